@@ -0,0 +1,127 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/benchmark/util.hpp>
+#include <mbgl/map/map.hpp>
+#include <mbgl/map/rendering_stats.hpp>
+#include <mbgl/gl/headless_backend.hpp>
+#include <mbgl/gl/offscreen_view.hpp>
+#include <mbgl/util/default_thread_pool.hpp>
+#include <mbgl/storage/default_file_source.hpp>
+#include <mbgl/storage/network_status.hpp>
+#include <mbgl/util/chrono.hpp>
+#include <mbgl/util/io.hpp>
+#include <mbgl/util/run_loop.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <vector>
+
+using namespace mbgl;
+
+namespace {
+
+// One keyframe of the scripted camera path. Frames in between are linearly
+// interpolated, like a recorded gesture replay.
+struct CameraKeyframe {
+    LatLng latLng;
+    double zoom;
+    double bearing;
+};
+
+const std::vector<CameraKeyframe> cameraPath {
+    { { 40.72, -73.99 },  9.0,  0.0 },  // overview
+    { { 40.74, -73.97 }, 12.0,  0.0 },  // zoom in
+    { { 40.70, -74.02 }, 12.0,  0.0 },  // pan
+    { { 40.70, -74.02 }, 14.0, 45.0 },  // zoom + rotate
+    { { 40.76, -73.94 }, 14.0, 90.0 },  // diagonal pan, rotated
+    { { 40.72, -73.99 },  9.0,  0.0 },  // zoom back out
+};
+
+// Frames per keyframe-to-keyframe segment.
+const std::size_t framesPerSegment = 30;
+
+CameraKeyframe interpolate(std::size_t frame) {
+    const std::size_t totalFrames = (cameraPath.size() - 1) * framesPerSegment;
+    const std::size_t i = (frame % totalFrames) / framesPerSegment;
+    const double t = double(frame % framesPerSegment) / framesPerSegment;
+    const CameraKeyframe& a = cameraPath[i];
+    const CameraKeyframe& b = cameraPath[i + 1];
+    return { { a.latLng.latitude + (b.latLng.latitude - a.latLng.latitude) * t,
+               a.latLng.longitude + (b.latLng.longitude - a.latLng.longitude) * t },
+             a.zoom + (b.zoom - a.zoom) * t,
+             a.bearing + (b.bearing - a.bearing) * t };
+}
+
+double percentile(const std::vector<double>& sorted, double p) {
+    if (sorted.empty()) {
+        return 0;
+    }
+    const std::size_t index = std::min(sorted.size() - 1,
+                                       static_cast<std::size_t>(p * sorted.size()));
+    return sorted[index];
+}
+
+class RenderBenchmark {
+public:
+    RenderBenchmark() {
+        NetworkStatus::Set(NetworkStatus::Status::Offline);
+        map.setStyleJSON(util::read_file("benchmark/fixtures/api/render_style.json"));
+    }
+
+    util::RunLoop loop;
+    HeadlessBackend backend;
+    OffscreenView view{ backend.getContext(), { 1000, 1000 } };
+    DefaultFileSource fileSource{ ":memory:", "." };
+    ThreadPool threadPool{ 4 };
+    Map map{ backend, view.size, 1, fileSource, threadPool, MapMode::Still };
+};
+
+} // end namespace
+
+// Replays a recorded pan/zoom/rotate path, one frame per iteration, and
+// reports the p50/p95/p99 frame time plus average per-frame GL counters so
+// builds and styles can be compared quantitatively.
+static void API_renderCameraPath(::benchmark::State& state) {
+    RenderBenchmark bench;
+
+    RenderingStats lastFrame;
+    bench.map.setRenderingStatsCallback([&](const RenderingStats& stats) {
+        lastFrame = stats;
+    });
+
+    // Warm up: load the style and sources before measuring.
+    bench.map.setLatLngZoom(cameraPath.front().latLng, cameraPath.front().zoom);
+    mbgl::benchmark::render(bench.map, bench.view);
+
+    std::vector<double> frameTimes;
+    uint64_t drawCalls = 0;
+    uint64_t textureBinds = 0;
+    std::size_t frame = 0;
+
+    while (state.KeepRunning()) {
+        const CameraKeyframe keyframe = interpolate(frame++);
+        bench.map.setLatLngZoom(keyframe.latLng, keyframe.zoom);
+        bench.map.setBearing(keyframe.bearing);
+
+        const TimePoint frameStart = Clock::now();
+        mbgl::benchmark::render(bench.map, bench.view);
+        frameTimes.push_back(
+            std::chrono::duration<double, std::milli>(Clock::now() - frameStart).count());
+
+        drawCalls += lastFrame.drawCalls;
+        textureBinds += lastFrame.textureBinds;
+    }
+
+    std::sort(frameTimes.begin(), frameTimes.end());
+
+    char label[128];
+    std::snprintf(label, sizeof(label),
+                  "p50=%.2fms p95=%.2fms p99=%.2fms draws/frame=%.1f binds/frame=%.1f",
+                  percentile(frameTimes, 0.50), percentile(frameTimes, 0.95),
+                  percentile(frameTimes, 0.99),
+                  frameTimes.empty() ? 0.0 : double(drawCalls) / frameTimes.size(),
+                  frameTimes.empty() ? 0.0 : double(textureBinds) / frameTimes.size());
+    state.SetLabel(label);
+}
+
+BENCHMARK(API_renderCameraPath);
@@ -0,0 +1,55 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/geometry/anchor.hpp>
+#include <mbgl/geometry/feature_index.hpp>
+#include <mbgl/text/collision_tile.hpp>
+#include <mbgl/text/collision_feature.hpp>
+#include <mbgl/text/placement_config.hpp>
+
+using namespace mbgl;
+
+namespace {
+
+// A label-sized collision feature anchored at the given tile coordinate.
+CollisionFeature labelFeature(int16_t x, int16_t y, util::Arena& arena) {
+    const GeometryCoordinates line {{ x, y }};
+    const Anchor anchor(x, y, 0.0f, 0.5f);
+    Shaping shaping;
+    shaping.top = -12;
+    shaping.bottom = 12;
+    shaping.left = -60;
+    shaping.right = 60;
+    return CollisionFeature(line, anchor, shaping, 1.0f, 2.0f,
+                            style::SymbolPlacementType::Point,
+                            IndexedSubfeature { 0, "layer", "bucket", 0 },
+                            arena);
+}
+
+} // namespace
+
+// Dense grid of labels, like a city center full of POIs: most placements have
+// to consult several previously inserted neighbors.
+static void CollisionTile_placeFeature(benchmark::State& state) {
+    util::Arena arena;
+    std::vector<CollisionFeature> features;
+    for (int16_t y = 0; y < 64; ++y) {
+        for (int16_t x = 0; x < 16; ++x) {
+            features.push_back(labelFeature(static_cast<int16_t>(x * 128 + 64),
+                                            static_cast<int16_t>(y * 64 + 32),
+                                            arena));
+        }
+    }
+
+    while (state.KeepRunning()) {
+        CollisionTile collisionTile { PlacementConfig() };
+        float scales = 0;
+        for (auto& feature : features) {
+            const float minPlacementScale = collisionTile.placeFeature(feature, false, false);
+            collisionTile.insertFeature(feature, minPlacementScale, false);
+            scales += minPlacementScale;
+        }
+        ::benchmark::DoNotOptimize(scales);
+    }
+}
+
+BENCHMARK(CollisionTile_placeFeature);
@@ -0,0 +1,54 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/benchmark/stub_geometry_tile_feature.hpp>
+#include <mbgl/renderer/fill_bucket.hpp>
+#include <mbgl/style/bucket_parameters.hpp>
+#include <mbgl/util/constants.hpp>
+
+#include <cmath>
+
+using namespace mbgl;
+
+namespace {
+
+const std::atomic<bool> neverObsolete { false };
+
+GeometryCoordinates ring(double centerX, double centerY, double radius, std::size_t points, bool clockwise) {
+    GeometryCoordinates result;
+    result.reserve(points + 1);
+    for (std::size_t i = 0; i <= points; ++i) {
+        const double angle = (clockwise ? -2.0 : 2.0) * M_PI * double(i % points) / double(points);
+        // Wobble the radius so the ring isn't convex; earcut's fast paths
+        // would otherwise make the benchmark unrealistically cheap.
+        const double r = radius * (1.0 + 0.2 * std::sin(angle * 9.0));
+        result.emplace_back(static_cast<int16_t>(centerX + r * std::cos(angle)),
+                            static_cast<int16_t>(centerY + r * std::sin(angle)));
+    }
+    return result;
+}
+
+// A landcover-style polygon: one large concave outer ring with a couple of
+// holes, the shape that dominates fill tessellation time in real tiles.
+GeometryCollection polygonGeometry(std::size_t points) {
+    const double center = util::EXTENT / 2.0;
+    GeometryCollection result;
+    result.push_back(ring(center, center, util::EXTENT * 0.45, points, false));
+    result.push_back(ring(center - util::EXTENT * 0.15, center, util::EXTENT * 0.08, points / 8, true));
+    result.push_back(ring(center + util::EXTENT * 0.15, center, util::EXTENT * 0.08, points / 8, true));
+    return result;
+}
+
+} // namespace
+
+static void FillBucket_addFeatureTessellation(benchmark::State& state) {
+    const GeometryCollection geometry = polygonGeometry(512);
+    const StubGeometryTileFeature feature { FeatureType::Polygon, geometry };
+
+    while (state.KeepRunning()) {
+        FillBucket bucket { { { 15, 0, 0 }, MapMode::Continuous, neverObsolete }, {} };
+        bucket.addFeature(feature, geometry);
+        ::benchmark::DoNotOptimize(bucket.triangles.indexSize());
+    }
+}
+
+BENCHMARK(FillBucket_addFeatureTessellation);
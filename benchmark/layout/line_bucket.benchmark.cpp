@@ -0,0 +1,56 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/benchmark/stub_geometry_tile_feature.hpp>
+#include <mbgl/renderer/line_bucket.hpp>
+#include <mbgl/style/bucket_parameters.hpp>
+#include <mbgl/util/constants.hpp>
+
+#include <cmath>
+
+using namespace mbgl;
+
+namespace {
+
+const std::atomic<bool> neverObsolete { false };
+
+// A winding polyline spanning the tile, comparable to a motorway or river:
+// plenty of vertices and a mix of join angles.
+GeometryCollection lineGeometry(std::size_t points) {
+    GeometryCoordinates line;
+    line.reserve(points);
+    for (std::size_t i = 0; i < points; ++i) {
+        const double t = double(i) / double(points - 1);
+        const auto x = static_cast<int16_t>(t * util::EXTENT);
+        const auto y = static_cast<int16_t>(
+            (0.5 + 0.35 * std::sin(t * 40.0) + 0.1 * std::sin(t * 173.0)) * util::EXTENT);
+        line.emplace_back(x, y);
+    }
+    return { std::move(line) };
+}
+
+void addLines(benchmark::State& state, const style::LineLayoutProperties& layout) {
+    const GeometryCollection geometry = lineGeometry(1024);
+    const StubGeometryTileFeature feature { FeatureType::LineString, geometry };
+
+    while (state.KeepRunning()) {
+        LineBucket bucket { { { 15, 0, 0 }, MapMode::Continuous, neverObsolete }, {}, layout };
+        bucket.addFeature(feature, geometry);
+        ::benchmark::DoNotOptimize(bucket.vertices.vertexSize());
+    }
+}
+
+} // namespace
+
+static void LineBucket_addFeatureMiterJoins(benchmark::State& state) {
+    addLines(state, style::LineLayoutProperties());
+}
+
+static void LineBucket_addFeatureRoundJoins(benchmark::State& state) {
+    style::LineLayoutProperties layout;
+    layout.unevaluated.get<style::LineJoin>() = style::LineJoinType::Round;
+    layout.unevaluated.get<style::LineCap>() = style::LineCapType::Round;
+    addLines(state, layout);
+}
+
+BENCHMARK(LineBucket_addFeatureMiterJoins);
+BENCHMARK(LineBucket_addFeatureRoundJoins);
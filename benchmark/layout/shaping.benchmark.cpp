@@ -0,0 +1,119 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/text/bidi.hpp>
+#include <mbgl/text/glyph_atlas.hpp>
+#include <mbgl/text/glyph_set.hpp>
+#include <mbgl/storage/default_file_source.hpp>
+#include <mbgl/util/run_loop.hpp>
+#include <mbgl/util/string.hpp>
+
+using namespace mbgl;
+
+namespace {
+
+// A glyph set covering printable ASCII with plausible label metrics, including
+// a bitmap so the glyphs can also be rasterized into a GlyphAtlas.
+const GlyphSet& asciiGlyphs() {
+    static const GlyphSet glyphs = [] {
+        GlyphSet result;
+        for (uint32_t id = 0x20; id < 0x7F; ++id) {
+            SDFGlyph glyph;
+            glyph.id = id;
+            glyph.metrics.width = 14;
+            glyph.metrics.height = 18;
+            glyph.metrics.left = 1;
+            glyph.metrics.top = -4;
+            glyph.metrics.advance = 12;
+            glyph.bitmap.resize((glyph.metrics.width + 2 * SDFGlyph::borderSize) *
+                                (glyph.metrics.height + 2 * SDFGlyph::borderSize));
+            result.insert(id, std::move(glyph));
+        }
+        return result;
+    }();
+    return glyphs;
+}
+
+std::u16string label(std::size_t i) {
+    const std::string text = "Main Street " + util::toString(i);
+    return std::u16string(text.begin(), text.end());
+}
+
+Shaping shape(const GlyphSet& glyphs, const std::u16string& text, BiDi& bidi) {
+    // Matches the scaling SymbolLayout::prepare applies to a symbol layer with
+    // default text-max-width and text-line-height.
+    return glyphs.getShaping(text, 10.0f * 24.0f, 1.2f * 24.0f, 0.5f, 0.5f, 0.5f, 0.0f,
+                             { 0.0f, 0.0f }, bidi);
+}
+
+} // namespace
+
+// Every iteration shapes a string the GlyphSet has not cached, measuring line
+// breaking and glyph positioning itself.
+static void Shaping_getShapingUncached(benchmark::State& state) {
+    const GlyphSet& glyphs = asciiGlyphs();
+    BiDi bidi;
+
+    std::size_t i = 0;
+    while (state.KeepRunning()) {
+        // Cycling through more labels than the shaping cache can hold makes
+        // every lookup a miss.
+        const Shaping shaping = shape(glyphs, label(i++ % 4096), bidi);
+        ::benchmark::DoNotOptimize(shaping.positionedGlyphs.size());
+    }
+}
+
+// Repeated labels ("Main St" across tiles) hit the shaping cache.
+static void Shaping_getShapingCached(benchmark::State& state) {
+    const GlyphSet& glyphs = asciiGlyphs();
+    BiDi bidi;
+    const std::u16string text = label(0);
+
+    while (state.KeepRunning()) {
+        const Shaping shaping = shape(glyphs, text, bidi);
+        ::benchmark::DoNotOptimize(shaping.positionedGlyphs.size());
+    }
+}
+
+// First use of a font in a tile: every glyph gets rasterized into the atlas.
+static void GlyphAtlas_addGlyphsCold(benchmark::State& state) {
+    util::RunLoop loop;
+    DefaultFileSource fileSource { ":memory:", "." };
+    const GlyphSet& glyphs = asciiGlyphs();
+    const FontStack fontStack {{ "Benchmark" }};
+    const std::u16string text = u" !\"#$%&'()*+,-./0123456789:;<=>?@ABCDEFGHIJKLMNOPQRSTUVWXYZ"
+                                u"[\\]^_`abcdefghijklmnopqrstuvwxyz{|}~";
+
+    while (state.KeepRunning()) {
+        GlyphAtlas atlas { { 512, 512 }, fileSource };
+        GlyphPositions face;
+        atlas.addGlyphs(1, text, fontStack, glyphs, face);
+        ::benchmark::DoNotOptimize(face.size());
+    }
+}
+
+// Steady state: the glyphs are already in the atlas and only the positions map
+// and reference counts are touched.
+static void GlyphAtlas_addGlyphsWarm(benchmark::State& state) {
+    util::RunLoop loop;
+    DefaultFileSource fileSource { ":memory:", "." };
+    const GlyphSet& glyphs = asciiGlyphs();
+    const FontStack fontStack {{ "Benchmark" }};
+    const std::u16string text = label(0);
+
+    GlyphAtlas atlas { { 512, 512 }, fileSource };
+    GlyphPositions warmup;
+    atlas.addGlyphs(1, text, fontStack, glyphs, warmup);
+
+    uintptr_t tileUID = 2;
+    while (state.KeepRunning()) {
+        GlyphPositions face;
+        atlas.addGlyphs(tileUID, text, fontStack, glyphs, face);
+        atlas.removeGlyphs(tileUID++);
+        ::benchmark::DoNotOptimize(face.size());
+    }
+}
+
+BENCHMARK(Shaping_getShapingUncached);
+BENCHMARK(Shaping_getShapingCached);
+BENCHMARK(GlyphAtlas_addGlyphsCold);
+BENCHMARK(GlyphAtlas_addGlyphsWarm);
@@ -0,0 +1,49 @@
+#include <benchmark/benchmark.h>
+
+#include <mbgl/tile/vector_tile.hpp>
+#include <mbgl/util/io.hpp>
+
+using namespace mbgl;
+
+namespace {
+
+std::shared_ptr<const std::string> tileData() {
+    static const auto data = std::make_shared<const std::string>(
+        util::read_file("benchmark/fixtures/tile/streets-10-163-395.vector.pbf"));
+    return data;
+}
+
+} // namespace
+
+// Parsing the layer directory and one layer's feature list; geometry stays
+// encoded. This is the synchronous part every tile pays on arrival.
+static void Parse_VectorTileLayer(benchmark::State& state) {
+    auto data = tileData();
+
+    while (state.KeepRunning()) {
+        VectorTileData tile(data);
+        ::benchmark::DoNotOptimize(tile.getLayer("road"));
+    }
+}
+
+// Full decode of a dense layer: every feature's geometry commands are walked,
+// as the buckets do during layout.
+static void Parse_VectorTileFeatures(benchmark::State& state) {
+    auto data = tileData();
+
+    while (state.KeepRunning()) {
+        VectorTileData tile(data);
+        const GeometryTileLayer* layer = tile.getLayer("road");
+        std::size_t coordinates = 0;
+        for (std::size_t i = 0; i < layer->featureCount(); ++i) {
+            const auto feature = layer->getFeature(i);
+            for (const auto& line : feature->getGeometries()) {
+                coordinates += line.size();
+            }
+        }
+        ::benchmark::DoNotOptimize(coordinates);
+    }
+}
+
+BENCHMARK(Parse_VectorTileLayer);
+BENCHMARK(Parse_VectorTileFeatures);
@@ -3,18 +3,27 @@
 set(MBGL_BENCHMARK_FILES
     # api
     benchmark/api/query.benchmark.cpp
+    benchmark/api/render.benchmark.cpp
 
     # include/mbgl
     benchmark/include/mbgl/benchmark.hpp
 
+    # layout
+    benchmark/layout/collision_tile.benchmark.cpp
+    benchmark/layout/fill_bucket.benchmark.cpp
+    benchmark/layout/line_bucket.benchmark.cpp
+    benchmark/layout/shaping.benchmark.cpp
+
     # parse
     benchmark/parse/filter.benchmark.cpp
+    benchmark/parse/vector_tile.benchmark.cpp
 
     # src
     benchmark/src/main.cpp
 
     # src/mbgl/benchmark
     benchmark/src/mbgl/benchmark/benchmark.cpp
+    benchmark/src/mbgl/benchmark/stub_geometry_tile_feature.hpp
     benchmark/src/mbgl/benchmark/util.cpp
     benchmark/src/mbgl/benchmark/util.hpp
 )
@@ -4,10 +4,13 @@ set(MBGL_CORE_FILES
     # actor
     src/mbgl/actor/actor.hpp
     src/mbgl/actor/actor_ref.hpp
+    src/mbgl/actor/instrumentation.cpp
+    src/mbgl/actor/instrumentation.hpp
     src/mbgl/actor/mailbox.cpp
     src/mbgl/actor/mailbox.hpp
     src/mbgl/actor/message.hpp
     src/mbgl/actor/scheduler.hpp
+    src/mbgl/actor/task_group.hpp
 
     # algorithm
     src/mbgl/algorithm/covered_by_children.hpp
@@ -56,6 +59,8 @@ set(MBGL_CORE_FILES
     include/mbgl/gl/gl.hpp
     src/mbgl/gl/attribute.cpp
     src/mbgl/gl/attribute.hpp
+    src/mbgl/gl/buffer_budget.cpp
+    src/mbgl/gl/buffer_budget.hpp
     src/mbgl/gl/color_mode.cpp
     src/mbgl/gl/color_mode.hpp
     src/mbgl/gl/context.cpp
@@ -106,11 +111,15 @@ set(MBGL_CORE_FILES
     include/mbgl/map/backend.hpp
     include/mbgl/map/camera.hpp
     include/mbgl/map/map.hpp
+    include/mbgl/map/map_state.hpp
     include/mbgl/map/mode.hpp
+    include/mbgl/map/rendering_stats.hpp
     include/mbgl/map/view.hpp
     src/mbgl/map/backend.cpp
     src/mbgl/map/change.hpp
     src/mbgl/map/map.cpp
+    src/mbgl/map/quality_governor.cpp
+    src/mbgl/map/quality_governor.hpp
     src/mbgl/map/transform.cpp
     src/mbgl/map/transform.hpp
     src/mbgl/map/transform_state.cpp
@@ -142,6 +151,7 @@ set(MBGL_CORE_FILES
     src/mbgl/programs/line_program.hpp
     src/mbgl/programs/program.hpp
     src/mbgl/programs/program_parameters.hpp
+    src/mbgl/programs/programs.cpp
     src/mbgl/programs/programs.hpp
     src/mbgl/programs/raster_program.cpp
     src/mbgl/programs/raster_program.hpp
@@ -208,12 +218,16 @@ set(MBGL_CORE_FILES
     src/mbgl/shaders/symbol_icon.hpp
     src/mbgl/shaders/symbol_sdf.cpp
     src/mbgl/shaders/symbol_sdf.hpp
+    src/mbgl/shaders/symbol_sdf_halo_fill.cpp
+    src/mbgl/shaders/symbol_sdf_halo_fill.hpp
 
     # sprite
     include/mbgl/sprite/sprite_image.hpp
     src/mbgl/sprite/sprite_atlas.cpp
     src/mbgl/sprite/sprite_atlas.hpp
     src/mbgl/sprite/sprite_atlas_observer.hpp
+    src/mbgl/sprite/sprite_cache.cpp
+    src/mbgl/sprite/sprite_cache.hpp
     src/mbgl/sprite/sprite_image.cpp
     src/mbgl/sprite/sprite_parser.cpp
     src/mbgl/sprite/sprite_parser.hpp
@@ -262,6 +276,8 @@ set(MBGL_CORE_FILES
     src/mbgl/style/observer.hpp
     src/mbgl/style/paint_property.hpp
     src/mbgl/style/paint_property_binder.hpp
+    src/mbgl/style/parsed_layer_cache.cpp
+    src/mbgl/style/parsed_layer_cache.hpp
     src/mbgl/style/parser.cpp
     src/mbgl/style/parser.hpp
     src/mbgl/style/possibly_evaluated_property_value.hpp
@@ -386,6 +402,8 @@ set(MBGL_CORE_FILES
     src/mbgl/text/glyph_atlas.cpp
     src/mbgl/text/glyph_atlas.hpp
     src/mbgl/text/glyph_atlas_observer.hpp
+    src/mbgl/text/glyph_cache.cpp
+    src/mbgl/text/glyph_cache.hpp
     src/mbgl/text/glyph_pbf.cpp
     src/mbgl/text/glyph_pbf.hpp
     src/mbgl/text/glyph_range.hpp
@@ -416,9 +434,13 @@ set(MBGL_CORE_FILES
     src/mbgl/tile/tile_cache.hpp
     src/mbgl/tile/tile_id.hpp
     src/mbgl/tile/tile_id_io.cpp
+    src/mbgl/tile/tile_latency.cpp
+    src/mbgl/tile/tile_latency.hpp
     src/mbgl/tile/tile_loader.hpp
     src/mbgl/tile/tile_loader_impl.hpp
     src/mbgl/tile/tile_observer.hpp
+    src/mbgl/tile/tile_parse_pressure.cpp
+    src/mbgl/tile/tile_parse_pressure.hpp
     src/mbgl/tile/vector_tile.cpp
     src/mbgl/tile/vector_tile.hpp
 
@@ -457,7 +479,10 @@ set(MBGL_CORE_FILES
     include/mbgl/util/work_request.hpp
     include/mbgl/util/work_task.hpp
     include/mbgl/util/work_task_impl.hpp
+    src/mbgl/util/arena.hpp
     src/mbgl/util/async_task.hpp
+    src/mbgl/util/buffer_pool.cpp
+    src/mbgl/util/buffer_pool.hpp
     src/mbgl/util/chrono.cpp
     src/mbgl/util/clip_id.cpp
     src/mbgl/util/clip_id.hpp
@@ -467,6 +492,8 @@ set(MBGL_CORE_FILES
     src/mbgl/util/convert.cpp
     src/mbgl/util/dtoa.cpp
     src/mbgl/util/dtoa.hpp
+    src/mbgl/util/etc1.cpp
+    src/mbgl/util/etc1.hpp
     src/mbgl/util/event.cpp
     src/mbgl/util/exclusive.hpp
     src/mbgl/util/font_stack.cpp
@@ -484,6 +511,8 @@ set(MBGL_CORE_FILES
     src/mbgl/util/indexed_tuple.hpp
     src/mbgl/util/interpolate.cpp
     src/mbgl/util/interpolate.hpp
+    src/mbgl/util/interned_string.cpp
+    src/mbgl/util/interned_string.hpp
     src/mbgl/util/intersection_tests.cpp
     src/mbgl/util/intersection_tests.hpp
     src/mbgl/util/io.cpp
@@ -498,12 +527,16 @@ set(MBGL_CORE_FILES
     src/mbgl/util/mat4.cpp
     src/mbgl/util/mat4.hpp
     src/mbgl/util/math.hpp
+    src/mbgl/util/memory_budget.cpp
+    src/mbgl/util/memory_budget.hpp
     src/mbgl/util/offscreen_texture.cpp
     src/mbgl/util/offscreen_texture.hpp
     src/mbgl/util/premultiply.cpp
     src/mbgl/util/premultiply.hpp
     src/mbgl/util/rapidjson.hpp
     src/mbgl/util/rect.hpp
+    src/mbgl/util/simplify.cpp
+    src/mbgl/util/simplify.hpp
     src/mbgl/util/std.hpp
     src/mbgl/util/stopwatch.cpp
     src/mbgl/util/stopwatch.hpp
@@ -514,7 +547,11 @@ set(MBGL_CORE_FILES
     src/mbgl/util/tile_coordinate.hpp
     src/mbgl/util/tile_cover.cpp
     src/mbgl/util/tile_cover.hpp
+    src/mbgl/util/tiny_sdf.cpp
+    src/mbgl/util/tiny_sdf.hpp
     src/mbgl/util/token.hpp
+    src/mbgl/util/tracing.cpp
+    src/mbgl/util/tracing.hpp
     src/mbgl/util/type_list.hpp
     src/mbgl/util/url.cpp
     src/mbgl/util/url.hpp
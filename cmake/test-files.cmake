@@ -4,6 +4,8 @@ set(MBGL_TEST_FILES
     # actor
     test/actor/actor.test.cpp
     test/actor/actor_ref.test.cpp
+    test/actor/instrumentation.test.cpp
+    test/actor/task_group.test.cpp
 
     # algorithm
     test/algorithm/covered_by_children.test.cpp
@@ -21,9 +23,11 @@ set(MBGL_TEST_FILES
 
     # geometry
     test/geometry/binpack.test.cpp
+    test/geometry/line_atlas.test.cpp
 
     # gl
     test/gl/bucket.test.cpp
+    test/gl/buffer_budget.test.cpp
     test/gl/object.test.cpp
 
     # include/mbgl
@@ -31,6 +35,7 @@ set(MBGL_TEST_FILES
 
     # map
     test/map/map.test.cpp
+    test/map/quality_governor.test.cpp
     test/map/transform.test.cpp
 
     # math
@@ -67,6 +72,7 @@ set(MBGL_TEST_FILES
     test/storage/offline.test.cpp
     test/storage/offline_database.test.cpp
     test/storage/offline_download.test.cpp
+    test/storage/offline_pack.test.cpp
     test/storage/online_file_source.test.cpp
     test/storage/resource.test.cpp
     test/storage/sqlite.test.cpp
@@ -103,25 +109,35 @@ set(MBGL_TEST_FILES
     test/tile/raster_tile.test.cpp
     test/tile/tile_coordinate.test.cpp
     test/tile/tile_id.test.cpp
+    test/tile/tile_latency.test.cpp
+    test/tile/tile_parse_pressure.test.cpp
     test/tile/vector_tile.test.cpp
 
     # util
     test/util/async_task.test.cpp
+    test/util/buffer_pool.test.cpp
+    test/util/etc1.test.cpp
     test/util/geo.test.cpp
+    test/util/grid_index.test.cpp
     test/util/http_timeout.test.cpp
+    test/util/i18n.test.cpp
     test/util/image.test.cpp
+    test/util/interned_string.test.cpp
     test/util/mapbox.test.cpp
     test/util/memory.test.cpp
+    test/util/memory_budget.test.cpp
     test/util/merge_lines.test.cpp
     test/util/number_conversions.test.cpp
     test/util/offscreen_texture.test.cpp
     test/util/projection.test.cpp
     test/util/run_loop.test.cpp
+    test/util/simplify.test.cpp
     test/util/text_conversions.test.cpp
     test/util/thread.test.cpp
     test/util/thread_local.test.cpp
     test/util/tile_cover.test.cpp
     test/util/timer.test.cpp
+    test/util/tiny_sdf.test.cpp
     test/util/token.test.cpp
     test/util/url.test.cpp
     test/util/work_queue.test.cpp
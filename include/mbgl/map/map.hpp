@@ -5,10 +5,12 @@
 #include <mbgl/map/mode.hpp>
 #include <mbgl/util/geo.hpp>
 #include <mbgl/util/feature.hpp>
+#include <mbgl/util/image.hpp>
 #include <mbgl/util/noncopyable.hpp>
 #include <mbgl/util/size.hpp>
 #include <mbgl/annotation/annotation.hpp>
 #include <mbgl/style/transition_options.hpp>
+#include <mbgl/util/font_stack.hpp>
 
 #include <cstdint>
 #include <string>
@@ -23,14 +25,31 @@ class View;
 class FileSource;
 class Scheduler;
 class SpriteImage;
+class RenderingStats;
 struct CameraOptions;
 struct AnimationOptions;
+struct MapState;
 
 namespace style {
 class Source;
 class Layer;
 } // namespace style
 
+// A profile of what a previous session's style ended up needing, recorded by
+// the embedder and fed to Map::warmup() so that shader compilation and
+// glyph/sprite fetches can start before the style itself has loaded.
+struct MapWarmupProfile {
+    // Style-spec layer type names, e.g. "fill", "line", "symbol".
+    std::vector<std::string> layerTypes;
+
+    // Glyph URL template and the font stacks used by symbol layers.
+    std::string glyphURL;
+    std::vector<FontStack> fontStacks;
+
+    // The style's sprite base URL.
+    optional<std::string> spriteURL;
+};
+
 class Map : private util::noncopyable {
 public:
     explicit Map(Backend&,
@@ -41,7 +60,8 @@ public:
                  MapMode mapMode = MapMode::Continuous,
                  GLContextMode contextMode = GLContextMode::Unique,
                  ConstrainMode constrainMode = ConstrainMode::HeightOnly,
-                 ViewportMode viewportMode = ViewportMode::Default);
+                 ViewportMode viewportMode = ViewportMode::Default,
+                 const optional<std::string>& programCacheDir = {});
     ~Map();
 
     // Register a callback that will get called (on the render thread) when all resources have
@@ -49,12 +69,55 @@ public:
     using StillImageCallback = std::function<void (std::exception_ptr)>;
     void renderStill(View&, StillImageCallback callback);
 
+    // Like above, but delivers a partial render of whatever has loaded by the
+    // time the deadline expires instead of waiting for the missing resources.
+    void renderStill(View&, Duration deadline, StillImageCallback callback);
+
     // Triggers a repaint.
     void triggerRepaint();
 
     // Main render function.
     void render(View&);
 
+    // Compiles the shader programs the current style's layers will use, so
+    // that the first frame doesn't have to. Optional; programs not warmed up
+    // here are compiled on first use. Requires a current GL context.
+    void precompilePrograms();
+
+    // Starts the work the first frame would otherwise run back to back —
+    // shader compilation, glyph prefetch, sprite load — concurrently, based
+    // on a profile recorded from a previous session, before any style has
+    // been set. Stale profile entries only cost wasted fetches; whatever the
+    // loaded style needs beyond the profile is resolved as usual. Requires a
+    // current GL context when the profile names layer types.
+    void warmup(const MapWarmupProfile&);
+
+    // Shows `image`, stretched over `bounds`, on top of the map until the
+    // style and every tile of the current viewport have finished loading.
+    // Intended for pre-rendered snapshots of the same style — for example
+    // produced ahead of time with renderStill() on a headless map — so that
+    // something meaningful is on screen while vector tiles are still laying
+    // out. Cleared automatically on the first fully loaded frame, or
+    // explicitly with removePlaceholderImage().
+    void setPlaceholderImage(PremultipliedImage&&, const LatLngBounds&);
+    void removePlaceholderImage();
+
+    // Batching
+    //
+    // Wraps a run of annotation or runtime style mutations so that they
+    // trigger a single invalidation — and thus one cascade, layout and
+    // placement pass on the next frame — instead of one per call. Batches
+    // nest; only the outermost endUpdates triggers the invalidation. The
+    // mutations themselves are applied immediately, so getters observe them
+    // inside an open batch as usual.
+    void beginUpdates();
+    void endUpdates();
+
+    // Applies every set field of the bundle — camera jump, debug options,
+    // style classes — inside one batch, so scripted drivers pay for a single
+    // update cascade per step regardless of how much state changed.
+    void applyState(const MapState&);
+
     // Styling
     void addClass(const std::string&);
     void removeClass(const std::string&);
@@ -81,6 +144,13 @@ public:
 
     // Camera
     CameraOptions getCameraOptions(optional<EdgeInsets>) const;
+
+    // Returns the camera as of the most recently rendered frame. Unlike the
+    // other camera getters, which must run on the map thread, this may be
+    // called from any thread without messaging: the map publishes a new
+    // snapshot at the start of every frame. Returns an empty CameraOptions
+    // until the first frame renders.
+    CameraOptions getCameraSnapshot() const;
     void jumpTo(const CameraOptions&);
     void easeTo(const CameraOptions&, const AnimationOptions&);
     void flyTo(const CameraOptions&, const AnimationOptions&);
@@ -185,8 +255,60 @@ public:
     std::vector<Feature> queryRenderedFeatures(const ScreenBox&,        const optional<std::vector<std::string>>& layerIDs = {});
     AnnotationIDs queryPointAnnotations(const ScreenBox&);
 
+    // Asynchronous feature queries. The query is deferred off the caller's
+    // stack — a hit test in a gesture handler no longer delays the frame
+    // being produced — and the result is delivered through the callback on
+    // the map thread. `limit` bounds the work done: the query stops visiting
+    // further tiles and sources once that many features have been found, so
+    // a hit test that only needs the topmost match can pass a small limit.
+    // With a limit the result is truncated and ordered per tile rather than
+    // across the whole viewport. Callbacks still pending when the Map is
+    // destroyed are dropped.
+    using QueryFeaturesCallback = std::function<void(std::vector<Feature>)>;
+    void queryRenderedFeatures(const ScreenCoordinate&, const optional<std::vector<std::string>>& layerIDs,
+                               optional<uint32_t> limit, QueryFeaturesCallback);
+    void queryRenderedFeatures(const ScreenBox&, const optional<std::vector<std::string>>& layerIDs,
+                               optional<uint32_t> limit, QueryFeaturesCallback);
+
+    // Glyphs
+    //
+    // Warms the glyph cache for the given font stacks over an inclusive
+    // codepoint range, issuing the underlying 256-codepoint glyph range
+    // requests up front — during a splash screen, say — instead of when the
+    // first label using them reaches layout. Requires a loaded style, since
+    // the glyph URL comes from the stylesheet. Ranges already requested or
+    // cached are skipped.
+    void prefetchGlyphs(const std::vector<FontStack>&, char16_t first, char16_t last);
+
     // Memory
     void setSourceTileCacheSize(size_t);
+
+    // Process-wide cap, in bytes, on the combined size of mbgl's in-memory
+    // caches (tile caches and atlases); 0 disables the cap. When the cap is
+    // exceeded, tile caches are shrunk proportionally after each frame.
+    void setMemoryBudget(size_t bytes);
+
+    // Approximate combined byte usage of mbgl's in-memory caches.
+    size_t getMemoryUsage() const;
+
+    // Process-wide budget, in bytes, for GL vertex and index buffer storage;
+    // 0 disables it. Tiles whose projected buffer cost would exceed the
+    // budget are laid out with coarser line tessellation, trading geometric
+    // fidelity for staying under the cap on memory-constrained GPUs.
+    void setVertexBufferBudget(size_t bytes);
+    size_t getVertexBufferUsage() const;
+
+    // Metrics
+    //
+    // End-to-end tile latency: the time from a tile's resource request to
+    // the first frame that drew it, aggregated process-wide into a bucketed
+    // histogram. `p` is a fraction — 0.95 reads p95 — and the result is the
+    // upper bound of the bucket the percentile falls in, so release gates
+    // can assert against it without per-sample bookkeeping.
+    Duration getTileLatencyPercentile(double p) const;
+    size_t getTileLatencySampleCount() const;
+    void resetTileLatencyHistogram();
+
     void onLowMemory();
 
     // Debug
@@ -194,7 +316,21 @@ public:
     void cycleDebugOptions();
     MapDebugOptions getDebug() const;
 
+    // Instrumentation. The callback is invoked on the render thread after
+    // every frame with that frame's stage timings and GL call counters.
+    using RenderingStatsCallback = std::function<void (const RenderingStats&)>;
+    void setRenderingStatsCallback(RenderingStatsCallback);
+
     bool isFullyLoaded() const;
+
+    // Whether rendering another frame would produce output different from the
+    // last one: pending update flags, a camera transition or gesture, style
+    // transitions, or an animation in progress. Embedders that drive
+    // continuous rendering from a vsync loop rather than from invalidate()
+    // can poll this and skip the frame entirely when it returns false,
+    // instead of redrawing an unchanged map every vertical blank.
+    bool needsRepaint() const;
+
     void dumpDebugLogs() const;
 
 private:
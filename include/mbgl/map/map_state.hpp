@@ -0,0 +1,36 @@
+#pragma once
+
+#include <mbgl/map/camera.hpp>
+#include <mbgl/map/mode.hpp>
+#include <mbgl/style/transition_options.hpp>
+#include <mbgl/util/optional.hpp>
+
+#include <string>
+#include <vector>
+
+namespace mbgl {
+
+/*
+    A bundle of map state applied atomically by Map::applyState(): every set
+    field takes effect immediately, but the whole bundle triggers a single
+    update cascade instead of one per setter. Remote-control and benchmark
+    drivers that replay scripted state per step should prefer this over a run
+    of individual setter calls.
+
+    Unset fields leave the corresponding state untouched.
+*/
+struct MapState {
+    // Applied as a jump (no animation), like Map::jumpTo().
+    optional<CameraOptions> camera;
+
+    optional<MapDebugOptions> debugOptions;
+
+    // Replaces the active style class list, like Map::setClasses().
+    optional<std::vector<std::string>> classes;
+
+    // Transition options for the class change above, like
+    // Map::setTransitionOptions().
+    optional<style::TransitionOptions> transitionOptions;
+};
+
+} // namespace mbgl
@@ -44,6 +44,13 @@ enum class MapDebugOptions : EnumType {
     Timestamps  = 1 << 3,
     Collision   = 1 << 4,
     Overdraw    = 1 << 5,
+    // Renders a heads-up overlay with live frame-health counters: frame time
+    // history, tile states, cache usage and GL call counts.
+    Overlay     = 1 << 8,
+    // Cross-checks the GL state cache against the live GL state after every
+    // frame, logging mismatches and the number of redundant state calls the
+    // cache filtered. Expensive; for driver-overhead investigations only.
+    StateAudit  = 1 << 9,
 // FIXME: https://github.com/mapbox/mapbox-gl-native/issues/5117
 #if not MBGL_USE_GLES2
     StencilClip = 1 << 6,
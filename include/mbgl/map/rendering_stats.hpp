@@ -0,0 +1,27 @@
+#pragma once
+
+#include <mbgl/util/chrono.hpp>
+
+#include <cstdint>
+
+namespace mbgl {
+
+// Per-frame health metrics collected while rendering. The durations measure
+// the CPU time the render thread spent encoding each stage of the frame; the
+// counters count GL calls actually issued, i.e. after redundant-state elision.
+// GPU-side stage timings would need the timer query extension, which the ES2
+// baseline does not provide, so they are not collected.
+class RenderingStats {
+public:
+    Duration uploadTime = Duration::zero();
+    Duration clipTime = Duration::zero();
+    Duration opaqueTime = Duration::zero();
+    Duration translucentTime = Duration::zero();
+
+    uint32_t drawCalls = 0;
+    uint32_t bufferUploads = 0;
+    uint32_t textureBinds = 0;
+    uint32_t textureUploads = 0;
+};
+
+} // namespace mbgl
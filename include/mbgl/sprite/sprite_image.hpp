@@ -6,6 +6,7 @@
 
 #include <string>
 #include <memory>
+#include <mutex>
 #include <cstdint>
 
 namespace mbgl {
@@ -14,7 +15,25 @@ class SpriteImage : private util::noncopyable {
 public:
     SpriteImage(PremultipliedImage&&, float pixelRatio, bool sdf = false);
 
-    PremultipliedImage image;
+    // Creates a view into a shared sprite sheet. No pixels are copied up
+    // front; the rect is sliced out of the sheet by the first getImage()
+    // call. Used by the sprite parser, which produces hundreds of icons per
+    // sheet of which a session typically touches a few dozen.
+    SpriteImage(std::shared_ptr<const PremultipliedImage> sheet,
+                uint32_t srcX,
+                uint32_t srcY,
+                Size size,
+                float pixelRatio,
+                bool sdf = false);
+
+    // Returns the icon's pixels, slicing them out of the sheet on first
+    // access for sheet-backed icons. Thread-safe.
+    const PremultipliedImage& getImage() const;
+
+    // Pixel storage. The size is always valid, but for sheet-backed icons
+    // the data is only populated once getImage() has been called; read
+    // pixels through getImage() rather than image.data.
+    mutable PremultipliedImage image;
 
     // Pixel ratio of the sprite image.
     const float pixelRatio;
@@ -24,6 +43,13 @@ public:
 
     float getWidth() const { return image.size.width / pixelRatio; }
     float getHeight() const { return image.size.height / pixelRatio; }
+
+private:
+    // Set for sheet-backed icons; keeps the sheet alive until slicing.
+    const std::shared_ptr<const PremultipliedImage> sheet;
+    const uint32_t srcX = 0;
+    const uint32_t srcY = 0;
+    mutable std::once_flag sliced;
 };
 
 } // namespace mbgl
@@ -36,6 +36,13 @@ public:
     void setAccessToken(const std::string&);
     std::string getAccessToken() const;
 
+    /*
+     * Caps the number of simultaneous transfers per host, so that one slow
+     * third-party server cannot occupy every connection slot and inflate the
+     * latency of the other sources in the style.
+     */
+    void setMaximumConcurrentRequestsPerHost(uint32_t);
+
     std::unique_ptr<AsyncRequest> request(const Resource&, Callback) override;
 
     /*
@@ -113,6 +120,42 @@ public:
      */
     void setOfflineMapboxTileCountLimit(uint64_t) const;
 
+    /*
+     * Mount a read-only offline pack, i.e. a resource archive previously
+     * written by exportOfflineRegion (typically baked into a firmware or
+     * installer image). Mounted packs answer requests that miss the offline
+     * database, so devices can ship with preloaded maps without copying a
+     * writable database. The database remains authoritative: a resource the
+     * device has since fetched shadows the baked-in copy.
+     *
+     * When the pack has been mounted or rejected as malformed, the given
+     * callback will be executed on the database thread; it is the
+     * responsibility of the SDK bindings to re-execute a user-provided
+     * callback on the main thread.
+     */
+    void mountOfflinePack(const std::string& path, std::function<void (std::exception_ptr)>);
+
+    /*
+     * Write the downloaded contents of an offline region into a pack file at
+     * the given path, suitable for mounting with mountOfflinePack on another
+     * device.
+     *
+     * When the export is complete or encounters an error, the given callback
+     * will be executed on the database thread; it is the responsibility of
+     * the SDK bindings to re-execute a user-provided callback on the main
+     * thread.
+     */
+    void exportOfflineRegion(OfflineRegion&, const std::string& path,
+                             std::function<void (std::exception_ptr)>);
+
+    /*
+     * Sets how many resource requests each offline region download keeps in
+     * flight at once. The default matches the HTTP connection limit; values
+     * above it only deepen the request queue. Applies to active downloads
+     * immediately.
+     */
+    void setOfflineDownloadConcurrency(uint32_t) const;
+
     // For testing only.
     void put(const Resource&, const Response&);
 
@@ -16,6 +16,10 @@ public:
     void setAccessToken(const std::string& t) { accessToken = t; }
     std::string getAccessToken() const { return accessToken; }
 
+    // Caps the number of simultaneous transfers per host, so that one slow
+    // server cannot occupy every connection slot. Values below 1 are clamped.
+    void setMaximumConcurrentRequestsPerHost(uint32_t);
+
     std::unique_ptr<AsyncRequest> request(const Resource&, Callback) override;
 
 private:
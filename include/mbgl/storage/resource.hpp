@@ -34,6 +34,18 @@ public:
         Required = true,
     };
 
+    // Scheduling hint for the online request queue: when the number of
+    // concurrent connections is saturated, pending requests are activated in
+    // priority order (and in arrival order within a priority). Style, sprite,
+    // and glyph requests default to High because layout and text rendering
+    // block on them; tile requests default to Regular so a burst of tiles
+    // after a zoom can't starve them.
+    enum Priority : uint8_t {
+        Low = 0,
+        Regular,
+        High,
+    };
+
     Resource(Kind kind_, std::string url_, optional<TileData> tileData_ = {}, Necessity necessity_ = Required)
         : kind(kind_),
           necessity(necessity_),
@@ -58,6 +70,7 @@ public:
 
     Kind kind;
     Necessity necessity;
+    Priority priority = Regular;
     std::string url;
 
     // Includes auxiliary data if this is a tile request.
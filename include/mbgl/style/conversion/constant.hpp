@@ -45,7 +45,7 @@ struct Converter<std::string> {
         if (!converted) {
             return Error { "value must be a string" };
         }
-        return *converted;
+        return std::move(*converted);
     }
 };
 
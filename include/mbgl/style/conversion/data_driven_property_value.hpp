@@ -20,23 +20,23 @@ struct Converter<DataDrivenPropertyValue<T>> {
             if (!constant) {
                 return constant.error();
             }
-            return DataDrivenPropertyValue<T>(*constant);
+            return DataDrivenPropertyValue<T>(std::move(*constant));
         } else if (!objectMember(value, "property")) {
             Result<CameraFunction<T>> function = convert<CameraFunction<T>>(value);
             if (!function) {
                 return function.error();
             }
-            return DataDrivenPropertyValue<T>(*function);
+            return DataDrivenPropertyValue<T>(std::move(*function));
         } else {
             Result<CompositeFunction<T>> composite = convert<CompositeFunction<T>>(value);
             if (composite) {
-                return DataDrivenPropertyValue<T>(*composite);
+                return DataDrivenPropertyValue<T>(std::move(*composite));
             }
             Result<SourceFunction<T>> source = convert<SourceFunction<T>>(value);
             if (!source) {
                 return source.error();
             }
-            return DataDrivenPropertyValue<T>(*source);
+            return DataDrivenPropertyValue<T>(std::move(*source));
         }
     }
 };
@@ -58,11 +58,11 @@ public:
     }
 
 private:
-    Result<Value> normalizeValue(const std::string& key, const optional<Value>& value) const {
+    Result<Value> normalizeValue(const std::string& key, optional<Value>&& value) const {
         if (!value) {
             return Error { "filter expression value must be a boolean, number, or string" };
         } else if (key != "$type") {
-            return *value;
+            return std::move(*value);
         } else if (*value == std::string("Point")) {
             return Value(uint64_t(FeatureType::Point));
         } else if (*value == std::string("LineString")) {
@@ -85,7 +85,7 @@ private:
             return Error { "filter expression key must be a string" };
         }
 
-        return FilterType { *key };
+        return FilterType { std::move(*key) };
     }
 
     template <class FilterType, class V>
@@ -104,7 +104,7 @@ private:
             return filterValue.error();
         }
 
-        return FilterType { *key, *filterValue };
+        return FilterType { std::move(*key), std::move(*filterValue) };
     }
 
     template <class FilterType, class V>
@@ -119,26 +119,28 @@ private:
         }
 
         std::vector<Value> values;
+        values.reserve(arrayLength(value) - 2);
         for (std::size_t i = 2; i < arrayLength(value); ++i) {
             Result<Value> filterValue = normalizeValue(*key, toValue(arrayMember(value, i)));
             if (!filterValue) {
                 return filterValue.error();
             }
-            values.push_back(*filterValue);
+            values.push_back(std::move(*filterValue));
         }
 
-        return FilterType { *key, std::move(values) };
+        return FilterType { std::move(*key), std::move(values) };
     }
 
     template <class FilterType, class V>
     Result<Filter> convertCompoundFilter(const V& value) const {
         std::vector<Filter> filters;
+        filters.reserve(arrayLength(value) - 1);
         for (std::size_t i = 1; i < arrayLength(value); ++i) {
             Result<Filter> element = operator()(arrayMember(value, i));
             if (!element) {
                 return element.error();
             }
-            filters.push_back(*element);
+            filters.push_back(std::move(*element));
         }
 
         return FilterType { std::move(filters) };
@@ -48,7 +48,7 @@ Result<std::map<D, R>> convertStops(const V& value) {
             return r.error();
         }
 
-        stops.emplace(*d, *r);
+        stops.emplace(std::move(*d), std::move(*r));
     }
 
     return stops;
@@ -67,7 +67,7 @@ struct Converter<ExponentialStops<T>> {
 
         auto baseValue = objectMember(value, "base");
         if (!baseValue) {
-            return ExponentialStops<T>(*stops);
+            return ExponentialStops<T>(std::move(*stops));
         }
 
         optional<float> base = toNumber(*baseValue);
@@ -75,7 +75,7 @@ struct Converter<ExponentialStops<T>> {
             return Error { "function base must be a number"};
         }
 
-        return ExponentialStops<T>(*stops, *base);
+        return ExponentialStops<T>(std::move(*stops), *base);
     }
 };
 
@@ -89,7 +89,7 @@ struct Converter<IntervalStops<T>> {
         if (!stops) {
             return stops.error();
         }
-        return IntervalStops<T>(*stops);
+        return IntervalStops<T>(std::move(*stops));
     }
 };
 
@@ -109,7 +109,7 @@ struct Converter<CategoricalValue> {
 
         auto s = toString(value);
         if (s) {
-            return *s;
+            return std::move(*s);
         }
 
         return Error { "stop domain value must be a number, string, or boolean" };
@@ -126,8 +126,7 @@ struct Converter<CategoricalStops<T>> {
         if (!stops) {
             return stops.error();
         }
-        return CategoricalStops<T>(
-            std::map<CategoricalValue, T>((*stops).begin(), (*stops).end()));
+        return CategoricalStops<T>(std::move(*stops));
     }
 };
 
@@ -152,8 +151,11 @@ public:
         std::string type = util::Interpolatable<T> ? "exponential" : "interval";
 
         auto typeValue = objectMember(value, "type");
-        if (typeValue && toString(*typeValue)) {
-            type = *toString(*typeValue);
+        if (typeValue) {
+            optional<std::string> typeString = toString(*typeValue);
+            if (typeString) {
+                type = std::move(*typeString);
+            }
         }
 
         optional<Result<variant<Ts...>>> result;
@@ -164,7 +166,7 @@ public:
             if (type == Converter<Stops>::type) {
                 auto stops = convert<Stops>(value);
                 result = stops
-                    ? Result<variant<Ts...>>(*stops)
+                    ? Result<variant<Ts...>>(std::move(*stops))
                     : Result<variant<Ts...>>(stops.error());
             }
         };
@@ -177,7 +179,7 @@ public:
             return Error { "unsupported function type" };
         }
 
-        return *result;
+        return std::move(*result);
     }
 };
 
@@ -194,7 +196,7 @@ struct Converter<CameraFunction<T>> {
             return stops.error();
         }
 
-        return CameraFunction<T>(*stops);
+        return CameraFunction<T>(std::move(*stops));
     }
 };
 
@@ -210,7 +212,7 @@ Result<optional<T>> convertDefaultValue(const V& value) {
         return Error { "wrong type for \"default\": " + defaultValue.error().message };
     }
 
-    return *defaultValue;
+    return std::move(*defaultValue);
 }
 
 template <class T>
@@ -241,7 +243,7 @@ struct Converter<SourceFunction<T>> {
             return defaultValue.error();
         }
 
-        return SourceFunction<T>(*propertyString, *stops, *defaultValue);
+        return SourceFunction<T>(std::move(*propertyString), std::move(*stops), std::move(*defaultValue));
     }
 };
 
@@ -278,7 +280,7 @@ struct Converter<CompositeValue<S>> {
             return s.error();
         }
 
-        return CompositeValue<S> { *z, *s };
+        return CompositeValue<S> { *z, std::move(*s) };
     }
 };
 
@@ -307,8 +309,11 @@ struct Converter<CompositeFunction<T>> {
 
         std::string type = "exponential";
         auto typeValue = objectMember(value, "type");
-        if (typeValue && toString(*typeValue)) {
-            type = *toString(*typeValue);
+        if (typeValue) {
+            optional<std::string> typeString = toString(*typeValue);
+            if (typeString) {
+                type = std::move(*typeString);
+            }
         }
 
         if (type == "exponential") {
@@ -324,13 +329,13 @@ struct Converter<CompositeFunction<T>> {
             }
 
             std::map<float, ExponentialStops<T>> convertedStops;
-            for (const auto& stop : *stops) {
+            for (auto& stop : *stops) {
                 auto& inner = convertedStops[stop.first.first];
                 inner.base = base;
-                inner.stops.emplace(stop.first.second, stop.second);
+                inner.stops.emplace(stop.first.second, std::move(stop.second));
             }
 
-            return CompositeFunction<T>(*propertyString, convertedStops, *defaultValue);
+            return CompositeFunction<T>(std::move(*propertyString), std::move(convertedStops), std::move(*defaultValue));
         } else if (type == "interval") {
             auto stops = convertStops<CompositeValue<float>, T>(value);
             if (!stops) {
@@ -338,12 +343,12 @@ struct Converter<CompositeFunction<T>> {
             }
 
             std::map<float, IntervalStops<T>> convertedStops;
-            for (const auto& stop : *stops) {
+            for (auto& stop : *stops) {
                 auto& inner = convertedStops[stop.first.first];
-                inner.stops.emplace(stop.first.second, stop.second);
+                inner.stops.emplace(stop.first.second, std::move(stop.second));
             }
 
-            return CompositeFunction<T>(*propertyString, convertedStops, *defaultValue);
+            return CompositeFunction<T>(std::move(*propertyString), std::move(convertedStops), std::move(*defaultValue));
         } else if (type == "categorical") {
             auto stops = convertStops<CompositeValue<CategoricalValue>, T>(value);
             if (!stops) {
@@ -351,12 +356,12 @@ struct Converter<CompositeFunction<T>> {
             }
 
             std::map<float, CategoricalStops<T>> convertedStops;
-            for (const auto& stop : *stops) {
+            for (auto& stop : *stops) {
                 auto& inner = convertedStops[stop.first.first];
-                inner.stops.emplace(stop.first.second, stop.second);
+                inner.stops.emplace(stop.first.second, std::move(stop.second));
             }
 
-            return CompositeFunction<T>(*propertyString, convertedStops, *defaultValue);
+            return CompositeFunction<T>(std::move(*propertyString), std::move(convertedStops), std::move(*defaultValue));
         } else {
             return Error { "unsupported function type" };
         }
@@ -68,6 +68,15 @@ struct Converter<GeoJSONOptions> {
             }
         }
 
+        const auto clusterMinZoomValue = objectMember(value, "clusterMinZoom");
+        if (clusterMinZoomValue) {
+            if (toNumber(*clusterMinZoomValue)) {
+                options.clusterMinZoom = static_cast<uint8_t>(*toNumber(*clusterMinZoomValue));
+            } else {
+                return Error{ "GeoJSON source clusterMinZoom value must be a number" };
+            }
+        }
+
         return { options };
     }
 
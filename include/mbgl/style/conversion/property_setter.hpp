@@ -32,7 +32,7 @@ auto makePropertySetter(void (L::*setter)(PropertyValue, const Args&...args)) {
             return typedValue.error();
         }
 
-        (typedLayer->*setter)(*typedValue, args...);
+        (typedLayer->*setter)(std::move(*typedValue), args...);
         return {};
     };
 }
@@ -20,13 +20,13 @@ struct Converter<PropertyValue<T>> {
             if (!function) {
                 return function.error();
             }
-            return *function;
+            return std::move(*function);
         } else {
             Result<T> constant = convert<T>(value);
             if (!constant) {
                 return constant.error();
             }
-            return *constant;
+            return std::move(*constant);
         }
     }
 };
@@ -53,7 +53,7 @@ private:
             if (!tileset) {
                 return tileset.error();
             }
-            return *tileset;
+            return std::move(*tileset);
         }
 
         optional<std::string> url = toString(*urlVal);
@@ -61,7 +61,7 @@ private:
             return Error{ "source url must be a string" };
         }
 
-        return *url;
+        return std::move(*url);
     }
 
     template <class V>
@@ -117,8 +117,8 @@ private:
                 return geoJSON.error();
             }
             result->setGeoJSON(std::move(*geoJSON));
-        } else if (toString(*dataValue)) {
-            result->setURL(*toString(*dataValue));
+        } else if (optional<std::string> url = toString(*dataValue)) {
+            result->setURL(*url);
         } else {
             return Error{ "GeoJSON data must be a URL or an object" };
         }
@@ -39,6 +39,14 @@ public:
             }
         }
 
+        auto encodingValue = objectMember(value, "encoding");
+        if (encodingValue) {
+            optional<std::string> encoding = toString(*encodingValue);
+            if (encoding && *encoding == "terrain-rgb") {
+                result.encoding = Tileset::Encoding::TerrainRGB;
+            }
+        }
+
         auto minzoomValue = objectMember(value, "minzoom");
         if (minzoomValue) {
             optional<float> minzoom = toNumber(*minzoomValue);
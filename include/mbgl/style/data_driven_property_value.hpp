@@ -42,6 +42,14 @@ public:
         return value.template is<Undefined>();
     }
 
+    bool isConstant() const {
+        return value.template is<T>();
+    }
+
+    const T& asConstant() const {
+        return value.template get<T>();
+    }
+
     bool isDataDriven() const {
         return value.template is<SourceFunction<T>>() || value.template is<CompositeFunction<T>>();
     }
@@ -205,5 +205,43 @@ bool Filter::operator()(FeatureType type, optional<FeatureIdentifier> id, Proper
     return FilterBase::visit(*this, FilterEvaluator<PropertyAccessor> { type, id, accessor });
 }
 
+/*
+   A visitor that reports whether a `Filter` ever inspects a given property
+   key. Checked once per layer group per tile, so the per-feature filter loop
+   can skip materializing feature state — notably the "$id" identifier, whose
+   construction may copy a string id — that no leaf of the filter looks at.
+*/
+class FilterKeyUsage {
+public:
+    const std::string& key;
+
+    bool operator()(const NullFilter&) const { return false; }
+
+    bool operator()(const EqualsFilter& filter) const { return filter.key == key; }
+    bool operator()(const NotEqualsFilter& filter) const { return filter.key == key; }
+    bool operator()(const LessThanFilter& filter) const { return filter.key == key; }
+    bool operator()(const LessThanEqualsFilter& filter) const { return filter.key == key; }
+    bool operator()(const GreaterThanFilter& filter) const { return filter.key == key; }
+    bool operator()(const GreaterThanEqualsFilter& filter) const { return filter.key == key; }
+    bool operator()(const InFilter& filter) const { return filter.key == key; }
+    bool operator()(const NotInFilter& filter) const { return filter.key == key; }
+    bool operator()(const HasFilter& filter) const { return filter.key == key; }
+    bool operator()(const NotHasFilter& filter) const { return filter.key == key; }
+
+    bool operator()(const AnyFilter& filter) const { return anyReference(filter.filters); }
+    bool operator()(const AllFilter& filter) const { return anyReference(filter.filters); }
+    bool operator()(const NoneFilter& filter) const { return anyReference(filter.filters); }
+
+private:
+    bool anyReference(const std::vector<Filter>& filters) const {
+        for (const auto& filter : filters) {
+            if (Filter::visit(filter, *this)) {
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
 } // namespace style
 } // namespace mbgl
@@ -73,10 +73,9 @@ public:
         );
     }
 
-    Range<T> evaluate(Range<InnerStops> coveringStops,
-                      const GeometryTileFeature& feature,
+    Range<T> evaluate(const Range<InnerStops>& coveringStops,
+                      const optional<Value>& v,
                       T finalDefaultValue) const {
-        optional<Value> v = feature.getValue(property);
         if (!v) {
             return {
                 defaultValue.value_or(finalDefaultValue),
@@ -92,6 +91,12 @@ public:
         };
     }
 
+    Range<T> evaluate(Range<InnerStops> coveringStops,
+                      const GeometryTileFeature& feature,
+                      T finalDefaultValue) const {
+        return evaluate(coveringStops, feature.getValue(property), finalDefaultValue);
+    }
+
     T evaluate(float zoom, const GeometryTileFeature& feature, T finalDefaultValue) const {
         std::tuple<Range<float>, Range<InnerStops>> ranges = coveringRanges(zoom);
         Range<T> resultRange = evaluate(std::get<1>(ranges), feature, finalDefaultValue);
@@ -33,14 +33,26 @@ public:
             return T();
         }
 
-        auto it = stops.upper_bound(*z);
+        return evaluate(*z);
+    }
+
+    // Fast path for zoom evaluation: every zoom function of every layer is
+    // re-evaluated per frame during zoom animations, so skip boxing the input
+    // in a Value and unboxing it again.
+    T evaluate(float z) const {
+        if (stops.empty()) {
+            assert(false);
+            return T();
+        }
+
+        auto it = stops.upper_bound(z);
         if (it == stops.end()) {
             return stops.rbegin()->second;
         } else if (it == stops.begin()) {
             return stops.begin()->second;
         } else {
             return util::interpolate(std::prev(it)->second, it->second,
-                util::interpolationFactor(base, { std::prev(it)->first, it->first }, *z));
+                util::interpolationFactor(base, { std::prev(it)->first, it->first }, z));
         }
     }
 
@@ -29,7 +29,18 @@ public:
             return {};
         }
 
-        auto it = stops.upper_bound(*z);
+        return evaluate(*z);
+    }
+
+    // Fast path for zoom evaluation that avoids the Value round-trip; see
+    // ExponentialStops::evaluate(float).
+    T evaluate(float z) const {
+        if (stops.empty()) {
+            assert(false);
+            return T();
+        }
+
+        auto it = stops.upper_bound(z);
         if (it == stops.end()) {
             return stops.rbegin()->second;
         } else if (it == stops.begin()) {
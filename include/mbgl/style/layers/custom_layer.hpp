@@ -1,6 +1,7 @@
 #pragma once
 
 #include <mbgl/style/layer.hpp>
+#include <mbgl/util/traits.hpp>
 
 namespace mbgl {
 namespace style {
@@ -46,6 +47,41 @@ using CustomLayerRenderFunction = void (*)(void* context, const CustomLayerRende
  */
 using CustomLayerDeinitializeFunction = void (*)(void* context);
 
+/**
+ * Describes which groups of GL state a custom layer's render function may
+ * modify. By default every group is assumed touched and the renderer
+ * invalidates its entire cached GL state after the layer draws, re-issuing
+ * state calls lazily afterwards. A layer that declares a narrower mask via
+ * CustomLayer::setStateMask keeps the rest of the cache valid, so drawing it
+ * costs no more state churn than a built-in layer. Declaring a group the
+ * render function does in fact modify causes undefined rendering.
+ */
+enum class CustomLayerStateMask : uint32_t {
+    None     = 0,
+    Stencil  = 1 << 0, // stencil func/mask/op and test enable
+    Depth    = 1 << 1, // depth range/mask/func and test enable
+    Blend    = 1 << 2, // blend enable/equation/func/color and color mask
+    Clear    = 1 << 3, // clear color/depth/stencil values
+    Program  = 1 << 4, // the bound program
+    Buffers  = 1 << 5, // vertex/index buffer bindings, VAOs, vertex attributes
+    Textures = 1 << 6, // active texture unit and texture bindings
+    Viewport = 1 << 7, // the viewport or framebuffer binding
+    Other    = 1 << 8, // line width, pixel store/transfer state
+    All      = ~0u,
+};
+
+constexpr CustomLayerStateMask operator|(CustomLayerStateMask lhs, CustomLayerStateMask rhs) {
+    return CustomLayerStateMask(mbgl::underlying_type(lhs) | mbgl::underlying_type(rhs));
+}
+
+constexpr CustomLayerStateMask& operator|=(CustomLayerStateMask& lhs, CustomLayerStateMask rhs) {
+    return (lhs = lhs | rhs);
+}
+
+constexpr bool operator&(CustomLayerStateMask lhs, CustomLayerStateMask rhs) {
+    return mbgl::underlying_type(lhs) & mbgl::underlying_type(rhs);
+}
+
 class CustomLayer : public Layer {
 public:
     CustomLayer(const std::string& id,
@@ -55,6 +91,10 @@ public:
                 void* context);
     ~CustomLayer() final;
 
+    // Declares which GL state groups the render function may modify; see
+    // CustomLayerStateMask. Defaults to All.
+    void setStateMask(CustomLayerStateMask);
+
     // Private implementation
 
     class Impl;
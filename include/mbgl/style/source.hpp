@@ -53,6 +53,14 @@ public:
 
     optional<std::string> getAttribution() const;
 
+    // When enabled, the low-zoom (z0–z5) ancestors of the current viewport are
+    // fetched and retained in addition to the regular tile cover. The ancestor
+    // pyramid is tiny, but it guarantees the parent-fallback path has something
+    // to draw immediately after a jump to an area that has never been viewed,
+    // instead of showing the background color until the ideal tiles arrive.
+    void setPrefetchLowZoomAncestors(bool);
+    bool getPrefetchLowZoomAncestors() const;
+
     // Private implementation
     class Impl;
     const std::unique_ptr<Impl> baseImpl;
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <mbgl/style/source.hpp>
+#include <mbgl/util/feature.hpp>
 #include <mbgl/util/geojson.hpp>
 #include <mbgl/util/optional.hpp>
 
@@ -34,6 +35,7 @@ struct GeoJSONOptions {
     bool cluster = false;
     uint16_t clusterRadius = 50;
     uint8_t clusterMaxZoom = 17;
+    uint8_t clusterMinZoom = 0;
 };
 
 class GeoJSONSource : public Source {
@@ -43,6 +45,23 @@ public:
     void setURL(const std::string& url);
     void setGeoJSON(const GeoJSON&);
 
+    // Appends a batch of features to the source's current feature collection
+    // and rebuilds the tile index on a background thread, swapping it in once
+    // it is ready. Unlike setGeoJSON(), this never blocks the map thread on
+    // indexing, so large frequently-updated overlays stay interactive. On
+    // clustered sources, appended points show up immediately as individual
+    // points and merge into the clusters once the rebuild lands.
+    void appendFeatures(FeatureCollection);
+
+    // Replaces the feature whose id matches the given feature's id, or adds
+    // it if no such feature exists. Only tiles intersecting the feature's old
+    // and new positions are regenerated; everything else keeps its data.
+    void updateFeature(Feature);
+
+    // Removes the feature with the given id, if any, regenerating only the
+    // tiles it intersected.
+    void removeFeature(const FeatureIdentifier&);
+
     optional<std::string> getURL() const;
 
     // Private implementation
@@ -8,5 +8,15 @@ namespace util {
 std::string compress(const std::string& raw);
 std::string decompress(const std::string& raw);
 
+// Inflates into a caller-provided buffer -- e.g. one recycled from
+// util::BufferPool -- appending to whatever it already holds.
+void decompress(const std::string& raw, std::string& result);
+
+// Whether the buffer starts with a valid zlib header, i.e. looks like the
+// output of compress(). Vector tile and image payloads never do: pbf buffers
+// begin with a tag byte whose wire type rules out 0x78, and image magic
+// numbers fail the header checksum.
+bool isCompressed(const std::string& raw);
+
 } // namespace util
 } // namespace mbgl
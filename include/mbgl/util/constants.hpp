@@ -42,6 +42,11 @@ constexpr uint64_t DEFAULT_MAX_CACHE_SIZE = 50 * 1024 * 1024;
 
 constexpr Duration DEFAULT_FADE_DURATION = Milliseconds(300);
 constexpr Seconds CLOCK_SKEW_RETRY_TIMEOUT { 30 };
+constexpr Seconds REFRESH_AHEAD_WINDOW { 30 };
+
+// Upper bound on simultaneous transfers to a single host, so that one slow
+// server cannot occupy every connection slot. See OnlineFileSource.
+constexpr uint32_t MAXIMUM_CONCURRENT_REQUESTS_PER_HOST = 6;
 
 constexpr UnitBezier DEFAULT_TRANSITION_EASE = { 0, 0, 0.25, 1 };
 
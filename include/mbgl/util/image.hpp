@@ -68,7 +68,13 @@ using PremultipliedImage = Image<ImageAlphaMode::Premultiplied>;
 using AlphaImage = Image<ImageAlphaMode::Exclusive>;
 
 // TODO: don't use std::string for binary data.
-PremultipliedImage decodeImage(const std::string&);
+//
+// `maxSize` is an optional decode-time downsampling hint: when non-zero,
+// decoders that can downsample cheaply (JPEG, WebP) reduce the output by a
+// power of two as long as the longer edge stays at or above `maxSize` pixels.
+// Decoders without cheap downsampling (PNG) ignore the hint, so callers must
+// cope with an image of either size.
+PremultipliedImage decodeImage(const std::string&, uint32_t maxSize = 0);
 std::string encodePNG(const PremultipliedImage&);
 
 } // namespace mbgl
@@ -23,6 +23,11 @@ void setCurrentThreadName(const std::string& name);
 // Makes the current thread low priority.
 void makeThreadLowPriority();
 
+// Makes the current thread high priority, where the platform permits it. On
+// heterogeneous (big.LITTLE) devices this also steers the scheduler towards
+// the faster cores.
+void makeThreadHighPriority();
+
 // Shows an alpha image with the specified dimensions in a named window.
 void showDebugImage(std::string name, const char *data, size_t width, size_t height);
 
@@ -12,10 +12,18 @@ class Tileset {
 public:
     enum class Scheme : bool { XYZ, TMS };
 
+    // How raster tile payloads are to be interpreted after image decode.
+    // TerrainRGB tiles carry elevations packed into the color channels
+    // (height = -10000 + (R * 256 * 256 + G * 256 + B) * 0.1 meters) and are
+    // converted to a height texture on the worker instead of being drawn as
+    // imagery.
+    enum class Encoding : bool { RGBA, TerrainRGB };
+
     std::vector<std::string> tiles;
     Range<uint8_t> zoomRange { 0, 22 };
     std::string attribution;
     Scheme scheme = Scheme::XYZ;
+    Encoding encoding = Encoding::RGBA;
 
     // TileJSON also includes center, zoom, and bounds, but they are not used by mbgl.
 };
@@ -8,7 +8,8 @@
 
 namespace mbgl {
 
-PremultipliedImage decodeImage(const std::string& string) {
+// BitmapFactory decodes at full resolution; the downsampling hint is unused.
+PremultipliedImage decodeImage(const std::string& string, uint32_t) {
     auto env{ android::AttachEnv() };
 
     auto array = jni::Array<jni::jbyte>::New(*env, string.size());
@@ -33,5 +33,13 @@ void makeThreadLowPriority() {
     setpriority(PRIO_PROCESS, 0, 19);
 }
 
+void makeThreadHighPriority() {
+    // ANDROID_PRIORITY_DISPLAY = -4
+    //
+    // Same per-thread behavior as above. On big.LITTLE devices the elevated
+    // priority also makes the scheduler prefer the big cores for this thread.
+    setpriority(PRIO_PROCESS, 0, -4);
+}
+
 } // namespace platform
 } // namespace mbgl
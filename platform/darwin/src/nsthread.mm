@@ -22,5 +22,9 @@ void makeThreadLowPriority() {
     [[NSThread currentThread] setThreadPriority:0.0];
 }
 
+void makeThreadHighPriority() {
+    pthread_set_qos_class_self_np(QOS_CLASS_USER_INTERACTIVE, 0);
+}
+
 }
 }
@@ -1,4 +1,7 @@
+#include <list>
+#include <map>
 #include <memory>
+#include <utility>
 
 #include <mbgl/text/bidi.hpp>
 #include <unicode/ubidi.h>
@@ -6,6 +9,24 @@
 
 namespace mbgl {
 
+namespace {
+
+// u_shapeArabic with the flags we pass only rewrites characters from the
+// Arabic blocks; everything else comes back unchanged. Most labels contain no
+// such characters, so detect that up front and skip ICU entirely.
+bool needsArabicShaping(const std::u16string& input) {
+    for (char16_t chr : input) {
+        if ((chr >= 0x0600 && chr <= 0x08FF) || // Arabic, Supplement, Extended-A
+            (chr >= 0xFB50 && chr <= 0xFDFF) || // Arabic Presentation Forms-A
+            (chr >= 0xFE70 && chr <= 0xFEFF)) { // Arabic Presentation Forms-B
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace
+
 class BiDiImpl {
 public:
     BiDiImpl() : bidiText(ubidi_open()), bidiLine(ubidi_open()) {
@@ -25,6 +46,24 @@ BiDi::~BiDi() = default;
 // Takes UTF16 input in logical order and applies Arabic shaping to the input while maintaining
 // logical order. Output won't be intelligible until the bidirectional algorithm is applied
 std::u16string applyArabicShaping(const std::u16string& input) {
+    if (!needsArabicShaping(input)) {
+        return input;
+    }
+
+    // Arabic labels repeat across features and tiles like any other labels;
+    // keep a small per-thread cache of shaped results, with least-recently-
+    // used eviction. Thread-local so worker threads don't contend on it.
+    using Order = std::list<std::u16string>;
+    static thread_local Order order; // Most recently used first.
+    static thread_local std::map<std::u16string, std::pair<std::u16string, Order::iterator>> cache;
+    const std::size_t maximumCacheSize = 512;
+
+    auto cached = cache.find(input);
+    if (cached != cache.end()) {
+        order.splice(order.begin(), order, cached->second.second);
+        return cached->second.first;
+    }
+
     UErrorCode errorCode = U_ZERO_ERROR;
 
     const int32_t outputLength =
@@ -43,10 +82,27 @@ std::u16string applyArabicShaping(const std::u16string& input) {
                   &errorCode);
 
     // If the algorithm fails for any reason, fall back to non-transformed text
-    if (U_FAILURE(errorCode))
-        return input;
+    std::u16string shaped = U_FAILURE(errorCode)
+                                ? input
+                                : std::u16string(outputText.get(), outputLength);
+
+    order.push_front(input);
+    cache.emplace(input, std::make_pair(shaped, order.begin()));
+    if (cache.size() > maximumCacheSize) {
+        cache.erase(order.back());
+        order.pop_back();
+    }
 
-    return std::u16string(outputText.get(), outputLength);
+    return shaped;
+}
+
+void prewarmBiDi() {
+    // ICU initialization (mapping the data file, building converter tables)
+    // is process-wide and happens on first use. Opening a pair of UBiDi
+    // objects and shaping one Arabic letter touches everything the worker
+    // threads will need, so the first real label doesn't pay for it.
+    BiDiImpl warm;
+    applyArabicShaping(u"\u0645"); // ARABIC LETTER MEEM
 }
 
 void BiDi::mergeParagraphLineBreaks(std::set<size_t>& lineBreakPoints) {
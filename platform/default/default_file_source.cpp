@@ -4,13 +4,18 @@
 #include <mbgl/storage/online_file_source.hpp>
 #include <mbgl/storage/offline_database.hpp>
 #include <mbgl/storage/offline_download.hpp>
+#include <mbgl/storage/offline_pack.hpp>
 
 #include <mbgl/util/platform.hpp>
 #include <mbgl/util/url.hpp>
 #include <mbgl/util/thread.hpp>
 #include <mbgl/util/work_request.hpp>
+#include <mbgl/util/run_loop.hpp>
 
+#include <algorithm>
 #include <cassert>
+#include <list>
+#include <sstream>
 
 namespace {
 
@@ -20,6 +25,79 @@ bool isAssetURL(const std::string& url) {
     return std::equal(assetProtocol.begin(), assetProtocol.end(), url.begin());
 }
 
+// The session journal remembers which resources the previous run requested and
+// is replayed against the database on the next launch, so that the sqlite pages
+// holding the last viewport are back in the page cache before the style has
+// finished loading and the real lookups arrive. It is stored in the offline
+// database itself, under a reserved URL that no real request can produce.
+const std::size_t maxSessionJournalEntries = 256;
+
+mbgl::Resource sessionJournalResource() {
+    return { mbgl::Resource::Unknown, "mapbox://journal/last-session" };
+}
+
+std::string sessionJournalKey(const mbgl::Resource& resource) {
+    if (resource.kind == mbgl::Resource::Kind::Tile && resource.tileData) {
+        return resource.tileData->urlTemplate
+            + "/" + std::to_string(resource.tileData->pixelRatio)
+            + "/" + std::to_string(resource.tileData->z)
+            + "/" + std::to_string(resource.tileData->x)
+            + "/" + std::to_string(resource.tileData->y);
+    }
+    return std::to_string(uint32_t(resource.kind)) + "/" + resource.url;
+}
+
+// One resource per line; the URL goes last because it is the only field that
+// is not a number.
+//   tile <pixelRatio> <z> <x> <y> <urlTemplate>
+//   res <kind> <url>
+std::string serializeSessionJournal(const std::list<mbgl::Resource>& journal) {
+    std::ostringstream stream;
+    for (const auto& resource : journal) {
+        if (resource.kind == mbgl::Resource::Kind::Tile && resource.tileData) {
+            stream << "tile " << uint32_t(resource.tileData->pixelRatio)
+                   << ' ' << int32_t(resource.tileData->z)
+                   << ' ' << resource.tileData->x
+                   << ' ' << resource.tileData->y
+                   << ' ' << resource.tileData->urlTemplate << '\n';
+        } else {
+            stream << "res " << uint32_t(resource.kind) << ' ' << resource.url << '\n';
+        }
+    }
+    return stream.str();
+}
+
+std::vector<mbgl::Resource> deserializeSessionJournal(const std::string& data) {
+    std::vector<mbgl::Resource> resources;
+    std::istringstream stream(data);
+    std::string line;
+    while (std::getline(stream, line)) {
+        std::istringstream entry(line);
+        std::string type;
+        entry >> type;
+        if (type == "tile") {
+            uint32_t pixelRatio;
+            int32_t z, x, y;
+            std::string urlTemplate;
+            entry >> pixelRatio >> z >> x >> y >> urlTemplate;
+            if (!entry) {
+                continue;
+            }
+            resources.emplace_back(mbgl::Resource::Kind::Tile, "",
+                mbgl::Resource::TileData{ urlTemplate, uint8_t(pixelRatio), x, y, int8_t(z) });
+        } else if (type == "res") {
+            uint32_t kind;
+            std::string url;
+            entry >> kind >> url;
+            if (!entry || kind > mbgl::Resource::Kind::SpriteJSON) {
+                continue;
+            }
+            resources.emplace_back(mbgl::Resource::Kind(kind), std::move(url));
+        }
+    }
+    return resources;
+}
+
 } // namespace
 
 namespace mbgl {
@@ -28,6 +106,22 @@ class DefaultFileSource::Impl {
 public:
     Impl(const std::string& cachePath, uint64_t maximumCacheSize)
         : offlineDatabase(cachePath, maximumCacheSize) {
+        // Deferred so that synchronous startup calls (access token, base URL)
+        // aren't queued behind the database reads; the replay still runs well
+        // before the style has loaded and the first tile requests arrive.
+        util::RunLoop::Get()->invoke([this] { warmSessionJournal(); });
+    }
+
+    ~Impl() {
+        try {
+            if (!sessionJournal.empty()) {
+                Response journal;
+                journal.data = std::make_shared<std::string>(serializeSessionJournal(sessionJournal));
+                offlineDatabase.put(sessionJournalResource(), journal);
+            }
+        } catch (...) {
+            // Losing the journal only costs the next launch its warm-up.
+        }
     }
 
     void setAPIBaseURL(const std::string& url) {
@@ -46,6 +140,10 @@ public:
         return onlineFileSource.getAccessToken();
     }
 
+    void setMaximumConcurrentRequestsPerHost(uint32_t limit) {
+        onlineFileSource.setMaximumConcurrentRequestsPerHost(limit);
+    }
+
     void listRegions(std::function<void (std::exception_ptr, optional<std::vector<OfflineRegion>>)> callback) {
         try {
             callback({}, offlineDatabase.listRegions());
@@ -101,27 +199,75 @@ public:
     }
 
     void request(AsyncRequest* req, Resource resource, Callback callback) {
-        Resource revalidation = resource;
+        recordSessionResource(resource);
 
         const bool hasPrior = resource.priorEtag || resource.priorModified || resource.priorExpires;
-        if (!hasPrior || resource.necessity == Resource::Optional) {
-            auto offlineResponse = offlineDatabase.get(resource);
-
-            if (resource.necessity == Resource::Optional && !offlineResponse) {
-                // Ensure there's always a response that we can send, so the caller knows that
-                // there's no optional data available in the cache.
-                offlineResponse.emplace();
-                offlineResponse->noContent = true;
-                offlineResponse->error = std::make_unique<Response::Error>(
-                    Response::Error::Reason::NotFound, "Not found in offline database");
+        const bool needsOfflineLookup = !hasPrior || resource.necessity == Resource::Optional;
+
+        if (needsOfflineLookup && resource.kind == Resource::Kind::Tile) {
+            // A pan typically queues a dozen tile requests at once; rather
+            // than issuing a database lookup per message, collect the tile
+            // requests that arrived within this run-loop iteration and answer
+            // them with a single batched query.
+            if (pendingTiles.empty()) {
+                util::RunLoop::Get()->invoke([this] { flushPendingTiles(); });
             }
+            pendingTiles.push_back({ req, std::move(resource), std::move(callback) });
+            return;
+        }
 
-            if (offlineResponse) {
-                revalidation.priorModified = offlineResponse->modified;
-                revalidation.priorExpires = offlineResponse->expires;
-                revalidation.priorEtag = offlineResponse->etag;
-                callback(*offlineResponse);
-            }
+        optional<Response> offlineResponse =
+            needsOfflineLookup ? offlineDatabase.get(resource) : optional<Response>();
+        if (needsOfflineLookup && !offlineResponse) {
+            offlineResponse = packGet(resource);
+        }
+
+        continueRequest(req, resource, std::move(callback), std::move(offlineResponse));
+    }
+
+    void flushPendingTiles() {
+        std::vector<PendingTile> batch;
+        batch.swap(pendingTiles);
+
+        if (batch.empty()) {
+            return;
+        }
+
+        std::vector<Resource> resources;
+        resources.reserve(batch.size());
+        for (const auto& pending : batch) {
+            resources.push_back(pending.resource);
+        }
+
+        auto offlineResponses = offlineDatabase.getTiles(resources);
+
+        for (std::size_t i = 0; i < batch.size(); i++) {
+            optional<Response> offlineResponse = offlineResponses[i]
+                ? optional<Response>(offlineResponses[i]->first)
+                : packGet(batch[i].resource);
+            continueRequest(batch[i].req, batch[i].resource, std::move(batch[i].callback),
+                            std::move(offlineResponse));
+        }
+    }
+
+    void continueRequest(AsyncRequest* req, const Resource& resource, Callback callback,
+                         optional<Response> offlineResponse) {
+        Resource revalidation = resource;
+
+        if (resource.necessity == Resource::Optional && !offlineResponse) {
+            // Ensure there's always a response that we can send, so the caller knows that
+            // there's no optional data available in the cache.
+            offlineResponse.emplace();
+            offlineResponse->noContent = true;
+            offlineResponse->error = std::make_unique<Response::Error>(
+                Response::Error::Reason::NotFound, "Not found in offline database");
+        }
+
+        if (offlineResponse) {
+            revalidation.priorModified = offlineResponse->modified;
+            revalidation.priorExpires = offlineResponse->expires;
+            revalidation.priorEtag = offlineResponse->etag;
+            callback(*offlineResponse);
         }
 
         if (resource.necessity == Resource::Required) {
@@ -132,7 +278,94 @@ public:
         }
     }
 
+    void mountPack(const std::string& path, std::function<void (std::exception_ptr)> callback) {
+        try {
+            packs.push_back(std::make_unique<OfflinePack>(path));
+            callback({});
+        } catch (...) {
+            callback(std::current_exception());
+        }
+    }
+
+    void exportRegion(int64_t regionID, const std::string& path, std::function<void (std::exception_ptr)> callback) {
+        try {
+            offlineDatabase.exportRegion(regionID, path);
+            callback({});
+        } catch (...) {
+            callback(std::current_exception());
+        }
+    }
+
+    // The database is authoritative; packs only answer when it has nothing,
+    // so a resource the device has since fetched shadows the baked-in copy.
+    optional<Response> packGet(const Resource& resource) {
+        for (const auto& pack : packs) {
+            try {
+                if (auto response = pack->get(resource)) {
+                    return response;
+                }
+            } catch (...) {
+                // A corrupt entry reads as a miss; the network path still works.
+            }
+        }
+        return {};
+    }
+
+    void recordSessionResource(const Resource& resource) {
+        auto key = sessionJournalKey(resource);
+        auto it = sessionJournalIndex.find(key);
+        if (it != sessionJournalIndex.end()) {
+            sessionJournal.splice(sessionJournal.begin(), sessionJournal, it->second);
+        } else {
+            sessionJournal.push_front(resource);
+            sessionJournalIndex.emplace(std::move(key), sessionJournal.begin());
+            if (sessionJournal.size() > maxSessionJournalEntries) {
+                sessionJournalIndex.erase(sessionJournalKey(sessionJournal.back()));
+                sessionJournal.pop_back();
+            }
+        }
+    }
+
+    void warmSessionJournal() {
+        optional<Response> journal;
+        try {
+            journal = offlineDatabase.get(sessionJournalResource());
+        } catch (...) {
+            return;
+        }
+        if (!journal || !journal->data) {
+            return;
+        }
+
+        // Look every journaled resource up and discard the result; the point
+        // is the side effect of the reads, which pull the relevant database
+        // pages into sqlite's and the operating system's caches while the map
+        // is still busy loading the style. Tiles go through the same batched
+        // query that live requests use.
+        std::vector<Resource> tiles;
+        for (auto& resource : deserializeSessionJournal(*journal->data)) {
+            try {
+                if (resource.kind == Resource::Kind::Tile) {
+                    tiles.push_back(std::move(resource));
+                } else {
+                    offlineDatabase.get(resource);
+                }
+            } catch (...) {
+                return;
+            }
+        }
+        if (!tiles.empty()) {
+            try {
+                offlineDatabase.getTiles(tiles);
+            } catch (...) {
+            }
+        }
+    }
+
     void cancel(AsyncRequest* req) {
+        pendingTiles.erase(std::remove_if(pendingTiles.begin(), pendingTiles.end(),
+                               [&] (const PendingTile& pending) { return pending.req == req; }),
+                           pendingTiles.end());
         tasks.erase(req);
     }
 
@@ -140,6 +373,13 @@ public:
         offlineDatabase.setOfflineMapboxTileCountLimit(limit);
     }
 
+    void setDownloadConcurrency(uint32_t concurrency) {
+        downloadConcurrency = concurrency;
+        for (auto& entry : downloads) {
+            entry.second->setConcurrency(concurrency);
+        }
+    }
+
     void put(const Resource& resource, const Response& response) {
         offlineDatabase.put(resource, response);
     }
@@ -150,14 +390,33 @@ private:
         if (it != downloads.end()) {
             return *it->second;
         }
-        return *downloads.emplace(regionID,
+        auto& download = *downloads.emplace(regionID,
             std::make_unique<OfflineDownload>(regionID, offlineDatabase.getRegionDefinition(regionID), offlineDatabase, onlineFileSource)).first->second;
+        if (downloadConcurrency) {
+            download.setConcurrency(*downloadConcurrency);
+        }
+        return download;
     }
 
+    struct PendingTile {
+        AsyncRequest* req;
+        Resource resource;
+        Callback callback;
+    };
+
     OfflineDatabase offlineDatabase;
     OnlineFileSource onlineFileSource;
+    std::vector<PendingTile> pendingTiles;
+    std::vector<std::unique_ptr<OfflinePack>> packs;
+
+    // Most recently requested resources, newest first, with an index for O(1)
+    // deduplication. Persisted on shutdown; see warmSessionJournal().
+    std::list<Resource> sessionJournal;
+    std::unordered_map<std::string, std::list<Resource>::iterator> sessionJournalIndex;
+
     std::unordered_map<AsyncRequest*, std::unique_ptr<AsyncRequest>> tasks;
     std::unordered_map<int64_t, std::unique_ptr<OfflineDownload>> downloads;
+    optional<uint32_t> downloadConcurrency;
 };
 
 DefaultFileSource::DefaultFileSource(const std::string& cachePath,
@@ -187,6 +446,10 @@ std::string DefaultFileSource::getAccessToken() const {
     return thread->invokeSync(&Impl::getAccessToken);
 }
 
+void DefaultFileSource::setMaximumConcurrentRequestsPerHost(uint32_t limit) {
+    thread->invokeSync(&Impl::setMaximumConcurrentRequestsPerHost, limit);
+}
+
 std::unique_ptr<AsyncRequest> DefaultFileSource::request(const Resource& resource, Callback callback) {
     class DefaultFileRequest : public AsyncRequest {
     public:
@@ -248,6 +511,19 @@ void DefaultFileSource::setOfflineMapboxTileCountLimit(uint64_t limit) const {
     thread->invokeSync(&Impl::setOfflineMapboxTileCountLimit, limit);
 }
 
+void DefaultFileSource::mountOfflinePack(const std::string& path, std::function<void (std::exception_ptr)> callback) {
+    thread->invoke(&Impl::mountPack, path, callback);
+}
+
+void DefaultFileSource::exportOfflineRegion(OfflineRegion& region, const std::string& path,
+                                            std::function<void (std::exception_ptr)> callback) {
+    thread->invoke(&Impl::exportRegion, region.getID(), path, callback);
+}
+
+void DefaultFileSource::setOfflineDownloadConcurrency(uint32_t concurrency) const {
+    thread->invokeSync(&Impl::setDownloadConcurrency, concurrency);
+}
+
 // For testing only:
 
 void DefaultFileSource::put(const Resource& resource, const Response& response) {
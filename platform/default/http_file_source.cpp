@@ -1,6 +1,7 @@
 #include <mbgl/storage/http_file_source.hpp>
 #include <mbgl/storage/resource.hpp>
 #include <mbgl/storage/response.hpp>
+#include <mbgl/util/buffer_pool.hpp>
 #include <mbgl/util/logging.hpp>
 
 #include <mbgl/util/util.hpp>
@@ -102,6 +103,13 @@ HTTPFileSource::Impl::Impl() {
     handleError(curl_multi_setopt(multi, CURLMOPT_SOCKETDATA, this));
     handleError(curl_multi_setopt(multi, CURLMOPT_TIMERFUNCTION, startTimeout));
     handleError(curl_multi_setopt(multi, CURLMOPT_TIMERDATA, this));
+#if LIBCURL_VERSION_NUM >= ((7) << 16 | (43) << 8 | 0) // CURLPIPE_MULTIPLEX was added in 7.43.0
+    // Multiplex requests to the same host over a single HTTP/2 connection
+    // when the server supports it, instead of opening parallel connections.
+    // A zoom burst of tile fetches then pays connection and TLS setup once,
+    // and a slow response doesn't head-of-line block the others.
+    handleError(curl_multi_setopt(multi, CURLMOPT_PIPELINING, CURLPIPE_MULTIPLEX));
+#endif
 }
 
 HTTPFileSource::Impl::~Impl() {
@@ -223,6 +231,24 @@ int HTTPFileSource::Impl::startTimeout(CURLM * /* multi */, long timeout_ms, voi
     return 0;
 }
 
+#if LIBCURL_VERSION_NUM >= ((7) << 16 | (46) << 8 | 0)
+// The HTTP/2 stream weight (1-256) for each scheduler priority, so that when
+// requests share a multiplexed connection, the server allocates bandwidth to
+// the blocking resources first: styles, sprites, and glyphs ahead of viewport
+// tiles, and those ahead of prefetched ancestor tiles.
+static long streamWeight(Resource::Priority priority) {
+    switch (priority) {
+    case Resource::High:
+        return 256;
+    case Resource::Regular:
+        return 64;
+    case Resource::Low:
+        return 16;
+    }
+    return 64;
+}
+#endif
+
 HTTPRequest::HTTPRequest(HTTPFileSource::Impl* context_, Resource resource_, FileSource::Callback callback_)
     : context(context_),
       resource(std::move(resource_)),
@@ -231,6 +257,13 @@ HTTPRequest::HTTPRequest(HTTPFileSource::Impl* context_, Resource resource_, Fil
 
     // If there's already a response, set the correct etags/modified headers to make sure we are
     // getting a 304 response if possible. This avoids redownloading unchanged data.
+    //
+    // Note on delta encoding (RFC 3229): revalidations that return 200 resend
+    // the whole body even when few bytes changed. Negotiating a delta against
+    // the prior etag (`A-IM` / 226) would avoid that, but it requires a diff
+    // codec we don't vendor, the stale body to be plumbed from the offline
+    // database into every platform HTTP stack, and server support for the
+    // instance-manipulation format — so it's deliberately not attempted here.
     if (resource.priorEtag) {
         const std::string header = std::string("If-None-Match: ") + *resource.priorEtag;
         headers = curl_slist_append(headers, header.c_str());
@@ -260,6 +293,14 @@ HTTPRequest::HTTPRequest(HTTPFileSource::Impl* context_, Resource resource_, Fil
 #endif
     handleError(curl_easy_setopt(handle, CURLOPT_USERAGENT, "MapboxGL/1.0"));
     handleError(curl_easy_setopt(handle, CURLOPT_SHARE, context->share));
+#if LIBCURL_VERSION_NUM >= ((7) << 16 | (47) << 8 | 0) // CURL_HTTP_VERSION_2TLS was added in 7.47.0
+    // Negotiate HTTP/2 on TLS connections; plain-text connections stay
+    // HTTP/1.1 rather than attempting an upgrade.
+    handleError(curl_easy_setopt(handle, CURLOPT_HTTP_VERSION, CURL_HTTP_VERSION_2TLS));
+#endif
+#if LIBCURL_VERSION_NUM >= ((7) << 16 | (46) << 8 | 0) // CURLOPT_STREAM_WEIGHT was added in 7.46.0
+    handleError(curl_easy_setopt(handle, CURLOPT_STREAM_WEIGHT, streamWeight(resource.priority)));
+#endif
 
     // Start requesting the information.
     handleError(curl_multi_add_handle(context->multi, handle));
@@ -283,7 +324,9 @@ size_t HTTPRequest::writeCallback(void *const contents, const size_t size, const
     auto impl = reinterpret_cast<HTTPRequest *>(userp);
 
     if (!impl->data) {
-        impl->data = std::make_shared<std::string>();
+        // Recycled from the response body pool; sizing by the first chunk
+        // picks a reasonable class and appends grow the buffer from there.
+        impl->data = util::BufferPool::acquire(size * nmemb);
     }
 
     impl->data->append((char *)contents, size * nmemb);
@@ -1,9 +1,8 @@
 #include <mbgl/util/image.hpp>
-#include <mbgl/util/char_array_buffer.hpp>
 
-#include <istream>
-#include <sstream>
-#include <array>
+#include <algorithm>
+#include <cstdio>
+#include <stdexcept>
 
 extern "C"
 {
@@ -12,62 +11,53 @@ extern "C"
 
 namespace mbgl {
 
-const static unsigned BUF_SIZE = 4096;
+// A source manager that serves the entire in-memory JPEG to the decompressor
+// as one zero-copy buffer, like libjpeg 8's jpeg_mem_src (which the oldest
+// libjpeg we support predates). The stream-style source this replaces copied
+// the already-in-memory data through an std::istream 4 KB at a time.
 
-struct jpeg_stream_wrapper {
-    jpeg_source_mgr manager;
-    std::istream* stream;
-    std::array<JOCTET, BUF_SIZE> buffer;
-};
-
-static void init_source(j_decompress_ptr cinfo) {
-    jpeg_stream_wrapper* wrap = reinterpret_cast<jpeg_stream_wrapper*>(cinfo->src);
-    wrap->stream->seekg(0, std::ios_base::beg);
-}
+static void init_source(j_decompress_ptr) {}
 
 static boolean fill_input_buffer(j_decompress_ptr cinfo) {
-    jpeg_stream_wrapper* wrap = reinterpret_cast<jpeg_stream_wrapper*>(cinfo->src);
-    wrap->stream->read(reinterpret_cast<char*>(&wrap->buffer[0]), BUF_SIZE);
-    std::streamsize size = wrap->stream->gcount();
-    wrap->manager.next_input_byte = wrap->buffer.data();
-    wrap->manager.bytes_in_buffer = BUF_SIZE;
-    return (size > 0) ? TRUE : FALSE;
+    // The whole image was supplied up front, so getting here means the data
+    // is truncated. Insert a fake EOI marker so libjpeg terminates cleanly
+    // with whatever scanlines it has, as jpeg_mem_src does.
+    static const JOCTET eoi[] = { 0xFF, JPEG_EOI };
+    cinfo->src->next_input_byte = eoi;
+    cinfo->src->bytes_in_buffer = sizeof(eoi);
+    return TRUE;
 }
 
 static void skip(j_decompress_ptr cinfo, long count) {
     if (count <= 0) return; // A zero or negative skip count should be treated as a no-op.
-    jpeg_stream_wrapper* wrap = reinterpret_cast<jpeg_stream_wrapper*>(cinfo->src);
-
-    if (wrap->manager.bytes_in_buffer > 0 && count < static_cast<long>(wrap->manager.bytes_in_buffer))
-    {
-        wrap->manager.bytes_in_buffer -= count;
-        wrap->manager.next_input_byte = &wrap->buffer[BUF_SIZE - wrap->manager.bytes_in_buffer];
-    }
-    else
-    {
-        wrap->stream->seekg(count - wrap->manager.bytes_in_buffer, std::ios_base::cur);
-        // trigger buffer fill
-        wrap->manager.next_input_byte = nullptr;
-        wrap->manager.bytes_in_buffer = 0; // bytes_in_buffer may be zero on return.
+    jpeg_source_mgr* src = cinfo->src;
+
+    if (static_cast<unsigned long>(count) < src->bytes_in_buffer) {
+        src->next_input_byte += count;
+        src->bytes_in_buffer -= count;
+    } else {
+        // Skipping past the end of the data; trigger the truncation handling
+        // in fill_input_buffer.
+        src->next_input_byte = nullptr;
+        src->bytes_in_buffer = 0;
     }
 }
 
 static void term(j_decompress_ptr) {}
 
-static void attach_stream(j_decompress_ptr cinfo, std::istream* in) {
+static void attach_buffer(j_decompress_ptr cinfo, const uint8_t* data, size_t size) {
     if (cinfo->src == nullptr) {
         cinfo->src = (struct jpeg_source_mgr *)
-            (*cinfo->mem->alloc_small) ((j_common_ptr) cinfo, JPOOL_PERMANENT, sizeof(jpeg_stream_wrapper));
+            (*cinfo->mem->alloc_small) ((j_common_ptr) cinfo, JPOOL_PERMANENT, sizeof(jpeg_source_mgr));
     }
-    jpeg_stream_wrapper * src = reinterpret_cast<jpeg_stream_wrapper*> (cinfo->src);
-    src->manager.init_source = init_source;
-    src->manager.fill_input_buffer = fill_input_buffer;
-    src->manager.skip_input_data = skip;
-    src->manager.resync_to_restart = jpeg_resync_to_restart;
-    src->manager.term_source = term;
-    src->manager.bytes_in_buffer = 0;
-    src->manager.next_input_byte = nullptr;
-    src->stream = in;
+    jpeg_source_mgr* src = cinfo->src;
+    src->init_source = init_source;
+    src->fill_input_buffer = fill_input_buffer;
+    src->skip_input_data = skip;
+    src->resync_to_restart = jpeg_resync_to_restart;
+    src->term_source = term;
+    src->next_input_byte = reinterpret_cast<const JOCTET*>(data);
+    src->bytes_in_buffer = size;
 }
 
 static void on_error(j_common_ptr) {}
@@ -89,10 +79,7 @@ struct jpeg_info_guard {
     jpeg_decompress_struct* i_;
 };
 
-PremultipliedImage decodeJPEG(const uint8_t* data, size_t size) {
-    util::CharArrayBuffer dataBuffer { reinterpret_cast<const char*>(data), size };
-    std::istream stream(&dataBuffer);
-
+PremultipliedImage decodeJPEG(const uint8_t* data, size_t size, uint32_t maxSize) {
     jpeg_decompress_struct cinfo;
     jpeg_info_guard iguard(&cinfo);
     jpeg_error_mgr jerr;
@@ -100,12 +87,22 @@ PremultipliedImage decodeJPEG(const uint8_t* data, size_t size) {
     jerr.error_exit = on_error;
     jerr.output_message = on_error_message;
     jpeg_create_decompress(&cinfo);
-    attach_stream(&cinfo, &stream);
+    attach_buffer(&cinfo, data, size);
 
     int ret = jpeg_read_header(&cinfo, TRUE);
     if (ret != JPEG_HEADER_OK)
         throw std::runtime_error("JPEG Reader: failed to read header");
 
+    if (maxSize > 0) {
+        // libjpeg decodes at 1/2, 1/4 or 1/8 scale nearly for free by
+        // operating on fewer DCT coefficients. Pick the largest reduction
+        // that keeps the longer edge at or above the requested size.
+        const JDIMENSION longerEdge = std::max(cinfo.image_width, cinfo.image_height);
+        while (cinfo.scale_denom < 8 && longerEdge / (cinfo.scale_denom * 2) >= maxSize) {
+            cinfo.scale_denom *= 2;
+        }
+    }
+
     jpeg_start_decompress(&cinfo);
 
     if (cinfo.out_color_space == JCS_UNKNOWN)
@@ -122,24 +119,35 @@ PremultipliedImage decodeJPEG(const uint8_t* data, size_t size) {
     PremultipliedImage image({ static_cast<uint32_t>(width), static_cast<uint32_t>(height) });
     uint8_t* dst = image.data.get();
 
-    JSAMPARRAY buffer = (*cinfo.mem->alloc_sarray)((j_common_ptr) &cinfo, JPOOL_IMAGE, rowStride, 1);
+    // Read scanlines in blocks of the decompressor's preferred unit (one MCU
+    // row, typically 8 or 16 scanlines) rather than one scanline per call.
+    const JDIMENSION blockHeight = cinfo.rec_outbuf_height;
+    JSAMPARRAY buffer = (*cinfo.mem->alloc_sarray)((j_common_ptr) &cinfo, JPOOL_IMAGE, rowStride, blockHeight);
 
     while (cinfo.output_scanline < cinfo.output_height) {
-        jpeg_read_scanlines(&cinfo, buffer, 1);
-
-        for (size_t i = 0; i < width; ++i) {
-            dst[0] = buffer[0][components * i];
-            dst[3] = 0xFF;
-
-            if (components > 2) {
-                dst[1] = buffer[0][components * i + 1];
-                dst[2] = buffer[0][components * i + 2];
+        const JDIMENSION rows = jpeg_read_scanlines(&cinfo, buffer, blockHeight);
+
+        for (JDIMENSION row = 0; row < rows; ++row) {
+            const JSAMPLE* src = buffer[row];
+
+            if (components >= 3) {
+                for (size_t i = 0; i < width; ++i) {
+                    dst[0] = src[components * i];
+                    dst[1] = src[components * i + 1];
+                    dst[2] = src[components * i + 2];
+                    dst[3] = 0xFF;
+                    dst += 4;
+                }
             } else {
-                dst[1] = dst[0];
-                dst[2] = dst[0];
+                for (size_t i = 0; i < width; ++i) {
+                    const uint8_t gray = src[components * i];
+                    dst[0] = gray;
+                    dst[1] = gray;
+                    dst[2] = gray;
+                    dst[3] = 0xFF;
+                    dst += 4;
+                }
             }
-
-            dst += 4;
         }
     }
 
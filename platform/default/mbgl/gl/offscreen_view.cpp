@@ -27,4 +27,18 @@ PremultipliedImage OffscreenView::readStillImage() {
     return context.readFramebuffer<PremultipliedImage>(size);
 }
 
+void OffscreenView::beginReadStillImage() {
+#if not MBGL_USE_GLES2
+    context.beginFramebufferRead(size);
+#endif
+}
+
+PremultipliedImage OffscreenView::endReadStillImage() {
+#if not MBGL_USE_GLES2
+    return context.endFramebufferRead<PremultipliedImage>(size);
+#else
+    return readStillImage();
+#endif
+}
+
 } // namespace mbgl
@@ -20,6 +20,14 @@ public:
 
     PremultipliedImage readStillImage();
 
+    // Asynchronous variant for continuous capture: begin queues the readback
+    // right after rendering and returns immediately; end collects the pixels,
+    // ideally after the next capture has started rendering. On GLES2, where
+    // there are no pixel pack buffers, the pair degenerates to a synchronous
+    // read in end.
+    void beginReadStillImage();
+    PremultipliedImage endReadStillImage();
+
 public:
     const Size size;
 
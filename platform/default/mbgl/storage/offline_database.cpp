@@ -1,5 +1,7 @@
 #include <mbgl/storage/offline_database.hpp>
+#include <mbgl/storage/offline_pack.hpp>
 #include <mbgl/storage/response.hpp>
+#include <mbgl/util/buffer_pool.hpp>
 #include <mbgl/util/compression.hpp>
 #include <mbgl/util/io.hpp>
 #include <mbgl/util/string.hpp>
@@ -36,6 +38,22 @@ void OfflineDatabase::connect(int flags) {
     db = std::make_unique<mapbox::sqlite::Database>(path.c_str(), flags);
     db->setBusyTimeout(Milliseconds::max());
     db->exec("PRAGMA foreign_keys = ON");
+
+    // Memory-map the database file so that tile blob reads are served straight
+    // from the OS page cache instead of being copied through SQLite's own page
+    // buffer with read(). SQLite clamps the value to SQLITE_MAX_MMAP_SIZE and
+    // silently ignores it on builds where mmap is disabled, so this is a no-op
+    // where unsupported. 64 MB covers the hot region of large offline packs
+    // without reserving excessive address space on 32-bit platforms.
+    db->exec("PRAGMA mmap_size = 67108864");
+
+    // Unlike the journal mode, the synchronous setting is per-connection and
+    // must be re-applied on every open. NORMAL skips the fsync at the end of
+    // every commit; under the WAL journal that cannot corrupt the database,
+    // it only risks losing the most recent commits on power loss, which for
+    // cached, re-fetchable data is an acceptable trade for not stalling the
+    // file source thread on two syncs per write.
+    db->exec("PRAGMA synchronous = NORMAL");
 }
 
 void OfflineDatabase::ensureSchema() {
@@ -48,8 +66,9 @@ void OfflineDatabase::ensureSchema() {
             case 1: break; // cache-only database; ok to delete
             case 2: migrateToVersion3(); // fall through
             case 3: // no-op and fall through
-            case 4: migrateToVersion5(); // fall through
-            case 5: return;
+            case 4: // already uses a WAL journal, like version 6; fall through
+            case 5: migrateToVersion6(); // fall through
+            case 6: return;
             default: throw std::runtime_error("unknown schema version");
             }
 
@@ -80,10 +99,9 @@ void OfflineDatabase::ensureSchema() {
 
         // If you change the schema you must write a migration from the previous version.
         db->exec("PRAGMA auto_vacuum = INCREMENTAL");
-        db->exec("PRAGMA journal_mode = DELETE");
-        db->exec("PRAGMA synchronous = FULL");
+        db->exec("PRAGMA journal_mode = WAL");
         db->exec(schema);
-        db->exec("PRAGMA user_version = 5");
+        db->exec("PRAGMA user_version = 6");
     } catch (...) {
         Log::Error(Event::Database, "Unexpected error creating database schema: %s", util::toString(std::current_exception()).c_str());
         throw;
@@ -115,15 +133,20 @@ void OfflineDatabase::migrateToVersion3() {
 }
 
 // Schema version 4 was WAL journal + NORMAL sync. It was reverted during pre-
-// release development and the migration was removed entirely to avoid potential
-// conflicts from quickly (and needlessly) switching journal and sync modes.
+// release development (version 5 switched back to a DELETE journal) to avoid
+// potential conflicts from quickly (and needlessly) switching journal and sync
+// modes. See: https://github.com/mapbox/mapbox-gl-native/pull/6320
 //
-// See: https://github.com/mapbox/mapbox-gl-native/pull/6320
-
-void OfflineDatabase::migrateToVersion5() {
-    db->exec("PRAGMA journal_mode = DELETE");
-    db->exec("PRAGMA synchronous = FULL");
-    db->exec("PRAGMA user_version = 5");
+// Version 6 restores the WAL journal, now that the churn has settled. With a
+// DELETE journal every commit creates, syncs, and deletes a rollback journal
+// file; during an offline region download those per-tile commits run on the
+// same thread that serves foreground cache reads, and the sync stalls show up
+// as dropped frames on every cache hit. WAL commits are a single sequential
+// append, and the synchronous mode is relaxed per-connection in connect().
+
+void OfflineDatabase::migrateToVersion6() {
+    db->exec("PRAGMA journal_mode = WAL");
+    db->exec("PRAGMA user_version = 6");
 }
 
 OfflineDatabase::Statement OfflineDatabase::getStatement(const char * sql) {
@@ -141,6 +164,28 @@ optional<Response> OfflineDatabase::get(const Resource& resource) {
     return result ? result->first : optional<Response>();
 }
 
+std::vector<optional<std::pair<Response, uint64_t>>> OfflineDatabase::getTiles(const std::vector<Resource>& resources) {
+    std::vector<optional<std::pair<Response, uint64_t>>> result;
+    result.reserve(resources.size());
+
+    // The SELECTs reuse the cached prepared statement; the transaction is what
+    // makes the batch cheap, by folding the per-tile `accessed` updates into a
+    // single journal write and sync instead of one per tile. An IN-list over
+    // (x, y, z, url_template) would need row values, which the oldest SQLite
+    // we support doesn't have.
+    mapbox::sqlite::Transaction transaction(*db);
+
+    for (const auto& resource : resources) {
+        assert(resource.kind == Resource::Kind::Tile);
+        assert(resource.tileData);
+        result.push_back(getTile(*resource.tileData));
+    }
+
+    transaction.commit();
+
+    return result;
+}
+
 optional<std::pair<Response, uint64_t>> OfflineDatabase::getInternal(const Resource& resource) {
     if (resource.kind == Resource::Kind::Tile) {
         assert(resource.tileData);
@@ -163,7 +208,7 @@ std::pair<bool, uint64_t> OfflineDatabase::put(const Resource& resource, const R
     return putInternal(resource, response, true);
 }
 
-std::pair<bool, uint64_t> OfflineDatabase::putInternal(const Resource& resource, const Response& response, bool evict_) {
+std::pair<bool, uint64_t> OfflineDatabase::putInternal(const Resource& resource, const Response& response, bool evict_, bool transactionOpen) {
     if (response.error) {
         return { false, 0 };
     }
@@ -189,11 +234,11 @@ std::pair<bool, uint64_t> OfflineDatabase::putInternal(const Resource& resource,
         assert(resource.tileData);
         inserted = putTile(*resource.tileData, response,
                 compressed ? compressedData : *response.data,
-                compressed);
+                compressed, transactionOpen);
     } else {
         inserted = putResource(resource, response,
                 compressed ? compressedData : *response.data,
-                compressed);
+                compressed, transactionOpen);
     }
 
     return { inserted, size };
@@ -234,11 +279,18 @@ optional<std::pair<Response, uint64_t>> OfflineDatabase::getResource(const Resou
     if (!data) {
         response.noContent = true;
     } else if (stmt->get<int>(4)) {
-        response.data = std::make_shared<std::string>(util::decompress(*data));
+        // Inflate into a recycled pool buffer, sized by a typical deflate
+        // ratio so most bodies fit without growing.
+        auto body = util::BufferPool::acquire(data->length() * 4);
+        util::decompress(*data, *body);
         size = data->length();
+        response.data = std::move(body);
     } else {
-        response.data = std::make_shared<std::string>(*data);
+        // The column accessor already copied the blob out of SQLite's (mapped)
+        // page; move that buffer into the response rather than copying again,
+        // and recycle its allocation through the response body pool.
         size = data->length();
+        response.data = util::BufferPool::adopt(std::move(*data));
     }
 
     return std::make_pair(response, size);
@@ -260,7 +312,8 @@ optional<int64_t> OfflineDatabase::hasResource(const Resource& resource) {
 bool OfflineDatabase::putResource(const Resource& resource,
                                   const Response& response,
                                   const std::string& data,
-                                  bool compressed) {
+                                  bool compressed,
+                                  bool transactionOpen) {
     if (response.notModified) {
         // clang-format off
         Statement update = getStatement(
@@ -280,8 +333,11 @@ bool OfflineDatabase::putResource(const Resource& resource,
     // We can't use REPLACE because it would change the id value.
 
     // Begin an immediate-mode transaction to ensure that two writers do not attempt
-    // to INSERT a resource at the same moment.
-    mapbox::sqlite::Transaction transaction(*db, mapbox::sqlite::Transaction::Immediate);
+    // to INSERT a resource at the same moment, unless the caller already holds one.
+    optional<mapbox::sqlite::Transaction> transaction;
+    if (!transactionOpen) {
+        transaction.emplace(*db, mapbox::sqlite::Transaction::Immediate);
+    }
 
     // clang-format off
     Statement update = getStatement(
@@ -313,7 +369,9 @@ bool OfflineDatabase::putResource(const Resource& resource,
 
     update->run();
     if (update->changes() != 0) {
-        transaction.commit();
+        if (transaction) {
+            transaction->commit();
+        }
         return false;
     }
 
@@ -339,7 +397,9 @@ bool OfflineDatabase::putResource(const Resource& resource,
     }
 
     insert->run();
-    transaction.commit();
+    if (transaction) {
+        transaction->commit();
+    }
 
     return true;
 }
@@ -366,8 +426,8 @@ optional<std::pair<Response, uint64_t>> OfflineDatabase::getTile(const Resource:
 
     // clang-format off
     Statement stmt = getStatement(
-        //        0      1        2       3        4
-        "SELECT etag, expires, modified, data, compressed "
+        //        0      1        2       3
+        "SELECT etag, expires, modified, data "
         "FROM tiles "
         "WHERE url_template = ?1 "
         "  AND pixel_ratio  = ?2 "
@@ -396,12 +456,15 @@ optional<std::pair<Response, uint64_t>> OfflineDatabase::getTile(const Resource:
     optional<std::string> data = stmt->get<optional<std::string>>(3);
     if (!data) {
         response.noContent = true;
-    } else if (stmt->get<int>(4)) {
-        response.data = std::make_shared<std::string>(util::decompress(*data));
-        size = data->length();
     } else {
-        response.data = std::make_shared<std::string>(*data);
+        // Tile payloads are delivered exactly as stored, compressed or not:
+        // VectorTileData and RasterTileWorker inflate on first parse, so tiles
+        // that sit in the tile cache (or are evicted unparsed) stay compressed.
+        // The column accessor already copied the blob out of SQLite's (mapped)
+        // page; move that buffer into the response rather than copying again,
+        // and recycle its allocation through the response body pool.
         size = data->length();
+        response.data = util::BufferPool::adopt(std::move(*data));
     }
 
     return std::make_pair(response, size);
@@ -435,7 +498,8 @@ optional<int64_t> OfflineDatabase::hasTile(const Resource::TileData& tile) {
 bool OfflineDatabase::putTile(const Resource::TileData& tile,
                               const Response& response,
                               const std::string& data,
-                              bool compressed) {
+                              bool compressed,
+                              bool transactionOpen) {
     if (response.notModified) {
         // clang-format off
         Statement update = getStatement(
@@ -463,8 +527,11 @@ bool OfflineDatabase::putTile(const Resource::TileData& tile,
     // We can't use REPLACE because it would change the id value.
 
     // Begin an immediate-mode transaction to ensure that two writers do not attempt
-    // to INSERT a resource at the same moment.
-    mapbox::sqlite::Transaction transaction(*db, mapbox::sqlite::Transaction::Immediate);
+    // to INSERT a resource at the same moment, unless the caller already holds one.
+    optional<mapbox::sqlite::Transaction> transaction;
+    if (!transactionOpen) {
+        transaction.emplace(*db, mapbox::sqlite::Transaction::Immediate);
+    }
 
     // clang-format off
     Statement update = getStatement(
@@ -502,7 +569,9 @@ bool OfflineDatabase::putTile(const Resource::TileData& tile,
 
     update->run();
     if (update->changes() != 0) {
-        transaction.commit();
+        if (transaction) {
+            transaction->commit();
+        }
         return false;
     }
 
@@ -531,7 +600,9 @@ bool OfflineDatabase::putTile(const Resource::TileData& tile,
     }
 
     insert->run();
-    transaction.commit();
+    if (transaction) {
+        transaction->commit();
+    }
 
     return true;
 }
@@ -619,7 +690,101 @@ optional<int64_t> OfflineDatabase::hasRegionResource(int64_t regionID, const Res
 }
 
 uint64_t OfflineDatabase::putRegionResource(int64_t regionID, const Resource& resource, const Response& response) {
-    uint64_t size = putInternal(resource, response, false).second;
+    return putRegionResourceInternal(regionID, resource, response, false);
+}
+
+std::vector<uint64_t> OfflineDatabase::putRegionResources(int64_t regionID,
+                                                          const std::vector<std::pair<Resource, Response>>& resources) {
+    mapbox::sqlite::Transaction transaction(*db, mapbox::sqlite::Transaction::Immediate);
+
+    std::vector<uint64_t> result;
+    result.reserve(resources.size());
+
+    for (const auto& entry : resources) {
+        result.push_back(putRegionResourceInternal(regionID, entry.first, entry.second, true));
+    }
+
+    transaction.commit();
+
+    return result;
+}
+
+std::vector<optional<int64_t>> OfflineDatabase::hasRegionResources(int64_t regionID,
+                                                                   const std::vector<Resource>& resources) {
+    // A transaction for the same reason as getTiles(): it folds the per-
+    // resource region_tiles bookkeeping writes into a single commit.
+    mapbox::sqlite::Transaction transaction(*db);
+
+    std::vector<optional<int64_t>> result;
+    result.reserve(resources.size());
+
+    for (const auto& resource : resources) {
+        result.push_back(hasRegionResource(regionID, resource));
+    }
+
+    transaction.commit();
+
+    return result;
+}
+
+void OfflineDatabase::exportRegion(int64_t regionID, const std::string& packPath) {
+    std::vector<OfflinePack::Entry> entries;
+
+    // clang-format off
+    Statement resources = getStatement(
+        //       0     1    2        3
+        "SELECT kind, url, data, compressed "
+        "FROM region_resources, resources "
+        "WHERE region_id = ?1 "
+        "AND resource_id = resources.id ");
+    // clang-format on
+
+    resources->bind(1, regionID);
+
+    while (resources->run()) {
+        optional<std::string> data = resources->get<optional<std::string>>(2);
+        if (!data) {
+            continue;
+        }
+        entries.push_back({ OfflinePack::entryKey({ Resource::Kind(resources->get<int>(0)),
+                                                    resources->get<std::string>(1) }),
+                            std::move(*data),
+                            resources->get<int>(3) != 0 });
+    }
+
+    // clang-format off
+    Statement tiles = getStatement(
+        //          0            1       2  3  4   5        6
+        "SELECT url_template, pixel_ratio, x, y, z, data, compressed "
+        "FROM region_tiles, tiles "
+        "WHERE region_id = ?1 "
+        "AND tile_id = tiles.id ");
+    // clang-format on
+
+    tiles->bind(1, regionID);
+
+    while (tiles->run()) {
+        optional<std::string> data = tiles->get<optional<std::string>>(5);
+        if (!data) {
+            continue;
+        }
+        Resource resource(Resource::Kind::Tile, "", Resource::TileData {
+            tiles->get<std::string>(0),
+            static_cast<uint8_t>(tiles->get<int>(1)),
+            tiles->get<int32_t>(2),
+            tiles->get<int32_t>(3),
+            static_cast<int8_t>(tiles->get<int>(4)) });
+        entries.push_back({ OfflinePack::entryKey(resource),
+                            std::move(*data),
+                            tiles->get<int>(6) != 0 });
+    }
+
+    OfflinePack::write(packPath, entries);
+}
+
+uint64_t OfflineDatabase::putRegionResourceInternal(int64_t regionID, const Resource& resource,
+                                                    const Response& response, bool transactionOpen) {
+    uint64_t size = putInternal(resource, response, false, transactionOpen).second;
     bool previouslyUnused = markUsed(regionID, resource);
 
     if (offlineMapboxTileCount
@@ -32,6 +32,12 @@ public:
 
     optional<Response> get(const Resource&);
 
+    // Batch lookup for tile resources; all inputs must have kind Tile. Returns
+    // one entry per input, in order, with the same semantics as get(). All
+    // lookups share a single transaction, so the per-tile `accessed` updates
+    // are committed (and synced) once rather than once per tile.
+    std::vector<optional<std::pair<Response, uint64_t>>> getTiles(const std::vector<Resource>&);
+
     // Return value is (inserted, stored size)
     std::pair<bool, uint64_t> put(const Resource&, const Response&);
 
@@ -49,6 +55,21 @@ public:
     optional<int64_t> hasRegionResource(int64_t regionID, const Resource&);
     uint64_t putRegionResource(int64_t regionID, const Resource&, const Response&);
 
+    // Batch variants for offline region downloads. Like getTiles(), the whole
+    // batch shares a single transaction, so the per-resource commits (and
+    // their syncs) are paid once per batch instead of once per resource.
+    // Returns one entry per input, in order, with the same semantics as the
+    // single-resource methods.
+    std::vector<uint64_t> putRegionResources(int64_t regionID,
+                                             const std::vector<std::pair<Resource, Response>>&);
+    std::vector<optional<int64_t>> hasRegionResources(int64_t regionID,
+                                                      const std::vector<Resource>&);
+
+    // Writes every stored resource of the region into a read-only pack file
+    // (see OfflinePack), which DefaultFileSource can mount on another device.
+    // Resources cached without a body are skipped; they carry nothing to serve.
+    void exportRegion(int64_t regionID, const std::string& packPath);
+
     OfflineRegionDefinition getRegionDefinition(int64_t regionID);
     OfflineRegionStatus getRegionCompletedStatus(int64_t regionID);
 
@@ -63,7 +84,7 @@ private:
     void ensureSchema();
     void removeExisting();
     void migrateToVersion3();
-    void migrateToVersion5();
+    void migrateToVersion6();
 
     class Statement {
     public:
@@ -83,16 +104,22 @@ private:
     optional<std::pair<Response, uint64_t>> getTile(const Resource::TileData&);
     optional<int64_t> hasTile(const Resource::TileData&);
     bool putTile(const Resource::TileData&, const Response&,
-                 const std::string&, bool compressed);
+                 const std::string&, bool compressed, bool transactionOpen);
 
     optional<std::pair<Response, uint64_t>> getResource(const Resource&);
     optional<int64_t> hasResource(const Resource&);
     bool putResource(const Resource&, const Response&,
-                     const std::string&, bool compressed);
+                     const std::string&, bool compressed, bool transactionOpen);
 
     optional<std::pair<Response, uint64_t>> getInternal(const Resource&);
     optional<int64_t> hasInternal(const Resource&);
-    std::pair<bool, uint64_t> putInternal(const Resource&, const Response&, bool evict);
+    // `transactionOpen` tells the insert path that the caller already holds a
+    // transaction, so it must not begin its own (they don't nest).
+    std::pair<bool, uint64_t> putInternal(const Resource&, const Response&, bool evict,
+                                          bool transactionOpen = false);
+
+    uint64_t putRegionResourceInternal(int64_t regionID, const Resource&, const Response&,
+                                       bool transactionOpen);
 
     // Return value is true iff the resource was previously unused by any other regions.
     bool markUsed(int64_t regionID, const Resource&);
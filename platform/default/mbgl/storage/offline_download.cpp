@@ -15,6 +15,16 @@
 
 #include <set>
 
+namespace {
+
+// How many downloaded resources to buffer before writing them to the database
+// in one transaction. Large enough to amortize the per-commit journal write
+// and sync over many small tile blobs, small enough that an interrupted
+// download loses at most a few seconds of work.
+const std::size_t regionResourceBatchSize = 32;
+
+} // namespace
+
 namespace mbgl {
 
 OfflineDownload::OfflineDownload(int64_t id_,
@@ -24,11 +34,18 @@ OfflineDownload::OfflineDownload(int64_t id_,
     : id(id_),
       definition(definition_),
       offlineDatabase(offlineDatabase_),
-      onlineFileSource(onlineFileSource_) {
+      onlineFileSource(onlineFileSource_),
+      concurrency(HTTPFileSource::maximumConcurrentRequests()) {
     setObserver(nullptr);
 }
 
-OfflineDownload::~OfflineDownload() = default;
+OfflineDownload::~OfflineDownload() {
+    try {
+        flushRegionResources();
+    } catch (...) {
+        // Losing the tail of the batch means re-downloading it on resume.
+    }
+}
 
 void OfflineDownload::setObserver(std::unique_ptr<OfflineRegionObserver> observer_) {
     observer = observer_ ? std::move(observer_) : std::make_unique<OfflineRegionObserver>();
@@ -50,6 +67,13 @@ void OfflineDownload::setState(OfflineRegionDownloadState state) {
     observer->statusChanged(status);
 }
 
+void OfflineDownload::setConcurrency(uint32_t concurrency_) {
+    concurrency = concurrency_ ? concurrency_ : 1;
+    if (status.downloadState == OfflineRegionDownloadState::Active) {
+        continueDownload();
+    }
+}
+
 OfflineRegionStatus OfflineDownload::getStatus() const {
     if (status.downloadState == OfflineRegionDownloadState::Active) {
         return status;
@@ -218,33 +242,77 @@ void OfflineDownload::activateDownload() {
 */
 void OfflineDownload::continueDownload() {
     if (resourcesRemaining.empty() && status.complete()) {
+        flushRegionResources();
         setState(OfflineRegionDownloadState::Inactive);
         return;
     }
 
-    while (!resourcesRemaining.empty() && requests.size() < HTTPFileSource::maximumConcurrentRequests()) {
+    while (!resourcesRemaining.empty() && requests.size() < concurrency) {
         ensureResource(resourcesRemaining.front());
         resourcesRemaining.pop_front();
     }
 }
 
 void OfflineDownload::deactivateDownload() {
+    // Persist whatever has been downloaded but not yet written, so that an
+    // interrupted download resumes from here rather than re-fetching it.
+    flushRegionResources();
+
     requiredSourceURLs.clear();
     resourcesRemaining.clear();
     requests.clear();
 }
 
+void OfflineDownload::flushRegionResources() {
+    if (pendingRegionResources.empty()) {
+        return;
+    }
+
+    std::vector<std::pair<Resource, Response>> batch;
+    batch.swap(pendingRegionResources);
+    pendingMapboxTileCount = 0;
+
+    std::vector<uint64_t> sizes = offlineDatabase.putRegionResources(id, batch);
+
+    for (std::size_t i = 0; i < batch.size(); i++) {
+        status.completedResourceSize += sizes[i];
+        if (batch[i].first.kind == Resource::Kind::Tile) {
+            status.completedTileSize += sizes[i];
+        }
+    }
+}
+
 void OfflineDownload::queueResource(Resource resource) {
     status.requiredResourceCount++;
     resourcesRemaining.push_front(std::move(resource));
 }
 
 void OfflineDownload::queueTiles(SourceType type, uint16_t tileSize, const Tileset& tileset) {
+    std::vector<Resource> tiles;
     for (const auto& tile : definition.tileCover(type, tileSize, tileset.zoomRange)) {
-        status.requiredResourceCount++;
-        resourcesRemaining.push_back(
+        tiles.push_back(
             Resource::tile(tileset.tiles[0], definition.pixelRatio, tile.x, tile.y, tile.z, tileset.scheme));
     }
+
+    status.requiredResourceCount += tiles.size();
+
+    // When resuming an interrupted download, most tiles are usually already
+    // in the database. Checking the whole cover in one batched query here
+    // completes them immediately, instead of re-discovering each one with its
+    // own database lookup on its own run loop turn before any network work
+    // starts.
+    std::vector<optional<int64_t>> sizes = offlineDatabase.hasRegionResources(id, tiles);
+
+    for (std::size_t i = 0; i < tiles.size(); i++) {
+        if (sizes[i]) {
+            status.completedResourceCount++;
+            status.completedResourceSize += *sizes[i];
+            status.completedTileCount += 1;
+            status.completedTileSize += *sizes[i];
+        } else {
+            resourcesRemaining.push_back(std::move(tiles[i]));
+        }
+    }
 }
 
 void OfflineDownload::ensureResource(const Resource& resource,
@@ -297,11 +365,19 @@ void OfflineDownload::ensureResource(const Resource& resource,
             }
 
             status.completedResourceCount++;
-            uint64_t resourceSize = offlineDatabase.putRegionResource(id, resource, onlineResponse);
-            status.completedResourceSize += resourceSize;
             if (resource.kind == Resource::Kind::Tile) {
                 status.completedTileCount += 1;
-                status.completedTileSize += resourceSize;
+                if (util::mapbox::isMapboxURL(resource.url)) {
+                    pendingMapboxTileCount++;
+                }
+            }
+
+            // Buffer the write; the sizes are folded into the status when the
+            // batch is flushed. Flush on completion so the final status
+            // change already carries the full sizes.
+            pendingRegionResources.emplace_back(resource, onlineResponse);
+            if (pendingRegionResources.size() >= regionResourceBatchSize || status.complete()) {
+                flushRegionResources();
             }
 
             observer->statusChanged(status);
@@ -316,8 +392,20 @@ void OfflineDownload::ensureResource(const Resource& resource,
 }
 
 bool OfflineDownload::checkTileCountLimit(const Resource& resource) {
-    if (resource.kind == Resource::Kind::Tile && util::mapbox::isMapboxURL(resource.url) &&
-        offlineDatabase.offlineMapboxTileCountLimitExceeded()) {
+    if (resource.kind != Resource::Kind::Tile || !util::mapbox::isMapboxURL(resource.url)) {
+        return false;
+    }
+
+    // Tiles buffered for the next batched write aren't counted by the
+    // database yet; only pay for an early flush when the buffered tiles could
+    // actually push the count over the limit.
+    if (pendingMapboxTileCount > 0 &&
+        offlineDatabase.getOfflineMapboxTileCount() + pendingMapboxTileCount >=
+            offlineDatabase.getOfflineMapboxTileCountLimit()) {
+        flushRegionResources();
+    }
+
+    if (offlineDatabase.offlineMapboxTileCountLimitExceeded()) {
         observer->mapboxTileCountLimitExceeded(offlineDatabase.getOfflineMapboxTileCountLimit());
         setState(OfflineRegionDownloadState::Inactive);
         return true;
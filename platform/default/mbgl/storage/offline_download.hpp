@@ -2,18 +2,19 @@
 
 #include <mbgl/storage/offline.hpp>
 #include <mbgl/storage/resource.hpp>
+#include <mbgl/storage/response.hpp>
 
 #include <list>
 #include <unordered_set>
 #include <memory>
 #include <deque>
+#include <vector>
 
 namespace mbgl {
 
 class OfflineDatabase;
 class FileSource;
 class AsyncRequest;
-class Response;
 class Tileset;
 
 namespace style {
@@ -33,6 +34,11 @@ public:
     void setObserver(std::unique_ptr<OfflineRegionObserver>);
     void setState(OfflineRegionDownloadState);
 
+    // How many requests this download keeps in flight at once. Values above
+    // the HTTP connection limit only deepen the upstream queue. Takes effect
+    // immediately if the download is active.
+    void setConcurrency(uint32_t);
+
     OfflineRegionStatus getStatus() const;
 
 private:
@@ -48,6 +54,10 @@ private:
     void ensureResource(const Resource&, std::function<void (Response)> = {});
     bool checkTileCountLimit(const Resource& resource);
 
+    // Write the buffered downloaded resources to the database in a single
+    // transaction and fold their stored sizes into the status.
+    void flushRegionResources();
+
     int64_t id;
     OfflineRegionDefinition definition;
     OfflineDatabase& offlineDatabase;
@@ -55,10 +65,17 @@ private:
     OfflineRegionStatus status;
     std::unique_ptr<OfflineRegionObserver> observer;
 
+    uint32_t concurrency;
     std::list<std::unique_ptr<AsyncRequest>> requests;
     std::unordered_set<std::string> requiredSourceURLs;
     std::deque<Resource> resourcesRemaining;
 
+    // Downloaded resources waiting for the next batched database write, and
+    // how many of them are Mapbox-hosted tiles (which count against the
+    // offline tile limit but aren't visible to the database until flushed).
+    std::vector<std::pair<Resource, Response>> pendingRegionResources;
+    uint64_t pendingMapboxTileCount = 0;
+
     void queueResource(Resource);
     void queueTiles(SourceType, uint16_t tileSize, const Tileset&);
 };
@@ -0,0 +1,157 @@
+#include <mbgl/storage/offline_pack.hpp>
+#include <mbgl/util/compression.hpp>
+#include <mbgl/util/io.hpp>
+
+#include <cstring>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+const char packMagic[8] = { 'M', 'B', 'G', 'L', 'P', 'A', 'C', 'K' };
+const uint32_t packVersion = 1;
+
+template <class T>
+T take(const char*& cursor, const char* end) {
+    if (end - cursor < static_cast<ptrdiff_t>(sizeof(T))) {
+        throw std::runtime_error("Offline pack is truncated");
+    }
+    T value;
+    std::memcpy(&value, cursor, sizeof(T));
+    cursor += sizeof(T);
+    return value;
+}
+
+template <class T>
+void append(std::string& out, T value) {
+    char buffer[sizeof(T)];
+    std::memcpy(buffer, &value, sizeof(T));
+    out.append(buffer, sizeof(T));
+}
+
+} // namespace
+
+namespace mbgl {
+
+OfflinePack::OfflinePack(const std::string& path) {
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Failed to open offline pack " + path);
+    }
+
+    struct stat info;
+    if (::fstat(fd, &info) != 0) {
+        ::close(fd);
+        throw std::runtime_error("Failed to stat offline pack " + path);
+    }
+
+    size = static_cast<std::size_t>(info.st_size);
+    map = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    // The mapping keeps the file alive; the descriptor is no longer needed.
+    ::close(fd);
+    if (map == MAP_FAILED) {
+        map = nullptr;
+        throw std::runtime_error("Failed to map offline pack " + path);
+    }
+
+    try {
+        const char* cursor = static_cast<const char*>(map);
+        const char* end = cursor + size;
+
+        if (size < sizeof(packMagic) || std::memcmp(cursor, packMagic, sizeof(packMagic)) != 0) {
+            throw std::runtime_error("Not an offline pack: " + path);
+        }
+        cursor += sizeof(packMagic);
+
+        if (take<uint32_t>(cursor, end) != packVersion) {
+            throw std::runtime_error("Unsupported offline pack version in " + path);
+        }
+
+        const uint32_t count = take<uint32_t>(cursor, end);
+        index.reserve(count);
+
+        for (uint32_t i = 0; i < count; i++) {
+            const uint32_t keySize = take<uint32_t>(cursor, end);
+            const uint32_t dataSize = take<uint32_t>(cursor, end);
+            const uint64_t dataOffset = take<uint64_t>(cursor, end);
+            const bool compressed = take<uint8_t>(cursor, end) != 0;
+            if (end - cursor < static_cast<ptrdiff_t>(keySize)
+                || dataOffset > size
+                || size - dataOffset < dataSize) {
+                throw std::runtime_error("Offline pack is truncated");
+            }
+            index.emplace(std::string(cursor, keySize), Slice { dataOffset, dataSize, compressed });
+            cursor += keySize;
+        }
+    } catch (...) {
+        // The destructor won't run when the constructor throws.
+        ::munmap(const_cast<void*>(map), size);
+        map = nullptr;
+        throw;
+    }
+}
+
+OfflinePack::~OfflinePack() {
+    if (map) {
+        ::munmap(const_cast<void*>(map), size);
+    }
+}
+
+optional<Response> OfflinePack::get(const Resource& resource) const {
+    auto it = index.find(entryKey(resource));
+    if (it == index.end()) {
+        return {};
+    }
+
+    const Slice& slice = it->second;
+    std::string blob(static_cast<const char*>(map) + slice.offset, slice.size);
+
+    Response response;
+    response.data = std::make_shared<std::string>(
+        slice.compressed ? util::decompress(blob) : std::move(blob));
+    return response;
+}
+
+std::string OfflinePack::entryKey(const Resource& resource) {
+    if (resource.kind == Resource::Kind::Tile && resource.tileData) {
+        return resource.tileData->urlTemplate
+            + "/" + std::to_string(resource.tileData->pixelRatio)
+            + "/" + std::to_string(resource.tileData->z)
+            + "/" + std::to_string(resource.tileData->x)
+            + "/" + std::to_string(resource.tileData->y);
+    }
+    return std::to_string(uint32_t(resource.kind)) + "/" + resource.url;
+}
+
+void OfflinePack::write(const std::string& path, const std::vector<Entry>& entries) {
+    std::size_t indexSize = 0;
+    for (const auto& entry : entries) {
+        indexSize += 2 * sizeof(uint32_t) + sizeof(uint64_t) + sizeof(uint8_t) + entry.key.size();
+    }
+
+    std::string header;
+    header.reserve(sizeof(packMagic) + 2 * sizeof(uint32_t) + indexSize);
+    header.append(packMagic, sizeof(packMagic));
+    append(header, packVersion);
+    append(header, static_cast<uint32_t>(entries.size()));
+
+    std::string blobs;
+    uint64_t offset = sizeof(packMagic) + 2 * sizeof(uint32_t) + indexSize;
+    for (const auto& entry : entries) {
+        append(header, static_cast<uint32_t>(entry.key.size()));
+        append(header, static_cast<uint32_t>(entry.data.size()));
+        append(header, offset);
+        append(header, static_cast<uint8_t>(entry.compressed ? 1 : 0));
+        header += entry.key;
+        blobs += entry.data;
+        offset += entry.data.size();
+    }
+
+    util::write_file(path, header + blobs);
+}
+
+} // namespace mbgl
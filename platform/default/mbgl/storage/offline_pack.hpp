@@ -0,0 +1,85 @@
+#pragma once
+
+#include <mbgl/storage/resource.hpp>
+#include <mbgl/storage/response.hpp>
+#include <mbgl/util/noncopyable.hpp>
+#include <mbgl/util/optional.hpp>
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace mbgl {
+
+/*
+ * A read-only archive of resources that DefaultFileSource can mount alongside
+ * the offline database. Packs are produced once, typically when a firmware or
+ * installer image is built, so that preloaded maps can be shipped as a plain
+ * file instead of copying a writable sqlite database onto every device.
+ *
+ * The pack is mapped into memory and never written to: the index is parsed
+ * once at mount time, and the blobs stay untouched until a lookup needs them,
+ * as clean file-backed pages that the kernel faults in on demand and can drop
+ * under memory pressure, with none of sqlite's journaling or page cache
+ * overhead.
+ *
+ * File layout (scalars are little-endian, copied verbatim; every supported
+ * target is little-endian):
+ *
+ *   8 bytes   magic "MBGLPACK"
+ *   uint32    format version, currently 1
+ *   uint32    entry count
+ *   then one record per entry:
+ *     uint32    key size
+ *     uint32    data size
+ *     uint64    data offset from the start of the file
+ *     uint8     1 if the data is deflated with util::compress()
+ *     key size bytes of key; see entryKey()
+ *   then the blob section the records point into
+ *
+ * @private
+ */
+class OfflinePack : private util::noncopyable {
+public:
+    // An entry as passed to write(). The data may already be deflated,
+    // matching how the offline database stores blobs, so exporting a region
+    // does not decompress and recompress every resource.
+    struct Entry {
+        std::string key;
+        std::string data;
+        bool compressed;
+    };
+
+    // Maps the pack at the given path. Throws std::runtime_error if the file
+    // cannot be opened or is not a well-formed pack.
+    explicit OfflinePack(const std::string& path);
+    ~OfflinePack();
+
+    // Returns the stored response, or nullopt if the pack has no entry for
+    // this resource. Pack entries carry no etag or expiration, so they behave
+    // like stale cache hits: served immediately, revalidated online when the
+    // resource is required and a network is available.
+    optional<Response> get(const Resource&) const;
+
+    // The index key for a resource. Tiles are keyed by URL template and
+    // coordinates, like the tiles table, so lookups are independent of the
+    // access token; everything else is keyed by kind and full URL.
+    static std::string entryKey(const Resource&);
+
+    // Writes a pack containing the given entries. Used by the region export
+    // path and by generator tooling.
+    static void write(const std::string& path, const std::vector<Entry>&);
+
+private:
+    struct Slice {
+        uint64_t offset;
+        uint32_t size;
+        bool compressed;
+    };
+
+    const void* map = nullptr;
+    std::size_t size = 0;
+    std::unordered_map<std::string, Slice> index;
+};
+
+} // namespace mbgl
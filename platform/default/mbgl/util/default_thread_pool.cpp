@@ -1,28 +1,51 @@
 #include <mbgl/util/default_thread_pool.hpp>
 #include <mbgl/actor/mailbox.hpp>
+#include <mbgl/util/platform.hpp>
 
 namespace mbgl {
 
-ThreadPool::ThreadPool(std::size_t count) {
+namespace {
+
+// Index of the worker deque owned by the current thread, or SIZE_MAX if the
+// current thread does not belong to a ThreadPool.
+thread_local std::size_t currentWorker = SIZE_MAX;
+
+} // namespace
+
+ThreadPool::ThreadPool(std::size_t count, util::ThreadContext context) {
+    workers.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        workers.push_back(std::make_unique<Worker>());
+    }
+
     threads.reserve(count);
     for (std::size_t i = 0; i < count; ++i) {
-        threads.emplace_back([this] () {
+        threads.emplace_back([this, i, context] () {
+            currentWorker = i;
+
+            platform::setCurrentThreadName(context.name);
+
+            if (context.priority == util::ThreadPriority::Low) {
+                platform::makeThreadLowPriority();
+            } else if (context.priority == util::ThreadPriority::High) {
+                platform::makeThreadHighPriority();
+            }
+
             while (true) {
-                std::unique_lock<std::mutex> lock(mutex);
+                std::weak_ptr<Mailbox> mailbox;
+                if (pop(i, mailbox)) {
+                    Mailbox::maybeReceive(mailbox);
+                    continue;
+                }
 
+                std::unique_lock<std::mutex> lock(sleepMutex);
                 cv.wait(lock, [this] {
-                    return !queue.empty() || terminate;
+                    return pending > 0 || terminate;
                 });
 
                 if (terminate) {
                     return;
                 }
-
-                auto mailbox = queue.front();
-                queue.pop();
-                lock.unlock();
-
-                Mailbox::maybeReceive(mailbox);
             }
         });
     }
@@ -30,7 +53,7 @@ ThreadPool::ThreadPool(std::size_t count) {
 
 ThreadPool::~ThreadPool() {
     {
-        std::lock_guard<std::mutex> lock(mutex);
+        std::lock_guard<std::mutex> lock(sleepMutex);
         terminate = true;
     }
 
@@ -42,12 +65,46 @@ ThreadPool::~ThreadPool() {
 }
 
 void ThreadPool::schedule(std::weak_ptr<Mailbox> mailbox) {
+    // Work scheduled from a worker thread stays on that worker's deque for
+    // locality; other threads distribute round-robin.
+    const std::size_t index = currentWorker < workers.size()
+        ? currentWorker
+        : nextWorker++ % workers.size();
+
     {
-        std::lock_guard<std::mutex> lock(mutex);
-        queue.push(mailbox);
+        std::lock_guard<std::mutex> lock(workers[index]->mutex);
+        workers[index]->queue.push_back(std::move(mailbox));
     }
 
+    ++pending;
     cv.notify_one();
 }
 
+bool ThreadPool::pop(std::size_t index, std::weak_ptr<Mailbox>& mailbox) {
+    // Own deque first, then try to steal from each sibling in turn. Owners pop
+    // from the front and thieves steal from the back to reduce the chance of
+    // both hitting the same element.
+    for (std::size_t attempt = 0; attempt < workers.size(); ++attempt) {
+        Worker& worker = *workers[(index + attempt) % workers.size()];
+
+        std::lock_guard<std::mutex> lock(worker.mutex);
+        if (worker.queue.empty()) {
+            continue;
+        }
+
+        if (attempt == 0) {
+            mailbox = std::move(worker.queue.front());
+            worker.queue.pop_front();
+        } else {
+            mailbox = std::move(worker.queue.back());
+            worker.queue.pop_back();
+        }
+
+        --pending;
+        return true;
+    }
+
+    return false;
+}
+
 } // namespace mbgl
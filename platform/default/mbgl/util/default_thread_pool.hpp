@@ -1,25 +1,54 @@
 #pragma once
 
 #include <mbgl/actor/scheduler.hpp>
+#include <mbgl/util/thread_context.hpp>
 
+#include <atomic>
 #include <condition_variable>
+#include <deque>
+#include <memory>
 #include <mutex>
-#include <queue>
 #include <thread>
+#include <vector>
 
 namespace mbgl {
 
+/*
+    A `Scheduler` implementation that distributes mailboxes over a fixed number
+    of worker threads. Each worker owns its own deque of scheduled mailboxes:
+    work scheduled from a worker thread goes to that worker's own deque, while
+    work scheduled from other threads is spread round-robin. A worker that runs
+    out of local work steals from the back of a sibling's deque, so a single
+    contended queue never becomes the bottleneck.
+*/
 class ThreadPool : public Scheduler {
 public:
-    ThreadPool(std::size_t count);
+    // The context names the workers and sets their scheduling priority. The
+    // default is High: the pool's main use is tile layout, whose latency is
+    // user-visible; pools doing background work should pass Low.
+    ThreadPool(std::size_t count,
+               util::ThreadContext context = { "Worker", util::ThreadPriority::High });
     ~ThreadPool() override;
 
     void schedule(std::weak_ptr<Mailbox>) override;
 
 private:
+    struct Worker {
+        std::mutex mutex;
+        std::deque<std::weak_ptr<Mailbox>> queue;
+    };
+
+    // Pops from the front of the worker's own deque, or steals from the back
+    // of a sibling's deque. Returns false if no work was found.
+    bool pop(std::size_t index, std::weak_ptr<Mailbox>&);
+
+    std::vector<std::unique_ptr<Worker>> workers;
     std::vector<std::thread> threads;
-    std::queue<std::weak_ptr<Mailbox>> queue;
-    std::mutex mutex;
+
+    std::atomic<std::size_t> pending { 0 };
+    std::atomic<std::size_t> nextWorker { 0 };
+
+    std::mutex sleepMutex;
     std::condition_variable cv;
     bool terminate { false };
 };
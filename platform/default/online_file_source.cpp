@@ -14,12 +14,14 @@
 #include <mbgl/util/noncopyable.hpp>
 #include <mbgl/util/timer.hpp>
 #include <mbgl/util/http_timeout.hpp>
+#include <mbgl/util/url.hpp>
 
 #include <algorithm>
 #include <cassert>
 #include <list>
 #include <unordered_set>
 #include <unordered_map>
+#include <vector>
 
 namespace mbgl {
 
@@ -32,6 +34,7 @@ public:
 
     void networkIsReachableAgain();
     void schedule(optional<Timestamp> expires);
+    void refreshAhead();
     void completed(Response);
 
     OnlineFileSource::Impl& impl;
@@ -50,8 +53,44 @@ public:
     uint32_t failedRequests = 0;
     Response::Error::Reason failedRequestReason = Response::Error::Reason::Success;
     optional<Timestamp> retryAfter;
+
+    // While the request is healthy and waiting for its expiration timer, the
+    // timestamp that timer fires at; unset while in flight, after errors, and
+    // after stale responses. This is what the idle refresh-ahead pass (see
+    // Impl::activateRefreshAheadRequest) uses to pick revalidation candidates.
+    optional<Timestamp> refreshAheadDue;
+    Timestamp lastRefreshAhead;
+
+    // Host part of the resource URL; transfers are limited per host so that
+    // one slow server cannot occupy every connection slot.
+    const std::string host;
 };
 
+// Host a transfer for this URL will connect to, for the per-host limit.
+std::string hostForURL(const std::string& url) {
+    util::URL parsed(url);
+    return url.substr(parsed.domain.first, parsed.domain.second);
+}
+
+// Two requests may share one in-flight transfer only if they would send the
+// same revalidation headers: a 304 fanned out to a request with a different
+// etag would wrongly confirm its stale copy.
+std::string inflightKey(const Resource& resource) {
+    std::string key = std::to_string(uint32_t(resource.kind));
+    key += '|';
+    key += resource.url;
+    key += '|';
+    if (resource.priorEtag) {
+        key += *resource.priorEtag;
+    }
+    key += '|';
+    if (resource.priorModified) {
+        key += std::to_string(std::chrono::duration_cast<std::chrono::seconds>(
+            resource.priorModified->time_since_epoch()).count());
+    }
+    return key;
+}
+
 class OnlineFileSource::Impl {
 public:
     Impl() {
@@ -67,7 +106,42 @@ public:
     }
 
     void remove(OnlineFileRequest* request) {
+        if (fanoutRecipients) {
+            // Cancelled from another recipient's callback while the shared
+            // response is being fanned out.
+            for (auto& recipient : *fanoutRecipients) {
+                if (recipient == request) {
+                    recipient = nullptr;
+                }
+            }
+        }
+
         allRequests.erase(request);
+
+        auto inflight = inflightRequests.find(inflightKey(request->resource));
+        if (inflight != inflightRequests.end()) {
+            auto& leader = inflight->second.first;
+            auto& riders = inflight->second.second;
+            if (leader == request) {
+                if (!riders.empty()) {
+                    // The open transfer outlives its initiator: the first
+                    // attached request takes over the handle and the active
+                    // slot, so the bytes already on the wire aren't wasted.
+                    OnlineFileRequest* promoted = riders.front();
+                    riders.erase(riders.begin());
+                    promoted->request = std::move(request->request);
+                    activeRequests.erase(request);
+                    activeRequests.insert(promoted);
+                    leader = promoted;
+                    assert(pendingRequestsMap.size() == pendingRequestsList.size());
+                    return;
+                }
+                inflightRequests.erase(inflight);
+            } else {
+                riders.erase(std::remove(riders.begin(), riders.end(), request), riders.end());
+            }
+        }
+
         if (activeRequests.erase(request)) {
             activatePendingRequest();
         } else {
@@ -85,37 +159,141 @@ public:
         assert(activeRequests.find(request) == activeRequests.end());
         assert(!request->request);
 
-        if (activeRequests.size() >= HTTPFileSource::maximumConcurrentRequests()) {
+        // Attaching to an already-open transfer for the same resource costs
+        // no connection, so it bypasses both the global and the per-host limit.
+        if (inflightRequests.find(inflightKey(request->resource)) != inflightRequests.end()) {
+            activateRequest(request);
+            return;
+        }
+
+        if (activeRequests.size() >= HTTPFileSource::maximumConcurrentRequests() ||
+            activeRequestsForHost(request->host) >= maximumConcurrentRequestsPerHost) {
             queueRequest(request);
         } else {
             activateRequest(request);
         }
     }
 
+    uint32_t activeRequestsForHost(const std::string& host) {
+        uint32_t count = 0;
+        for (const auto& active : activeRequests) {
+            if (active->host == host) {
+                count++;
+            }
+        }
+        return count;
+    }
+
     void queueRequest(OnlineFileRequest* request) {
-        auto it = pendingRequestsList.insert(pendingRequestsList.end(), request);
+        // The pending list is kept sorted by descending priority, with
+        // arrival order as the tie-breaker; activatePendingRequest drains it
+        // from the front within those bands. This keeps a burst of tile
+        // requests after a zoom from starving the glyph
+        // and sprite fetches that text rendering blocks on. Requests whose
+        // resources leave the viewport are cancelled by their owners, which
+        // removes them from this list and promotes the next pending request.
+        auto position = std::find_if(pendingRequestsList.begin(), pendingRequestsList.end(),
+                                     [&] (OnlineFileRequest* pending) {
+                                         return pending->resource.priority < request->resource.priority;
+                                     });
+        auto it = pendingRequestsList.insert(position, request);
         pendingRequestsMap.emplace(request, std::move(it));
         assert(pendingRequestsMap.size() == pendingRequestsList.size());
     }
 
     void activateRequest(OnlineFileRequest* request) {
+        request->refreshAheadDue = {};
+
+        auto key = inflightKey(request->resource);
+        auto inflight = inflightRequests.find(key);
+        if (inflight != inflightRequests.end()) {
+            // A transfer for the same resource with the same revalidation
+            // headers is already open; attach to it and share its response
+            // rather than fetching the same bytes twice.
+            inflight->second.second.push_back(request);
+            return;
+        }
+
+        inflightRequests[key].first = request;
         activeRequests.insert(request);
         request->request = httpFileSource.request(request->resource, [=] (Response response) {
-            activeRequests.erase(request);
-            activatePendingRequest();
-            request->request.reset();
-            request->completed(response);
+            transferCompleted(key, response);
         });
         assert(pendingRequestsMap.size() == pendingRequestsList.size());
     }
 
+    void transferCompleted(const std::string& key, Response response) {
+        auto it = inflightRequests.find(key);
+        assert(it != inflightRequests.end());
+        OnlineFileRequest* leader = it->second.first;
+
+        // Every request that attached while the transfer was open receives
+        // the same response. The entry is erased first, so that a request
+        // activated from the pending queue below starts a fresh transfer
+        // instead of attaching to this finished one.
+        std::vector<OnlineFileRequest*> recipients;
+        recipients.reserve(1 + it->second.second.size());
+        recipients.push_back(leader);
+        recipients.insert(recipients.end(), it->second.second.begin(), it->second.second.end());
+        inflightRequests.erase(it);
+
+        activeRequests.erase(leader);
+        activatePendingRequest();
+        leader->request.reset();
+
+        // A callback may cancel any of the other recipients; remove() nulls
+        // cancelled entries out of this list while it is being delivered.
+        assert(!fanoutRecipients);
+        fanoutRecipients = &recipients;
+        for (auto& recipient : recipients) {
+            if (recipient) {
+                recipient->completed(response);
+            }
+        }
+        fanoutRecipients = nullptr;
+    }
+
     void activatePendingRequest() {
         if (pendingRequestsList.empty()) {
+            if (activeRequests.empty()) {
+                activateRefreshAheadRequest();
+            }
             return;
         }
 
-        OnlineFileRequest* request = pendingRequestsList.front();
-        pendingRequestsList.pop_front();
+        // The list is sorted by descending priority, so walk the leading run
+        // of equal-priority requests and take the one whose host has the
+        // fewest open transfers, skipping hosts at their per-host limit. This
+        // spreads freed slots across hosts instead of letting a slow server
+        // with a deep backlog reclaim every slot its stalled transfers
+        // release. When an entire priority band is waiting on its per-host
+        // limit, the scan falls through to the next band rather than leaving
+        // the slot idle.
+        auto best = pendingRequestsList.end();
+        uint32_t bestCount = 0;
+        for (auto it = pendingRequestsList.begin(); it != pendingRequestsList.end(); ++it) {
+            if (best != pendingRequestsList.end() &&
+                (*it)->resource.priority < (*best)->resource.priority) {
+                break;
+            }
+            const uint32_t count = activeRequestsForHost((*it)->host);
+            if (count >= maximumConcurrentRequestsPerHost) {
+                continue;
+            }
+            if (best == pendingRequestsList.end() || count < bestCount) {
+                best = it;
+                bestCount = count;
+            }
+        }
+
+        if (best == pendingRequestsList.end()) {
+            // Every pending request targets a saturated host; their
+            // completions will re-enter this path and drain the queue.
+            return;
+        }
+
+        OnlineFileRequest* request = *best;
+        pendingRequestsList.erase(best);
 
         pendingRequestsMap.erase(request);
 
@@ -123,12 +301,59 @@ public:
         assert(pendingRequestsMap.size() == pendingRequestsList.size());
     }
 
+    void activateRefreshAheadRequest() {
+        // The network just went idle. Rather than letting a hot resource
+        // expire and revalidating it on demand — paying the network latency
+        // exactly when the user looks at it — pull forward the revalidation
+        // of whichever healthy waiting request expires soonest, if it expires
+        // within the refresh-ahead window. Each completion re-enters this
+        // path, so an idle period drains the window one request at a time,
+        // and real traffic takes over again as soon as it appears.
+        const Timestamp now = util::now();
+        const Timestamp deadline = now + util::REFRESH_AHEAD_WINDOW;
+
+        OnlineFileRequest* next = nullptr;
+        for (auto& request : allRequests) {
+            if (!request->refreshAheadDue || isActive(request) || isPending(request)) {
+                continue;
+            }
+            // Requests already due are about to fire on their own; requests
+            // refreshed ahead within the current window keep their turn from
+            // coming around more often than the window itself.
+            if (*request->refreshAheadDue <= now || *request->refreshAheadDue > deadline ||
+                request->lastRefreshAhead + util::REFRESH_AHEAD_WINDOW > now) {
+                continue;
+            }
+            if (!next || *request->refreshAheadDue < *next->refreshAheadDue) {
+                next = request;
+            }
+        }
+
+        if (next) {
+            next->refreshAhead();
+        }
+    }
+
     bool isPending(OnlineFileRequest* request) {
         return pendingRequestsMap.find(request) != pendingRequestsMap.end();
     }
 
+    void setMaximumConcurrentRequestsPerHost(uint32_t limit) {
+        maximumConcurrentRequestsPerHost = limit ? limit : 1;
+    }
+
     bool isActive(OnlineFileRequest* request) {
-        return activeRequests.find(request) != activeRequests.end();
+        if (activeRequests.find(request) != activeRequests.end()) {
+            return true;
+        }
+        // A request riding on another request's transfer is active too, just
+        // without a connection of its own.
+        auto inflight = inflightRequests.find(inflightKey(request->resource));
+        if (inflight == inflightRequests.end()) {
+            return false;
+        }
+        const auto& riders = inflight->second.second;
+        return std::find(riders.begin(), riders.end(), request) != riders.end();
     }
 
 private:
@@ -148,12 +373,26 @@ private:
      *
      * Requests in any state are in `allRequests`. Requests in the pending state are in
      * `pendingRequests`. Requests in the active state are in `activeRequests`.
+     *
+     * A request that would open a transfer identical to one already active attaches to
+     * it instead (see `inflightRequests`); it counts as active but holds no connection,
+     * and returns to #1 when the shared response arrives.
      */
     std::unordered_set<OnlineFileRequest*> allRequests;
     std::list<OnlineFileRequest*> pendingRequestsList;
     std::unordered_map<OnlineFileRequest*, std::list<OnlineFileRequest*>::iterator> pendingRequestsMap;
     std::unordered_set<OnlineFileRequest*> activeRequests;
 
+    // In-flight transfers by revalidation key: the request that opened the
+    // transfer, and the requests that later attached to it instead of
+    // fetching the same bytes again. Attached requests occupy no slot in
+    // `activeRequests` and rejoin the normal lifecycle when the shared
+    // response is fanned out.
+    std::unordered_map<std::string, std::pair<OnlineFileRequest*, std::vector<OnlineFileRequest*>>> inflightRequests;
+    std::vector<OnlineFileRequest*>* fanoutRecipients = nullptr;
+
+    uint32_t maximumConcurrentRequestsPerHost = util::MAXIMUM_CONCURRENT_REQUESTS_PER_HOST;
+
     HTTPFileSource httpFileSource;
     util::AsyncTask reachability { std::bind(&Impl::networkIsReachableAgain, this) };
 };
@@ -164,6 +403,10 @@ OnlineFileSource::OnlineFileSource()
 
 OnlineFileSource::~OnlineFileSource() = default;
 
+void OnlineFileSource::setMaximumConcurrentRequestsPerHost(uint32_t limit) {
+    impl->setMaximumConcurrentRequestsPerHost(limit);
+}
+
 std::unique_ptr<AsyncRequest> OnlineFileSource::request(const Resource& resource, Callback callback) {
     Resource res = resource;
 
@@ -199,7 +442,8 @@ std::unique_ptr<AsyncRequest> OnlineFileSource::request(const Resource& resource
 OnlineFileRequest::OnlineFileRequest(Resource resource_, Callback callback_, OnlineFileSource::Impl& impl_)
     : impl(impl_),
       resource(std::move(resource_)),
-      callback(std::move(callback_)) {
+      callback(std::move(callback_)),
+      host(hostForURL(resource.url)) {
     impl.add(this);
 
     // Force an immediate first request if we don't have an expiration time.
@@ -261,6 +505,8 @@ void OnlineFileRequest::schedule(optional<Timestamp> expires) {
                             http::errorRetryTimeout(failedRequestReason, failedRequests, retryAfter),
                             http::expirationTimeout(expires, expiredRequests));
 
+    refreshAheadDue = {};
+
     if (timeout == Duration::max()) {
         return;
     }
@@ -274,11 +520,27 @@ void OnlineFileRequest::schedule(optional<Timestamp> expires) {
         timeout = Duration::max();
     }
 
+    // A healthy wait for expiration is a refresh-ahead candidate; error
+    // retries and stale-server backoffs are not, because revalidating those
+    // early would defeat the backoff.
+    if (expires && failedRequests == 0 && expiredRequests == 0) {
+        refreshAheadDue = *expires;
+    }
+
     timer.start(timeout, Duration::zero(), [&] {
         impl.activateOrQueueRequest(this);
     });
 }
 
+void OnlineFileRequest::refreshAhead() {
+    // Only invoked while the network is idle: revalidate now instead of when
+    // the expiration timer would have fired.
+    refreshAheadDue = {};
+    lastRefreshAhead = util::now();
+    timer.stop();
+    impl.activateOrQueueRequest(this);
+}
+
 void OnlineFileRequest::completed(Response response) {
     // If we didn't get various caching headers in the response, continue using the
     // previous values. Otherwise, update the previous values to the new values.
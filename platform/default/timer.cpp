@@ -4,6 +4,10 @@
 
 #include <uv.h>
 
+#include <algorithm>
+#include <map>
+#include <vector>
+
 #if UV_VERSION_MAJOR == 0 && UV_VERSION_MINOR <= 10
 #define UV_TIMER_PARAMS(timer) uv_timer_t *timer, int
 #else
@@ -13,10 +17,89 @@
 namespace mbgl {
 namespace util {
 
+class TimerService;
+
 class Timer::Impl {
 public:
-    Impl() : timer(new uv_timer_t) {
-        uv_loop_t* loop = reinterpret_cast<uv_loop_t*>(RunLoop::getLoopHandle());
+    Impl();
+    ~Impl();
+
+    void start(uint64_t timeout, uint64_t repeat, std::function<void()>&& cb_);
+    void stop();
+
+    TimerService& service;
+    std::function<void()> cb;
+    uint64_t repeatMs = 0;
+
+    // Engaged iff this timer is waiting in the service's deadline map.
+    bool scheduled = false;
+    std::multimap<uint64_t, Timer::Impl*>::iterator entry;
+};
+
+/*
+    All timers on one run loop share a single uv timer, owned by a per-thread
+    TimerService. Deadlines live in a sorted map, the uv timer is armed for
+    the earliest one, and each wakeup runs every timer whose deadline falls
+    within a small slack window of the current time. A map with hundreds of
+    staggered deadlines (HTTP retries, tile expiries, transition ticks) then
+    wakes the loop once per window instead of once per timer, which matters
+    for battery.
+
+    The service exists while at least one Timer::Impl on the thread does, so
+    its uv handle is always closed before the thread's RunLoop goes away.
+*/
+class TimerService {
+public:
+    // Deadlines within this distance of the one that triggered a wakeup fire
+    // in the same wakeup. Only coalesced timers fire early, and by at most
+    // this amount; a lone timer keeps its exact deadline.
+    static const uint64_t slackMs = 10;
+
+    static TimerService& get() {
+        if (!instance) {
+            instance = new TimerService();
+        }
+        return *instance;
+    }
+
+    void attach() {
+        ++timers;
+    }
+
+    void detach() {
+        if (--timers == 0 && !firing) {
+            shutdown();
+        }
+    }
+
+    void start(Timer::Impl& owner, uint64_t timeout) {
+        stop(owner);
+        schedule(owner, timeout);
+        if (!firing) {
+            arm();
+        }
+    }
+
+    void stop(Timer::Impl& owner) {
+        if (owner.scheduled) {
+            deadlines.erase(owner.entry);
+            owner.scheduled = false;
+            if (!firing) {
+                arm();
+            }
+        }
+        if (activeBatch) {
+            for (auto& pending : *activeBatch) {
+                if (pending == &owner) {
+                    pending = nullptr;
+                }
+            }
+        }
+    }
+
+private:
+    TimerService() : timer(new uv_timer_t) {
+        loop = reinterpret_cast<uv_loop_t*>(RunLoop::getLoopHandle());
         if (uv_timer_init(loop, timer) != 0) {
             throw std::runtime_error("Failed to initialize timer.");
         }
@@ -25,40 +108,126 @@ public:
         uv_unref(handle());
     }
 
-    ~Impl() {
+    void shutdown() {
+        instance = nullptr;
+        uv_timer_stop(timer);
         uv_close(handle(), [](uv_handle_t* h) {
             delete reinterpret_cast<uv_timer_t*>(h);
         });
+        delete this;
     }
 
-    void start(uint64_t timeout, uint64_t repeat, std::function<void ()>&& cb_) {
-        cb = std::move(cb_);
-        if (uv_timer_start(timer, timerCallback, timeout, repeat) != 0) {
+    void schedule(Timer::Impl& owner, uint64_t timeout) {
+        owner.entry = deadlines.emplace(uv_now(loop) + timeout, &owner);
+        owner.scheduled = true;
+    }
+
+    // (Re-)arms the uv timer for the earliest pending deadline.
+    void arm() {
+        if (deadlines.empty()) {
+            uv_timer_stop(timer);
+            return;
+        }
+
+        const uint64_t now = uv_now(loop);
+        const uint64_t earliest = deadlines.begin()->first;
+        if (uv_timer_start(timer, fired, earliest > now ? earliest - now : 0, 0) != 0) {
             throw std::runtime_error("Failed to start timer.");
         }
     }
 
-    void stop() {
-        cb = nullptr;
-        if (uv_timer_stop(timer) != 0) {
-            throw std::runtime_error("Failed to stop timer.");
-        }
+    static void fired(UV_TIMER_PARAMS(handle)) {
+        reinterpret_cast<TimerService*>(handle->data)->fire();
     }
 
-private:
-    static void timerCallback(UV_TIMER_PARAMS(handle)) {
-        reinterpret_cast<Impl*>(handle->data)->cb();
+    void fire() {
+        const uint64_t now = uv_now(loop);
+
+        // Collect the whole batch before running anything: callbacks may
+        // start or stop timers — including ones already collected, which
+        // stop() then nulls out here — or destroy their Timer outright.
+        std::vector<Timer::Impl*> batch;
+        while (!deadlines.empty() && deadlines.begin()->first <= now + slackMs) {
+            const uint64_t deadline = deadlines.begin()->first;
+            Timer::Impl* owner = deadlines.begin()->second;
+            deadlines.erase(deadlines.begin());
+            owner->scheduled = false;
+            if (owner->repeatMs > 0) {
+                // Reinserting at now + repeat rather than deadline + repeat
+                // would let the slack shorten every period a little; anchoring
+                // on the old deadline keeps the long-run cadence exact. The
+                // max() keeps a repeat shorter than the slack from firing more
+                // than once per wakeup.
+                owner->entry = deadlines.emplace(
+                    std::max(deadline + owner->repeatMs, now + 1), owner);
+                owner->scheduled = true;
+            }
+            batch.push_back(owner);
+        }
+
+        firing = true;
+        activeBatch = &batch;
+
+        for (auto& owner : batch) {
+            if (owner) {
+                // Run a copy: the callback may stop or destroy its own timer.
+                auto cb = owner->cb;
+                if (cb) {
+                    cb();
+                }
+            }
+        }
+
+        activeBatch = nullptr;
+        firing = false;
+
+        if (timers == 0) {
+            // The last Timer on this thread was destroyed from a callback.
+            shutdown();
+            return;
+        }
+
+        arm();
     }
 
     uv_handle_t* handle() {
         return reinterpret_cast<uv_handle_t*>(timer);
     }
 
+    static thread_local TimerService* instance;
+
+    uv_loop_t* loop = nullptr;
     uv_timer_t* timer;
 
-    std::function<void()> cb;
+    std::multimap<uint64_t, Timer::Impl*> deadlines;
+    std::vector<Timer::Impl*>* activeBatch = nullptr;
+    std::size_t timers = 0;
+    bool firing = false;
 };
 
+thread_local TimerService* TimerService::instance = nullptr;
+
+Timer::Impl::Impl() : service(TimerService::get()) {
+    service.attach();
+}
+
+Timer::Impl::~Impl() {
+    service.stop(*this);
+    service.detach();
+}
+
+void Timer::Impl::start(uint64_t timeout, uint64_t repeat, std::function<void()>&& cb_) {
+    cb = std::move(cb_);
+    repeatMs = repeat;
+    service.start(*this, timeout);
+}
+
+void Timer::Impl::stop() {
+    cb = nullptr;
+    repeatMs = 0;
+    service.stop(*this);
+}
+
 Timer::Timer()
     : impl(std::make_unique<Impl>()) {
 }
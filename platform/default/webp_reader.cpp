@@ -7,19 +7,47 @@ extern "C"
 #include <webp/decode.h>
 }
 
+#include <algorithm>
+
 namespace mbgl {
 
-PremultipliedImage decodeWebP(const uint8_t* data, size_t size) {
+PremultipliedImage decodeWebP(const uint8_t* data, size_t size, uint32_t maxSize) {
     int width = 0, height = 0;
     if (WebPGetInfo(data, size, &width, &height) == 0) {
         throw std::runtime_error("failed to retrieve WebP basic header information");
     }
 
+    // libwebp can downscale while decoding. Reduce by the largest power of
+    // two that keeps the longer edge at or above the requested size.
+    int denom = 1;
+    if (maxSize > 0) {
+        const int longerEdge = std::max(width, height);
+        while (denom < 8 && longerEdge / (denom * 2) >= static_cast<int>(maxSize)) {
+            denom *= 2;
+        }
+        width /= denom;
+        height /= denom;
+    }
+
     int stride = width * 4;
     size_t webpSize = stride * height;
     auto webp = std::make_unique<uint8_t[]>(webpSize);
 
-    if (!WebPDecodeRGBAInto(data, size, webp.get(), webpSize, stride)) {
+    WebPDecoderConfig config;
+    if (!WebPInitDecoderConfig(&config)) {
+        throw std::runtime_error("failed to initialize WebP decoder configuration");
+    }
+
+    config.options.use_scaling = denom > 1 ? 1 : 0;
+    config.options.scaled_width = width;
+    config.options.scaled_height = height;
+    config.output.colorspace = MODE_RGBA;
+    config.output.is_external_memory = 1;
+    config.output.u.RGBA.rgba = webp.get();
+    config.output.u.RGBA.stride = stride;
+    config.output.u.RGBA.size = webpSize;
+
+    if (WebPDecode(data, size, &config) != VP8_STATUS_OK) {
         throw std::runtime_error("failed to decode WebP data");
     }
 
@@ -174,6 +174,12 @@ std::string StringifyStyle(v8::Local<v8::Value> styleHandle) {
 /**
  * Load a stylesheet
  *
+ * Maps are reusable: a pooled map that loads the same stylesheet again keeps
+ * its parsed style, atlases, and tile caches warm across render() calls, so
+ * repeated still renders only pay the camera/size swap and the render itself.
+ * If the style was mutated (e.g. via addLayer), reloading restores the
+ * stylesheet as written.
+ *
  * @function
  * @name load
  * @param {string|Object} stylesheet either an object or a JSON representation
@@ -15,6 +15,10 @@ std::u16string applyArabicShaping(const std::u16string& input) {
     return input;
 }
 
+void prewarmBiDi() {
+    // Nothing to initialize for the Qt implementation.
+}
+
 void BiDi::mergeParagraphLineBreaks(std::set<std::size_t>& lineBreakPoints) {
     lineBreakPoints.insert(static_cast<std::size_t>(impl->string.length()));
 }
@@ -61,6 +61,12 @@ public:
         mailbox->push(actor::makeMessage(object, fn, std::forward<Args>(args)...));
     }
 
+    // Allows this actor to process up to `size` queued messages per scheduling
+    // turn. See Mailbox::setBatchSize.
+    void setBatchSize(std::size_t size) {
+        mailbox->setBatchSize(size);
+    }
+
     ActorRef<std::decay_t<Object>> self() {
         return ActorRef<std::decay_t<Object>>(object, mailbox);
     }
@@ -0,0 +1,56 @@
+#include <mbgl/actor/instrumentation.hpp>
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+
+namespace mbgl {
+namespace actor {
+
+namespace {
+
+// `interval` doubles as the enabled flag so that the per-push fast path is a
+// single relaxed load. The callback is kept behind a shared_ptr swapped under
+// a mutex: samples are rare by construction, so the lock on the reporting
+// path is uncontended, while a sampler uninstalled mid-flight stays alive
+// until in-progress reports are done with it.
+std::atomic<uint32_t> samplingInterval { 0 };
+std::atomic<uint32_t> pushCounter { 0 };
+
+std::mutex callbackMutex;
+std::shared_ptr<const MessageSampleCallback> callback;
+
+} // namespace
+
+void setMessageSampler(uint32_t interval, MessageSampleCallback callback_) {
+    std::lock_guard<std::mutex> lock(callbackMutex);
+    if (interval == 0 || !callback_) {
+        samplingInterval.store(0, std::memory_order_relaxed);
+        callback.reset();
+    } else {
+        callback = std::make_shared<const MessageSampleCallback>(std::move(callback_));
+        samplingInterval.store(interval, std::memory_order_release);
+    }
+}
+
+bool shouldSampleMessage() {
+    const uint32_t interval = samplingInterval.load(std::memory_order_relaxed);
+    if (interval == 0) {
+        return false;
+    }
+    return pushCounter.fetch_add(1, std::memory_order_relaxed) % interval == 0;
+}
+
+void reportMessageSample(const MessageSample& sample) {
+    std::shared_ptr<const MessageSampleCallback> localCallback;
+    {
+        std::lock_guard<std::mutex> lock(callbackMutex);
+        localCallback = callback;
+    }
+    if (localCallback) {
+        (*localCallback)(sample);
+    }
+}
+
+} // namespace actor
+} // namespace mbgl
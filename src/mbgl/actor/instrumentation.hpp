@@ -0,0 +1,43 @@
+#pragma once
+
+#include <mbgl/util/chrono.hpp>
+
+#include <cstdint>
+#include <functional>
+
+namespace mbgl {
+
+class Mailbox;
+
+namespace actor {
+
+// One processed message, as observed by the sampling instrumentation.
+// Interpreting a stream of samples: deep queues with short waits mean the
+// receiving actor is the bottleneck; shallow queues with long waits mean the
+// scheduler's threads are busy elsewhere; little traffic at all while tiles
+// are slow points at the network.
+struct MessageSample {
+    const Mailbox* mailbox;  // identifies the actor's queue across samples
+    std::size_t queueDepth;  // messages still queued when this one was dequeued
+    Duration waitTime;       // time spent queued before processing began
+    Duration processingTime; // time spent executing the message
+};
+
+using MessageSampleCallback = std::function<void (const MessageSample&)>;
+
+// Installs a process-wide sampling hook: every `interval`-th message pushed to
+// any mailbox is timestamped and reported through the callback once processed.
+// The callback runs on whichever thread processed the message, so it must be
+// thread-safe and cheap. An interval of 0 (or an empty callback) disables
+// sampling; disabled sampling costs one relaxed atomic load per push.
+void setMessageSampler(uint32_t interval, MessageSampleCallback);
+
+// Internal, called by Mailbox: whether the message being pushed should carry a
+// timestamp and be reported when processed.
+bool shouldSampleMessage();
+
+// Internal, called by Mailbox after processing a sampled message.
+void reportMessageSample(const MessageSample&);
+
+} // namespace actor
+} // namespace mbgl
@@ -1,8 +1,11 @@
 #include <mbgl/actor/mailbox.hpp>
+#include <mbgl/actor/instrumentation.hpp>
 #include <mbgl/actor/message.hpp>
 #include <mbgl/actor/scheduler.hpp>
 
+#include <algorithm>
 #include <cassert>
+#include <vector>
 
 namespace mbgl {
 
@@ -10,17 +13,30 @@ Mailbox::Mailbox(Scheduler& scheduler_)
     : scheduler(scheduler_) {
 }
 
-void Mailbox::push(std::unique_ptr<Message> message) {
+void Mailbox::push(MessageHolder message) {
     assert(!closing);
 
+    Enqueued enqueued { std::move(message), TimePoint(), false };
+    if (actor::shouldSampleMessage()) {
+        enqueued.pushed = Clock::now();
+        enqueued.sampled = true;
+    }
+
     std::lock_guard<std::mutex> queueLock(queueMutex);
     bool wasEmpty = queue.empty();
-    queue.push(std::move(message));
+    queue.push(std::move(enqueued));
     if (wasEmpty) {
         scheduler.schedule(shared_from_this());
     }
 }
 
+void Mailbox::setBatchSize(std::size_t size) {
+    assert(size > 0);
+
+    std::lock_guard<std::mutex> queueLock(queueMutex);
+    batchSize = size;
+}
+
 void Mailbox::close() {
     // Block until the scheduler is guaranteed not to be executing receive().
     std::lock_guard<std::mutex> closingLock(closingMutex);
@@ -34,20 +50,42 @@ void Mailbox::receive() {
         return;
     }
 
-    std::unique_ptr<Message> message;
-    bool wasEmpty;
+    // Drain up to `batchSize` messages under a single queue lock rather than
+    // re-locking and rescheduling for each one.
+    std::vector<Enqueued> batch;
+    bool empty;
+    std::size_t remaining;
 
     {
         std::lock_guard<std::mutex> queueLock(queueMutex);
         assert(!queue.empty());
-        message = std::move(queue.front());
-        queue.pop();
-        wasEmpty = queue.empty();
+        std::size_t count = std::min(batchSize, queue.size());
+        batch.reserve(count);
+        while (count-- > 0) {
+            batch.push_back(std::move(queue.front()));
+            queue.pop();
+        }
+        empty = queue.empty();
+        remaining = queue.size();
     }
 
-    (*message)();
+    for (std::size_t i = 0; i < batch.size(); ++i) {
+        Enqueued& enqueued = batch[i];
+        if (enqueued.sampled) {
+            const TimePoint started = Clock::now();
+            enqueued.message();
+            const TimePoint finished = Clock::now();
+            // Messages drained after this one are still effectively queued.
+            actor::reportMessageSample({ this,
+                                         remaining + (batch.size() - 1 - i),
+                                         started - enqueued.pushed,
+                                         finished - started });
+        } else {
+            enqueued.message();
+        }
+    }
 
-    if (!wasEmpty) {
+    if (!empty) {
         scheduler.schedule(shared_from_this());
     }
 }
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <mbgl/actor/message.hpp>
+#include <mbgl/util/chrono.hpp>
+
 #include <memory>
 #include <mutex>
 #include <queue>
@@ -7,13 +10,18 @@
 namespace mbgl {
 
 class Scheduler;
-class Message;
 
 class Mailbox : public std::enable_shared_from_this<Mailbox> {
 public:
     Mailbox(Scheduler&);
 
-    void push(std::unique_ptr<Message>);
+    void push(MessageHolder);
+
+    // Sets how many queued messages a single receive() call may process. The
+    // default of 1 preserves strict message-by-message scheduling; larger
+    // values drain up to `size` messages under a single queue lock, which cuts
+    // per-message locking and rescheduling for high-traffic mailboxes.
+    void setBatchSize(std::size_t size);
 
     void close();
     void receive();
@@ -26,8 +34,17 @@ private:
     std::mutex closingMutex;
     bool closing { false };
 
+    // A queued message; `pushed` is only stamped when the instrumentation
+    // picked the message as a sample (see actor/instrumentation.hpp).
+    struct Enqueued {
+        MessageHolder message;
+        TimePoint pushed;
+        bool sampled;
+    };
+
     std::mutex queueMutex;
-    std::queue<std::unique_ptr<Message>> queue;
+    std::queue<Enqueued> queue;
+    std::size_t batchSize { 1 };
 };
 
 } // namespace mbgl
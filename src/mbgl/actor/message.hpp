@@ -1,5 +1,9 @@
 #pragma once
 
+#include <cstddef>
+#include <new>
+#include <tuple>
+#include <type_traits>
 #include <utility>
 
 namespace mbgl {
@@ -11,6 +15,11 @@ class Message {
 public:
     virtual ~Message() = default;
     virtual void operator()() = 0;
+
+    // Move-constructs the concrete message into `target`, which must provide
+    // suitably sized and aligned storage. Used when a MessageHolder with
+    // inline storage is itself moved.
+    virtual Message* moveTo(void* target) = 0;
 };
 
 template <class Object, class MemberFn, class ArgsTuple>
@@ -26,6 +35,10 @@ public:
         invoke(std::make_index_sequence<std::tuple_size<ArgsTuple>::value>());
     }
 
+    Message* moveTo(void* target) override {
+        return new (target) MessageImpl(std::move(*this));
+    }
+
     template <std::size_t... I>
     void invoke(std::index_sequence<I...>) {
         (object.*memberFn)(std::move(std::get<I>(argsTuple))...);
@@ -36,12 +49,96 @@ public:
     ArgsTuple argsTuple;
 };
 
+// Owns a type-erased message. Implementations that fit the inline buffer are
+// stored inside the holder itself, so steady-state actor traffic — thousands
+// of messages per second during gestures — does not touch the allocator;
+// oversized messages fall back to the heap.
+class MessageHolder {
+public:
+    MessageHolder() = default;
+
+    MessageHolder(MessageHolder&& other) noexcept {
+        *this = std::move(other);
+    }
+
+    MessageHolder& operator=(MessageHolder&& other) noexcept {
+        reset();
+        if (other.message) {
+            if (other.inlineStored) {
+                message = other.message->moveTo(&storage);
+                inlineStored = true;
+                other.reset();
+            } else {
+                message = other.message;
+                other.message = nullptr;
+            }
+        }
+        return *this;
+    }
+
+    ~MessageHolder() {
+        reset();
+    }
+
+    template <class Impl, class... Args>
+    static MessageHolder make(Args&&... args) {
+        MessageHolder holder;
+        holder.emplace<Impl>(
+            std::integral_constant<bool, (sizeof(Impl) <= sizeof(Storage) &&
+                                          alignof(Impl) <= alignof(Storage))>(),
+            std::forward<Args>(args)...);
+        return holder;
+    }
+
+    explicit operator bool() const {
+        return message != nullptr;
+    }
+
+    void operator()() {
+        (*message)();
+    }
+
+private:
+    template <class Impl, class... Args>
+    void emplace(std::true_type /* fits inline */, Args&&... args) {
+        message = new (&storage) Impl(std::forward<Args>(args)...);
+        inlineStored = true;
+    }
+
+    template <class Impl, class... Args>
+    void emplace(std::false_type /* heap fallback */, Args&&... args) {
+        message = new Impl(std::forward<Args>(args)...);
+    }
+
+    void reset() {
+        if (!message) {
+            return;
+        }
+        if (inlineStored) {
+            message->~Message();
+        } else {
+            delete message;
+        }
+        message = nullptr;
+        inlineStored = false;
+    }
+
+    // Sized for the typical tile worker message: member function pointer,
+    // object reference, and an argument tuple of a few pointers and IDs.
+    using Storage = std::aligned_storage_t<160, alignof(std::max_align_t)>;
+    Storage storage;
+
+    Message* message = nullptr;
+    bool inlineStored = false;
+};
+
 namespace actor {
 
 template <class Object, class MemberFn, class... Args>
-std::unique_ptr<Message> makeMessage(Object& object, MemberFn memberFn, Args&&... args) {
+MessageHolder makeMessage(Object& object, MemberFn memberFn, Args&&... args) {
     auto tuple = std::make_tuple(std::forward<Args>(args)...);
-    return std::make_unique<MessageImpl<Object, MemberFn, decltype(tuple)>>(object, memberFn, std::move(tuple));
+    return MessageHolder::make<MessageImpl<Object, MemberFn, decltype(tuple)>>(
+        object, memberFn, std::move(tuple));
 }
 
 } // namespace actor
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <mbgl/actor/actor_ref.hpp>
+
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+namespace mbgl {
+
+/*
+    A single-use group of closures fanned out over a scheduler's thread pool.
+    The owning thread calls join(), which drains the queue on the calling
+    thread as well; helper messages scheduled on sibling pool threads merely
+    accelerate it. Completion therefore never depends on another pool thread
+    becoming available, so a fully loaded pool cannot deadlock on its own
+    subtasks.
+*/
+class TaskGroup {
+public:
+    void add(std::function<void()> task) {
+        std::lock_guard<std::mutex> lock(mutex);
+        tasks.push_back(std::move(task));
+        ++total;
+    }
+
+    // Runs one queued task, if any is left.
+    void runOne() {
+        std::function<void()> task;
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (tasks.empty()) {
+                return;
+            }
+            task = std::move(tasks.back());
+            tasks.pop_back();
+        }
+
+        try {
+            task();
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!error) {
+                error = std::current_exception();
+            }
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            ++completed;
+        }
+
+        cv.notify_one();
+    }
+
+    // Drains remaining tasks on the calling thread and blocks until every
+    // task has finished, including those picked up by helpers. Rethrows the
+    // first exception thrown by a task.
+    void join() {
+        while (true) {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (tasks.empty()) {
+                    break;
+                }
+            }
+            runOne();
+        }
+
+        std::unique_lock<std::mutex> lock(mutex);
+        cv.wait(lock, [this] { return completed == total; });
+
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+
+private:
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::vector<std::function<void()>> tasks;
+    std::size_t total = 0;
+    std::size_t completed = 0;
+    std::exception_ptr error;
+};
+
+// Actor wrapper that lets sibling pool threads pull tasks from a TaskGroup.
+class TaskGroupHelper {
+public:
+    TaskGroupHelper(ActorRef<TaskGroupHelper>, TaskGroup& group_)
+        : group(group_) {
+    }
+
+    void runOne() {
+        group.runOne();
+    }
+
+private:
+    TaskGroup& group;
+};
+
+} // namespace mbgl
@@ -9,6 +9,9 @@
 #include <mbgl/style/layers/symbol_layer.hpp>
 #include <mbgl/style/layers/symbol_layer_impl.hpp>
 #include <mbgl/storage/file_source.hpp>
+#include <mbgl/util/constants.hpp>
+
+#include <mapbox/geometry/envelope.hpp>
 
 #include <boost/function_output_iterator.hpp>
 
@@ -16,6 +19,36 @@ namespace mbgl {
 
 using namespace style;
 
+namespace {
+
+LatLngBounds shapeBounds(const ShapeAnnotationGeometry& geometry) {
+    return ShapeAnnotationGeometry::visit(geometry, [] (const auto& geometry_) {
+        const auto box = mapbox::geometry::envelope(geometry_);
+        return LatLngBounds::hull({ box.min.y, box.min.x }, { box.max.y, box.max.x });
+    });
+}
+
+LatLngBounds symbolBounds(const SymbolAnnotation& annotation) {
+    const Point<double>& p = annotation.geometry;
+    return LatLngBounds::singleton({ p.y, p.x });
+}
+
+// Whether changes within the given bounds can affect the tile's contents.
+// Shape tiles pick up geometry from slightly outside their boundaries (the
+// shape tiler runs with a 255/util::EXTENT buffer), so the tile bounds are
+// padded accordingly.
+bool tileAffected(const CanonicalTileID& tileID, const LatLngBounds& bounds) {
+    const double bufferFraction = 255.0 / util::EXTENT;
+    const LatLngBounds tileBounds(tileID);
+    const double padLat = (tileBounds.north() - tileBounds.south()) * bufferFraction;
+    const double padLng = (tileBounds.east() - tileBounds.west()) * bufferFraction;
+    return LatLngBounds::hull({ tileBounds.south() - padLat, tileBounds.west() - padLng },
+                              { tileBounds.north() + padLat, tileBounds.east() + padLng })
+        .intersects(bounds);
+}
+
+} // namespace
+
 const std::string AnnotationManager::SourceID = "com.mapbox.annotations";
 const std::string AnnotationManager::PointLayerID = "com.mapbox.annotations.points";
 
@@ -54,9 +87,11 @@ Update AnnotationManager::updateAnnotation(const AnnotationID& id, const Annotat
 
 void AnnotationManager::removeAnnotation(const AnnotationID& id) {
     if (symbolAnnotations.find(id) != symbolAnnotations.end()) {
+        markDirty(symbolBounds(symbolAnnotations.at(id)->annotation));
         symbolTree.remove(symbolAnnotations.at(id));
         symbolAnnotations.erase(id);
     } else if (shapeAnnotations.find(id) != shapeAnnotations.end()) {
+        markDirty(shapeBounds(shapeAnnotations.at(id)->geometry()));
         obsoleteShapeAnnotationLayers.insert(shapeAnnotations.at(id)->layerID);
         shapeAnnotations.erase(id);
     } else {
@@ -68,24 +103,28 @@ void AnnotationManager::add(const AnnotationID& id, const SymbolAnnotation& anno
     auto impl = std::make_shared<SymbolAnnotationImpl>(id, annotation);
     symbolTree.insert(impl);
     symbolAnnotations.emplace(id, impl);
+    markDirty(symbolBounds(annotation));
 }
 
 void AnnotationManager::add(const AnnotationID& id, const LineAnnotation& annotation, const uint8_t maxZoom) {
     ShapeAnnotationImpl& impl = *shapeAnnotations.emplace(id,
         std::make_unique<LineAnnotationImpl>(id, annotation, maxZoom)).first->second;
     obsoleteShapeAnnotationLayers.erase(impl.layerID);
+    markDirty(shapeBounds(impl.geometry()));
 }
 
 void AnnotationManager::add(const AnnotationID& id, const FillAnnotation& annotation, const uint8_t maxZoom) {
     ShapeAnnotationImpl& impl = *shapeAnnotations.emplace(id,
         std::make_unique<FillAnnotationImpl>(id, annotation, maxZoom)).first->second;
     obsoleteShapeAnnotationLayers.erase(impl.layerID);
+    markDirty(shapeBounds(impl.geometry()));
 }
 
 void AnnotationManager::add(const AnnotationID& id, const StyleSourcedAnnotation& annotation, const uint8_t maxZoom) {
     ShapeAnnotationImpl& impl = *shapeAnnotations.emplace(id,
         std::make_unique<StyleSourcedAnnotationImpl>(id, annotation, maxZoom)).first->second;
     obsoleteShapeAnnotationLayers.erase(impl.layerID);
+    markDirty(shapeBounds(impl.geometry()));
 }
 
 Update AnnotationManager::update(const AnnotationID& id, const SymbolAnnotation& annotation, const uint8_t maxZoom) {
@@ -205,10 +244,22 @@ void AnnotationManager::updateStyle(Style& style) {
     obsoleteShapeAnnotationLayers.clear();
 }
 
+void AnnotationManager::markDirty(const LatLngBounds& bounds) {
+    if (!dirtyBounds) {
+        dirtyBounds = LatLngBounds::empty();
+    }
+    dirtyBounds->extend(bounds);
+}
+
 void AnnotationManager::updateData() {
     for (auto& tile : tiles) {
+        if (dirtyBounds && !tileAffected(tile->id.canonical, *dirtyBounds)) {
+            // No annotation within reach of this tile changed.
+            continue;
+        }
         tile->setData(getTileData(tile->id.canonical));
     }
+    dirtyBounds = {};
 }
 
 void AnnotationManager::addTile(AnnotationTile& tile) {
@@ -218,6 +269,9 @@ void AnnotationManager::addTile(AnnotationTile& tile) {
 
 void AnnotationManager::removeTile(AnnotationTile& tile) {
     tiles.erase(&tile);
+    for (const auto& shape : shapeAnnotations) {
+        shape.second->evictTileData(tile.id.canonical);
+    }
 }
 
 void AnnotationManager::addIcon(const std::string& name, std::shared_ptr<const SpriteImage> sprite) {
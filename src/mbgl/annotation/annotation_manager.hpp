@@ -4,7 +4,9 @@
 #include <mbgl/annotation/symbol_annotation_impl.hpp>
 #include <mbgl/sprite/sprite_atlas.hpp>
 #include <mbgl/map/update.hpp>
+#include <mbgl/util/geo.hpp>
 #include <mbgl/util/noncopyable.hpp>
+#include <mbgl/util/optional.hpp>
 
 #include <string>
 #include <vector>
@@ -13,7 +15,6 @@
 
 namespace mbgl {
 
-class LatLngBounds;
 class AnnotationTile;
 class AnnotationTileData;
 class SymbolAnnotationImpl;
@@ -59,6 +60,10 @@ private:
 
     void removeAndAdd(const AnnotationID&, const Annotation&, const uint8_t);
 
+    // Extends the region covering the annotations added or removed since the
+    // last updateData(); only tiles intersecting it are refreshed.
+    void markDirty(const LatLngBounds&);
+
     std::unique_ptr<AnnotationTileData> getTileData(const CanonicalTileID&);
 
     AnnotationID nextID = 0;
@@ -74,6 +79,9 @@ private:
     ShapeAnnotationMap shapeAnnotations;
     std::unordered_set<std::string> obsoleteShapeAnnotationLayers;
     std::unordered_set<AnnotationTile*> tiles;
+    // Disengaged when no change has been recorded; updateData() then
+    // refreshes every tile (e.g. after icon changes, whose reach is unknown).
+    optional<LatLngBounds> dirtyBounds;
     SpriteAtlas spriteAtlas;
 };
 
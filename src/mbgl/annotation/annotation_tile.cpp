@@ -44,6 +44,15 @@ std::unique_ptr<GeometryTileData> AnnotationTileData::clone() const {
     return std::make_unique<AnnotationTileData>(*this);
 }
 
+bool AnnotationTileData::empty() const {
+    for (const auto& pair : layers) {
+        if (pair.second.featureCount() > 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
 const GeometryTileLayer* AnnotationTileData::getLayer(const std::string& name) const {
     auto it = layers.find(name);
     if (it != layers.end()) {
@@ -32,7 +32,7 @@ public:
     FeatureType getType() const override { return type; }
     optional<Value> getValue(const std::string&) const override;
     optional<FeatureIdentifier> getID() const override { return { static_cast<uint64_t>(id) }; }
-    GeometryCollection getGeometries() const override { return geometries; }
+    const GeometryCollection& getGeometries() const override { return geometries; }
 
     const AnnotationID id;
     const FeatureType type;
@@ -58,6 +58,7 @@ class AnnotationTileData : public GeometryTileData {
 public:
     std::unique_ptr<GeometryTileData> clone() const override;
     const GeometryTileLayer* getLayer(const std::string&) const override;
+    bool empty() const override;
 
     std::unordered_map<std::string, AnnotationTileLayer> layers;
 };
@@ -21,6 +21,18 @@ ShapeAnnotationImpl::ShapeAnnotationImpl(const AnnotationID id_, const uint8_t m
 void ShapeAnnotationImpl::updateTileData(const CanonicalTileID& tileID, AnnotationTileData& data) {
     static const double baseTolerance = 4;
 
+    auto cached = tileCache.find(tileID);
+    if (cached != tileCache.end()) {
+        if (cached->second.empty())
+            return;
+
+        AnnotationTileLayer& layer = data.layers.emplace(layerID, layerID).first->second;
+        for (const auto& feature : cached->second) {
+            layer.features.emplace_back(id, feature.type, feature.geometry);
+        }
+        return;
+    }
+
     if (!shapeTiler) {
         mapbox::geometry::feature_collection<double> features;
         features.emplace_back(ShapeAnnotationGeometry::visit(geometry(), [] (auto&& geom) {
@@ -35,10 +47,11 @@ void ShapeAnnotationImpl::updateTileData(const CanonicalTileID& tileID, Annotati
     }
 
     const auto& shapeTile = shapeTiler->getTile(tileID.z, tileID.x, tileID.y);
-    if (shapeTile.features.empty())
-        return;
 
-    AnnotationTileLayer& layer = data.layers.emplace(layerID, layerID).first->second;
+    // Cache the result — including "nothing here" — so the next refresh of
+    // this tile skips the geometry conversion and polygon fixup entirely.
+    // The memory cost is bounded by the set of tiles currently on screen.
+    std::vector<TileFeature>& features = tileCache[tileID];
 
     ToGeometryCollection toGeometryCollection;
     ToFeatureType toFeatureType;
@@ -53,7 +66,15 @@ void ShapeAnnotationImpl::updateTileData(const CanonicalTileID& tileID, Annotati
             renderGeometry = fixupPolygons(renderGeometry);
         }
 
-        layer.features.emplace_back(id, featureType, renderGeometry);
+        features.push_back({ featureType, std::move(renderGeometry) });
+    }
+
+    if (features.empty())
+        return;
+
+    AnnotationTileLayer& layer = data.layers.emplace(layerID, layerID).first->second;
+    for (const auto& feature : features) {
+        layer.features.emplace_back(id, feature.type, feature.geometry);
     }
 }
 
@@ -3,15 +3,18 @@
 #include <mapbox/geojsonvt.hpp>
 
 #include <mbgl/annotation/annotation.hpp>
+#include <mbgl/tile/tile_id.hpp>
+#include <mbgl/tile/geometry_tile_data.hpp>
 #include <mbgl/util/geometry.hpp>
 
+#include <map>
 #include <string>
 #include <memory>
+#include <vector>
 
 namespace mbgl {
 
 class AnnotationTileData;
-class CanonicalTileID;
 
 namespace style {
 class Style;
@@ -27,10 +30,27 @@ public:
 
     void updateTileData(const CanonicalTileID&, AnnotationTileData&);
 
+    // Drops the cached render geometry for a tile that is no longer held by
+    // any annotation source.
+    void evictTileData(const CanonicalTileID& tileID) {
+        tileCache.erase(tileID);
+    }
+
     const AnnotationID id;
     const uint8_t maxZoom;
     const std::string layerID;
     std::unique_ptr<mapbox::geojsonvt::GeoJSONVT> shapeTiler;
+
+private:
+    // The finished render geometry for one tile. The shape itself is
+    // immutable (updates replace the whole impl), so once a tile's geometry
+    // has been tiled and fixed up it can be replayed verbatim whenever that
+    // tile refreshes because some *other* annotation changed.
+    struct TileFeature {
+        FeatureType type;
+        GeometryCollection geometry;
+    };
+    std::map<CanonicalTileID, std::vector<TileFeature>> tileCache;
 };
 
 struct CloseShapeAnnotation {
@@ -2,100 +2,186 @@
 
 #include <mbgl/util/noncopyable.hpp>
 #include <mbgl/util/rect.hpp>
+
+#include <algorithm>
 #include <cstdint>
-#include <list>
+#include <limits>
+#include <vector>
 
 namespace mbgl {
 
+/*
+    A shelf packer with merging. The atlas is divided into horizontal shelves;
+    an allocation goes onto the open shelf with the least height waste (best
+    height fit), claiming a horizontal span of it. Released spans merge with
+    their free neighbors on the same shelf, fully free shelves merge with
+    adjacent free shelves, and a free shelf at the top of the packed region
+    returns its space to the unshelved remainder — so alternating allocate and
+    release cycles, as SpriteAtlas and GlyphAtlas produce, do not fragment the
+    atlas the way the previous guillotine packer did. An empty shelf taller
+    than a request is split rather than wasted.
+
+    Allocated rects are never relocated: the atlases bake texture coordinates
+    into bucket vertex data, so entries must keep their position for as long
+    as they are alive.
+*/
 template <typename T>
 class BinPack : private util::noncopyable {
 public:
-    BinPack(T width, T height)
-        : free(1, Rect<uint16_t>{ 0, 0, width, height }) {}
-public:
-    Rect<T> allocate(T width, T height) {
-        // Find the smallest free rect angle
-        auto smallest = free.end();
-        for (auto it = free.begin(); it != free.end(); ++it) {
-            const Rect<T>& ref = *it;
-            const Rect<T>& rect = *smallest;
-            if (width <= ref.w && height <= ref.h) {
-                if (smallest == free.end() || (ref.y <= rect.y && ref.x <= rect.x)) {
-                    smallest = it;
-                } else {
-                    // Our current "smallest" rect is already closer to 0/0.
-                }
-            } else {
-                // The rect in the free list is not big enough.
-            }
+    BinPack(T width_, T height_)
+        : width(width_), height(height_) {}
+
+    Rect<T> allocate(T w, T h) {
+        if (w == 0 || h == 0 || w > width || h > height) {
+            return Rect<T>{ 0, 0, 0, 0 };
         }
 
-        if (smallest == free.end()) {
-            // There's no space left for this char.
-            return Rect<uint16_t>{ 0, 0, 0, 0 };
-        } else {
-            Rect<T> rect = *smallest;
-            free.erase(smallest);
-
-            // Shorter/Longer Axis Split Rule (SAS)
-            // http://clb.demon.fi/files/RectangleBinPack.pdf p. 15
-            // Ignore the dimension of R and just split long the shorter dimension
-            // See Also: http://www.cs.princeton.edu/~chazelle/pubs/blbinpacking.pdf
-            if (rect.w < rect.h) {
-                // split horizontally
-                // +--+---+
-                // |__|___|  <-- b1
-                // +------+  <-- b2
-                if (rect.w > width) free.emplace_back(rect.x + width, rect.y, rect.w - width, height);
-                if (rect.h > height) free.emplace_back(rect.x, rect.y + height, rect.w, rect.h - height);
-            } else {
-                // split vertically
-                // +--+---+
-                // |__|   | <-- b1
-                // +--|---+ <-- b2
-                if (rect.w > width) free.emplace_back(rect.x + width, rect.y, rect.w - width, rect.h);
-                if (rect.h > height) free.emplace_back(rect.x, rect.y + height, width, rect.h - height);
+        // Best height fit: the open shelf wasting the least height. A fully
+        // free shelf can be split, so it wastes nothing regardless of height.
+        Shelf* best = nullptr;
+        T bestWaste = std::numeric_limits<T>::max();
+        for (auto& shelf : shelves) {
+            if (shelf.height < h || !hasSpan(shelf, w)) {
+                continue;
+            }
+            const T waste = isEmpty(shelf) ? 0 : shelf.height - h;
+            if (waste < bestWaste) {
+                best = &shelf;
+                bestWaste = waste;
             }
+        }
 
-            return Rect<uint16_t>{ rect.x, rect.y, width, height };
+        // Prefer opening a fresh shelf over wasting height on an existing one.
+        if ((!best || bestWaste > 0) && h <= height - shelfTop) {
+            shelves.push_back(Shelf{ shelfTop, h, { Span{ 0, width } } });
+            shelfTop = shelfTop + h;
+            best = &shelves.back();
+        }
+
+        if (!best) {
+            // There's no space left for this rect.
+            return Rect<T>{ 0, 0, 0, 0 };
         }
-    }
 
+        if (isEmpty(*best) && best->height > h) {
+            best = &splitShelf(*best, h);
+        }
+
+        return takeSpan(*best, w, h);
+    }
 
     void release(Rect<T> rect) {
-        // Simple algorithm to recursively merge the newly released cell with its
-        // neighbor. This doesn't merge more than two cells at a time, and fails
-        // for complicated merges.
-        for (auto it = free.begin(); it != free.end(); ++it) {
-            Rect<T> ref = *it;
-            if (ref.y == rect.y && ref.h == rect.h && ref.x + ref.w == rect.x) {
-                ref.w += rect.w;
+        auto it = std::lower_bound(shelves.begin(), shelves.end(), rect.y,
+                                   [] (const Shelf& shelf, T y) { return shelf.y < y; });
+        if (it == shelves.end() || it->y != rect.y) {
+            return; // Not an allocated rect.
+        }
+
+        insertSpan(*it, Span{ rect.x, rect.w });
+
+        if (isEmpty(*it)) {
+            mergeEmptyShelves();
+        }
+    }
+
+private:
+    struct Span {
+        T x;
+        T w;
+    };
+
+    // Horizontal slice of the atlas: allocations on it share its y and
+    // reserve its full height. `spans` lists the free stretches, sorted by x.
+    struct Shelf {
+        T y;
+        T height;
+        std::vector<Span> spans;
+    };
+
+    static bool hasSpan(const Shelf& shelf, T w) {
+        for (const auto& span : shelf.spans) {
+            if (span.w >= w) {
+                return true;
             }
-            else if (ref.x == rect.x && ref.w == rect.w && ref.y + ref.h == rect.y) {
-                ref.h += rect.h;
+        }
+        return false;
+    }
+
+    bool isEmpty(const Shelf& shelf) const {
+        return shelf.spans.size() == 1 && shelf.spans.front().x == 0 &&
+               shelf.spans.front().w == width;
+    }
+
+    // Shrinks `shelf` to the requested height and reopens the rest as an
+    // empty shelf directly below it.
+    Shelf& splitShelf(Shelf& shelf, T h) {
+        const std::size_t index = &shelf - shelves.data();
+        Shelf remainder{ static_cast<T>(shelf.y + h), static_cast<T>(shelf.height - h),
+                         { Span{ 0, width } } };
+        shelf.height = h;
+        shelves.insert(shelves.begin() + index + 1, std::move(remainder));
+        return shelves[index];
+    }
+
+    Rect<T> takeSpan(Shelf& shelf, T w, T h) {
+        // Best width fit among the shelf's free spans.
+        auto best = shelf.spans.end();
+        for (auto it = shelf.spans.begin(); it != shelf.spans.end(); ++it) {
+            if (it->w >= w && (best == shelf.spans.end() || it->w < best->w)) {
+                best = it;
             }
-            else if (rect.y == ref.y && rect.h == ref.h && rect.x + rect.w == ref.x) {
-                ref.x = rect.x;
-                ref.w += rect.w;
+        }
+
+        Rect<T> rect{ best->x, shelf.y, w, h };
+        best->x = best->x + w;
+        best->w = best->w - w;
+        if (best->w == 0) {
+            shelf.spans.erase(best);
+        }
+        return rect;
+    }
+
+    void insertSpan(Shelf& shelf, Span span) {
+        auto next = std::lower_bound(shelf.spans.begin(), shelf.spans.end(), span.x,
+                                     [] (const Span& ref, T x) { return ref.x < x; });
+
+        if (next != shelf.spans.end() && span.x + span.w == next->x) {
+            span.w = span.w + next->w;
+            next = shelf.spans.erase(next);
+        }
+        if (next != shelf.spans.begin()) {
+            auto prev = std::prev(next);
+            if (prev->x + prev->w == span.x) {
+                prev->w = prev->w + span.w;
+                return;
             }
-            else if (rect.x == ref.x && rect.w == ref.w && rect.y + rect.h == ref.y) {
-                ref.y = rect.y;
-                ref.h += rect.h;
+        }
+        shelf.spans.insert(next, span);
+    }
+
+    void mergeEmptyShelves() {
+        // Adjacent fully free shelves combine into one taller free shelf, and
+        // a free shelf bordering the unshelved remainder dissolves into it.
+        for (std::size_t i = 0; i + 1 < shelves.size();) {
+            if (isEmpty(shelves[i]) && isEmpty(shelves[i + 1])) {
+                shelves[i].height = shelves[i].height + shelves[i + 1].height;
+                shelves.erase(shelves.begin() + i + 1);
             } else {
-                continue;
+                ++i;
             }
-
-            free.erase(it);
-            release(ref);
-            return;
-
         }
 
-        free.emplace_back(rect);
-    };
+        while (!shelves.empty() && isEmpty(shelves.back()) &&
+               shelves.back().y + shelves.back().height == shelfTop) {
+            shelfTop = shelves.back().y;
+            shelves.pop_back();
+        }
+    }
 
-private:
-    std::list<Rect<T>> free;
+    const T width;
+    const T height;
+    T shelfTop = 0;
+    std::vector<Shelf> shelves;
 };
 
 } // namespace mbgl
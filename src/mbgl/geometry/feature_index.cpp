@@ -15,25 +15,25 @@
 
 namespace mbgl {
 
-FeatureIndex::FeatureIndex()
-    : grid(util::EXTENT, 16, 0) {
-}
-
 void FeatureIndex::insert(const GeometryCollection& geometries,
                           std::size_t index,
-                          const std::string& sourceLayerName,
-                          const std::string& bucketName) {
+                          const util::InternedString& sourceLayerName,
+                          const util::InternedString& bucketName) {
+    assert(!tree);
     for (const auto& ring : geometries) {
-        grid.insert(IndexedSubfeature { index, sourceLayerName, bucketName, sortIndex++ },
-                    mapbox::geometry::envelope(ring));
+        const auto envelope = mapbox::geometry::envelope(ring);
+        boxes.emplace_back(FeatureIndexBox { { envelope.min.x, envelope.min.y },
+                                             { envelope.max.x, envelope.max.y } },
+                           features.size());
+        features.push_back(IndexedSubfeature { index, sourceLayerName, bucketName, sortIndex++ });
     }
 }
 
-static bool vectorContains(const std::vector<std::string>& vector, const std::string& s) {
+static bool vectorContains(const std::vector<util::InternedString>& vector, const util::InternedString& s) {
     return std::find(vector.begin(), vector.end(), s) != vector.end();
 }
 
-static bool vectorsIntersect(const std::vector<std::string>& vectorA, const std::vector<std::string>& vectorB) {
+static bool vectorsIntersect(const std::vector<util::InternedString>& vectorA, const std::vector<util::InternedString>& vectorB) {
     for (const auto& a : vectorA) {
         if (vectorContains(vectorB, a)) {
             return true;
@@ -62,21 +62,44 @@ void FeatureIndex::query(
         const style::Style& style,
         const CollisionTile* collisionTile) const {
 
+    // Intern the filter once per query; candidate filtering below then runs
+    // on integer tokens rather than re-hashing strings per feature.
+    optional<std::vector<util::InternedString>> internedFilterIDs;
+    if (filterLayerIDs) {
+        internedFilterIDs.emplace(filterLayerIDs->begin(), filterLayerIDs->end());
+    }
+
     mapbox::geometry::box<int16_t> box = mapbox::geometry::envelope(queryGeometry);
 
     const float pixelsToTileUnits = util::EXTENT / tileSize / scale;
     const int16_t additionalRadius = std::min<int16_t>(util::EXTENT, std::ceil(style.getQueryRadius() * pixelsToTileUnits));
-    std::vector<IndexedSubfeature> features = grid.query({ box.min - additionalRadius, box.max + additionalRadius });
 
-    std::sort(features.begin(), features.end(), topDown);
+    // Bulk-load the R-tree on the first query; by then the index is complete.
+    if (!tree) {
+        tree.emplace(boxes.begin(), boxes.end());
+    }
+
+    const FeatureIndexBox queryBox {
+        { static_cast<int16_t>(box.min.x - additionalRadius),
+          static_cast<int16_t>(box.min.y - additionalRadius) },
+        { static_cast<int16_t>(box.max.x + additionalRadius),
+          static_cast<int16_t>(box.max.y + additionalRadius) }
+    };
+
+    std::vector<IndexedSubfeature> candidates;
+    for (auto it = tree->qbegin(bgi::intersects(queryBox)); it != tree->qend(); ++it) {
+        candidates.push_back(features[it->second]);
+    }
+
+    std::sort(candidates.begin(), candidates.end(), topDown);
     size_t previousSortIndex = std::numeric_limits<size_t>::max();
-    for (const auto& indexedFeature : features) {
+    for (const auto& indexedFeature : candidates) {
 
         // If this feature is the same as the previous feature, skip it.
         if (indexedFeature.sortIndex == previousSortIndex) continue;
         previousSortIndex = indexedFeature.sortIndex;
 
-        addFeature(result, indexedFeature, queryGeometry, filterLayerIDs, geometryTileData, tileID, style, bearing, pixelsToTileUnits);
+        addFeature(result, indexedFeature, queryGeometry, internedFilterIDs, geometryTileData, tileID, style, bearing, pixelsToTileUnits);
     }
 
     // Query symbol features, if they've been placed.
@@ -87,7 +110,7 @@ void FeatureIndex::query(
     std::vector<IndexedSubfeature> symbolFeatures = collisionTile->queryRenderedSymbols(queryGeometry, scale);
     std::sort(symbolFeatures.begin(), symbolFeatures.end(), topDownSymbols);
     for (const auto& symbolFeature : symbolFeatures) {
-        addFeature(result, symbolFeature, queryGeometry, filterLayerIDs, geometryTileData, tileID, style, bearing, pixelsToTileUnits);
+        addFeature(result, symbolFeature, queryGeometry, internedFilterIDs, geometryTileData, tileID, style, bearing, pixelsToTileUnits);
     }
 }
 
@@ -95,7 +118,7 @@ void FeatureIndex::addFeature(
     std::unordered_map<std::string, std::vector<Feature>>& result,
     const IndexedSubfeature& indexedFeature,
     const GeometryCoordinates& queryGeometry,
-    const optional<std::vector<std::string>>& filterLayerIDs,
+    const optional<std::vector<util::InternedString>>& filterLayerIDs,
     const GeometryTileData& geometryTileData,
     const CanonicalTileID& tileID,
     const style::Style& style,
@@ -107,17 +130,18 @@ void FeatureIndex::addFeature(
         return;
     }
 
-    auto sourceLayer = geometryTileData.getLayer(indexedFeature.sourceLayerName);
+    auto sourceLayer = geometryTileData.getLayer(indexedFeature.sourceLayerName.str());
     assert(sourceLayer);
 
     auto geometryTileFeature = sourceLayer->getFeature(indexedFeature.index);
     assert(geometryTileFeature);
 
-    for (const auto& layerID : layerIDs) {
-        if (filterLayerIDs && !vectorContains(*filterLayerIDs, layerID)) {
+    for (const auto& internedLayerID : layerIDs) {
+        if (filterLayerIDs && !vectorContains(*filterLayerIDs, internedLayerID)) {
             continue;
         }
 
+        const std::string& layerID = internedLayerID.str();
         auto styleLayer = style.getLayer(layerID);
         if (!styleLayer ||
             (!styleLayer->is<style::SymbolLayer>() &&
@@ -152,7 +176,8 @@ optional<GeometryCoordinates> FeatureIndex::translateQueryGeometry(
 }
 
 void FeatureIndex::setBucketLayerIDs(const std::string& bucketName, const std::vector<std::string>& layerIDs) {
-    bucketLayerIDs[bucketName] = layerIDs;
+    bucketLayerIDs[util::InternedString(bucketName)] =
+        std::vector<util::InternedString>(layerIDs.begin(), layerIDs.end());
 }
 
 } // namespace mbgl
@@ -2,15 +2,30 @@
 
 #include <mbgl/style/types.hpp>
 #include <mbgl/tile/geometry_tile_data.hpp>
-#include <mbgl/util/grid_index.hpp>
 #include <mbgl/util/feature.hpp>
+#include <mbgl/util/interned_string.hpp>
+#include <mbgl/util/optional.hpp>
+
+#include <boost/geometry.hpp>
+#include <boost/geometry/geometries/point.hpp>
+#include <boost/geometry/geometries/box.hpp>
+#include <boost/geometry/index/rtree.hpp>
 
 #include <vector>
 #include <string>
 #include <unordered_map>
+#include <utility>
 
 namespace mbgl {
 
+namespace bg = boost::geometry;
+namespace bgm = bg::model;
+namespace bgi = bg::index;
+typedef bgm::point<int16_t, 2, bg::cs::cartesian> FeatureIndexPoint;
+typedef bgm::box<FeatureIndexPoint> FeatureIndexBox;
+typedef std::pair<FeatureIndexBox, std::size_t> FeatureIndexTreeBox;
+typedef bgi::rtree<FeatureIndexTreeBox, bgi::linear<16, 4>> FeatureIndexTree;
+
 namespace style {
 class Style;
 } // namespace style
@@ -22,16 +37,16 @@ class IndexedSubfeature {
 public:
     IndexedSubfeature() = delete;
     std::size_t index;
-    std::string sourceLayerName;
-    std::string bucketName;
+    // Interned handles: one subfeature is indexed per ring per feature, so
+    // carrying (and later hashing) full strings here is a per-tile hot path.
+    util::InternedString sourceLayerName;
+    util::InternedString bucketName;
     size_t sortIndex;
 };
 
 class FeatureIndex {
 public:
-    FeatureIndex();
-
-    void insert(const GeometryCollection&, std::size_t index, const std::string& sourceLayerName, const std::string& bucketName);
+    void insert(const GeometryCollection&, std::size_t index, const util::InternedString& sourceLayerName, const util::InternedString& bucketName);
 
     void query(
             std::unordered_map<std::string, std::vector<Feature>>& result,
@@ -54,21 +69,39 @@ public:
 
     void setBucketLayerIDs(const std::string& bucketName, const std::vector<std::string>& layerIDs);
 
+    // Pre-sizes the backing storage; the tile worker passes the previous
+    // layout's entry count so steady-state re-layouts avoid regrowth.
+    void reserve(std::size_t entries) {
+        features.reserve(entries);
+        boxes.reserve(entries);
+    }
+
+    std::size_t size() const {
+        return features.size();
+    }
+
 private:
     void addFeature(
             std::unordered_map<std::string, std::vector<Feature>>& result,
             const IndexedSubfeature&,
             const GeometryCoordinates& queryGeometry,
-            const optional<std::vector<std::string>>& filterLayerIDs,
+            const optional<std::vector<util::InternedString>>& filterLayerIDs,
             const GeometryTileData&,
             const CanonicalTileID&,
             const style::Style&,
             const float bearing,
             const float pixelsToTileUnits) const;
 
-    GridIndex<IndexedSubfeature> grid;
+    // Boxes accumulate during tile layout; the packed (bulk-loaded) R-tree
+    // over them is built on first query, once the index has stopped changing.
+    // A bulk-loaded tree is both cheaper to construct and faster to query
+    // than one grown by repeated insertion.
+    std::vector<IndexedSubfeature> features;
+    std::vector<FeatureIndexTreeBox> boxes;
+    mutable optional<FeatureIndexTree> tree;
+
     unsigned int sortIndex = 0;
 
-    std::unordered_map<std::string, std::vector<std::string>> bucketLayerIDs;
+    std::unordered_map<util::InternedString, std::vector<util::InternedString>> bucketLayerIDs;
 };
 } // namespace mbgl
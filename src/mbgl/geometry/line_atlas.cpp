@@ -1,47 +1,89 @@
 #include <mbgl/geometry/line_atlas.hpp>
 #include <mbgl/gl/context.hpp>
 #include <mbgl/util/logging.hpp>
+#include <mbgl/util/memory_budget.hpp>
 #include <mbgl/util/platform.hpp>
 
 #include <boost/functional/hash.hpp>
 
+#include <algorithm>
 #include <sstream>
 #include <cmath>
 
 namespace mbgl {
 
-LineAtlas::LineAtlas(const Size size)
-    : image(size),
-      dirty(true) {
-}
-
-LineAtlas::~LineAtlas() = default;
+namespace {
 
-LinePatternPos LineAtlas::getDashPosition(const std::vector<float>& dasharray,
-                                          LinePatternCap patternCap) {
+size_t dashKey(const std::vector<float>& dasharray, LinePatternCap patternCap) {
     size_t key = patternCap == LinePatternCap::Round ? std::numeric_limits<size_t>::min()
                                                      : std::numeric_limits<size_t>::max();
     for (const float part : dasharray) {
         boost::hash_combine<float>(key, part);
     }
+    return key;
+}
+
+} // namespace
+
+LineAtlas::LineAtlas(const Size size)
+    : image(size),
+      dirtyMin(size.height),
+      dirtyMax(0) {
+    // The atlas page is referenced by live buckets, so it only reports its
+    // usage and cannot be trimmed.
+    memoryBudgetId = MemoryBudget::Register("LineAtlas", [this] { return image.bytes(); });
+}
+
+LineAtlas::~LineAtlas() {
+    MemoryBudget::Unregister(memoryBudgetId);
+}
 
+LinePatternPos LineAtlas::getDashPosition(const std::vector<float>& dasharray,
+                                          LinePatternCap patternCap) {
     // Note: We're not handling hash collisions here.
-    const auto it = positions.find(key);
+    const auto it = positions.find(dashKey(dasharray, patternCap));
     if (it == positions.end()) {
-        auto inserted = positions.emplace(key, addDash(dasharray, patternCap));
-        assert(inserted.second);
-        return inserted.first->second;
+        return addDash(dasharray, patternCap);
     } else {
-        return it->second;
+        it->second.lastUse = ++useCounter;
+        return it->second.pos;
     }
 }
 
+optional<uint32_t> LineAtlas::allocateRows(uint8_t height) {
+    if (nextRow + height <= image.size.height) {
+        const uint32_t row = nextRow;
+        nextRow += height;
+        return row;
+    }
+
+    // The atlas is full: recycle the band of the least recently used pattern
+    // of the same height. The two most recently touched entries are the
+    // from/to positions of the dash transition currently being drawn, so
+    // they are pinned.
+    auto lru = positions.end();
+    for (auto it = positions.begin(); it != positions.end(); ++it) {
+        if (it->second.height == height && it->second.lastUse + 2 <= useCounter &&
+            (lru == positions.end() || it->second.lastUse < lru->second.lastUse)) {
+            lru = it;
+        }
+    }
+    if (lru == positions.end()) {
+        return {};
+    }
+
+    const uint32_t row = lru->second.row;
+    positions.erase(lru);
+    return row;
+}
+
 LinePatternPos LineAtlas::addDash(const std::vector<float>& dasharray, LinePatternCap patternCap) {
     const uint8_t n = patternCap == LinePatternCap::Round ? 7 : 0;
     const uint8_t dashheight = 2 * n + 1;
     const uint8_t offset = 128;
 
-    if (nextRow + dashheight > image.size.height) {
+    const optional<uint32_t> allocatedRow = allocateRows(dashheight);
+    if (!allocatedRow) {
         Log::Warning(Event::OpenGL, "line atlas bitmap overflow");
         return LinePatternPos();
     }
@@ -58,7 +100,7 @@ LinePatternPos LineAtlas::addDash(const std::vector<float>& dasharray, LinePatte
     bool oddLength = dasharray.size() % 2 == 1;
 
     for (int y = -n; y <= n; y++) {
-        int row = nextRow + n + y;
+        int row = *allocatedRow + n + y;
         int index = image.size.width * row;
 
         float left = 0;
@@ -106,17 +148,23 @@ LinePatternPos LineAtlas::addDash(const std::vector<float>& dasharray, LinePatte
     }
 
     LinePatternPos position;
-    position.y = (0.5 + nextRow + n) / image.size.height;
+    position.y = (0.5 + *allocatedRow + n) / image.size.height;
     position.height = (2.0 * n) / image.size.height;
     position.width = length;
 
-    nextRow += dashheight;
+    positions[dashKey(dasharray, patternCap)] =
+        DashEntry { position, *allocatedRow, dashheight, ++useCounter };
 
-    dirty = true;
+    markDirty(*allocatedRow, dashheight);
 
     return position;
 }
 
+void LineAtlas::markDirty(const uint32_t row, const uint8_t height) {
+    dirtyMin = std::min(dirtyMin, row);
+    dirtyMax = std::max(dirtyMax, row + height - 1);
+}
+
 Size LineAtlas::getSize() const {
     return image.size;
 }
@@ -124,11 +172,13 @@ Size LineAtlas::getSize() const {
 void LineAtlas::upload(gl::Context& context, gl::TextureUnit unit) {
     if (!texture) {
         texture = context.createTexture(image, unit);
-    } else if (dirty) {
-        context.updateTexture(*texture, image, unit);
+    } else if (dirtyMin <= dirtyMax) {
+        // Only the band of rows touched since the last upload is re-sent.
+        context.updateTextureBand(*texture, image, dirtyMin, dirtyMax - dirtyMin + 1, unit);
     }
 
-    dirty = false;
+    dirtyMin = image.size.height;
+    dirtyMax = 0;
 }
 
 void LineAtlas::bind(gl::Context& context, gl::TextureUnit unit) {
@@ -45,11 +45,35 @@ public:
     Size getSize() const;
 
 private:
+    // A rendered dash pattern occupying a band of rows in the atlas.
+    // Equivalent dasharrays from different layers hash to the same entry, so
+    // each distinct pattern is rendered once regardless of how many layers
+    // use it. lastUse orders entries for eviction when the atlas is full.
+    struct DashEntry {
+        LinePatternPos pos;
+        uint32_t row;
+        uint8_t height;
+        uint64_t lastUse;
+    };
+
+    // Returns the topmost row of a free band of the given height, recycling
+    // the band of the least recently used pattern of the same height when
+    // the atlas is full. Bands are only ever 1 (square cap) or 15 (round
+    // cap) rows tall, so exact-height reuse doesn't fragment the atlas.
+    optional<uint32_t> allocateRows(uint8_t height);
+    void markDirty(uint32_t row, uint8_t height);
+
     const AlphaImage image;
-    bool dirty;
     mbgl::optional<gl::Texture> texture;
     uint32_t nextRow = 0;
-    std::unordered_map<size_t, LinePatternPos> positions;
+    uint64_t memoryBudgetId;
+    uint64_t useCounter = 0;
+
+    // Dirty band of rows to re-upload, inclusive; empty when min > max.
+    uint32_t dirtyMin;
+    uint32_t dirtyMax;
+
+    std::unordered_map<size_t, DashEntry> positions;
 };
 
 } // namespace mbgl
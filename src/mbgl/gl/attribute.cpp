@@ -7,6 +7,7 @@ namespace mbgl {
 namespace gl {
 
 static_assert(offsetof(Normalized<uint8_t>, value) == 0, "unexpected normalized offset");
+static_assert(sizeof(Normalized<uint8_t>) == sizeof(uint8_t), "unexpected normalized size");
 
 AttributeLocation bindAttributeLocation(ProgramID id, AttributeLocation location, const char* name) {
     MBGL_CHECK_ERROR(glBindAttribLocation(id, location, name));
@@ -26,6 +27,16 @@ template <class T> bool IsNormalized                  = false;
 template <class T> bool IsNormalized<Normalized<T>>   = true;
 template <class T> DataType DataTypeOf<Normalized<T>> = DataTypeOf<T>;
 
+template <class T>
+float componentValue(T value) {
+    return value;
+}
+
+template <class T>
+float componentValue(Normalized<T> value) {
+    return value.denormalized();
+}
+
 template <class T, std::size_t N>
 void VariableAttributeBinding<T, N>::bind(Context& context,
                                           AttributeLocation location,
@@ -70,169 +81,64 @@ template class VariableAttributeBinding<float, 2>;
 template class VariableAttributeBinding<float, 3>;
 template class VariableAttributeBinding<float, 4>;
 
-template <>
-void ConstantAttributeBinding<uint8_t, 1>::bind(Context&, AttributeLocation location, optional<VariableAttributeBinding<uint8_t, 1>>& oldBinding, std::size_t) const {
-    assert(location != 0);
-    oldBinding = {};
-    MBGL_CHECK_ERROR(glDisableVertexAttribArray(location));
-    MBGL_CHECK_ERROR(glVertexAttrib1f(location, value[0]));
-}
-
-template <>
-void ConstantAttributeBinding<uint8_t, 2>::bind(Context&, AttributeLocation location, optional<VariableAttributeBinding<uint8_t, 2>>& oldBinding, std::size_t) const {
-    assert(location != 0);
-    oldBinding = {};
-    MBGL_CHECK_ERROR(glDisableVertexAttribArray(location));
-    MBGL_CHECK_ERROR(glVertexAttrib2f(location, value[0], value[1]));
-}
-
-template <>
-void ConstantAttributeBinding<uint8_t, 3>::bind(Context&, AttributeLocation location, optional<VariableAttributeBinding<uint8_t, 3>>& oldBinding, std::size_t) const {
-    assert(location != 0);
-    oldBinding = {};
-    MBGL_CHECK_ERROR(glDisableVertexAttribArray(location));
-    MBGL_CHECK_ERROR(glVertexAttrib3f(location, value[0], value[1], value[2]));
-}
-
-template <>
-void ConstantAttributeBinding<uint8_t, 4>::bind(Context&, AttributeLocation location, optional<VariableAttributeBinding<uint8_t, 4>>& oldBinding, std::size_t) const {
-    assert(location != 0);
-    oldBinding = {};
-    MBGL_CHECK_ERROR(glDisableVertexAttribArray(location));
-    MBGL_CHECK_ERROR(glVertexAttrib4f(location, value[0], value[1], value[2], value[3]));
-}
-
-
-template <>
-void ConstantAttributeBinding<Normalized<uint8_t>, 1>::bind(Context&, AttributeLocation location, optional<VariableAttributeBinding<Normalized<uint8_t>, 1>>& oldBinding, std::size_t) const {
-    assert(location != 0);
-    oldBinding = {};
-    MBGL_CHECK_ERROR(glDisableVertexAttribArray(location));
-    MBGL_CHECK_ERROR(glVertexAttrib1f(location, value[0].denormalized()));
-}
-
-template <>
-void ConstantAttributeBinding<Normalized<uint8_t>, 2>::bind(Context&, AttributeLocation location, optional<VariableAttributeBinding<Normalized<uint8_t>, 2>>& oldBinding, std::size_t) const {
-    assert(location != 0);
-    oldBinding = {};
-    MBGL_CHECK_ERROR(glDisableVertexAttribArray(location));
-    MBGL_CHECK_ERROR(glVertexAttrib2f(location, value[0].denormalized(), value[1].denormalized()));
-}
-
-template <>
-void ConstantAttributeBinding<Normalized<uint8_t>, 3>::bind(Context&, AttributeLocation location, optional<VariableAttributeBinding<Normalized<uint8_t>, 3>>& oldBinding, std::size_t) const {
-    assert(location != 0);
-    oldBinding = {};
-    MBGL_CHECK_ERROR(glDisableVertexAttribArray(location));
-    MBGL_CHECK_ERROR(glVertexAttrib3f(location, value[0].denormalized(), value[1].denormalized(), value[2].denormalized()));
-}
-
-template <>
-void ConstantAttributeBinding<Normalized<uint8_t>, 4>::bind(Context&, AttributeLocation location, optional<VariableAttributeBinding<Normalized<uint8_t>, 4>>& oldBinding, std::size_t) const {
-    assert(location != 0);
-    oldBinding = {};
-    MBGL_CHECK_ERROR(glDisableVertexAttribArray(location));
-    MBGL_CHECK_ERROR(glVertexAttrib4f(location, value[0].denormalized(), value[1].denormalized(), value[2].denormalized(), value[3].denormalized()));
-}
-
-
-template <>
-void ConstantAttributeBinding<uint16_t, 1>::bind(Context&, AttributeLocation location, optional<VariableAttributeBinding<uint16_t, 1>>& oldBinding, std::size_t) const {
-    assert(location != 0);
-    oldBinding = {};
-    MBGL_CHECK_ERROR(glDisableVertexAttribArray(location));
-    MBGL_CHECK_ERROR(glVertexAttrib1f(location, value[0]));
-}
-
-template <>
-void ConstantAttributeBinding<uint16_t, 2>::bind(Context&, AttributeLocation location, optional<VariableAttributeBinding<uint16_t, 2>>& oldBinding, std::size_t) const {
-    assert(location != 0);
-    oldBinding = {};
-    MBGL_CHECK_ERROR(glDisableVertexAttribArray(location));
-    MBGL_CHECK_ERROR(glVertexAttrib2f(location, value[0], value[1]));
-}
-
-template <>
-void ConstantAttributeBinding<uint16_t, 3>::bind(Context&, AttributeLocation location, optional<VariableAttributeBinding<uint16_t, 3>>& oldBinding, std::size_t) const {
-    assert(location != 0);
-    oldBinding = {};
-    MBGL_CHECK_ERROR(glDisableVertexAttribArray(location));
-    MBGL_CHECK_ERROR(glVertexAttrib3f(location, value[0], value[1], value[2]));
-}
-
-template <>
-void ConstantAttributeBinding<uint16_t, 4>::bind(Context&, AttributeLocation location, optional<VariableAttributeBinding<uint16_t, 4>>& oldBinding, std::size_t) const {
+template <class T, std::size_t N>
+void ConstantAttributeBinding<T, N>::bind(Context& context,
+                                          AttributeLocation location,
+                                          optional<VariableAttributeBinding<T, N>>& oldBinding,
+                                          std::size_t) const {
     assert(location != 0);
-    oldBinding = {};
-    MBGL_CHECK_ERROR(glDisableVertexAttribArray(location));
-    MBGL_CHECK_ERROR(glVertexAttrib4f(location, value[0], value[1], value[2], value[3]));
-}
-
+    assert(static_cast<std::size_t>(location) < AttributeMax);
 
-template <>
-void ConstantAttributeBinding<int16_t, 1>::bind(Context&, AttributeLocation location, optional<VariableAttributeBinding<int16_t, 1>>& oldBinding, std::size_t) const {
-    assert(location != 0);
-    oldBinding = {};
-    MBGL_CHECK_ERROR(glDisableVertexAttribArray(location));
-    MBGL_CHECK_ERROR(glVertexAttrib1f(location, value[0]));
-}
+    // The enabled/disabled flag is part of VAO state: a fresh VAO starts with
+    // every array disabled, and oldBinding holds a value only when a variable
+    // binding has enabled this attribute in the currently bound VAO.
+    if (oldBinding) {
+        oldBinding = {};
+        MBGL_CHECK_ERROR(glDisableVertexAttribArray(location));
+    }
 
-template <>
-void ConstantAttributeBinding<int16_t, 2>::bind(Context&, AttributeLocation location, optional<VariableAttributeBinding<int16_t, 2>>& oldBinding, std::size_t) const {
-    assert(location != 0);
-    oldBinding = {};
-    MBGL_CHECK_ERROR(glDisableVertexAttribArray(location));
-    MBGL_CHECK_ERROR(glVertexAttrib2f(location, value[0], value[1]));
-}
+    // The generic attribute value itself is context-global, not VAO state, so
+    // it is cached per location in the Context. Components beyond N stay at
+    // the GL defaults (0, 0, 0, 1), matching what glVertexAttrib{1..4}f would
+    // leave there, so bindings of different arity compare correctly.
+    std::array<float, 4> components {{ 0, 0, 0, 1 }};
+    for (std::size_t i = 0; i < N; ++i) {
+        components[i] = componentValue(value[i]);
+    }
 
-template <>
-void ConstantAttributeBinding<int16_t, 3>::bind(Context&, AttributeLocation location, optional<VariableAttributeBinding<int16_t, 3>>& oldBinding, std::size_t) const {
-    assert(location != 0);
-    oldBinding = {};
-    MBGL_CHECK_ERROR(glDisableVertexAttribArray(location));
-    MBGL_CHECK_ERROR(glVertexAttrib3f(location, value[0], value[1], value[2]));
-}
+    auto& cached = context.constantAttributeValues[location];
+    if (cached && *cached == components) {
+        return;
+    }
+    cached = components;
 
-template <>
-void ConstantAttributeBinding<int16_t, 4>::bind(Context&, AttributeLocation location, optional<VariableAttributeBinding<int16_t, 4>>& oldBinding, std::size_t) const {
-    assert(location != 0);
-    oldBinding = {};
-    MBGL_CHECK_ERROR(glDisableVertexAttribArray(location));
-    MBGL_CHECK_ERROR(glVertexAttrib4f(location, value[0], value[1], value[2], value[3]));
+    MBGL_CHECK_ERROR(glVertexAttrib4fv(location, components.data()));
 }
 
+template class ConstantAttributeBinding<uint8_t, 1>;
+template class ConstantAttributeBinding<uint8_t, 2>;
+template class ConstantAttributeBinding<uint8_t, 3>;
+template class ConstantAttributeBinding<uint8_t, 4>;
 
-template <>
-void ConstantAttributeBinding<float, 1>::bind(Context&, AttributeLocation location, optional<VariableAttributeBinding<float, 1>>& oldBinding, std::size_t) const {
-    assert(location != 0);
-    oldBinding = {};
-    MBGL_CHECK_ERROR(glDisableVertexAttribArray(location));
-    MBGL_CHECK_ERROR(glVertexAttrib1f(location, value[0]));
-}
+template class ConstantAttributeBinding<Normalized<uint8_t>, 1>;
+template class ConstantAttributeBinding<Normalized<uint8_t>, 2>;
+template class ConstantAttributeBinding<Normalized<uint8_t>, 3>;
+template class ConstantAttributeBinding<Normalized<uint8_t>, 4>;
 
-template <>
-void ConstantAttributeBinding<float, 2>::bind(Context&, AttributeLocation location, optional<VariableAttributeBinding<float, 2>>& oldBinding, std::size_t) const {
-    assert(location != 0);
-    oldBinding = {};
-    MBGL_CHECK_ERROR(glDisableVertexAttribArray(location));
-    MBGL_CHECK_ERROR(glVertexAttrib2f(location, value[0], value[1]));
-}
+template class ConstantAttributeBinding<uint16_t, 1>;
+template class ConstantAttributeBinding<uint16_t, 2>;
+template class ConstantAttributeBinding<uint16_t, 3>;
+template class ConstantAttributeBinding<uint16_t, 4>;
 
-template <>
-void ConstantAttributeBinding<float, 3>::bind(Context&, AttributeLocation location, optional<VariableAttributeBinding<float, 3>>& oldBinding, std::size_t) const {
-    assert(location != 0);
-    oldBinding = {};
-    MBGL_CHECK_ERROR(glDisableVertexAttribArray(location));
-    MBGL_CHECK_ERROR(glVertexAttrib3f(location, value[0], value[1], value[2]));
-}
+template class ConstantAttributeBinding<int16_t, 1>;
+template class ConstantAttributeBinding<int16_t, 2>;
+template class ConstantAttributeBinding<int16_t, 3>;
+template class ConstantAttributeBinding<int16_t, 4>;
 
-template <>
-void ConstantAttributeBinding<float, 4>::bind(Context&, AttributeLocation location, optional<VariableAttributeBinding<float, 4>>& oldBinding, std::size_t) const {
-    assert(location != 0);
-    oldBinding = {};
-    MBGL_CHECK_ERROR(glDisableVertexAttribArray(location));
-    MBGL_CHECK_ERROR(glVertexAttrib4f(location, value[0], value[1], value[2], value[3]));
-}
+template class ConstantAttributeBinding<float, 1>;
+template class ConstantAttributeBinding<float, 2>;
+template class ConstantAttributeBinding<float, 3>;
+template class ConstantAttributeBinding<float, 4>;
 
 } // namespace gl
 } // namespace mbgl
@@ -8,6 +8,7 @@
 
 #include <cstddef>
 #include <functional>
+#include <type_traits>
 
 namespace mbgl {
 namespace gl {
@@ -66,14 +67,12 @@ public:
     using VariableBinding = VariableAttributeBinding<T, N>;
     using ConstantBinding = ConstantAttributeBinding<T, N>;
 
-    using Location = AttributeLocation;
-
     using Binding = variant<
         ConstantBinding,
         VariableBinding>;
 
     static void bind(Context& context,
-                     const Location& location,
+                     AttributeLocation location,
                      optional<VariableBinding>& oldBinding,
                      const Binding& newBinding,
                      std::size_t vertexOffset) {
@@ -110,7 +109,6 @@ public:
     typename A1::Value a1;
 
     using VertexType = Vertex<A1>;
-    static const std::size_t attributeOffsets[1];
 };
 
 template <class A1, class A2>
@@ -120,7 +118,6 @@ public:
     typename A2::Value a2;
 
     using VertexType = Vertex<A1, A2>;
-    static const std::size_t attributeOffsets[2];
 };
 
 template <class A1, class A2, class A3>
@@ -131,7 +128,6 @@ public:
     typename A3::Value a3;
 
     using VertexType = Vertex<A1, A2, A3>;
-    static const std::size_t attributeOffsets[3];
 };
 
 template <class A1, class A2, class A3, class A4>
@@ -143,7 +139,6 @@ public:
     typename A4::Value a4;
 
     using VertexType = Vertex<A1, A2, A3, A4>;
-    static const std::size_t attributeOffsets[4];
 };
 
 template <class A1, class A2, class A3, class A4, class A5>
@@ -156,44 +151,114 @@ public:
     typename A5::Value a5;
 
     using VertexType = Vertex<A1, A2, A3, A4, A5>;
-    static const std::size_t attributeOffsets[5];
 };
 
+// Compile-time description of the interleaved layout: the offset of the I-th
+// attribute within the vertex, as a constant expression. The member typedef
+// keeps the template-id's comma out of the offsetof macro invocation.
+
+template <class V, std::size_t I>
+struct AttributeOffset;
+
 template <class A1>
-const std::size_t Vertex<A1>::attributeOffsets[1] = {
-    offsetof(VertexType, a1)
+struct AttributeOffset<Vertex<A1>, 0> {
+    using VertexType = Vertex<A1>;
+    static constexpr std::size_t value = offsetof(VertexType, a1);
 };
 
 template <class A1, class A2>
-const std::size_t Vertex<A1, A2>::attributeOffsets[2] = {
-    offsetof(VertexType, a1),
-    offsetof(VertexType, a2)
+struct AttributeOffset<Vertex<A1, A2>, 0> {
+    using VertexType = Vertex<A1, A2>;
+    static constexpr std::size_t value = offsetof(VertexType, a1);
+};
+
+template <class A1, class A2>
+struct AttributeOffset<Vertex<A1, A2>, 1> {
+    using VertexType = Vertex<A1, A2>;
+    static constexpr std::size_t value = offsetof(VertexType, a2);
 };
 
 template <class A1, class A2, class A3>
-const std::size_t Vertex<A1, A2, A3>::attributeOffsets[3] = {
-    offsetof(VertexType, a1),
-    offsetof(VertexType, a2),
-    offsetof(VertexType, a3)
+struct AttributeOffset<Vertex<A1, A2, A3>, 0> {
+    using VertexType = Vertex<A1, A2, A3>;
+    static constexpr std::size_t value = offsetof(VertexType, a1);
+};
+
+template <class A1, class A2, class A3>
+struct AttributeOffset<Vertex<A1, A2, A3>, 1> {
+    using VertexType = Vertex<A1, A2, A3>;
+    static constexpr std::size_t value = offsetof(VertexType, a2);
+};
+
+template <class A1, class A2, class A3>
+struct AttributeOffset<Vertex<A1, A2, A3>, 2> {
+    using VertexType = Vertex<A1, A2, A3>;
+    static constexpr std::size_t value = offsetof(VertexType, a3);
+};
+
+template <class A1, class A2, class A3, class A4>
+struct AttributeOffset<Vertex<A1, A2, A3, A4>, 0> {
+    using VertexType = Vertex<A1, A2, A3, A4>;
+    static constexpr std::size_t value = offsetof(VertexType, a1);
+};
+
+template <class A1, class A2, class A3, class A4>
+struct AttributeOffset<Vertex<A1, A2, A3, A4>, 1> {
+    using VertexType = Vertex<A1, A2, A3, A4>;
+    static constexpr std::size_t value = offsetof(VertexType, a2);
+};
+
+template <class A1, class A2, class A3, class A4>
+struct AttributeOffset<Vertex<A1, A2, A3, A4>, 2> {
+    using VertexType = Vertex<A1, A2, A3, A4>;
+    static constexpr std::size_t value = offsetof(VertexType, a3);
 };
 
 template <class A1, class A2, class A3, class A4>
-const std::size_t Vertex<A1, A2, A3, A4>::attributeOffsets[4] = {
-    offsetof(VertexType, a1),
-    offsetof(VertexType, a2),
-    offsetof(VertexType, a3),
-    offsetof(VertexType, a4)
+struct AttributeOffset<Vertex<A1, A2, A3, A4>, 3> {
+    using VertexType = Vertex<A1, A2, A3, A4>;
+    static constexpr std::size_t value = offsetof(VertexType, a4);
+};
+
+template <class A1, class A2, class A3, class A4, class A5>
+struct AttributeOffset<Vertex<A1, A2, A3, A4, A5>, 0> {
+    using VertexType = Vertex<A1, A2, A3, A4, A5>;
+    static constexpr std::size_t value = offsetof(VertexType, a1);
 };
 
 template <class A1, class A2, class A3, class A4, class A5>
-const std::size_t Vertex<A1, A2, A3, A4, A5>::attributeOffsets[5] = {
-    offsetof(VertexType, a1),
-    offsetof(VertexType, a2),
-    offsetof(VertexType, a3),
-    offsetof(VertexType, a4),
-    offsetof(VertexType, a5)
+struct AttributeOffset<Vertex<A1, A2, A3, A4, A5>, 1> {
+    using VertexType = Vertex<A1, A2, A3, A4, A5>;
+    static constexpr std::size_t value = offsetof(VertexType, a2);
+};
+
+template <class A1, class A2, class A3, class A4, class A5>
+struct AttributeOffset<Vertex<A1, A2, A3, A4, A5>, 2> {
+    using VertexType = Vertex<A1, A2, A3, A4, A5>;
+    static constexpr std::size_t value = offsetof(VertexType, a3);
+};
+
+template <class A1, class A2, class A3, class A4, class A5>
+struct AttributeOffset<Vertex<A1, A2, A3, A4, A5>, 3> {
+    using VertexType = Vertex<A1, A2, A3, A4, A5>;
+    static constexpr std::size_t value = offsetof(VertexType, a4);
 };
 
+template <class A1, class A2, class A3, class A4, class A5>
+struct AttributeOffset<Vertex<A1, A2, A3, A4, A5>, 4> {
+    using VertexType = Vertex<A1, A2, A3, A4, A5>;
+    static constexpr std::size_t value = offsetof(VertexType, a5);
+};
+
+constexpr std::size_t sumOfSizes() {
+    return 0;
+}
+
+template <class... Sizes>
+constexpr std::size_t sumOfSizes(std::size_t first, Sizes... rest) {
+    return first + sumOfSizes(rest...);
+}
+
 } // namespace detail
 
 AttributeLocation bindAttributeLocation(ProgramID, AttributeLocation, const char * name);
@@ -202,9 +267,6 @@ template <class... As>
 class Attributes {
 public:
     using Types = TypeList<As...>;
-    using Locations = IndexedTuple<
-        TypeList<As...>,
-        TypeList<typename As::Location...>>;
     using Bindings = IndexedTuple<
         TypeList<As...>,
         TypeList<typename As::Binding...>>;
@@ -217,30 +279,44 @@ public:
     template <class A>
     static constexpr std::size_t Index = TypeIndex<A, As...>::value;
 
-    static Locations locations(const ProgramID& id) {
-        return Locations { bindAttributeLocation(id, Index<As>, As::name())... };
+    // The interleaved layout — stride and per-attribute offsets — is fully
+    // determined at compile time.
+    static constexpr std::size_t Stride = sizeof(Vertex);
+
+    template <class A>
+    static constexpr std::size_t Offset = detail::AttributeOffset<Vertex, Index<A>>::value;
+
+    static_assert(std::is_standard_layout<Vertex>::value, "vertex type must use standard layout");
+    static_assert(sizeof...(As) == 0 || Stride == detail::sumOfSizes(sizeof(typename As::Value)...),
+                  "vertex type must be tightly packed; padding silently bloats vertex memory");
+
+    // Attribute locations are assigned by pack index and bound by name before
+    // the program links, so the location table is a compile-time constant
+    // rather than per-program state queried back after the link.
+    template <class A>
+    static constexpr AttributeLocation Location = static_cast<AttributeLocation>(Index<A>);
+
+    static void bindLocations(const ProgramID& id) {
+        util::ignore({ (bindAttributeLocation(id, Location<As>, As::name()), 0)... });
     }
 
     template <class DrawMode>
     static Bindings allVariableBindings(const VertexBuffer<Vertex, DrawMode>& buffer) {
-        static_assert(std::is_standard_layout<Vertex>::value, "vertex type must use standard layout");
-
         return Bindings {
             typename As::VariableBinding {
                 buffer.buffer,
-                sizeof(Vertex),
-                Vertex::attributeOffsets[Index<As>]
+                Stride,
+                Offset<As>
             }...
         };
     }
 
     static void bind(Context& context,
-                     const Locations& locations,
                      VariableBindings& oldBindings,
                      const Bindings& newBindings,
                      std::size_t vertexOffset) {
         util::ignore({ (As::bind(context,
-                                 locations.template get<As>(),
+                                 Location<As>,
                                  oldBindings.template get<As>(),
                                  newBindings.template get<As>(),
                                  vertexOffset), 0)... });
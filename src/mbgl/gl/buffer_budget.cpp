@@ -0,0 +1,55 @@
+#include <mbgl/gl/buffer_budget.hpp>
+
+#include <atomic>
+
+namespace mbgl {
+namespace gl {
+
+namespace {
+
+std::atomic<std::size_t> usage { 0 };
+std::atomic<std::size_t> limit { 0 };
+
+// Beyond this factor, further coarsening destroys geometry without freeing
+// meaningful amounts of memory.
+constexpr double maximumPressure = 4.0;
+
+} // namespace
+
+void BufferBudget::SetLimit(std::size_t bytes) {
+    limit = bytes;
+}
+
+std::size_t BufferBudget::GetLimit() {
+    return limit;
+}
+
+std::size_t BufferBudget::Usage() {
+    return usage;
+}
+
+void BufferBudget::Allocated(std::size_t bytes) {
+    usage += bytes;
+}
+
+void BufferBudget::Freed(std::size_t bytes) {
+    usage -= bytes;
+}
+
+double BufferBudget::Pressure(std::size_t estimatedBytes) {
+    const std::size_t cap = limit;
+    if (cap == 0) {
+        return 1.0;
+    }
+
+    const std::size_t projected = usage + estimatedBytes;
+    if (projected <= cap) {
+        return 1.0;
+    }
+
+    const double pressure = double(projected) / double(cap);
+    return pressure < maximumPressure ? pressure : maximumPressure;
+}
+
+} // namespace gl
+} // namespace mbgl
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstddef>
+
+namespace mbgl {
+namespace gl {
+
+// Process-wide ledger of the bytes held in GL vertex and index buffers.
+//
+// Contexts report every buffer allocation and deallocation here, so the
+// ledger tracks live buffer storage across all maps in the process. Tile
+// workers consult it before layout: given an estimate of the bytes a tile is
+// about to add, Pressure() answers how far over the configured budget that
+// would land, and the worker coarsens line tessellation proportionally.
+// Degrading geometry before allocation beats finding out from the driver
+// that the allocation failed.
+//
+// All entry points are thread-safe; the counters are plain atomics.
+class BufferBudget {
+public:
+    // Sets the process-wide cap in bytes; 0 (the default) disables pressure.
+    static void SetLimit(std::size_t bytes);
+    static std::size_t GetLimit();
+
+    // Live bytes across all contexts.
+    static std::size_t Usage();
+
+    // Context bookkeeping, called at glBufferData time and when the backing
+    // store is actually deleted.
+    static void Allocated(std::size_t bytes);
+    static void Freed(std::size_t bytes);
+
+    // Projected overage if estimatedBytes were allocated now, as a factor
+    // >= 1: 1.0 while the projection fits the budget, the ratio of projection
+    // to budget beyond it, capped so a pathological tile cannot simplify
+    // geometry into mush.
+    static double Pressure(std::size_t estimatedBytes);
+};
+
+} // namespace gl
+} // namespace mbgl
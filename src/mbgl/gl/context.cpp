@@ -1,16 +1,54 @@
 #include <mbgl/map/view.hpp>
 #include <mbgl/gl/context.hpp>
+#include <mbgl/gl/buffer_budget.hpp>
 #include <mbgl/gl/gl.hpp>
+#include <mbgl/gl/extension.hpp>
 #include <mbgl/gl/vertex_array.hpp>
 #include <mbgl/util/traits.hpp>
 #include <mbgl/util/std.hpp>
 #include <mbgl/util/logging.hpp>
 
+#include <algorithm>
 #include <cstring>
+#include <limits>
+
+#ifndef GL_PROGRAM_BINARY_RETRIEVABLE_HINT
+#define GL_PROGRAM_BINARY_RETRIEVABLE_HINT 0x8257
+#endif
+
+#ifndef GL_PROGRAM_BINARY_LENGTH
+#define GL_PROGRAM_BINARY_LENGTH 0x8741
+#endif
+
+#ifndef GL_ETC1_RGB8_OES
+#define GL_ETC1_RGB8_OES 0x8D64
+#endif
+
+#ifndef GL_COMPRESSED_RGB8_ETC2
+#define GL_COMPRESSED_RGB8_ETC2 0x9274
+#endif
 
 namespace mbgl {
 namespace gl {
 
+static ExtensionFunction<void(GLuint program,
+                              GLsizei bufSize,
+                              GLsizei* length,
+                              GLenum* binaryFormat,
+                              void* binary)>
+    GetProgramBinary({ { "GL_OES_get_program_binary", "glGetProgramBinaryOES" },
+                       { "GL_ARB_get_program_binary", "glGetProgramBinary" } });
+
+static ExtensionFunction<void(GLuint program,
+                              GLenum binaryFormat,
+                              const void* binary,
+                              GLsizei length)>
+    ProgramBinary({ { "GL_OES_get_program_binary", "glProgramBinaryOES" },
+                    { "GL_ARB_get_program_binary", "glProgramBinary" } });
+
+static ExtensionFunction<void(GLuint program, GLenum pname, GLint value)>
+    ProgramParameteri({ { "GL_ARB_get_program_binary", "glProgramParameteri" } });
+
 static_assert(underlying_type(ShaderType::Vertex) == GL_VERTEX_SHADER, "OpenGL type mismatch");
 static_assert(underlying_type(ShaderType::Fragment) == GL_FRAGMENT_SHADER, "OpenGL type mismatch");
 
@@ -33,6 +71,7 @@ static_assert(std::is_same<RenderbufferID, GLuint>::value, "OpenGL type mismatch
 static_assert(std::is_same<std::underlying_type_t<TextureFormat>, GLenum>::value, "OpenGL type mismatch");
 static_assert(underlying_type(TextureFormat::RGBA) == GL_RGBA, "OpenGL type mismatch");
 static_assert(underlying_type(TextureFormat::Alpha) == GL_ALPHA, "OpenGL type mismatch");
+static_assert(underlying_type(TextureFormat::LuminanceAlpha) == GL_LUMINANCE_ALPHA, "OpenGL type mismatch");
 
 Context::~Context() {
     reset();
@@ -72,9 +111,65 @@ UniqueProgram Context::createProgram(ShaderID vertexShader, ShaderID fragmentSha
     return result;
 }
 
+bool Context::supportsProgramBinaries() const {
+    return GetProgramBinary && ProgramBinary;
+}
+
+optional<std::pair<BinaryProgramFormat, std::string>> Context::getBinaryProgram(ProgramID program_) const {
+    if (!supportsProgramBinaries()) {
+        return {};
+    }
+
+    GLint binaryLength = 0;
+    MBGL_CHECK_ERROR(glGetProgramiv(program_, GL_PROGRAM_BINARY_LENGTH, &binaryLength));
+    if (binaryLength <= 0) {
+        return {};
+    }
+
+    std::string binary;
+    binary.resize(binaryLength);
+    GLenum binaryFormat = 0;
+    MBGL_CHECK_ERROR(GetProgramBinary(program_, binaryLength, &binaryLength, &binaryFormat,
+                                      const_cast<char*>(binary.data())));
+    if (binaryLength <= 0 || binaryFormat == 0) {
+        return {};
+    }
+    binary.resize(binaryLength);
+
+    return std::make_pair(BinaryProgramFormat(binaryFormat), std::move(binary));
+}
+
+UniqueProgram Context::createProgram(BinaryProgramFormat binaryFormat, const std::string& binaryProgram) {
+    assert(supportsProgramBinaries());
+    UniqueProgram result { MBGL_CHECK_ERROR(glCreateProgram()), { this } };
+    MBGL_CHECK_ERROR(ProgramBinary(result, static_cast<GLenum>(binaryFormat), binaryProgram.data(),
+                                   static_cast<GLsizei>(binaryProgram.size())));
+    verifyProgramLinkage(result);
+    return result;
+}
+
+const std::string& Context::driverIdentity() {
+    if (cachedDriverIdentity.empty()) {
+        const char* version = reinterpret_cast<const char*>(MBGL_CHECK_ERROR(glGetString(GL_VERSION)));
+        const char* renderer = reinterpret_cast<const char*>(MBGL_CHECK_ERROR(glGetString(GL_RENDERER)));
+        cachedDriverIdentity =
+            std::string(version ? version : "unknown") + "/" + (renderer ? renderer : "unknown");
+    }
+    return cachedDriverIdentity;
+}
+
 void Context::linkProgram(ProgramID program_) {
+    if (ProgramParameteri) {
+        // Ask the driver to keep a retrievable binary around; required for
+        // glGetProgramBinary on the ARB extension, harmless otherwise.
+        MBGL_CHECK_ERROR(ProgramParameteri(program_, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE));
+    }
+
     MBGL_CHECK_ERROR(glLinkProgram(program_));
+    verifyProgramLinkage(program_);
+}
 
+void Context::verifyProgramLinkage(ProgramID program_) {
     GLint status;
     MBGL_CHECK_ERROR(glGetProgramiv(program_, GL_LINK_STATUS, &status));
     if (status == GL_TRUE) {
@@ -92,22 +187,41 @@ void Context::linkProgram(ProgramID program_) {
     throw std::runtime_error("program failed to link");
 }
 
+UniqueBuffer Context::createBuffer() {
+    // As with textures, buffer names are generated in batches and recycled
+    // through a pool: every tile re-layout replaces the buffers of all its
+    // buckets, and creating and deleting the GL objects one by one is a
+    // steady per-frame cost during animation. glBufferData re-specifies the
+    // storage from scratch, so a recycled name behaves exactly like a fresh
+    // one and any storage it still held is orphaned by the next upload.
+    if (pooledBuffers.empty()) {
+        pooledBuffers.resize(BufferMax);
+        MBGL_CHECK_ERROR(glGenBuffers(BufferMax, pooledBuffers.data()));
+    }
+
+    BufferID id = pooledBuffers.back();
+    pooledBuffers.pop_back();
+    return UniqueBuffer{ std::move(id), { this } };
+}
+
 UniqueBuffer Context::createVertexBuffer(const void* data, std::size_t size) {
-    BufferID id = 0;
-    MBGL_CHECK_ERROR(glGenBuffers(1, &id));
-    UniqueBuffer result { std::move(id), { this } };
+    UniqueBuffer result = createBuffer();
     vertexBuffer = result;
     MBGL_CHECK_ERROR(glBufferData(GL_ARRAY_BUFFER, size, data, GL_STATIC_DRAW));
+    ++stats.bufferUploads;
+    bufferSizes[result] = size;
+    BufferBudget::Allocated(size);
     return result;
 }
 
 UniqueBuffer Context::createIndexBuffer(const void* data, std::size_t size) {
-    BufferID id = 0;
-    MBGL_CHECK_ERROR(glGenBuffers(1, &id));
-    UniqueBuffer result { std::move(id), { this } };
+    UniqueBuffer result = createBuffer();
     vertexArrayObject = 0;
     elementBuffer = result;
     MBGL_CHECK_ERROR(glBufferData(GL_ELEMENT_ARRAY_BUFFER, size, data, GL_STATIC_DRAW));
+    ++stats.bufferUploads;
+    bufferSizes[result] = size;
+    BufferBudget::Allocated(size);
     return result;
 }
 
@@ -176,6 +290,77 @@ std::unique_ptr<uint8_t[]> Context::readFramebuffer(const Size size, const Textu
 }
 
 #if not MBGL_USE_GLES2
+void Context::beginFramebufferRead(const Size size, const TextureFormat format) {
+    const std::size_t stride = size.width * (format == TextureFormat::RGBA ? 4 : 1);
+    const std::size_t byteSize = stride * size.height;
+
+    auto& slot = pixelReadBuffers[pixelReadWriteCursor];
+    pixelReadWriteCursor = (pixelReadWriteCursor + 1) % pixelReadBuffers.size();
+    assert(!slot.pending);
+
+    if (!slot.buffer) {
+        BufferID id = 0;
+        MBGL_CHECK_ERROR(glGenBuffers(1, &id));
+        slot.buffer = UniqueBuffer { std::move(id), { this } };
+    }
+
+    pixelPackBuffer = *slot.buffer;
+    if (slot.byteSize != byteSize) {
+        MBGL_CHECK_ERROR(glBufferData(GL_PIXEL_PACK_BUFFER, byteSize, nullptr, GL_STREAM_READ));
+        slot.byteSize = byteSize;
+    }
+
+    pixelStorePack = { 1 };
+
+    // With a pack buffer bound, the data argument is an offset into it and
+    // the call returns once the transfer is queued.
+    MBGL_CHECK_ERROR(glReadPixels(0, 0, size.width, size.height, static_cast<GLenum>(format),
+                                  GL_UNSIGNED_BYTE, nullptr));
+    pixelPackBuffer = value::BindPixelPackBuffer::Default;
+    slot.pending = true;
+}
+
+std::unique_ptr<uint8_t[]> Context::endFramebufferRead(const Size size,
+                                                       const TextureFormat format,
+                                                       const bool flip) {
+    const std::size_t stride = size.width * (format == TextureFormat::RGBA ? 4 : 1);
+    auto data = std::make_unique<uint8_t[]>(stride * size.height);
+
+    auto& slot = pixelReadBuffers[pixelReadReadCursor];
+    pixelReadReadCursor = (pixelReadReadCursor + 1) % pixelReadBuffers.size();
+    assert(slot.pending && slot.byteSize == stride * size.height);
+
+    pixelPackBuffer = *slot.buffer;
+    const auto* pixels =
+        static_cast<const uint8_t*>(MBGL_CHECK_ERROR(glMapBuffer(GL_PIXEL_PACK_BUFFER, GL_READ_ONLY)));
+    if (pixels) {
+        if (flip) {
+            for (std::size_t i = 0; i < size.height; i++) {
+                std::memcpy(data.get() + i * stride, pixels + (size.height - 1 - i) * stride, stride);
+            }
+        } else {
+            std::memcpy(data.get(), pixels, stride * size.height);
+        }
+        MBGL_CHECK_ERROR(glUnmapBuffer(GL_PIXEL_PACK_BUFFER));
+    } else {
+        // Mapping can fail after e.g. a context loss; fall back to a copy-out.
+        MBGL_CHECK_ERROR(glGetBufferSubData(GL_PIXEL_PACK_BUFFER, 0, stride * size.height, data.get()));
+        if (flip) {
+            auto tmp = std::make_unique<uint8_t[]>(stride);
+            uint8_t* rgba = data.get();
+            for (int i = 0, j = size.height - 1; i < j; i++, j--) {
+                std::memcpy(tmp.get(), rgba + i * stride, stride);
+                std::memcpy(rgba + i * stride, rgba + j * stride, stride);
+                std::memcpy(rgba + j * stride, tmp.get(), stride);
+            }
+        }
+    }
+    pixelPackBuffer = value::BindPixelPackBuffer::Default;
+    slot.pending = false;
+
+    return data;
+}
+
 void Context::drawPixels(const Size size, const void* data, TextureFormat format) {
     pixelStoreUnpack = { 1 };
     if (format != TextureFormat::RGBA) {
@@ -293,13 +478,129 @@ Context::createTexture(const Size size, const void* data, TextureFormat format,
     return obj;
 }
 
+Texture Context::createCompressedTexture(const Size size,
+                                         const void* data,
+                                         const std::size_t byteSize,
+                                         TextureUnit unit) {
+    assert(etcTextureSupport() != ETCTextureSupport::None);
+    // ETC1 data is bitstream-compatible with ETC2 RGB8; desktop GL only
+    // accepts it under the ETC2 token.
+    const GLenum internalFormat = etcTextureSupport() == ETCTextureSupport::ETC2
+                                      ? GL_COMPRESSED_RGB8_ETC2
+                                      : GL_ETC1_RGB8_OES;
+    auto obj = createTexture();
+    const TextureID id = obj;
+    activeTexture = unit;
+    if (texture[unit] != id) {
+        ++stats.textureBinds;
+    }
+    texture[unit] = id;
+    const void* blocks = data;
+#if not MBGL_USE_GLES2
+    const bool staged = stageTextureUpload(data, byteSize);
+    if (staged) {
+        blocks = nullptr;
+    }
+#endif // MBGL_USE_GLES2
+    MBGL_CHECK_ERROR(glCompressedTexImage2D(GL_TEXTURE_2D, 0, internalFormat, size.width,
+                                            size.height, 0, static_cast<GLsizei>(byteSize),
+                                            blocks));
+#if not MBGL_USE_GLES2
+    if (staged) {
+        pixelUnpackBuffer = value::BindPixelUnpackBuffer::Default;
+    }
+#endif // MBGL_USE_GLES2
+    ++stats.textureUploads;
+    MBGL_CHECK_ERROR(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE));
+    MBGL_CHECK_ERROR(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE));
+    MBGL_CHECK_ERROR(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST));
+    MBGL_CHECK_ERROR(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST));
+    return { size, std::move(obj) };
+}
+
+#if not MBGL_USE_GLES2
+bool Context::stageTextureUpload(const void* data, const std::size_t byteSize) {
+    if (!data || byteSize == 0) {
+        return false;
+    }
+    currentPixelUploadBuffer = (currentPixelUploadBuffer + 1) % pixelUploadBuffers.size();
+    auto& buffer = pixelUploadBuffers[currentPixelUploadBuffer];
+    if (!buffer) {
+        BufferID id = 0;
+        MBGL_CHECK_ERROR(glGenBuffers(1, &id));
+        buffer = UniqueBuffer { std::move(id), { this } };
+    }
+    pixelUnpackBuffer = *buffer;
+    MBGL_CHECK_ERROR(glBufferData(GL_PIXEL_UNPACK_BUFFER, byteSize, data, GL_STREAM_DRAW));
+    return true;
+}
+#endif // MBGL_USE_GLES2
+
 void Context::updateTexture(
     TextureID id, const Size size, const void* data, TextureFormat format, TextureUnit unit) {
     activeTexture = unit;
+    if (texture[unit] != id) {
+        ++stats.textureBinds;
+    }
     texture[unit] = id;
+    const void* pixels = data;
+#if not MBGL_USE_GLES2
+    const std::size_t byteSize =
+        std::size_t(size.width) * size.height * (format == TextureFormat::RGBA ? 4 : 1);
+    const bool staged = stageTextureUpload(data, byteSize);
+    if (staged) {
+        pixels = nullptr;
+    }
+#endif // MBGL_USE_GLES2
     MBGL_CHECK_ERROR(glTexImage2D(GL_TEXTURE_2D, 0, static_cast<GLenum>(format), size.width,
                                   size.height, 0, static_cast<GLenum>(format), GL_UNSIGNED_BYTE,
-                                  data));
+                                  pixels));
+#if not MBGL_USE_GLES2
+    if (staged) {
+        pixelUnpackBuffer = value::BindPixelUnpackBuffer::Default;
+    }
+#endif // MBGL_USE_GLES2
+    ++stats.textureUploads;
+}
+
+void Context::updateTextureBand(TextureID id,
+                                const Size size,
+                                const uint32_t yOffset,
+                                const uint32_t rows,
+                                const void* data,
+                                TextureFormat format,
+                                TextureUnit unit) {
+    activeTexture = unit;
+    if (texture[unit] != id) {
+        ++stats.textureBinds;
+    }
+    texture[unit] = id;
+    const void* pixels = data;
+#if not MBGL_USE_GLES2
+    const std::size_t byteSize =
+        std::size_t(size.width) * rows * (format == TextureFormat::RGBA ? 4 : 1);
+    const bool staged = stageTextureUpload(data, byteSize);
+    if (staged) {
+        pixels = nullptr;
+    }
+#endif // MBGL_USE_GLES2
+    MBGL_CHECK_ERROR(glTexSubImage2D(GL_TEXTURE_2D, 0, 0, yOffset, size.width, rows,
+                                     static_cast<GLenum>(format), GL_UNSIGNED_BYTE, pixels));
+#if not MBGL_USE_GLES2
+    if (staged) {
+        pixelUnpackBuffer = value::BindPixelUnpackBuffer::Default;
+    }
+#endif // MBGL_USE_GLES2
+    ++stats.textureUploads;
+}
+
+void Context::generateMipmap(Texture& obj, TextureUnit unit) {
+    activeTexture = unit;
+    if (texture[unit] != obj.texture) {
+        ++stats.textureBinds;
+    }
+    texture[unit] = obj.texture;
+    MBGL_CHECK_ERROR(glGenerateMipmap(GL_TEXTURE_2D));
 }
 
 void Context::bindTexture(Texture& obj,
@@ -310,6 +611,9 @@ void Context::bindTexture(Texture& obj,
                           TextureWrap wrapY) {
     if (filter != obj.filter || mipmap != obj.mipmap || wrapX != obj.wrapX || wrapY != obj.wrapY) {
         activeTexture = unit;
+        if (texture[unit] != obj.texture) {
+            ++stats.textureBinds;
+        }
         texture[unit] = obj.texture;
 
         if (filter != obj.filter || mipmap != obj.mipmap) {
@@ -342,52 +646,172 @@ void Context::bindTexture(Texture& obj,
         // texture bind.
         activeTexture = unit;
         texture[unit] = obj.texture;
+        ++stats.textureBinds;
     }
 }
 
 void Context::reset() {
+    performLowMemoryCleanup();
+}
+
+void Context::performLowMemoryCleanup() {
     std::copy(pooledTextures.begin(), pooledTextures.end(), std::back_inserter(abandonedTextures));
     pooledTextures.resize(0);
-    performCleanup();
+    std::copy(pooledBuffers.begin(), pooledBuffers.end(), std::back_inserter(abandonedBuffers));
+    pooledBuffers.resize(0);
+#if not MBGL_USE_GLES2
+    // The staging buffers are recreated on demand by the next texture upload.
+    for (auto& buffer : pixelUploadBuffers) {
+        buffer = {};
+    }
+#endif // MBGL_USE_GLES2
+    // Unlike the per-frame tier, drain everything at once: memory pressure
+    // (or imminent destruction) outranks frame pacing.
+    performCleanup(std::numeric_limits<std::size_t>::max());
 }
 
 void Context::setDirtyState() {
+    setDirtyState(StateGroup::All);
+}
+
+void Context::setDirtyState(StateGroup groups) {
     // Note: does not set viewport/bindFramebuffer to dirty since they are handled separately in
     // the view object.
-    stencilFunc.setDirty();
-    stencilMask.setDirty();
-    stencilTest.setDirty();
-    stencilOp.setDirty();
-    depthRange.setDirty();
-    depthMask.setDirty();
-    depthTest.setDirty();
-    depthFunc.setDirty();
-    blend.setDirty();
-    blendEquation.setDirty();
-    blendFunc.setDirty();
-    blendColor.setDirty();
-    colorMask.setDirty();
-    clearDepth.setDirty();
-    clearColor.setDirty();
-    clearStencil.setDirty();
-    program.setDirty();
-    lineWidth.setDirty();
-    activeTexture.setDirty();
+    if (groups & StateGroup::Stencil) {
+        stencilFunc.setDirty();
+        stencilMask.setDirty();
+        stencilTest.setDirty();
+        stencilOp.setDirty();
+    }
+    if (groups & StateGroup::Depth) {
+        depthRange.setDirty();
+        depthMask.setDirty();
+        depthTest.setDirty();
+        depthFunc.setDirty();
+    }
+    if (groups & StateGroup::Blend) {
+        blend.setDirty();
+        blendEquation.setDirty();
+        blendFunc.setDirty();
+        blendColor.setDirty();
+        colorMask.setDirty();
+    }
+    if (groups & StateGroup::Clear) {
+        clearDepth.setDirty();
+        clearColor.setDirty();
+        clearStencil.setDirty();
+    }
+    if (groups & StateGroup::Program) {
+        program.setDirty();
+    }
+    if (groups & StateGroup::Textures) {
+        activeTexture.setDirty();
+        for (auto& tex : texture) {
+            tex.setDirty();
+        }
+    }
+    if (groups & StateGroup::Buffers) {
+        vertexBuffer.setDirty();
+        elementBuffer.setDirty();
+        vertexArrayObject.setDirty();
+        for (auto& value : constantAttributeValues) {
+            value = {};
+        }
+    }
+    if (groups & StateGroup::Other) {
+        lineWidth.setDirty();
+        bindRenderbuffer.setDirty();
 #if not MBGL_USE_GLES2
-    pointSize.setDirty();
-    pixelZoom.setDirty();
-    rasterPos.setDirty();
-    pixelStorePack.setDirty();
-    pixelStoreUnpack.setDirty();
-    pixelTransferDepth.setDirty();
-    pixelTransferStencil.setDirty();
+        pointSize.setDirty();
+        pixelUnpackBuffer.setDirty();
+        pixelPackBuffer.setDirty();
+        pixelZoom.setDirty();
+        rasterPos.setDirty();
+        pixelStorePack.setDirty();
+        pixelStoreUnpack.setDirty();
+        pixelTransferDepth.setDirty();
+        pixelTransferStencil.setDirty();
 #endif // MBGL_USE_GLES2
-    for (auto& tex : texture) {
-       tex.setDirty();
     }
-    vertexBuffer.setDirty();
-    elementBuffer.setDirty();
-    vertexArrayObject.setDirty();
+}
+
+namespace {
+
+// Audits one cached value: drains its filtered-call counter, and when the
+// cache claims to know the current value, cross-checks it against the live
+// GL state.
+template <typename T>
+bool auditValue(State<T>& state, const char* name, uint32_t& filtered, uint32_t& verified) {
+    filtered += state.getFilteredCalls();
+    state.resetFilteredCalls();
+    if (state.isDirty()) {
+        return true;
+    }
+    ++verified;
+    if (state.getCurrentValue() != T::Get()) {
+        Log::Error(Event::OpenGL, "GL state cache mismatch: %s", name);
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
+bool Context::auditStateCache() {
+    uint32_t filtered = 0;
+    uint32_t verified = 0;
+    bool clean = true;
+
+#define MBGL_AUDIT_STATE(name) clean = auditValue(name, #name, filtered, verified) && clean
+    MBGL_AUDIT_STATE(stencilFunc);
+    MBGL_AUDIT_STATE(stencilMask);
+    MBGL_AUDIT_STATE(stencilTest);
+    MBGL_AUDIT_STATE(stencilOp);
+    MBGL_AUDIT_STATE(depthRange);
+    MBGL_AUDIT_STATE(depthMask);
+    MBGL_AUDIT_STATE(depthTest);
+    MBGL_AUDIT_STATE(depthFunc);
+    MBGL_AUDIT_STATE(blend);
+    MBGL_AUDIT_STATE(blendEquation);
+    MBGL_AUDIT_STATE(blendFunc);
+    MBGL_AUDIT_STATE(blendColor);
+    MBGL_AUDIT_STATE(colorMask);
+    MBGL_AUDIT_STATE(clearDepth);
+    MBGL_AUDIT_STATE(clearColor);
+    MBGL_AUDIT_STATE(clearStencil);
+    MBGL_AUDIT_STATE(program);
+    MBGL_AUDIT_STATE(lineWidth);
+    MBGL_AUDIT_STATE(viewport);
+    MBGL_AUDIT_STATE(bindFramebuffer);
+    MBGL_AUDIT_STATE(bindRenderbuffer);
+    MBGL_AUDIT_STATE(vertexBuffer);
+    MBGL_AUDIT_STATE(elementBuffer);
+    MBGL_AUDIT_STATE(vertexArrayObject);
+#if not MBGL_USE_GLES2
+    MBGL_AUDIT_STATE(pointSize);
+    MBGL_AUDIT_STATE(pixelUnpackBuffer);
+    MBGL_AUDIT_STATE(pixelPackBuffer);
+    MBGL_AUDIT_STATE(pixelZoom);
+    MBGL_AUDIT_STATE(rasterPos);
+    MBGL_AUDIT_STATE(pixelStorePack);
+    MBGL_AUDIT_STATE(pixelStoreUnpack);
+    MBGL_AUDIT_STATE(pixelTransferDepth);
+    MBGL_AUDIT_STATE(pixelTransferStencil);
+#endif // MBGL_USE_GLES2
+
+    // GL only exposes the texture binding of the active unit, so walk the
+    // units through the cached activeTexture state and audit it last, once
+    // its cached value is known to match.
+    for (TextureUnit unit = 0; unit < texture.size(); ++unit) {
+        activeTexture = unit;
+        clean = auditValue(texture[unit], "texture", filtered, verified) && clean;
+    }
+    MBGL_AUDIT_STATE(activeTexture);
+#undef MBGL_AUDIT_STATE
+
+    Log::Info(Event::OpenGL, "GL state audit: %u cached values verified, %u redundant state calls filtered",
+              verified, filtered);
+    return clean;
 }
 
 void Context::clear(optional<mbgl::Color> color,
@@ -486,70 +910,106 @@ void Context::draw(PrimitiveType primitiveType,
         static_cast<GLsizei>(indexLength),
         GL_UNSIGNED_SHORT,
         reinterpret_cast<GLvoid*>(sizeof(uint16_t) * indexOffset)));
+    ++stats.drawCalls;
 }
 
+namespace {
+
+// Objects deleted per performCleanup() call. A mass tile eviction after a
+// deep zoom-out abandons hundreds of objects at once; deleting them all at
+// frame end causes a driver spike, while the objects themselves are in no
+// hurry to go. Sized so a typical eviction drains within a handful of frames.
+constexpr std::size_t cleanupBudgetPerFrame = 64;
+
+} // namespace
+
 void Context::performCleanup() {
-    for (auto id : abandonedPrograms) {
+    performCleanup(cleanupBudgetPerFrame);
+}
+
+void Context::performCleanup(std::size_t budget) {
+    while (!abandonedPrograms.empty() && budget > 0) {
+        const auto id = abandonedPrograms.back();
+        abandonedPrograms.pop_back();
         if (program == id) {
             program.setDirty();
         }
         MBGL_CHECK_ERROR(glDeleteProgram(id));
+        budget--;
     }
-    abandonedPrograms.clear();
 
-    for (auto id : abandonedShaders) {
-        MBGL_CHECK_ERROR(glDeleteShader(id));
+    while (!abandonedShaders.empty() && budget > 0) {
+        MBGL_CHECK_ERROR(glDeleteShader(abandonedShaders.back()));
+        abandonedShaders.pop_back();
+        budget--;
     }
-    abandonedShaders.clear();
 
-    if (!abandonedBuffers.empty()) {
-        for (const auto id : abandonedBuffers) {
-            if (vertexBuffer == id) {
+    if (!abandonedBuffers.empty() && budget > 0) {
+        const std::size_t count = std::min(budget, abandonedBuffers.size());
+        const auto first = abandonedBuffers.end() - count;
+        for (auto it = first; it != abandonedBuffers.end(); ++it) {
+            if (vertexBuffer == *it) {
                 vertexBuffer.setDirty();
-            } else if (elementBuffer == id) {
+            } else if (elementBuffer == *it) {
                 elementBuffer.setDirty();
             }
+            // Pooled-but-never-filled IDs have no size entry; only buffers
+            // that went through glBufferData are on the ledger.
+            auto sizeEntry = bufferSizes.find(*it);
+            if (sizeEntry != bufferSizes.end()) {
+                BufferBudget::Freed(sizeEntry->second);
+                bufferSizes.erase(sizeEntry);
+            }
         }
-        MBGL_CHECK_ERROR(glDeleteBuffers(int(abandonedBuffers.size()), abandonedBuffers.data()));
-        abandonedBuffers.clear();
+        MBGL_CHECK_ERROR(glDeleteBuffers(int(count), &*first));
+        abandonedBuffers.erase(first, abandonedBuffers.end());
+        budget -= count;
     }
 
-    if (!abandonedTextures.empty()) {
-        for (const auto id : abandonedTextures) {
-            if (activeTexture == id) {
+    if (!abandonedTextures.empty() && budget > 0) {
+        const std::size_t count = std::min(budget, abandonedTextures.size());
+        const auto first = abandonedTextures.end() - count;
+        for (auto it = first; it != abandonedTextures.end(); ++it) {
+            if (activeTexture == *it) {
                 activeTexture.setDirty();
             }
         }
-        MBGL_CHECK_ERROR(glDeleteTextures(int(abandonedTextures.size()), abandonedTextures.data()));
-        abandonedTextures.clear();
+        MBGL_CHECK_ERROR(glDeleteTextures(int(count), &*first));
+        abandonedTextures.erase(first, abandonedTextures.end());
+        budget -= count;
     }
 
-    if (!abandonedVertexArrays.empty()) {
-        for (const auto id : abandonedVertexArrays) {
-            if (vertexArrayObject == id) {
+    if (!abandonedVertexArrays.empty() && budget > 0) {
+        const std::size_t count = std::min(budget, abandonedVertexArrays.size());
+        const auto first = abandonedVertexArrays.end() - count;
+        for (auto it = first; it != abandonedVertexArrays.end(); ++it) {
+            if (vertexArrayObject == *it) {
                 vertexArrayObject.setDirty();
             }
         }
-        MBGL_CHECK_ERROR(gl::DeleteVertexArrays(int(abandonedVertexArrays.size()),
-                                                abandonedVertexArrays.data()));
-        abandonedVertexArrays.clear();
+        MBGL_CHECK_ERROR(gl::DeleteVertexArrays(int(count), &*first));
+        abandonedVertexArrays.erase(first, abandonedVertexArrays.end());
+        budget -= count;
     }
 
-    if (!abandonedFramebuffers.empty()) {
-        for (const auto id : abandonedFramebuffers) {
-            if (bindFramebuffer == id) {
+    if (!abandonedFramebuffers.empty() && budget > 0) {
+        const std::size_t count = std::min(budget, abandonedFramebuffers.size());
+        const auto first = abandonedFramebuffers.end() - count;
+        for (auto it = first; it != abandonedFramebuffers.end(); ++it) {
+            if (bindFramebuffer == *it) {
                 bindFramebuffer.setDirty();
             }
         }
-        MBGL_CHECK_ERROR(
-            glDeleteFramebuffers(int(abandonedFramebuffers.size()), abandonedFramebuffers.data()));
-        abandonedFramebuffers.clear();
+        MBGL_CHECK_ERROR(glDeleteFramebuffers(int(count), &*first));
+        abandonedFramebuffers.erase(first, abandonedFramebuffers.end());
+        budget -= count;
     }
 
-    if (!abandonedRenderbuffers.empty()) {
-        MBGL_CHECK_ERROR(glDeleteRenderbuffers(int(abandonedRenderbuffers.size()),
-                                               abandonedRenderbuffers.data()));
-        abandonedRenderbuffers.clear();
+    if (!abandonedRenderbuffers.empty() && budget > 0) {
+        const std::size_t count = std::min(budget, abandonedRenderbuffers.size());
+        const auto first = abandonedRenderbuffers.end() - count;
+        MBGL_CHECK_ERROR(glDeleteRenderbuffers(int(count), &*first));
+        abandonedRenderbuffers.erase(first, abandonedRenderbuffers.end());
     }
 }
 
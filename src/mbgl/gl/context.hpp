@@ -14,10 +14,15 @@
 #include <mbgl/gl/stencil_mode.hpp>
 #include <mbgl/gl/color_mode.hpp>
 #include <mbgl/util/noncopyable.hpp>
+#include <mbgl/util/optional.hpp>
+#include <mbgl/util/traits.hpp>
 
 
+#include <array>
+#include <cassert>
 #include <functional>
 #include <memory>
+#include <utility>
 #include <vector>
 #include <array>
 #include <string>
@@ -31,6 +36,14 @@ namespace gl {
 
 constexpr size_t TextureMax = 64;
 
+// Number of buffer names generated at a time and the cap on the recycling
+// pool; a name without storage costs nothing, so this matches TextureMax.
+constexpr size_t BufferMax = 64;
+
+// OpenGL ES 2.0 guarantees no more than 8 vertex attribute locations; the
+// shaders stay within that minimum, so it also bounds per-location caches.
+constexpr size_t AttributeMax = 8;
+
 class Context : private util::noncopyable {
 public:
     ~Context();
@@ -41,6 +54,17 @@ public:
     UniqueTexture createTexture();
     UniqueVertexArray createVertexArray();
 
+    // Program binary support (GL_ARB_get_program_binary / GL_OES_get_program_binary).
+    // When unsupported, getBinaryProgram returns nullopt and createProgram from
+    // a binary must not be called.
+    bool supportsProgramBinaries() const;
+    optional<std::pair<BinaryProgramFormat, std::string>> getBinaryProgram(ProgramID) const;
+    UniqueProgram createProgram(BinaryProgramFormat binaryFormat, const std::string& binaryProgram);
+
+    // GL_VERSION and GL_RENDERER, for keying driver-specific artifacts such as
+    // cached program binaries. Queried lazily; requires a current context.
+    const std::string& driverIdentity();
+
     template <class Vertex, class DrawMode>
     VertexBuffer<Vertex, DrawMode> createVertexBuffer(VertexVector<Vertex, DrawMode>&& v) {
         return VertexBuffer<Vertex, DrawMode> {
@@ -80,6 +104,26 @@ public:
     }
 
 #if not MBGL_USE_GLES2
+    // Queues an asynchronous read of the current framebuffer into a
+    // round-robin pixel pack buffer and returns as soon as the transfer is
+    // submitted, without waiting for the GPU. Pair each call with
+    // endFramebufferRead(), ideally with other work — e.g. rendering the next
+    // capture — in between, so continuous snapshotting overlaps the GPU copy
+    // of one frame with the drawing of the next instead of stalling per
+    // capture.
+    void beginFramebufferRead(Size, TextureFormat = TextureFormat::RGBA);
+
+    // Completes the oldest outstanding beginFramebufferRead() with the same
+    // size and format, blocking only if that transfer hasn't finished yet.
+    template <typename Image,
+              TextureFormat format = Image::channels == 4 ? TextureFormat::RGBA
+                                                          : TextureFormat::Alpha>
+    Image endFramebufferRead(const Size size, bool flip = true) {
+        static_assert(Image::channels == (format == TextureFormat::RGBA ? 4 : 1),
+                      "image format mismatch");
+        return { size, endFramebufferRead(size, format, flip) };
+    }
+
     template <typename Image>
     void drawPixels(const Image& image) {
         auto format = image.channels == 4 ? TextureFormat::RGBA : TextureFormat::Alpha;
@@ -101,6 +145,23 @@ public:
         obj.size = image.size;
     }
 
+    // Re-uploads a horizontal band of rows of an image into an existing
+    // texture of the same size. The band always spans the texture's full
+    // width: rows are only contiguous in client memory at full width, and
+    // ES2 has no GL_UNPACK_ROW_LENGTH to describe anything narrower.
+    template <typename Image>
+    void updateTextureBand(Texture& obj,
+                           const Image& image,
+                           const uint32_t yOffset,
+                           const uint32_t rows,
+                           TextureUnit unit = 0) {
+        assert(obj.size == image.size);
+        assert(yOffset + rows <= image.size.height);
+        auto format = image.channels == 4 ? TextureFormat::RGBA : TextureFormat::Alpha;
+        updateTextureBand(obj.texture.get(), image.size, yOffset, rows,
+                          image.data.get() + yOffset * image.stride(), format, unit);
+    }
+
     // Creates an empty texture with the specified dimensions.
     Texture createTexture(const Size size,
                           TextureFormat format = TextureFormat::RGBA,
@@ -108,6 +169,19 @@ public:
         return { size, createTexture(size, nullptr, format, unit) };
     }
 
+    // Creates a two-channel luminance+alpha texture from tightly packed
+    // 16-bit big-endian samples, as produced by worker-side raster decode
+    // stages (terrain heights, for example); the shader reads the high byte
+    // from any of r/g/b and the low byte from a.
+    Texture createLuminanceAlphaTexture(const Size size, const uint8_t* data, TextureUnit unit = 0) {
+        return { size, createTexture(size, data, TextureFormat::LuminanceAlpha, unit) };
+    }
+
+    // Creates a texture from an ETC-compressed payload (see util::compressETC1),
+    // choosing the internal format the context advertises. Must only be called
+    // when etcTextureSupport() is not None.
+    Texture createCompressedTexture(Size, const void* data, std::size_t byteSize, TextureUnit = 0);
+
     void bindTexture(Texture&,
                      TextureUnit = 0,
                      TextureFilter = TextureFilter::Nearest,
@@ -115,6 +189,11 @@ public:
                      TextureWrap wrapX = TextureWrap::Clamp,
                      TextureWrap wrapY = TextureWrap::Clamp);
 
+    // (Re)builds the texture's mipmap chain from its base level, for textures
+    // that are later bound with TextureMipMap::Yes. The texture's dimensions
+    // must be powers of two (an ES2 requirement).
+    void generateMipmap(Texture&, TextureUnit = 0);
+
     void clear(optional<mbgl::Color> color,
                optional<float> depth,
                optional<int32_t> stencil);
@@ -134,15 +213,26 @@ public:
               std::size_t indexLength);
 
     // Actually remove the objects we marked as abandoned with the above methods.
+    // Deletes at most a fixed budget of objects per call, so that a mass tile
+    // eviction doesn't turn into a burst of hundreds of glDelete calls in one
+    // frame; the remainder is carried over to subsequent calls.
     // Only call this while the OpenGL context is exclusive to this thread.
     void performCleanup();
 
+    // Memory pressure tier of performCleanup: additionally returns pooled
+    // texture IDs to the driver. Recycled textures keep their storage alive
+    // while pooled, so draining the pool lets a backgrounded map give that
+    // VRAM back instead of hoarding it for reuse.
+    // Only call this while the OpenGL context is exclusive to this thread.
+    void performLowMemoryCleanup();
+
     // Drain pools and remove abandoned objects, in preparation for destroying the store.
     // Only call this while the OpenGL context is exclusive to this thread.
     void reset();
 
     bool empty() const {
         return pooledTextures.empty()
+            && pooledBuffers.empty()
             && abandonedPrograms.empty()
             && abandonedShaders.empty()
             && abandonedBuffers.empty()
@@ -153,6 +243,48 @@ public:
 
     void setDirtyState();
 
+    // Groups of cached GL state, for partial invalidation when external code
+    // (a custom layer) declares which state it modified behind the cache's
+    // back. Viewport and framebuffer binding are handled separately by the
+    // view object, as in setDirtyState().
+    enum class StateGroup : uint32_t {
+        None     = 0,
+        Stencil  = 1 << 0,
+        Depth    = 1 << 1,
+        Blend    = 1 << 2, // includes the color mask
+        Clear    = 1 << 3, // clear color/depth/stencil values
+        Program  = 1 << 4,
+        Buffers  = 1 << 5, // buffer bindings, VAOs, constant vertex attributes
+        Textures = 1 << 6,
+        Other    = 1 << 7, // line width, renderbuffer, pixel store/transfer
+        All      = ~0u,
+    };
+
+    // Marks only the given groups of cached state dirty; their GL calls are
+    // re-issued lazily on next use while every other group stays valid.
+    void setDirtyState(StateGroup);
+
+    // Debug audit of the state cache: cross-checks every cached value that
+    // isn't marked dirty against the live GL state, logging any mismatch, and
+    // reports how many redundant state calls the cache filtered since the
+    // last audit. Returns false if a mismatch was found. Expensive (one
+    // glGet* round trip per value); only run it under an explicit debug mode.
+    bool auditStateCache();
+
+    // Counters for frame instrumentation. They count GL calls actually issued,
+    // i.e. after redundant-state elision, and are reset by the renderer at the
+    // start of each frame.
+    struct Stats {
+        uint32_t drawCalls = 0;
+        uint32_t bufferUploads = 0;
+        uint32_t textureBinds = 0;
+        uint32_t textureUploads = 0;
+
+        void reset() {
+            *this = Stats();
+        }
+    } stats;
+
     State<value::ActiveTexture> activeTexture;
     State<value::BindFramebuffer> bindFramebuffer;
     State<value::Viewport> viewport;
@@ -162,7 +294,15 @@ public:
     State<value::BindVertexBuffer> vertexBuffer;
     State<value::BindElementBuffer> elementBuffer;
 
+    // Generic (constant) vertex attribute values are context-global state, not
+    // part of VAO state, so the last value set for each location is tracked
+    // here and re-setting an unchanged value is skipped. nullopt means the
+    // current value is unknown.
+    std::array<optional<std::array<float, 4>>, AttributeMax> constantAttributeValues;
+
 #if not MBGL_USE_GLES2
+    State<value::BindPixelUnpackBuffer> pixelUnpackBuffer;
+    State<value::BindPixelPackBuffer> pixelPackBuffer;
     State<value::PixelZoom> pixelZoom;
     State<value::RasterPos> rasterPos;
     State<value::PixelStorePack> pixelStorePack;
@@ -194,15 +334,44 @@ private:
     State<value::PointSize> pointSize;
 #endif // MBGL_USE_GLES2
 
+    UniqueBuffer createBuffer();
     UniqueBuffer createVertexBuffer(const void* data, std::size_t size);
     UniqueBuffer createIndexBuffer(const void* data, std::size_t size);
     UniqueTexture createTexture(Size size, const void* data, TextureFormat, TextureUnit);
     void updateTexture(TextureID, Size size, const void* data, TextureFormat, TextureUnit);
+    void updateTextureBand(TextureID, Size size, uint32_t yOffset, uint32_t rows,
+                           const void* data, TextureFormat, TextureUnit);
     UniqueFramebuffer createFramebuffer();
     UniqueRenderbuffer createRenderbuffer(RenderbufferType, Size size);
     std::unique_ptr<uint8_t[]> readFramebuffer(Size, TextureFormat, bool flip);
 #if not MBGL_USE_GLES2
+    std::unique_ptr<uint8_t[]> endFramebufferRead(Size, TextureFormat, bool flip);
     void drawPixels(Size size, const void* data, TextureFormat);
+
+    // Copies the pixels into one of two round-robin pixel unpack buffers and
+    // leaves that buffer bound, so that the following glTexImage2D or
+    // glTexSubImage2D call sources from it and the driver can transfer the
+    // data asynchronously instead of stalling on a synchronous client-memory
+    // copy. The storage is re-specified (orphaned) on every staging, which
+    // keeps consecutive uploads independent without fence objects. Returns
+    // false when there is nothing to stage; callers unbind via
+    // pixelUnpackBuffer after the texture call.
+    bool stageTextureUpload(const void* data, std::size_t byteSize);
+
+    std::array<optional<UniqueBuffer>, 2> pixelUploadBuffers;
+    std::size_t currentPixelUploadBuffer = 0;
+
+    // Round-robin pixel pack buffers for asynchronous framebuffer reads.
+    // begin advances the write cursor, end the read cursor, so two captures
+    // can be in flight at once.
+    struct PixelReadBuffer {
+        optional<UniqueBuffer> buffer;
+        std::size_t byteSize = 0;
+        bool pending = false;
+    };
+    std::array<PixelReadBuffer, 2> pixelReadBuffers;
+    std::size_t pixelReadWriteCursor = 0;
+    std::size_t pixelReadReadCursor = 0;
 #endif // MBGL_USE_GLES2
 
     friend detail::ProgramDeleter;
@@ -213,7 +382,20 @@ private:
     friend detail::FramebufferDeleter;
     friend detail::RenderbufferDeleter;
 
+    void verifyProgramLinkage(ProgramID);
+
+    // Deletes at most `budget` abandoned objects; performCleanup() passes a
+    // per-frame budget, reset() and the low-memory tier drain everything.
+    void performCleanup(std::size_t budget);
+
     std::vector<TextureID> pooledTextures;
+    std::vector<BufferID> pooledBuffers;
+
+    // Bytes of buffer storage per live buffer, kept so the process-wide
+    // BufferBudget ledger can be credited when the buffer is finally deleted.
+    std::unordered_map<BufferID, std::size_t> bufferSizes;
+
+    std::string cachedDriverIdentity;
 
     std::vector<ProgramID> abandonedPrograms;
     std::vector<ShaderID> abandonedShaders;
@@ -224,5 +406,17 @@ private:
     std::vector<RenderbufferID> abandonedRenderbuffers;
 };
 
+constexpr Context::StateGroup operator|(Context::StateGroup lhs, Context::StateGroup rhs) {
+    return Context::StateGroup(underlying_type(lhs) | underlying_type(rhs));
+}
+
+constexpr Context::StateGroup& operator|=(Context::StateGroup& lhs, Context::StateGroup rhs) {
+    return (lhs = lhs | rhs);
+}
+
+constexpr bool operator&(Context::StateGroup lhs, Context::StateGroup rhs) {
+    return underlying_type(lhs) & underlying_type(rhs);
+}
+
 } // namespace gl
 } // namespace mbgl
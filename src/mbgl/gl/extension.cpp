@@ -1,6 +1,7 @@
 #include <mbgl/gl/extension.hpp>
 #include <mbgl/gl/gl.hpp>
 
+#include <atomic>
 #include <mutex>
 #include <string>
 #include <vector>
@@ -25,10 +26,13 @@ ExtensionFunctionBase::ExtensionFunctionBase(std::initializer_list<Probe> probes
 
 static std::once_flag initializeExtensionsOnce;
 
+static std::atomic<ETCTextureSupport> etcSupport { ETCTextureSupport::None };
+
 void InitializeExtensions(glProc (*getProcAddress)(const char*)) {
     std::call_once(initializeExtensionsOnce, [getProcAddress] {
-        if (const char* extensions =
-                reinterpret_cast<const char*>(MBGL_CHECK_ERROR(glGetString(GL_EXTENSIONS)))) {
+        const char* extensions =
+            reinterpret_cast<const char*>(MBGL_CHECK_ERROR(glGetString(GL_EXTENSIONS)));
+        if (extensions) {
             for (auto fn : detail::extensionFunctions()) {
                 for (auto probe : fn.second) {
                     if (strstr(extensions, probe.first) != nullptr) {
@@ -38,8 +42,26 @@ void InitializeExtensions(glProc (*getProcAddress)(const char*)) {
                 }
             }
         }
+
+        // Publish compressed-texture capability for tile workers. ETC2 is
+        // core in OpenGL ES 3.0 and isn't necessarily listed in the extension
+        // string there, so the version string is consulted as well.
+        const char* version =
+            reinterpret_cast<const char*>(MBGL_CHECK_ERROR(glGetString(GL_VERSION)));
+        if (version && strncmp(version, "OpenGL ES 3", 11) == 0) {
+            etcSupport.store(ETCTextureSupport::ETC2, std::memory_order_release);
+        } else if (extensions && strstr(extensions, "GL_ARB_ES3_compatibility") != nullptr) {
+            etcSupport.store(ETCTextureSupport::ETC2, std::memory_order_release);
+        } else if (extensions &&
+                   strstr(extensions, "GL_OES_compressed_ETC1_RGB8_texture") != nullptr) {
+            etcSupport.store(ETCTextureSupport::ETC1, std::memory_order_release);
+        }
     });
 }
 
+ETCTextureSupport etcTextureSupport() {
+    return etcSupport.load(std::memory_order_acquire);
+}
+
 } // namespace gl
 } // namespace mbgl
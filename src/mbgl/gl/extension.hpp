@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <initializer_list>
 #include <utility>
 
@@ -9,6 +10,18 @@ namespace gl {
 using glProc = void (*)();
 void InitializeExtensions(glProc (*getProcAddress)(const char*));
 
+// ETC compressed-texture support of the process' GL context, published by
+// InitializeExtensions and None until then. ETC1 bitstreams are valid ETC2
+// RGB8 payloads, so ETC2-capable contexts also take ETC1-encoded data. Safe
+// to read from any thread; tile workers consult it to decide whether raster
+// tiles should be transcoded before upload (see util::compressETC1).
+enum class ETCTextureSupport : uint8_t {
+    None,
+    ETC1, // GL_OES_compressed_ETC1_RGB8_texture
+    ETC2, // OpenGL ES 3.0, or desktop GL with GL_ARB_ES3_compatibility
+};
+ETCTextureSupport etcTextureSupport();
+
 namespace detail {
 
 class ExtensionFunctionBase {
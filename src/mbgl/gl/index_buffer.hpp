@@ -14,6 +14,15 @@ class IndexVector {
 public:
     static constexpr std::size_t groupSize = DrawMode::bufferGroupSize;
 
+    IndexVector() = default;
+
+    // Move-only, like VertexVector: staged index data must be handed off by
+    // moving, never copied.
+    IndexVector(const IndexVector&) = delete;
+    IndexVector& operator=(const IndexVector&) = delete;
+    IndexVector(IndexVector&&) = default;
+    IndexVector& operator=(IndexVector&&) = default;
+
     template <class... Args>
     void emplace_back(Args&&... args) {
         static_assert(sizeof...(args) == groupSize, "wrong buffer element count");
@@ -26,6 +35,10 @@ public:
     bool empty() const { return v.empty(); }
     const uint16_t* data() const { return v.data(); }
 
+    // Releases the growth slack left by geometric reallocation; called once
+    // the contents are final.
+    void shrinkToFit() { v.shrink_to_fit(); }
+
 private:
     std::vector<uint16_t> v;
 };
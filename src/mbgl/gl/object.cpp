@@ -19,7 +19,11 @@ void ShaderDeleter::operator()(ShaderID id) const {
 
 void BufferDeleter::operator()(BufferID id) const {
     assert(context);
-    context->abandonedBuffers.push_back(id);
+    if (context->pooledBuffers.size() >= BufferMax) {
+        context->abandonedBuffers.push_back(id);
+    } else {
+        context->pooledBuffers.push_back(id);
+    }
 }
 
 void TextureDeleter::operator()(TextureID id) const {
@@ -26,9 +26,22 @@ public:
     Program(Context& context, const std::string& vertexSource, const std::string& fragmentSource)
         : vertexShader(context.createShader(ShaderType::Vertex, vertexSource)),
           fragmentShader(context.createShader(ShaderType::Fragment, fragmentSource)),
-          program(context.createProgram(vertexShader, fragmentShader)),
-          attributeLocations(Attributes::locations(program)),
-          uniformsState((context.linkProgram(program), Uniforms::state(program))) {}
+          program(context.createProgram(*vertexShader, *fragmentShader)),
+          uniformsState((Attributes::bindLocations(program),
+                         context.linkProgram(program),
+                         Uniforms::state(program))) {}
+
+    // Reconstructs an already-linked program from a driver binary. Attribute
+    // locations are compile-time constants bound by index before linking in
+    // the compile path, so the binary restores identical bindings and nothing
+    // needs to be re-bound or queried here.
+    Program(Context& context, BinaryProgramFormat binaryFormat, const std::string& binaryProgram)
+        : program(context.createProgram(binaryFormat, binaryProgram)),
+          uniformsState(Uniforms::state(program)) {}
+
+    ProgramID identifier() const {
+        return program;
+    }
 
     template <class DrawMode>
     void draw(Context& context,
@@ -54,7 +67,6 @@ public:
         for (const auto& segment : segments) {
             segment.bind(context,
                          indexBuffer.buffer,
-                         attributeLocations,
                          attributeBindings);
 
             context.draw(drawMode.primitiveType,
@@ -64,11 +76,11 @@ public:
     }
 
 private:
-    UniqueShader vertexShader;
-    UniqueShader fragmentShader;
+    // Unset when the program was loaded from a binary.
+    optional<UniqueShader> vertexShader;
+    optional<UniqueShader> fragmentShader;
     UniqueProgram program;
 
-    typename Attributes::Locations attributeLocations;
     typename Uniforms::State uniformsState;
 };
 
@@ -30,7 +30,6 @@ public:
 
     void bind(Context& context,
               BufferID indexBuffer_,
-              const typename Attributes::Locations& attributeLocations,
               const typename Attributes::Bindings& attributeBindings_) const {
         if (!vao) {
             vao = context.createVertexArray();
@@ -46,7 +45,6 @@ public:
         }
 
         Attributes::bind(context,
-                         attributeLocations,
                          variableBindings,
                          attributeBindings_,
                          vertexOffset);
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstdint>
+
 namespace mbgl {
 namespace gl {
 
@@ -19,6 +21,10 @@ public:
         if (*this != value) {
             setCurrentValue(value);
             T::Set(currentValue);
+        } else {
+            // Counted rather than silently dropped so the state cache audit
+            // can report how much redundant work the cache absorbs.
+            ++filteredCalls;
         }
     }
 
@@ -49,9 +55,19 @@ public:
         return dirty;
     }
 
+    // Number of assignments elided because the value was already current.
+    uint32_t getFilteredCalls() const {
+        return filteredCalls;
+    }
+
+    void resetFilteredCalls() {
+        filteredCalls = 0;
+    }
+
 private:
     typename T::Type currentValue = T::Default;
     bool dirty = true;
+    uint32_t filteredCalls = 0;
 };
 
 // Helper struct that stores the current state and restores it upon destruction. You should not use
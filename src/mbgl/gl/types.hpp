@@ -18,6 +18,7 @@ using RenderbufferID = uint32_t;
 using AttributeLocation = int32_t;
 using UniformLocation = int32_t;
 using TextureUnit = uint8_t;
+using BinaryProgramFormat = uint32_t;
 
 enum class ShaderType : uint32_t {
     Vertex = 0x8B31,
@@ -45,6 +46,7 @@ enum class TextureWrap : bool { Clamp, Repeat };
 enum class TextureFormat : uint32_t {
     RGBA = 0x1908,
     Alpha = 0x1906,
+    LuminanceAlpha = 0x190A,
 #if not MBGL_USE_GLES2
     Stencil = 0x1901,
     Depth = 0x1902,
@@ -26,6 +26,11 @@ class Uniform {
 public:
     using Value = UniformValue<Tag, T>;
 
+    // Per-program uniform caching layer: uniforms are program object state in
+    // GL, so the last-bound value survives across draws and frames. Assigning
+    // an unchanged value is therefore a no-op and frame constants (projection
+    // matrix, viewport size, texture sizes, ...) are only ever uploaded when
+    // they actually change, no matter how many draws share them.
     class State {
     public:
         void operator=(const Value& value) {
@@ -352,6 +352,30 @@ BindVertexArray::Type BindVertexArray::Get() {
 
 #if not MBGL_USE_GLES2
 
+const constexpr BindPixelUnpackBuffer::Type BindPixelUnpackBuffer::Default;
+
+void BindPixelUnpackBuffer::Set(const Type& value) {
+    MBGL_CHECK_ERROR(glBindBuffer(GL_PIXEL_UNPACK_BUFFER, value));
+}
+
+BindPixelUnpackBuffer::Type BindPixelUnpackBuffer::Get() {
+    GLint binding;
+    MBGL_CHECK_ERROR(glGetIntegerv(GL_PIXEL_UNPACK_BUFFER_BINDING, &binding));
+    return binding;
+}
+
+const constexpr BindPixelPackBuffer::Type BindPixelPackBuffer::Default;
+
+void BindPixelPackBuffer::Set(const Type& value) {
+    MBGL_CHECK_ERROR(glBindBuffer(GL_PIXEL_PACK_BUFFER, value));
+}
+
+BindPixelPackBuffer::Type BindPixelPackBuffer::Get() {
+    GLint binding;
+    MBGL_CHECK_ERROR(glGetIntegerv(GL_PIXEL_PACK_BUFFER_BINDING, &binding));
+    return binding;
+}
+
 const constexpr PointSize::Type PointSize::Default;
 
 void PointSize::Set(const Type& value) {
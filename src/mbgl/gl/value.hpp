@@ -231,6 +231,20 @@ struct BindVertexArray {
 
 #if not MBGL_USE_GLES2
 
+struct BindPixelUnpackBuffer {
+    using Type = gl::BufferID;
+    static const constexpr Type Default = 0;
+    static void Set(const Type&);
+    static Type Get();
+};
+
+struct BindPixelPackBuffer {
+    using Type = gl::BufferID;
+    static const constexpr Type Default = 0;
+    static void Set(const Type&);
+    static Type Get();
+};
+
 struct PointSize {
     using Type = float;
     static const constexpr Type Default = 1;
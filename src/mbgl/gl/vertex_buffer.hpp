@@ -16,6 +16,16 @@ public:
     using Vertex = V;
     static constexpr std::size_t groupSize = DrawMode::bufferGroupSize;
 
+    VertexVector() = default;
+
+    // Staged vertex data is built in place on the worker and handed off by
+    // moving, all the way into createVertexBuffer(). Copying a staging
+    // vector is invariably a performance bug, so it doesn't compile.
+    VertexVector(const VertexVector&) = delete;
+    VertexVector& operator=(const VertexVector&) = delete;
+    VertexVector(VertexVector&&) = default;
+    VertexVector& operator=(VertexVector&&) = default;
+
     template <class... Args>
     void emplace_back(Args&&... args) {
         static_assert(sizeof...(args) == groupSize, "wrong buffer element count");
@@ -28,6 +38,10 @@ public:
     bool empty() const { return v.empty(); }
     const Vertex* data() const { return v.data(); }
 
+    // Releases the growth slack left by geometric reallocation; called once
+    // the contents are final.
+    void shrinkToFit() { v.shrink_to_fit(); }
+
 private:
     std::vector<Vertex> v;
 };
@@ -9,6 +9,19 @@ GeometryCollection clipLines(const GeometryCollection &lines,
         const int16_t x1, const int16_t y1, const int16_t x2, const int16_t y2) {
 
     GeometryCollection clippedLines;
+    clipLines(lines, x1, y1, x2, y2, clippedLines);
+    return clippedLines;
+}
+
+void clipLines(const GeometryCollection &lines,
+        const int16_t x1, const int16_t y1, const int16_t x2, const int16_t y2,
+        GeometryCollection &clippedLines) {
+
+    // Output lines are recycled by index: an existing line is cleared and
+    // refilled, which keeps its coordinate storage, and only the lines beyond
+    // what this input produces are released at the end.
+    size_t used = 0;
+    GeometryCoordinates* current = nullptr;
 
     for (auto& line : lines) {
 
@@ -52,16 +65,20 @@ GeometryCollection clipLines(const GeometryCollection &lines,
                 p1 = { static_cast<int16_t>(::round(p0.x + (p1.x - p0.x) * ((float)(y2 - p0.y) / (p1.y - p0.y)))), y2 };
             }
 
-            if (clippedLines.empty() || (!clippedLines.back().empty() && !(p0 == clippedLines.back().back()))) {
-                clippedLines.emplace_back();
-                clippedLines.back().push_back(p0);
+            if (!current || (!current->empty() && !(p0 == current->back()))) {
+                if (used == clippedLines.size()) {
+                    clippedLines.emplace_back();
+                }
+                current = &clippedLines[used++];
+                current->clear();
+                current->push_back(p0);
             }
 
-            clippedLines.back().push_back(p1);
+            current->push_back(p1);
         }
     }
 
-    return clippedLines;
+    clippedLines.resize(used);
 }
 
 } // end namespace util
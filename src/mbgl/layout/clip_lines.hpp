@@ -12,5 +12,12 @@ namespace util {
 GeometryCollection clipLines(const GeometryCollection &lines,
         const int16_t x1, const int16_t y1, const int16_t x2, const int16_t y2);
 
+// As above, but writes into a caller-owned buffer. Passing the same buffer
+// for every feature recycles both the outer vector and the per-line
+// coordinate storage instead of reallocating them per feature.
+void clipLines(const GeometryCollection &lines,
+        const int16_t x1, const int16_t y1, const int16_t x2, const int16_t y2,
+        GeometryCollection &clippedLines);
+
 } // end namespace util
 } // end namespace mbgl
@@ -3,13 +3,15 @@
 
 #include <boost/functional/hash.hpp>
 
+#include <algorithm>
+
 namespace mbgl {
 namespace util {
 
 // Map of key -> index into features
 using Index = std::unordered_map<size_t, size_t>;
 
-size_t mergeFromRight(std::vector<SymbolFeature>& features,
+static size_t mergeFromRight(std::vector<SymbolFeature>& features,
                       Index& rightIndex,
                       Index::iterator left,
                       size_t rightKey,
@@ -25,7 +27,7 @@ size_t mergeFromRight(std::vector<SymbolFeature>& features,
     return index;
 }
 
-size_t mergeFromLeft(std::vector<SymbolFeature>& features,
+static size_t mergeFromLeft(std::vector<SymbolFeature>& features,
                      Index& leftIndex,
                      Index::iterator right,
                      size_t leftKey,
@@ -42,8 +44,8 @@ size_t mergeFromLeft(std::vector<SymbolFeature>& features,
     return index;
 }
 
-size_t getKey(const std::u16string& text, const GeometryCoordinate& coord) {
-    auto hash = std::hash<std::u16string>()(text);
+static size_t getKey(size_t textId, const GeometryCoordinate& coord) {
+    size_t hash = textId;
     boost::hash_combine(hash, coord.x);
     boost::hash_combine(hash, coord.y);
     return hash;
@@ -53,6 +55,11 @@ void mergeLines(std::vector<SymbolFeature>& features) {
     Index leftIndex;
     Index rightIndex;
 
+    // Label texts are interned to a small id once per distinct string, so
+    // the endpoint keys below combine an integer and two coordinates instead
+    // of rehashing the whole label for every feature and endpoint.
+    std::unordered_map<std::u16string, size_t> textIds;
+
     for (size_t k = 0; k < features.size(); k++) {
         SymbolFeature& feature = features[k];
         GeometryCollection& geometry = feature.geometry;
@@ -61,11 +68,27 @@ void mergeLines(std::vector<SymbolFeature>& features) {
             continue;
         }
 
-        const size_t leftKey = getKey(*feature.text, geometry[0].front());
-        const size_t rightKey = getKey(*feature.text, geometry[0].back());
-
-        const auto left = rightIndex.find(leftKey);
-        const auto right = leftIndex.find(rightKey);
+        const size_t textId = textIds.emplace(*feature.text, textIds.size()).first->second;
+
+        size_t leftKey = getKey(textId, geometry[0].front());
+        size_t rightKey = getKey(textId, geometry[0].back());
+
+        auto left = rightIndex.find(leftKey);
+        auto right = leftIndex.find(rightKey);
+
+        if (left == rightIndex.end() && right == leftIndex.end() &&
+            (leftIndex.find(leftKey) != leftIndex.end() ||
+             rightIndex.find(rightKey) != rightIndex.end())) {
+            // Same-name segments are frequently digitized in opposite
+            // directions, so a shared endpoint can also face front-to-front
+            // or back-to-back. Reversing this segment turns those into the
+            // ordinary head-to-tail cases below; glyph placement handles
+            // either direction.
+            std::reverse(geometry[0].begin(), geometry[0].end());
+            std::swap(leftKey, rightKey);
+            left = rightIndex.find(leftKey);
+            right = leftIndex.find(rightKey);
+        }
 
         if (left != rightIndex.end() && right != leftIndex.end() && left->second != right->second) {
             // found lines with the same text adjacent to both ends of the current line, merge all
@@ -75,7 +98,7 @@ void mergeLines(std::vector<SymbolFeature>& features) {
 
             leftIndex.erase(leftKey);
             rightIndex.erase(rightKey);
-            rightIndex[getKey(*feature.text, features[i].geometry[0].back())] = i;
+            rightIndex[getKey(textId, features[i].geometry[0].back())] = i;
 
         } else if (left != rightIndex.end()) {
             // found mergeable line adjacent to the start of the current line, merge
@@ -16,7 +16,8 @@ public:
             const style::SymbolLayoutProperties::Evaluated&, const bool inside, const uint32_t index,
             const float textBoxScale, const float textPadding, style::SymbolPlacementType textPlacement,
             const float iconBoxScale, const float iconPadding, style::SymbolPlacementType iconPlacement,
-            const GlyphPositions& face, const IndexedSubfeature& indexedfeature);
+            const GlyphPositions& face, const IndexedSubfeature& indexedfeature,
+            util::Arena& arena);
 
     Point<float> point;
     uint32_t index;
@@ -1,4 +1,7 @@
 #include <mbgl/layout/symbol_layout.hpp>
+#include <mbgl/actor/actor.hpp>
+#include <mbgl/actor/scheduler.hpp>
+#include <mbgl/actor/task_group.hpp>
 #include <mbgl/layout/merge_lines.hpp>
 #include <mbgl/layout/clip_lines.hpp>
 #include <mbgl/renderer/symbol_bucket.hpp>
@@ -7,6 +10,7 @@
 #include <mbgl/style/layers/symbol_layer.hpp>
 #include <mbgl/style/layers/symbol_layer_impl.hpp>
 #include <mbgl/sprite/sprite_atlas.hpp>
+#include <mbgl/text/bidi.hpp>
 #include <mbgl/text/glyph_atlas.hpp>
 #include <mbgl/text/get_anchors.hpp>
 #include <mbgl/text/glyph_atlas.hpp>
@@ -14,6 +18,7 @@
 #include <mbgl/util/constants.hpp>
 #include <mbgl/util/utf.hpp>
 #include <mbgl/util/token.hpp>
+#include <mbgl/util/dtoa.hpp>
 #include <mbgl/util/std.hpp>
 #include <mbgl/util/constants.hpp>
 #include <mbgl/util/string.hpp>
@@ -25,16 +30,41 @@
 
 #include <mapbox/polylabel.hpp>
 
+#include <cinttypes>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
 namespace mbgl {
 
 using namespace style;
 
+namespace {
+
+// The previous placement's geometry stream is compared (and retained) as raw
+// bytes: the vertex type is standard-layout and tightly packed, and keeping
+// bytes avoids copying typed vertices around just for the comparison.
+bool geometryMatches(const std::vector<uint8_t>& previous,
+                     const gl::VertexVector<SymbolGeometryVertex>& current) {
+    return previous.size() == current.byteSize()
+        && std::memcmp(previous.data(), current.data(), previous.size()) == 0;
+}
+
+void rememberGeometry(std::vector<uint8_t>& previous,
+                      const gl::VertexVector<SymbolGeometryVertex>& current) {
+    const auto* begin = reinterpret_cast<const uint8_t*>(current.data());
+    previous.assign(begin, begin + current.byteSize());
+}
+
+} // namespace
+
 SymbolLayout::SymbolLayout(const BucketParameters& parameters,
                            const std::vector<const Layer*>& layers,
                            const GeometryTileLayer& sourceLayer,
                            SpriteAtlas& spriteAtlas_)
     : sourceLayerName(sourceLayer.getName()),
       bucketName(layers.at(0)->getID()),
+      obsolete(parameters.obsolete),
       overscaling(parameters.tileID.overscaleFactor()),
       zoom(parameters.tileID.overscaledZ),
       mode(parameters.mode),
@@ -83,43 +113,63 @@ SymbolLayout::SymbolLayout(const BucketParameters& parameters,
         layerPaintProperties.emplace(layer->getID(), layer->as<SymbolLayer>()->impl->paint.evaluated);
     }
 
+    // As in GeometryTileWorker, only build the feature identifier when the
+    // filter actually inspects "$id".
+    const std::string idKey = "$id";
+    const bool filterNeedsID = Filter::visit(leader.filter, FilterKeyUsage { idKey });
+
+    // Field templates are constant across the layer group: parse them once
+    // and expand into a reused buffer, so the per-feature cost is appends
+    // into existing capacity rather than a template scan plus temporary
+    // strings for every feature.
+    const util::TokenTemplate textTemplate { layout.get<TextField>() };
+    const util::TokenTemplate iconTemplate { layout.get<IconImage>() };
+    std::string u8buffer;
+
     // Determine and load glyph ranges
     const size_t featureCount = sourceLayer.featureCount();
     for (size_t i = 0; i < featureCount; ++i) {
         auto feature = sourceLayer.getFeature(i);
-        if (!leader.filter(feature->getType(), feature->getID(), [&] (const auto& key) { return feature->getValue(key); }))
+        if (!leader.filter(feature->getType(),
+                           filterNeedsID ? feature->getID() : optional<FeatureIdentifier>(),
+                           [&] (const auto& key) { return feature->getValue(key); }))
             continue;
 
         SymbolFeature ft;
         ft.index = i;
 
-        auto getValue = [&feature](const std::string& key) -> std::string {
+        auto appendValue = [&feature](const std::string& key, std::string& out) {
             auto value = feature->getValue(key);
             if (!value)
-                return std::string();
-            if (value->is<std::string>())
-                return value->get<std::string>();
-            if (value->is<bool>())
-                return value->get<bool>() ? "true" : "false";
-            if (value->is<int64_t>())
-                return util::toString(value->get<int64_t>());
-            if (value->is<uint64_t>())
-                return util::toString(value->get<uint64_t>());
-            if (value->is<double>())
-                return util::toString(value->get<double>());
-            return "null";
+                return;
+            if (value->is<std::string>()) {
+                out.append(value->get<std::string>());
+            } else if (value->is<bool>()) {
+                out.append(value->get<bool>() ? "true" : "false");
+            } else if (value->is<int64_t>()) {
+                char buffer[32];
+                out.append(buffer, snprintf(buffer, sizeof(buffer), "%" PRId64, value->get<int64_t>()));
+            } else if (value->is<uint64_t>()) {
+                char buffer[32];
+                out.append(buffer, snprintf(buffer, sizeof(buffer), "%" PRIu64, value->get<uint64_t>()));
+            } else if (value->is<double>()) {
+                char buffer[32];
+                out.append(buffer, util::dtoa(value->get<double>(), buffer) - buffer);
+            } else {
+                out.append("null");
+            }
         };
 
         if (hasText) {
-            std::string u8string = util::replaceTokens(layout.get<TextField>(), getValue);
+            textTemplate.expand(u8buffer, appendValue);
 
             if (layout.get<TextTransform>() == TextTransformType::Uppercase) {
-                u8string = platform::uppercase(u8string);
+                u8buffer = platform::uppercase(u8buffer);
             } else if (layout.get<TextTransform>() == TextTransformType::Lowercase) {
-                u8string = platform::lowercase(u8string);
+                u8buffer = platform::lowercase(u8buffer);
             }
 
-            ft.text = applyArabicShaping(util::utf8_to_utf16::convert(u8string));
+            ft.text = applyArabicShaping(util::utf8_to_utf16::convert(u8buffer));
 
             // Loop through all characters of this text and collect unique codepoints.
             for (char16_t chr : *ft.text) {
@@ -128,7 +178,12 @@ SymbolLayout::SymbolLayout(const BucketParameters& parameters,
         }
 
         if (hasIcon) {
-            ft.icon = util::replaceTokens(layout.get<IconImage>(), getValue);
+            if (iconTemplate.hasTokens()) {
+                iconTemplate.expand(u8buffer, appendValue);
+                ft.icon = u8buffer;
+            } else {
+                ft.icon = layout.get<IconImage>();
+            }
             ft.iconOffset = layout.evaluate<IconOffset>(zoom, *feature);
             ft.iconRotation = layout.evaluate<IconRotate>(zoom, *feature) * util::DEG2RAD;
         }
@@ -162,7 +217,8 @@ bool SymbolLayout::canPrepare(GlyphAtlas& glyphAtlas) {
 }
 
 void SymbolLayout::prepare(uintptr_t tileUID,
-                           GlyphAtlas& glyphAtlas) {
+                           GlyphAtlas& glyphAtlas,
+                           Scheduler& scheduler) {
     float horizontalAlign = 0.5;
     float verticalAlign = 0.5;
 
@@ -206,53 +262,127 @@ void SymbolLayout::prepare(uintptr_t tileUID,
 
     auto glyphSet = glyphAtlas.getGlyphSet(layout.get<TextFont>());
 
-    for (const auto& feature : features) {
-        if (feature.geometry.empty()) continue;
-
+    // Per-feature shaping results, indexed by feature position so the merge
+    // below can consume them in the original order no matter which thread
+    // produced them.
+    struct PreparedFeature {
         Shaping shapedText;
         PositionedIcon shapedIcon;
         GlyphPositions face;
+        bool sdfIcon = false;
+        bool iconNeedsLinear = false;
+    };
+    std::vector<PreparedFeature> prepared(features.size());
+
+    // Off-tile features can be culled before they reach shaping, but only
+    // when nothing downstream can want them: line placement clips its
+    // geometry to the tile instead, and still mode draws buffered symbols
+    // clipped at render time.
+    const bool mayCull = mode != MapMode::Still
+        && layout.get<SymbolPlacement>() != SymbolPlacementType::Line;
+
+    auto shapeChunk = [&] (std::size_t begin, std::size_t end) {
+        // One BiDi instance -- a pair of reusable UBiDi objects -- per worker
+        // thread, created lazily on first use. ICU requires each instance to
+        // stay on one thread, which thread_local guarantees; previously every
+        // SymbolLayout opened and closed its own pair.
+        static thread_local BiDi bidi;
+
+        // Shaping dominates layout on label-dense tiles; stop between
+        // features once the tile has been dropped. Partially shaped results
+        // are never placed for an obsolete tile.
+        for (std::size_t i = begin; !obsolete && i < end; i++) {
+            const SymbolFeature& feature = features[i];
+
+            if (feature.geometry.empty()) continue;
+
+            if (mayCull && isOutsideTileEnvelope(feature)) continue;
+
+            PreparedFeature& out = prepared[i];
+
+            // if feature has text, shape the text
+            if (feature.text) {
+                out.shapedText = glyphSet->getShaping(
+                    /* string */ *feature.text,
+                    /* maxWidth: ems */ layout.get<SymbolPlacement>() != SymbolPlacementType::Line ?
+                        layout.get<TextMaxWidth>() * 24 : 0,
+                    /* lineHeight: ems */ layout.get<TextLineHeight>() * 24,
+                    /* horizontalAlign */ horizontalAlign,
+                    /* verticalAlign */ verticalAlign,
+                    /* justify */ justify,
+                    /* spacing: ems */ layout.get<TextLetterSpacing>() * 24,
+                    /* translate */ Point<float>(layout.get<TextOffset>()[0], layout.get<TextOffset>()[1]),
+                    /* bidirectional algorithm object */ bidi);
+
+                // Add the glyphs we need for this label to the glyph atlas.
+                if (out.shapedText) {
+                    glyphAtlas.addGlyphs(tileUID, *feature.text, layout.get<TextFont>(), **glyphSet, out.face);
+                }
+            }
 
-        // if feature has text, shape the text
-        if (feature.text) {
-            shapedText = glyphSet->getShaping(
-                /* string */ *feature.text,
-                /* maxWidth: ems */ layout.get<SymbolPlacement>() != SymbolPlacementType::Line ?
-                    layout.get<TextMaxWidth>() * 24 : 0,
-                /* lineHeight: ems */ layout.get<TextLineHeight>() * 24,
-                /* horizontalAlign */ horizontalAlign,
-                /* verticalAlign */ verticalAlign,
-                /* justify */ justify,
-                /* spacing: ems */ layout.get<TextLetterSpacing>() * 24,
-                /* translate */ Point<float>(layout.get<TextOffset>()[0], layout.get<TextOffset>()[1]),
-                /* bidirectional algorithm object */ bidi);
-
-            // Add the glyphs we need for this label to the glyph atlas.
-            if (shapedText) {
-                glyphAtlas.addGlyphs(tileUID, *feature.text, layout.get<TextFont>(), **glyphSet, face);
+            // if feature has icon, get sprite atlas position
+            if (feature.icon) {
+                auto image = spriteAtlas.getImage(*feature.icon, SpritePatternMode::Single);
+                if (image) {
+                    out.shapedIcon = shapeIcon(*image, feature);
+                    assert((*image).spriteImage);
+                    if ((*image).spriteImage->sdf) {
+                        out.sdfIcon = true;
+                    }
+                    if ((*image).relativePixelRatio != 1.0f) {
+                        out.iconNeedsLinear = true;
+                    } else if (layout.get<IconRotate>().constantOr(1) != 0) {
+                        out.iconNeedsLinear = true;
+                    }
+                }
             }
         }
+    };
 
-        // if feature has icon, get sprite atlas position
-        if (feature.icon) {
-            auto image = spriteAtlas.getImage(*feature.icon, SpritePatternMode::Single);
-            if (image) {
-                shapedIcon = shapeIcon(*image, feature);
-                assert((*image).spriteImage);
-                if ((*image).spriteImage->sdf) {
-                    sdfIcons = true;
-                }
-                if ((*image).relativePixelRatio != 1.0f) {
-                    iconsNeedLinear = true;
-                } else if (layout.get<IconRotate>().constantOr(1) != 0) {
-                    iconsNeedLinear = true;
-                }
+    // Shape feature chunks across the worker pool, following the pattern of
+    // GeometryTileWorker's parallel group layouts. Shaping and atlas
+    // population are safe to run concurrently (GlyphSet, GlyphAtlas and
+    // SpriteAtlas each guard their shared state); anchor fitting and quad
+    // generation in addFeature are not -- they allocate from the arena and
+    // number symbol instances -- so those stay in the serial merge below.
+    static const std::size_t chunkSize = 64;
+
+    if (features.size() <= chunkSize) {
+        shapeChunk(0, features.size());
+    } else {
+        TaskGroup taskGroup;
+        std::size_t taskCount = 0;
+
+        for (std::size_t begin = 0; begin < features.size(); begin += chunkSize) {
+            const std::size_t end = util::min(begin + chunkSize, features.size());
+            ++taskCount;
+            taskGroup.add([&, begin, end] { shapeChunk(begin, end); });
+        }
+
+        std::unique_ptr<Actor<TaskGroupHelper>> helper;
+        if (taskCount > 1) {
+            helper = std::make_unique<Actor<TaskGroupHelper>>(scheduler, taskGroup);
+            for (std::size_t i = 1; i < taskCount; ++i) {
+                helper->invoke(&TaskGroupHelper::runOne);
             }
         }
 
+        taskGroup.join();
+    }
+
+    for (std::size_t i = 0; i < features.size(); i++) {
+        if (obsolete) {
+            return;
+        }
+
+        PreparedFeature& p = prepared[i];
+
+        sdfIcons = sdfIcons || p.sdfIcon;
+        iconsNeedLinear = iconsNeedLinear || p.iconNeedsLinear;
+
         // if either shapedText or icon position is present, add the feature
-        if (shapedText || shapedIcon) {
-            addFeature(feature, shapedText, shapedIcon, face);
+        if (p.shapedText || p.shapedIcon) {
+            addFeature(features[i], p.shapedText, p.shapedIcon, p.face);
         }
     }
 
@@ -308,11 +438,11 @@ void SymbolLayout::addFeature(const SymbolFeature& feature,
         symbolInstances.emplace_back(anchor, line, shapedText, shapedIcon, layout, addToBuffers, symbolInstances.size(),
                 textBoxScale, textPadding, textPlacement,
                 iconBoxScale, iconPadding, iconPlacement,
-                face, indexedFeature);
+                face, indexedFeature, arena);
     };
 
     if (layout.get<SymbolPlacement>() == SymbolPlacementType::Line) {
-        auto clippedLines = util::clipLines(feature.geometry, 0, 0, util::EXTENT, util::EXTENT);
+        util::clipLines(feature.geometry, 0, 0, util::EXTENT, util::EXTENT, clippedLines);
         for (const auto& line : clippedLines) {
             Anchors anchors = getAnchors(line,
                                          symbolSpacing,
@@ -362,11 +492,66 @@ void SymbolLayout::addFeature(const SymbolFeature& feature,
     }
 }
 
+bool SymbolLayout::isOutsideTileEnvelope(const SymbolFeature& feature) const {
+    const float glyphSize = 24.0f;
+
+    // Upper bound, in tile units, on how far any collision box of this
+    // feature can reach out from its anchor.
+    float reach = 0.0f;
+
+    if (feature.text) {
+        const float maxWidth = layout.get<TextMaxWidth>() * glyphSize;
+        if (maxWidth <= 0.0f) {
+            return false; // Unwrapped text has no useful width bound.
+        }
+
+        // All in glyph pixels: every wrapped line is at most maxWidth plus
+        // one overhanging advance wide, and a run of N glyphs breaks into at
+        // most ceil(N * advance / maxWidth) lines.
+        const float maxAdvance = glyphSize + layout.get<TextLetterSpacing>() * glyphSize;
+        const float lineCount = std::ceil(feature.text->size() * maxAdvance / maxWidth);
+        const float height = lineCount * layout.get<TextLineHeight>() * glyphSize;
+        const float offset = (std::fabs(layout.get<TextOffset>()[0]) +
+                              std::fabs(layout.get<TextOffset>()[1])) * glyphSize;
+
+        const float textMaxBoxScale = tilePixelRatio * textMaxSize / glyphSize;
+        reach = util::max(reach,
+                          (util::max(maxWidth + maxAdvance, height) + offset) * textMaxBoxScale +
+                              layout.get<TextPadding>() * tilePixelRatio);
+    }
+
+    if (feature.icon) {
+        // The sprite image is not sized until shaping; bound it by the
+        // largest icon plausibly shipped, a generous 256px square.
+        const float maximumIconSize = 256.0f;
+        reach = util::max(reach,
+                          maximumIconSize * tilePixelRatio * layout.get<IconSize>() +
+                              layout.get<IconPadding>() * tilePixelRatio);
+    }
+
+    // The reach is a radius around the anchor, so the collision tile's
+    // rotation cannot grow it; the factor covers placement scales up to
+    // CollisionTile's maximum of 2 and the pitch stretch of its boxes
+    // (at most 2^1.3).
+    const float pad = reach * 5.0f;
+
+    for (const auto& ring : feature.geometry) {
+        for (const auto& point : ring) {
+            if (point.x >= -pad && point.x <= util::EXTENT + pad &&
+                point.y >= -pad && point.y <= util::EXTENT + pad) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
 bool SymbolLayout::anchorIsTooClose(const std::u16string& text, const float repeatDistance, const Anchor& anchor) {
     if (compareText.find(text) == compareText.end()) {
         compareText.emplace(text, Anchors());
     } else {
-        auto otherAnchors = compareText.find(text)->second;
+        const auto& otherAnchors = compareText.find(text)->second;
         for (const Anchor& otherAnchor : otherAnchors) {
             if (util::dist<float>(anchor.point, otherAnchor.point) < repeatDistance) {
                 return true;
@@ -377,9 +562,7 @@ bool SymbolLayout::anchorIsTooClose(const std::u16string& text, const float repe
     return false;
 }
 
-std::unique_ptr<SymbolBucket> SymbolLayout::place(CollisionTile& collisionTile) {
-    auto bucket = std::make_unique<SymbolBucket>(layout, layerPaintProperties, zoom, sdfIcons, iconsNeedLinear);
-
+std::shared_ptr<SymbolBucket> SymbolLayout::place(CollisionTile& collisionTile) {
     // Calculate which labels can be shown and when they can be shown and
     // create the bufers used for rendering.
 
@@ -393,13 +576,27 @@ std::unique_ptr<SymbolBucket> SymbolLayout::place(CollisionTile& collisionTile)
     const bool mayOverlap = layout.get<TextAllowOverlap>() || layout.get<IconAllowOverlap>() ||
         layout.get<TextIgnorePlacement>() || layout.get<IconIgnorePlacement>();
 
+    // Icon-only layers that both allow overlap and ignore placement — the
+    // synthetic annotation point layer is the main producer of these, with
+    // tens of thousands of markers — can bypass the collision tile entirely:
+    // every icon is always visible and constrains nothing. Their draw order
+    // is fixed at the north-up y order instead of being re-sorted for every
+    // placement angle, which keeps stacking stable while rotating and makes
+    // the generated bucket independent of the angle, so the bucket reuse
+    // below kicks in and rotation no longer rebuilds or re-uploads their
+    // vertex data.
+    const bool alwaysPlaced = layout.get<IconAllowOverlap>()
+        && layout.get<IconIgnorePlacement>()
+        && (layout.get<TextField>().empty() || layout.get<TextFont>().empty())
+        && iconPlacement == SymbolPlacementType::Point;
+
     // Sort symbols by their y position on the canvas so that they lower symbols
     // are drawn on top of higher symbols.
     // Don't sort symbols that won't overlap because it isn't necessary and
     // because it causes more labels to pop in and out when rotating.
     if (mayOverlap) {
-        const float sin = std::sin(collisionTile.config.angle);
-        const float cos = std::cos(collisionTile.config.angle);
+        const float sin = alwaysPlaced ? 0.0f : std::sin(collisionTile.config.angle);
+        const float cos = alwaysPlaced ? 1.0f : std::cos(collisionTile.config.angle);
 
         std::sort(symbolInstances.begin(), symbolInstances.end(), [sin, cos](SymbolInstance &a, SymbolInstance &b) {
             const int32_t aRotated = sin * a.point.x + cos * a.point.y;
@@ -410,7 +607,19 @@ std::unique_ptr<SymbolBucket> SymbolLayout::place(CollisionTile& collisionTile)
         });
     }
 
-    for (SymbolInstance &symbolInstance : symbolInstances) {
+    // Collision phase: determine the scales at which each cached symbol
+    // instance becomes visible, inserting placed features as we go since
+    // they constrain the instances that follow.
+
+    std::vector<std::pair<float, float>> scales;
+    scales.reserve(symbolInstances.size());
+
+    if (alwaysPlaced) {
+        // Every instance is visible from the minimum scale on, and nothing is
+        // inserted into the collision tile for other layers to collide with.
+        scales.assign(symbolInstances.size(),
+                      { collisionTile.minScale, collisionTile.minScale });
+    } else for (SymbolInstance &symbolInstance : symbolInstances) {
 
         const bool hasText = symbolInstance.hasText;
         const bool hasIcon = symbolInstance.hasIcon;
@@ -440,25 +649,52 @@ std::unique_ptr<SymbolBucket> SymbolLayout::place(CollisionTile& collisionTile)
             iconScale = util::max(iconScale, glyphScale);
         }
 
-
-        // Insert final placement into collision tree and add glyphs/icons to buffers
-
         if (hasText) {
             collisionTile.insertFeature(symbolInstance.textCollisionFeature, glyphScale, layout.get<TextIgnorePlacement>());
-            if (glyphScale < collisionTile.maxScale) {
-                addSymbols(
-                    bucket->text, symbolInstance.glyphQuads, glyphScale,
-                    layout.get<TextKeepUpright>(), textPlacement, collisionTile.config.angle);
-            }
         }
-
         if (hasIcon) {
             collisionTile.insertFeature(symbolInstance.iconCollisionFeature, iconScale, layout.get<IconIgnorePlacement>());
-            if (iconScale < collisionTile.maxScale) {
-                addSymbols(
-                    bucket->icon, symbolInstance.iconQuads, iconScale,
-                    layout.get<IconKeepUpright>(), iconPlacement, collisionTile.config.angle);
-            }
+        }
+
+        scales.emplace_back(glyphScale, iconScale);
+    }
+
+    // Quad generation phase. The vertex data depends on the placement angle
+    // only through the keep-upright handling of line labels, the overlap
+    // sort above, and the debug buffers; when none of those apply and the
+    // collision phase produced the same visibility as last time — typical
+    // when a rotation crosses a placement threshold in a tile whose labels
+    // don't collide — reuse the previously generated bucket so nothing has
+    // to be rebuilt or re-uploaded. Always-placed layers qualify despite
+    // overlapping: their sort order above is pinned to the north-up angle.
+
+    const bool bucketReusable = (!mayOverlap || alwaysPlaced)
+        && !collisionTile.config.debug
+        && !(layout.get<TextKeepUpright>() && textPlacement == SymbolPlacementType::Line)
+        && !(layout.get<IconKeepUpright>() && iconPlacement == SymbolPlacementType::Line);
+
+    if (bucketReusable && placedBucket && scales == placedScales) {
+        return placedBucket;
+    }
+
+    auto bucket = std::make_shared<SymbolBucket>(layout, layerPaintProperties, zoom, sdfIcons, iconsNeedLinear);
+
+    auto scaleIt = scales.begin();
+    for (SymbolInstance &symbolInstance : symbolInstances) {
+        const float glyphScale = scaleIt->first;
+        const float iconScale = scaleIt->second;
+        ++scaleIt;
+
+        if (symbolInstance.hasText && glyphScale < collisionTile.maxScale) {
+            addSymbols(
+                bucket->text, symbolInstance.glyphQuads, glyphScale,
+                layout.get<TextKeepUpright>(), textPlacement, collisionTile.config.angle);
+        }
+
+        if (symbolInstance.hasIcon && iconScale < collisionTile.maxScale) {
+            addSymbols(
+                bucket->icon, symbolInstance.iconQuads, iconScale,
+                layout.get<IconKeepUpright>(), iconPlacement, collisionTile.config.angle);
         }
     }
 
@@ -466,6 +702,36 @@ std::unique_ptr<SymbolBucket> SymbolLayout::place(CollisionTile& collisionTile)
         addToDebugBuffers(collisionTile, *bucket);
     }
 
+    if (bucketReusable) {
+        // Even when the scales changed, the geometry stream usually did not:
+        // placement only rewrites the per-vertex zoom range unless it crossed
+        // a threshold that drops or revives whole quads. When the freshly
+        // generated geometry is byte-identical to the previous placement's,
+        // hand the new bucket the previous bucket's GPU geometry handles so
+        // only the small placement stream is re-uploaded. The comparison runs
+        // against worker-owned copies because the previous bucket's staging
+        // vectors may be getting moved into GL buffers on the render thread.
+        if (placedBucket) {
+            if (geometryMatches(placedTextGeometry, bucket->text.geometryVertices)) {
+                bucket->text.geometryVertexBuffer = placedBucket->text.geometryVertexBuffer;
+                bucket->text.indexBuffer = placedBucket->text.indexBuffer;
+            }
+            if (geometryMatches(placedIconGeometry, bucket->icon.geometryVertices)) {
+                bucket->icon.geometryVertexBuffer = placedBucket->icon.geometryVertexBuffer;
+                bucket->icon.indexBuffer = placedBucket->icon.indexBuffer;
+            }
+        }
+        rememberGeometry(placedTextGeometry, bucket->text.geometryVertices);
+        rememberGeometry(placedIconGeometry, bucket->icon.geometryVertices);
+        placedScales = std::move(scales);
+        placedBucket = bucket;
+    } else {
+        placedScales.clear();
+        placedBucket.reset();
+        placedTextGeometry.clear();
+        placedIconGeometry.clear();
+    }
+
     return bucket;
 }
 
@@ -515,14 +781,17 @@ void SymbolLayout::addSymbols(Buffer &buffer, const SymbolQuads &symbols, float
         uint8_t glyphAngle = std::round((symbol.glyphAngle / (M_PI * 2)) * 256);
 
         // coordinates (2 triangles)
-        buffer.vertices.emplace_back(SymbolLayoutAttributes::vertex(anchorPoint, tl, tex.x, tex.y,
-                            minZoom, maxZoom, placementZoom, glyphAngle));
-        buffer.vertices.emplace_back(SymbolLayoutAttributes::vertex(anchorPoint, tr, tex.x + tex.w, tex.y,
-                            minZoom, maxZoom, placementZoom, glyphAngle));
-        buffer.vertices.emplace_back(SymbolLayoutAttributes::vertex(anchorPoint, bl, tex.x, tex.y + tex.h,
-                            minZoom, maxZoom, placementZoom, glyphAngle));
-        buffer.vertices.emplace_back(SymbolLayoutAttributes::vertex(anchorPoint, br, tex.x + tex.w, tex.y + tex.h,
-                            minZoom, maxZoom, placementZoom, glyphAngle));
+        buffer.geometryVertices.emplace_back(SymbolGeometryAttributes::vertex(anchorPoint, tl, tex.x, tex.y));
+        buffer.geometryVertices.emplace_back(SymbolGeometryAttributes::vertex(anchorPoint, tr, tex.x + tex.w, tex.y));
+        buffer.geometryVertices.emplace_back(SymbolGeometryAttributes::vertex(anchorPoint, bl, tex.x, tex.y + tex.h));
+        buffer.geometryVertices.emplace_back(SymbolGeometryAttributes::vertex(anchorPoint, br, tex.x + tex.w, tex.y + tex.h));
+
+        // placement data, one entry per corner
+        const auto placementVertex = SymbolPlacementAttributes::vertex(minZoom, maxZoom, placementZoom, glyphAngle);
+        buffer.placementVertices.emplace_back(placementVertex);
+        buffer.placementVertices.emplace_back(placementVertex);
+        buffer.placementVertices.emplace_back(placementVertex);
+        buffer.placementVertices.emplace_back(placementVertex);
 
         // add the two triangles, referencing the four coordinates we just inserted.
         buffer.triangles.emplace_back(index + 0, index + 1, index + 2);
@@ -4,8 +4,11 @@
 #include <mbgl/style/layers/symbol_layer_properties.hpp>
 #include <mbgl/layout/symbol_feature.hpp>
 #include <mbgl/layout/symbol_instance.hpp>
-#include <mbgl/text/bidi.hpp>
+#include <mbgl/util/arena.hpp>
+#include <mbgl/util/interned_string.hpp>
 
+#include <atomic>
+#include <cstdint>
 #include <memory>
 #include <map>
 #include <unordered_set>
@@ -15,6 +18,7 @@ namespace mbgl {
 
 class GeometryTileLayer;
 class CollisionTile;
+class Scheduler;
 class SpriteAtlas;
 class GlyphAtlas;
 class SymbolBucket;
@@ -37,9 +41,10 @@ public:
     bool canPrepare(GlyphAtlas&);
 
     void prepare(uintptr_t tileUID,
-                 GlyphAtlas&);
+                 GlyphAtlas&,
+                 Scheduler&);
 
-    std::unique_ptr<SymbolBucket> place(CollisionTile&);
+    std::shared_ptr<SymbolBucket> place(CollisionTile&);
 
     bool hasSymbolInstances() const;
 
@@ -59,8 +64,29 @@ private:
                     const PositionedIcon& shapedIcon,
                     const GlyphPositions& face);
 
+    // Scratch memory for layout intermediates that die with this SymbolLayout.
+    // A dense tile makes tens of thousands of such allocations; the arena
+    // turns them into a handful of chunk allocations. Must be declared before
+    // the containers that allocate from it.
+    util::Arena arena;
+
     bool anchorIsTooClose(const std::u16string& text, const float repeatDistance, const Anchor&);
-    std::map<std::u16string, std::vector<Anchor>> compareText;
+
+    // Whether every anchor candidate of this feature is so far outside the
+    // tile that none of its symbols could be drawn in, or collide with
+    // anything inside, this tile; such features are culled before shaping.
+    bool isOutsideTileEnvelope(const SymbolFeature&) const;
+
+    // Scratch buffer reused by addFeature for clipping line geometries, so
+    // every line-placed feature doesn't allocate a fresh collection.
+    GeometryCollection clippedLines;
+
+    using CompareTextMap = std::map<std::u16string,
+                                    std::vector<Anchor>,
+                                    std::less<std::u16string>,
+                                    util::ArenaAllocator<std::pair<const std::u16string, std::vector<Anchor>>>>;
+    CompareTextMap compareText { CompareTextMap::key_compare(),
+                                 CompareTextMap::allocator_type(arena) };
 
     void addToDebugBuffers(CollisionTile&, SymbolBucket&);
 
@@ -69,8 +95,12 @@ private:
     void addSymbols(Buffer&, const SymbolQuads&, float scale,
                     const bool keepUpright, const style::SymbolPlacementType, const float placementAngle);
 
-    const std::string sourceLayerName;
-    const std::string bucketName;
+    const util::InternedString sourceLayerName;
+    const util::InternedString bucketName;
+    // Tile cancellation flag, polled inside the shaping loop of prepare().
+    // SymbolLayouts can outlive the BucketParameters they were created with,
+    // but not the GeometryTile that owns the flag.
+    const std::atomic<bool>& obsolete;
     const float overscaling;
     const float zoom;
     const MapMode mode;
@@ -87,10 +117,27 @@ private:
     bool iconsNeedLinear = false;
 
     GlyphRangeSet ranges;
-    std::vector<SymbolInstance> symbolInstances;
+    std::vector<SymbolInstance, util::ArenaAllocator<SymbolInstance>> symbolInstances {
+        util::ArenaAllocator<SymbolInstance>(arena)
+    };
     std::vector<SymbolFeature> features;
 
-    BiDi bidi; // Consider moving this up to geometry tile worker to reduce reinstantiation costs; use of BiDi/ubiditransform object must be constrained to one thread
+    // Results of the previous placement: the (text, icon) scale pair computed
+    // for each symbol instance, and the bucket generated from them. When a
+    // re-placement triggered by rotation yields identical scales and the
+    // quads themselves don't depend on the angle, the cached bucket is
+    // returned as-is and no vertex data is rebuilt or re-uploaded.
+    std::vector<std::pair<float, float>> placedScales;
+    std::shared_ptr<SymbolBucket> placedBucket;
+
+    // Byte-wise copies of the previous bucket's geometry streams. When a
+    // re-placement regenerates identical geometry, the new bucket inherits
+    // the previous bucket's GPU geometry buffers and only re-uploads the
+    // small placement stream. Copies are kept here because the previous
+    // bucket's own staging vectors belong to the render thread once it has
+    // been handed off.
+    std::vector<uint8_t> placedTextGeometry;
+    std::vector<uint8_t> placedIconGeometry;
 };
 
 } // namespace mbgl
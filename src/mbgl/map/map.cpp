@@ -1,9 +1,11 @@
 #include <mbgl/map/map.hpp>
 #include <mbgl/map/camera.hpp>
+#include <mbgl/map/map_state.hpp>
 #include <mbgl/map/view.hpp>
 #include <mbgl/map/backend.hpp>
 #include <mbgl/map/transform.hpp>
 #include <mbgl/map/transform_state.hpp>
+#include <mbgl/map/quality_governor.hpp>
 #include <mbgl/annotation/annotation_manager.hpp>
 #include <mbgl/style/style.hpp>
 #include <mbgl/style/source.hpp>
@@ -13,13 +15,21 @@
 #include <mbgl/style/update_parameters.hpp>
 #include <mbgl/style/query_parameters.hpp>
 #include <mbgl/renderer/painter.hpp>
+#include <mbgl/text/bidi.hpp>
+#include <mbgl/text/glyph.hpp>
+#include <mbgl/text/glyph_atlas.hpp>
 #include <mbgl/storage/file_source.hpp>
 #include <mbgl/storage/resource.hpp>
 #include <mbgl/storage/response.hpp>
 #include <mbgl/util/projection.hpp>
 #include <mbgl/util/math.hpp>
+#include <mbgl/math/clamp.hpp>
+#include <mbgl/util/memory_budget.hpp>
+#include <mbgl/gl/buffer_budget.hpp>
+#include <mbgl/tile/tile_latency.hpp>
 #include <mbgl/util/exception.hpp>
 #include <mbgl/util/async_task.hpp>
+#include <mbgl/util/timer.hpp>
 #include <mbgl/util/mapbox.hpp>
 #include <mbgl/util/tile_coordinate.hpp>
 #include <mbgl/actor/scheduler.hpp>
@@ -44,6 +54,11 @@ struct StillImageRequest {
 
     View& view;
     Map::StillImageCallback callback;
+
+    // Started when the request carries a deadline; on expiry the frame is
+    // delivered with whatever has loaded so far.
+    util::Timer deadline;
+    bool deadlineReached = false;
 };
 
 class Map::Impl : public style::Observer {
@@ -56,7 +71,8 @@ public:
          MapMode,
          GLContextMode,
          ConstrainMode,
-         ViewportMode);
+         ViewportMode,
+         optional<std::string> programCacheDir);
 
     void onSourceAttributionChanged(style::Source&, const std::string&) override;
     void onUpdate(Update) override;
@@ -69,6 +85,16 @@ public:
 
     void loadStyleJSON(const std::string&);
 
+    struct PendingQuery {
+        ScreenLineString geometry;
+        optional<std::vector<std::string>> layerIDs;
+        optional<uint32_t> limit;
+        Map::QueryFeaturesCallback callback;
+    };
+
+    void enqueueQuery(PendingQuery);
+    void flushQueries();
+
     Map& map;
     Backend& backend;
     FileSource& fileSource;
@@ -77,14 +103,30 @@ public:
     RenderState renderState = RenderState::Never;
     Transform transform;
 
+    // Camera state at the previous frame, used to estimate the camera velocity
+    // for predictive tile prefetch while a transition or gesture is running.
+    optional<TransformState> previousTransformState;
+
+    // Camera snapshot published once per frame for Map::getCameraSnapshot(),
+    // which may run off the map thread. Written with std::atomic_store and
+    // read with std::atomic_load; never mutate the pointee.
+    std::shared_ptr<const CameraOptions> cameraSnapshot;
+
     const MapMode mode;
     const GLContextMode contextMode;
     const float pixelRatio;
+    const optional<std::string> programCacheDir;
 
     MapDebugOptions debugOptions { MapDebugOptions::NoDebug };
 
+    Map::RenderingStatsCallback renderingStatsCallback;
+
     Update updateFlags = Update::Nothing;
 
+    // Number of open beginUpdates batches. While non-zero, onUpdate only
+    // accumulates flags; the invalidation is sent by the outermost endUpdates.
+    uint32_t updateBatchDepth = 0;
+
     std::unique_ptr<AnnotationManager> annotationManager;
     std::unique_ptr<Painter> painter;
     std::unique_ptr<Style> style;
@@ -96,11 +138,49 @@ public:
 
     std::unique_ptr<AsyncRequest> styleRequest;
 
+    // Prefetches issued by Map::warmup(). Their responses are discarded; the
+    // requests exist to populate the cache ahead of the style's own requests,
+    // which either hit the cache or attach to one still inflight. Released
+    // once a style loads.
+    std::vector<std::unique_ptr<AsyncRequest>> warmupRequests;
+
     size_t sourceCacheSize;
     bool loading = false;
 
     util::AsyncTask asyncInvalidate;
+
+    std::vector<PendingQuery> pendingQueries;
+    util::AsyncTask asyncQuery;
+
+    // Frame pacing state for continuous mode. The interval between frames is
+    // tracked as a running average and stands in for the display refresh
+    // period; a frame that used up most of it defers end-of-frame maintenance
+    // (GL object cleanup, cache shrinking) to the next frame rather than
+    // stretching the spike further.
+    Duration frameInterval { std::chrono::milliseconds(16) };
+    TimePoint previousFrameTime;
+    bool maintenanceDeferred = false;
+
+    // Steps visual quality down when measured frame times cannot keep up
+    // with the refresh period, and back up once there is headroom again.
+    // Only fed in continuous mode; still renders always run at full quality.
+    QualityGovernor qualityGovernor;
+
+    // While a continuous resize drag is in progress the tile cover is held:
+    // repaints draw with the tiles already loaded, and the cover update --
+    // which would kick off loads and parses the next resize step discards a
+    // frame later -- runs once the size has been stable for a beat. Symbol
+    // placement is per-tile here and doesn't depend on the viewport size, so
+    // existing placements stay valid throughout.
+    bool resizeSettling = false;
+    util::Timer resizeSettleTimer;
+
     std::unique_ptr<StillImageRequest> stillImageRequest;
+
+    // Snapshot handed over by setPlaceholderImage, staged here until the
+    // render thread passes it to the painter.
+    optional<std::pair<PremultipliedImage, LatLngBounds>> pendingPlaceholder;
+    bool placeholderRemovalRequested = false;
 };
 
 Map::Map(Backend& backend,
@@ -111,7 +191,8 @@ Map::Map(Backend& backend,
          MapMode mapMode,
          GLContextMode contextMode,
          ConstrainMode constrainMode,
-         ViewportMode viewportMode)
+         ViewportMode viewportMode,
+         const optional<std::string>& programCacheDir)
     : impl(std::make_unique<Impl>(*this,
                                   backend,
                                   pixelRatio,
@@ -120,8 +201,13 @@ Map::Map(Backend& backend,
                                   mapMode,
                                   contextMode,
                                   constrainMode,
-                                  viewportMode)) {
+                                  viewportMode,
+                                  programCacheDir)) {
     impl->transform.resize(size);
+
+    // Pull in one-time ICU initialization now, while no tiles are in flight,
+    // instead of paying for it inside the first label layout on a worker.
+    prewarmBiDi();
 }
 
 Map::Impl::Impl(Map& map_,
@@ -132,7 +218,8 @@ Map::Impl::Impl(Map& map_,
                 MapMode mode_,
                 GLContextMode contextMode_,
                 ConstrainMode constrainMode_,
-                ViewportMode viewportMode_)
+                ViewportMode viewportMode_,
+                optional<std::string> programCacheDir_)
     : map(map_),
       backend(backend_),
       fileSource(fileSource_),
@@ -143,6 +230,7 @@ Map::Impl::Impl(Map& map_,
       mode(mode_),
       contextMode(contextMode_),
       pixelRatio(pixelRatio_),
+      programCacheDir(std::move(programCacheDir_)),
       annotationManager(std::make_unique<AnnotationManager>(pixelRatio)),
       asyncInvalidate([this] {
           if (mode == MapMode::Continuous) {
@@ -150,6 +238,9 @@ Map::Impl::Impl(Map& map_,
           } else {
               renderStill();
           }
+      }),
+      asyncQuery([this] {
+          flushQueries();
       }) {
 }
 
@@ -166,6 +257,10 @@ Map::~Map() {
 }
 
 void Map::renderStill(View& view, StillImageCallback callback) {
+    renderStill(view, Duration::zero(), std::move(callback));
+}
+
+void Map::renderStill(View& view, Duration deadline, StillImageCallback callback) {
     if (!callback) {
         Log::Error(Event::General, "StillImageCallback not set");
         return;
@@ -192,6 +287,14 @@ void Map::renderStill(View& view, StillImageCallback callback) {
     }
 
     impl->stillImageRequest = std::make_unique<StillImageRequest>(view, std::move(callback));
+
+    if (deadline > Duration::zero()) {
+        impl->stillImageRequest->deadline.start(deadline, Duration::zero(), [this] {
+            impl->stillImageRequest->deadlineReached = true;
+            impl->onUpdate(Update::Render);
+        });
+    }
+
     impl->onUpdate(Update::Repaint);
 }
 
@@ -213,53 +316,200 @@ void Map::render(View& view) {
     impl->render(view);
 }
 
-void Map::Impl::render(View& view) {
-    if (!style) {
+void Map::precompilePrograms() {
+    if (!impl->style) {
         return;
     }
 
-    TimePoint timePoint = Clock::now();
+    BackendScope guard(impl->backend);
 
-    auto flags = transform.updateTransitions(timePoint);
+    if (!impl->painter) {
+        impl->painter = std::make_unique<Painter>(impl->backend.getContext(),
+                                                  impl->transform.getState(), impl->pixelRatio,
+                                                  impl->programCacheDir);
+    }
 
-    updateFlags |= flags;
+    impl->painter->precompilePrograms(*impl->style);
+}
+
+void Map::warmup(const MapWarmupProfile& profile) {
+    if (!profile.layerTypes.empty()) {
+        BackendScope guard(impl->backend);
+
+        if (!impl->painter) {
+            impl->painter = std::make_unique<Painter>(impl->backend.getContext(),
+                                                      impl->transform.getState(), impl->pixelRatio,
+                                                      impl->programCacheDir);
+        }
 
-    if (style->loaded && updateFlags & Update::AnnotationStyle) {
-        annotationManager->updateStyle(*style);
-        updateFlags |= Update::Classes;
+        impl->painter->precompilePrograms(profile.layerTypes);
     }
 
-    if (updateFlags & Update::AnnotationData) {
-        annotationManager->updateData();
+    // Glyphs and the sprite are fetched at low priority purely to populate
+    // the cache, concurrently with the shader compilation above and with
+    // whatever style load the embedder kicks off next.
+    auto prefetch = [this](Resource resource) {
+        resource.priority = Resource::Priority::Low;
+        impl->warmupRequests.push_back(impl->fileSource.request(resource, [](Response) {
+            // Discarded; the style reads the cache.
+        }));
+    };
+
+    if (!profile.glyphURL.empty()) {
+        for (const auto& fontStack : profile.fontStacks) {
+            // The first range covers basic Latin, which nearly every label
+            // touches; other ranges load on demand during layout.
+            prefetch(Resource::glyphs(profile.glyphURL, fontStack, { 0, 255 }));
+        }
     }
 
-    if (updateFlags & Update::Classes) {
-        style->cascade(timePoint, mode);
+    if (profile.spriteURL) {
+        prefetch(Resource::spriteImage(*profile.spriteURL, impl->pixelRatio));
+        prefetch(Resource::spriteJSON(*profile.spriteURL, impl->pixelRatio));
     }
+}
+
+void Map::setPlaceholderImage(PremultipliedImage&& image, const LatLngBounds& bounds) {
+    impl->pendingPlaceholder = std::make_pair(std::move(image), bounds);
+    impl->placeholderRemovalRequested = false;
+    impl->onUpdate(Update::Repaint);
+}
 
-    if (updateFlags & Update::Classes || updateFlags & Update::RecalculateStyle) {
-        style->recalculate(transform.getZoom(), timePoint, mode);
+void Map::removePlaceholderImage() {
+    impl->pendingPlaceholder = {};
+    impl->placeholderRemovalRequested = true;
+    impl->onUpdate(Update::Repaint);
+}
+
+void Map::Impl::render(View& view) {
+    if (!style) {
+        return;
     }
 
-    if (updateFlags & Update::Layout) {
-        style->relayout();
+    TimePoint timePoint = Clock::now();
+
+    if (mode == MapMode::Continuous) {
+        // Track the frame cadence. Deltas well beyond a plausible refresh
+        // period mean the map was idle, not that the display is slow.
+        if (previousFrameTime != TimePoint()) {
+            const Duration delta = timePoint - previousFrameTime;
+            if (delta < std::chrono::milliseconds(100)) {
+                frameInterval = (frameInterval * 7 + delta) / 8;
+            }
+        }
+        previousFrameTime = timePoint;
     }
 
-    style::UpdateParameters parameters(pixelRatio,
-                                       debugOptions,
-                                       transform.getState(),
-                                       scheduler,
-                                       fileSource,
-                                       mode,
-                                       *annotationManager,
-                                       *style);
+    auto flags = transform.updateTransitions(timePoint);
+
+    updateFlags |= flags;
+
+    // Publish this frame's camera for off-thread readers (UI overlays polling
+    // getCameraSnapshot()); transitions were just advanced, so this is the
+    // state the frame will be drawn with.
+    std::atomic_store(&cameraSnapshot,
+                      std::shared_ptr<const CameraOptions>(
+                          std::make_shared<CameraOptions>(transform.getCameraOptions({}))));
+
+    // A tile-arrival notification (Update::Render) cannot change the tile
+    // cover, and in still mode the camera holds steady while a request is in
+    // flight; skip the style and tile update pass and go straight to checking
+    // whether the frame can now be drawn. Continuous mode keeps updating every
+    // frame -- animations and gestures change the cover without setting flags.
+    if (mode != MapMode::Still || updateFlags != Update::Render) {
+        if (style->loaded && updateFlags & Update::AnnotationStyle) {
+            annotationManager->updateStyle(*style);
+            updateFlags |= Update::Classes;
+        }
+
+        if (updateFlags & Update::AnnotationData) {
+            annotationManager->updateData();
+        }
+
+        if (updateFlags & Update::Classes) {
+            style->cascade(timePoint, mode, &scheduler);
+        }
+
+        if (updateFlags & Update::Classes || updateFlags & Update::RecalculateStyle) {
+            style->recalculate(transform.getZoom(), timePoint, mode, &scheduler);
+        }
+
+        if (updateFlags & Update::Layout) {
+            style->relayout();
+        }
 
-    style->updateTiles(parameters);
+        style::UpdateParameters parameters(pixelRatio,
+                                           debugOptions,
+                                           transform.getState(),
+                                           scheduler,
+                                           fileSource,
+                                           mode,
+                                           *annotationManager,
+                                           *style);
+
+        parameters.placementAngleQuantization = qualityGovernor.placementAngleQuantization();
+        parameters.allowSpeculativeWork = qualityGovernor.allowSpeculativeWork();
+
+        // While the camera is moving, extrapolate it a few frames ahead along its
+        // current velocity and hand the predicted state to the sources, which
+        // prefetch the predicted cover at low priority. By the time a fast pan or
+        // zoom settles, the tiles it lands on are often already warm in the cache.
+        if (mode == MapMode::Continuous && previousTransformState &&
+            qualityGovernor.allowSpeculativeWork() &&
+            (transform.inTransition() || transform.isGestureInProgress())) {
+            const TransformState& current = transform.getState();
+            const LatLng previousLatLng = previousTransformState->getLatLng();
+            const LatLng latLng = current.getLatLng();
+            const double zoomDelta = current.getZoom() - previousTransformState->getZoom();
+            const double latitudeDelta = latLng.latitude - previousLatLng.latitude;
+            const double longitudeDelta = latLng.longitude - previousLatLng.longitude;
+
+            // How many frames ahead to extrapolate: small enough that the
+            // prediction rarely overshoots the easing's deceleration, large enough
+            // for the prefetched tiles to arrive before the camera does.
+            const double prefetchFrames = 5.0;
+
+            if (zoomDelta != 0.0 || latitudeDelta != 0.0 || longitudeDelta != 0.0) {
+                TransformState predicted = current;
+                predicted.setLatLngZoom(
+                    LatLng(util::clamp(latLng.latitude + latitudeDelta * prefetchFrames,
+                                       -util::LATITUDE_MAX, util::LATITUDE_MAX),
+                           latLng.longitude + longitudeDelta * prefetchFrames,
+                           LatLng::Wrapped),
+                    util::clamp(current.getZoom() + zoomDelta * prefetchFrames,
+                                current.getMinZoom(), current.getMaxZoom()));
+                parameters.prefetchTransformState = std::move(predicted);
+            }
+        }
+        previousTransformState = transform.getState();
+
+        // A camera transition or gesture overrides the resize hold: the cover
+        // is changing anyway, so there is nothing to save by deferring.
+        if (!resizeSettling || transform.inTransition() || transform.isGestureInProgress()) {
+            style->updateTiles(parameters);
+        }
+    }
 
     updateFlags = Update::Nothing;
 
     if (!painter) {
-        painter = std::make_unique<Painter>(backend.getContext(), transform.getState(), pixelRatio);
+        painter = std::make_unique<Painter>(backend.getContext(), transform.getState(), pixelRatio,
+                                            programCacheDir);
+    }
+
+    if (placeholderRemovalRequested) {
+        painter->clearPlaceholder();
+        placeholderRemovalRequested = false;
+    }
+    if (pendingPlaceholder) {
+        painter->setPlaceholder(std::move(pendingPlaceholder->first), pendingPlaceholder->second);
+        pendingPlaceholder = {};
+    }
+    // The snapshot has served its purpose once the live style — including
+    // every tile of the current viewport — has finished loading; drop it so
+    // this frame shows the real map.
+    if (painter->hasPlaceholder() && style->isLoaded()) {
+        painter->clearPlaceholder();
     }
 
     if (mode == MapMode::Continuous) {
@@ -280,7 +530,9 @@ void Map::Impl::render(View& view) {
                         view,
                         annotationManager->getSpriteAtlas());
 
-        painter->cleanup();
+        if (renderingStatsCallback) {
+            renderingStatsCallback(painter->stats);
+        }
 
         backend.notifyMapChange(style->isLoaded() ?
             MapChangeDidFinishRenderingFrameFullyRendered :
@@ -303,12 +555,20 @@ void Map::Impl::render(View& view) {
             flags |= Update::Repaint;
         }
 
+        // Feed the measured frame time to the quality governor; on a level
+        // change, re-read the knobs it owns and schedule an update so the
+        // placement and prefetch knobs take effect on the next pass.
+        if (qualityGovernor.observeFrame(Clock::now() - timePoint, frameInterval)) {
+            painter->fadeDuration = qualityGovernor.fadeDuration();
+            flags |= Update::Repaint;
+        }
+
         // Only schedule an update if we need to paint another frame due to transitions or
         // animations that are still in progress
         if (flags != Update::Nothing) {
             onUpdate(flags);
         }
-    } else if (stillImageRequest && style->isLoaded()) {
+    } else if (stillImageRequest && (style->isLoaded() || stillImageRequest->deadlineReached)) {
         FrameData frameData { timePoint,
                               pixelRatio,
                               mode,
@@ -328,14 +588,45 @@ void Map::Impl::render(View& view) {
         auto request = std::move(stillImageRequest);
         request->callback(nullptr);
 
-        painter->cleanup();
+        if (renderingStatsCallback) {
+            renderingStatsCallback(painter->stats);
+        }
     }
+
+    // The frame has been submitted; now run the camera observer callbacks
+    // that updateTransitions() deferred, so their cost lands after the draw
+    // instead of in the middle of the frame.
+    transform.deliverTransitionNotifications();
+
+    // End-of-frame maintenance: destroy abandoned GL objects and give memory
+    // back if the process-wide budget is exceeded. Neither is needed for the
+    // frame just drawn, so in continuous mode a frame that already used most
+    // of the refresh period defers them once to the next frame instead of
+    // stretching the spike further. A single deferral is the cap: if the next
+    // frame is busy too, the backlog must not grow without bound.
+    if (mode == MapMode::Continuous && !maintenanceDeferred &&
+        Clock::now() - timePoint > frameInterval / 2) {
+        maintenanceDeferred = true;
+        onUpdate(Update::Repaint);
+        return;
+    }
+    maintenanceDeferred = false;
+
+    painter->cleanup();
+
+    // Cached tiles are the only consumer that can shrink without affecting
+    // what is currently on screen.
+    MemoryBudget::Enforce();
 }
 
 #pragma mark - Style
 
 void Map::setStyleURL(const std::string& url) {
-    if (impl->styleURL == url) {
+    // Re-setting the current style is a no-op, which lets a pooled still-mode
+    // map be handed a fresh render request without throwing away its parsed
+    // style, atlases, and tile caches. A mutated style, however, must be
+    // rebuilt so the next session starts from the stylesheet as written.
+    if (impl->styleURL == url && !impl->styleMutated) {
         return;
     }
 
@@ -379,7 +670,9 @@ void Map::setStyleURL(const std::string& url) {
 }
 
 void Map::setStyleJSON(const std::string& json) {
-    if (impl->styleJSON == json) {
+    // As with setStyleURL, reloading the identical stylesheet keeps everything
+    // warm across still renders unless runtime mutations have to be undone.
+    if (impl->styleJSON == json && !impl->styleMutated) {
         return;
     }
 
@@ -402,7 +695,7 @@ void Map::Impl::loadStyleJSON(const std::string& json) {
     styleJSON = json;
 
     // force style cascade, causing all pending transitions to complete.
-    style->cascade(Clock::now(), mode);
+    style->cascade(Clock::now(), mode, &scheduler);
 
     if (!cameraMutated) {
         // Zoom first because it may constrain subsequent operations.
@@ -413,6 +706,10 @@ void Map::Impl::loadStyleJSON(const std::string& json) {
     }
 
     onUpdate(Update::Classes | Update::RecalculateStyle | Update::AnnotationStyle);
+
+    // Warm-up prefetches have served their purpose: the style's requests from
+    // setJSON attach to any of them still inflight, and the rest are cached.
+    warmupRequests.clear();
 }
 
 std::string Map::getStyleURL() const {
@@ -457,6 +754,11 @@ CameraOptions Map::getCameraOptions(optional<EdgeInsets> padding) const {
     return impl->transform.getCameraOptions(padding);
 }
 
+CameraOptions Map::getCameraSnapshot() const {
+    auto snapshot = std::atomic_load(&impl->cameraSnapshot);
+    return snapshot ? *snapshot : CameraOptions();
+}
+
 void Map::jumpTo(const CameraOptions& camera) {
     impl->cameraMutated = true;
     impl->transform.jumpTo(camera);
@@ -657,7 +959,20 @@ double Map::getMaxZoom() const {
 #pragma mark - Size
 
 void Map::setSize(const Size size) {
-    impl->transform.resize(size);
+    if (!impl->transform.resize(size)) {
+        return;
+    }
+
+    if (impl->mode == MapMode::Continuous) {
+        // Debounce the tile-cover update during continuous resizing; each
+        // step still repaints immediately at the new size.
+        impl->resizeSettling = true;
+        impl->resizeSettleTimer.start(std::chrono::milliseconds(150), Duration::zero(), [this] {
+            impl->resizeSettling = false;
+            impl->onUpdate(Update::Repaint);
+        });
+    }
+
     impl->onUpdate(Update::Repaint);
 }
 
@@ -829,6 +1144,54 @@ std::vector<Feature> Map::queryRenderedFeatures(const ScreenBox& box, const opti
     });
 }
 
+void Map::queryRenderedFeatures(const ScreenCoordinate& point,
+                                const optional<std::vector<std::string>>& layerIDs,
+                                optional<uint32_t> limit,
+                                QueryFeaturesCallback callback) {
+    impl->enqueueQuery({ { point }, layerIDs, limit, std::move(callback) });
+}
+
+void Map::queryRenderedFeatures(const ScreenBox& box,
+                                const optional<std::vector<std::string>>& layerIDs,
+                                optional<uint32_t> limit,
+                                QueryFeaturesCallback callback) {
+    impl->enqueueQuery({
+        {
+            box.min,
+            { box.max.x, box.min.y },
+            box.max,
+            { box.min.x, box.max.y },
+            box.min
+        },
+        layerIDs, limit, std::move(callback)
+    });
+}
+
+void Map::Impl::enqueueQuery(PendingQuery query) {
+    pendingQueries.push_back(std::move(query));
+    asyncQuery.send();
+}
+
+void Map::Impl::flushQueries() {
+    // Callbacks may enqueue follow-up queries; those land in a fresh list
+    // and are answered on the next wakeup.
+    std::vector<PendingQuery> queries = std::move(pendingQueries);
+    pendingQueries.clear();
+
+    for (auto& query : queries) {
+        std::vector<Feature> result;
+        if (style) {
+            result = style->queryRenderedFeatures({
+                query.geometry,
+                transform.getState(),
+                query.layerIDs,
+                query.limit
+            });
+        }
+        query.callback(std::move(result));
+    }
+}
+
 AnnotationIDs Map::queryPointAnnotations(const ScreenBox& box) {
     auto features = queryRenderedFeatures(box, {{ AnnotationManager::PointLayerID }});
     std::set<AnnotationID> set;
@@ -990,12 +1353,14 @@ void Map::cycleDebugOptions() {
 #if not MBGL_USE_GLES2
     if (impl->debugOptions & MapDebugOptions::StencilClip)
         impl->debugOptions = MapDebugOptions::NoDebug;
-    else if (impl->debugOptions & MapDebugOptions::Overdraw)
+    else if (impl->debugOptions & MapDebugOptions::Overlay)
         impl->debugOptions = MapDebugOptions::StencilClip;
 #else
-    if (impl->debugOptions & MapDebugOptions::Overdraw)
+    if (impl->debugOptions & MapDebugOptions::Overlay)
         impl->debugOptions = MapDebugOptions::NoDebug;
 #endif // MBGL_USE_GLES2
+    else if (impl->debugOptions & MapDebugOptions::Overdraw)
+        impl->debugOptions = MapDebugOptions::Overlay;
     else if (impl->debugOptions & MapDebugOptions::Collision)
         impl->debugOptions = MapDebugOptions::Overdraw;
     else if (impl->debugOptions & MapDebugOptions::Timestamps)
@@ -1014,10 +1379,63 @@ MapDebugOptions Map::getDebug() const {
     return impl->debugOptions;
 }
 
+void Map::setRenderingStatsCallback(RenderingStatsCallback callback) {
+    impl->renderingStatsCallback = std::move(callback);
+}
+
 bool Map::isFullyLoaded() const {
     return impl->style ? impl->style->isLoaded() : false;
 }
 
+bool Map::needsRepaint() const {
+    // The first frame (and any frame before the style is fully rendered)
+    // always needs to be painted; after that, the accumulated update flags
+    // are the damage record, and transitions/animations keep producing new
+    // frames until they settle.
+    return impl->renderState != RenderState::Fully
+        || impl->updateFlags != Update::Nothing
+        || impl->transform.inTransition()
+        || impl->transform.isGestureInProgress()
+        || (impl->style && impl->style->hasTransitions())
+        || (impl->painter && impl->painter->needsAnimation())
+        || bool(impl->stillImageRequest);
+}
+
+#pragma mark - Batching
+
+void Map::beginUpdates() {
+    ++impl->updateBatchDepth;
+}
+
+void Map::endUpdates() {
+    assert(impl->updateBatchDepth > 0);
+    if (impl->updateBatchDepth > 0 && --impl->updateBatchDepth == 0 &&
+        impl->updateFlags != Update::Nothing) {
+        impl->asyncInvalidate.send();
+    }
+}
+
+void Map::applyState(const MapState& state) {
+    beginUpdates();
+
+    // Transition options first so a class change in the same bundle picks
+    // them up when it cascades.
+    if (state.transitionOptions) {
+        setTransitionOptions(*state.transitionOptions);
+    }
+    if (state.classes) {
+        setClasses(*state.classes);
+    }
+    if (state.debugOptions) {
+        setDebug(*state.debugOptions);
+    }
+    if (state.camera) {
+        jumpTo(*state.camera);
+    }
+
+    endUpdates();
+}
+
 void Map::addClass(const std::string& className) {
     if (impl->style && impl->style->addClass(className)) {
         impl->onUpdate(Update::Classes);
@@ -1061,6 +1479,27 @@ std::vector<std::string> Map::getClasses() const {
     return {};
 }
 
+void Map::prefetchGlyphs(const std::vector<FontStack>& fontStacks,
+                         const char16_t first,
+                         const char16_t last) {
+    if (!impl->style || impl->style->glyphAtlas->getURL().empty() || last < first) {
+        return;
+    }
+
+    GlyphRangeSet ranges;
+    for (uint32_t codepoint = first; codepoint <= last; codepoint += GLYPHS_PER_GLYPH_RANGE) {
+        ranges.insert(getGlyphRange(static_cast<char16_t>(codepoint)));
+    }
+    ranges.insert(getGlyphRange(last));
+
+    // hasGlyphRanges issues the requests for every range it doesn't have yet;
+    // ranges that are in flight, parsed, or satisfied by the process-wide
+    // GlyphCache cost nothing.
+    for (const auto& fontStack : fontStacks) {
+        impl->style->glyphAtlas->hasGlyphRanges(fontStack, ranges);
+    }
+}
+
 void Map::setSourceTileCacheSize(size_t size) {
     if (size != impl->sourceCacheSize) {
         impl->sourceCacheSize = size;
@@ -1070,13 +1509,46 @@ void Map::setSourceTileCacheSize(size_t size) {
     }
 }
 
+void Map::setMemoryBudget(size_t bytes) {
+    MemoryBudget::SetLimit(bytes);
+}
+
+size_t Map::getMemoryUsage() const {
+    return MemoryBudget::Usage();
+}
+
+void Map::setVertexBufferBudget(size_t bytes) {
+    gl::BufferBudget::SetLimit(bytes);
+}
+
+size_t Map::getVertexBufferUsage() const {
+    return gl::BufferBudget::Usage();
+}
+
+Duration Map::getTileLatencyPercentile(double p) const {
+    return TileLatency::percentile(p);
+}
+
+size_t Map::getTileLatencySampleCount() const {
+    return TileLatency::sampleCount();
+}
+
+void Map::resetTileLatencyHistogram() {
+    TileLatency::reset();
+}
+
 void Map::onLowMemory() {
+    // Drop cached tiles first: they are the largest consumer and the
+    // cheapest to recreate, since evicting them doesn't touch anything that
+    // is currently on screen.
+    if (impl->style) {
+        impl->style->onLowMemory();
+    }
     if (impl->painter) {
         BackendScope guard(impl->backend);
-        impl->painter->cleanup();
+        impl->painter->onLowMemory();
     }
     if (impl->style) {
-        impl->style->onLowMemory();
         impl->backend.invalidate();
     }
 }
@@ -1087,7 +1559,10 @@ void Map::Impl::onSourceAttributionChanged(style::Source&, const std::string&) {
 
 void Map::Impl::onUpdate(Update flags) {
     updateFlags |= flags;
-    asyncInvalidate.send();
+
+    if (updateBatchDepth == 0) {
+        asyncInvalidate.send();
+    }
 }
 
 void Map::Impl::onStyleLoaded() {
@@ -0,0 +1,81 @@
+#include <mbgl/map/quality_governor.hpp>
+#include <mbgl/util/constants.hpp>
+
+namespace mbgl {
+
+namespace {
+
+// Degrade once the smoothed frame time has spent this many consecutive frames
+// above 90% of the refresh period (~a quarter second at 60Hz); recover once it
+// has spent this many below 50% (~two seconds at 60Hz).
+constexpr uint32_t degradeStreakLength = 15;
+constexpr uint32_t recoverStreakLength = 120;
+
+} // namespace
+
+bool QualityGovernor::observeFrame(const Duration& frameTime, const Duration& frameInterval) {
+    if (smoothedFrameTime == Duration::zero()) {
+        smoothedFrameTime = frameTime;
+    } else {
+        smoothedFrameTime = (smoothedFrameTime * 7 + frameTime) / 8;
+    }
+
+    const bool over = smoothedFrameTime * 10 > frameInterval * 9;
+    const bool under = smoothedFrameTime * 2 < frameInterval;
+
+    if (over) {
+        ++overBudgetStreak;
+        underBudgetStreak = 0;
+    } else if (under) {
+        ++underBudgetStreak;
+        overBudgetStreak = 0;
+    } else {
+        // In the dead band between the thresholds both streaks reset, so a
+        // borderline workload holds whatever level it has.
+        overBudgetStreak = 0;
+        underBudgetStreak = 0;
+    }
+
+    if (over && overBudgetStreak >= degradeStreakLength && currentLevel != Level::Minimal) {
+        currentLevel = static_cast<Level>(static_cast<uint8_t>(currentLevel) + 1);
+        overBudgetStreak = 0;
+        // The level change itself cuts the frame time; restart the average so
+        // the stale one doesn't trigger the next degradation immediately.
+        smoothedFrameTime = Duration::zero();
+        return true;
+    }
+
+    if (under && underBudgetStreak >= recoverStreakLength && currentLevel != Level::Full) {
+        currentLevel = static_cast<Level>(static_cast<uint8_t>(currentLevel) - 1);
+        underBudgetStreak = 0;
+        return true;
+    }
+
+    return false;
+}
+
+float QualityGovernor::placementAngleQuantization() const {
+    switch (currentLevel) {
+    case Level::Full:
+        return 0.0f;
+    case Level::Reduced:
+        return static_cast<float>(3.0 * util::DEG2RAD);
+    case Level::Minimal:
+        return static_cast<float>(10.0 * util::DEG2RAD);
+    }
+    return 0.0f;
+}
+
+Duration QualityGovernor::fadeDuration() const {
+    switch (currentLevel) {
+    case Level::Full:
+        return util::DEFAULT_FADE_DURATION;
+    case Level::Reduced:
+        return util::DEFAULT_FADE_DURATION / 2;
+    case Level::Minimal:
+        return Duration::zero();
+    }
+    return util::DEFAULT_FADE_DURATION;
+}
+
+} // namespace mbgl
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <mbgl/util/chrono.hpp>
+
+#include <cstdint>
+
+namespace mbgl {
+
+/*
+    Trades visual quality for frame rate when the device cannot sustain the
+    display's refresh period. The map feeds it one measured frame time per
+    rendered frame; a smoothed average is compared against the frame interval
+    and the governor steps through discrete quality levels, each of which
+    relaxes a set of live knobs (symbol fade duration, placement granularity,
+    speculative tile work).
+
+    Hysteresis is asymmetric: degrading takes a sustained overrun of roughly a
+    quarter second, recovering takes comfortable headroom for a couple of
+    seconds. Quality therefore ratchets down promptly under load and creeps
+    back up only once the load has genuinely passed, instead of oscillating
+    around the threshold.
+*/
+class QualityGovernor {
+public:
+    enum class Level : uint8_t {
+        // Every knob at its default.
+        Full = 0,
+        // Cheaper animation: halved fades, coarser placement triggers.
+        Reduced = 1,
+        // As above, plus no fades and no speculative work.
+        Minimal = 2,
+    };
+
+    // Feeds one frame's measured CPU time together with the current estimate
+    // of the display refresh period. Returns true when the quality level
+    // changed, in which case the caller should re-read the knobs below.
+    bool observeFrame(const Duration& frameTime, const Duration& frameInterval);
+
+    Level level() const { return currentLevel; }
+
+    // Granularity, in radians, applied to the bearing and pitch that trigger
+    // symbol re-placement. Zero means re-place on any change; a coarser grid
+    // means slow rotations cross fewer placement boundaries.
+    float placementAngleQuantization() const;
+
+    // Symbol fade duration at the current level. Shorter fades mean fewer
+    // animation-driven repaints after each placement.
+    Duration fadeDuration() const;
+
+    // Whether sources should spend time on speculative work this update:
+    // predictive tile prefetch and raster decode-ahead.
+    bool allowSpeculativeWork() const { return currentLevel != Level::Minimal; }
+
+private:
+    Duration smoothedFrameTime = Duration::zero();
+    uint32_t overBudgetStreak = 0;
+    uint32_t underBudgetStreak = 0;
+    Level currentLevel = Level::Full;
+};
+
+} // namespace mbgl
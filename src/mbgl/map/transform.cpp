@@ -586,10 +586,15 @@ void Transform::startTransition(const CameraOptions& camera,
         // At t = 1.0, a DidChangeAnimated notification should be sent from finish().
         if (t < 1.0) {
             if (animation.transitionFrameFn) {
-                animation.transitionFrameFn(t);
+                auto transitionFrame = animation.transitionFrameFn;
+                notifyObservers([transitionFrame, t] {
+                    transitionFrame(t);
+                });
             }
             if (callback) {
-                callback(MapChangeRegionIsChanging);
+                notifyObservers([this] {
+                    callback(MapChangeRegionIsChanging);
+                });
             }
         } else {
             transitionFinishFn();
@@ -607,10 +612,15 @@ void Transform::startTransition(const CameraOptions& camera,
         state.scaling = false;
         state.rotating = false;
         if (animation.transitionFinishFn) {
-            animation.transitionFinishFn();
+            auto transitionFinish = animation.transitionFinishFn;
+            notifyObservers([transitionFinish] {
+                transitionFinish();
+            });
         }
         if (callback) {
-            callback(isAnimated ? MapChangeRegionDidChangeAnimated : MapChangeRegionDidChange);
+            notifyObservers([this, isAnimated] {
+                callback(isAnimated ? MapChangeRegionDidChangeAnimated : MapChangeRegionDidChange);
+            });
         }
     };
 
@@ -624,7 +634,38 @@ bool Transform::inTransition() const {
 }
 
 Update Transform::updateTransitions(const TimePoint& now) {
-    return transitionFrameFn ? transitionFrameFn(now) : Update::Nothing;
+    if (!transitionFrameFn) {
+        return Update::Nothing;
+    }
+
+    // Advance the easing and the transform state now; queue the observer
+    // callbacks for deliverTransitionNotifications(). SDK bindings react to
+    // these by doing arbitrary amounts of work (updating chrome around the
+    // map, say), which used to run between the camera update and the draw
+    // and made frame pacing dependent on the observers.
+    deferringNotifications = true;
+    Update result = transitionFrameFn(now);
+    deferringNotifications = false;
+    return result;
+}
+
+void Transform::deliverTransitionNotifications() {
+    // A delivered callback may start or cancel a transition, queueing nothing
+    // further (deferral is only active inside updateTransitions), but it must
+    // not invalidate this iteration; work from a copy.
+    std::vector<std::function<void()>> notifications;
+    std::swap(notifications, deferredNotifications);
+    for (const auto& notify : notifications) {
+        notify();
+    }
+}
+
+void Transform::notifyObservers(std::function<void()> notify) {
+    if (deferringNotifications) {
+        deferredNotifications.push_back(std::move(notify));
+    } else {
+        notify();
+    }
 }
 
 void Transform::cancelTransitions() {
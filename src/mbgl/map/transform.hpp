@@ -13,6 +13,7 @@
 #include <cstdint>
 #include <cmath>
 #include <functional>
+#include <vector>
 
 namespace mbgl {
 
@@ -144,6 +145,10 @@ public:
     // Transitions
     bool inTransition() const;
     Update updateTransitions(const TimePoint& now);
+    // Runs the observer callbacks queued by updateTransitions(). The caller
+    // invokes this once the frame has been drawn, so that SDK-side reactions
+    // to camera changes never run between the camera update and the draw.
+    void deliverTransitionNotifications();
     TimePoint getTransitionStart() const { return transitionStart; }
     Duration getTransitionDuration() const { return transitionDuration; }
     void cancelTransitions();
@@ -176,6 +181,15 @@ private:
     Duration transitionDuration;
     std::function<Update(const TimePoint)> transitionFrameFn;
     std::function<void()> transitionFinishFn;
+
+    // Observer callbacks (region-is-changing notifications, the per-frame and
+    // finish callbacks from AnimationOptions) generated while a transition is
+    // advanced on the render tick are queued here instead of running inline,
+    // keeping arbitrary SDK work out of the easing-to-draw critical path.
+    // Outside of updateTransitions() they run immediately as before.
+    void notifyObservers(std::function<void()>);
+    bool deferringNotifications = false;
+    std::vector<std::function<void()>> deferredNotifications;
 };
 
 } // namespace mbgl
@@ -16,14 +16,21 @@ TransformState::TransformState(ConstrainMode constrainMode_, ViewportMode viewpo
 #pragma mark - Matrix
 
 void TransformState::matrixFor(mat4& matrix, const UnwrappedTileID& tileID) const {
+    const aff2 transform = tileTransform(tileID);
+
+    matrix::identity(matrix);
+    matrix::translate(matrix, matrix, transform[2], transform[3], 0);
+    matrix::scale(matrix, matrix, transform[0], transform[1], 1);
+}
+
+aff2 TransformState::tileTransform(const UnwrappedTileID& tileID) const {
     const uint64_t tileScale = 1ull << tileID.canonical.z;
     const double s = Projection::worldSize(scale) / tileScale;
 
-    matrix::identity(matrix);
-    matrix::translate(matrix, matrix,
-                      int64_t(tileID.canonical.x + tileID.wrap * tileScale) * s,
-                      int64_t(tileID.canonical.y) * s, 0);
-    matrix::scale(matrix, matrix, s / util::EXTENT, s / util::EXTENT, 1);
+    return {{ s / util::EXTENT,
+              s / util::EXTENT,
+              int64_t(tileID.canonical.x + tileID.wrap * tileScale) * s,
+              int64_t(tileID.canonical.y) * s }};
 }
 
 void TransformState::getProjMatrix(mat4& projMatrix) const {
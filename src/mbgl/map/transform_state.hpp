@@ -24,6 +24,9 @@ public:
 
     // Matrix
     void matrixFor(mat4&, const UnwrappedTileID&) const;
+    // The tile-to-world transform of matrixFor() in its natural affine form,
+    // for composing with a projection matrix without a general 4x4 multiply.
+    aff2 tileTransform(const UnwrappedTileID&) const;
     void getProjMatrix(mat4& matrix) const;
 
     // Dimensions
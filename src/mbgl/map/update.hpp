@@ -7,6 +7,10 @@ namespace mbgl {
 enum class Update {
     Nothing                   = 0,
     Repaint                   = 1 << 0,
+    // A repaint triggered by new content arriving for the existing tile set.
+    // Unlike Repaint it cannot change the tile cover, which lets still mode
+    // skip the per-notification tile update pass.
+    Render                    = 1 << 1,
     Classes                   = 1 << 2,
     RecalculateStyle          = 1 << 3,
     AnnotationStyle           = 1 << 6,
@@ -9,10 +9,6 @@
 
 namespace mbgl {
 
-namespace uniforms {
-MBGL_DEFINE_UNIFORM_SCALAR(bool, u_scale_with_map);
-} // namespace uniforms
-
 class CircleProgram : public Program<
     shaders::circle,
     gl::Triangle,
@@ -20,7 +16,6 @@ class CircleProgram : public Program<
         attributes::a_pos>,
     gl::Uniforms<
         uniforms::u_matrix,
-        uniforms::u_scale_with_map,
         uniforms::u_extrude_scale>,
     style::CirclePaintProperties>
 {
@@ -44,6 +39,7 @@ public:
 };
 
 using CircleLayoutVertex = CircleProgram::LayoutVertex;
+static_assert(sizeof(CircleLayoutVertex) == 4, "expected CircleLayoutVertex to be 4 bytes");
 using CircleAttributes = CircleProgram::Attributes;
 
 } // namespace mbgl
@@ -53,5 +53,6 @@ public:
 };
 
 using CollisionBoxVertex = CollisionBoxProgram::LayoutVertex;
+static_assert(sizeof(CollisionBoxVertex) == 10, "expected CollisionBoxVertex to be 10 bytes");
 
 } // namespace mbgl
@@ -22,6 +22,7 @@ public:
 };
 
 using DebugLayoutVertex = DebugProgram::LayoutVertex;
+static_assert(sizeof(DebugLayoutVertex) == 4, "expected DebugLayoutVertex to be 4 bytes");
 using DebugAttributes = DebugProgram::Attributes;
 
 } // namespace mbgl
@@ -122,6 +122,7 @@ public:
 };
 
 using FillLayoutVertex = FillProgram::LayoutVertex;
+static_assert(sizeof(FillLayoutVertex) == 4, "expected FillLayoutVertex to be 4 bytes");
 using FillAttributes = FillProgram::Attributes;
 
 } // namespace mbgl
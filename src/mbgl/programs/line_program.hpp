@@ -160,6 +160,7 @@ public:
 };
 
 using LineLayoutVertex = LineProgram::LayoutVertex;
+static_assert(sizeof(LineLayoutVertex) == 8, "expected LineLayoutVertex to be 8 bytes");
 using LineAttributes = LineProgram::Attributes;
 
 } // namespace mbgl
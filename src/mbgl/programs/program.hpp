@@ -5,8 +5,12 @@
 #include <mbgl/programs/attributes.hpp>
 #include <mbgl/style/paint_property.hpp>
 
+#include <mbgl/util/io.hpp>
+
 #include <sstream>
 #include <cassert>
+#include <cstring>
+#include <functional>
 
 namespace mbgl {
 
@@ -33,9 +37,64 @@ public:
     ProgramType program;
 
     Program(gl::Context& context, const ProgramParameters& programParameters)
-        : program(context, vertexSource(programParameters), fragmentSource(programParameters))
+        : program(create(context, programParameters))
         {}
 
+    // Loads the program from the binary cache if the driver supports program
+    // binaries and a cache directory is configured; compiles from source
+    // otherwise, persisting the freshly linked binary for the next launch.
+    // Entries are keyed by a hash of the preprocessed shader sources and the
+    // driver identity, so driver updates or shader changes miss the cache and
+    // fall back to compilation.
+    static ProgramType create(gl::Context& context, const ProgramParameters& parameters) {
+        const std::string vertex = vertexSource(parameters);
+        const std::string fragment = fragmentSource(parameters);
+
+        if (!parameters.cacheDir || !context.supportsProgramBinaries()) {
+            return ProgramType { context, vertex, fragment };
+        }
+
+        const std::string cachePath = binaryCachePath(context, parameters, vertex, fragment);
+
+        try {
+            const std::string data = util::read_file(cachePath);
+            if (data.size() > sizeof(gl::BinaryProgramFormat)) {
+                gl::BinaryProgramFormat format;
+                std::memcpy(&format, data.data(), sizeof(format));
+                return ProgramType { context, format, data.substr(sizeof(format)) };
+            }
+        } catch (...) {
+            // Missing or stale cache entry; fall through to compiling from source.
+        }
+
+        ProgramType result { context, vertex, fragment };
+
+        if (auto binary = context.getBinaryProgram(result.identifier())) {
+            std::string data;
+            data.reserve(sizeof(binary->first) + binary->second.size());
+            data.append(reinterpret_cast<const char*>(&binary->first), sizeof(binary->first));
+            data.append(binary->second);
+            try {
+                util::write_file(cachePath, data);
+            } catch (...) {
+                // Failing to persist a cache entry is not an error.
+            }
+        }
+
+        return result;
+    }
+
+    static std::string binaryCachePath(gl::Context& context,
+                                       const ProgramParameters& parameters,
+                                       const std::string& vertex,
+                                       const std::string& fragment) {
+        std::ostringstream ss;
+        ss << *parameters.cacheDir << "/com.mapbox.gl.program." << Shaders::name << "."
+           << std::hex << std::hash<std::string>()(vertex + fragment + context.driverIdentity())
+           << ".bin";
+        return ss.str();
+    }
+
     static std::string pixelRatioDefine(const ProgramParameters& parameters) {
         std::ostringstream pixelRatioSS;
         pixelRatioSS.imbue(std::locale("C"));
@@ -45,7 +104,7 @@ public:
     }
 
     static std::string fragmentSource(const ProgramParameters& parameters) {
-        std::string source = pixelRatioDefine(parameters) + Shaders::fragmentSource;
+        std::string source = pixelRatioDefine(parameters) + parameters.defines + Shaders::fragmentSource;
         if (parameters.overdraw) {
             assert(source.find("#ifdef OVERDRAW_INSPECTOR") != std::string::npos);
             source.replace(source.find_first_of('\n'), 1, "\n#define OVERDRAW_INSPECTOR\n");
@@ -54,7 +113,7 @@ public:
     }
 
     static std::string vertexSource(const ProgramParameters& parameters) {
-        return pixelRatioDefine(parameters) + Shaders::vertexSource;
+        return pixelRatioDefine(parameters) + parameters.defines + Shaders::vertexSource;
     }
 
     template <class DrawMode>
@@ -1,16 +1,41 @@
 #pragma once
 
+#include <mbgl/util/optional.hpp>
+
+#include <string>
+#include <utility>
+
 namespace mbgl {
 
 class ProgramParameters {
 public:
-    ProgramParameters(float pixelRatio_ = 1.0, bool overdraw_ = false)
+    ProgramParameters(float pixelRatio_ = 1.0,
+                      bool overdraw_ = false,
+                      optional<std::string> cacheDir_ = {})
       : pixelRatio(pixelRatio_),
-        overdraw(overdraw_) {}
+        overdraw(overdraw_),
+        cacheDir(std::move(cacheDir_)) {}
+
+    // Returns a copy with an additional "#define <name>" prepended to both
+    // shader stages. Programs uses this to instantiate compile-time shader
+    // variants: modes that are fixed for the duration of a draw (e.g. map
+    // versus viewport alignment) compile to straight-line code instead of
+    // branching on a uniform per fragment. Each distinct combination yields
+    // distinct preprocessed sources and therefore its own binary cache entry.
+    ProgramParameters withDefine(const std::string& name) const {
+        ProgramParameters result = *this;
+        result.defines += "#define " + name + "\n";
+        return result;
+    }
 
     float pixelRatio;
     bool overdraw;
+
+    // Directory for cached program binaries; unset disables binary caching.
+    optional<std::string> cacheDir;
+
+    // Preprocessor definitions prepended to both shader stages.
+    std::string defines;
 };
 
 } // namespace mbgl
-
@@ -0,0 +1,70 @@
+#include <mbgl/programs/programs.hpp>
+
+#include <mbgl/style/style.hpp>
+#include <mbgl/style/layer.hpp>
+#include <mbgl/style/layers/background_layer.hpp>
+#include <mbgl/style/layers/circle_layer.hpp>
+#include <mbgl/style/layers/fill_layer.hpp>
+#include <mbgl/style/layers/line_layer.hpp>
+#include <mbgl/style/layers/raster_layer.hpp>
+#include <mbgl/style/layers/symbol_layer.hpp>
+
+namespace mbgl {
+
+void Programs::precompile(const style::Style& style) {
+    for (const style::Layer* layer : style.getLayers()) {
+        if (layer->is<style::FillLayer>() || layer->is<style::BackgroundLayer>()) {
+            fill();
+            fillPattern();
+            fillOutline();
+            fillOutlinePattern();
+        } else if (layer->is<style::LineLayer>()) {
+            line();
+            lineSDF();
+            linePattern();
+        } else if (layer->is<style::CircleLayer>()) {
+            circle(false);
+        } else if (layer->is<style::SymbolLayer>()) {
+            // Warm the viewport-aligned variants; map-aligned specializations
+            // of these programs compile lazily on first draw like any other
+            // variant.
+            symbolIcon(false);
+            symbolIconSDF(false, false);
+            symbolGlyph(false, false);
+            symbolGlyphHaloFill(false, false);
+        } else if (layer->is<style::RasterLayer>()) {
+            raster();
+        }
+    }
+
+    // The fill program also renders clipping masks, which every frame needs.
+    fill();
+}
+
+void Programs::precompile(const std::vector<std::string>& layerTypes) {
+    for (const std::string& type : layerTypes) {
+        if (type == "fill" || type == "background") {
+            fill();
+            fillPattern();
+            fillOutline();
+            fillOutlinePattern();
+        } else if (type == "line") {
+            line();
+            lineSDF();
+            linePattern();
+        } else if (type == "circle") {
+            circle(false);
+        } else if (type == "symbol") {
+            symbolIcon(false);
+            symbolIconSDF(false, false);
+            symbolGlyph(false, false);
+            symbolGlyphHaloFill(false, false);
+        } else if (type == "raster") {
+            raster();
+        }
+    }
+
+    fill();
+}
+
+} // namespace mbgl
@@ -9,42 +9,129 @@
 #include <mbgl/programs/collision_box_program.hpp>
 #include <mbgl/programs/program_parameters.hpp>
 
+#include <array>
+#include <memory>
+#include <string>
+#include <vector>
+
 namespace mbgl {
 
+namespace style {
+class Style;
+} // namespace style
+
 class Programs {
 public:
-    Programs(gl::Context& context, const ProgramParameters& programParameters)
-        : circle(context, programParameters),
-          fill(context, programParameters),
-          fillPattern(context, programParameters),
-          fillOutline(context, programParameters),
-          fillOutlinePattern(context, programParameters),
-          line(context, programParameters),
-          lineSDF(context, programParameters),
-          linePattern(context, programParameters),
-          raster(context, programParameters),
-          symbolIcon(context, programParameters),
-          symbolIconSDF(context, programParameters),
-          symbolGlyph(context, programParameters),
-          debug(context, ProgramParameters(programParameters.pixelRatio, false)),
-          collisionBox(context, ProgramParameters(programParameters.pixelRatio, false)) {
-    }
-
-    CircleProgram circle;
-    FillProgram fill;
-    FillPatternProgram fillPattern;
-    FillOutlineProgram fillOutline;
-    FillOutlinePatternProgram fillOutlinePattern;
-    LineProgram line;
-    LineSDFProgram lineSDF;
-    LinePatternProgram linePattern;
-    RasterProgram raster;
-    SymbolIconProgram symbolIcon;
-    SymbolSDFProgram symbolIconSDF;
-    SymbolSDFProgram symbolGlyph;
-
-    DebugProgram debug;
-    CollisionBoxProgram collisionBox;
+    Programs(gl::Context& context_, const ProgramParameters& programParameters)
+        : context(context_),
+          parameters(programParameters) {
+    }
+
+    // Each program is compiled and linked on first use, so styles that never
+    // draw a given layer type don't pay for its shaders. precompile() warms up
+    // the programs a parsed style will need, for embedders that prefer the
+    // compilation cost at load time rather than on the first frame.
+    void precompile(const style::Style&);
+
+    // Same, but driven by style-spec layer type names ("fill", "line", ...)
+    // recorded from a previous session, for warming up before any style has
+    // been parsed. Unknown names are ignored.
+    void precompile(const std::vector<std::string>& layerTypes);
+
+    // Compile-time shader variants: modes that are fixed for the duration of
+    // a draw select a specialization compiled with the matching #define
+    // instead of branching on a uniform. Each variant is compiled lazily on
+    // first use and cached through the program binary cache like any other
+    // program.
+    CircleProgram& circle(bool scaleWithMap) {
+        return get(circleProgram[scaleWithMap ? 1 : 0],
+                   scaleWithMap ? parameters.withDefine("SCALE_WITH_MAP") : parameters);
+    }
+    FillProgram& fill() { return get(fillProgram); }
+    FillPatternProgram& fillPattern() { return get(fillPatternProgram); }
+    FillOutlineProgram& fillOutline() { return get(fillOutlineProgram); }
+    FillOutlinePatternProgram& fillOutlinePattern() { return get(fillOutlinePatternProgram); }
+    LineProgram& line() { return get(lineProgram); }
+    LineSDFProgram& lineSDF() { return get(lineSDFProgram); }
+    LinePatternProgram& linePattern() { return get(linePatternProgram); }
+    RasterProgram& raster() { return get(rasterProgram); }
+    SymbolIconProgram& symbolIcon(bool rotateWithMap) {
+        return get(symbolIconProgram[rotateWithMap ? 1 : 0],
+                   rotateWithMap ? parameters.withDefine("ROTATE_WITH_MAP") : parameters);
+    }
+    SymbolSDFProgram& symbolIconSDF(bool rotateWithMap, bool pitchWithMap) {
+        return get(symbolIconSDFProgram[sdfVariant(rotateWithMap, pitchWithMap)],
+                   sdfParameters(rotateWithMap, pitchWithMap));
+    }
+    SymbolSDFProgram& symbolGlyph(bool rotateWithMap, bool pitchWithMap) {
+        return get(symbolGlyphProgram[sdfVariant(rotateWithMap, pitchWithMap)],
+                   sdfParameters(rotateWithMap, pitchWithMap));
+    }
+    SymbolSDFHaloFillProgram& symbolIconSDFHaloFill(bool rotateWithMap, bool pitchWithMap) {
+        return get(symbolIconSDFHaloFillProgram[sdfVariant(rotateWithMap, pitchWithMap)],
+                   sdfParameters(rotateWithMap, pitchWithMap));
+    }
+    SymbolSDFHaloFillProgram& symbolGlyphHaloFill(bool rotateWithMap, bool pitchWithMap) {
+        return get(symbolGlyphHaloFillProgram[sdfVariant(rotateWithMap, pitchWithMap)],
+                   sdfParameters(rotateWithMap, pitchWithMap));
+    }
+
+    DebugProgram& debug() {
+        return get(debugProgram, ProgramParameters(parameters.pixelRatio, false, parameters.cacheDir));
+    }
+    CollisionBoxProgram& collisionBox() {
+        return get(collisionBoxProgram, ProgramParameters(parameters.pixelRatio, false, parameters.cacheDir));
+    }
+
+private:
+    template <class Program>
+    Program& get(std::unique_ptr<Program>& program) {
+        return get(program, parameters);
+    }
+
+    static std::size_t sdfVariant(bool rotateWithMap, bool pitchWithMap) {
+        return (rotateWithMap ? 1 : 0) | (pitchWithMap ? 2 : 0);
+    }
+
+    ProgramParameters sdfParameters(bool rotateWithMap, bool pitchWithMap) const {
+        ProgramParameters result = parameters;
+        if (rotateWithMap) {
+            result = result.withDefine("ROTATE_WITH_MAP");
+        }
+        if (pitchWithMap) {
+            result = result.withDefine("PITCH_WITH_MAP");
+        }
+        return result;
+    }
+
+    template <class Program>
+    Program& get(std::unique_ptr<Program>& program, const ProgramParameters& programParameters) {
+        if (!program) {
+            program = std::make_unique<Program>(context, programParameters);
+        }
+        return *program;
+    }
+
+    gl::Context& context;
+    const ProgramParameters parameters;
+
+    std::array<std::unique_ptr<CircleProgram>, 2> circleProgram;
+    std::unique_ptr<FillProgram> fillProgram;
+    std::unique_ptr<FillPatternProgram> fillPatternProgram;
+    std::unique_ptr<FillOutlineProgram> fillOutlineProgram;
+    std::unique_ptr<FillOutlinePatternProgram> fillOutlinePatternProgram;
+    std::unique_ptr<LineProgram> lineProgram;
+    std::unique_ptr<LineSDFProgram> lineSDFProgram;
+    std::unique_ptr<LinePatternProgram> linePatternProgram;
+    std::unique_ptr<RasterProgram> rasterProgram;
+    std::array<std::unique_ptr<SymbolIconProgram>, 2> symbolIconProgram;
+    std::array<std::unique_ptr<SymbolSDFProgram>, 4> symbolIconSDFProgram;
+    std::array<std::unique_ptr<SymbolSDFProgram>, 4> symbolGlyphProgram;
+    std::array<std::unique_ptr<SymbolSDFHaloFillProgram>, 4> symbolIconSDFHaloFillProgram;
+    std::array<std::unique_ptr<SymbolSDFHaloFillProgram>, 4> symbolGlyphHaloFillProgram;
+
+    std::unique_ptr<DebugProgram> debugProgram;
+    std::unique_ptr<CollisionBoxProgram> collisionBoxProgram;
 };
 
 } // namespace mbgl
@@ -63,6 +63,7 @@ public:
 };
 
 using RasterLayoutVertex = RasterProgram::LayoutVertex;
+static_assert(sizeof(RasterLayoutVertex) == 8, "expected RasterLayoutVertex to be 8 bytes");
 using RasterAttributes = RasterProgram::Attributes;
 
 } // namespace mbgl
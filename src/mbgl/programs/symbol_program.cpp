@@ -7,7 +7,8 @@ namespace mbgl {
 
 using namespace style;
 
-static_assert(sizeof(SymbolLayoutVertex) == 16, "expected SymbolLayoutVertex size");
+static_assert(sizeof(SymbolGeometryVertex) == 12, "expected SymbolGeometryVertex size");
+static_assert(sizeof(SymbolPlacementVertex) == 4, "expected SymbolPlacementVertex size");
 
 template <class Values, class...Args>
 Values makeValues(const style::SymbolPropertyValues& values,
@@ -39,7 +40,6 @@ Values makeValues(const style::SymbolPropertyValues& values,
         uniforms::u_extrude_scale::Value{ extrudeScale },
         uniforms::u_texsize::Value{ std::array<float, 2> {{ float(texsize.width) / 4, float(texsize.height) / 4 }} },
         uniforms::u_zoom::Value{ float((state.getZoom() - zoomAdjust) * 10) },
-        uniforms::u_rotate_with_map::Value{ values.rotationAlignment == AlignmentType::Map },
         uniforms::u_texture::Value{ 0 },
         uniforms::u_fadetexture::Value{ 1 },
         std::forward<Args>(args)...
@@ -90,8 +90,7 @@ static SymbolSDFProgram::UniformValues makeSDFValues(const style::SymbolProperty
         uniforms::u_gamma::Value{ (gammaBase + gammaAdjust) * gammaScale },
         uniforms::u_pitch::Value{ state.getPitch() },
         uniforms::u_bearing::Value{ -1.0f * state.getAngle() },
-        uniforms::u_aspect_ratio::Value{ (state.getSize().width * 1.0f) / (state.getSize().height * 1.0f) },
-        uniforms::u_pitch_with_map::Value{ values.pitchAlignment == AlignmentType::Map }
+        uniforms::u_aspect_ratio::Value{ (state.getSize().width * 1.0f) / (state.getSize().height * 1.0f) }
     );
 }
 
@@ -142,4 +141,44 @@ SymbolSDFProgram::foregroundUniformValues(const style::SymbolPropertyValues& val
     );
 }
 
+SymbolSDFHaloFillProgram::UniformValues
+SymbolSDFHaloFillProgram::uniformValues(const style::SymbolPropertyValues& values,
+                                        const Size& texsize,
+                                        const std::array<float, 2>& pixelsToGLUnits,
+                                        const RenderTile& tile,
+                                        const TransformState& state,
+                                        float pixelRatio)
+{
+    // Same thresholds and gammas that haloUniformValues and
+    // foregroundUniformValues compute for the two-pass path; here the fill
+    // parameters fill the symbol_sdf slots and the halo parameters ride along
+    // in the dedicated u_halo_* uniforms.
+    const float scale = values.paintSize / values.sdfScale;
+    const float sdfPx = 8.0f;
+    const float blurOffset = 1.19f;
+    const float haloOffset = 6.0f;
+
+    const float gammaBase = 0.105 * values.sdfScale / values.paintSize / pixelRatio;
+    const float gammaScale = (values.pitchAlignment == AlignmentType::Map
+        ? 1.0 / std::cos(state.getPitch())
+        : 1.0) / state.getCameraToCenterDistance();
+
+    return makeValues<SymbolSDFHaloFillProgram::UniformValues>(
+        values,
+        texsize,
+        pixelsToGLUnits,
+        tile,
+        state,
+        uniforms::u_color::Value{ values.color },
+        uniforms::u_buffer::Value{ (256.0f - 64.0f) / 256.0f },
+        uniforms::u_gamma::Value{ gammaBase * gammaScale },
+        uniforms::u_pitch::Value{ state.getPitch() },
+        uniforms::u_bearing::Value{ -1.0f * state.getAngle() },
+        uniforms::u_aspect_ratio::Value{ (state.getSize().width * 1.0f) / (state.getSize().height * 1.0f) },
+        uniforms::u_halo_color::Value{ values.haloColor },
+        uniforms::u_halo_buffer::Value{ (haloOffset - values.haloWidth / scale) / sdfPx },
+        uniforms::u_halo_gamma::Value{ (gammaBase + values.haloBlur * blurOffset / scale / sdfPx) * gammaScale }
+    );
+}
+
 } // namespace mbgl
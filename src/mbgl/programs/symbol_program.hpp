@@ -5,6 +5,7 @@
 #include <mbgl/programs/uniforms.hpp>
 #include <mbgl/shaders/symbol_icon.hpp>
 #include <mbgl/shaders/symbol_sdf.hpp>
+#include <mbgl/shaders/symbol_sdf_halo_fill.hpp>
 #include <mbgl/util/geometry.hpp>
 #include <mbgl/util/size.hpp>
 #include <mbgl/style/layers/symbol_layer_properties.hpp>
@@ -23,29 +24,31 @@ class TransformState;
 
 namespace uniforms {
 MBGL_DEFINE_UNIFORM_VECTOR(float, 2, u_texsize);
-MBGL_DEFINE_UNIFORM_SCALAR(bool, u_rotate_with_map);
-MBGL_DEFINE_UNIFORM_SCALAR(bool, u_pitch_with_map);
 MBGL_DEFINE_UNIFORM_SCALAR(gl::TextureUnit, u_texture);
 MBGL_DEFINE_UNIFORM_SCALAR(gl::TextureUnit, u_fadetexture);
 MBGL_DEFINE_UNIFORM_SCALAR(float, u_buffer);
 MBGL_DEFINE_UNIFORM_SCALAR(float, u_gamma);
 MBGL_DEFINE_UNIFORM_SCALAR(float, u_aspect_ratio);
+MBGL_DEFINE_UNIFORM_SCALAR(Color, u_halo_color);
+MBGL_DEFINE_UNIFORM_SCALAR(float, u_halo_buffer);
+MBGL_DEFINE_UNIFORM_SCALAR(float, u_halo_gamma);
 } // namespace uniforms
 
-struct SymbolLayoutAttributes : gl::Attributes<
+// Symbol vertex data is split into two streams that are bound side by side:
+// the geometry stream (position, glyph offset, texture coordinates) is fixed
+// once layout has run, while the placement stream (the packed a_data zoom
+// range and angle) changes with every placement. Keeping them in separate
+// buffers lets a re-placement re-upload only the 4-byte placement vertices
+// and reuse the 12-byte geometry buffer from the previous placement.
+struct SymbolGeometryAttributes : gl::Attributes<
     attributes::a_pos,
     attributes::a_offset<2>,
-    attributes::a_texture_pos,
-    attributes::a_data<4>>
+    attributes::a_texture_pos>
 {
     static Vertex vertex(Point<float> a,
                          Point<float> o,
                          uint16_t tx,
-                         uint16_t ty,
-                         float minzoom,
-                         float maxzoom,
-                         float labelminzoom,
-                         uint8_t labelangle) {
+                         uint16_t ty) {
         return Vertex {
             {{
                 static_cast<int16_t>(a.x),
@@ -58,7 +61,19 @@ struct SymbolLayoutAttributes : gl::Attributes<
             {{
                 static_cast<uint16_t>(tx / 4),
                 static_cast<uint16_t>(ty / 4)
-            }},
+            }}
+        };
+    }
+};
+
+struct SymbolPlacementAttributes : gl::Attributes<
+    attributes::a_data<4>>
+{
+    static Vertex vertex(float minzoom,
+                         float maxzoom,
+                         float labelminzoom,
+                         uint8_t labelangle) {
+        return Vertex {
             {{
                 static_cast<uint8_t>(labelminzoom * 10), // 1/10 zoom levels: z16 == 160
                 static_cast<uint8_t>(labelangle),
@@ -69,23 +84,78 @@ struct SymbolLayoutAttributes : gl::Attributes<
     }
 };
 
-class SymbolIconProgram : public Program<
-    shaders::symbol_icon,
+// The shader-visible attribute set is unchanged: both streams concatenate to
+// the former interleaved layout, so locations and names stay the same.
+using SymbolLayoutAttributes = gl::ConcatenateAttributes<SymbolGeometryAttributes, SymbolPlacementAttributes>;
+
+template <class Shaders, class Uniforms>
+class SymbolProgram : public Program<
+    Shaders,
     gl::Triangle,
     SymbolLayoutAttributes,
+    Uniforms,
+    style::SymbolPaintProperties>
+{
+public:
+    using BaseProgram = Program<
+        Shaders,
+        gl::Triangle,
+        SymbolLayoutAttributes,
+        Uniforms,
+        style::SymbolPaintProperties>;
+
+    using BaseProgram::BaseProgram;
+
+    using UniformValues = typename BaseProgram::UniformValues;
+    using PaintPropertyBinders = typename BaseProgram::PaintPropertyBinders;
+    using Attributes = typename BaseProgram::Attributes;
+
+    // Like the generic Program::draw, but sources the layout attributes from
+    // the two symbol streams instead of one interleaved vertex buffer.
+    template <class DrawMode>
+    void draw(gl::Context& context,
+              DrawMode drawMode,
+              gl::DepthMode depthMode,
+              gl::StencilMode stencilMode,
+              gl::ColorMode colorMode,
+              UniformValues&& uniformValues,
+              const gl::VertexBuffer<SymbolGeometryAttributes::Vertex>& geometryVertexBuffer,
+              const gl::VertexBuffer<SymbolPlacementAttributes::Vertex>& placementVertexBuffer,
+              const gl::IndexBuffer<DrawMode>& indexBuffer,
+              const gl::SegmentVector<Attributes>& segments,
+              const PaintPropertyBinders& paintPropertyBinders,
+              const typename style::SymbolPaintProperties::Evaluated& currentProperties,
+              float currentZoom) {
+        this->program.draw(
+            context,
+            std::move(drawMode),
+            std::move(depthMode),
+            std::move(stencilMode),
+            std::move(colorMode),
+            uniformValues
+                .concat(paintPropertyBinders.uniformValues(currentZoom)),
+            SymbolGeometryAttributes::allVariableBindings(geometryVertexBuffer)
+                .concat(SymbolPlacementAttributes::allVariableBindings(placementVertexBuffer))
+                .concat(paintPropertyBinders.attributeBindings(currentProperties)),
+            indexBuffer,
+            segments
+        );
+    }
+};
+
+class SymbolIconProgram : public SymbolProgram<
+    shaders::symbol_icon,
     gl::Uniforms<
         uniforms::u_matrix,
         uniforms::u_opacity,
         uniforms::u_extrude_scale,
         uniforms::u_texsize,
         uniforms::u_zoom,
-        uniforms::u_rotate_with_map,
         uniforms::u_texture,
-        uniforms::u_fadetexture>,
-    style::SymbolPaintProperties>
+        uniforms::u_fadetexture>>
 {
 public:
-    using Program::Program;
+    using SymbolProgram::SymbolProgram;
 
     static UniformValues uniformValues(const style::SymbolPropertyValues&,
                                        const Size& texsize,
@@ -94,17 +164,14 @@ public:
                                        const TransformState&);
 };
 
-class SymbolSDFProgram : public Program<
+class SymbolSDFProgram : public SymbolProgram<
     shaders::symbol_sdf,
-    gl::Triangle,
-    SymbolLayoutAttributes,
     gl::Uniforms<
         uniforms::u_matrix,
         uniforms::u_opacity,
         uniforms::u_extrude_scale,
         uniforms::u_texsize,
         uniforms::u_zoom,
-        uniforms::u_rotate_with_map,
         uniforms::u_texture,
         uniforms::u_fadetexture,
         uniforms::u_color,
@@ -112,12 +179,10 @@ class SymbolSDFProgram : public Program<
         uniforms::u_gamma,
         uniforms::u_pitch,
         uniforms::u_bearing,
-        uniforms::u_aspect_ratio,
-        uniforms::u_pitch_with_map>,
-    style::SymbolPaintProperties>
+        uniforms::u_aspect_ratio>>
 {
 public:
-    using Program::Program;
+    using SymbolProgram::SymbolProgram;
 
     static UniformValues haloUniformValues(const style::SymbolPropertyValues&,
                                            const Size& texsize,
@@ -134,7 +199,45 @@ public:
                                                  float pixelRatio);
 };
 
-using SymbolLayoutVertex = SymbolLayoutAttributes::Vertex;
+// Single-pass variant of SymbolSDFProgram for layers that draw both a halo
+// and a fill: the shader thresholds the distance field at both buffers and
+// composites in-register, replacing the halo-then-foreground draw pair with
+// one draw over the same buffers.
+class SymbolSDFHaloFillProgram : public SymbolProgram<
+    shaders::symbol_sdf_halo_fill,
+    gl::Uniforms<
+        uniforms::u_matrix,
+        uniforms::u_opacity,
+        uniforms::u_extrude_scale,
+        uniforms::u_texsize,
+        uniforms::u_zoom,
+        uniforms::u_texture,
+        uniforms::u_fadetexture,
+        uniforms::u_color,
+        uniforms::u_buffer,
+        uniforms::u_gamma,
+        uniforms::u_pitch,
+        uniforms::u_bearing,
+        uniforms::u_aspect_ratio,
+        uniforms::u_halo_color,
+        uniforms::u_halo_buffer,
+        uniforms::u_halo_gamma>>
+{
+public:
+    using SymbolProgram::SymbolProgram;
+
+    static UniformValues uniformValues(const style::SymbolPropertyValues&,
+                                       const Size& texsize,
+                                       const std::array<float, 2>& pixelsToGLUnits,
+                                       const RenderTile&,
+                                       const TransformState&,
+                                       float pixelRatio);
+};
+
+using SymbolGeometryVertex = SymbolGeometryAttributes::Vertex;
+using SymbolPlacementVertex = SymbolPlacementAttributes::Vertex;
+static_assert(sizeof(SymbolGeometryVertex) == 12, "expected SymbolGeometryVertex to be 12 bytes");
+static_assert(sizeof(SymbolPlacementVertex) == 4, "expected SymbolPlacementVertex to be 4 bytes");
 using SymbolAttributes = SymbolIconProgram::Attributes;
 
 } // namespace mbgl
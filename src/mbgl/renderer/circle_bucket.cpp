@@ -6,12 +6,23 @@
 #include <mbgl/style/layers/circle_layer_impl.hpp>
 #include <mbgl/util/constants.hpp>
 
+#include <algorithm>
+#include <cmath>
+
 namespace mbgl {
 
 using namespace style;
 
 CircleBucket::CircleBucket(const BucketParameters& parameters, const std::vector<const Layer*>& layers)
-    : mode(parameters.mode) {
+    : mode(parameters.mode),
+      // Aggregation bakes one color for the whole tile, so it is only an
+      // option when a single layer draws this bucket and none of its paint
+      // properties are data-driven.
+      mayAggregate(layers.size() == 1 && !layers.front()->as<CircleLayer>()->impl->hasDataDrivenPaint()),
+      aggregationColor(mayAggregate
+                           ? layers.front()->as<CircleLayer>()->impl->paint.evaluated
+                                 .get<CircleColor>().constantOr(Color::black())
+                           : Color::black()) {
     for (const auto& layer : layers) {
         paintPropertyBinders.emplace(layer->getID(),
             CircleProgram::PaintPropertyBinders(
@@ -20,9 +31,79 @@ CircleBucket::CircleBucket(const BucketParameters& parameters, const std::vector
     }
 }
 
+void CircleBucket::binPoint(const GeometryCoordinate& point) {
+    // Out-of-tile points (which Still mode keeps for quads) can't land in
+    // the grid; the neighbouring tile bins its own copy.
+    if (point.x < 0 || point.x >= util::EXTENT || point.y < 0 || point.y >= util::EXTENT) {
+        return;
+    }
+    const uint32_t x = uint32_t(point.x) * densityGridSize / util::EXTENT;
+    const uint32_t y = uint32_t(point.y) * densityGridSize / util::EXTENT;
+    densityGrid[y * densityGridSize + x] += 1.0f;
+}
+
+void CircleBucket::switchToAggregation() {
+    densityGrid.assign(densityGridSize * densityGridSize, 0.0f);
+    for (const auto& point : pendingPoints) {
+        binPoint(point);
+    }
+    pendingPoints.clear();
+    pendingPoints.shrink_to_fit();
+
+    // The grid supersedes the quads emitted so far. The paint property
+    // binders stay: without data-driven paint they hold no per-vertex data.
+    vertices = {};
+    segments.clear();
+
+    aggregated = true;
+}
+
+void CircleBucket::commit() {
+    if (aggregated) {
+        // Normalize against the densest cell with a square-root ramp, so
+        // moderately dense areas stay visible next to extreme hotspots, and
+        // bake the layer's (premultiplied, constant) circle color. Opacity
+        // still applies live at draw time, but a circle-color change only
+        // takes effect on the next layout.
+        float maxCount = 0.0f;
+        for (const float count : densityGrid) {
+            maxCount = std::max(maxCount, count);
+        }
+        const float invMax = maxCount > 0.0f ? 1.0f / maxCount : 0.0f;
+
+        density = PremultipliedImage({ densityGridSize, densityGridSize });
+        for (std::size_t i = 0; i < densityGrid.size(); i++) {
+            const Color pixel = aggregationColor * std::sqrt(densityGrid[i] * invMax);
+            density.data[i * 4 + 0] = uint8_t(std::round(pixel.r * 255.0f));
+            density.data[i * 4 + 1] = uint8_t(std::round(pixel.g * 255.0f));
+            density.data[i * 4 + 2] = uint8_t(std::round(pixel.b * 255.0f));
+            density.data[i * 4 + 3] = uint8_t(std::round(pixel.a * 255.0f));
+        }
+        densityGrid.clear();
+        densityGrid.shrink_to_fit();
+    }
+    pendingPoints.clear();
+    pendingPoints.shrink_to_fit();
+
+    vertices.shrinkToFit();
+    segments.shrink_to_fit();
+
+    for (auto& pair : paintPropertyBinders) {
+        pair.second.shrinkToFit();
+    }
+}
+
+std::size_t CircleBucket::uploadByteSize() const {
+    return vertices.byteSize() + density.bytes();
+}
+
 void CircleBucket::upload(gl::Context& context) {
-    vertexBuffer = context.createVertexBuffer(std::move(vertices));
-    indexBuffer = context.createIndexBuffer(std::move(triangles));
+    if (aggregated) {
+        densityTexture = context.createTexture(std::move(density));
+        density = {};
+    } else {
+        vertexBuffer = context.createVertexBuffer(std::move(vertices));
+    }
 
     for (auto& pair : paintPropertyBinders) {
         pair.second.upload(context);
@@ -39,7 +120,7 @@ void CircleBucket::render(Painter& painter,
 }
 
 bool CircleBucket::hasData() const {
-    return !segments.empty();
+    return !segments.empty() || aggregated;
 }
 
 void CircleBucket::addFeature(const GeometryTileFeature& feature,
@@ -57,9 +138,24 @@ void CircleBucket::addFeature(const GeometryTileFeature& feature,
             if ((mode != MapMode::Still) &&
                 (x < 0 || x >= util::EXTENT || y < 0 || y >= util::EXTENT)) continue;
 
+            if (aggregated) {
+                binPoint(point);
+                continue;
+            }
+
+            if (mayAggregate) {
+                pendingPoints.push_back(point);
+                if (pendingPoints.size() > aggregationThreshold) {
+                    switchToAggregation();
+                    continue;
+                }
+            }
+
             if (segments.empty() || segments.back().vertexLength + vertexLength > std::numeric_limits<uint16_t>::max()) {
                 // Move to a new segments because the old one can't hold the geometry.
-                segments.emplace_back(vertices.vertexSize(), triangles.indexSize());
+                // Indices come from the shared quad pattern, so every segment
+                // starts at index offset zero.
+                segments.emplace_back(vertices.vertexSize(), 0);
             }
 
             // this geometry will be of the Point type, and we'll derive
@@ -78,20 +174,18 @@ void CircleBucket::addFeature(const GeometryTileFeature& feature,
 
             auto& segment = segments.back();
             assert(segment.vertexLength <= std::numeric_limits<uint16_t>::max());
-            uint16_t index = segment.vertexLength;
-
-            // 1, 2, 3
-            // 1, 4, 3
-            triangles.emplace_back(index, index + 1, index + 2);
-            triangles.emplace_back(index, index + 3, index + 2);
 
+            // The (1, 2, 3 / 1, 4, 3) triangles for this quad come from the
+            // shared index pattern.
             segment.vertexLength += vertexLength;
             segment.indexLength += 6;
         }
     }
 
-    for (auto& pair : paintPropertyBinders) {
-        pair.second.populateVertexVectors(feature, vertices.vertexSize());
+    if (!aggregated) {
+        for (auto& pair : paintPropertyBinders) {
+            pair.second.populateVertexVectors(feature, vertices.vertexSize());
+        }
     }
 }
 
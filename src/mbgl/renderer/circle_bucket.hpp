@@ -6,8 +6,11 @@
 #include <mbgl/gl/vertex_buffer.hpp>
 #include <mbgl/gl/index_buffer.hpp>
 #include <mbgl/gl/segment.hpp>
+#include <mbgl/gl/texture.hpp>
 #include <mbgl/programs/circle_program.hpp>
 #include <mbgl/style/layers/circle_layer_properties.hpp>
+#include <mbgl/util/color.hpp>
+#include <mbgl/util/image.hpp>
 
 namespace mbgl {
 
@@ -23,19 +26,55 @@ public:
                     const GeometryCollection&) override;
     bool hasData() const override;
 
+    void commit() override;
+
     void upload(gl::Context&) override;
+    std::size_t uploadByteSize() const override;
     void render(Painter&, PaintParameters&, const style::Layer&, const RenderTile&) override;
 
+    // Whether the bucket gave up on per-point quads and binned its points
+    // into a density grid instead; see aggregationThreshold.
+    bool isAggregated() const { return aggregated; }
+
+    // No per-bucket index data: every circle is four consecutive vertices,
+    // so all buckets draw through the shared quad index pattern in
+    // Painter::quadTriangleIndexBuffer, with each segment starting at index
+    // offset zero.
     gl::VertexVector<CircleLayoutVertex> vertices;
-    gl::IndexVector<gl::Triangles> triangles;
     gl::SegmentVector<CircleAttributes> segments;
 
     optional<gl::VertexBuffer<CircleLayoutVertex>> vertexBuffer;
-    optional<gl::IndexBuffer<gl::Triangles>> indexBuffer;
 
     std::unordered_map<std::string, CircleProgram::PaintPropertyBinders> paintPropertyBinders;
 
+    // Aggregated mode: per-tile point density colorized with the layer's
+    // constant circle color at commit(), rendered as one textured quad.
+    PremultipliedImage density;
+    optional<gl::Texture> densityTexture;
+
     const MapMode mode;
+
+private:
+    void switchToAggregation();
+    void binPoint(const GeometryCoordinate&);
+
+    // Four vertices per point stop scaling somewhere in the hundreds of
+    // thousands of points per tile, so beyond this count the bucket bins
+    // points into a density grid and draws a single quad — a constant-cost
+    // frame no matter how many points the tile holds. Only buckets without
+    // data-driven paint may switch, since per-feature styling cannot survive
+    // aggregation.
+    static constexpr std::size_t aggregationThreshold = 100000;
+    static constexpr uint32_t densityGridSize = 256;
+
+    const bool mayAggregate;
+    bool aggregated = false;
+    Color aggregationColor;
+
+    // Points seen so far, kept until the threshold decides between quads and
+    // binning; discarded as soon as the decision falls.
+    std::vector<GeometryCoordinate> pendingPoints;
+    std::vector<float> densityGrid;
 };
 
 } // namespace mbgl
@@ -27,7 +27,8 @@ using namespace style;
 
 struct GeometryTooLongException : std::exception {};
 
-FillBucket::FillBucket(const BucketParameters& parameters, const std::vector<const Layer*>& layers) {
+FillBucket::FillBucket(const BucketParameters& parameters, const std::vector<const Layer*>& layers)
+    : obsolete(parameters.obsolete) {
     for (const auto& layer : layers) {
         paintPropertyBinders.emplace(layer->getID(),
             FillProgram::PaintPropertyBinders(
@@ -39,6 +40,14 @@ FillBucket::FillBucket(const BucketParameters& parameters, const std::vector<con
 void FillBucket::addFeature(const GeometryTileFeature& feature,
                             const GeometryCollection& geometry) {
     for (auto& polygon : classifyRings(geometry)) {
+        // Multipolygon features (large water or landuse fills) can carry
+        // hundreds of rings; stop tessellating between polygons once the tile
+        // has been dropped. Partially filled buffers are never rendered or
+        // cached once `obsolete` is set.
+        if (obsolete) {
+            return;
+        }
+
         // Optimize polygons with many interior rings for earcut tesselation.
         limitHoles(polygon, 500);
 
@@ -78,7 +87,13 @@ void FillBucket::addFeature(const GeometryTileFeature& feature,
             lineSegment.indexLength += nVertices * 2;
         }
 
-        std::vector<uint32_t> indices = mapbox::earcut(polygon);
+        // Reuse one tessellator per worker thread: earcut's internal node pool
+        // then keeps its allocations across the thousands of polygons in a
+        // landuse or building tile instead of allocating and freeing per
+        // polygon, which dominates layout time on those tiles.
+        static thread_local mapbox::detail::Earcut<uint32_t> tessellator;
+        tessellator(polygon);
+        const std::vector<uint32_t>& indices = tessellator.indices;
 
         std::size_t nIndicies = indices.size();
         assert(nIndicies % 3 == 0);
@@ -106,6 +121,22 @@ void FillBucket::addFeature(const GeometryTileFeature& feature,
     }
 }
 
+void FillBucket::commit() {
+    vertices.shrinkToFit();
+    lines.shrinkToFit();
+    triangles.shrinkToFit();
+    lineSegments.shrink_to_fit();
+    triangleSegments.shrink_to_fit();
+
+    for (auto& pair : paintPropertyBinders) {
+        pair.second.shrinkToFit();
+    }
+}
+
+std::size_t FillBucket::uploadByteSize() const {
+    return vertices.byteSize() + lines.byteSize() + triangles.byteSize();
+}
+
 void FillBucket::upload(gl::Context& context) {
     vertexBuffer = context.createVertexBuffer(std::move(vertices));
     lineIndexBuffer = context.createIndexBuffer(std::move(lines));
@@ -8,6 +8,7 @@
 #include <mbgl/programs/fill_program.hpp>
 #include <mbgl/style/layers/fill_layer_properties.hpp>
 
+#include <atomic>
 #include <vector>
 
 namespace mbgl {
@@ -24,7 +25,10 @@ public:
                     const GeometryCollection&) override;
     bool hasData() const override;
 
+    void commit() override;
+
     void upload(gl::Context&) override;
+    std::size_t uploadByteSize() const override;
     void render(Painter&, PaintParameters&, const style::Layer&, const RenderTile&) override;
 
     gl::VertexVector<FillLayoutVertex> vertices;
@@ -38,6 +42,11 @@ public:
     optional<gl::IndexBuffer<gl::Triangles>> triangleIndexBuffer;
 
     std::unordered_map<std::string, FillProgram::PaintPropertyBinders> paintPropertyBinders;
+
+private:
+    // Tile cancellation flag, polled between polygons in addFeature so a
+    // dropped tile stops tessellating promptly.
+    const std::atomic<bool>& obsolete;
 };
 
 } // namespace mbgl
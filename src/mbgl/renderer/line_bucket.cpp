@@ -8,14 +8,79 @@
 
 #include <cassert>
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
 namespace mbgl {
 
 using namespace style;
 
+namespace {
+
+/*
+    Computes the unit normal of every segment (coordinates[i] -> coordinates[i + 1])
+    in one batch pass, so the join-handling loop in addGeometry can consume
+    precomputed values instead of doing the perp/unit math point-by-point.
+    The arithmetic is done two segments at a time with SSE2 or NEON where the
+    target supports double-precision vectors, with a scalar tail/fallback that
+    produces bit-identical results (perp(unit(d)) == (-d.y, d.x) / |d|).
+    Segments of length zero yield undefined normals, as before; the consumer
+    skips duplicate coordinate pairs and never reads them.
+*/
+void computeSegmentNormals(const GeometryCoordinates& coordinates,
+                           std::size_t len,
+                           std::vector<Point<double>>& normals) {
+    normals.resize(len > 0 ? len - 1 : 0);
+
+    std::size_t i = 0;
+
+#if defined(__SSE2__) || (defined(__aarch64__) && defined(__ARM_NEON))
+    for (; i + 1 < normals.size(); i += 2) {
+        const double d[4] = {
+            double(coordinates[i + 1].x - coordinates[i].x),
+            double(coordinates[i + 2].x - coordinates[i + 1].x),
+            double(coordinates[i + 1].y - coordinates[i].y),
+            double(coordinates[i + 2].y - coordinates[i + 1].y),
+        };
+
+        double nx[2];
+        double ny[2];
+
+#if defined(__SSE2__)
+        const __m128d dx = _mm_loadu_pd(&d[0]);
+        const __m128d dy = _mm_loadu_pd(&d[2]);
+        const __m128d mag =
+            _mm_sqrt_pd(_mm_add_pd(_mm_mul_pd(dx, dx), _mm_mul_pd(dy, dy)));
+        _mm_storeu_pd(nx, _mm_div_pd(_mm_sub_pd(_mm_setzero_pd(), dy), mag));
+        _mm_storeu_pd(ny, _mm_div_pd(dx, mag));
+#else
+        const float64x2_t dx = vld1q_f64(&d[0]);
+        const float64x2_t dy = vld1q_f64(&d[2]);
+        const float64x2_t mag = vsqrtq_f64(vfmaq_f64(vmulq_f64(dx, dx), dy, dy));
+        vst1q_f64(nx, vdivq_f64(vnegq_f64(dy), mag));
+        vst1q_f64(ny, vdivq_f64(dx, mag));
+#endif
+
+        normals[i] = { nx[0], ny[0] };
+        normals[i + 1] = { nx[1], ny[1] };
+    }
+#endif
+
+    for (; i < normals.size(); ++i) {
+        normals[i] = util::perp(util::unit(convertPoint<double>(coordinates[i + 1] - coordinates[i])));
+    }
+}
+
+} // namespace
+
 LineBucket::LineBucket(const BucketParameters& parameters,
                        const std::vector<const Layer*>& layers,
                        const style::LineLayoutProperties& layout_)
     : layout(layout_.evaluate(PropertyEvaluationParameters(parameters.tileID.overscaledZ))),
+      obsolete(parameters.obsolete),
       overscaling(parameters.tileID.overscaleFactor()) {
     for (const auto& layer : layers) {
         paintPropertyBinders.emplace(layer->getID(),
@@ -103,15 +168,24 @@ void LineBucket::addGeometry(const GeometryCoordinates& coordinates) {
     // the last three vertices added
     e1 = e2 = e3 = -1;
 
+    computeSegmentNormals(coordinates, len, normalScratch);
+
     if (closed) {
         currentCoordinate = coordinates[len - 2];
-        nextNormal = util::perp(util::unit(convertPoint<double>(firstCoordinate - *currentCoordinate)));
+        nextNormal = normalScratch[len - 2];
     }
 
     const std::size_t startVertex = vertices.vertexSize();
     std::vector<TriangleElement> triangleStore;
 
     for (std::size_t i = 0; i < len; ++i) {
+        // A single motorway or coastline can run to thousands of vertices;
+        // bail out mid-line once the tile has been dropped. The partially
+        // built buffers are never rendered or cached once `obsolete` is set.
+        if (obsolete) {
+            return;
+        }
+
         if (closed && i == len - 1) {
             // if the line is closed, we treat the last vertex like the first
             nextCoordinate = coordinates[1];
@@ -139,9 +213,13 @@ void LineBucket::addGeometry(const GeometryCoordinates& coordinates) {
 
         // Calculate the normal towards the next vertex in this line. In case
         // there is no next vertex, pretend that the line is continuing straight,
-        // meaning that we are just using the previous normal.
-        nextNormal = nextCoordinate ? util::perp(util::unit(convertPoint<double>(*nextCoordinate - *currentCoordinate)))
-                                : prevNormal;
+        // meaning that we are just using the previous normal. The segment
+        // normals were precomputed in a batch; the closed-line wraparound
+        // segment (last -> second) coincides with the first segment because
+        // the first and last coordinates are equal.
+        nextNormal = nextCoordinate
+                         ? (closed && i == len - 1 ? normalScratch[0] : normalScratch[i])
+                         : prevNormal;
 
         // If we still don't have a previous normal, this is the beginning of a
         // non-closed line, so we're doing a straight "join".
@@ -444,6 +522,20 @@ void LineBucket::addPieSliceVertex(const GeometryCoordinate& currentVertex,
     }
 }
 
+void LineBucket::commit() {
+    vertices.shrinkToFit();
+    triangles.shrinkToFit();
+    segments.shrink_to_fit();
+
+    for (auto& pair : paintPropertyBinders) {
+        pair.second.shrinkToFit();
+    }
+}
+
+std::size_t LineBucket::uploadByteSize() const {
+    return vertices.byteSize() + triangles.byteSize();
+}
+
 void LineBucket::upload(gl::Context& context) {
     vertexBuffer = context.createVertexBuffer(std::move(vertices));
     indexBuffer = context.createIndexBuffer(std::move(triangles));
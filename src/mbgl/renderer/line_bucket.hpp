@@ -8,6 +8,7 @@
 #include <mbgl/programs/line_program.hpp>
 #include <mbgl/style/layers/line_layer_properties.hpp>
 
+#include <atomic>
 #include <vector>
 
 namespace mbgl {
@@ -26,7 +27,10 @@ public:
                     const GeometryCollection&) override;
     bool hasData() const override;
 
+    void commit() override;
+
     void upload(gl::Context&) override;
+    std::size_t uploadByteSize() const override;
     void render(Painter&, PaintParameters&, const style::Layer&, const RenderTile&) override;
 
     style::LineLayoutProperties::Evaluated layout;
@@ -58,6 +62,15 @@ private:
     std::ptrdiff_t e2;
     std::ptrdiff_t e3;
 
+    // Per-segment unit normals for the line currently being tessellated,
+    // filled in one batch pass at the start of addGeometry. Kept as a member
+    // so consecutive lines reuse the allocation.
+    std::vector<Point<double>> normalScratch;
+
+    // Tile cancellation flag, polled inside the per-vertex loop of
+    // addGeometry so a dropped tile abandons tessellation promptly.
+    const std::atomic<bool>& obsolete;
+
     const uint32_t overscaling;
 };
 
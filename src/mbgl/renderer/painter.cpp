@@ -8,14 +8,21 @@
 #include <mbgl/map/view.hpp>
 
 #include <mbgl/util/logging.hpp>
+#include <mbgl/util/projection.hpp>
 #include <mbgl/gl/debugging.hpp>
 
 #include <mbgl/style/style.hpp>
 #include <mbgl/style/layer_impl.hpp>
 
 #include <mbgl/style/layers/background_layer.hpp>
+#include <mbgl/style/layers/circle_layer.hpp>
 #include <mbgl/style/layers/custom_layer.hpp>
 #include <mbgl/style/layers/custom_layer_impl.hpp>
+#include <mbgl/style/layers/fill_layer.hpp>
+#include <mbgl/style/layers/fill_extrusion_layer.hpp>
+#include <mbgl/style/layers/line_layer.hpp>
+#include <mbgl/style/layers/raster_layer.hpp>
+#include <mbgl/style/layers/symbol_layer.hpp>
 
 #include <mbgl/sprite/sprite_atlas.hpp>
 #include <mbgl/geometry/line_atlas.hpp>
@@ -29,19 +36,36 @@
 
 #include <mbgl/util/constants.hpp>
 #include <mbgl/util/mat3.hpp>
+#include <mbgl/util/premultiply.hpp>
 #include <mbgl/util/string.hpp>
+#include <mbgl/util/tracing.hpp>
 
 #include <mbgl/util/offscreen_texture.hpp>
 
 #include <cassert>
 #include <algorithm>
 #include <iostream>
+#include <limits>
 #include <unordered_set>
 
 namespace mbgl {
 
 using namespace style;
 
+// Sort key for grouping draws that go through the same program. Layers of the
+// same type share a program (modulo overdraw variants), so the type is a
+// sufficient proxy.
+static uint8_t programGroup(const style::Layer& layer) {
+    if (layer.is<FillLayer>()) return 0;
+    if (layer.is<FillExtrusionLayer>()) return 1;
+    if (layer.is<LineLayer>()) return 2;
+    if (layer.is<CircleLayer>()) return 3;
+    if (layer.is<SymbolLayer>()) return 4;
+    if (layer.is<RasterLayer>()) return 5;
+    if (layer.is<BackgroundLayer>()) return 6;
+    return 7;
+}
+
 static gl::VertexVector<FillLayoutVertex> tileVertices() {
     gl::VertexVector<FillLayoutVertex> result;
     result.emplace_back(FillProgram::layoutVertex({ 0,            0 }));
@@ -68,6 +92,21 @@ static gl::IndexVector<gl::LineStrip> tileLineStripIndices() {
     return result;
 }
 
+static gl::IndexVector<gl::Triangles> quadTriangleIndices() {
+    // The (0,1,2 / 0,3,2)-per-four-vertices pattern shared by every circle
+    // bucket, sized for the largest segment a bucket can emit (segments split
+    // at 65535 vertices; see CircleBucket::addFeature). Building it once here
+    // replaces the 12 bytes of indices per circle each bucket used to build
+    // and upload itself.
+    gl::IndexVector<gl::Triangles> result;
+    for (uint32_t i = 0; i < std::numeric_limits<uint16_t>::max() / 4; ++i) {
+        const uint16_t index = i * 4;
+        result.emplace_back(index, index + 1, index + 2);
+        result.emplace_back(index, index + 3, index + 2);
+    }
+    return result;
+}
+
 static gl::VertexVector<RasterLayoutVertex> rasterVertices() {
     gl::VertexVector<RasterLayoutVertex> result;
     result.emplace_back(RasterProgram::layoutVertex({ 0, 0 }, { 0, 0 }));
@@ -77,13 +116,17 @@ static gl::VertexVector<RasterLayoutVertex> rasterVertices() {
     return result;
 }
 
-Painter::Painter(gl::Context& context_, const TransformState& state_, float pixelRatio)
+Painter::Painter(gl::Context& context_,
+                 const TransformState& state_,
+                 float pixelRatio,
+                 const optional<std::string>& programCacheDir)
     : context(context_),
       state(state_),
       tileVertexBuffer(context.createVertexBuffer(tileVertices())),
       rasterVertexBuffer(context.createVertexBuffer(rasterVertices())),
       tileTriangleIndexBuffer(context.createIndexBuffer(tileTriangleIndices())),
-      tileBorderIndexBuffer(context.createIndexBuffer(tileLineStripIndices())) {
+      tileBorderIndexBuffer(context.createIndexBuffer(tileLineStripIndices())),
+      quadTriangleIndexBuffer(context.createIndexBuffer(quadTriangleIndices())) {
 
     tileTriangleSegments.emplace_back(0, 0, 4, 6);
     tileBorderSegments.emplace_back(0, 0, 4, 5);
@@ -91,11 +134,11 @@ Painter::Painter(gl::Context& context_, const TransformState& state_, float pixe
 
     gl::debugging::enable();
 
-    ProgramParameters programParameters{ pixelRatio, false };
+    ProgramParameters programParameters{ pixelRatio, false, programCacheDir };
     programs = std::make_unique<Programs>(context, programParameters);
 #ifndef NDEBUG
 
-    ProgramParameters programParametersOverdraw{ pixelRatio, true };
+    ProgramParameters programParametersOverdraw{ pixelRatio, true, programCacheDir };
     overdrawPrograms = std::make_unique<Programs>(context, programParametersOverdraw);
 #endif
 }
@@ -103,19 +146,54 @@ Painter::Painter(gl::Context& context_, const TransformState& state_, float pixe
 Painter::~Painter() = default;
 
 bool Painter::needsAnimation() const {
-    return frameHistory.needsAnimation(util::DEFAULT_FADE_DURATION);
+    return frameHistory.needsAnimation(fadeDuration);
 }
 
 void Painter::cleanup() {
     context.performCleanup();
 }
 
+void Painter::onLowMemory() {
+    context.performLowMemoryCleanup();
+}
+
+// Overdraw inspection programs are deliberately left cold; they're only used
+// when overdraw debugging is toggled on.
+void Painter::precompilePrograms(const Style& style) {
+    programs->precompile(style);
+}
+
+void Painter::precompilePrograms(const std::vector<std::string>& layerTypes) {
+    programs->precompile(layerTypes);
+}
+
+void Painter::setPlaceholder(PremultipliedImage&& image, const LatLngBounds& bounds) {
+    // The raster program samples unassociated alpha, like raster tiles do.
+    placeholderImage = util::unpremultiply(std::move(image));
+    placeholderBounds = bounds;
+    placeholderTexture = {};
+}
+
+void Painter::clearPlaceholder() {
+    placeholderImage = {};
+    placeholderTexture = {};
+}
+
+bool Painter::hasPlaceholder() const {
+    return placeholderImage.valid() || placeholderTexture;
+}
+
 void Painter::render(const Style& style, const FrameData& frame_, View& view, SpriteAtlas& annotationSpriteAtlas) {
+    MBGL_TRACE_SPAN("render", "frame");
+
     frame = frame_;
     if (frame.contextMode == GLContextMode::Shared) {
         context.setDirtyState();
     }
 
+    stats = RenderingStats();
+    context.stats.reset();
+
     PaintParameters parameters {
 #ifndef NDEBUG
         paintMode() == PaintMode::Overdraw ? *overdrawPrograms : *programs,
@@ -135,6 +213,7 @@ void Painter::render(const Style& style, const FrameData& frame_, View& view, Sp
 
     // Update the default matrices to the current viewport dimensions.
     state.getProjMatrix(projMatrix);
+    tileMatrixCache.clear();
 
     pixelsToGLUnits = {{ 2.0f  / state.getSize().width, -2.0f / state.getSize().height }};
     if (state.getViewportMode() == ViewportMode::FlippedY) {
@@ -142,13 +221,15 @@ void Painter::render(const Style& style, const FrameData& frame_, View& view, Sp
     }
 
     frameHistory.record(frame.timePoint, state.getZoom(),
-        frame.mapMode == MapMode::Continuous ? util::DEFAULT_FADE_DURATION : Milliseconds(0));
+        frame.mapMode == MapMode::Continuous ? fadeDuration : Milliseconds(0));
 
 
     // - UPLOAD PASS -------------------------------------------------------------------------------
     // Uploads all required buffers and images before we do any actual rendering.
     {
         MBGL_DEBUG_GROUP("upload");
+        MBGL_TRACE_SPAN("render", "upload");
+        const TimePoint uploadStart = Clock::now();
 
         spriteAtlas->upload(context, 0);
 
@@ -157,11 +238,38 @@ void Painter::render(const Style& style, const FrameData& frame_, View& view, Sp
         frameHistory.upload(context, 0);
         annotationSpriteAtlas.upload(context, 0);
 
+        // Budget bucket uploads per frame in continuous mode: when a burst of
+        // tiles finishes layout at once, uploading all of them synchronously
+        // stalls a single frame. Buckets beyond the budget stay pending, the
+        // render passes below skip them, and they are picked up on subsequent
+        // frames. At least one bucket is always uploaded so progress is
+        // guaranteed, and still-mode renders produce exactly one frame, so
+        // they upload everything. Deferring a bucket can briefly show the
+        // retained parent or nothing where that tile would draw, which is why
+        // the budget errs on the generous side.
+        static const std::size_t uploadByteBudget = 8 * 1024 * 1024;
+        std::size_t uploadedBytes = 0;
+        bool uploadedAny = false;
         for (const auto& item : order) {
             if (item.bucket && item.bucket->needsUpload()) {
-                item.bucket->upload(context);
+                const std::size_t byteSize = item.bucket->uploadByteSize();
+                if (frame.mapMode == MapMode::Continuous && uploadedAny &&
+                    uploadedBytes + byteSize > uploadByteBudget) {
+                    continue;
+                }
+                {
+                    MBGL_TRACE_SPAN_ID("render", "bucket upload",
+                                       util::Tracing::Active() && item.tile
+                                           ? util::toString(item.tile->tile.id)
+                                           : std::string());
+                    item.bucket->upload(context);
+                }
+                uploadedBytes += byteSize;
+                uploadedAny = true;
             }
         }
+
+        stats.uploadTime = Clock::now() - uploadStart;
     }
 
     // - CLEAR -------------------------------------------------------------------------------------
@@ -181,19 +289,65 @@ void Painter::render(const Style& style, const FrameData& frame_, View& view, Sp
     // Draws the clipping masks to the stencil buffer.
     {
         MBGL_DEBUG_GROUP("clip");
+        MBGL_TRACE_SPAN("render", "clip");
+        const TimePoint clipStart = Clock::now();
 
-        // Update all clipping IDs.
-        algorithm::ClipIDGenerator generator;
+        // Tile matrices depend on the camera and are refreshed every frame.
         for (const auto& source : sources) {
-            source->baseImpl->startRender(generator, projMatrix, state);
+            source->baseImpl->startRender(projMatrix, state);
+        }
+
+        // The clip ID assignment, in contrast, only depends on the renderable
+        // tile sets; regenerate it only when they changed since the previous
+        // frame. The masks themselves are still drawn every frame: the
+        // backend owns the default framebuffer, and swapping leaves the
+        // stencil attachment's contents undefined.
+        const auto captureTileSet = [&] {
+            ClippedTileSet set;
+            for (const auto& source : sources) {
+                for (auto& pair : source->baseImpl->getRenderTiles()) {
+                    set.emplace_back(source, pair.first, pair.second.used, pair.second.clip);
+                }
+            }
+            return set;
+        };
+
+        ClippedTileSet tileSet = captureTileSet();
+        if (tileSet != renderedTileSet) {
+            algorithm::ClipIDGenerator generator;
+            for (const auto& source : sources) {
+                source->baseImpl->updateClipIDs(generator);
+            }
+            renderedStencils = generator.getStencils();
+            // Generating assigns fresh clip IDs to the render tiles, so the
+            // set describing this frame has to be captured again.
+            renderedTileSet = captureTileSet();
         }
 
         MBGL_DEBUG_GROUP("clipping masks");
 
-        for (const auto& stencil : generator.getStencils()) {
+        const auto& stencils = renderedStencils;
+        for (const auto& stencil : stencils) {
             MBGL_DEBUG_GROUP(std::string{ "mask: " } + util::toString(stencil.first));
             renderClippingMask(stencil.first, stencil.second);
         }
+
+        // Mark render tiles whose stencil region is entirely covered by
+        // children. getStencils() already drops them from the mask pass above,
+        // so their stencil reference can never match the buffer and clipped
+        // draws from them would be rasterized only to fail the test. The draw
+        // lists below skip them outright (except for symbol layers, which
+        // render without stencil clipping).
+        for (const auto& source : sources) {
+            for (auto& pair : source->baseImpl->getRenderTiles()) {
+                RenderTile& renderTile = pair.second;
+                renderTile.covered = renderTile.used &&
+                                     renderTile.clip.mask.any() &&
+                                     stencils.find(pair.first) == stencils.end();
+            }
+        }
+
+        stats.clipTime = Clock::now() - clipStart;
     }
 
 #if not MBGL_USE_GLES2 and not defined(NDEBUG)
@@ -211,20 +365,100 @@ void Painter::render(const Style& style, const FrameData& frame_, View& view, Sp
 
     // - OPAQUE PASS -------------------------------------------------------------------------------
     // Render everything top-to-bottom by using reverse iterators. Render opaque objects first.
-    renderPass(parameters,
-               RenderPass::Opaque,
-               order.rbegin(), order.rend(),
-               0, 1);
+    // Draws are grouped by program while keeping the top-to-bottom (i.e. front-to-back) order
+    // within each group: this pass writes unblended color and the per-layer depth ranges make the
+    // closest fragment win regardless of draw order, so sorting across layers is safe and avoids
+    // program and paint state switches between interleaved layer types.
+    skippedCoveredTileDraws = 0;
+    const TimePoint opaqueStart = Clock::now();
+
+    // Within a program group, draw near tiles first: opaque fragments win by
+    // depth regardless of order, so front-to-back lets early-Z reject far
+    // tiles' fragments before shading — which is where fill-bound tiler GPUs
+    // spend their time when the map is pitched.
+    const Point<double> cameraWorld =
+        Projection::project(state.getLatLng(LatLng::Unwrapped), state.getScale());
+    const auto distanceFromCamera = [&](const RenderTile* renderTile) {
+        if (!renderTile) {
+            return 0.0;
+        }
+        const double tilesAtZoom = 1 << renderTile->id.canonical.z;
+        const double size = Projection::worldSize(state.getScale()) / tilesAtZoom;
+        const double dx =
+            (renderTile->id.canonical.x + renderTile->id.wrap * tilesAtZoom + 0.5) * size - cameraWorld.x;
+        const double dy = (renderTile->id.canonical.y + 0.5) * size - cameraWorld.y;
+        return dx * dx + dy * dy;
+    };
+
+    std::vector<PassItem> opaqueItems;
+    opaqueItems.reserve(order.size());
+    {
+        uint32_t i = 0;
+        for (auto it = order.rbegin(); it != order.rend(); ++it, ++i) {
+            // Buckets whose upload was deferred by the byte budget can't be
+            // drawn this frame.
+            if (it->bucket && it->bucket->needsUpload()) {
+                continue;
+            }
+            if (it->tile && it->tile->covered && !it->layer.is<SymbolLayer>()) {
+                ++skippedCoveredTileDraws;
+                continue;
+            }
+            if (it->layer.baseImpl->hasRenderPass(RenderPass::Opaque)) {
+                opaqueItems.push_back({ &*it, i, distanceFromCamera(it->tile) });
+            }
+        }
+    }
+    std::stable_sort(opaqueItems.begin(), opaqueItems.end(), [] (const PassItem& a, const PassItem& b) {
+        const uint8_t groupA = programGroup(a.item->layer);
+        const uint8_t groupB = programGroup(b.item->layer);
+        if (groupA != groupB) {
+            return groupA < groupB;
+        }
+        return a.tileDistance < b.tileDistance;
+    });
+    {
+        MBGL_TRACE_SPAN("render", "opaque");
+        renderPass(parameters, RenderPass::Opaque, opaqueItems);
+    }
+    stats.opaqueTime = Clock::now() - opaqueStart;
 
     // - TRANSLUCENT PASS --------------------------------------------------------------------------
     // Make a second pass, rendering translucent objects. This time, we render bottom-to-top.
-    renderPass(parameters,
-               RenderPass::Translucent,
-               order.begin(), order.end(),
-               static_cast<uint32_t>(order.size()) - 1, -1);
+    // Blending makes this pass order-dependent, so unlike the opaque pass it must not be sorted.
+    const TimePoint translucentStart = Clock::now();
+    std::vector<PassItem> translucentItems;
+    translucentItems.reserve(order.size());
+    {
+        uint32_t i = static_cast<uint32_t>(order.size()) - 1;
+        for (auto it = order.begin(); it != order.end(); ++it, --i) {
+            if (it->bucket && it->bucket->needsUpload()) {
+                continue;
+            }
+            if (it->tile && it->tile->covered && !it->layer.is<SymbolLayer>()) {
+                ++skippedCoveredTileDraws;
+                continue;
+            }
+            if (it->layer.baseImpl->hasRenderPass(RenderPass::Translucent)) {
+                translucentItems.push_back({ &*it, i, 0.0 });
+            }
+        }
+    }
+    {
+        MBGL_TRACE_SPAN("render", "translucent");
+        renderPass(parameters, RenderPass::Translucent, translucentItems);
+    }
+    stats.translucentTime = Clock::now() - translucentStart;
 
     if (debug::renderTree) { Log::Info(Event::Render, "}"); indent--; }
 
+    // - PLACEHOLDER -------------------------------------------------------------------------------
+    // While a pre-rendered snapshot is installed, draw it over the layers;
+    // the map owner clears it once the live style has fully loaded.
+    if (hasPlaceholder()) {
+        renderPlaceholder(parameters);
+    }
+
     // - DEBUG PASS --------------------------------------------------------------------------------
     // Renders debug overlays.
     {
@@ -245,6 +479,12 @@ void Painter::render(const Style& style, const FrameData& frame_, View& view, Sp
     }
 #endif
 
+    // Drawn last so the overlay sits on top of everything, including the
+    // other debug modes.
+    if (frame.debugOptions & MapDebugOptions::Overlay) {
+        renderHUD(renderData);
+    }
+
     // TODO: Find a better way to unbind VAOs after we're done with them without introducing
     // unnecessary bind(0)/bind(N) sequences.
     {
@@ -257,13 +497,20 @@ void Painter::render(const Style& style, const FrameData& frame_, View& view, Sp
 
         context.vertexArrayObject = 0;
     }
+
+    if (frame.debugOptions & MapDebugOptions::StateAudit) {
+        context.auditStateCache();
+    }
+
+    stats.drawCalls = context.stats.drawCalls;
+    stats.bufferUploads = context.stats.bufferUploads;
+    stats.textureBinds = context.stats.textureBinds;
+    stats.textureUploads = context.stats.textureUploads;
 }
 
-template <class Iterator>
 void Painter::renderPass(PaintParameters& parameters,
                          RenderPass pass_,
-                         Iterator it, Iterator end,
-                         uint32_t i, int8_t increment) {
+                         const std::vector<PassItem>& items) {
     pass = pass_;
 
     MBGL_DEBUG_GROUP(pass == RenderPass::Opaque ? "opaque" : "translucent");
@@ -273,33 +520,50 @@ void Painter::renderPass(PaintParameters& parameters,
                   pass == RenderPass::Opaque ? "opaque" : "translucent");
     }
 
-    for (; it != end; ++it, i += increment) {
-        currentLayer = i;
+    for (const auto& passItem : items) {
+        currentLayer = passItem.layerIndex;
 
-        const auto& item = *it;
+        const auto& item = *passItem.item;
         const Layer& layer = item.layer;
 
-        if (!layer.baseImpl->hasRenderPass(pass))
-            continue;
-
         if (layer.is<BackgroundLayer>()) {
             MBGL_DEBUG_GROUP("background");
             renderBackground(parameters, *layer.as<BackgroundLayer>());
         } else if (layer.is<CustomLayer>()) {
             MBGL_DEBUG_GROUP(layer.baseImpl->id + " - custom");
 
+            const CustomLayer::Impl& custom = *layer.as<CustomLayer>()->impl;
+
             // Reset GL state to a known state so the CustomLayer always has a clean slate.
             context.vertexArrayObject = 0;
             context.setDepthMode(depthModeForSublayer(0, gl::DepthMode::ReadOnly));
             context.setStencilMode(gl::StencilMode::disabled());
             context.setColorMode(colorModeForRenderPass());
 
-            layer.as<CustomLayer>()->impl->render(state);
+            custom.render(state);
+
+            // Invalidate only the state groups the layer declared it may
+            // touch (all of them by default); everything else in the cache
+            // stays valid, so a well-behaved custom layer costs no more
+            // state churn than a built-in one.
+            const CustomLayerStateMask mask = custom.stateMask;
 
-            // Reset the view back to our original one, just in case the CustomLayer changed
-            // the viewport or Framebuffer.
-            parameters.view.bind();
-            context.setDirtyState();
+            if (mask & CustomLayerStateMask::Viewport) {
+                // Reset the view back to our original one, in case the
+                // CustomLayer changed the viewport or framebuffer.
+                parameters.view.bind();
+            }
+
+            gl::Context::StateGroup dirty = gl::Context::StateGroup::None;
+            if (mask & CustomLayerStateMask::Stencil)  dirty |= gl::Context::StateGroup::Stencil;
+            if (mask & CustomLayerStateMask::Depth)    dirty |= gl::Context::StateGroup::Depth;
+            if (mask & CustomLayerStateMask::Blend)    dirty |= gl::Context::StateGroup::Blend;
+            if (mask & CustomLayerStateMask::Clear)    dirty |= gl::Context::StateGroup::Clear;
+            if (mask & CustomLayerStateMask::Program)  dirty |= gl::Context::StateGroup::Program;
+            if (mask & CustomLayerStateMask::Buffers)  dirty |= gl::Context::StateGroup::Buffers;
+            if (mask & CustomLayerStateMask::Textures) dirty |= gl::Context::StateGroup::Textures;
+            if (mask & CustomLayerStateMask::Other)    dirty |= gl::Context::StateGroup::Other;
+            context.setDirtyState(dirty);
         } else {
             MBGL_DEBUG_GROUP(layer.baseImpl->id + " - " + util::toString(item.tile->id));
             item.bucket->render(*this, parameters, layer, *item.tile);
@@ -312,9 +576,18 @@ void Painter::renderPass(PaintParameters& parameters,
 }
 
 mat4 Painter::matrixForTile(const UnwrappedTileID& tileID) {
+    // The result only depends on the camera, which is fixed for the duration
+    // of a frame, and the same tile ID comes through here repeatedly within
+    // one: once per clipping mask and once per tile quad of every background
+    // layer. The memo is cleared at the start of each frame.
+    auto it = tileMatrixCache.find(tileID);
+    if (it != tileMatrixCache.end()) {
+        return it->second;
+    }
+
     mat4 matrix;
-    state.matrixFor(matrix, tileID);
-    matrix::multiply(matrix, projMatrix, matrix);
+    matrix::multiply(matrix, projMatrix, state.tileTransform(tileID));
+    tileMatrixCache.emplace(tileID, matrix);
     return matrix;
 }
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <mbgl/map/transform_state.hpp>
+#include <mbgl/map/rendering_stats.hpp>
 
 #include <mbgl/tile/tile_id.hpp>
 
@@ -19,11 +20,13 @@
 #include <mbgl/util/noncopyable.hpp>
 #include <mbgl/util/chrono.hpp>
 #include <mbgl/util/constants.hpp>
+#include <mbgl/util/clip_id.hpp>
 
 #include <array>
 #include <vector>
 #include <set>
 #include <map>
+#include <tuple>
 
 namespace mbgl {
 
@@ -45,8 +48,6 @@ class RasterBucket;
 class Programs;
 class PaintParameters;
 
-struct ClipID;
-
 namespace style {
 class Style;
 class Source;
@@ -68,7 +69,10 @@ struct FrameData {
 
 class Painter : private util::noncopyable {
 public:
-    Painter(gl::Context&, const TransformState&, float pixelRatio);
+    Painter(gl::Context&,
+            const TransformState&,
+            float pixelRatio,
+            const optional<std::string>& programCacheDir = {});
     ~Painter();
 
     void render(const style::Style&,
@@ -78,8 +82,40 @@ public:
 
     void cleanup();
 
+    // Responds to a platform memory-pressure signal: deletes abandoned GL
+    // objects and drains the context's texture pool so their VRAM is
+    // returned to the driver.
+    void onLowMemory();
+
+    // Warms up the shader programs the style's layers will use; remaining
+    // programs are compiled lazily on first draw.
+    void precompilePrograms(const style::Style&);
+
+    // Same, but driven by recorded layer type names rather than a parsed
+    // style; see MapWarmupProfile.
+    void precompilePrograms(const std::vector<std::string>& layerTypes);
+
+    // A pre-rendered snapshot drawn over the frame, stretched across the
+    // given bounds, until it is cleared; see Map::setPlaceholderImage().
+    void setPlaceholder(PremultipliedImage&&, const LatLngBounds&);
+    void clearPlaceholder();
+    bool hasPlaceholder() const;
+
+    // Number of per-layer/tile draws skipped in the last frame because the
+    // tile's stencil region was fully covered by children. Exposed for
+    // verification.
+    uint32_t skippedCoveredTileDraws = 0;
+
+    // Health metrics for the last rendered frame: per-stage CPU timings and
+    // the gl::Context call counters.
+    RenderingStats stats;
+
     void renderClippingMask(const UnwrappedTileID&, const ClipID&);
     void renderTileDebug(const RenderTile&);
+    // Draws the frame-health overlay (MapDebugOptions::Overlay): frame time
+    // history, tile state counts, cache usage and GL call counters, rendered
+    // in screen space with the debug program.
+    void renderHUD(const RenderData&);
     void renderFill(PaintParameters&, FillBucket&, const style::FillLayer&, const RenderTile&);
     void renderLine(PaintParameters&, LineBucket&, const style::LineLayer&, const RenderTile&);
     void renderCircle(PaintParameters&, CircleBucket&, const style::CircleLayer&, const RenderTile&);
@@ -96,14 +132,31 @@ public:
 
     bool needsAnimation() const;
 
+    // Symbol fade duration for continuous-mode frames. The quality governor
+    // shortens or zeroes this under load; still renders always use zero.
+    Duration fadeDuration = util::DEFAULT_FADE_DURATION;
+
 private:
     std::vector<RenderItem> determineRenderOrder(const style::Style&);
 
-    template <class Iterator>
+    // One layer/tile draw within a render pass, tagged with the layer's
+    // position in the original render order so that the per-layer depth
+    // ranges stay correct when a pass is sorted for batching.
+    struct PassItem {
+        const RenderItem* item;
+        uint32_t layerIndex;
+        // Squared world distance from the camera to the item's tile center;
+        // the opaque pass sorts near tiles first within a program group so
+        // early-Z can reject far fragments. Zero for tile-less items and in
+        // the translucent pass, which must keep layer order.
+        double tileDistance;
+    };
+
     void renderPass(PaintParameters&,
                     RenderPass,
-                    Iterator it, Iterator end,
-                    uint32_t i, int8_t increment);
+                    const std::vector<PassItem>&);
+
+    void renderPlaceholder(PaintParameters&);
 
     mat4 matrixForTile(const UnwrappedTileID&);
     gl::DepthMode depthModeForSublayer(uint8_t n, gl::DepthMode::Mask) const;
@@ -151,6 +204,25 @@ private:
     GlyphAtlas* glyphAtlas = nullptr;
     LineAtlas* lineAtlas = nullptr;
 
+    // Everything the frame's clip ID assignment depends on: the sources in
+    // visitation order and, per renderable tile, its used flag and the clip
+    // it already carries. When this matches the previous frame — most frames
+    // in steady state, and every frame of a camera-only movement — the clip
+    // IDs on the render tiles are still valid and regeneration is skipped.
+    using ClippedTileSet =
+        std::vector<std::tuple<const style::Source*, UnwrappedTileID, bool, ClipID>>;
+    ClippedTileSet renderedTileSet;
+    std::map<UnwrappedTileID, ClipID> renderedStencils;
+
+    // Per-frame memo for matrixForTile(); see there.
+    std::map<UnwrappedTileID, mat4> tileMatrixCache;
+
+    // Frame interval history for the HUD graph (MapDebugOptions::Overlay),
+    // in milliseconds. Only sampled while the overlay is enabled.
+    std::array<float, 120> hudFrameTimes {{}};
+    std::size_t hudFrameTimeIndex = 0;
+    TimePoint hudPreviousFrameTime = TimePoint::min();
+
     FrameHistory frameHistory;
 
     std::unique_ptr<Programs> programs;
@@ -164,9 +236,19 @@ private:
     gl::IndexBuffer<gl::Triangles> tileTriangleIndexBuffer;
     gl::IndexBuffer<gl::LineStrip> tileBorderIndexBuffer;
 
+    // Quad index pattern shared by all circle buckets, which therefore carry
+    // no index data of their own.
+    gl::IndexBuffer<gl::Triangles> quadTriangleIndexBuffer;
+
     gl::SegmentVector<FillAttributes> tileTriangleSegments;
     gl::SegmentVector<DebugAttributes> tileBorderSegments;
     gl::SegmentVector<RasterAttributes> rasterSegments;
+
+    // Placeholder snapshot state; the image stages the pixels until the
+    // first frame uploads them.
+    UnassociatedImage placeholderImage;
+    optional<gl::Texture> placeholderTexture;
+    LatLngBounds placeholderBounds = LatLngBounds::world();
 };
 
 } // namespace mbgl
@@ -6,6 +6,8 @@
 #include <mbgl/style/layers/circle_layer_impl.hpp>
 #include <mbgl/programs/programs.hpp>
 #include <mbgl/programs/circle_program.hpp>
+#include <mbgl/programs/raster_program.hpp>
+#include <mbgl/style/layers/raster_layer_properties.hpp>
 #include <mbgl/gl/context.hpp>
 
 namespace mbgl {
@@ -21,9 +23,60 @@ void Painter::renderCircle(PaintParameters& parameters,
     }
 
     const CirclePaintProperties::Evaluated& properties = layer.impl->paint.evaluated;
+
+    if (bucket.isAggregated()) {
+        // Dense-point fallback: the bucket binned its points into a density
+        // texture (see CircleBucket::switchToAggregation), which draws as a
+        // single quad through the raster program with neutral color
+        // adjustments. The circle color is baked into the texture; opacity
+        // stays a live uniform.
+        assert(bucket.densityTexture);
+        context.bindTexture(*bucket.densityTexture, 0, gl::TextureFilter::Linear);
+        context.bindTexture(*bucket.densityTexture, 1, gl::TextureFilter::Linear);
+
+        static const RasterPaintProperties::Evaluated rasterProperties {};
+        static const RasterProgram::PaintPropertyBinders rasterPaintAttributeData(rasterProperties, 0);
+
+        parameters.programs.raster().draw(
+            context,
+            gl::Triangles(),
+            depthModeForSublayer(0, gl::DepthMode::ReadOnly),
+            frame.mapMode == MapMode::Still
+                ? stencilModeForClipping(tile.clip)
+                : gl::StencilMode::disabled(),
+            colorModeForRenderPass(),
+            RasterProgram::UniformValues {
+                uniforms::u_matrix::Value{
+                    tile.translatedMatrix(properties.get<CircleTranslate>(),
+                                          properties.get<CircleTranslateAnchor>(),
+                                          state)
+                },
+                uniforms::u_image0::Value{ 0 },
+                uniforms::u_image1::Value{ 1 },
+                uniforms::u_opacity::Value{ properties.get<CircleOpacity>().constantOr(1.0f) },
+                uniforms::u_fade_t::Value{ 1 },
+                uniforms::u_brightness_low::Value{ 0.0f },
+                uniforms::u_brightness_high::Value{ 1.0f },
+                uniforms::u_saturation_factor::Value{ 0.0f },
+                uniforms::u_contrast_factor::Value{ 1.0f },
+                uniforms::u_spin_weights::Value{ std::array<float, 3> {{ 1.0f, 0.0f, 0.0f }} },
+                uniforms::u_buffer_scale::Value{ 1.0f },
+                uniforms::u_scale_parent::Value{ 1.0f },
+                uniforms::u_tl_parent::Value{ std::array<float, 2> {{ 0.0f, 0.0f }} },
+            },
+            rasterVertexBuffer,
+            tileTriangleIndexBuffer,
+            rasterSegments,
+            rasterPaintAttributeData,
+            rasterProperties,
+            state.getZoom()
+        );
+        return;
+    }
+
     const bool scaleWithMap = properties.get<CirclePitchScale>() == CirclePitchScaleType::Map;
 
-    parameters.programs.circle.draw(
+    parameters.programs.circle(scaleWithMap).draw(
         context,
         gl::Triangles(),
         depthModeForSublayer(0, gl::DepthMode::ReadOnly),
@@ -37,7 +90,6 @@ void Painter::renderCircle(PaintParameters& parameters,
                                       properties.get<CircleTranslateAnchor>(),
                                       state)
             },
-            uniforms::u_scale_with_map::Value{ scaleWithMap },
             uniforms::u_extrude_scale::Value{ scaleWithMap
                 ? std::array<float, 2> {{
                     pixelsToGLUnits[0] * state.getCameraToCenterDistance(),
@@ -46,7 +98,7 @@ void Painter::renderCircle(PaintParameters& parameters,
                 : pixelsToGLUnits }
         },
         *bucket.vertexBuffer,
-        *bucket.indexBuffer,
+        quadTriangleIndexBuffer,
         bucket.segments,
         bucket.paintPropertyBinders.at(layer.getID()),
         properties,
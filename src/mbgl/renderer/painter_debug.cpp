@@ -3,12 +3,20 @@
 #include <mbgl/renderer/render_tile.hpp>
 #include <mbgl/renderer/paint_parameters.hpp>
 #include <mbgl/map/view.hpp>
+#include <mbgl/style/source.hpp>
+#include <mbgl/style/source_impl.hpp>
 #include <mbgl/tile/tile.hpp>
 #include <mbgl/programs/programs.hpp>
 #include <mbgl/programs/fill_program.hpp>
+#include <mbgl/geometry/debug_font_data.hpp>
 #include <mbgl/util/string.hpp>
 #include <mbgl/gl/debugging.hpp>
 #include <mbgl/util/color.hpp>
+#include <mbgl/util/mat4.hpp>
+#include <mbgl/util/memory_budget.hpp>
+
+#include <algorithm>
+#include <cmath>
 
 namespace mbgl {
 
@@ -24,7 +32,7 @@ void Painter::renderTileDebug(const RenderTile& renderTile) {
     static const DebugProgram::PaintPropertyBinders paintAttibuteData(properties, 0);
 
     auto draw = [&] (Color color, const auto& vertexBuffer, const auto& indexBuffer, const auto& segments, auto drawMode) {
-        programs->debug.draw(
+        programs->debug().draw(
             context,
             drawMode,
             gl::DepthMode::disabled(),
@@ -77,6 +85,191 @@ void Painter::renderTileDebug(const RenderTile& renderTile) {
     }
 }
 
+void Painter::renderHUD(const RenderData& renderData) {
+    MBGL_DEBUG_GROUP("hud");
+
+    const auto toMilliseconds = [] (Duration d) {
+        return std::chrono::duration_cast<std::chrono::duration<float, std::milli>>(d).count();
+    };
+
+    // Record the interval to the previous frame. The ring only fills while
+    // the overlay is enabled, so the graph starts out flat after toggling.
+    if (hudPreviousFrameTime != TimePoint::min()) {
+        hudFrameTimes[hudFrameTimeIndex] = toMilliseconds(frame.timePoint - hudPreviousFrameTime);
+        hudFrameTimeIndex = (hudFrameTimeIndex + 1) % hudFrameTimes.size();
+    }
+    hudPreviousFrameTime = frame.timePoint;
+
+    float lastInterval = hudFrameTimes[(hudFrameTimeIndex + hudFrameTimes.size() - 1) % hudFrameTimes.size()];
+    float maxInterval = 0;
+    float sumIntervals = 0;
+    std::size_t sampleCount = 0;
+    for (const float interval : hudFrameTimes) {
+        if (interval > 0) {
+            maxInterval = std::max(maxInterval, interval);
+            sumIntervals += interval;
+            sampleCount++;
+        }
+    }
+    const float avgInterval = sampleCount ? sumIntervals / sampleCount : 0.0f;
+
+    // Tile states across the frame's sources.
+    std::size_t completeTiles = 0;
+    std::size_t renderableTiles = 0;
+    std::size_t pendingTiles = 0;
+    for (const auto& source : renderData.sources) {
+        for (auto& pair : source->baseImpl->getRenderTiles()) {
+            const Tile& tile = pair.second.tile;
+            if (tile.isComplete()) {
+                completeTiles++;
+            } else if (tile.isRenderable()) {
+                renderableTiles++;
+            } else {
+                pendingTiles++;
+            }
+        }
+    }
+
+    const auto toFixed = [] (float value) {
+        const int64_t tenths = int64_t(::round(value * 10));
+        return util::toString(tenths / 10) + "." + util::toString(tenths % 10);
+    };
+
+    // The overlay's geometry is tiny and changes every frame, so it is
+    // rebuilt from scratch rather than cached like the tile debug buckets.
+    gl::VertexVector<FillLayoutVertex> vertices;
+    gl::IndexVector<gl::Lines> indices;
+
+    const auto addText = [&] (const std::string& text, double left, double baseline, double scale) {
+        for (uint8_t c : text) {
+            if (c < 32 || c >= 127)
+                continue;
+
+            optional<Point<int16_t>> prev;
+
+            const glyph& glyph = simplex[c - 32];
+            for (int32_t j = 0; j < glyph.length; j += 2) {
+                if (glyph.data[j] == -1 && glyph.data[j + 1] == -1) {
+                    prev = {};
+                } else {
+                    Point<int16_t> p {
+                        int16_t(::round(left + glyph.data[j] * scale)),
+                        int16_t(::round(baseline - glyph.data[j + 1] * scale))
+                    };
+
+                    vertices.emplace_back(FillProgram::layoutVertex(p));
+
+                    if (prev) {
+                        indices.emplace_back(vertices.vertexSize() - 2,
+                                             vertices.vertexSize() - 1);
+                    }
+
+                    prev = p;
+                }
+            }
+
+            left += glyph.width * scale;
+        }
+    };
+
+    const auto addSegment = [&] (Point<int16_t> a, Point<int16_t> b) {
+        vertices.emplace_back(FillProgram::layoutVertex(a));
+        vertices.emplace_back(FillProgram::layoutVertex(b));
+        indices.emplace_back(vertices.vertexSize() - 2, vertices.vertexSize() - 1);
+    };
+
+    // The stage timings are final by the time the debug pass runs; the GL
+    // call counters cover the frame so far, i.e. everything but the
+    // overlay's own draws.
+    double baseline = 20;
+    addText("frame " + toFixed(lastInterval) + "ms  avg " + toFixed(avgInterval) +
+            "  max " + toFixed(maxInterval), 8, baseline, 0.5);
+    baseline += 16;
+    addText("cpu  upload " + toFixed(toMilliseconds(stats.uploadTime)) +
+            "  clip " + toFixed(toMilliseconds(stats.clipTime)) +
+            "  opaque " + toFixed(toMilliseconds(stats.opaqueTime)) +
+            "  translucent " + toFixed(toMilliseconds(stats.translucentTime)) + "ms",
+            8, baseline, 0.5);
+    baseline += 16;
+    addText("tiles  " + util::toString(completeTiles) + " complete  " +
+            util::toString(renderableTiles) + " renderable  " +
+            util::toString(pendingTiles) + " pending", 8, baseline, 0.5);
+    baseline += 16;
+    addText("cache  " + toFixed(MemoryBudget::Usage() / (1024.0f * 1024.0f)) + " mb",
+            8, baseline, 0.5);
+    baseline += 16;
+    addText("gl  " + util::toString(context.stats.drawCalls) + " draws  " +
+            util::toString(context.stats.bufferUploads) + " buffer uploads  " +
+            util::toString(context.stats.textureBinds) + " texture binds",
+            8, baseline, 0.5);
+
+    // Frame time graph: one sample per frame, oldest to newest, with a
+    // reference line at the 60 fps budget. The vertical scale stretches to
+    // the worst sample in the window so spikes stay visible.
+    const float frameBudget = 1000.0f / 60.0f;
+    const float ceiling = std::max(2 * frameBudget, maxInterval);
+    const int16_t graphLeft = 8;
+    const int16_t graphTop = int16_t(baseline + 12);
+    const int16_t graphHeight = 48;
+    const int16_t sampleWidth = 2;
+
+    const auto sampleY = [&] (float interval) {
+        return int16_t(graphTop + graphHeight -
+                       ::round(std::min(interval, ceiling) / ceiling * graphHeight));
+    };
+
+    const int16_t graphRight =
+        int16_t(graphLeft + sampleWidth * (hudFrameTimes.size() - 1));
+    addSegment({ graphLeft, sampleY(frameBudget) }, { graphRight, sampleY(frameBudget) });
+
+    optional<Point<int16_t>> prev;
+    for (std::size_t i = 0; i < hudFrameTimes.size(); i++) {
+        const float interval = hudFrameTimes[(hudFrameTimeIndex + i) % hudFrameTimes.size()];
+        const Point<int16_t> p { int16_t(graphLeft + i * sampleWidth), sampleY(interval) };
+        if (prev) {
+            addSegment(*prev, p);
+        }
+        prev = p;
+    }
+
+    gl::SegmentVector<DebugAttributes> segments;
+    segments.emplace_back(0, 0, vertices.vertexSize(), indices.indexSize());
+    auto vertexBuffer = context.createVertexBuffer(std::move(vertices));
+    auto indexBuffer = context.createIndexBuffer(std::move(indices));
+
+    // Screen-space projection, in the same logical pixels the text was laid
+    // out in.
+    mat4 hudMatrix;
+    matrix::ortho(hudMatrix, 0, state.getSize().width, state.getSize().height, 0, 0, 1);
+
+    static const style::PaintProperties<>::Evaluated properties {};
+    static const DebugProgram::PaintPropertyBinders paintAttibuteData(properties, 0);
+
+    const auto draw = [&] (Color color, float lineWidth) {
+        programs->debug().draw(
+            context,
+            gl::Lines { lineWidth * frame.pixelRatio },
+            gl::DepthMode::disabled(),
+            gl::StencilMode::disabled(),
+            gl::ColorMode::unblended(),
+            DebugProgram::UniformValues {
+                uniforms::u_matrix::Value{ hudMatrix },
+                uniforms::u_color::Value{ color }
+            },
+            vertexBuffer,
+            indexBuffer,
+            segments,
+            paintAttibuteData,
+            properties,
+            state.getZoom()
+        );
+    };
+
+    // Halo pass first so the text stays readable over any map content.
+    draw(Color::black(), 4.0f);
+    draw(Color::white(), 2.0f);
+}
+
 #ifndef NDEBUG
 void Painter::renderClipMasks(PaintParameters&) {
     context.setStencilMode(gl::StencilMode::disabled());
@@ -67,7 +67,7 @@ void Painter::renderFill(PaintParameters& parameters,
         };
 
         draw(0,
-             parameters.programs.fillPattern,
+             parameters.programs.fillPattern(),
              gl::Triangles(),
              *bucket.triangleIndexBuffer,
              bucket.triangleSegments);
@@ -77,7 +77,7 @@ void Painter::renderFill(PaintParameters& parameters,
         }
 
         draw(2,
-             parameters.programs.fillOutlinePattern,
+             parameters.programs.fillOutlinePattern(),
              gl::Lines { 2.0f },
              *bucket.lineIndexBuffer,
              bucket.lineSegments);
@@ -112,7 +112,7 @@ void Painter::renderFill(PaintParameters& parameters,
 
         if (properties.get<FillAntialias>() && !layer.impl->paint.unevaluated.get<FillOutlineColor>().isUndefined() && pass == RenderPass::Translucent) {
             draw(2,
-                 parameters.programs.fillOutline,
+                 parameters.programs.fillOutline(),
                  gl::Lines { 2.0f },
                  *bucket.lineIndexBuffer,
                  bucket.lineSegments);
@@ -123,7 +123,7 @@ void Painter::renderFill(PaintParameters& parameters,
         if ((properties.get<FillColor>().constantOr(Color()).a >= 1.0f
           && properties.get<FillOpacity>().constantOr(0) >= 1.0f) == (pass == RenderPass::Opaque)) {
             draw(1,
-                 parameters.programs.fill,
+                 parameters.programs.fill(),
                  gl::Triangles(),
                  *bucket.triangleIndexBuffer,
                  bucket.triangleSegments);
@@ -131,7 +131,7 @@ void Painter::renderFill(PaintParameters& parameters,
 
         if (properties.get<FillAntialias>() && layer.impl->paint.unevaluated.get<FillOutlineColor>().isUndefined() && pass == RenderPass::Translucent) {
             draw(2,
-                 parameters.programs.fillOutline,
+                 parameters.programs.fillOutline(),
                  gl::Lines { 2.0f },
                  *bucket.lineIndexBuffer,
                  bucket.lineSegments);
@@ -48,7 +48,7 @@ void Painter::renderLine(PaintParameters& parameters,
 
         lineAtlas->bind(context, 0);
 
-        draw(parameters.programs.lineSDF,
+        draw(parameters.programs.lineSDF(),
              LineSDFProgram::uniformValues(
                  properties,
                  frame.pixelRatio,
@@ -71,7 +71,7 @@ void Painter::renderLine(PaintParameters& parameters,
 
         spriteAtlas->bind(true, context, 0);
 
-        draw(parameters.programs.linePattern,
+        draw(parameters.programs.linePattern(),
              LinePatternProgram::uniformValues(
                  properties,
                  tile,
@@ -81,7 +81,7 @@ void Painter::renderLine(PaintParameters& parameters,
                  *posB));
 
     } else {
-        draw(parameters.programs.line,
+        draw(parameters.programs.line(),
              LineProgram::uniformValues(
                  properties,
                  tile,
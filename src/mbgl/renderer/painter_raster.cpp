@@ -6,6 +6,7 @@
 #include <mbgl/style/layers/raster_layer_impl.hpp>
 #include <mbgl/programs/programs.hpp>
 #include <mbgl/programs/raster_program.hpp>
+#include <mbgl/gl/debugging.hpp>
 
 namespace mbgl {
 
@@ -39,6 +40,64 @@ static std::array<float, 3> spinWeights(float spin) {
     return spin_weights;
 }
 
+void Painter::renderPlaceholder(PaintParameters& parameters) {
+    MBGL_DEBUG_GROUP("placeholder");
+
+    if (!placeholderTexture) {
+        placeholderTexture = context.createTexture(std::move(placeholderImage));
+        placeholderImage = {};
+    }
+
+    static const RasterPaintProperties::Evaluated properties {};
+    static const RasterProgram::PaintPropertyBinders paintAttributeData(properties, 0);
+
+    context.bindTexture(*placeholderTexture, 0, gl::TextureFilter::Linear);
+    context.bindTexture(*placeholderTexture, 1, gl::TextureFilter::Linear);
+
+    // Stretch the unit tile quad over the bounds' world-space rectangle, so
+    // the snapshot tracks the camera like the tiles it stands in for.
+    const Point<double> nw =
+        Projection::project(placeholderBounds.northwest(), state.getScale());
+    const Point<double> se =
+        Projection::project(placeholderBounds.southeast(), state.getScale());
+
+    mat4 matrix;
+    matrix::multiply(matrix, projMatrix,
+                     aff2 {{ (se.x - nw.x) / util::EXTENT,
+                             (se.y - nw.y) / util::EXTENT,
+                             nw.x,
+                             nw.y }});
+
+    parameters.programs.raster().draw(
+        context,
+        gl::Triangles(),
+        gl::DepthMode::disabled(),
+        gl::StencilMode::disabled(),
+        gl::ColorMode::alphaBlended(),
+        RasterProgram::UniformValues {
+            uniforms::u_matrix::Value{ matrix },
+            uniforms::u_image0::Value{ 0 },
+            uniforms::u_image1::Value{ 1 },
+            uniforms::u_opacity::Value{ 1.0f },
+            uniforms::u_fade_t::Value{ 1 },
+            uniforms::u_brightness_low::Value{ properties.get<RasterBrightnessMin>() },
+            uniforms::u_brightness_high::Value{ properties.get<RasterBrightnessMax>() },
+            uniforms::u_saturation_factor::Value{ saturationFactor(properties.get<RasterSaturation>()) },
+            uniforms::u_contrast_factor::Value{ contrastFactor(properties.get<RasterContrast>()) },
+            uniforms::u_spin_weights::Value{ spinWeights(properties.get<RasterHueRotate>()) },
+            uniforms::u_buffer_scale::Value{ 1.0f },
+            uniforms::u_scale_parent::Value{ 1.0f },
+            uniforms::u_tl_parent::Value{ std::array<float, 2> {{ 0.0f, 0.0f }} },
+        },
+        rasterVertexBuffer,
+        tileTriangleIndexBuffer,
+        rasterSegments,
+        paintAttributeData,
+        properties,
+        state.getZoom()
+    );
+}
+
 void Painter::renderRaster(PaintParameters& parameters,
                            RasterBucket& bucket,
                            const RasterLayer& layer,
@@ -47,15 +106,26 @@ void Painter::renderRaster(PaintParameters& parameters,
         return;
     if (!bucket.hasData())
         return;
+    // DEM buckets carry no drawable color texture; their height texture is
+    // for terrain programs, not the imagery draw.
+    if (!bucket.texture)
+        return;
 
     const RasterPaintProperties::Evaluated& properties = layer.impl->paint.evaluated;
     const RasterProgram::PaintPropertyBinders paintAttributeData(properties, 0);
 
+    // Two binds per tile: the shader cross-fades between a tile and its
+    // parent, and we currently always pass the tile itself as its own parent.
+    // Sharing one texture across tiles (an atlas, or ES3 texture arrays)
+    // would cut this to one bind per layer, but we target ES2 and the shader
+    // sources are generated upstream, so the texcoord remapping an atlas
+    // needs cannot be expressed here. Context::bindTexture already elides
+    // redundant glBindTexture calls through its state cache.
     assert(bucket.texture);
     context.bindTexture(*bucket.texture, 0, gl::TextureFilter::Linear);
     context.bindTexture(*bucket.texture, 1, gl::TextureFilter::Linear);
 
-    parameters.programs.raster.draw(
+    parameters.programs.raster().draw(
         context,
         gl::Triangles(),
         depthModeForSublayer(0, gl::DepthMode::ReadOnly),
@@ -49,8 +49,9 @@ void Painter::renderSymbol(PaintParameters& parameters,
                 : gl::StencilMode::disabled(),
             colorModeForRenderPass(),
             std::move(uniformValues),
-            *buffers.vertexBuffer,
-            *buffers.indexBuffer,
+            **buffers.geometryVertexBuffer,
+            *buffers.placementVertexBuffer,
+            **buffers.indexBuffer,
             buffers.segments,
             bucket.paintPropertyBinders.at(layer.getID()),
             layer.impl->paint.evaluated,
@@ -69,21 +70,29 @@ void Painter::renderSymbol(PaintParameters& parameters,
         const Size texsize = atlas.getSize();
 
         if (bucket.sdfIcons) {
-            if (values.hasHalo()) {
-                draw(parameters.programs.symbolIconSDF,
+            // When both halo and fill are visible, the combined program
+            // composites them in a single pass instead of two draws.
+            if (values.hasHalo() && values.hasForeground()) {
+                draw(parameters.programs.symbolIconSDFHaloFill(values.rotationAlignment == AlignmentType::Map,
+                                                               values.pitchAlignment == AlignmentType::Map),
+                     SymbolSDFHaloFillProgram::uniformValues(values, texsize, pixelsToGLUnits, tile, state, frame.pixelRatio),
+                     bucket.icon,
+                     values);
+            } else if (values.hasHalo()) {
+                draw(parameters.programs.symbolIconSDF(values.rotationAlignment == AlignmentType::Map,
+                                                       values.pitchAlignment == AlignmentType::Map),
                      SymbolSDFProgram::haloUniformValues(values, texsize, pixelsToGLUnits, tile, state, frame.pixelRatio),
                      bucket.icon,
                      values);
-            }
-
-            if (values.hasForeground()) {
-                draw(parameters.programs.symbolIconSDF,
+            } else if (values.hasForeground()) {
+                draw(parameters.programs.symbolIconSDF(values.rotationAlignment == AlignmentType::Map,
+                                                       values.pitchAlignment == AlignmentType::Map),
                      SymbolSDFProgram::foregroundUniformValues(values, texsize, pixelsToGLUnits, tile, state, frame.pixelRatio),
                      bucket.icon,
                      values);
             }
         } else {
-            draw(parameters.programs.symbolIcon,
+            draw(parameters.programs.symbolIcon(values.rotationAlignment == AlignmentType::Map),
                  SymbolIconProgram::uniformValues(values, texsize, pixelsToGLUnits, tile, state),
                  bucket.icon,
                  values);
@@ -97,15 +106,21 @@ void Painter::renderSymbol(PaintParameters& parameters,
 
         const Size texsize = glyphAtlas->getSize();
 
-        if (values.hasHalo()) {
-            draw(parameters.programs.symbolGlyph,
+        if (values.hasHalo() && values.hasForeground()) {
+            draw(parameters.programs.symbolGlyphHaloFill(values.rotationAlignment == AlignmentType::Map,
+                                              values.pitchAlignment == AlignmentType::Map),
+                 SymbolSDFHaloFillProgram::uniformValues(values, texsize, pixelsToGLUnits, tile, state, frame.pixelRatio),
+                 bucket.text,
+                 values);
+        } else if (values.hasHalo()) {
+            draw(parameters.programs.symbolGlyph(values.rotationAlignment == AlignmentType::Map,
+                                              values.pitchAlignment == AlignmentType::Map),
                  SymbolSDFProgram::haloUniformValues(values, texsize, pixelsToGLUnits, tile, state, frame.pixelRatio),
                  bucket.text,
                  values);
-        }
-
-        if (values.hasForeground()) {
-            draw(parameters.programs.symbolGlyph,
+        } else if (values.hasForeground()) {
+            draw(parameters.programs.symbolGlyph(values.rotationAlignment == AlignmentType::Map,
+                                              values.pitchAlignment == AlignmentType::Map),
                  SymbolSDFProgram::foregroundUniformValues(values, texsize, pixelsToGLUnits, tile, state, frame.pixelRatio),
                  bucket.text,
                  values);
@@ -116,7 +131,7 @@ void Painter::renderSymbol(PaintParameters& parameters,
         static const style::PaintProperties<>::Evaluated properties {};
         static const CollisionBoxProgram::PaintPropertyBinders paintAttributeData(properties, 0);
 
-        programs->collisionBox.draw(
+        programs->collisionBox().draw(
             context,
             gl::Lines { 1.0f },
             gl::DepthMode::disabled(),
@@ -11,8 +11,32 @@ using namespace style;
 RasterBucket::RasterBucket(UnassociatedImage&& image_) : image(std::move(image_)) {
 }
 
+RasterBucket::RasterBucket(util::ETC1Image&& etc1_) : etc1(std::move(etc1_)) {
+}
+
+RasterBucket::RasterBucket(DEMPayload&& dem_) : dem(std::move(dem_)) {
+}
+
+std::size_t RasterBucket::uploadByteSize() const {
+    if (dem) {
+        return std::size_t(dem->size.width) * dem->size.height * 2;
+    }
+    return etc1 ? etc1->blocks.size() : image.bytes();
+}
+
 void RasterBucket::upload(gl::Context& context) {
-    texture = context.createTexture(std::move(image));
+    if (dem) {
+        demTexture = context.createLuminanceAlphaTexture(dem->size, dem->data.get());
+        dem = {};
+    } else if (etc1) {
+        // The worker only produces the compressed form when the context
+        // advertised support, so this is never reached without it.
+        texture = context.createCompressedTexture(etc1->size, etc1->blocks.data(),
+                                                  etc1->blocks.size());
+        etc1 = {};
+    } else {
+        texture = context.createTexture(std::move(image));
+    }
     uploaded = true;
 }
 
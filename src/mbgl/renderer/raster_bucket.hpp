@@ -1,6 +1,7 @@
 #pragma once
 
 #include <mbgl/renderer/bucket.hpp>
+#include <mbgl/util/etc1.hpp>
 #include <mbgl/util/image.hpp>
 #include <mbgl/util/optional.hpp>
 #include <mbgl/gl/texture.hpp>
@@ -9,14 +10,34 @@ namespace mbgl {
 
 class RasterBucket : public Bucket {
 public:
+    // Alternate-format payload produced by a worker-side decode stage in
+    // place of image/etc1: 16-bit samples, two bytes per texel, big-endian.
+    // For terrain-RGB sources these are heights in meters, offset by 10000
+    // and clamped to 16 bits. Uploaded as a luminance-alpha texture to be
+    // consumed by terrain programs; not drawn by the plain raster draw.
+    struct DEMPayload {
+        Size size;
+        std::unique_ptr<uint8_t[]> data;
+    };
+
     RasterBucket(UnassociatedImage&&);
+    RasterBucket(util::ETC1Image&&);
+    RasterBucket(DEMPayload&&);
 
     void upload(gl::Context&) override;
+    std::size_t uploadByteSize() const override;
     void render(Painter&, PaintParameters&, const style::Layer&, const RenderTile&) override;
     bool hasData() const override;
 
+    // Exactly one of these carries the tile's pixels until upload: the worker
+    // delivers the ETC1 form when the context supports compressed textures and
+    // the image is eligible (see util::compressETC1), and plain RGBA otherwise.
     UnassociatedImage image;
+    optional<util::ETC1Image> etc1;
+    optional<DEMPayload> dem;
+
     optional<gl::Texture> texture;
+    optional<gl::Texture> demTexture;
 };
 
 } // namespace mbgl
@@ -26,6 +26,12 @@ public:
     mat4 matrix;
     bool used = false;
 
+    // Set per frame when this tile's stencil region is entirely covered by
+    // child tiles. Stencil-clipped draws from a covered tile can never pass
+    // the stencil test and are skipped; symbol layers ignore this flag since
+    // they draw without stencil clipping.
+    bool covered = false;
+
     mat4 translatedMatrix(const std::array<float, 2>& translate,
                           style::TranslateAnchorType anchor,
                           const TransformState&) const;
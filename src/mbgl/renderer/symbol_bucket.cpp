@@ -22,15 +22,62 @@ SymbolBucket::SymbolBucket(style::SymbolLayoutProperties::Evaluated layout_,
     }
 }
 
+void SymbolBucket::commit() {
+    text.geometryVertices.shrinkToFit();
+    text.placementVertices.shrinkToFit();
+    text.triangles.shrinkToFit();
+    text.segments.shrink_to_fit();
+
+    icon.geometryVertices.shrinkToFit();
+    icon.placementVertices.shrinkToFit();
+    icon.triangles.shrinkToFit();
+    icon.segments.shrink_to_fit();
+
+    collisionBox.vertices.shrinkToFit();
+    collisionBox.lines.shrinkToFit();
+    collisionBox.segments.shrink_to_fit();
+
+    for (auto& pair : paintPropertyBinders) {
+        pair.second.shrinkToFit();
+    }
+}
+
+std::size_t SymbolBucket::uploadByteSize() const {
+    std::size_t total = text.placementVertices.byteSize()
+                      + icon.placementVertices.byteSize()
+                      + collisionBox.vertices.byteSize() + collisionBox.lines.byteSize();
+    // Geometry inherited from the previous placement is already on the GPU.
+    if (!*text.geometryVertexBuffer) {
+        total += text.geometryVertices.byteSize() + text.triangles.byteSize();
+    }
+    if (!*icon.geometryVertexBuffer) {
+        total += icon.geometryVertices.byteSize() + icon.triangles.byteSize();
+    }
+    return total;
+}
+
 void SymbolBucket::upload(gl::Context& context) {
     if (hasTextData()) {
-        text.vertexBuffer = context.createVertexBuffer(std::move(text.vertices));
-        text.indexBuffer = context.createIndexBuffer(std::move(text.triangles));
+        if (!*text.geometryVertexBuffer) {
+            *text.geometryVertexBuffer = context.createVertexBuffer(std::move(text.geometryVertices));
+            *text.indexBuffer = context.createIndexBuffer(std::move(text.triangles));
+        } else {
+            // Shared from the previous placement; drop the unused staging copy.
+            text.geometryVertices = {};
+            text.triangles = {};
+        }
+        text.placementVertexBuffer = context.createVertexBuffer(std::move(text.placementVertices));
     }
 
     if (hasIconData()) {
-        icon.vertexBuffer = context.createVertexBuffer(std::move(icon.vertices));
-        icon.indexBuffer = context.createIndexBuffer(std::move(icon.triangles));
+        if (!*icon.geometryVertexBuffer) {
+            *icon.geometryVertexBuffer = context.createVertexBuffer(std::move(icon.geometryVertices));
+            *icon.indexBuffer = context.createIndexBuffer(std::move(icon.triangles));
+        } else {
+            icon.geometryVertices = {};
+            icon.triangles = {};
+        }
+        icon.placementVertexBuffer = context.createVertexBuffer(std::move(icon.placementVertices));
     }
 
     if (!collisionBox.vertices.empty()) {
@@ -10,6 +10,7 @@
 #include <mbgl/text/glyph_range.hpp>
 #include <mbgl/style/layers/symbol_layer_properties.hpp>
 
+#include <memory>
 #include <vector>
 
 namespace mbgl {
@@ -23,8 +24,11 @@ public:
                  bool iconsNeedLinear);
 
     void upload(gl::Context&) override;
+    std::size_t uploadByteSize() const override;
     void render(Painter&, PaintParameters&, const style::Layer&, const RenderTile&) override;
     bool hasData() const override;
+
+    void commit() override;
     bool hasTextData() const;
     bool hasIconData() const;
     bool hasCollisionBoxData() const;
@@ -35,22 +39,37 @@ public:
 
     std::unordered_map<std::string, SymbolIconProgram::PaintPropertyBinders> paintPropertyBinders;
 
+    // The geometry stream and triangle indices are placement-independent;
+    // the placement stream carries the per-vertex a_data that changes with
+    // every placement. The GL objects for the placement-independent parts
+    // live behind shared handles: when SymbolLayout determines that a
+    // re-placement produced the same geometry, it points the new bucket at
+    // the previous bucket's handles and upload() only creates the small
+    // placement buffer.
     struct TextBuffer {
-        gl::VertexVector<SymbolLayoutVertex> vertices;
+        gl::VertexVector<SymbolGeometryVertex> geometryVertices;
+        gl::VertexVector<SymbolPlacementVertex> placementVertices;
         gl::IndexVector<gl::Triangles> triangles;
         gl::SegmentVector<SymbolAttributes> segments;
 
-        optional<gl::VertexBuffer<SymbolLayoutVertex>> vertexBuffer;
-        optional<gl::IndexBuffer<gl::Triangles>> indexBuffer;
+        std::shared_ptr<optional<gl::VertexBuffer<SymbolGeometryVertex>>> geometryVertexBuffer
+            = std::make_shared<optional<gl::VertexBuffer<SymbolGeometryVertex>>>();
+        std::shared_ptr<optional<gl::IndexBuffer<gl::Triangles>>> indexBuffer
+            = std::make_shared<optional<gl::IndexBuffer<gl::Triangles>>>();
+        optional<gl::VertexBuffer<SymbolPlacementVertex>> placementVertexBuffer;
     } text;
 
     struct IconBuffer {
-        gl::VertexVector<SymbolLayoutVertex> vertices;
+        gl::VertexVector<SymbolGeometryVertex> geometryVertices;
+        gl::VertexVector<SymbolPlacementVertex> placementVertices;
         gl::IndexVector<gl::Triangles> triangles;
         gl::SegmentVector<SymbolAttributes> segments;
 
-        optional<gl::VertexBuffer<SymbolLayoutVertex>> vertexBuffer;
-        optional<gl::IndexBuffer<gl::Triangles>> indexBuffer;
+        std::shared_ptr<optional<gl::VertexBuffer<SymbolGeometryVertex>>> geometryVertexBuffer
+            = std::make_shared<optional<gl::VertexBuffer<SymbolGeometryVertex>>>();
+        std::shared_ptr<optional<gl::IndexBuffer<gl::Triangles>>> indexBuffer
+            = std::make_shared<optional<gl::IndexBuffer<gl::Triangles>>>();
+        optional<gl::VertexBuffer<SymbolPlacementVertex>> placementVertexBuffer;
     } icon;
 
     struct CollisionBoxBuffer {
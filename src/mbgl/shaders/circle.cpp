@@ -62,7 +62,6 @@ vec2 get_pattern_pos(const vec2 pixel_coord_upper, const vec2 pixel_coord_lower,
     return (tile_units_to_pixels * pos + offset) / pattern_size;
 }
 uniform mat4 u_matrix;
-uniform bool u_scale_with_map;
 uniform vec2 u_extrude_scale;
 
 attribute vec2 a_pos;
@@ -116,11 +115,11 @@ void main(void) {
     // in extrusion data
     gl_Position = u_matrix * vec4(floor(a_pos * 0.5), 0, 1);
 
-    if (u_scale_with_map) {
-        gl_Position.xy += extrude;
-    } else {
-        gl_Position.xy += extrude * gl_Position.w;
-    }
+#ifdef SCALE_WITH_MAP
+    gl_Position.xy += extrude;
+#else
+    gl_Position.xy += extrude * gl_Position.w;
+#endif
 
     // This is a minimum blur distance that serves as a faux-antialiasing for
     // the circle. since blur is a ratio of the circle's size and the intent is
@@ -71,7 +71,6 @@ attribute vec4 a_data;
 uniform mat4 u_matrix;
 
 uniform mediump float u_zoom;
-uniform bool u_rotate_with_map;
 uniform vec2 u_extrude_scale;
 
 uniform vec2 u_texsize;
@@ -90,12 +89,12 @@ void main() {
     mediump float z = 2.0 - step(a_minzoom, u_zoom) - (1.0 - step(a_maxzoom, u_zoom));
 
     vec2 extrude = u_extrude_scale * (a_offset / 64.0);
-    if (u_rotate_with_map) {
-        gl_Position = u_matrix * vec4(a_pos + extrude, 0, 1);
-        gl_Position.z += z * gl_Position.w;
-    } else {
-        gl_Position = u_matrix * vec4(a_pos, 0, 1) + vec4(extrude, 0, 0);
-    }
+#ifdef ROTATE_WITH_MAP
+    gl_Position = u_matrix * vec4(a_pos + extrude, 0, 1);
+    gl_Position.z += z * gl_Position.w;
+#else
+    gl_Position = u_matrix * vec4(a_pos, 0, 1) + vec4(extrude, 0, 0);
+#endif
 
     v_tex = a_tex / u_texsize;
     v_fade_tex = vec2(a_labelminzoom / 255.0, 0.0);
@@ -0,0 +1,71 @@
+// NOTE: Unlike its siblings, this file is maintained by hand. It is a local
+// variant of symbol_sdf that thresholds the distance field twice and
+// composites halo and fill in a single pass.
+
+#include <mbgl/shaders/symbol_sdf_halo_fill.hpp>
+#include <mbgl/shaders/symbol_sdf.hpp>
+
+namespace mbgl {
+namespace shaders {
+
+const char* symbol_sdf_halo_fill::name = "symbol_sdf_halo_fill";
+
+// The vertex stage is identical to symbol_sdf; aliasing it keeps the two
+// shaders from drifting apart when the generated one is regenerated.
+const char* symbol_sdf_halo_fill::vertexSource = symbol_sdf::vertexSource;
+
+// Compositing the fill over the halo inside the shader produces exactly the
+// same premultiplied color as drawing the halo pass and then the fill pass
+// with the usual (1, 1-src_alpha) blending: the halo contributes only where
+// the fill doesn't cover it, scaled by (1 - fill_alpha).
+const char* symbol_sdf_halo_fill::fragmentSource = R"MBGL_SHADER(
+#ifdef GL_ES
+precision mediump float;
+#else
+
+#if !defined(lowp)
+#define lowp
+#endif
+
+#if !defined(mediump)
+#define mediump
+#endif
+
+#if !defined(highp)
+#define highp
+#endif
+
+#endif
+uniform sampler2D u_texture;
+uniform sampler2D u_fadetexture;
+uniform lowp vec4 u_color;
+uniform lowp float u_opacity;
+uniform lowp float u_buffer;
+uniform lowp float u_gamma;
+uniform lowp vec4 u_halo_color;
+uniform lowp float u_halo_buffer;
+uniform lowp float u_halo_gamma;
+
+varying vec2 v_tex;
+varying vec2 v_fade_tex;
+varying float v_gamma_scale;
+
+void main() {
+    lowp float dist = texture2D(u_texture, v_tex).a;
+    lowp float fade_alpha = texture2D(u_fadetexture, v_fade_tex).a;
+    lowp float gamma = u_gamma * v_gamma_scale;
+    lowp float halo_gamma = u_halo_gamma * v_gamma_scale;
+    lowp float fill_alpha = smoothstep(u_buffer - gamma, u_buffer + gamma, dist);
+    lowp float halo_alpha = smoothstep(u_halo_buffer - halo_gamma, u_halo_buffer + halo_gamma, dist);
+
+    gl_FragColor = (u_color * fill_alpha + u_halo_color * ((1.0 - fill_alpha) * halo_alpha)) * (fade_alpha * u_opacity);
+
+#ifdef OVERDRAW_INSPECTOR
+    gl_FragColor = vec4(1.0);
+#endif
+}
+
+)MBGL_SHADER";
+
+} // namespace shaders
+} // namespace mbgl
@@ -0,0 +1,20 @@
+// NOTE: Unlike its siblings, this file is maintained by hand. It is a local
+// variant of symbol_sdf that thresholds the distance field twice and
+// composites halo and fill in a single pass.
+
+#pragma once
+
+#include <mbgl/gl/gl.hpp>
+
+namespace mbgl {
+namespace shaders {
+
+class symbol_sdf_halo_fill {
+public:
+    static const char* name;
+    static const char* vertexSource;
+    static const char* fragmentSource;
+};
+
+} // namespace shaders
+} // namespace mbgl
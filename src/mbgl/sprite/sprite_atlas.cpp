@@ -1,8 +1,10 @@
 #include <mbgl/sprite/sprite_atlas.hpp>
 #include <mbgl/sprite/sprite_atlas_observer.hpp>
+#include <mbgl/sprite/sprite_cache.hpp>
 #include <mbgl/sprite/sprite_parser.hpp>
 #include <mbgl/gl/context.hpp>
 #include <mbgl/util/logging.hpp>
+#include <mbgl/util/memory_budget.hpp>
 #include <mbgl/util/platform.hpp>
 #include <mbgl/util/math.hpp>
 #include <mbgl/util/std.hpp>
@@ -21,6 +23,7 @@ namespace mbgl {
 static SpriteAtlasObserver nullObserver;
 
 struct SpriteAtlas::Loader {
+    std::string url;
     std::shared_ptr<const std::string> image;
     std::shared_ptr<const std::string> json;
     std::unique_ptr<AsyncRequest> jsonRequest;
@@ -33,9 +36,14 @@ SpriteAtlas::SpriteAtlas(Size size_, float pixelRatio_)
       observer(&nullObserver),
       bin(size.width, size.height),
       dirty(true) {
+    // The atlas page is referenced by live buckets, so it only reports its
+    // usage and cannot be trimmed.
+    memoryBudgetId = MemoryBudget::Register("SpriteAtlas", [this] { return image.bytes(); });
 }
 
-SpriteAtlas::~SpriteAtlas() = default;
+SpriteAtlas::~SpriteAtlas() {
+    MemoryBudget::Unregister(memoryBudgetId);
+}
 
 void SpriteAtlas::load(const std::string& url, FileSource& fileSource) {
     if (url.empty()) {
@@ -44,7 +52,18 @@ void SpriteAtlas::load(const std::string& url, FileSource& fileSource) {
         return;
     }
 
+    Sprites cached;
+    if (SpriteCache::Get().get(url, pixelRatio, cached)) {
+        loaded = true;
+        setSprites(cached);
+        workQueue.push([this] {
+            observer->onSpriteLoaded();
+        });
+        return;
+    }
+
     loader = std::make_unique<Loader>();
+    loader->url = url;
 
     loader->jsonRequest = fileSource.request(Resource::spriteJSON(url, pixelRatio), [this](Response res) {
         if (res.error) {
@@ -87,6 +106,7 @@ void SpriteAtlas::emitSpriteLoadedIfComplete() {
     if (result.is<Sprites>()) {
         loaded = true;
         setSprites(result.get<Sprites>());
+        SpriteCache::Get().put(loader->url, pixelRatio, std::move(result.get<Sprites>()));
         observer->onSpriteLoaded();
     } else {
         observer->onSpriteError(result.get<std::exception_ptr>());
@@ -133,6 +153,10 @@ void SpriteAtlas::_setSprite(const std::string& name,
             sprites.emplace(name, sprite);
         }
 
+        if (sprite->pixelRatio > maxSpriteRatio.load()) {
+            maxSpriteRatio.store(sprite->pixelRatio);
+        }
+
         // Always add/replace the value in the dirty list.
         auto dirty_it = dirtySprites.find(name);
         if (dirty_it != dirtySprites.end()) {
@@ -266,17 +290,38 @@ void SpriteAtlas::copy(const Holder& holder, const SpritePatternMode mode) {
         std::fill(image.data.get(), image.data.get() + image.bytes(), 0);
     }
 
-    const uint32_t* srcData =
-        reinterpret_cast<const uint32_t*>(holder.spriteImage->image.data.get());
+    // getImage() slices sheet-backed icons out of the sprite sheet on first
+    // use; icons never drawn by this style stay unsliced.
+    const PremultipliedImage& spriteImage = holder.spriteImage->getImage();
+    const uint32_t* srcData = reinterpret_cast<const uint32_t*>(spriteImage.data.get());
     if (!srcData) return;
     uint32_t* const dstData = reinterpret_cast<uint32_t*>(image.data.get());
 
     const int padding = 1;
 
-    copyBitmap(srcData, holder.spriteImage->image.size.width, 0, 0, dstData, image.size.width,
+    copyBitmap(srcData, spriteImage.size.width, 0, 0, dstData, image.size.width,
                (holder.pos.x + padding) * pixelRatio, (holder.pos.y + padding) * pixelRatio,
-               image.size.width * image.size.height, holder.spriteImage->image.size.width,
-               holder.spriteImage->image.size.height, mode);
+               image.size.width * image.size.height, spriteImage.size.width,
+               spriteImage.size.height, mode);
+
+    // Track the band of rows this copy touched so upload() can send just that
+    // band instead of the whole atlas. The extra row on either side covers
+    // the 1 px border; when the border wraps past the top or bottom edge of
+    // the atlas it lands on the opposite edge, so fall back to marking the
+    // whole image dirty in that case.
+    const int32_t firstRow = int32_t((holder.pos.y + padding) * pixelRatio) - 1;
+    const int32_t lastRow = int32_t((holder.pos.y + padding) * pixelRatio +
+                                    holder.spriteImage->image.size.height) + 1;
+    if (firstRow < 0 || lastRow > int32_t(image.size.height)) {
+        dirtyRowsBegin = 0;
+        dirtyRowsEnd = image.size.height;
+    } else if (dirtyRowsBegin == dirtyRowsEnd) {
+        dirtyRowsBegin = firstRow;
+        dirtyRowsEnd = lastRow;
+    } else {
+        dirtyRowsBegin = std::min(dirtyRowsBegin, uint32_t(firstRow));
+        dirtyRowsEnd = std::max(dirtyRowsEnd, uint32_t(lastRow));
+    }
 
     dirty = true;
 }
@@ -310,10 +355,36 @@ void SpriteAtlas::updateDirty() {
 }
 
 void SpriteAtlas::upload(gl::Context& context, gl::TextureUnit unit) {
+    std::lock_guard<std::recursive_mutex> lock(mtx);
+
+    bool contentChanged = false;
+
     if (!texture) {
         texture = context.createTexture(image, unit);
+        contentChanged = true;
     } else if (dirty) {
-        context.updateTexture(*texture, image, unit);
+        if (dirtyRowsBegin < dirtyRowsEnd) {
+            // Only re-upload the band of rows that changed since the last
+            // upload; a single added marker icon no longer pushes the whole
+            // atlas to the GPU.
+            context.updateTextureBand(*texture, image, dirtyRowsBegin,
+                                      dirtyRowsEnd - dirtyRowsBegin, unit);
+        } else {
+            context.updateTexture(*texture, image, unit);
+        }
+        contentChanged = true;
+    }
+
+    // Sprites denser than this display -- served from another density's
+    // cached sheet -- minify when drawn, so keep a mipmap chain for them.
+    // Mipmaps require power-of-two dimensions on ES2; fractional pixel
+    // ratios can produce non-POT atlases, which just fall back to the base
+    // level.
+    const auto isPOT = [] (uint32_t v) { return v != 0 && (v & (v - 1)) == 0; };
+    if (contentChanged && maxSpriteRatio.load() > pixelRatio &&
+        isPOT(image.size.width) && isPOT(image.size.height)) {
+        context.generateMipmap(*texture, unit);
+        mipmapped = true;
     }
 
 #if not MBGL_USE_GLES2
@@ -325,12 +396,14 @@ void SpriteAtlas::upload(gl::Context& context, gl::TextureUnit unit) {
 #endif // MBGL_USE_GLES2
 
     dirty = false;
+    dirtyRowsBegin = dirtyRowsEnd = 0;
 }
 
 void SpriteAtlas::bind(bool linear, gl::Context& context, gl::TextureUnit unit) {
     upload(context, unit);
     context.bindTexture(*texture, unit,
-                        linear ? gl::TextureFilter::Linear : gl::TextureFilter::Nearest);
+                        linear ? gl::TextureFilter::Linear : gl::TextureFilter::Nearest,
+                        mipmapped ? gl::TextureMipMap::Yes : gl::TextureMipMap::No);
 }
 
 SpriteAtlas::Holder::Holder(std::shared_ptr<const SpriteImage> spriteImage_, Rect<uint16_t> pos_)
@@ -4,6 +4,7 @@
 #include <mbgl/gl/texture.hpp>
 #include <mbgl/util/noncopyable.hpp>
 #include <mbgl/util/optional.hpp>
+#include <mbgl/util/work_queue.hpp>
 #include <mbgl/sprite/sprite_image.hpp>
 
 #include <atomic>
@@ -112,6 +113,11 @@ private:
 
     bool loaded = false;
 
+    // Defers observer notifications when the sprite sheet was satisfied
+    // synchronously from the process-wide SpriteCache, since observers may
+    // reenter the atlas.
+    util::WorkQueue workQueue;
+
     SpriteAtlasObserver* observer = nullptr;
 
     // Lock for sprites and dirty maps.
@@ -142,6 +148,23 @@ private:
     PremultipliedImage image;
     mbgl::optional<gl::Texture> texture;
     std::atomic<bool> dirty;
+
+    // The densest pixel ratio among the loaded sprites. When it exceeds the
+    // atlas's own ratio -- sprites served from another density's cached sheet
+    // -- those sprites minify when drawn, so upload() maintains a mipmap
+    // chain and bind() samples through it.
+    std::atomic<float> maxSpriteRatio { 1.0f };
+    bool mipmapped = false;
+
+    // Half-open band of atlas rows changed since the last upload, maintained
+    // by copy() and consumed by upload(). Row-granular because ES2's
+    // glTexSubImage2D cannot upload a partial-width region of a wider
+    // client-side buffer (no GL_UNPACK_ROW_LENGTH). Guarded by mtx.
+    uint32_t dirtyRowsBegin = 0;
+    uint32_t dirtyRowsEnd = 0;
+
+    uint64_t memoryBudgetId;
+
     static const int buffer = 1;
 };
 
@@ -0,0 +1,51 @@
+#include <mbgl/sprite/sprite_cache.hpp>
+
+namespace mbgl {
+
+SpriteCache& SpriteCache::Get() {
+    static SpriteCache cache;
+    return cache;
+}
+
+bool SpriteCache::get(const std::string& url, float pixelRatio, Sprites& out) {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    auto it = cache.find(Key { url, pixelRatio });
+    if (it != cache.end()) {
+        out = it->second;
+        return true;
+    }
+
+    // Density fallback: a sheet fetched for another display density serves
+    // this one too. SpriteImages carry their own pixel ratio and SpriteAtlas
+    // scales them on use, so when a window moves to a screen with a different
+    // density, hand back the densest sheet already parsed for this URL rather
+    // than forcing a refetch.
+    const Sprites* densest = nullptr;
+    float densestRatio = 0;
+    for (const auto& entry : cache) {
+        if (entry.first.first == url && entry.first.second > densestRatio) {
+            densest = &entry.second;
+            densestRatio = entry.first.second;
+        }
+    }
+
+    if (!densest) {
+        return false;
+    }
+
+    out = *densest;
+    return true;
+}
+
+void SpriteCache::put(const std::string& url, float pixelRatio, Sprites sprites) {
+    std::lock_guard<std::mutex> lock(mutex);
+    cache[Key { url, pixelRatio }] = std::move(sprites);
+}
+
+void SpriteCache::clear() {
+    std::lock_guard<std::mutex> lock(mutex);
+    cache.clear();
+}
+
+} // namespace mbgl
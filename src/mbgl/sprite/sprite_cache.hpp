@@ -0,0 +1,50 @@
+#pragma once
+
+#include <mbgl/util/noncopyable.hpp>
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+
+namespace mbgl {
+
+class SpriteImage;
+
+/*
+    Process-wide cache of parsed sprite sheets, the sprite-side counterpart of
+    GlyphCache. Each Style owns its own SpriteAtlas, so without this cache
+    every map instance running side by side (and every style switch) refetches,
+    re-decodes, and reparses the same sprite image and JSON. Entries are keyed
+    by sprite URL and pixel ratio and live for the lifetime of the process; the
+    SpriteImages themselves are immutable and shared by reference, so N maps
+    using the same style pay for one decoded copy. Thread-safe.
+*/
+class SpriteCache : private util::noncopyable {
+public:
+    using Sprites = std::map<std::string, std::shared_ptr<const SpriteImage>>;
+
+    static SpriteCache& Get();
+
+    // Copies the cached sprite set for the given key into `out`, falling back
+    // to the densest set parsed for the same URL at any other pixel ratio
+    // (SpriteAtlas scales sprites whose ratio differs from its own). Returns
+    // false if this sprite sheet hasn't been parsed at any density.
+    bool get(const std::string& url, float pixelRatio, Sprites& out);
+
+    void put(const std::string& url, float pixelRatio, Sprites);
+
+    // Only for use in tests, which reuse one sprite URL across cases.
+    void clear();
+
+private:
+    SpriteCache() = default;
+
+    using Key = std::pair<std::string, float>;
+
+    std::mutex mutex;
+    std::map<Key, Sprites> cache;
+};
+
+} // namespace mbgl
@@ -2,7 +2,9 @@
 
 #include <mbgl/util/exception.hpp>
 
+#include <cassert>
 #include <cmath>
+#include <cstring>
 
 namespace mbgl {
 
@@ -20,4 +22,43 @@ SpriteImage::SpriteImage(PremultipliedImage&& image_,
     }
 }
 
+SpriteImage::SpriteImage(std::shared_ptr<const PremultipliedImage> sheet_,
+                         const uint32_t srcX_,
+                         const uint32_t srcY_,
+                         const Size size_,
+                         const float pixelRatio_,
+                         bool sdf_)
+    : image(size_, nullptr),
+      pixelRatio(pixelRatio_),
+      sdf(sdf_),
+      sheet(std::move(sheet_)),
+      srcX(srcX_),
+      srcY(srcY_) {
+
+    if (!image.size) {
+        throw util::SpriteImageException("Sprite image dimensions may not be zero");
+    } else if (pixelRatio <= 0) {
+        throw util::SpriteImageException("Sprite pixelRatio may not be <= 0");
+    }
+
+    assert(sheet);
+    assert(srcX + image.size.width <= sheet->size.width);
+    assert(srcY + image.size.height <= sheet->size.height);
+}
+
+const PremultipliedImage& SpriteImage::getImage() const {
+    if (sheet) {
+        std::call_once(sliced, [this] {
+            PremultipliedImage copy(image.size);
+            for (uint32_t y = 0; y < image.size.height; ++y) {
+                std::memcpy(copy.data.get() + copy.stride() * y,
+                            sheet->data.get() + sheet->stride() * (srcY + y) + srcX * sheet->channels,
+                            copy.stride());
+            }
+            image.data = std::move(copy.data);
+        });
+    }
+    return image;
+}
+
 } // namespace mbgl
@@ -13,14 +13,15 @@
 
 namespace mbgl {
 
-SpriteImagePtr createSpriteImage(const PremultipliedImage& image,
-                                 const uint32_t srcX,
-                                 const uint32_t srcY,
-                                 const uint32_t width,
-                                 const uint32_t height,
-                                 const double ratio,
-                                 const bool sdf) {
-    // Disallow invalid parameter configurations.
+namespace {
+
+// Disallow invalid parameter configurations.
+bool validateSpriteMetrics(const PremultipliedImage& image,
+                           const uint32_t srcX,
+                           const uint32_t srcY,
+                           const uint32_t width,
+                           const uint32_t height,
+                           const double ratio) {
     if (width <= 0 || height <= 0 || width > 1024 || height > 1024 ||
         ratio <= 0 || ratio > 10 ||
         srcX >= image.size.width || srcY >= image.size.height ||
@@ -29,6 +30,21 @@ SpriteImagePtr createSpriteImage(const PremultipliedImage& image,
             width, height, srcX, srcY,
             image.size.width, image.size.height,
             util::toString(ratio).c_str());
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
+SpriteImagePtr createSpriteImage(const PremultipliedImage& image,
+                                 const uint32_t srcX,
+                                 const uint32_t srcY,
+                                 const uint32_t width,
+                                 const uint32_t height,
+                                 const double ratio,
+                                 const bool sdf) {
+    if (!validateSpriteMetrics(image, srcX, srcY, width, height, ratio)) {
         return nullptr;
     }
 
@@ -95,10 +111,15 @@ bool getBoolean(const JSValue& value, const char* name, const bool def = false)
 
 SpriteParseResult parseSprite(const std::string& image, const std::string& json) {
     Sprites sprites;
-    PremultipliedImage raster;
+
+    // The decoded sheet is shared by every icon; icons are created as views
+    // into it and only slice their pixels out when they are actually used
+    // (SpriteImage::getImage()), so a sheet with hundreds of icons doesn't
+    // cost hundreds of copies up front.
+    std::shared_ptr<PremultipliedImage> raster = std::make_shared<PremultipliedImage>();
 
     try {
-        raster = decodeImage(image);
+        *raster = decodeImage(image);
     } catch (...) {
         return std::current_exception();
     }
@@ -125,9 +146,9 @@ SpriteParseResult parseSprite(const std::string& image, const std::string& json)
                 const double pixelRatio = getDouble(value, "pixelRatio", 1);
                 const bool sdf = getBoolean(value, "sdf", false);
 
-                auto sprite = createSpriteImage(raster, x, y, width, height, pixelRatio, sdf);
-                if (sprite) {
-                    sprites.emplace(name, sprite);
+                if (validateSpriteMetrics(*raster, x, y, width, height, pixelRatio)) {
+                    sprites.emplace(name, std::make_shared<const SpriteImage>(
+                                              raster, x, y, Size{ width, height }, pixelRatio, sdf));
                 }
             }
         }
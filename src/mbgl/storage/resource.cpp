@@ -40,35 +40,43 @@ static std::string getTileBBox(int32_t x, int32_t y, int8_t z) {
 }
 
 Resource Resource::style(const std::string& url) {
-    return Resource {
+    Resource result {
         Resource::Kind::Style,
         url
     };
+    result.priority = Resource::High;
+    return result;
 }
 
 Resource Resource::source(const std::string& url) {
-    return Resource {
+    Resource result {
         Resource::Kind::Source,
         url
     };
+    result.priority = Resource::High;
+    return result;
 }
 
 Resource Resource::spriteImage(const std::string& base, float pixelRatio) {
-    return Resource {
+    Resource result {
         Resource::Kind::SpriteImage,
         base + (pixelRatio > 1 ? "@2x" : "") + ".png"
     };
+    result.priority = Resource::High;
+    return result;
 }
 
 Resource Resource::spriteJSON(const std::string& base, float pixelRatio) {
-    return Resource {
+    Resource result {
         Resource::Kind::SpriteJSON,
         base + (pixelRatio > 1 ? "@2x" : "") + ".json"
     };
+    result.priority = Resource::High;
+    return result;
 }
 
 Resource Resource::glyphs(const std::string& urlTemplate, const FontStack& fontStack, const std::pair<uint16_t, uint16_t>& glyphRange) {
-    return Resource {
+    Resource result {
         Resource::Kind::Glyphs,
         util::replaceTokens(urlTemplate, [&](const std::string& token) {
             if (token == "fontstack") {
@@ -80,6 +88,8 @@ Resource Resource::glyphs(const std::string& urlTemplate, const FontStack& fontS
             }
         })
     };
+    result.priority = Resource::High;
+    return result;
 }
 
 Resource Resource::tile(const std::string& urlTemplate,
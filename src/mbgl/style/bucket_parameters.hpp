@@ -3,6 +3,8 @@
 #include <mbgl/map/mode.hpp>
 #include <mbgl/tile/tile_id.hpp>
 
+#include <atomic>
+
 namespace mbgl {
 namespace style {
 
@@ -10,6 +12,12 @@ class BucketParameters {
 public:
     const OverscaledTileID tileID;
     const MapMode mode;
+
+    // Set when the tile this layout belongs to has been dropped. Long-running
+    // bucket builds poll it so an obsolete tile stops consuming worker time
+    // mid-feature instead of running to completion. Owned by the GeometryTile,
+    // which outlives every bucket built for it.
+    const std::atomic<bool>& obsolete;
 };
 
 } // namespace style
@@ -14,6 +14,12 @@ public:
     std::vector<ClassID> classes;
     TimePoint now;
     TransitionOptions transition;
+
+    // Small id identifying this exact class list, assigned by Style::cascade.
+    // The per-property caches snapshot their class resolution under it, so
+    // toggling between a handful of class sets reuses the resolved values
+    // instead of re-scanning per property. Zero means "don't cache".
+    uint32_t classCombination = 0;
 };
 
 } // namespace style
@@ -3,6 +3,7 @@
 #include <mbgl/style/filter.hpp>
 #include <mbgl/style/property_value.hpp>
 #include <mbgl/style/layout_property.hpp>
+#include <mbgl/style/paint_property.hpp>
 #include <mbgl/util/enum.hpp>
 #include <mbgl/util/color.hpp>
 #include <mbgl/util/feature.hpp>
@@ -383,6 +384,27 @@ void stringify(Writer& writer, const LayoutProperties<Ps...>& ps) {
     writer.EndObject();
 }
 
+template <class Writer, class Value>
+void stringify(Writer& writer, const UnevaluatedPaintProperty<Value>& v) {
+    if (v.isUndefined()) {
+        writer.Null();
+    } else {
+        stringify(writer, v.getValue());
+    }
+}
+
+// Serializes the cascaded (but not yet evaluated) values of every paint
+// property, in declaration order. Paint properties don't carry `key` members,
+// so this writes a positional array rather than an object; the result is a
+// deterministic signature suitable for change detection, not round-trippable
+// style JSON.
+template <class Writer, class... Ps>
+void stringify(Writer& writer, const PaintProperties<Ps...>& ps) {
+    writer.StartArray();
+    util::ignore({ (stringify(writer, ps.unevaluated.template get<Ps>()), 0)... });
+    writer.EndArray();
+}
+
 } // namespace conversion
 } // namespace style
 } // namespace mbgl
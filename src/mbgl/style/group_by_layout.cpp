@@ -32,7 +32,22 @@ std::string layoutKey(const Layer& layer) {
     return s.GetString();
 }
 
-std::vector<std::vector<const Layer*>> groupByLayout(const std::vector<std::unique_ptr<Layer>>& layers) {
+std::string bucketKey(const std::vector<const Layer*>& group) {
+    rapidjson::StringBuffer s;
+    rapidjson::Writer<rapidjson::StringBuffer> writer(s);
+
+    writer.StartArray();
+    writer.String(layoutKey(*group.at(0)));
+    for (const auto* layer : group) {
+        writer.String(layer->getID());
+        layer->baseImpl->stringifyPaint(writer);
+    }
+    writer.EndArray();
+
+    return s.GetString();
+}
+
+std::vector<std::vector<const Layer*>> groupByLayout(const std::vector<std::shared_ptr<const Layer>>& layers) {
     std::unordered_map<std::string, std::vector<const Layer*>> map;
     for (auto& layer : layers) {
         map[layoutKey(*layer)].push_back(layer.get());
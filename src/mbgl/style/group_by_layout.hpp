@@ -2,13 +2,25 @@
 
 #include <vector>
 #include <memory>
+#include <string>
 
 namespace mbgl {
 namespace style {
 
 class Layer;
 
-std::vector<std::vector<const Layer*>> groupByLayout(const std::vector<std::unique_ptr<Layer>>&);
+std::vector<std::vector<const Layer*>> groupByLayout(const std::vector<std::shared_ptr<const Layer>>&);
+
+// Signature covering everything that affects how a layer's buckets are laid
+// out: type, source, source layer, zoom range, visibility, filter, and layout
+// properties. Two layers with equal keys differ at most in paint.
+std::string layoutKey(const Layer&);
+
+// Signature covering everything that a bucket built for this group bakes in:
+// the shared layout key, plus each member layer's id and cascaded paint
+// properties (data-driven paint values end up in the bucket's vertex data).
+// Two groups with equal keys produce identical buckets for the same tile data.
+std::string bucketKey(const std::vector<const Layer*>& group);
 
 } // namespace style
 } // namespace mbgl
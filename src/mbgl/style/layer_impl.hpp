@@ -54,6 +54,11 @@ public:
     // Utility function for automatic layer grouping.
     virtual void stringifyLayout(rapidjson::Writer<rapidjson::StringBuffer>&) const = 0;
 
+    // Utility function for detecting changes to the cascaded paint properties,
+    // e.g. to decide whether a bucket that bakes in data-driven paint values
+    // can be reused. Writes a deterministic signature, not valid style JSON.
+    virtual void stringifyPaint(rapidjson::Writer<rapidjson::StringBuffer>&) const = 0;
+
     // Partially evaluate paint properties based on a set of classes.
     virtual void cascade(const CascadeParameters&) = 0;
 
@@ -63,6 +68,20 @@ public:
 
     virtual std::unique_ptr<Bucket> createBucket(const BucketParameters&, const std::vector<const Layer*>&) const = 0;
 
+    // Whether any paint property currently holds a data-driven value. Buckets
+    // bake such values into their vertex data, so paint changes on layers
+    // returning true require re-layout, not just a cascade (see the setJSON
+    // diffing in Style).
+    virtual bool hasDataDrivenPaint() const { return false; }
+
+    // Whether createBucket() produces identical output no matter which
+    // overscaled zoom it runs at. Layers whose buckets bake in zoom-dependent
+    // values — composite paint functions, zoom-evaluated layout properties, or
+    // overscale-aware geometry processing — must return false. Buckets of
+    // layers returning true can be shared across the overzoom levels of a
+    // canonical tile.
+    virtual bool hasZoomIndependentBuckets() const { return false; }
+
     // Checks whether this layer needs to be rendered in the given render pass.
     bool hasRenderPass(RenderPass) const;
 
@@ -34,6 +34,10 @@ std::unique_ptr<Layer> BackgroundLayer::Impl::cloneRef(const std::string& id_) c
 void BackgroundLayer::Impl::stringifyLayout(rapidjson::Writer<rapidjson::StringBuffer>&) const {
 }
 
+void BackgroundLayer::Impl::stringifyPaint(rapidjson::Writer<rapidjson::StringBuffer>& writer) const {
+    conversion::stringify(writer, paint);
+}
+
 
 // Layout properties
 
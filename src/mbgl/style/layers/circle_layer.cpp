@@ -35,6 +35,10 @@ std::unique_ptr<Layer> CircleLayer::Impl::cloneRef(const std::string& id_) const
 void CircleLayer::Impl::stringifyLayout(rapidjson::Writer<rapidjson::StringBuffer>&) const {
 }
 
+void CircleLayer::Impl::stringifyPaint(rapidjson::Writer<rapidjson::StringBuffer>& writer) const {
+    conversion::stringify(writer, paint);
+}
+
 // Source
 
 const std::string& CircleLayer::getSourceID() const {
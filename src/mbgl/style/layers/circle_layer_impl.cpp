@@ -26,6 +26,22 @@ std::unique_ptr<Bucket> CircleLayer::Impl::createBucket(const BucketParameters&
     return std::make_unique<CircleBucket>(parameters, layers);
 }
 
+bool CircleLayer::Impl::hasZoomIndependentBuckets() const {
+    // The circle bucket's geometry ignores the zoom; only composite paint
+    // functions baked into the binders tie it to the zoom it was built at.
+    return paint.evaluated.get<CircleRadius>().isZoomConstant()
+        && paint.evaluated.get<CircleColor>().isZoomConstant()
+        && paint.evaluated.get<CircleBlur>().isZoomConstant()
+        && paint.evaluated.get<CircleOpacity>().isZoomConstant()
+        && paint.evaluated.get<CircleStrokeWidth>().isZoomConstant()
+        && paint.evaluated.get<CircleStrokeColor>().isZoomConstant()
+        && paint.evaluated.get<CircleStrokeOpacity>().isZoomConstant();
+}
+
+bool CircleLayer::Impl::hasDataDrivenPaint() const {
+    return paint.hasDataDrivenValue();
+}
+
 float CircleLayer::Impl::getQueryRadius() const {
     const std::array<float, 2>& translate = paint.evaluated.get<CircleTranslate>();
     return paint.evaluated.get<CircleRadius>().constantOr(CircleRadius::defaultValue())
@@ -20,5 +20,9 @@ CustomLayer::CustomLayer(const Impl& other)
 
 CustomLayer::~CustomLayer() = default;
 
+void CustomLayer::setStateMask(CustomLayerStateMask mask) {
+    impl->stateMask = mask;
+}
+
 } // namespace style
 } // namespace mbgl
@@ -24,10 +24,15 @@ public:
     void deinitialize();
     void render(const TransformState&) const;
 
+    // GL state groups the render function may modify; the painter
+    // invalidates only these after the layer draws.
+    CustomLayerStateMask stateMask = CustomLayerStateMask::All;
+
 private:
     std::unique_ptr<Layer> clone() const override;
     std::unique_ptr<Layer> cloneRef(const std::string& id) const override;
     void stringifyLayout(rapidjson::Writer<rapidjson::StringBuffer>&) const override;
+    void stringifyPaint(rapidjson::Writer<rapidjson::StringBuffer>&) const override;
 
     void cascade(const CascadeParameters&) final {}
     bool evaluate(const PropertyEvaluationParameters&) final;
@@ -35,6 +35,10 @@ std::unique_ptr<Layer> FillExtrusionLayer::Impl::cloneRef(const std::string& id_
 void FillExtrusionLayer::Impl::stringifyLayout(rapidjson::Writer<rapidjson::StringBuffer>&) const {
 }
 
+void FillExtrusionLayer::Impl::stringifyPaint(rapidjson::Writer<rapidjson::StringBuffer>& writer) const {
+    conversion::stringify(writer, paint);
+}
+
 // Source
 
 const std::string& FillExtrusionLayer::getSourceID() const {
@@ -15,5 +15,9 @@ std::unique_ptr<Bucket> FillExtrusionLayer::Impl::createBucket(const BucketParam
     return nullptr;
 }
 
+bool FillExtrusionLayer::Impl::hasDataDrivenPaint() const {
+    return paint.hasDataDrivenValue();
+}
+
 } // namespace style
 } // namespace mbgl
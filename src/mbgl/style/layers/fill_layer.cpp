@@ -35,6 +35,10 @@ std::unique_ptr<Layer> FillLayer::Impl::cloneRef(const std::string& id_) const {
 void FillLayer::Impl::stringifyLayout(rapidjson::Writer<rapidjson::StringBuffer>&) const {
 }
 
+void FillLayer::Impl::stringifyPaint(rapidjson::Writer<rapidjson::StringBuffer>& writer) const {
+    conversion::stringify(writer, paint);
+}
+
 // Source
 
 const std::string& FillLayer::getSourceID() const {
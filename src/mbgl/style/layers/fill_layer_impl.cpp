@@ -39,6 +39,19 @@ std::unique_ptr<Bucket> FillLayer::Impl::createBucket(const BucketParameters& pa
     return std::make_unique<FillBucket>(parameters, layers);
 }
 
+bool FillLayer::Impl::hasZoomIndependentBuckets() const {
+    // Fill has no zoom-evaluated layout properties; the bucket depends on the
+    // zoom only through composite paint functions baked into the binders.
+    // Constant and camera-evaluated values live in uniforms instead.
+    return paint.evaluated.get<FillOpacity>().isZoomConstant()
+        && paint.evaluated.get<FillColor>().isZoomConstant()
+        && paint.evaluated.get<FillOutlineColor>().isZoomConstant();
+}
+
+bool FillLayer::Impl::hasDataDrivenPaint() const {
+    return paint.hasDataDrivenValue();
+}
+
 float FillLayer::Impl::getQueryRadius() const {
     const std::array<float, 2>& translate = paint.evaluated.get<FillTranslate>();
     return util::length(translate[0], translate[1]);
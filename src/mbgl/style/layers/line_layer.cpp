@@ -36,6 +36,10 @@ void LineLayer::Impl::stringifyLayout(rapidjson::Writer<rapidjson::StringBuffer>
     conversion::stringify(writer, layout);
 }
 
+void LineLayer::Impl::stringifyPaint(rapidjson::Writer<rapidjson::StringBuffer>& writer) const {
+    conversion::stringify(writer, paint);
+}
+
 // Source
 
 const std::string& LineLayer::getSourceID() const {
@@ -32,6 +32,10 @@ std::unique_ptr<Bucket> LineLayer::Impl::createBucket(const BucketParameters& pa
     return std::make_unique<LineBucket>(parameters, layers, layout);
 }
 
+bool LineLayer::Impl::hasDataDrivenPaint() const {
+    return paint.hasDataDrivenValue();
+}
+
 float LineLayer::Impl::getLineWidth() const {
     float lineWidth = paint.evaluated.get<LineWidth>();
     float gapWidth = paint.evaluated.get<LineGapWidth>().constantOr(0);
@@ -35,6 +35,10 @@ std::unique_ptr<Layer> RasterLayer::Impl::cloneRef(const std::string& id_) const
 void RasterLayer::Impl::stringifyLayout(rapidjson::Writer<rapidjson::StringBuffer>&) const {
 }
 
+void RasterLayer::Impl::stringifyPaint(rapidjson::Writer<rapidjson::StringBuffer>& writer) const {
+    conversion::stringify(writer, paint);
+}
+
 // Source
 
 const std::string& RasterLayer::getSourceID() const {
@@ -29,6 +29,10 @@ std::unique_ptr<Bucket> SymbolLayer::Impl::createBucket(const BucketParameters&,
     return nullptr;
 }
 
+bool SymbolLayer::Impl::hasDataDrivenPaint() const {
+    return paint.hasDataDrivenValue();
+}
+
 std::unique_ptr<SymbolLayout> SymbolLayer::Impl::createLayout(const BucketParameters& parameters,
                                                               const std::vector<const Layer*>& group,
                                                               const GeometryTileLayer& layer) const {
@@ -17,6 +17,7 @@
 
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 namespace mbgl {
 
@@ -35,7 +36,8 @@ public:
                              TimePoint now)
         : begin(now + transition.delay.value_or(Duration::zero())),
           end(begin + transition.duration.value_or(Duration::zero())),
-          value(std::move(value_)) {
+          value(std::move(value_)),
+          constant(value.isConstant()) {
         if (transition) {
             prior = { std::move(prior_) };
         }
@@ -43,6 +45,14 @@ public:
 
     template <class Evaluator>
     auto evaluate(const Evaluator& evaluator, TimePoint now) {
+        if (constant && !prior) {
+            // Fast path decided at cascade time: most properties in a typical
+            // style are plain constants, and re-dispatching through the value
+            // variant for them every frame shows up in zoom-animation
+            // profiles. Hand the constant straight to the evaluator instead.
+            return evaluator(value.asConstant());
+        }
+
         auto finalValue = value.evaluate(evaluator);
         if (!prior) {
             // No prior value.
@@ -78,6 +88,10 @@ private:
     TimePoint begin;
     TimePoint end;
     Value value;
+
+    // Whether `value` holds a plain constant; recorded once at cascade time
+    // so per-frame evaluation can skip the variant visit.
+    bool constant = false;
 };
 
 template <class Value>
@@ -95,10 +109,24 @@ public:
 
     void set(const Value& value_, const optional<std::string>& klass) {
         values[klass ? ClassDictionary::Get().lookup(*klass) : ClassID::Default] = value_;
+        snapshots.clear();
     }
 
     void setTransition(const TransitionOptions& transition, const optional<std::string>& klass) {
         transitions[klass ? ClassDictionary::Get().lookup(*klass) : ClassID::Default] = transition;
+        snapshots.clear();
+    }
+
+    // Whether any class currently carries a data-driven (source or composite
+    // function) value. Only instantiable when `Value` is a
+    // DataDrivenPropertyValue.
+    bool isDataDriven() const {
+        for (const auto& pair : values) {
+            if (pair.second.isDataDriven()) {
+                return true;
+            }
+        }
+        return false;
     }
 
     template <class UnevaluatedPaintProperty>
@@ -106,17 +134,39 @@ public:
         TransitionOptions transition;
         Value value;
 
-        for (const auto classID : params.classes) {
-            if (values.find(classID) != values.end()) {
-                value = values.at(classID);
-                break;
+        // Class switches re-cascade every property of every layer; reuse the
+        // resolution from the last time this class combination was cascaded,
+        // so only the transition wiring below runs.
+        const Snapshot* snapshot = nullptr;
+        if (params.classCombination) {
+            for (const auto& entry : snapshots) {
+                if (entry.combination == params.classCombination) {
+                    snapshot = &entry;
+                    break;
+                }
             }
         }
 
-        for (const auto classID : params.classes) {
-            if (transitions.find(classID) != transitions.end()) {
-                transition = transitions.at(classID).reverseMerge(transition);
-                break;
+        if (snapshot) {
+            value = snapshot->value;
+            transition = snapshot->transition;
+        } else {
+            for (const auto classID : params.classes) {
+                if (values.find(classID) != values.end()) {
+                    value = values.at(classID);
+                    break;
+                }
+            }
+
+            for (const auto classID : params.classes) {
+                if (transitions.find(classID) != transitions.end()) {
+                    transition = transitions.at(classID).reverseMerge(transition);
+                    break;
+                }
+            }
+
+            if (params.classCombination) {
+                snapshots.push_back({ params.classCombination, value, transition });
             }
         }
 
@@ -127,6 +177,17 @@ public:
     }
 
 private:
+    // A lazily built snapshot of the class resolution above for one class
+    // combination (see CascadeParameters::classCombination). Invalidated
+    // wholesale whenever a value or transition changes; mutable because the
+    // cache is an implementation detail of the const cascade().
+    struct Snapshot {
+        uint32_t combination;
+        Value value;
+        TransitionOptions transition;
+    };
+    mutable std::vector<Snapshot> snapshots;
+
     std::unordered_map<ClassID, Value> values;
     std::unordered_map<ClassID, TransitionOptions> transitions;
 };
@@ -235,6 +296,25 @@ public:
         return result;
     }
 
+    // Whether any data-driven-capable property currently holds a source or
+    // composite function. Buckets bake such values into their vertex data, so
+    // changing them requires re-layout rather than just a cascade.
+    bool hasDataDrivenValue() const {
+        bool result = false;
+        util::ignore({ (result = result || isDataDrivenValue<Ps>(IsDataDriven<Ps>()), 0)... });
+        return result;
+    }
+
+    template <class P>
+    bool isDataDrivenValue(std::true_type) const {
+        return cascading.template get<P>().isDataDriven();
+    }
+
+    template <class P>
+    bool isDataDrivenValue(std::false_type) const {
+        return false;
+    }
+
     Cascading cascading;
     Unevaluated unevaluated;
     Evaluated evaluated;
@@ -5,6 +5,9 @@
 #include <mbgl/gl/uniform.hpp>
 #include <mbgl/util/type_list.hpp>
 
+#include <map>
+#include <utility>
+
 namespace mbgl {
 namespace style {
 
@@ -20,6 +23,7 @@ public:
     }
 
     void populateVertexVector(const GeometryTileFeature&, std::size_t) {}
+    void shrinkToFit() {}
     void upload(gl::Context&) {}
 
     AttributeBinding minAttributeBinding(const PossiblyEvaluatedPropertyValue<T>& currentValue) const {
@@ -57,13 +61,33 @@ public:
 
     void populateVertexVector(const GeometryTileFeature& feature, std::size_t length) {
         AttributeValue value = Attribute::value(function.evaluate(feature, defaultValue));
+        if (!uniformValue) {
+            uniformValue = value;
+        }
+        if (vertexVector.vertexSize() == 0 && value == *uniformValue) {
+            // Every feature so far evaluated to the same value, a common case
+            // (e.g. a handful of distinct building colors across thousands of
+            // buildings). Defer building the per-vertex stream until a second
+            // distinct value shows up.
+            uniformVertexCount = length;
+            return;
+        }
+        for (std::size_t i = vertexVector.vertexSize(); i < uniformVertexCount; ++i) {
+            vertexVector.emplace_back(Vertex { *uniformValue });
+        }
         for (std::size_t i = vertexVector.vertexSize(); i < length; ++i) {
             vertexVector.emplace_back(Vertex { value });
         }
     }
 
+    void shrinkToFit() {
+        vertexVector.shrinkToFit();
+    }
+
     void upload(gl::Context& context) {
-        vertexBuffer = context.createVertexBuffer(std::move(vertexVector));
+        if (!vertexVector.empty()) {
+            vertexBuffer = context.createVertexBuffer(std::move(vertexVector));
+        }
     }
 
     AttributeBinding minAttributeBinding(const PossiblyEvaluatedPropertyValue<T>& currentValue) const {
@@ -71,6 +95,12 @@ public:
             return typename Attribute::ConstantBinding {
                 Attribute::value(*currentValue.constant())
             };
+        } else if (!vertexBuffer) {
+            // The whole bucket shares one evaluated value; bind it as a
+            // constant rather than a buffer full of identical vertices.
+            return typename Attribute::ConstantBinding {
+                uniformValue ? *uniformValue : AttributeValue()
+            };
         } else {
             return Attributes::allVariableBindings(*vertexBuffer)
                 .template get<Attribute>();
@@ -88,6 +118,8 @@ public:
 private:
     SourceFunction<T> function;
     T defaultValue;
+    optional<AttributeValue> uniformValue;
+    std::size_t uniformVertexCount = 0;
     gl::VertexVector<Vertex> vertexVector;
     optional<gl::VertexBuffer<Vertex>> vertexBuffer;
 };
@@ -112,16 +144,39 @@ public:
     }
 
     void populateVertexVector(const GeometryTileFeature& feature, std::size_t length) {
-        Range<T> range = function.evaluate(std::get<1>(coveringRanges), feature, defaultValue);
+        Range<T> range = evaluate(feature);
         AttributeValue min = Attribute::value(range.min);
         AttributeValue max = Attribute::value(range.max);
+        if (!uniformValue) {
+            uniformValue = std::make_pair(min, max);
+        }
+        if (vertexVector.vertexSize() == 0
+            && min == uniformValue->first && max == uniformValue->second) {
+            // Same deduplication as SourceFunctionPaintPropertyBinder: don't
+            // build the per-vertex stream while all features share one value.
+            uniformVertexCount = length;
+            return;
+        }
+        for (std::size_t i = vertexVector.vertexSize(); i < uniformVertexCount; ++i) {
+            vertexVector.emplace_back(Vertex { uniformValue->first, uniformValue->second });
+        }
         for (std::size_t i = vertexVector.vertexSize(); i < length; ++i) {
             vertexVector.emplace_back(Vertex { min, max });
         }
     }
 
+    void shrinkToFit() {
+        vertexVector.shrinkToFit();
+        // The evaluation memo only serves populateVertexVector(); its keys
+        // are feature property values, including strings, so drop it with
+        // the rest of the slack.
+        memo.clear();
+    }
+
     void upload(gl::Context& context) {
-        vertexBuffer = context.createVertexBuffer(std::move(vertexVector));
+        if (!vertexVector.empty()) {
+            vertexBuffer = context.createVertexBuffer(std::move(vertexVector));
+        }
     }
 
     AttributeBinding minAttributeBinding(const PossiblyEvaluatedPropertyValue<T>& currentValue) const {
@@ -129,6 +184,10 @@ public:
             return typename Attribute::ConstantBinding {
                 Attribute::value(*currentValue.constant())
             };
+        } else if (!vertexBuffer) {
+            return typename Attribute::ConstantBinding {
+                uniformValue ? uniformValue->first : AttributeValue()
+            };
         } else {
             return Attributes::allVariableBindings(*vertexBuffer)
                 .template get<MinAttribute>();
@@ -138,6 +197,10 @@ public:
     AttributeBinding maxAttributeBinding(const PossiblyEvaluatedPropertyValue<T>& currentValue) const {
         if (currentValue.isConstant()) {
             return AttributeBinding();
+        } else if (!vertexBuffer) {
+            return typename Attribute::ConstantBinding {
+                uniformValue ? uniformValue->second : AttributeValue()
+            };
         } else {
             return Attributes::allVariableBindings(*vertexBuffer)
                 .template get<MaxAttribute>();
@@ -150,9 +213,44 @@ public:
 
 private:
     using InnerStops = typename CompositeFunction<T>::InnerStops;
+
+    // Only scalar feature values — the kind stops actually key on — are
+    // memoizable; Value's container alternatives are not comparable.
+    using MemoKey = variant<bool, int64_t, uint64_t, double, std::string>;
+
+    static optional<MemoKey> memoKey(const Value& value) {
+        return value.match(
+            [] (bool v) -> optional<MemoKey> { return MemoKey(v); },
+            [] (int64_t v) -> optional<MemoKey> { return MemoKey(v); },
+            [] (uint64_t v) -> optional<MemoKey> { return MemoKey(v); },
+            [] (double v) -> optional<MemoKey> { return MemoKey(v); },
+            [] (const std::string& v) -> optional<MemoKey> { return MemoKey(v); },
+            [] (const auto&) -> optional<MemoKey> { return {}; });
+    }
+
+    Range<T> evaluate(const GeometryTileFeature& feature) {
+        // A bucket typically holds thousands of features sharing a handful of
+        // distinct property values (road classes, admin levels, ranks); run
+        // the stop lookups only once per distinct value.
+        optional<Value> value = feature.getValue(function.property);
+        optional<MemoKey> key = value ? memoKey(*value) : optional<MemoKey>();
+        if (!key) {
+            return function.evaluate(std::get<1>(coveringRanges), value, defaultValue);
+        }
+        auto it = memo.find(*key);
+        if (it == memo.end()) {
+            Range<T> range = function.evaluate(std::get<1>(coveringRanges), value, defaultValue);
+            it = memo.emplace(std::move(*key), std::move(range)).first;
+        }
+        return it->second;
+    }
+
     CompositeFunction<T> function;
     T defaultValue;
     std::tuple<Range<float>, Range<InnerStops>> coveringRanges;
+    std::map<MemoKey, Range<T>> memo;
+    optional<std::pair<AttributeValue, AttributeValue>> uniformValue;
+    std::size_t uniformVertexCount = 0;
     gl::VertexVector<Vertex> vertexVector;
     optional<gl::VertexBuffer<Vertex>> vertexBuffer;
 };
@@ -189,6 +287,12 @@ public:
         });
     }
 
+    void shrinkToFit() {
+        binder.match([] (auto& b) {
+            b.shrinkToFit();
+        });
+    }
+
     void upload(gl::Context& context) {
         binder.match([&] (auto& b) {
             b.upload(context);
@@ -246,6 +350,12 @@ public:
         });
     }
 
+    void shrinkToFit() {
+        util::ignore({
+            (binders.template get<Ps>().shrinkToFit(), 0)...
+        });
+    }
+
     void upload(gl::Context& context) {
         util::ignore({
             (binders.template get<Ps>().upload(context), 0)...
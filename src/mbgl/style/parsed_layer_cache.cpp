@@ -0,0 +1,40 @@
+#include <mbgl/style/parsed_layer_cache.hpp>
+#include <mbgl/style/layer.hpp>
+#include <mbgl/style/layer_impl.hpp>
+
+namespace mbgl {
+namespace style {
+
+ParsedLayerCache& ParsedLayerCache::Get() {
+    static ParsedLayerCache cache;
+    return cache;
+}
+
+bool ParsedLayerCache::get(const std::string& json, std::vector<std::unique_ptr<Layer>>& out) {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    auto it = cache.find(json);
+    if (it == cache.end()) {
+        return false;
+    }
+
+    out.reserve(it->second.size());
+    for (const auto& layer : it->second) {
+        out.push_back(layer->baseImpl->clone());
+    }
+    return true;
+}
+
+void ParsedLayerCache::put(const std::string& json, const std::vector<std::unique_ptr<Layer>>& layers) {
+    std::vector<std::unique_ptr<Layer>> prototypes;
+    prototypes.reserve(layers.size());
+    for (const auto& layer : layers) {
+        prototypes.push_back(layer->baseImpl->clone());
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    cache[json] = std::move(prototypes);
+}
+
+} // namespace style
+} // namespace mbgl
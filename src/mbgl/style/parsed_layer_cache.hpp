@@ -0,0 +1,44 @@
+#pragma once
+
+#include <mbgl/util/noncopyable.hpp>
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace mbgl {
+namespace style {
+
+class Layer;
+
+/*
+    Process-wide cache of converted layer objects, keyed by the stylesheet
+    they were parsed from. Converting the layers array through rapidjson and
+    the conversion machinery dominates style parse time, and a pooled map or
+    a multi-map setup re-runs it for the identical stylesheet on every
+    setJSON. The cache keeps one set of layer prototypes per stylesheet and
+    hands out deep clones, so repeated loads of the same style pay only for
+    the clones. Entries live for the lifetime of the process. Thread-safe.
+*/
+class ParsedLayerCache : private util::noncopyable {
+public:
+    static ParsedLayerCache& Get();
+
+    // Fills `out` with clones of the cached layer prototypes for this
+    // stylesheet. Returns false if this stylesheet hasn't been parsed before.
+    bool get(const std::string& json, std::vector<std::unique_ptr<Layer>>& out);
+
+    // Stores clones of the given layers as prototypes for this stylesheet.
+    void put(const std::string& json, const std::vector<std::unique_ptr<Layer>>& layers);
+
+private:
+    ParsedLayerCache() = default;
+
+    std::mutex mutex;
+    std::map<std::string, std::vector<std::unique_ptr<Layer>>> cache;
+};
+
+} // namespace style
+} // namespace mbgl
@@ -11,6 +11,8 @@
 
 #include <rapidjson/document.h>
 #include <rapidjson/error/en.h>
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
 
 #include <algorithm>
 #include <set>
@@ -22,7 +24,17 @@ namespace style {
 Parser::~Parser() = default;
 
 StyleParseResult Parser::parse(const std::string& json) {
-    rapidjson::GenericDocument<rapidjson::UTF8<>, rapidjson::CrtAllocator> document;
+    auto result = parseExceptLayers(json);
+    if (result) {
+        return result;
+    }
+
+    parseLayers();
+
+    return nullptr;
+}
+
+StyleParseResult Parser::parseExceptLayers(const std::string& json) {
     document.Parse<0>(json.c_str());
 
     if (document.HasParseError()) {
@@ -83,11 +95,12 @@ StyleParseResult Parser::parse(const std::string& json) {
     }
 
     if (document.HasMember("sources")) {
-        parseSources(document["sources"]);
-    }
-
-    if (document.HasMember("layers")) {
-        parseLayers(document["layers"]);
+        const JSValue& sourcesValue = document["sources"];
+        rapidjson::StringBuffer buffer;
+        rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+        sourcesValue.Accept(writer);
+        sourcesJSON = buffer.GetString();
+        parseSources(sourcesValue);
     }
 
     if (document.HasMember("sprite")) {
@@ -107,6 +120,12 @@ StyleParseResult Parser::parse(const std::string& json) {
     return nullptr;
 }
 
+void Parser::parseLayers() {
+    if (document.IsObject() && document.HasMember("layers")) {
+        parseLayers(document["layers"]);
+    }
+}
+
 void Parser::parseSources(const JSValue& value) {
     if (!value.IsObject()) {
         Log::Warning(Event::ParseStyle, "sources must be an object");
@@ -25,9 +25,22 @@ public:
 
     StyleParseResult parse(const std::string&);
 
+    // Two-phase alternative to parse() for large styles: parseExceptLayers()
+    // handles the document and everything but the layers array — typically
+    // the bulk of a big style — leaving `sources` populated, so the caller
+    // can start source description loads before the expensive layer
+    // conversion runs in parseLayers().
+    StyleParseResult parseExceptLayers(const std::string&);
+    void parseLayers();
+
     std::string spriteURL;
     std::string glyphURL;
 
+    // Verbatim serialization of the stylesheet's `sources` object, so callers
+    // can detect whether the sources changed between stylesheet versions
+    // without comparing parsed Source objects.
+    std::string sourcesJSON;
+
     std::vector<std::unique_ptr<Source>> sources;
     std::vector<std::unique_ptr<Layer>> layers;
 
@@ -45,6 +58,9 @@ private:
     void parseLayers(const JSValue&);
     void parseLayer(const std::string& id, const JSValue&, std::unique_ptr<Layer>&);
 
+    // Kept across the two parsing phases; layersMap holds references into it.
+    JSDocument document;
+
     std::unordered_map<std::string, const Source*> sourcesMap;
     std::unordered_map<std::string, std::pair<const JSValue&, std::unique_ptr<Layer>>> layersMap;
 
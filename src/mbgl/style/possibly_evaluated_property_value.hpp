@@ -29,6 +29,13 @@ public:
         return value.template is<T>();
     }
 
+    // Whether evaluating this value per feature yields the same result at
+    // every zoom level. Only composite functions interpolate along the zoom
+    // axis; constants and source functions do not.
+    bool isZoomConstant() const {
+        return !value.template is<CompositeFunction<T>>();
+    }
+
     optional<T> constant() const {
         return value.match(
             [&] (const T& t) { return optional<T>(t); },
@@ -15,6 +15,12 @@ public:
     const ScreenLineString& geometry;
     const TransformState& transformState;
     const optional<std::vector<std::string>>& layerIDs;
+
+    // Stop querying further tiles and sources once at least this many
+    // features have been collected; the final result is truncated to it.
+    // Bounds the cost of hit testing, where only the first few matches
+    // matter.
+    optional<uint32_t> limit;
 };
 
 } // namespace style
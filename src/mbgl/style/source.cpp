@@ -18,5 +18,13 @@ optional<std::string> Source::getAttribution() const {
     return baseImpl->getAttribution();
 }
 
+void Source::setPrefetchLowZoomAncestors(bool prefetch) {
+    baseImpl->prefetchLowZoomAncestors = prefetch;
+}
+
+bool Source::getPrefetchLowZoomAncestors() const {
+    return baseImpl->prefetchLowZoomAncestors;
+}
+
 } // namespace style
 } // namespace mbgl
@@ -9,6 +9,7 @@
 #include <mbgl/util/logging.hpp>
 #include <mbgl/math/clamp.hpp>
 #include <mbgl/util/tile_cover.hpp>
+#include <mbgl/util/tile_coordinate.hpp>
 #include <mbgl/util/enum.hpp>
 
 #include <mbgl/algorithm/update_renderables.hpp>
@@ -18,6 +19,8 @@
 #include <mapbox/geometry/envelope.hpp>
 
 #include <algorithm>
+#include <cmath>
+#include <set>
 
 namespace mbgl {
 namespace style {
@@ -47,30 +50,31 @@ bool Source::Impl::isLoaded() const {
 
 void Source::Impl::invalidateTiles() {
     tiles.clear();
+    prefetchedTiles.clear();
     renderTiles.clear();
     cache.clear();
 }
 
-void Source::Impl::startRender(algorithm::ClipIDGenerator& generator,
-                         const mat4& projMatrix,
-                         const TransformState& transform) {
+void Source::Impl::startRender(const mat4& projMatrix, const TransformState& transform) {
+    for (auto& pair : renderTiles) {
+        auto& tile = pair.second;
+        matrix::multiply(tile.matrix, projMatrix, transform.tileTransform(tile.id));
+    }
+}
+
+void Source::Impl::updateClipIDs(algorithm::ClipIDGenerator& generator) {
     if (type == SourceType::Vector ||
         type == SourceType::GeoJSON ||
         type == SourceType::Annotations) {
         generator.update(renderTiles);
     }
-
-    for (auto& pair : renderTiles) {
-        auto& tile = pair.second;
-        transform.matrixFor(tile.matrix, tile.id);
-        matrix::multiply(tile.matrix, projMatrix, tile.matrix);
-    }
 }
 
 void Source::Impl::finishRender(Painter& painter) {
     for (auto& pair : renderTiles) {
         auto& tile = pair.second;
         if (tile.used) {
+            tile.tile.markRendered();
             painter.renderTileDebug(tile);
         }
     }
@@ -101,17 +105,32 @@ void Source::Impl::updateTiles(const UpdateParameters& parameters) {
             tileZoom = idealZoom;
         }
 
-        idealTiles = util::tileCover(parameters.transformState, idealZoom);
+        // The cover is sorted by distance from the viewport center, and
+        // updateRenderables below creates tiles (and thereby issues their
+        // network requests) in that order. OnlineFileSource activates pending
+        // requests of equal priority in arrival order, so under request
+        // saturation the tile the user is looking at loads first. Keep this
+        // chain in mind before reordering any of these steps.
+        auto cached = parameters.tileCoverCache.find(idealZoom);
+        if (cached == parameters.tileCoverCache.end()) {
+            cached = parameters.tileCoverCache
+                         .emplace(idealZoom, util::tileCover(parameters.transformState, idealZoom))
+                         .first;
+        }
+        idealTiles = cached->second;
     }
 
     // Stores a list of all the tiles that we're definitely going to retain. There are two
     // kinds of tiles we need: the ideal tiles determined by the tile cover. They may not yet be in
     // use because they're still loading. In addition to that, we also need to retain all tiles that
     // we're actively using, e.g. as a replacement for tile that aren't loaded yet.
-    std::set<OverscaledTileID> retain;
+    // A flat vector rather than a std::set: it holds a few dozen entries,
+    // is rebuilt every frame, and is sorted once after collection for the
+    // binary searches and the lockstep merge in removeStaleTiles.
+    std::vector<OverscaledTileID> retain;
 
     auto retainTileFn = [&retain](Tile& tile, Resource::Necessity necessity) -> void {
-        retain.emplace(tile.id);
+        retain.push_back(tile.id);
         tile.setNecessity(necessity);
     };
     auto getTileFn = [this](const OverscaledTileID& tileID) -> Tile* {
@@ -120,10 +139,28 @@ void Source::Impl::updateTiles(const UpdateParameters& parameters) {
     };
     auto createTileFn = [this, &parameters](const OverscaledTileID& tileID) -> Tile* {
         std::unique_ptr<Tile> tile = cache.get(tileID);
+        if (!tile) {
+            auto prefetched = prefetchedTiles.find(tileID);
+            if (prefetched != prefetchedTiles.end()) {
+                tile = std::move(prefetched->second);
+                prefetchedTiles.erase(prefetched);
+            }
+        }
         if (!tile) {
             tile = createTile(tileID, parameters);
             if (tile) {
                 tile->setObserver(this);
+                // When a tile covering the same canonical data at another
+                // overscaled zoom is still alive — typical while zooming
+                // through an overzoom range — the new tile can adopt its
+                // zoom-independent layout output instead of recomputing it.
+                for (auto& pair : tiles) {
+                    if (pair.first.canonical == tileID.canonical &&
+                        pair.first.overscaledZ != tileID.overscaledZ) {
+                        tile->inheritLayout(*pair.second);
+                        break;
+                    }
+                }
             }
         }
         if (!tile) {
@@ -131,14 +168,79 @@ void Source::Impl::updateTiles(const UpdateParameters& parameters) {
         }
         return tiles.emplace(tileID, std::move(tile)).first->second.get();
     };
-    auto renderTileFn = [this](const UnwrappedTileID& tileID, Tile& tile) {
-        renderTiles.emplace(tileID, RenderTile{ tileID, tile });
+    std::map<UnwrappedTileID, RenderTile> newRenderTiles;
+    auto renderTileFn = [&](const UnwrappedTileID& tileID, Tile& tile) {
+        newRenderTiles.emplace(tileID, RenderTile{ tileID, tile });
     };
 
-    renderTiles.clear();
     algorithm::updateRenderables(getTileFn, createTileFn, retainTileFn, renderTileFn,
                                  idealTiles, zoomRange, tileZoom);
 
+    // Keep the existing RenderTiles — and the clip IDs already assigned to
+    // them — when the renderable set is unchanged, so the painter can reuse
+    // the previous frame's stencil computation. Camera-only updates hit this
+    // path on every frame of a movement.
+    const bool renderablesChanged =
+        newRenderTiles.size() != renderTiles.size() ||
+        !std::equal(newRenderTiles.begin(), newRenderTiles.end(), renderTiles.begin(),
+                    [](const auto& a, const auto& b) {
+                        return a.first == b.first && &a.second.tile == &b.second.tile;
+                    });
+    if (renderablesChanged) {
+        renderTiles = std::move(newRenderTiles);
+    }
+
+    std::sort(retain.begin(), retain.end());
+    retain.erase(std::unique(retain.begin(), retain.end()), retain.end());
+
+    // The ancestor loop below may append to `retain` past this point; the
+    // binary searches are limited to the prefix that is known to be sorted.
+    const std::size_t sortedRetain = retain.size();
+
+    if (prefetchLowZoomAncestors && !idealTiles.empty() &&
+        (type == SourceType::Vector || type == SourceType::Raster)) {
+        // Also fetch and retain the low-zoom ancestors of the cover. They cost
+        // a few dozen kilobytes, but updateRenderables' parent-fallback path
+        // can then always draw an approximation of an area that has never been
+        // viewed, instead of the background color. Requested at low priority
+        // so they queue behind the ideal tiles above.
+        const uint8_t maxAncestorZoom = 5;
+
+        UpdateParameters ancestorParameters = parameters;
+        ancestorParameters.tilePriority = Resource::Priority::Low;
+
+        for (const auto& idealTile : idealTiles) {
+            for (int32_t z = zoomRange.min; z <= maxAncestorZoom && z < idealTile.canonical.z; ++z) {
+                const OverscaledTileID ancestorID(z, idealTile.canonical.scaledTo(z));
+                if (std::binary_search(retain.begin(), retain.begin() + sortedRetain, ancestorID)) {
+                    continue;
+                }
+                Tile* tile = getTileFn(ancestorID);
+                if (!tile) {
+                    std::unique_ptr<Tile> created = cache.get(ancestorID);
+                    if (!created) {
+                        auto prefetched = prefetchedTiles.find(ancestorID);
+                        if (prefetched != prefetchedTiles.end()) {
+                            created = std::move(prefetched->second);
+                            prefetchedTiles.erase(prefetched);
+                        }
+                    }
+                    if (!created) {
+                        created = createTile(ancestorID, ancestorParameters);
+                        if (created) {
+                            created->setObserver(this);
+                        }
+                    }
+                    if (!created) {
+                        continue;
+                    }
+                    tile = tiles.emplace(ancestorID, std::move(created)).first->second.get();
+                }
+                retainTileFn(*tile, Resource::Necessity::Required);
+            }
+        }
+    }
+
     if (type != SourceType::Annotations) {
         size_t conservativeCacheSize =
             std::max((float)parameters.transformState.getSize().width / tileSize, 1.0f) *
@@ -148,21 +250,240 @@ void Source::Impl::updateTiles(const UpdateParameters& parameters) {
         cache.setSize(conservativeCacheSize);
     }
 
+    if (retain.size() != sortedRetain) {
+        std::sort(retain.begin(), retain.end());
+    }
+
     removeStaleTiles(retain);
 
-    const PlacementConfig config { parameters.transformState.getAngle(),
-                                   parameters.transformState.getPitch(),
+    float placementAngle = parameters.transformState.getAngle();
+    float placementPitch = parameters.transformState.getPitch();
+    if (parameters.placementAngleQuantization > 0) {
+        // Under a degraded quality level, snap the placement trigger to a
+        // coarse grid: a slow rotation then crosses far fewer placement
+        // boundaries, at the cost of labels rotating in visible steps.
+        const float quantization = parameters.placementAngleQuantization;
+        placementAngle = std::round(placementAngle / quantization) * quantization;
+        placementPitch = std::round(placementPitch / quantization) * quantization;
+    }
+
+    const PlacementConfig config { placementAngle,
+                                   placementPitch,
                                    parameters.debugOptions & MapDebugOptions::Collision };
 
+    dispatchPlacement(config, parameters);
+
+    if (parameters.prefetchTransformState) {
+        prefetchTiles(parameters);
+    } else if (!prefetchedTiles.empty()) {
+        // The camera stopped; whatever the prediction was still loading is no
+        // longer worth the bandwidth.
+        prefetchedTiles.clear();
+    }
+
+    // Raster display during fast pans is gated by decode time rather than the
+    // network once tiles are in the cache; decode the cover's neighbors ahead.
+    if (type == SourceType::Raster && parameters.allowSpeculativeWork) {
+        decodeAhead(parameters, idealTiles);
+    }
+}
+
+// Hands a new placement configuration to a bounded number of tiles per update
+// rather than to all of them at once. A rotation invalidates the placement of
+// every tile simultaneously, and dispatching them in one burst saturates the
+// workers and starves freshly arrived tiles of layout time for up to a second.
+// Tiles receive the configuration in order of distance from the viewport
+// center, so the labels the user is looking at settle first; the remainder
+// drains on subsequent updates — each completed placement triggers a repaint,
+// which runs the next update.
+void Source::Impl::dispatchPlacement(const PlacementConfig& config,
+                                     const UpdateParameters& parameters) {
+    std::vector<Tile*> pending;
     for (auto& pair : tiles) {
-        pair.second->setPlacementConfig(config);
+        if (pair.second->needsPlacement(config)) {
+            pending.push_back(pair.second.get());
+        }
+    }
+
+    // A handful of placements roughly fills one frame interval on the default
+    // worker pool; dispatching more would only queue ahead of new-tile layout.
+    static constexpr std::size_t placementBudget = 4;
+
+    // Still renders have no frame cadence to pace against — the sooner the
+    // workers saturate, the sooner the image is done.
+    if (parameters.mode != MapMode::Still && pending.size() > placementBudget) {
+        const TileCoordinatePoint center =
+            TileCoordinate::fromLatLng(0, parameters.transformState.getLatLng()).p;
+
+        auto sqDist = [&center](const Tile* tile) {
+            const double scale = 1 << tile->id.canonical.z;
+            double dx = (tile->id.canonical.x + 0.5) / scale - center.x;
+            const double dy = (tile->id.canonical.y + 0.5) / scale - center.y;
+            // The world wraps in x; measure across the antimeridian when
+            // that is shorter.
+            dx -= std::round(dx);
+            return dx * dx + dy * dy;
+        };
+
+        std::partial_sort(pending.begin(), pending.begin() + placementBudget, pending.end(),
+                          [&](const Tile* a, const Tile* b) { return sqDist(a) < sqDist(b); });
+        pending.resize(placementBudget);
+    }
+
+    for (Tile* tile : pending) {
+        tile->setPlacementConfig(config);
     }
 }
 
-// Moves all tiles to the cache except for those specified in the retain set.
-void Source::Impl::removeStaleTiles(const std::set<OverscaledTileID>& retain) {
-    // Remove stale tiles. This goes through the (sorted!) tiles map and retain set in lockstep
-    // and removes items from tiles that don't have the corresponding key in the retain set.
+// Creates tiles for the cover of the extrapolated camera position, requested at
+// low priority so they queue behind the tiles the user is actually looking at.
+void Source::Impl::prefetchTiles(const UpdateParameters& parameters) {
+    // Locally generated sources have no network requests to get ahead of, and
+    // speculatively parsing them would steal worker time from visible tiles.
+    if (type != SourceType::Vector && type != SourceType::Raster) {
+        return;
+    }
+
+    const TransformState& predictedState = *parameters.prefetchTransformState;
+    const Range<uint8_t> zoomRange = getZoomRange();
+
+    int32_t overscaledZoom = util::coveringZoomLevel(predictedState.getZoom(), type, getTileSize());
+    if (overscaledZoom < zoomRange.min) {
+        prefetchedTiles.clear();
+        return;
+    }
+
+    int32_t idealZoom = std::min<int32_t>(zoomRange.max, overscaledZoom);
+    int32_t tileZoom = type == SourceType::Raster ? idealZoom : overscaledZoom;
+
+    UpdateParameters prefetchParameters = parameters;
+    prefetchParameters.tilePriority = Resource::Priority::Low;
+
+    std::set<OverscaledTileID> predicted;
+    for (const auto& unwrappedTileID : util::tileCover(predictedState, idealZoom)) {
+        const OverscaledTileID tileID(tileZoom, unwrappedTileID.canonical);
+        predicted.emplace(tileID);
+
+        if (tiles.find(tileID) != tiles.end() || cache.has(tileID) ||
+            prefetchedTiles.find(tileID) != prefetchedTiles.end()) {
+            continue;
+        }
+
+        std::unique_ptr<Tile> tile = createTile(tileID, prefetchParameters);
+        if (!tile) {
+            continue;
+        }
+        tile->setObserver(this);
+        tile->setNecessity(Tile::Necessity::Required);
+        prefetchedTiles.emplace(tileID, std::move(tile));
+    }
+
+    // Drop prefetched tiles the prediction no longer covers, and move completed
+    // ones into the cache where createTileFn will pick them up.
+    auto it = prefetchedTiles.begin();
+    while (it != prefetchedTiles.end()) {
+        if (predicted.find(it->first) == predicted.end()) {
+            prefetchedTiles.erase(it++);
+        } else if (it->second->isComplete()) {
+            it->second->setNecessity(Tile::Necessity::Optional);
+            cache.add(it->first, std::move(it->second));
+            prefetchedTiles.erase(it++);
+        } else {
+            ++it;
+        }
+    }
+}
+
+// Speculatively decodes raster tiles bordering the viewport. The loads stay at
+// Necessity::Optional, so they are served from the cache and never touch the
+// network; only tiles whose payload is already cached pay the decode, which
+// runs on the workers at low priority behind visible tiles. Completed tiles
+// move into the tile cache, where the regular update picks them up the moment
+// a pan brings them into the cover — without the 10-20ms decode stall.
+void Source::Impl::decodeAhead(const UpdateParameters& parameters,
+                               const std::vector<UnwrappedTileID>& idealTiles) {
+    // Without optional requests there is no cache-only load; a speculative
+    // tile would just sit idle until evicted.
+    if (idealTiles.empty() || !parameters.fileSource.supportsOptionalRequests()) {
+        decodeAheadTiles.clear();
+        return;
+    }
+
+    // A decoded tile costs tileSize² RGBA in memory until the cache evicts
+    // it; cap the in-flight ring to a fixed byte budget.
+    static constexpr std::size_t decodeAheadBudget = 8 * 1024 * 1024;
+    const std::size_t perTileBytes = std::size_t(getTileSize()) * getTileSize() * 4;
+    const std::size_t maxTiles = decodeAheadBudget / perTileBytes;
+
+    // The ring: direct neighbors of the cover that are not themselves part of
+    // it. Wrapped duplicates collapse in the OverscaledTileID set. Rows above
+    // and below the tile pyramid are skipped up front — the UnwrappedTileID
+    // constructor would clamp them onto an existing row.
+    const std::set<UnwrappedTileID> cover(idealTiles.begin(), idealTiles.end());
+    std::set<OverscaledTileID> ring;
+    for (const auto& id : idealTiles) {
+        const int64_t maxRow = 1ll << id.canonical.z;
+        for (int32_t dx = -1; dx <= 1; ++dx) {
+            for (int32_t dy = -1; dy <= 1; ++dy) {
+                if (dx == 0 && dy == 0) {
+                    continue;
+                }
+                const int64_t y = int64_t(id.canonical.y) + dy;
+                if (y < 0 || y >= maxRow) {
+                    continue;
+                }
+                const int64_t x = (int64_t(id.wrap) << id.canonical.z) + id.canonical.x + dx;
+                const UnwrappedTileID neighbor(id.canonical.z, x, y);
+                if (cover.find(neighbor) == cover.end()) {
+                    ring.emplace(neighbor.canonical.z, neighbor.canonical);
+                }
+            }
+        }
+    }
+
+    UpdateParameters decodeParameters = parameters;
+    decodeParameters.tilePriority = Resource::Priority::Low;
+
+    for (const auto& tileID : ring) {
+        if (decodeAheadTiles.size() >= maxTiles) {
+            break;
+        }
+        if (tiles.find(tileID) != tiles.end() || cache.has(tileID) ||
+            prefetchedTiles.find(tileID) != prefetchedTiles.end() ||
+            decodeAheadTiles.find(tileID) != decodeAheadTiles.end()) {
+            continue;
+        }
+
+        std::unique_ptr<Tile> tile = createTile(tileID, decodeParameters);
+        if (!tile) {
+            continue;
+        }
+        tile->setObserver(this);
+        // Necessity stays Optional: the loader issues a cache-only request
+        // and never escalates to the network.
+        decodeAheadTiles.emplace(tileID, std::move(tile));
+    }
+
+    // Drop speculative tiles the viewport has moved away from, and move
+    // completed ones into the cache.
+    auto it = decodeAheadTiles.begin();
+    while (it != decodeAheadTiles.end()) {
+        if (ring.find(it->first) == ring.end()) {
+            decodeAheadTiles.erase(it++);
+        } else if (it->second->isComplete()) {
+            cache.add(it->first, std::move(it->second));
+            decodeAheadTiles.erase(it++);
+        } else {
+            ++it;
+        }
+    }
+}
+
+// Moves all tiles to the cache except for those specified in the retain list,
+// which must be sorted (duplicates are fine).
+void Source::Impl::removeStaleTiles(const std::vector<OverscaledTileID>& retain) {
+    // Remove stale tiles. This goes through the (sorted!) tiles map and retain list in lockstep
+    // and removes items from tiles that don't have the corresponding key in the retain list.
     auto tilesIt = tiles.begin();
     auto retainIt = retain.begin();
     while (tilesIt != tiles.end()) {
@@ -181,6 +502,7 @@ void Source::Impl::removeStaleTiles(const std::set<OverscaledTileID>& retain) {
 
 void Source::Impl::removeTiles() {
     renderTiles.clear();
+    prefetchedTiles.clear();
     if (!tiles.empty()) {
         removeStaleTiles({});
     }
@@ -247,6 +569,16 @@ std::unordered_map<std::string, std::vector<Feature>> Source::Impl::queryRendere
                                               tileSpaceQueryGeometry,
                                               parameters.transformState,
                                               parameters.layerIDs);
+
+        if (parameters.limit) {
+            std::size_t count = 0;
+            for (const auto& entry : result) {
+                count += entry.second.size();
+            }
+            if (count >= *parameters.limit) {
+                break;
+            }
+        }
     }
 
     return result;
@@ -257,6 +589,7 @@ void Source::Impl::setCacheSize(size_t size) {
 }
 
 void Source::Impl::onLowMemory() {
+    prefetchedTiles.clear();
     cache.clear();
 }
 
@@ -58,9 +58,8 @@ public:
     // data with fresh style information.
     void reloadTiles();
 
-    void startRender(algorithm::ClipIDGenerator&,
-                     const mat4& projMatrix,
-                     const TransformState&);
+    void startRender(const mat4& projMatrix, const TransformState&);
+    void updateClipIDs(algorithm::ClipIDGenerator&);
     void finishRender(Painter&);
 
     std::map<UnwrappedTileID, RenderTile>& getRenderTiles();
@@ -86,15 +85,31 @@ public:
     // called before Style::recalculate().
     bool enabled = true;
 
+    // See Source::setPrefetchLowZoomAncestors().
+    bool prefetchLowZoomAncestors = false;
+
 protected:
     void invalidateTiles();
-    void removeStaleTiles(const std::set<OverscaledTileID>&);
+    void removeStaleTiles(const std::vector<OverscaledTileID>&);
+    void dispatchPlacement(const PlacementConfig&, const UpdateParameters&);
+    void prefetchTiles(const UpdateParameters&);
+    void decodeAhead(const UpdateParameters&, const std::vector<UnwrappedTileID>& idealTiles);
 
     Source& base;
     SourceObserver* observer = nullptr;
     std::map<OverscaledTileID, std::unique_ptr<Tile>> tiles;
     TileCache cache;
 
+    // Tiles speculatively created for an extrapolated camera position. They are
+    // never rendered from; once complete they move into the cache, where the
+    // regular update finds them when the camera arrives.
+    std::map<OverscaledTileID, std::unique_ptr<Tile>> prefetchedTiles;
+
+    // Raster tiles bordering the viewport, loaded cache-only so they decode
+    // ahead of a pan without touching the network. Like prefetched tiles, they
+    // move into the cache once complete.
+    std::map<OverscaledTileID, std::unique_ptr<Tile>> decodeAheadTiles;
+
 private:
     // TileObserver implementation.
     void onTileChanged(Tile&) override;
@@ -18,6 +18,18 @@ void GeoJSONSource::setGeoJSON(const mapbox::geojson::geojson& geoJSON) {
     impl->setGeoJSON(geoJSON);
 }
 
+void GeoJSONSource::appendFeatures(FeatureCollection features) {
+    impl->appendFeatures(std::move(features));
+}
+
+void GeoJSONSource::updateFeature(Feature feature) {
+    impl->updateFeature(std::move(feature));
+}
+
+void GeoJSONSource::removeFeature(const FeatureIdentifier& id) {
+    impl->removeFeature(id);
+}
+
 optional<std::string> GeoJSONSource::getURL() const {
     return impl->getURL();
 }
@@ -5,15 +5,19 @@
 #include <mbgl/style/sources/geojson_source_impl.hpp>
 #include <mbgl/tile/geojson_tile.hpp>
 #include <mbgl/util/rapidjson.hpp>
+#include <mbgl/util/thread.hpp>
+#include <mbgl/util/tile_coordinate.hpp>
 
 #include <mapbox/geojson.hpp>
 #include <mapbox/geojson/rapidjson.hpp>
+#include <mapbox/geometry/envelope.hpp>
 #include <mapbox/geojsonvt.hpp>
 #include <mapbox/geojsonvt/convert.hpp>
 #include <supercluster.hpp>
 
 #include <rapidjson/error/en.h>
 
+#include <iterator>
 #include <sstream>
 
 namespace mbgl {
@@ -30,6 +34,68 @@ Result<GeoJSON> convertGeoJSON(const JSValue& value) {
 }
 } // namespace conversion
 
+namespace {
+
+GeoJSONIndex buildIndex(const GeoJSON& geoJSON, const GeoJSONOptions& options) {
+    double scale = util::EXTENT / util::tileSize;
+
+    if (options.cluster
+        && geoJSON.is<mapbox::geometry::feature_collection<double>>()
+        && !geoJSON.get<mapbox::geometry::feature_collection<double>>().empty()) {
+        mapbox::supercluster::Options clusterOptions;
+        clusterOptions.minZoom = options.clusterMinZoom;
+        clusterOptions.maxZoom = options.clusterMaxZoom;
+        clusterOptions.extent = util::EXTENT;
+        clusterOptions.radius = std::round(scale * options.clusterRadius);
+
+        const auto& features = geoJSON.get<mapbox::geometry::feature_collection<double>>();
+        return std::make_unique<mapbox::supercluster::Supercluster>(features, clusterOptions);
+    } else {
+        mapbox::geojsonvt::Options vtOptions;
+        vtOptions.maxZoom = options.maxzoom;
+        vtOptions.extent = util::EXTENT;
+        vtOptions.buffer = std::round(scale * options.buffer);
+        vtOptions.tolerance = scale * options.tolerance;
+        return std::make_unique<mapbox::geojsonvt::GeoJSONVT>(geoJSON, vtOptions);
+    }
+}
+
+// Whether a tile's contents can be affected by changes within the given
+// bounds, accounting for the tile buffer: features just outside a tile's
+// boundary still contribute geometry to it.
+void extendBounds(optional<LatLngBounds>& bounds, const mapbox::geometry::geometry<double>& geometry) {
+    if (!bounds) {
+        bounds = LatLngBounds::empty();
+    }
+    const auto box = mapbox::geometry::envelope(geometry);
+    bounds->extend(LatLng(box.min.y, box.min.x));
+    bounds->extend(LatLng(box.max.y, box.max.x));
+}
+
+bool tileIntersects(const CanonicalTileID& tileID,
+                    const LatLngBounds& changed,
+                    double bufferFraction) {
+    const LatLngBounds tileBounds{ tileID };
+    const double padLat = (tileBounds.north() - tileBounds.south()) * bufferFraction;
+    const double padLng = (tileBounds.east() - tileBounds.west()) * bufferFraction;
+    return LatLngBounds::hull({ tileBounds.south() - padLat, tileBounds.west() - padLng },
+                              { tileBounds.north() + padLat, tileBounds.east() + padLng })
+        .intersects(changed);
+}
+
+} // namespace
+
+// Stateless; the only synchronization point is the callback delivered back
+// to the map thread once the index is built.
+class GeoJSONIndexWorker {
+public:
+    void build(GeoJSON geoJSON,
+               GeoJSONOptions options,
+               std::function<void(std::shared_ptr<GeoJSONIndex>)> callback) {
+        callback(std::make_shared<GeoJSONIndex>(buildIndex(geoJSON, options)));
+    }
+};
+
 GeoJSONSource::Impl::Impl(std::string id_, Source& base_, const GeoJSONOptions options_)
     : Source::Impl(SourceType::GeoJSON, std::move(id_), base_), options(options_) {
 }
@@ -57,38 +123,256 @@ void GeoJSONSource::Impl::setGeoJSON(const GeoJSON& geoJSON) {
     _setGeoJSON(geoJSON);
 }
 
-// Private implementation
-void GeoJSONSource::Impl::_setGeoJSON(const GeoJSON& geoJSON) {
-    double scale = util::EXTENT / util::tileSize;
+void GeoJSONSource::Impl::appendFeatures(FeatureCollection features) {
+    req.reset();
 
-    cache.clear();
+    optional<LatLngBounds> overlayBounds;
+    for (auto& feature : features) {
+        extendChangedBounds(feature.geometry);
+        if (options.cluster) {
+            addToClusterOverlay(feature, overlayBounds);
+        }
+        if (feature.id) {
+            featureIndexById[*feature.id] = streamedFeatures.size();
+        }
+        streamedFeatures.push_back(std::move(feature));
+    }
+    indexDirty = true;
+    if (overlayBounds) {
+        refreshIntersectingTiles(*overlayBounds);
+    }
+    startIndexing();
+}
 
-    if (options.cluster
-        && geoJSON.is<mapbox::geometry::feature_collection<double>>()
-        && !geoJSON.get<mapbox::geometry::feature_collection<double>>().empty()) {
-        mapbox::supercluster::Options clusterOptions;
-        clusterOptions.maxZoom = options.clusterMaxZoom;
-        clusterOptions.extent = util::EXTENT;
-        clusterOptions.radius = std::round(scale * options.clusterRadius);
+void GeoJSONSource::Impl::updateFeature(Feature feature) {
+    if (!feature.id) {
+        // Without an identity there is nothing to patch; treat it as a new
+        // feature.
+        FeatureCollection batch;
+        batch.push_back(std::move(feature));
+        appendFeatures(std::move(batch));
+        return;
+    }
 
-        const auto& features = geoJSON.get<mapbox::geometry::feature_collection<double>>();
-        geoJSONOrSupercluster =
-            std::make_unique<mapbox::supercluster::Supercluster>(features, clusterOptions);
+    req.reset();
+
+    extendChangedBounds(feature.geometry);
+    optional<LatLngBounds> overlayBounds;
+    if (options.cluster) {
+        addToClusterOverlay(feature, overlayBounds);
+    }
+    auto it = featureIndexById.find(*feature.id);
+    if (it != featureIndexById.end()) {
+        // Tiles covering the old position have to refresh as well.
+        extendChangedBounds(streamedFeatures[it->second].geometry);
+        streamedFeatures[it->second] = std::move(feature);
     } else {
-        mapbox::geojsonvt::Options vtOptions;
-        vtOptions.maxZoom = options.maxzoom;
-        vtOptions.extent = util::EXTENT;
-        vtOptions.buffer = std::round(scale * options.buffer);
-        vtOptions.tolerance = scale * options.tolerance;
-        geoJSONOrSupercluster = std::make_unique<mapbox::geojsonvt::GeoJSONVT>(geoJSON, vtOptions);
+        featureIndexById.emplace(*feature.id, streamedFeatures.size());
+        streamedFeatures.push_back(std::move(feature));
     }
 
+    indexDirty = true;
+    if (overlayBounds) {
+        refreshIntersectingTiles(*overlayBounds);
+    }
+    startIndexing();
+}
+
+void GeoJSONSource::Impl::removeFeature(const FeatureIdentifier& id) {
+    auto it = featureIndexById.find(id);
+    if (it == featureIndexById.end()) {
+        return;
+    }
+
+    req.reset();
+
+    const std::size_t index = it->second;
+    extendChangedBounds(streamedFeatures[index].geometry);
+    optional<LatLngBounds> overlayBounds;
+    if (options.cluster) {
+        // If the feature is still sitting in the overlay its removal is
+        // visible immediately; a removal baked into the clusters waits for
+        // the rebuild.
+        removeFromClusterOverlay(id, overlayBounds);
+    }
+    featureIndexById.erase(it);
+
+    // Swap-and-pop; reindex the feature that took the vacated slot.
+    if (index + 1 != streamedFeatures.size()) {
+        streamedFeatures[index] = std::move(streamedFeatures.back());
+        if (streamedFeatures[index].id) {
+            featureIndexById[*streamedFeatures[index].id] = index;
+        }
+    }
+    streamedFeatures.pop_back();
+
+    indexDirty = true;
+    if (overlayBounds) {
+        refreshIntersectingTiles(*overlayBounds);
+    }
+    startIndexing();
+}
+
+void GeoJSONSource::Impl::addToClusterOverlay(const Feature& feature,
+                                              optional<LatLngBounds>& bounds) {
+    // Only point features can be drawn unclustered on top of the built
+    // clusters; supercluster only indexes points anyway.
+    if (!feature.geometry.is<mapbox::geometry::point<double>>()) {
+        return;
+    }
+    if (feature.id) {
+        removeFromClusterOverlay(*feature.id, bounds);
+    }
+    extendBounds(bounds, feature.geometry);
+    clusterOverlay.push_back(feature);
+}
+
+bool GeoJSONSource::Impl::removeFromClusterOverlay(const FeatureIdentifier& id,
+                                                   optional<LatLngBounds>& bounds) {
+    for (std::size_t i = 0; i < clusterOverlay.size(); ++i) {
+        if (clusterOverlay[i].id && *clusterOverlay[i].id == id) {
+            extendBounds(bounds, clusterOverlay[i].geometry);
+            clusterOverlay.erase(clusterOverlay.begin() + i);
+            if (i < clusterOverlayInBuild) {
+                // The in-flight build snapshotted this entry's old state; one
+                // fewer overlay feature is consumed when it completes, and the
+                // dirty flag forces a follow-up build covering the change.
+                clusterOverlayInBuild--;
+            }
+            return true;
+        }
+    }
+    return false;
+}
+
+void GeoJSONSource::Impl::appendClusterOverlay(
+    mapbox::geometry::feature_collection<int16_t>& features, const CanonicalTileID& tileID) const {
+    if (clusterOverlay.empty()) {
+        return;
+    }
+
+    // Pad by the cluster radius, matching the halo of neighbouring points
+    // supercluster includes in each tile.
+    const double scale = util::EXTENT / util::tileSize;
+    const int32_t pad = std::round(scale * options.clusterRadius);
+    const UnwrappedTileID unwrapped{ tileID.z, tileID.x, tileID.y };
+
+    for (const auto& feature : clusterOverlay) {
+        // addToClusterOverlay only admits points.
+        const auto& point = feature.geometry.get<mapbox::geometry::point<double>>();
+        const GeometryCoordinate local = TileCoordinate::toGeometryCoordinate(
+            unwrapped, TileCoordinate::fromLatLng(0, LatLng(point.y, point.x)).p);
+        if (local.x < -pad || local.x > util::EXTENT + pad ||
+            local.y < -pad || local.y > util::EXTENT + pad) {
+            continue;
+        }
+
+        mapbox::geometry::feature<int16_t> projected{ mapbox::geometry::point<int16_t>(local.x, local.y) };
+        projected.id = feature.id;
+        projected.properties = feature.properties;
+        features.push_back(std::move(projected));
+    }
+}
+
+void GeoJSONSource::Impl::refreshIntersectingTiles(const LatLngBounds& bounds) {
+    cache.clear();
+    const double bufferFraction = double(options.buffer) / util::EXTENT;
+    for (auto const& item : tiles) {
+        GeoJSONTile* geoJSONTile = static_cast<GeoJSONTile*>(item.second.get());
+        if (!tileIntersects(geoJSONTile->id.canonical, bounds, bufferFraction)) {
+            continue;
+        }
+        setTileData(*geoJSONTile, geoJSONTile->id);
+    }
+}
+
+void GeoJSONSource::Impl::extendChangedBounds(const mapbox::geometry::geometry<double>& geometry) {
+    if (options.cluster) {
+        // Clustering aggregates points across tile boundaries at lower zooms,
+        // so a single changed point can alter clusters far outside its own
+        // envelope; cluster sources always refresh every tile.
+        return;
+    }
+    extendBounds(pendingChangedBounds, geometry);
+}
+
+// Private implementation
+void GeoJSONSource::Impl::_setGeoJSON(const GeoJSON& geoJSON) {
+    // Replacing the data wholesale supersedes any in-flight streamed index,
+    // and becomes the baseline that subsequent feature batches append to.
+    indexRequest.reset();
+    indexDirty = false;
+    pendingChangedBounds = {};
+    clusterOverlay.clear();
+    clusterOverlayInBuild = 0;
+    streamedFeatures = geoJSON.is<FeatureCollection>()
+        ? geoJSON.get<FeatureCollection>()
+        : FeatureCollection{};
+    featureIndexById.clear();
+    for (std::size_t i = 0; i < streamedFeatures.size(); ++i) {
+        if (streamedFeatures[i].id) {
+            featureIndexById[*streamedFeatures[i].id] = i;
+        }
+    }
+
+    cache.clear();
+
+    geoJSONOrSupercluster = buildIndex(geoJSON, options);
+
     for (auto const &item : tiles) {
         GeoJSONTile* geoJSONTile = static_cast<GeoJSONTile*>(item.second.get());
         setTileData(*geoJSONTile, geoJSONTile->id);
     }
 }
 
+void GeoJSONSource::Impl::startIndexing() {
+    if (indexRequest) {
+        // A build is already running; its completion callback starts another
+        // one covering the features that arrived in the meantime.
+        return;
+    }
+
+    if (!indexThread) {
+        indexThread = std::make_unique<util::Thread<GeoJSONIndexWorker>>(
+            util::ThreadContext{ "GeoJSON Indexing", util::ThreadPriority::Low });
+    }
+
+    indexDirty = false;
+    clusterOverlayInBuild = clusterOverlay.size();
+    const optional<LatLngBounds> updateBounds = pendingChangedBounds;
+    pendingChangedBounds = {};
+
+    indexRequest = indexThread->invokeWithCallback(
+        &GeoJSONIndexWorker::build, GeoJSON{ streamedFeatures }, options,
+        [this, updateBounds](std::shared_ptr<GeoJSONIndex> index) {
+            indexRequest.reset();
+
+            // Swap in the new generation. Visible tiles re-query the index
+            // from here on the map thread, so the renderer never observes a
+            // partially built state. Tiles that don't intersect the changed
+            // features are identical in both generations and keep their data.
+            cache.clear();
+            geoJSONOrSupercluster = std::move(*index);
+            // Overlay points the build covered are now part of the clusters.
+            clusterOverlay.erase(clusterOverlay.begin(),
+                                 clusterOverlay.begin() + clusterOverlayInBuild);
+            clusterOverlayInBuild = 0;
+            const double bufferFraction = double(options.buffer) / util::EXTENT;
+            for (auto const& item : tiles) {
+                GeoJSONTile* geoJSONTile = static_cast<GeoJSONTile*>(item.second.get());
+                if (updateBounds
+                    && !tileIntersects(geoJSONTile->id.canonical, *updateBounds, bufferFraction)) {
+                    continue;
+                }
+                setTileData(*geoJSONTile, geoJSONTile->id);
+            }
+
+            if (indexDirty) {
+                startIndexing();
+            }
+        });
+}
+
 void GeoJSONSource::Impl::setTileData(GeoJSONTile& tile, const OverscaledTileID& tileID) {
     if (geoJSONOrSupercluster.is<GeoJSONVTPointer>()) {
         tile.updateData(geoJSONOrSupercluster.get<GeoJSONVTPointer>()->getTile(tileID.canonical.z,
@@ -96,9 +380,11 @@ void GeoJSONSource::Impl::setTileData(GeoJSONTile& tile, const OverscaledTileID&
                                                                                tileID.canonical.y).features);
     } else {
         assert(geoJSONOrSupercluster.is<SuperclusterPointer>());
-        tile.updateData(geoJSONOrSupercluster.get<SuperclusterPointer>()->getTile(tileID.canonical.z,
+        auto features = geoJSONOrSupercluster.get<SuperclusterPointer>()->getTile(tileID.canonical.z,
                                                                                   tileID.canonical.x,
-                                                                                  tileID.canonical.y));
+                                                                                  tileID.canonical.y);
+        appendClusterOverlay(features, tileID.canonical);
+        tile.updateData(features);
     }
 }
 
@@ -2,15 +2,28 @@
 
 #include <mbgl/style/source_impl.hpp>
 #include <mbgl/style/sources/geojson_source.hpp>
+#include <mbgl/util/geo.hpp>
 #include <mbgl/util/variant.hpp>
 #include <mbgl/tile/geojson_tile.hpp>
 
+#include <map>
+
 namespace mbgl {
 
 class AsyncRequest;
 
+namespace util {
+template <class> class Thread;
+} // namespace util
+
 namespace style {
 
+using GeoJSONIndex = variant<GeoJSONVTPointer, SuperclusterPointer>;
+
+// Builds geojson-vt / supercluster indexes on a dedicated low-priority
+// thread so streamed feature updates don't stall the map thread.
+class GeoJSONIndexWorker;
+
 class GeoJSONSource::Impl : public Source::Impl {
 public:
     Impl(std::string id, Source&, const GeoJSONOptions);
@@ -20,6 +33,9 @@ public:
     optional<std::string> getURL() const;
 
     void setGeoJSON(const GeoJSON&);
+    void appendFeatures(FeatureCollection);
+    void updateFeature(Feature);
+    void removeFeature(const FeatureIdentifier&);
     void setTileData(GeoJSONTile&, const OverscaledTileID& tileID);
 
     void loadDescription(FileSource&) final;
@@ -30,6 +46,13 @@ public:
 
 private:
     void _setGeoJSON(const GeoJSON&);
+    void startIndexing();
+    void extendChangedBounds(const mapbox::geometry::geometry<double>&);
+    void addToClusterOverlay(const Feature&, optional<LatLngBounds>&);
+    bool removeFromClusterOverlay(const FeatureIdentifier&, optional<LatLngBounds>&);
+    void appendClusterOverlay(mapbox::geometry::feature_collection<int16_t>&,
+                              const CanonicalTileID&) const;
+    void refreshIntersectingTiles(const LatLngBounds&);
 
     Range<uint8_t> getZoomRange() final;
     std::unique_ptr<Tile> createTile(const OverscaledTileID&, const UpdateParameters&) final;
@@ -37,7 +60,33 @@ private:
     GeoJSONOptions options;
     optional<std::string> url;
     std::unique_ptr<AsyncRequest> req;
-    variant<GeoJSONVTPointer, SuperclusterPointer> geoJSONOrSupercluster;
+    GeoJSONIndex geoJSONOrSupercluster;
+
+    // Streaming ingestion state: the accumulated feature collection, the
+    // worker thread (created on first use) that indexes it, and the pending
+    // build. indexDirty records batches that arrived while a build was in
+    // flight; they are picked up by one follow-up build when it completes.
+    FeatureCollection streamedFeatures;
+    std::unique_ptr<util::Thread<GeoJSONIndexWorker>> indexThread;
+    std::unique_ptr<AsyncRequest> indexRequest;
+    bool indexDirty = false;
+
+    // Position of each identified feature within streamedFeatures, for the
+    // keyed update/remove paths. The union of the changed features' old and
+    // new envelopes bounds the next partial tile refresh; disengaged while
+    // dirty, every tile is refreshed (always the case for cluster sources).
+    std::map<FeatureIdentifier, std::size_t> featureIndexById;
+    optional<LatLngBounds> pendingChangedBounds;
+
+    // The built cluster tree can't be patched in place, so points added or
+    // moved since the last completed build are kept here and drawn as plain
+    // points on top of the clustered tiles; they merge into the clusters when
+    // the worker rebuild lands. Removals of already-clustered points can't be
+    // masked this way and only take effect with the rebuild. The first
+    // clusterOverlayInBuild entries are covered by the in-flight build and are
+    // dropped when it completes.
+    FeatureCollection clusterOverlay;
+    std::size_t clusterOverlayInBuild = 0;
 };
 
 } // namespace style
@@ -13,6 +13,8 @@
 #include <mbgl/style/layers/circle_layer.hpp>
 #include <mbgl/style/layers/raster_layer.hpp>
 #include <mbgl/style/layer_impl.hpp>
+#include <mbgl/style/group_by_layout.hpp>
+#include <mbgl/style/parsed_layer_cache.hpp>
 #include <mbgl/style/parser.hpp>
 #include <mbgl/style/query_parameters.hpp>
 #include <mbgl/style/transition_options.hpp>
@@ -20,6 +22,9 @@
 #include <mbgl/style/update_parameters.hpp>
 #include <mbgl/style/cascade_parameters.hpp>
 #include <mbgl/style/property_evaluation_parameters.hpp>
+#include <mbgl/actor/actor.hpp>
+#include <mbgl/actor/scheduler.hpp>
+#include <mbgl/actor/task_group.hpp>
 #include <mbgl/sprite/sprite_atlas.hpp>
 #include <mbgl/text/glyph_atlas.hpp>
 #include <mbgl/geometry/line_atlas.hpp>
@@ -33,6 +38,7 @@
 #include <mbgl/math/minmax.hpp>
 
 #include <algorithm>
+#include <unordered_map>
 
 namespace mbgl {
 namespace style {
@@ -100,28 +106,73 @@ TransitionOptions Style::getTransitionOptions() const {
 }
 
 void Style::setJSON(const std::string& json) {
-    sources.clear();
-    layers.clear();
-    classes.clear();
-    transitionOptions = {};
-    updateBatch = {};
-
     Parser parser;
-    auto error = parser.parse(json);
+    auto error = parser.parseExceptLayers(json);
 
     if (error) {
+        // The current style — if any — stays in place; an unparsable pushed
+        // stylesheet shouldn't blank the map.
         Log::Error(Event::ParseStyle, "Failed to parse style: %s", util::toString(error).c_str());
         observer->onStyleError();
         observer->onResourceError(error);
         return;
     }
 
-    for (auto& source : parser.sources) {
-        addSource(std::move(source));
-    }
+    // Converting the layers array dominates parse time; reuse previously
+    // converted layers when this exact stylesheet has been loaded before in
+    // this process (pooled still-render maps, multi-map setups, style
+    // switches back and forth).
+    const auto takeLayers = [&] {
+        std::vector<std::unique_ptr<Layer>> result;
+        if (!ParsedLayerCache::Get().get(json, result)) {
+            parser.parseLayers();
+            ParsedLayerCache::Get().put(json, parser.layers);
+            result = std::move(parser.layers);
+        }
+        return result;
+    };
 
-    for (auto& layer : parser.layers) {
-        addLayer(std::move(layer));
+    // When everything but the layers matches the current stylesheet — the
+    // common case for server-pushed style tweaks — apply the layers as a diff
+    // against the current ones instead of tearing down every source and
+    // re-laying-out every tile. Paint-only tweaks then cost one cascade.
+    if (loaded && parser.glyphURL == glyphURL && parser.spriteURL == spriteURL &&
+        parser.sourcesJSON == sourcesJSON) {
+        classes.clear();
+        transitionOptions = {};
+        applyLayerDiff(takeLayers());
+    } else {
+        sources.clear();
+        layers.clear();
+        layerSnapshot.reset();
+        classes.clear();
+        transitionOptions = {};
+        updateBatch = {};
+
+        for (auto& source : parser.sources) {
+            addSource(std::move(source));
+        }
+
+        // Start TileJSON fetches before converting the layers array, which
+        // dominates parse time for large styles. The network requests then run
+        // concurrently with layer conversion instead of queuing behind it, so the
+        // first tile requests go out sooner. GeoJSON sources are skipped because
+        // their loadDescription() may parse inline data on this thread, which is
+        // exactly the kind of work we're trying to defer; they keep loading on
+        // demand from recalculate(). loadDescription() is idempotent, so the
+        // on-demand path stays a no-op for sources started here.
+        for (const auto& source : sources) {
+            if (source->baseImpl->type != SourceType::GeoJSON) {
+                source->baseImpl->loadDescription(fileSource);
+            }
+        }
+
+        for (auto& layer : takeLayers()) {
+            addLayer(std::move(layer));
+        }
+
+        glyphAtlas->setURL(parser.glyphURL);
+        spriteAtlas->load(parser.spriteURL, fileSource);
     }
 
     name = parser.name;
@@ -130,8 +181,9 @@ void Style::setJSON(const std::string& json) {
     defaultBearing = parser.bearing;
     defaultPitch = parser.pitch;
 
-    glyphAtlas->setURL(parser.glyphURL);
-    spriteAtlas->load(parser.spriteURL, fileSource);
+    glyphURL = parser.glyphURL;
+    spriteURL = parser.spriteURL;
+    sourcesJSON = parser.sourcesJSON;
 
     loaded = true;
 
@@ -187,6 +239,21 @@ std::vector<Layer*> Style::getLayers() {
     return result;
 }
 
+std::shared_ptr<const std::vector<std::shared_ptr<const Layer>>> Style::getLayerSnapshot() {
+    if (!layerSnapshot) {
+        auto snapshot = std::make_shared<std::vector<std::shared_ptr<const Layer>>>();
+        snapshot->reserve(layers.size());
+        for (const auto& layer : layers) {
+            if (layer->is<BackgroundLayer>() || layer->is<CustomLayer>()) {
+                continue;
+            }
+            snapshot->push_back(layer->baseImpl->clone());
+        }
+        layerSnapshot = std::move(snapshot);
+    }
+    return layerSnapshot;
+}
+
 std::vector<std::unique_ptr<Layer>>::const_iterator Style::findLayer(const std::string& id) const {
     return std::find_if(layers.begin(), layers.end(), [&](const auto& layer) {
         return layer->baseImpl->id == id;
@@ -221,6 +288,7 @@ Layer* Style::addLayer(std::unique_ptr<Layer> layer, optional<std::string> befor
     }
 
     layer->baseImpl->setObserver(this);
+    layerSnapshot.reset();
 
     return layers.emplace(before ? findLayer(*before) : layers.end(), std::move(layer))->get();
 }
@@ -240,6 +308,7 @@ std::unique_ptr<Layer> Style::removeLayer(const std::string& id) {
     }
 
     layers.erase(it);
+    layerSnapshot.reset();
     return layer;
 }
 
@@ -287,7 +356,43 @@ void Style::relayout() {
     updateBatch.sourceIDs.clear();
 }
 
-void Style::cascade(const TimePoint& timePoint, MapMode mode) {
+// Layers fanned out per scheduler message: large enough to amortize the
+// message traffic, small enough to spread a 100+ layer style across the pool.
+static constexpr std::size_t layerEvaluationBatchSize = 16;
+
+// Runs range(begin, end) over [0, count) in batches on the scheduler's pool,
+// blocking until every batch is done. The calling thread drains the queue
+// too, so a fully loaded pool cannot deadlock on its own batches. Falls back
+// to a plain inline loop when no scheduler is available or the count is too
+// small to be worth the message traffic.
+static void forEachLayerBatch(Scheduler* scheduler,
+                              std::size_t count,
+                              const std::function<void(std::size_t, std::size_t)>& range) {
+    if (!scheduler || count <= layerEvaluationBatchSize) {
+        range(0, count);
+        return;
+    }
+
+    TaskGroup group;
+    for (std::size_t begin = 0; begin < count; begin += layerEvaluationBatchSize) {
+        const std::size_t end = std::min(begin + layerEvaluationBatchSize, count);
+        group.add([&range, begin, end] { range(begin, end); });
+    }
+
+    Actor<TaskGroupHelper> helper { *scheduler, group };
+    for (std::size_t i = layerEvaluationBatchSize; i < count; i += layerEvaluationBatchSize) {
+        helper.invoke(&TaskGroupHelper::runOne);
+    }
+
+    group.join();
+}
+
+void Style::cascade(const TimePoint& timePoint, MapMode mode, Scheduler* scheduler) {
+    // Cascading changes layer impl state that ends up in snapshot clones
+    // (layouts read the evaluated paint properties), so any snapshot taken
+    // before this pass is stale.
+    layerSnapshot.reset();
+
     // When in continuous mode, we can either have user- or style-defined
     // transitions. Still mode is always immediate.
     static const TransitionOptions immediateTransition {};
@@ -298,18 +403,41 @@ void Style::cascade(const TimePoint& timePoint, MapMode mode) {
     }
     classIDs.push_back(ClassID::Default);
 
+    // Identify the class list with a small id so the per-property caches can
+    // snapshot their resolution for it; apps that toggle between a handful of
+    // class sets (day/night/...) then pay the full resolution only the first
+    // time each combination appears. Bounded so a pathological sequence of
+    // one-off class sets cannot grow the caches without limit — overflow
+    // combinations simply take the uncached path.
+    static constexpr std::size_t maxClassCombinations = 16;
+    uint32_t classCombination = 0;
+    auto combination = classCombinations.find(classIDs);
+    if (combination != classCombinations.end()) {
+        classCombination = combination->second;
+    } else if (classCombinations.size() < maxClassCombinations) {
+        classCombination = static_cast<uint32_t>(classCombinations.size() + 1);
+        classCombinations.emplace(classIDs, classCombination);
+    }
+
     const CascadeParameters parameters {
         classIDs,
         mode == MapMode::Continuous ? timePoint : Clock::time_point::max(),
-        mode == MapMode::Continuous ? transitionOptions : immediateTransition
+        mode == MapMode::Continuous ? transitionOptions : immediateTransition,
+        classCombination
     };
 
-    for (const auto& layer : layers) {
-        layer->baseImpl->cascade(parameters);
-    }
+    // Cascading touches only the layer's own impl, so layers are independent.
+    forEachLayerBatch(scheduler, layers.size(), [&] (std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+            layers[i]->baseImpl->cascade(parameters);
+        }
+    });
 }
 
-void Style::recalculate(float z, const TimePoint& timePoint, MapMode mode) {
+void Style::recalculate(float z, const TimePoint& timePoint, MapMode mode, Scheduler* scheduler) {
+    // See cascade(): evaluation also changes impl state captured by clones.
+    layerSnapshot.reset();
+
     // Disable all sources first. If we find an enabled layer that uses this source, we will
     // re-enable it later.
     for (const auto& source : sources) {
@@ -325,20 +453,38 @@ void Style::recalculate(float z, const TimePoint& timePoint, MapMode mode) {
         mode == MapMode::Continuous ? util::DEFAULT_FADE_DURATION : Duration::zero()
     };
 
-    hasPendingTransitions = false;
-    for (const auto& layer : layers) {
-        const bool hasTransitions = layer->baseImpl->evaluate(parameters);
+    // Evaluation phase: touches only the layer's own impl, so layers are
+    // independent and may run on pool threads. Each layer's outcome is
+    // recorded by index; all side effects on shared state wait for the
+    // serial commit pass below.
+    enum : uint8_t { HasTransitions = 1 << 0, NeedsRendering = 1 << 1 };
+    std::vector<uint8_t> evaluated(layers.size(), 0);
+
+    forEachLayerBatch(scheduler, layers.size(), [&] (std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+            uint8_t outcome = 0;
+            if (layers[i]->baseImpl->evaluate(parameters)) {
+                outcome |= HasTransitions;
+            }
+            if (layers[i]->baseImpl->needsRendering(zoomHistory.lastZoom)) {
+                outcome |= NeedsRendering;
+            }
+            evaluated[i] = outcome;
+        }
+    });
 
+    // Commit phase, in one serial pass over the recorded outcomes.
+    hasPendingTransitions = false;
+    for (std::size_t i = 0; i < layers.size(); ++i) {
         // Disable this layer if it doesn't need to be rendered.
-        const bool needsRendering = layer->baseImpl->needsRendering(zoomHistory.lastZoom);
-        if (!needsRendering) {
+        if (!(evaluated[i] & NeedsRendering)) {
             continue;
         }
 
-        hasPendingTransitions |= hasTransitions;
+        hasPendingTransitions |= (evaluated[i] & HasTransitions) != 0;
 
         // If this layer has a source, make sure that it gets loaded.
-        if (Source* source = getSource(layer->baseImpl->source)) {
+        if (Source* source = getSource(layers[i]->baseImpl->source)) {
             source->baseImpl->enabled = true;
             if (!source->baseImpl->loaded) {
                 source->baseImpl->loadDescription(fileSource);
@@ -522,6 +668,16 @@ std::vector<Feature> Style::queryRenderedFeatures(const QueryParameters& paramet
 
         auto sourceResults = source->baseImpl->queryRenderedFeatures(parameters);
         std::move(sourceResults.begin(), sourceResults.end(), std::inserter(resultsByLayer, resultsByLayer.begin()));
+
+        if (parameters.limit) {
+            std::size_t count = 0;
+            for (const auto& entry : resultsByLayer) {
+                count += entry.second.size();
+            }
+            if (count >= *parameters.limit) {
+                break;
+            }
+        }
     }
 
     if (resultsByLayer.empty()) {
@@ -539,6 +695,10 @@ std::vector<Feature> Style::queryRenderedFeatures(const QueryParameters& paramet
         }
     }
 
+    if (parameters.limit && result.size() > *parameters.limit) {
+        result.resize(*parameters.limit);
+    }
+
     return result;
 }
 
@@ -609,7 +769,7 @@ void Style::onSourceDescriptionChanged(Source& source) {
 
 void Style::onTileChanged(Source& source, const OverscaledTileID& tileID) {
     observer->onTileChanged(source, tileID);
-    observer->onUpdate(Update::Repaint);
+    observer->onUpdate(Update::Render);
 }
 
 void Style::onTileError(Source& source, const OverscaledTileID& tileID, std::exception_ptr error) {
@@ -648,26 +808,130 @@ struct QueueSourceReloadVisitor {
     }
 };
 
+static std::string paintKey(const Layer& layer) {
+    rapidjson::StringBuffer s;
+    rapidjson::Writer<rapidjson::StringBuffer> writer(s);
+    layer.baseImpl->stringifyPaint(writer);
+    return s.GetString();
+}
+
+void Style::applyLayerDiff(std::vector<std::unique_ptr<Layer>> newLayers) {
+    // Order changes are structural: tiles lay out buckets and resolve symbol
+    // collisions in layer order.
+    bool reordered = layers.size() != newLayers.size();
+    if (!reordered) {
+        for (std::size_t i = 0; i < layers.size(); ++i) {
+            if (layers[i]->getID() != newLayers[i]->getID()) {
+                reordered = true;
+                break;
+            }
+        }
+    }
+
+    std::unordered_map<std::string, std::unique_ptr<Layer>> previous;
+    previous.reserve(layers.size());
+    for (auto& layer : layers) {
+        previous.emplace(layer->getID(), std::move(layer));
+    }
+    layers.clear();
+    layerSnapshot.reset();
+
+    // Mirrors the setup addLayer() performs; custom layers never come from
+    // JSON, so their initialize/deinitialize doesn't apply to incoming layers.
+    const auto adopt = [&](std::unique_ptr<Layer> layer) {
+        if (SymbolLayer* symbolLayer = layer->as<SymbolLayer>()) {
+            if (!symbolLayer->impl->spriteAtlas) {
+                symbolLayer->impl->spriteAtlas = spriteAtlas.get();
+            }
+        }
+        layer->baseImpl->setObserver(this);
+        layers.push_back(std::move(layer));
+    };
+
+    Update update = Update::Nothing;
+
+    for (auto& layer : newLayers) {
+        const auto it = previous.find(layer->getID());
+        if (it != previous.end() && it->second && it->second->type == layer->type) {
+            auto& old = it->second;
+            if (layoutKey(*old) == layoutKey(*layer)) {
+                if (paintKey(*old) == paintKey(*layer)) {
+                    // Unchanged: keep the current layer object.
+                    layers.push_back(std::move(old));
+                    continue;
+                }
+                // Paint-only change: the cascade applies it without touching
+                // layout — unless data-driven paint values are involved,
+                // which buckets bake into their vertex data.
+                update |= Update::Classes | Update::RecalculateStyle;
+                if (old->baseImpl->hasDataDrivenPaint() || layer->baseImpl->hasDataDrivenPaint()) {
+                    layer->accept(QueueSourceReloadVisitor { updateBatch });
+                    update |= Update::Layout;
+                }
+                old.reset();
+                adopt(std::move(layer));
+                continue;
+            }
+        }
+        // Added, type changed, or layout-affecting change: the layer's source
+        // has to re-lay-out its tiles. A replaced same-id layer stays behind
+        // in `previous` and is handled as removed below.
+        update |= Update::Classes | Update::RecalculateStyle | Update::Layout;
+        layer->accept(QueueSourceReloadVisitor { updateBatch });
+        adopt(std::move(layer));
+    }
+
+    for (auto& entry : previous) {
+        if (!entry.second) {
+            continue;
+        }
+        if (CustomLayer* customLayer = entry.second->as<CustomLayer>()) {
+            customLayer->impl->deinitialize();
+        }
+        entry.second->accept(QueueSourceReloadVisitor { updateBatch });
+        update |= Update::Classes | Update::RecalculateStyle | Update::Layout;
+    }
+
+    if (reordered) {
+        for (auto& layer : layers) {
+            layer->accept(QueueSourceReloadVisitor { updateBatch });
+        }
+        update |= Update::Classes | Update::RecalculateStyle | Update::Layout;
+    }
+
+    if (update != Update::Nothing) {
+        observer->onUpdate(update);
+    }
+}
+
 void Style::onLayerFilterChanged(Layer& layer) {
+    // A filter change schedules a relayout without a cascade/recalculate pass
+    // in between, so the snapshot has to be dropped here (and in the other
+    // mutation notifications, for uniformity).
+    layerSnapshot.reset();
     layer.accept(QueueSourceReloadVisitor { updateBatch });
     observer->onUpdate(Update::Layout);
 }
 
 void Style::onLayerVisibilityChanged(Layer& layer) {
+    layerSnapshot.reset();
     layer.accept(QueueSourceReloadVisitor { updateBatch });
     observer->onUpdate(Update::RecalculateStyle | Update::Layout);
 }
 
 void Style::onLayerPaintPropertyChanged(Layer&) {
+    layerSnapshot.reset();
     observer->onUpdate(Update::RecalculateStyle | Update::Classes);
 }
 
 void Style::onLayerDataDrivenPaintPropertyChanged(Layer& layer) {
+    layerSnapshot.reset();
     layer.accept(QueueSourceReloadVisitor { updateBatch });
     observer->onUpdate(Update::RecalculateStyle | Update::Classes | Update::Layout);
 }
 
 void Style::onLayerLayoutPropertyChanged(Layer& layer, const char * property) {
+    layerSnapshot.reset();
     layer.accept(QueueSourceReloadVisitor { updateBatch });
 
     auto update = Update::Layout;
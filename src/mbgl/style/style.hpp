@@ -1,5 +1,6 @@
 #pragma once
 
+#include <mbgl/style/class_dictionary.hpp>
 #include <mbgl/style/transition_options.hpp>
 #include <mbgl/style/observer.hpp>
 #include <mbgl/style/source_observer.hpp>
@@ -17,6 +18,7 @@
 #include <mbgl/util/geo.hpp>
 
 #include <cstdint>
+#include <map>
 #include <memory>
 #include <string>
 #include <vector>
@@ -28,6 +30,7 @@ class GlyphAtlas;
 class SpriteAtlas;
 class LineAtlas;
 class RenderData;
+class Scheduler;
 
 namespace style {
 
@@ -55,8 +58,13 @@ public:
     void updateTiles(const UpdateParameters&);
 
     void relayout();
-    void cascade(const TimePoint&, MapMode);
-    void recalculate(float z, const TimePoint&, MapMode);
+
+    // Per-layer cascading and property evaluation are independent, so both
+    // passes fan the layers out over the given scheduler in batches when one
+    // is provided; side effects on shared state (source bookkeeping) are
+    // committed serially afterwards. With no scheduler they run inline.
+    void cascade(const TimePoint&, MapMode, Scheduler* = nullptr);
+    void recalculate(float z, const TimePoint&, MapMode, Scheduler* = nullptr);
 
     bool hasTransitions() const;
 
@@ -72,6 +80,14 @@ public:
 
     std::vector<const Layer*> getLayers() const;
     std::vector<Layer*> getLayers();
+
+    // An immutable snapshot of the current layers (minus the background and
+    // custom layers, which never reach a worker), cloned once and shared by
+    // every tile that ships the style to its worker. Invalidated by any layer
+    // mutation and by cascade/recalculate, so within one update pass the
+    // clones are made once instead of once per tile.
+    std::shared_ptr<const std::vector<std::shared_ptr<const Layer>>> getLayerSnapshot();
+
     Layer* getLayer(const std::string& id) const;
     Layer* addLayer(std::unique_ptr<Layer>,
                     optional<std::string> beforeLayerID = {});
@@ -115,6 +131,13 @@ private:
     std::vector<std::string> classes;
     TransitionOptions transitionOptions;
 
+    // Ids handed out for class lists seen by cascade(); see
+    // CascadeParameters::classCombination.
+    std::map<std::vector<ClassID>, uint32_t> classCombinations;
+
+    // Lazily built by getLayerSnapshot(); reset whenever layer state changes.
+    std::shared_ptr<const std::vector<std::shared_ptr<const Layer>>> layerSnapshot;
+
     // Defaults
     std::string name;
     LatLng defaultLatLng;
@@ -122,10 +145,21 @@ private:
     double defaultBearing = 0;
     double defaultPitch = 0;
 
+    // Signatures of the current stylesheet's non-layer parts, for deciding in
+    // setJSON whether a new document can be applied as a layer diff.
+    std::string glyphURL;
+    std::string spriteURL;
+    std::string sourcesJSON;
+
     std::vector<std::unique_ptr<Layer>>::const_iterator findLayer(const std::string& layerID) const;
     void reloadLayerSource(Layer&);
     void updateSymbolDependentTiles();
 
+    // Replaces the layers vector with `newLayers`, reusing current layer
+    // objects where nothing changed and queueing source reloads only where
+    // layout is affected; paint-only differences are applied via the cascade.
+    void applyLayerDiff(std::vector<std::unique_ptr<Layer>> newLayers);
+
     // GlyphStoreObserver implementation.
     void onGlyphsLoaded(const FontStack&, const GlyphRange&) override;
     void onGlyphsError(const FontStack&, const GlyphRange&, std::exception_ptr) override;
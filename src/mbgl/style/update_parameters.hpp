@@ -1,10 +1,16 @@
 #pragma once
 
 #include <mbgl/map/mode.hpp>
+#include <mbgl/map/transform_state.hpp>
+#include <mbgl/storage/resource.hpp>
+#include <mbgl/tile/tile_id.hpp>
+#include <mbgl/util/optional.hpp>
+
+#include <map>
+#include <vector>
 
 namespace mbgl {
 
-class TransformState;
 class Scheduler;
 class FileSource;
 class AnnotationManager;
@@ -40,6 +46,29 @@ public:
     const MapMode mode;
     AnnotationManager& annotationManager;
 
+    // While the camera is animating, an extrapolation of transformState a few
+    // frames ahead along the current pan/zoom velocity. When set, sources
+    // prefetch the tile cover of this state at low priority so that fast pans
+    // land on warm tiles.
+    optional<TransformState> prefetchTransformState;
+
+    // Priority assigned to tile resources requested with these parameters.
+    Resource::Priority tilePriority = Resource::Priority::Regular;
+
+    // Quality-governor knobs (see QualityGovernor). A non-zero quantization
+    // snaps the bearing/pitch that trigger symbol re-placement to a grid of
+    // that granularity, in radians; speculative work covers predictive tile
+    // prefetch and raster decode-ahead.
+    float placementAngleQuantization = 0;
+    bool allowSpeculativeWork = true;
+
+    // Per-frame scratch shared by the per-source update loop: the tile cover
+    // depends only on transformState and the ideal zoom, so sources that
+    // resolve to the same zoom (common in many-source styles) reuse one cover
+    // instead of rerunning the scanline cover per source. Mutable because the
+    // parameters are otherwise read-only and passed by const reference.
+    mutable std::map<int32_t, std::vector<UnwrappedTileID>> tileCoverCache;
+
     // TODO: remove
     Style& style;
 };
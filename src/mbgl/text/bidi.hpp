@@ -14,6 +14,11 @@ class BiDiImpl;
 
 std::u16string applyArabicShaping(const std::u16string&);
 
+// Pulls in one-time BiDi engine initialization (for ICU, mapping the data
+// file) ahead of the first label, so it doesn't show up as a latency spike on
+// a worker thread. Safe to call from any thread; cheap after the first call.
+void prewarmBiDi();
+
 class BiDi : private util::noncopyable {
 public:
     BiDi();
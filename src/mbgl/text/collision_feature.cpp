@@ -6,8 +6,9 @@ namespace mbgl {
 CollisionFeature::CollisionFeature(const GeometryCoordinates &line, const Anchor &anchor,
         const float top, const float bottom, const float left, const float right,
         const float boxScale, const float padding, const style::SymbolPlacementType placement, IndexedSubfeature indexedFeature_,
-        const bool straight)
-        : indexedFeature(std::move(indexedFeature_)) {
+        const bool straight, util::Arena& arena)
+        : boxes(util::ArenaAllocator<CollisionBox>(arena)),
+          indexedFeature(std::move(indexedFeature_)) {
 
     if (top == 0 && bottom == 0 && left == 0 && right == 0) return;
 
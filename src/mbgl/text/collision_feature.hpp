@@ -4,6 +4,7 @@
 #include <mbgl/text/shaping.hpp>
 #include <mbgl/tile/geometry_tile_data.hpp>
 #include <mbgl/geometry/feature_index.hpp>
+#include <mbgl/util/arena.hpp>
 
 #include <vector>
 
@@ -32,29 +33,37 @@ namespace mbgl {
 
     class CollisionFeature {
         public:
+            // Boxes live in the layout's arena: line labels generate dozens
+            // of boxes per feature, and pooling them keeps the placement scan
+            // over contiguous memory instead of scattered per-feature heaps.
+            using CollisionBoxes = std::vector<CollisionBox, util::ArenaAllocator<CollisionBox>>;
+
             // for text
             explicit CollisionFeature(const GeometryCoordinates &line, const Anchor &anchor,
                     const Shaping &shapedText,
-                    const float boxScale, const float padding, const style::SymbolPlacementType placement, const IndexedSubfeature& indexedFeature_)
+                    const float boxScale, const float padding, const style::SymbolPlacementType placement, const IndexedSubfeature& indexedFeature_,
+                    util::Arena& arena)
                 : CollisionFeature(line, anchor,
                         shapedText.top, shapedText.bottom, shapedText.left, shapedText.right,
-                        boxScale, padding, placement, indexedFeature_, false) {}
+                        boxScale, padding, placement, indexedFeature_, false, arena) {}
 
             // for icons
             explicit CollisionFeature(const GeometryCoordinates &line, const Anchor &anchor,
                     const PositionedIcon &shapedIcon,
-                    const float boxScale, const float padding, const style::SymbolPlacementType placement, const IndexedSubfeature& indexedFeature_)
+                    const float boxScale, const float padding, const style::SymbolPlacementType placement, const IndexedSubfeature& indexedFeature_,
+                    util::Arena& arena)
                 : CollisionFeature(line, anchor,
                         shapedIcon.top, shapedIcon.bottom, shapedIcon.left, shapedIcon.right,
-                        boxScale, padding, placement, indexedFeature_, true) {}
+                        boxScale, padding, placement, indexedFeature_, true, arena) {}
 
             explicit CollisionFeature(const GeometryCoordinates &line, const Anchor &anchor,
                     const float top, const float bottom, const float left, const float right,
                     const float boxScale, const float padding, const style::SymbolPlacementType placement,
-                    IndexedSubfeature, const bool straight);
+                    IndexedSubfeature, const bool straight,
+                    util::Arena& arena);
 
 
-            std::vector<CollisionBox> boxes;
+            CollisionBoxes boxes;
             IndexedSubfeature indexedFeature;
 
         private:
@@ -87,8 +87,19 @@ float CollisionTile::placeFeature(const CollisionFeature& feature, bool allowOve
         const auto anchor = util::matrixMultiply(rotationMatrix, box.anchor);
 
         if (!allowOverlap) {
-            for (auto it = tree.qbegin(bgi::intersects(getTreeBox(anchor, box))); it != tree.qend(); ++it) {
+            // Shrink the query box to the extent of the symbol at the lowest
+            // scale it could still be placed at. Boxes in the tree that don't
+            // intersect it can only collide below the current minPlacementScale
+            // and thus can't raise it any further, so the tree traversal gets
+            // cheaper as blocking boxes are found.
+            const float queryScale = util::max(1.0f, minPlacementScale);
+            for (auto it = tree.qbegin(bgi::intersects(getTreeBox(anchor, box, queryScale))); it != tree.qend(); ++it) {
                 const CollisionBox& blocking = std::get<1>(*it);
+
+                // A blocking box that disappears at or below the current
+                // minPlacementScale can't push it any higher.
+                if (blocking.maxScale <= minPlacementScale) continue;
+
                 Point<float> blockingAnchor = util::matrixMultiply(rotationMatrix, blocking.anchor);
 
                 minPlacementScale = util::max(minPlacementScale, findPlacementScale(anchor, box, blockingAnchor, blocking));
@@ -168,9 +179,51 @@ Box CollisionTile::getTreeBox(const Point<float>& anchor, const CollisionBox& bo
     };
 }
 
+void CollisionTile::finalize() {
+    std::vector<CollisionTreeBox> packed;
+    packed.reserve(tree.size() + ignoredTree.size());
+
+    auto pack = [&](const Tree& source) {
+        for (const auto& entry : source) {
+            const CollisionBox& box = std::get<1>(entry);
+            const auto anchor = util::matrixMultiply(rotationMatrix, box.anchor);
+
+            // The key must cover the box's extent at every scale it can be
+            // visible at. visibleAtScale compares the rounded scale against
+            // [placementScale, maxScale], while intersectsAtScale computes
+            // the extent with the unrounded scale, which can undershoot the
+            // lower bound by up to a factor of 2^-0.1; padding the lower
+            // scale by 0.9 keeps the key conservative. Each edge coordinate
+            // is monotonic in scale, so the envelope of the extents at both
+            // ends of the range covers it entirely.
+            const float loScale = 0.9f * util::max(minScale, box.placementScale);
+            const float hiScale = util::max(loScale, util::min(maxScale, box.maxScale));
+            const Box lo = getTreeBox(anchor, box, loScale);
+            const Box hi = getTreeBox(anchor, box, hiScale);
+            const Box key {
+                CollisionPoint { util::min(lo.min_corner().get<0>(), hi.min_corner().get<0>()),
+                                 util::min(lo.min_corner().get<1>(), hi.min_corner().get<1>()) },
+                CollisionPoint { util::max(lo.max_corner().get<0>(), hi.max_corner().get<0>()),
+                                 util::max(lo.max_corner().get<1>(), hi.max_corner().get<1>()) }
+            };
+            packed.emplace_back(key, box, std::get<2>(entry));
+        }
+    };
+
+    pack(tree);
+    pack(ignoredTree);
+
+    // Bulk-loading yields a better-balanced tree than the repeated insertion
+    // placement had to use, and the grown trees are no longer needed.
+    packedTree.emplace(packed.begin(), packed.end());
+    tree.clear();
+    ignoredTree.clear();
+}
+
 std::vector<IndexedSubfeature> CollisionTile::queryRenderedSymbols(const GeometryCoordinates& queryGeometry, float scale) const {
     std::vector<IndexedSubfeature> result;
-    if (queryGeometry.empty() || (tree.empty() && ignoredTree.empty())) {
+    if (queryGeometry.empty() ||
+        (packedTree ? packedTree->empty() : (tree.empty() && ignoredTree.empty()))) {
         return result;
     }
 
@@ -183,7 +236,7 @@ std::vector<IndexedSubfeature> CollisionTile::queryRenderedSymbols(const Geometr
     }
 
     // Predicate for ruling out already seen features.
-    std::unordered_map<std::string, std::unordered_set<std::size_t>> sourceLayerFeatures;
+    std::unordered_map<util::InternedString, std::unordered_set<std::size_t>> sourceLayerFeatures;
     auto seenFeature = [&] (const CollisionTreeBox& treeBox) -> bool {
         const IndexedSubfeature& feature = std::get<2>(treeBox);
         const auto& seenFeatures = sourceLayerFeatures[feature.sourceLayerName];
@@ -217,8 +270,8 @@ std::vector<IndexedSubfeature> CollisionTile::queryRenderedSymbols(const Geometr
                    && bgi::satisfies(visibleAtScale)
                    && bgi::satisfies(intersectsAtScale);
 
-    auto queryTree = [&](const auto& tree_) {
-        for (auto it = tree_.qbegin(predicates); it != tree_.qend(); ++it) {
+    auto queryTree = [&](const auto& tree_, const auto& treePredicates) {
+        for (auto it = tree_.qbegin(treePredicates); it != tree_.qend(); ++it) {
             const IndexedSubfeature& feature = std::get<2>(*it);
             auto& seenFeatures = sourceLayerFeatures[feature.sourceLayerName];
             seenFeatures.insert(feature.index);
@@ -226,8 +279,20 @@ std::vector<IndexedSubfeature> CollisionTile::queryRenderedSymbols(const Geometr
         }
     };
 
-    queryTree(tree);
-    queryTree(ignoredTree);
+    if (packedTree) {
+        // The packed keys cover each box's extent over its visible scale
+        // range, so the traversal can be restricted spatially before the
+        // exact predicates run.
+        const auto envelope = mapbox::geometry::envelope(polygon);
+        const Box queryBox {
+            CollisionPoint { static_cast<float>(envelope.min.x), static_cast<float>(envelope.min.y) },
+            CollisionPoint { static_cast<float>(envelope.max.x), static_cast<float>(envelope.max.y) }
+        };
+        queryTree(*packedTree, bgi::intersects(queryBox) && predicates);
+    } else {
+        queryTree(tree, predicates);
+        queryTree(ignoredTree, predicates);
+    }
 
     return result;
 }
@@ -3,6 +3,7 @@
 #include <mbgl/text/collision_feature.hpp>
 #include <mbgl/text/placement_config.hpp>
 #include <mbgl/tile/geometry_tile_data.hpp>
+#include <mbgl/util/optional.hpp>
 
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wunused-function"
@@ -44,6 +45,13 @@ public:
 
     std::vector<IndexedSubfeature> queryRenderedSymbols(const GeometryCoordinates&, float scale) const;
 
+    // Called on the worker once placement is complete. Repacks the boxes of
+    // both trees into a single bulk-loaded tree whose keys cover every scale
+    // the box can be visible at, so queryRenderedSymbols becomes a spatially
+    // indexed lookup instead of a predicate scan over all boxes, and drops
+    // the insertion-grown trees that placement needed.
+    void finalize();
+
     const PlacementConfig config;
 
     const float minScale = 0.5f;
@@ -61,6 +69,9 @@ private:
 
     Tree tree;
     Tree ignoredTree;
+
+    // Built by finalize(); empty while placement is still running.
+    optional<Tree> packedTree;
 };
 
 } // namespace mbgl
@@ -3,9 +3,11 @@
 #include <mbgl/text/glyph_pbf.hpp>
 #include <mbgl/gl/context.hpp>
 #include <mbgl/util/logging.hpp>
+#include <mbgl/util/memory_budget.hpp>
 #include <mbgl/util/platform.hpp>
 
 #include <cassert>
+#include <cstring>
 #include <algorithm>
 
 namespace mbgl {
@@ -18,9 +20,14 @@ GlyphAtlas::GlyphAtlas(const Size size, FileSource& fileSource_)
       bin(size.width, size.height),
       image(size),
       dirty(true) {
+    // The atlas page is a fixed-size allocation that is referenced by live
+    // buckets, so it only reports its usage and cannot be trimmed.
+    memoryBudgetId = MemoryBudget::Register("GlyphAtlas", [this] { return image.bytes(); });
 }
 
-GlyphAtlas::~GlyphAtlas() = default;
+GlyphAtlas::~GlyphAtlas() {
+    MemoryBudget::Unregister(memoryBudgetId);
+}
 
 void GlyphAtlas::requestGlyphRange(const FontStack& fontStack, const GlyphRange& range) {
     std::lock_guard<std::mutex> lock(rangesMutex);
@@ -80,6 +87,12 @@ void GlyphAtlas::setObserver(GlyphAtlasObserver* observer_) {
     observer = observer_;
 }
 
+void GlyphAtlas::scheduleGlyphsLoaded(const FontStack& fontStack, const GlyphRange& range) {
+    workQueue.push([this, fontStack, range] {
+        observer->onGlyphsLoaded(fontStack, range);
+    });
+}
+
 void GlyphAtlas::addGlyphs(uintptr_t tileUID,
                            const std::u16string& text,
                            const FontStack& fontStack,
@@ -157,21 +170,30 @@ Rect<uint16_t> GlyphAtlas::addGlyph(uintptr_t tileUID,
 
     face.emplace(glyph.id, GlyphValue { rect, tileUID });
 
-    // Copy the bitmap
+    // Copy the bitmap, one contiguous row at a time.
     const uint8_t* source = reinterpret_cast<const uint8_t*>(glyph.bitmap.data());
     for (uint32_t y = 0; y < buffered_height; y++) {
         uint32_t y1 = image.size.width * (rect.y + y + padding) + rect.x + padding;
         uint32_t y2 = buffered_width * y;
-        for (uint32_t x = 0; x < buffered_width; x++) {
-            image.data[y1 + x] = source[y2 + x];
-        }
+        std::memcpy(image.data.get() + y1, source + y2, buffered_width);
     }
 
+    markDirtyRows(rect.y, rect.y + rect.h);
     dirty = true;
 
     return rect;
 }
 
+void GlyphAtlas::markDirtyRows(uint32_t begin, uint32_t end) {
+    if (dirtyRowsBegin == dirtyRowsEnd) {
+        dirtyRowsBegin = begin;
+        dirtyRowsEnd = end;
+    } else {
+        dirtyRowsBegin = std::min(dirtyRowsBegin, begin);
+        dirtyRowsEnd = std::max(dirtyRowsEnd, end);
+    }
+}
+
 void GlyphAtlas::removeGlyphs(uintptr_t tileUID) {
     std::lock_guard<std::mutex> lock(mtx);
 
@@ -193,6 +215,11 @@ void GlyphAtlas::removeGlyphs(uintptr_t tileUID) {
                     }
                 }
 
+                // Don't set the dirty flag — an upload isn't needed until a
+                // new glyph lands — but do widen the band so the next upload
+                // carries the cleared pixels along.
+                markDirtyRows(rect.y, rect.y + rect.h);
+
                 bin.release(rect);
 
                 // Make sure to post-increment the iterator: This will return the
@@ -217,10 +244,19 @@ void GlyphAtlas::upload(gl::Context& context, gl::TextureUnit unit) {
     if (!texture) {
         texture = context.createTexture(image, unit);
     } else if (dirty) {
-        context.updateTexture(*texture, image, unit);
+        if (dirtyRowsBegin < dirtyRowsEnd) {
+            // Only re-upload the band of rows that changed since the last
+            // upload; a newly arrived glyph range no longer pushes the whole
+            // page to the GPU.
+            context.updateTextureBand(*texture, image, dirtyRowsBegin,
+                                      dirtyRowsEnd - dirtyRowsBegin, unit);
+        } else {
+            context.updateTexture(*texture, image, unit);
+        }
     }
 
     dirty = false;
+    dirtyRowsBegin = dirtyRowsEnd = 0;
 }
 
 void GlyphAtlas::bind(gl::Context& context, gl::TextureUnit unit) {
@@ -54,6 +54,12 @@ public:
 
     void setObserver(GlyphAtlasObserver* observer);
 
+    // Notifies the observer of a loaded glyph range on the next run loop
+    // iteration. Used instead of a direct observer call when the glyphs were
+    // satisfied synchronously (e.g. from the process-wide GlyphCache), since
+    // observers may reenter the atlas.
+    void scheduleGlyphsLoaded(const FontStack&, const GlyphRange&);
+
     void addGlyphs(uintptr_t tileUID,
                    const std::u16string& text,
                    const FontStack&,
@@ -77,6 +83,9 @@ private:
                             const FontStack&,
                             const SDFGlyph&);
 
+    // Extends the dirty row band to cover [begin, end). Caller must hold mtx.
+    void markDirtyRows(uint32_t begin, uint32_t end);
+
 
     FileSource& fileSource;
     std::string glyphURL;
@@ -103,7 +112,18 @@ private:
     std::unordered_map<FontStack, std::map<uint32_t, GlyphValue>, FontStackHash> index;
     const AlphaImage image;
     std::atomic<bool> dirty;
+
+    // Half-open band of atlas rows changed since the last upload. Glyph
+    // ranges arrive one PBF at a time, but their insertions coalesce here so
+    // upload() sends one bounded band per frame instead of re-uploading the
+    // full page for every arrival. Row-granular because ES2's
+    // glTexSubImage2D cannot upload a partial-width region of a wider
+    // client-side buffer (no GL_UNPACK_ROW_LENGTH). Guarded by mtx.
+    uint32_t dirtyRowsBegin = 0;
+    uint32_t dirtyRowsEnd = 0;
+
     mbgl::optional<gl::Texture> texture;
+    uint64_t memoryBudgetId;
 };
 
 } // namespace mbgl
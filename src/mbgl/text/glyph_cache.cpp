@@ -0,0 +1,33 @@
+#include <mbgl/text/glyph_cache.hpp>
+
+namespace mbgl {
+
+GlyphCache& GlyphCache::Get() {
+    static GlyphCache cache;
+    return cache;
+}
+
+bool GlyphCache::get(const std::string& url,
+                     const FontStack& fontStack,
+                     const GlyphRange& range,
+                     Glyphs& out) {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    auto it = cache.find(Key { url, fontStack, range });
+    if (it == cache.end()) {
+        return false;
+    }
+
+    out = it->second;
+    return true;
+}
+
+void GlyphCache::put(const std::string& url,
+                     const FontStack& fontStack,
+                     const GlyphRange& range,
+                     Glyphs glyphs) {
+    std::lock_guard<std::mutex> lock(mutex);
+    cache[Key { url, fontStack, range }] = std::move(glyphs);
+}
+
+} // namespace mbgl
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <mbgl/text/glyph.hpp>
+#include <mbgl/text/glyph_range.hpp>
+#include <mbgl/util/font_stack.hpp>
+#include <mbgl/util/noncopyable.hpp>
+
+#include <map>
+#include <mutex>
+#include <string>
+#include <tuple>
+
+namespace mbgl {
+
+/*
+    Process-wide cache of parsed SDF glyph ranges. GlyphAtlas is owned by the
+    Style and destroyed with it, so without this cache every style switch
+    refetches, reparses, and rerasterizes all glyph ranges even when the new
+    style uses the same fonts. Entries are keyed by glyph URL, font stack, and
+    range, and live for the lifetime of the process. Thread-safe.
+*/
+class GlyphCache : private util::noncopyable {
+public:
+    using Glyphs = std::map<uint32_t, SDFGlyph>;
+
+    static GlyphCache& Get();
+
+    // Copies the cached glyphs for the given key into `out`. Returns false if
+    // this range hasn't been parsed before.
+    bool get(const std::string& url, const FontStack&, const GlyphRange&, Glyphs& out);
+
+    void put(const std::string& url, const FontStack&, const GlyphRange&, Glyphs);
+
+private:
+    GlyphCache() = default;
+
+    using Key = std::tuple<std::string, FontStack, GlyphRange>;
+
+    std::mutex mutex;
+    std::map<Key, Glyphs> cache;
+};
+
+} // namespace mbgl
@@ -1,5 +1,6 @@
 #include <mbgl/text/glyph_pbf.hpp>
 #include <mbgl/text/glyph_atlas.hpp>
+#include <mbgl/text/glyph_cache.hpp>
 #include <mbgl/text/glyph_atlas_observer.hpp>
 #include <mbgl/text/glyph_set.hpp>
 #include <mbgl/storage/file_source.hpp>
@@ -16,7 +17,8 @@ namespace mbgl {
 
 namespace {
 
-void parseGlyphPBF(GlyphSet& glyphSet, const GlyphRange& glyphRange, const std::string& data) {
+GlyphCache::Glyphs parseGlyphPBF(const GlyphRange& glyphRange, const std::string& data) {
+    GlyphCache::Glyphs result;
     protozero::pbf_reader glyphs_pbf(data);
 
     while (glyphs_pbf.next(1)) {
@@ -82,10 +84,12 @@ void parseGlyphPBF(GlyphSet& glyphSet, const GlyphRange& glyphRange, const std::
                 glyph.metrics.top >= -128 && glyph.metrics.top < 128 &&
                 glyph.metrics.advance < 256 && glyph.bitmap.size() == expectedBitmapSize &&
                 glyph.id >= glyphRange.first && glyph.id <= glyphRange.second) {
-                glyphSet.insert(glyph.id, std::move(glyph));
+                result.emplace(glyph.id, std::move(glyph));
             }
         }
     }
+
+    return result;
 }
 
 } // namespace
@@ -97,6 +101,27 @@ GlyphPBF::GlyphPBF(GlyphAtlas* atlas,
                    FileSource& fileSource)
     : parsed(false),
       observer(observer_) {
+    // If this range was already parsed by a previous atlas (e.g. before a
+    // style switch), populate the glyph set straight from the process-wide
+    // cache instead of going back to the FileSource.
+    GlyphCache::Glyphs cached;
+    if (GlyphCache::Get().get(atlas->getURL(), fontStack, glyphRange, cached)) {
+        {
+            auto glyphSet = atlas->getGlyphSet(fontStack);
+            for (auto& pair : cached) {
+                (*glyphSet)->insert(pair.first, std::move(pair.second));
+            }
+        }
+
+        parsed = true;
+
+        // Notify asynchronously, mirroring the response callback: we are
+        // running under the atlas's ranges lock here, and observers are
+        // allowed to reenter the atlas.
+        atlas->scheduleGlyphsLoaded(fontStack, glyphRange);
+        return;
+    }
+
     req = fileSource.request(Resource::glyphs(atlas->getURL(), fontStack, glyphRange), [this, atlas, fontStack, glyphRange](Response res) {
         if (res.error) {
             observer->onGlyphsError(fontStack, glyphRange, std::make_exception_ptr(std::runtime_error(res.error->message)));
@@ -107,7 +132,16 @@ GlyphPBF::GlyphPBF(GlyphAtlas* atlas,
             observer->onGlyphsLoaded(fontStack, glyphRange);
         } else {
             try {
-                parseGlyphPBF(**atlas->getGlyphSet(fontStack), glyphRange, *res.data);
+                GlyphCache::Glyphs glyphs = parseGlyphPBF(glyphRange, *res.data);
+
+                {
+                    auto glyphSet = atlas->getGlyphSet(fontStack);
+                    for (const auto& pair : glyphs) {
+                        (*glyphSet)->insert(pair.first, SDFGlyph(pair.second));
+                    }
+                }
+
+                GlyphCache::Get().put(atlas->getURL(), fontStack, glyphRange, std::move(glyphs));
             } catch (...) {
                 observer->onGlyphsError(fontStack, glyphRange, std::current_exception());
                 return;
@@ -13,8 +13,12 @@ namespace mbgl {
 void GlyphSet::insert(uint32_t id, SDFGlyph&& glyph) {
     auto it = sdfs.find(id);
     if (it == sdfs.end()) {
-        // Glyph doesn't exist yet.
+        // Glyph doesn't exist yet. Cached shapings may have skipped this
+        // glyph while it was missing, so they are no longer valid.
         sdfs.emplace(id, std::move(glyph));
+        std::lock_guard<std::mutex> lock(shapingCacheMutex);
+        shapingCache.clear();
+        shapingOrder.clear();
     } else if (it->second.metrics == glyph.metrics) {
         if (it->second.bitmap != glyph.bitmap) {
             // The actual bitmap was updated; this is unsupported.
@@ -44,10 +48,24 @@ const Shaping GlyphSet::getShaping(const std::u16string& logicalInput,
                                    const Point<float>& translate,
                                    BiDi& bidi) const {
 
+    ShapingKey key { logicalInput, maxWidth,  lineHeight, horizontalAlign, verticalAlign,
+                     justify,      spacing,   translate.x, translate.y };
+
+    {
+        std::lock_guard<std::mutex> lock(shapingCacheMutex);
+        auto cached = shapingCache.find(key);
+        if (cached != shapingCache.end()) {
+            shapingOrder.splice(shapingOrder.begin(), shapingOrder, cached->second.second);
+            return cached->second.first;
+        }
+    }
+
     // The string stored in shaping.text is used for finding duplicates, but may end up quite
     // different from the glyphs that get shown
     Shaping shaping(translate.x * 24, translate.y * 24, logicalInput);
 
+    // Shaped outside the lock; two threads hitting the same uncached label
+    // concurrently just shape it twice, which is benign.
     std::vector<std::u16string> reorderedLines =
         bidi.processText(logicalInput,
                          determineLineBreaks(logicalInput, spacing, maxWidth));
@@ -55,6 +73,18 @@ const Shaping GlyphSet::getShaping(const std::u16string& logicalInput,
     shapeLines(shaping, reorderedLines, spacing, lineHeight, horizontalAlign, verticalAlign,
                justify, translate);
 
+    {
+        std::lock_guard<std::mutex> lock(shapingCacheMutex);
+        if (shapingCache.find(key) == shapingCache.end()) {
+            shapingOrder.push_front(key);
+            shapingCache.emplace(std::move(key), std::make_pair(shaping, shapingOrder.begin()));
+            if (shapingCache.size() > maximumShapingCacheSize) {
+                shapingCache.erase(shapingOrder.back());
+                shapingOrder.pop_back();
+            }
+        }
+    }
+
     return shaping;
 }
 
@@ -4,6 +4,11 @@
 #include <mbgl/text/glyph.hpp>
 #include <mbgl/util/geometry.hpp>
 
+#include <list>
+#include <mutex>
+#include <tuple>
+#include <utility>
+
 namespace mbgl {
 
 class GlyphSet {
@@ -38,6 +43,21 @@ private:
                     const Point<float>& translate) const;
 
     std::map<uint32_t, SDFGlyph> sdfs;
+
+    // Shaping results keyed by input string and shaping parameters, with
+    // least-recently-used eviction. Labels repeat heavily across features and
+    // tiles ("Main St" and friends), so most getShaping calls are duplicates.
+    // Guarded by its own mutex: SymbolLayout::prepare shapes feature chunks
+    // on several pool threads against the same set. Cleared whenever a new
+    // glyph is inserted, since shaping depends on which glyphs are present.
+    // Mutable because getShaping is logically const.
+    using ShapingKey =
+        std::tuple<std::u16string, float, float, float, float, float, float, float, float>;
+    using ShapingOrder = std::list<ShapingKey>;
+    mutable std::mutex shapingCacheMutex;
+    mutable ShapingOrder shapingOrder; // Most recently used first.
+    mutable std::map<ShapingKey, std::pair<Shaping, ShapingOrder::iterator>> shapingCache;
+    static const std::size_t maximumShapingCacheSize = 2048;
 };
 
 } // end namespace mbgl
@@ -17,7 +17,7 @@ SymbolQuads getIconQuads(Anchor& anchor, const PositionedIcon& shapedIcon,
         const GeometryCoordinates& line, const SymbolLayoutProperties::Evaluated& layout,
         const style::SymbolPlacementType placement, const Shaping& shapedText) {
 
-    auto image = *(shapedIcon.image);
+    const auto& image = *(shapedIcon.image);
 
     const float border = 1.0;
     auto left = shapedIcon.left - border;
@@ -172,6 +172,24 @@ SymbolQuads getGlyphQuads(Anchor& anchor, const Shaping& shapedText,
     const bool keepUpright = layout.get<TextKeepUpright>();
 
     SymbolQuads quads;
+    // Point placement produces exactly one quad per drawable glyph; line
+    // placement at least one. Sizing from the shaping result up front keeps
+    // the label from reallocating the vector as it grows glyph by glyph.
+    quads.reserve(shapedText.positionedGlyphs.size());
+
+    // The rotation is constant for the whole label; compute the matrix once
+    // instead of once per glyph instance.
+    std::array<float, 4> matrix = {{ 1, 0, 0, 1 }};
+    if (textRotate) {
+        const float angle_sin = std::sin(textRotate);
+        const float angle_cos = std::cos(textRotate);
+        matrix = {{angle_cos, -angle_sin, angle_sin, angle_cos}};
+    }
+
+    // Reused across glyphs: line placement appends a variable number of
+    // instances per glyph, and allocating a fresh vector for each one is
+    // measurable on symbol-heavy tiles.
+    GlyphInstances glyphInstances;
 
     for (const PositionedGlyph &positionedGlyph: shapedText.positionedGlyphs) {
         auto face_it = face.find(positionedGlyph.glyph);
@@ -188,7 +206,7 @@ SymbolQuads getGlyphQuads(Anchor& anchor, const Shaping& shapedText,
 
         const float centerX = (positionedGlyph.x + glyph.metrics.advance / 2.0f) * boxScale;
 
-        GlyphInstances glyphInstances;
+        glyphInstances.clear();
         if (placement == style::SymbolPlacementType::Line) {
             getSegmentGlyphs(std::back_inserter(glyphInstances), anchor, centerX, line, anchor.segment, true);
             if (keepUpright)
@@ -220,11 +238,6 @@ SymbolQuads getGlyphQuads(Anchor& anchor, const Shaping& shapedText,
             Point<float> br = obr;
 
             if (textRotate) {
-                // Compute the transformation matrix.
-                float angle_sin = std::sin(textRotate);
-                float angle_cos = std::cos(textRotate);
-                std::array<float, 4> matrix = {{angle_cos, -angle_sin, angle_sin, angle_cos}};
-
                 tl = util::matrixMultiply(matrix, tl);
                 tr = util::matrixMultiply(matrix, tr);
                 bl = util::matrixMultiply(matrix, bl);
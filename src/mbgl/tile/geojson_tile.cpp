@@ -25,15 +25,17 @@ public:
         return feature.properties;
     }
 
-    GeometryCollection getGeometries() const override {
-        GeometryCollection geometry = apply_visitor(ToGeometryCollection(), feature.geometry);
-
-        // https://github.com/mapbox/geojson-vt-cpp/issues/44
-        if (getType() == FeatureType::Polygon) {
-            geometry = fixupPolygons(geometry);
+    const GeometryCollection& getGeometries() const override {
+        if (!geometry) {
+            geometry = apply_visitor(ToGeometryCollection(), feature.geometry);
+
+            // https://github.com/mapbox/geojson-vt-cpp/issues/44
+            if (getType() == FeatureType::Polygon) {
+                geometry = fixupPolygons(*geometry);
+            }
         }
 
-        return geometry;
+        return *geometry;
     }
 
     optional<Value> getValue(const std::string& key) const override {
@@ -43,6 +45,9 @@ public:
         }
         return optional<Value>();
     }
+
+private:
+    mutable optional<GeometryCollection> geometry;
 };
 
 class GeoJSONTileData : public GeometryTileData,
@@ -62,6 +67,10 @@ public:
         return this;
     }
 
+    bool empty() const override {
+        return features.empty();
+    }
+
     std::string getName() const override {
         return "";
     }
@@ -2,10 +2,9 @@
 #include <mbgl/tile/geometry_tile_worker.hpp>
 #include <mbgl/tile/geometry_tile_data.hpp>
 #include <mbgl/tile/tile_observer.hpp>
+#include <mbgl/tile/tile_parse_pressure.hpp>
 #include <mbgl/style/update_parameters.hpp>
 #include <mbgl/style/layer_impl.hpp>
-#include <mbgl/style/layers/background_layer.hpp>
-#include <mbgl/style/layers/custom_layer.hpp>
 #include <mbgl/style/layers/symbol_layer.hpp>
 #include <mbgl/style/style.hpp>
 #include <mbgl/storage/file_source.hpp>
@@ -27,14 +26,19 @@ GeometryTile::GeometryTile(const OverscaledTileID& id_,
       mailbox(std::make_shared<Mailbox>(*util::RunLoop::Get())),
       worker(parameters.workerScheduler,
              ActorRef<GeometryTile>(*this, mailbox),
+             parameters.workerScheduler,
              id_,
              *parameters.style.glyphAtlas,
              obsolete,
              parameters.mode) {
+    // Style changes invalidate every tile at once, flooding the worker with
+    // setLayers/setPlacementConfig messages; let it drain them in batches.
+    worker.setBatchSize(8);
 }
 
 GeometryTile::~GeometryTile() {
     cancel();
+    TileParsePressure::remove(queuedParseBytes);
 }
 
 void GeometryTile::cancel() {
@@ -46,19 +50,47 @@ void GeometryTile::setError(std::exception_ptr err) {
 }
 
 void GeometryTile::setData(std::unique_ptr<const GeometryTileData> data_) {
+    // Tiles without any features — oceans, bare land — skip the worker round
+    // trip entirely: there is nothing to lay out or place, and wherever no
+    // bucket draws, the background shows through anyway. While the flag is
+    // set, every worker-bound message is suppressed so a stale layout cannot
+    // resurrect buckets from previous data.
+    if (data_ && data_->empty()) {
+        emptyData = true;
+        TileParsePressure::remove(queuedParseBytes);
+        queuedParseBytes = 0;
+        nonSymbolBuckets.clear();
+        symbolBuckets.clear();
+        collisionTile.reset();
+        featureIndex = std::make_unique<FeatureIndex>();
+        data = std::move(data_);
+        availableData = DataAvailability::All;
+        observer->onTileChanged(*this);
+        return;
+    }
+    emptyData = false;
+
     // Mark the tile as pending again if it was complete before to prevent signaling a complete
     // state despite pending parse operations.
     if (availableData == DataAvailability::All) {
         availableData = DataAvailability::Some;
     }
 
+    // A new payload supersedes whatever was still queued for this tile; only
+    // the latest one is ever parsed.
+    TileParsePressure::remove(queuedParseBytes);
+    queuedParseBytes = data_ ? data_->payloadSize() : 0;
+    TileParsePressure::add(queuedParseBytes);
+
     ++correlationID;
     worker.invoke(&GeometryTileWorker::setData, std::move(data_), correlationID);
     redoLayout();
 }
 
 void GeometryTile::setPlacementConfig(const PlacementConfig& desiredConfig) {
-    if (requestedConfig == desiredConfig) {
+    // Leave requestedConfig untouched while the tile is empty: it reflects
+    // what the worker last received, which matters again if real data arrives.
+    if (emptyData || requestedConfig == desiredConfig) {
         return;
     }
 
@@ -73,55 +105,89 @@ void GeometryTile::setPlacementConfig(const PlacementConfig& desiredConfig) {
     worker.invoke(&GeometryTileWorker::setPlacementConfig, desiredConfig, correlationID);
 }
 
+bool GeometryTile::needsPlacement(const PlacementConfig& desiredConfig) const {
+    return !emptyData && requestedConfig != desiredConfig;
+}
+
 void GeometryTile::symbolDependenciesChanged() {
+    if (emptyData) {
+        return;
+    }
     worker.invoke(&GeometryTileWorker::symbolDependenciesChanged);
 }
 
 void GeometryTile::redoLayout() {
+    if (emptyData) {
+        return;
+    }
+
     // Mark the tile as pending again if it was complete before to prevent signaling a complete
     // state despite pending parse operations.
     if (availableData == DataAvailability::All) {
         availableData = DataAvailability::Some;
     }
 
-    std::vector<std::unique_ptr<Layer>> copy;
+    // The snapshot is one set of layer clones shared by every tile relaying
+    // out in this update pass; filtering down to this tile's relevant layers
+    // only copies pointers. Background and custom layers are already excluded
+    // from the snapshot.
+    std::shared_ptr<const std::vector<std::shared_ptr<const Layer>>> snapshot =
+        style.getLayerSnapshot();
 
-    for (const Layer* layer : style.getLayers()) {
-        // Avoid cloning and including irrelevant layers.
-        if (layer->is<BackgroundLayer>() ||
-            layer->is<CustomLayer>() ||
-            layer->baseImpl->source != sourceID ||
+    std::vector<std::shared_ptr<const Layer>> copy;
+
+    for (const auto& layer : *snapshot) {
+        if (layer->baseImpl->source != sourceID ||
             id.overscaledZ < std::floor(layer->baseImpl->minZoom) ||
             id.overscaledZ >= std::ceil(layer->baseImpl->maxZoom) ||
             layer->baseImpl->visibility == VisibilityType::None) {
             continue;
         }
 
-        copy.push_back(layer->baseImpl->clone());
+        copy.push_back(layer);
     }
 
     ++correlationID;
     worker.invoke(&GeometryTileWorker::setLayers, std::move(copy), correlationID);
 }
 
+void GeometryTile::inheritLayout(Tile& origin) {
+    // All tiles of one source share a concrete type, so a sibling of a
+    // GeometryTile is a GeometryTile. Its worker decides on its own thread
+    // which of its buckets are shareable and seeds our worker directly.
+    static_cast<GeometryTile&>(origin).worker.invoke(&GeometryTileWorker::shareLayoutTo, worker.self());
+}
+
 void GeometryTile::onLayout(LayoutResult result) {
+    if (emptyData) {
+        return; // In-flight result from data that the empty payload replaced.
+    }
+    TileParsePressure::remove(queuedParseBytes);
+    queuedParseBytes = 0;
     availableData = DataAvailability::Some;
     nonSymbolBuckets = std::move(result.nonSymbolBuckets);
     featureIndex = std::move(result.featureIndex);
     data = std::move(result.tileData);
+    layoutDuration = result.layoutDuration;
     observer->onTileChanged(*this);
 }
 
 void GeometryTile::onPlacement(PlacementResult result) {
-    if (result.correlationID == correlationID) {
+    if (emptyData) {
+        return; // In-flight result from data that the empty payload replaced.
+    }
+    if (result.correlationID == correlationID && result.complete) {
         availableData = DataAvailability::All;
     }
     symbolBuckets = std::move(result.symbolBuckets);
     collisionTile = std::move(result.collisionTile);
+    placementDuration = result.placementDuration;
     observer->onTileChanged(*this);
 }
 
 void GeometryTile::onError(std::exception_ptr err) {
+    TileParsePressure::remove(queuedParseBytes);
+    queuedParseBytes = 0;
     availableData = DataAvailability::All;
     observer->onTileError(*this, err);
 }
@@ -137,6 +203,21 @@ Bucket* GeometryTile::getBucket(const Layer& layer) {
     return it->second.get();
 }
 
+Duration GeometryTile::rebuildCost() const {
+    return layoutDuration + placementDuration;
+}
+
+std::size_t GeometryTile::byteSize() const {
+    std::size_t total = 0;
+    for (const auto& entry : nonSymbolBuckets) {
+        total += entry.second->uploadByteSize();
+    }
+    for (const auto& entry : symbolBuckets) {
+        total += entry.second->uploadByteSize();
+    }
+    return total;
+}
+
 void GeometryTile::queryRenderedFeatures(
     std::unordered_map<std::string, std::vector<Feature>>& result,
     const GeometryCoordinates& queryGeometry,
@@ -35,8 +35,10 @@ public:
     void setData(std::unique_ptr<const GeometryTileData>);
 
     void setPlacementConfig(const PlacementConfig&) override;
+    bool needsPlacement(const PlacementConfig&) const override;
     void symbolDependenciesChanged() override;
     void redoLayout() override;
+    void inheritLayout(Tile&) override;
 
     Bucket* getBucket(const style::Layer&) override;
 
@@ -48,20 +50,36 @@ public:
 
     void cancel() override;
 
+    std::size_t byteSize() const override;
+    Duration rebuildCost() const override;
+
     class LayoutResult {
     public:
         std::unordered_map<std::string, std::shared_ptr<Bucket>> nonSymbolBuckets;
         std::unique_ptr<FeatureIndex> featureIndex;
         std::unique_ptr<GeometryTileData> tileData;
+        Duration layoutDuration;
         uint64_t correlationID;
     };
     void onLayout(LayoutResult);
 
+    // Placement on the worker writes into freshly built buckets (or reuses
+    // the previous ones, see SymbolLayout::place) and the whole set is
+    // swapped in at once by onPlacement, so the render thread keeps drawing
+    // the prior placement until the new one is complete and the worker never
+    // mutates a bucket the foreground holds.
     class PlacementResult {
     public:
         std::unordered_map<std::string, std::shared_ptr<Bucket>> symbolBuckets;
         std::unique_ptr<CollisionTile> collisionTile;
+        Duration placementDuration;
         uint64_t correlationID;
+
+        // False while some symbol layouts were skipped because their glyph
+        // or icon dependencies were still in flight. Partial results update
+        // the visuals so ready labels appear progressively, but only a
+        // complete one marks the tile's data fully available.
+        bool complete;
     };
     void onPlacement(PlacementResult);
 
@@ -80,12 +98,26 @@ private:
     uint64_t correlationID = 0;
     optional<PlacementConfig> requestedConfig;
 
+    // Set when the current data contains no features. The tile is then served
+    // entirely from the foreground (empty buckets, empty feature index) and
+    // the worker is left untouched until real data arrives.
+    bool emptyData = false;
+
+    // Payload bytes currently queued for the worker but not yet parsed,
+    // registered with TileParsePressure; zero once layout has consumed them.
+    std::size_t queuedParseBytes = 0;
+
     std::unordered_map<std::string, std::shared_ptr<Bucket>> nonSymbolBuckets;
     std::unique_ptr<FeatureIndex> featureIndex;
     std::unique_ptr<const GeometryTileData> data;
 
     std::unordered_map<std::string, std::shared_ptr<Bucket>> symbolBuckets;
     std::unique_ptr<CollisionTile> collisionTile;
+
+    // Worker time spent on the most recent layout and placement passes, as
+    // reported with their results; see Tile::rebuildCost().
+    Duration layoutDuration = Duration::zero();
+    Duration placementDuration = Duration::zero();
 };
 
 } // namespace mbgl
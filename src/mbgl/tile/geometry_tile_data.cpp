@@ -17,6 +17,84 @@ static double signedArea(const GeometryCoordinates& ring) {
     return sum;
 }
 
+static int sign(int64_t value) {
+    return (value > 0) - (value < 0);
+}
+
+// Twice the signed area of the triangle a-b-c. Integer math: the int16_t
+// coordinate range cannot overflow the 64-bit products.
+static int64_t orientation(const GeometryCoordinate& a,
+                           const GeometryCoordinate& b,
+                           const GeometryCoordinate& c) {
+    return int64_t(b.x - a.x) * int64_t(c.y - a.y) - int64_t(b.y - a.y) * int64_t(c.x - a.x);
+}
+
+// Whether p, known to be collinear with the segment a-b, lies on it.
+static bool onSegment(const GeometryCoordinate& a,
+                      const GeometryCoordinate& b,
+                      const GeometryCoordinate& p) {
+    return std::min(a.x, b.x) <= p.x && p.x <= std::max(a.x, b.x) &&
+           std::min(a.y, b.y) <= p.y && p.y <= std::max(a.y, b.y);
+}
+
+static bool segmentsIntersect(const GeometryCoordinate& a0, const GeometryCoordinate& a1,
+                              const GeometryCoordinate& b0, const GeometryCoordinate& b1) {
+    const int d1 = sign(orientation(b0, b1, a0));
+    const int d2 = sign(orientation(b0, b1, a1));
+    const int d3 = sign(orientation(a0, a1, b0));
+    const int d4 = sign(orientation(a0, a1, b1));
+    if (d1 != d2 && d3 != d4) return true;
+    if (d1 == 0 && onSegment(b0, b1, a0)) return true;
+    if (d2 == 0 && onSegment(b0, b1, a1)) return true;
+    if (d3 == 0 && onSegment(a0, a1, b0)) return true;
+    if (d4 == 0 && onSegment(a0, a1, b1)) return true;
+    return false;
+}
+
+// Whether the ring (open or with a repeated closing point) neither
+// self-intersects nor doubles back on itself. O(n²) over segment pairs with
+// early exit; callers cap the ring size so this stays cheaper than handing
+// the ring to clipper.
+static bool ringIsSimple(const GeometryCoordinates& ring) {
+    std::size_t len = ring.size();
+    if (len > 1 && ring.front() == ring.back()) {
+        --len; // Ignore the repeated closing point.
+    }
+    if (len < 3) {
+        return false;
+    }
+
+    for (std::size_t i = 0; i < len; ++i) {
+        const GeometryCoordinate& a0 = ring[i];
+        const GeometryCoordinate& a1 = ring[(i + 1) % len];
+
+        if (a0 == a1) {
+            return false; // Zero-length segment.
+        }
+
+        // A segment folding straight back along its predecessor forms a
+        // zero-width spike that the proper intersection test below does not
+        // see, because adjacent segments legitimately share an endpoint.
+        const GeometryCoordinate& a2 = ring[(i + 2) % len];
+        if (orientation(a0, a1, a2) == 0 &&
+            int64_t(a0.x - a1.x) * int64_t(a2.x - a1.x) +
+            int64_t(a0.y - a1.y) * int64_t(a2.y - a1.y) > 0) {
+            return false;
+        }
+
+        for (std::size_t j = i + 2; j < len; ++j) {
+            if (i == 0 && j == len - 1) {
+                continue; // Adjacent through the wrap-around.
+            }
+            if (segmentsIntersect(a0, a1, ring[j], ring[(j + 1) % len])) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
 static ClipperLib::Path toClipperPath(const GeometryCoordinates& ring) {
     ClipperLib::Path result;
     result.reserve(ring.size());
@@ -67,6 +145,23 @@ static void processPolynodeBranch(ClipperLib::PolyNode* polynode, GeometryCollec
 }
 
 GeometryCollection fixupPolygons(const GeometryCollection& rings) {
+    // The overwhelming majority of inputs — simple annotation shapes clipped
+    // to a tile — arrive as one well-formed ring. Those don't need clipper's
+    // Vatti sweep at all: verifying simplicity and normalizing the winding
+    // produces the same result without the allocations. The quadratic
+    // simplicity test is only cheaper than the sweep for moderate ring
+    // sizes, so big or ill-formed inputs take the general path below.
+    if (rings.size() == 1 && rings.front().size() <= 256 && ringIsSimple(rings.front())) {
+        GeometryCoordinates ring = rings.front();
+        if (ring.front() != ring.back()) {
+            ring.push_back(ring.front());
+        }
+        if (signedArea(ring) < 0) {
+            std::reverse(ring.begin(), ring.end());
+        }
+        return {{ std::move(ring) }};
+    }
+
     ClipperLib::Clipper clipper;
     clipper.StrictlySimple(true);
 
@@ -146,7 +241,7 @@ static Feature::geometry_type convertGeometry(const GeometryTileFeature& geometr
         );
     };
 
-    GeometryCollection geometries = geometryTileFeature.getGeometries();
+    const GeometryCollection& geometries = geometryTileFeature.getGeometries();
 
     switch (geometryTileFeature.getType()) {
         case FeatureType::Unknown: {
@@ -37,7 +37,11 @@ public:
     virtual optional<Value> getValue(const std::string& key) const = 0;
     virtual PropertyMap getProperties() const { return PropertyMap(); }
     virtual optional<FeatureIdentifier> getID() const { return {}; }
-    virtual GeometryCollection getGeometries() const = 0;
+
+    // The returned reference remains valid for the lifetime of the feature.
+    // Implementations decode lazily and cache, so repeated calls are free and
+    // callers that only iterate don't pay for a copy.
+    virtual const GeometryCollection& getGeometries() const = 0;
 };
 
 class GeometryTileLayer {
@@ -53,6 +57,22 @@ public:
     virtual ~GeometryTileData() = default;
     virtual std::unique_ptr<GeometryTileData> clone() const = 0;
     virtual const GeometryTileLayer* getLayer(const std::string&) const = 0;
+
+    // Hash of the underlying tile payload, if the implementation can compute
+    // one cheaply. Two data objects with equal engaged hashes are guaranteed to
+    // describe identical content, which lets the worker keep its parsed bucket
+    // cache warm across refreshes that didn't change the data (e.g. a
+    // revalidation that returned the same bytes).
+    virtual optional<std::uint64_t> contentHash() const { return {}; }
+
+    // Whether this tile contains no features at all (e.g. ocean or bare-land
+    // tiles), determined without a full parse. May answer conservatively:
+    // false is always safe and merely forgoes the empty-tile fast path.
+    virtual bool empty() const { return false; }
+
+    // Size in bytes of the unparsed payload backing this data, for the parse
+    // backpressure accounting (see TileParsePressure); zero when unknown.
+    virtual std::size_t payloadSize() const { return 0; }
 };
 
 // classifies an array of rings into polygons with outer rings and holes
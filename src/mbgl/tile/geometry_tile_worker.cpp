@@ -1,20 +1,27 @@
 #include <mbgl/tile/geometry_tile_worker.hpp>
 #include <mbgl/tile/geometry_tile_data.hpp>
 #include <mbgl/tile/geometry_tile.hpp>
+#include <mbgl/actor/actor.hpp>
+#include <mbgl/actor/scheduler.hpp>
+#include <mbgl/actor/task_group.hpp>
 #include <mbgl/text/collision_tile.hpp>
 #include <mbgl/text/glyph_atlas.hpp>
 #include <mbgl/layout/symbol_layout.hpp>
+#include <mbgl/gl/buffer_budget.hpp>
 #include <mbgl/style/bucket_parameters.hpp>
 #include <mbgl/style/group_by_layout.hpp>
 #include <mbgl/style/filter.hpp>
 #include <mbgl/style/filter_evaluator.hpp>
+#include <mbgl/style/layers/line_layer.hpp>
 #include <mbgl/style/layers/symbol_layer.hpp>
 #include <mbgl/style/layers/symbol_layer_impl.hpp>
 #include <mbgl/renderer/symbol_bucket.hpp>
 #include <mbgl/util/logging.hpp>
 #include <mbgl/util/constants.hpp>
+#include <mbgl/util/simplify.hpp>
 #include <mbgl/util/string.hpp>
 #include <mbgl/util/exception.hpp>
+#include <mbgl/util/tracing.hpp>
 
 #include <unordered_set>
 
@@ -24,12 +31,14 @@ using namespace style;
 
 GeometryTileWorker::GeometryTileWorker(ActorRef<GeometryTileWorker> self_,
                                        ActorRef<GeometryTile> parent_,
+                                       Scheduler& scheduler_,
                                        OverscaledTileID id_,
                                        GlyphAtlas& glyphAtlas_,
                                        const std::atomic<bool>& obsolete_,
                                        const MapMode mode_)
     : self(std::move(self_)),
       parent(std::move(parent_)),
+      scheduler(scheduler_),
       id(std::move(id_)),
       glyphAtlas(glyphAtlas_),
       obsolete(obsolete_),
@@ -75,8 +84,18 @@ GeometryTileWorker::~GeometryTileWorker() {
 
 void GeometryTileWorker::setData(std::unique_ptr<const GeometryTileData> data_, uint64_t correlationID_) {
     try {
+        // If the incoming payload hashes identically to what we already laid
+        // out, the bucket caches stay warm and redoLayout degenerates to a
+        // cache sweep plus placement. Without a hash (or without prior data),
+        // assume the data changed.
+        const bool sameData = data && data_ && data->contentHash() &&
+                              data->contentHash() == data_->contentHash();
+
         data = std::move(data_);
         correlationID = correlationID_;
+        if (!sameData) {
+            dataChanged = true;
+        }
 
         switch (state) {
         case Idle:
@@ -95,7 +114,7 @@ void GeometryTileWorker::setData(std::unique_ptr<const GeometryTileData> data_,
     }
 }
 
-void GeometryTileWorker::setLayers(std::vector<std::unique_ptr<Layer>> layers_, uint64_t correlationID_) {
+void GeometryTileWorker::setLayers(std::vector<std::shared_ptr<const Layer>> layers_, uint64_t correlationID_) {
     try {
         layers = std::move(layers_);
         correlationID = correlationID_;
@@ -168,6 +187,55 @@ void GeometryTileWorker::symbolDependenciesChanged() {
     }
 }
 
+void GeometryTileWorker::shareLayoutTo(ActorRef<GeometryTileWorker> other) {
+    try {
+        // Only a cache that matches the current data can be shared; a pending
+        // re-layout (dataChanged) means it still reflects a previous payload.
+        if (!data || !*data || !layers || dataChanged || bucketCache.empty()) {
+            return;
+        }
+
+        const optional<std::uint64_t> contentHash = (*data)->contentHash();
+        if (!contentHash) {
+            return;
+        }
+
+        auto seed = std::make_shared<LayoutSeed>();
+        seed->contentHash = contentHash;
+
+        for (const auto& group : groupByLayout(*layers)) {
+            if (group.at(0)->is<SymbolLayer>()) {
+                continue; // Placement always re-runs per overzoom level.
+            }
+
+            bool shareable = true;
+            for (const Layer* layer : group) {
+                shareable = shareable && layer->baseImpl->hasZoomIndependentBuckets();
+            }
+            if (!shareable) {
+                continue;
+            }
+
+            auto cached = bucketCache.find(bucketKey(group));
+            if (cached != bucketCache.end()) {
+                seed->entries.emplace(cached->first, cached->second);
+            }
+        }
+
+        if (!seed->entries.empty()) {
+            other.invoke(&GeometryTileWorker::seedLayout, std::move(seed));
+        }
+    } catch (...) {
+        parent.invoke(&GeometryTile::onError, std::current_exception());
+    }
+}
+
+void GeometryTileWorker::seedLayout(std::shared_ptr<const LayoutSeed> seed) {
+    // Applied by the next redoLayout(); if our layout already ran, existing
+    // cache entries win and the seed only fills the gaps.
+    layoutSeed = std::move(seed);
+}
+
 void GeometryTileWorker::coalesced() {
     try {
         switch (state) {
@@ -204,19 +272,83 @@ void GeometryTileWorker::redoLayout() {
         return;
     }
 
-    std::vector<std::string> symbolOrder;
+    MBGL_TRACE_SPAN_ID("worker", "layout",
+                       util::Tracing::Active() ? util::toString(id) : std::string());
+
+    // Timed so the foreground cache can weigh how expensive this tile would
+    // be to rebuild; see Tile::rebuildCost().
+    const TimePoint layoutStart = Clock::now();
+
+    symbolOrder.clear();
     for (auto it = layers->rbegin(); it != layers->rend(); it++) {
         if ((*it)->is<SymbolLayer>()) {
             symbolOrder.push_back((*it)->getID());
         }
     }
 
-    std::unordered_map<std::string, std::unique_ptr<SymbolLayout>> symbolLayoutMap;
+    // New data invalidates everything we built from the old data; layer-only
+    // changes can reuse the groups whose bucket keys are unchanged.
+    if (dataChanged) {
+        bucketCache.clear();
+        symbolLayoutCache.clear();
+        dataChanged = false;
+    }
+
+    // A sibling tile overzooming the same canonical tile may have seeded us
+    // with its zoom-independent buckets. Adopt them if they were built from
+    // identical data, so the reuse pass below skips those groups entirely.
+    if (layoutSeed) {
+        if (*data && (*data)->contentHash() &&
+            (*data)->contentHash() == layoutSeed->contentHash) {
+            for (const auto& entry : layoutSeed->entries) {
+                bucketCache.emplace(entry.first, entry.second);
+            }
+        }
+        layoutSeed = nullptr;
+    }
+
+    symbolLayoutMap.clear();
+    std::unordered_map<std::string, std::shared_ptr<SymbolLayout>> newSymbolLayoutCache;
+    newSymbolLayoutCache.reserve(symbolLayoutCache.size());
     std::unordered_map<std::string, std::shared_ptr<Bucket>> buckets;
+    buckets.reserve(previousBucketCount);
     auto featureIndex = std::make_unique<FeatureIndex>();
-    BucketParameters parameters { id, mode };
+    featureIndex->reserve(previousFeatureIndexSize);
+    BucketParameters parameters { id, mode, obsolete };
 
     std::vector<std::vector<const Layer*>> groups = groupByLayout(*layers);
+
+    // Bucket construction for the non-symbol groups is independent (the
+    // groups from groupByLayout share no state), so fan it out over the
+    // worker pool and join before sending the result. Symbol layouts stay on
+    // this thread because they interact with the shared glyph atlas.
+    struct GroupLayout {
+        const std::vector<const Layer*>* group;
+        const GeometryTileLayer* geometryLayer;
+        std::string key;
+        std::shared_ptr<Bucket> bucket;
+        std::vector<std::pair<GeometryCollection, std::size_t>> features;
+    };
+
+    std::vector<GroupLayout> groupLayouts;
+    groupLayouts.reserve(groups.size());
+
+    TaskGroup taskGroup;
+    std::unique_ptr<Actor<TaskGroupHelper>> helper;
+    std::size_t taskCount = 0;
+
+    // Rough per-feature buffer cost, accumulated while the groups are walked
+    // and settled against the GL buffer budget before any bucket task runs
+    // (tasks only execute once the helper actors start, below). Lines
+    // dominate: every source point fans out into several join/cap vertices.
+    // A pressure factor above 1 widens the line simplification tolerance, so
+    // a tile that would blow the buffer budget sheds vertices during layout
+    // instead of failing to allocate at upload time.
+    static const std::size_t estimatedBytesPerLineFeature = 1024;
+    static const std::size_t estimatedBytesPerFeature = 256;
+    std::size_t estimatedBucketBytes = 0;
+    double bucketPressure = 1.0;
+
     for (auto& group : groups) {
         if (obsolete) {
             return;
@@ -229,46 +361,147 @@ void GeometryTileWorker::redoLayout() {
         const Layer& leader = *group.at(0);
 
         auto geometryLayer = (*data)->getLayer(leader.baseImpl->sourceLayer);
-        if (!geometryLayer) {
+        if (!geometryLayer || geometryLayer->featureCount() == 0) {
+            // Source layer missing or present but empty: there is nothing to
+            // lay out, place or index, so skip the bucket and symbol layout
+            // setup entirely.
             continue;
         }
 
-        std::vector<std::string> layerIDs;
+        groupLayerIDs.clear();
         for (const auto& layer : group) {
-            layerIDs.push_back(layer->getID());
+            groupLayerIDs.push_back(layer->getID());
         }
 
-        featureIndex->setBucketLayerIDs(leader.getID(), layerIDs);
+        featureIndex->setBucketLayerIDs(leader.getID(), groupLayerIDs);
+
+        const std::string key = bucketKey(group);
 
         if (leader.is<SymbolLayer>()) {
-            symbolLayoutMap.emplace(leader.getID(),
-                leader.as<SymbolLayer>()->impl->createLayout(parameters, group, *geometryLayer));
-        } else {
-            const Filter& filter = leader.baseImpl->filter;
-            const std::string& sourceLayerID = leader.baseImpl->sourceLayer;
-            std::shared_ptr<Bucket> bucket = leader.baseImpl->createBucket(parameters, group);
+            std::shared_ptr<SymbolLayout> symbolLayout;
 
-            for (std::size_t i = 0; !obsolete && i < geometryLayer->featureCount(); i++) {
-                std::unique_ptr<GeometryTileFeature> feature = geometryLayer->getFeature(i);
+            auto cached = symbolLayoutCache.find(key);
+            if (cached != symbolLayoutCache.end()) {
+                symbolLayout = cached->second;
+            } else {
+                symbolLayout = leader.as<SymbolLayer>()->impl->createLayout(parameters, group, *geometryLayer);
+            }
 
-                if (!filter(feature->getType(), feature->getID(), [&] (const auto& key) { return feature->getValue(key); }))
-                    continue;
+            newSymbolLayoutCache.emplace(key, symbolLayout);
+            symbolLayoutMap.emplace(leader.getID(), std::move(symbolLayout));
+        } else {
+            groupLayouts.push_back(GroupLayout { &group, geometryLayer, key, nullptr, {} });
 
-                GeometryCollection geometries = feature->getGeometries();
-                bucket->addFeature(*feature, geometries);
-                featureIndex->insert(geometries, i, sourceLayerID, leader.getID());
+            if (bucketCache.find(key) != bucketCache.end()) {
+                continue; // Reused in the merge below; nothing to rebuild.
             }
 
-            if (!bucket->hasData()) {
-                continue;
-            }
+            GroupLayout& entry = groupLayouts.back();
+            ++taskCount;
+
+            estimatedBucketBytes += geometryLayer->featureCount() *
+                (leader.is<LineLayer>() ? estimatedBytesPerLineFeature : estimatedBytesPerFeature);
+
+            taskGroup.add([this, &entry, &parameters, &bucketPressure] {
+                const Layer& groupLeader = *entry.group->at(0);
+                const Filter& filter = groupLeader.baseImpl->filter;
+
+                // Most filters never inspect "$id"; determine this once per
+                // layer group so the feature loop below can skip building the
+                // identifier, which may copy a string id for every feature.
+                const std::string idKey = "$id";
+                const bool filterNeedsID = Filter::visit(filter, FilterKeyUsage { idKey });
+
+                // Sub-pixel simplification before tessellation: line joins and
+                // caps multiply every source point into several vertices, so
+                // decimating within half a pixel cuts LineBucket volume with no
+                // visible change. Overscaled tiles render magnified, so their
+                // tolerance shrinks accordingly. Points must never be dropped,
+                // and simplifying shared polygon borders independently can open
+                // hairline cracks between adjacent fills, so only line groups
+                // simplify.
+                // Buffer-budget pressure widens the tolerance further: dense
+                // line vertex counts fall roughly linearly with it, which is
+                // the graceful end of the degradation the budget asks for.
+                const double tolerance = groupLeader.is<LineLayer>()
+                    ? util::SIMPLIFY_DEFAULT_TOLERANCE * bucketPressure /
+                          parameters.tileID.overscaleFactor()
+                    : 0.0;
+
+                entry.bucket = groupLeader.baseImpl->createBucket(parameters, *entry.group);
+
+                for (std::size_t i = 0; !obsolete && i < entry.geometryLayer->featureCount(); i++) {
+                    std::unique_ptr<GeometryTileFeature> feature = entry.geometryLayer->getFeature(i);
+
+                    if (!filter(feature->getType(),
+                                filterNeedsID ? feature->getID() : optional<FeatureIdentifier>(),
+                                [&] (const auto& key) { return feature->getValue(key); }))
+                        continue;
+
+                    GeometryCollection geometries = feature->getGeometries();
+                    if (tolerance > 0) {
+                        geometries = util::simplify(geometries, tolerance);
+                    }
+                    entry.bucket->addFeature(*feature, geometries);
+                    entry.features.emplace_back(std::move(geometries), i);
+                }
+
+                // The bucket is final; return the staging vectors' growth
+                // slack before it ships to the foreground.
+                entry.bucket->commit();
+            });
+        }
+    }
+
+    bucketPressure = gl::BufferBudget::Pressure(estimatedBucketBytes);
+
+    if (taskCount > 1) {
+        helper = std::make_unique<Actor<TaskGroupHelper>>(scheduler, taskGroup);
+        for (std::size_t i = 1; i < taskCount; ++i) {
+            helper->invoke(&TaskGroupHelper::runOne);
+        }
+    }
+
+    taskGroup.join();
+
+    std::unordered_map<std::string, BucketCacheEntry> newBucketCache;
+    newBucketCache.reserve(bucketCache.size());
+
+    for (auto& entry : groupLayouts) {
+        if (obsolete) {
+            return;
+        }
+
+        const Layer& leader = *entry.group->at(0);
+        const std::string& sourceLayerID = leader.baseImpl->sourceLayer;
+
+        auto cached = bucketCache.find(entry.key);
+        if (cached != bucketCache.end()) {
+            entry.bucket = cached->second.bucket;
+            entry.features = std::move(cached->second.features);
+            bucketCache.erase(cached);
+        }
 
-            for (const auto& layer : group) {
-                buckets.emplace(layer->getID(), bucket);
+        // Intern once per group; insert() then stores integer handles per ring.
+        const util::InternedString internedSourceLayerID { sourceLayerID };
+        const util::InternedString internedBucketID { leader.getID() };
+        for (auto& pair : entry.features) {
+            featureIndex->insert(pair.first, pair.second, internedSourceLayerID, internedBucketID);
+        }
+
+        if (entry.bucket->hasData()) {
+            for (const auto& layer : *entry.group) {
+                buckets.emplace(layer->getID(), entry.bucket);
             }
         }
+
+        newBucketCache.emplace(std::move(entry.key),
+                               BucketCacheEntry { std::move(entry.bucket), std::move(entry.features) });
     }
 
+    bucketCache = std::move(newBucketCache);
+    symbolLayoutCache = std::move(newSymbolLayoutCache);
+
     symbolLayouts.clear();
     for (const auto& symbolLayerID : symbolOrder) {
         auto it = symbolLayoutMap.find(symbolLayerID);
@@ -276,11 +509,16 @@ void GeometryTileWorker::redoLayout() {
             symbolLayouts.push_back(std::move(it->second));
         }
     }
+    emptyPlacementDelivered = false;
+
+    previousBucketCount = buckets.size();
+    previousFeatureIndexSize = featureIndex->size();
 
     parent.invoke(&GeometryTile::onLayout, GeometryTile::LayoutResult {
         std::move(buckets),
         std::move(featureIndex),
         *data ? (*data)->clone() : nullptr,
+        Clock::now() - layoutStart,
         correlationID
     });
 
@@ -304,7 +542,23 @@ void GeometryTileWorker::attemptPlacement() {
         return;
     }
 
-    bool canPlace = true;
+    MBGL_TRACE_SPAN_ID("worker", "placement",
+                       util::Tracing::Active() ? util::toString(id) : std::string());
+
+    const TimePoint placementStart = Clock::now();
+
+    // A tile without symbol layers yields the same empty placement at every
+    // angle. The first result still has to be delivered so that the tile
+    // reaches DataAvailability::All; after that, each placement request for
+    // a new camera angle would only ship the same empty bucket map and a
+    // fresh (but unqueried) collision tile to the foreground again. Skip the
+    // round trip and leave the delivered result in place.
+    if (symbolLayouts.empty() && emptyPlacementDelivered) {
+        return;
+    }
+
+    bool allPrepared = true;
+    std::size_t preparedCount = 0;
 
     // Prepare as many SymbolLayouts as possible.
     for (auto& symbolLayout : symbolLayouts) {
@@ -316,15 +570,26 @@ void GeometryTileWorker::attemptPlacement() {
             if (symbolLayout->canPrepare(glyphAtlas)) {
                 symbolLayout->state = SymbolLayout::Prepared;
                 symbolLayout->prepare(reinterpret_cast<uintptr_t>(this),
-                                      glyphAtlas);
+                                      glyphAtlas,
+                                      scheduler);
             } else {
-                canPlace = false;
+                allPrepared = false;
+                continue;
             }
         }
+        ++preparedCount;
     }
 
-    if (!canPlace) {
-        return; // We'll be notified (via `setPlacementConfig`) when it's time to try again.
+    if (!allPrepared) {
+        // Still renders capture a single frame, so a partial result would be
+        // final; wait for every dependency. Continuous mode places the ready
+        // layouts now — on a cold glyph cache one slow range (commonly CJK)
+        // otherwise gates every label in the tile — and re-runs the full
+        // placement when the stragglers' dependencies land (we are notified
+        // via `symbolDependenciesChanged`).
+        if (mode == MapMode::Still || preparedCount == 0) {
+            return;
+        }
     }
 
     auto collisionTile = std::make_unique<CollisionTile>(*placementConfig);
@@ -335,22 +600,35 @@ void GeometryTileWorker::attemptPlacement() {
             return;
         }
 
+        if (symbolLayout->state == SymbolLayout::Pending) {
+            continue; // Dependencies still in flight; placed once they land.
+        }
+
         symbolLayout->state = SymbolLayout::Placed;
         if (!symbolLayout->hasSymbolInstances()) {
             continue;
         }
 
         std::shared_ptr<Bucket> bucket = symbolLayout->place(*collisionTile);
+        bucket->commit();
         for (const auto& pair : symbolLayout->layerPaintProperties) {
             buckets.emplace(pair.first, bucket);
         }
     }
 
+    // Repack the collision boxes for querying; the foreground only ever
+    // reads the tile through queryRenderedSymbols.
+    collisionTile->finalize();
+
     parent.invoke(&GeometryTile::onPlacement, GeometryTile::PlacementResult {
         std::move(buckets),
         std::move(collisionTile),
-        correlationID
+        Clock::now() - placementStart,
+        correlationID,
+        allPrepared
     });
+
+    emptyPlacementDelivered = symbolLayouts.empty();
 }
 
 } // namespace mbgl
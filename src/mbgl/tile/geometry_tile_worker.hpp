@@ -2,6 +2,7 @@
 
 #include <mbgl/map/mode.hpp>
 #include <mbgl/tile/tile_id.hpp>
+#include <mbgl/tile/geometry_tile_data.hpp>
 #include <mbgl/text/placement_config.hpp>
 #include <mbgl/actor/actor_ref.hpp>
 #include <mbgl/util/optional.hpp>
@@ -12,9 +13,10 @@
 
 namespace mbgl {
 
+class Bucket;
 class GeometryTile;
-class GeometryTileData;
 class GlyphAtlas;
+class Scheduler;
 class SymbolLayout;
 
 namespace style {
@@ -25,17 +27,39 @@ class GeometryTileWorker {
 public:
     GeometryTileWorker(ActorRef<GeometryTileWorker> self,
                        ActorRef<GeometryTile> parent,
+                       Scheduler&,
                        OverscaledTileID,
                        GlyphAtlas&,
                        const std::atomic<bool>&,
                        const MapMode);
     ~GeometryTileWorker();
 
-    void setLayers(std::vector<std::unique_ptr<style::Layer>>, uint64_t correlationID);
+    void setLayers(std::vector<std::shared_ptr<const style::Layer>>, uint64_t correlationID);
     void setData(std::unique_ptr<const GeometryTileData>, uint64_t correlationID);
     void setPlacementConfig(PlacementConfig, uint64_t correlationID);
     void symbolDependenciesChanged();
 
+    // A cached layout result: the bucket itself plus the feature index
+    // entries built alongside it, because the index is rebuilt from scratch
+    // every pass.
+    struct BucketCacheEntry {
+        std::shared_ptr<Bucket> bucket;
+        std::vector<std::pair<GeometryCollection, std::size_t>> features;
+    };
+
+    // An immutable snapshot of zoom-independent layout output, passed between
+    // the workers of tiles that overzoom the same canonical tile. The buckets
+    // are shared; the feature index entries are copied by each recipient.
+    struct LayoutSeed {
+        optional<std::uint64_t> contentHash;
+        std::unordered_map<std::string, BucketCacheEntry> entries;
+    };
+
+    // Sends the buckets whose layers produce zoom-independent output to the
+    // worker of an overzoomed sibling tile, so it can skip rebuilding them.
+    void shareLayoutTo(ActorRef<GeometryTileWorker>);
+    void seedLayout(std::shared_ptr<const LayoutSeed>);
+
 private:
     void coalesce();
     void coalesced();
@@ -45,6 +69,7 @@ private:
 
     ActorRef<GeometryTileWorker> self;
     ActorRef<GeometryTile> parent;
+    Scheduler& scheduler;
 
     const OverscaledTileID id;
     GlyphAtlas& glyphAtlas;
@@ -61,12 +86,41 @@ private:
     State state = Idle;
     uint64_t correlationID = 0;
 
-    // Outer optional indicates whether we've received it or not.
-    optional<std::vector<std::unique_ptr<style::Layer>>> layers;
+    // Outer optional indicates whether we've received it or not. The layers
+    // are clones shared with every other tile of the same update pass; see
+    // Style::getLayerSnapshot().
+    optional<std::vector<std::shared_ptr<const style::Layer>>> layers;
     optional<std::unique_ptr<const GeometryTileData>> data;
     optional<PlacementConfig> placementConfig;
 
-    std::vector<std::unique_ptr<SymbolLayout>> symbolLayouts;
+    std::vector<std::shared_ptr<SymbolLayout>> symbolLayouts;
+
+    // Whether a placement result has been delivered for the current set of
+    // symbol layouts. A tile without symbol layouts produces an identical
+    // empty placement at every angle, so delivering it once is enough.
+    bool emptyPlacementDelivered = false;
+
+    // Layout results from the previous pass, keyed by style::bucketKey.
+    // A re-layout triggered by a layer change reuses the entries whose keys
+    // are unchanged instead of rebuilding them; new tile data invalidates
+    // everything.
+    std::unordered_map<std::string, BucketCacheEntry> bucketCache;
+    std::unordered_map<std::string, std::shared_ptr<SymbolLayout>> symbolLayoutCache;
+    bool dataChanged = false;
+
+    // Scratch containers reused across redoLayout() passes — cleared, not
+    // destroyed — plus the previous pass's result sizes, used to pre-size
+    // the containers that ship to the foreground. Steady-state re-layouts
+    // of the same tile then stop paying hash table and vector regrowth.
+    std::vector<std::string> symbolOrder;
+    std::unordered_map<std::string, std::shared_ptr<SymbolLayout>> symbolLayoutMap;
+    std::vector<std::string> groupLayerIDs;
+    std::size_t previousBucketCount = 0;
+    std::size_t previousFeatureIndexSize = 0;
+
+    // Seed received from a sibling's worker, applied by the next redoLayout()
+    // if the data it was built from matches ours.
+    std::shared_ptr<const LayoutSeed> layoutSeed;
 };
 
 } // namespace mbgl
@@ -8,14 +8,22 @@
 #include <mbgl/storage/response.hpp>
 #include <mbgl/storage/file_source.hpp>
 #include <mbgl/renderer/raster_bucket.hpp>
+#include <mbgl/map/transform_state.hpp>
+#include <mbgl/util/geo.hpp>
 #include <mbgl/util/run_loop.hpp>
 
+#include <array>
+#include <cmath>
+
 namespace mbgl {
 
 RasterTile::RasterTile(const OverscaledTileID& id_,
                        const style::UpdateParameters& parameters,
                        const Tileset& tileset)
     : Tile(id_),
+      transformState(parameters.transformState),
+      pixelRatio(parameters.pixelRatio),
+      encoding(tileset.encoding),
       loader(*this, id_, parameters, tileset),
       mailbox(std::make_shared<Mailbox>(*util::RunLoop::Get())),
       worker(parameters.workerScheduler,
@@ -36,11 +44,43 @@ void RasterTile::setData(std::shared_ptr<const std::string> data,
                              optional<Timestamp> expires_) {
     modified = modified_;
     expires = expires_;
-    worker.invoke(&RasterTileWorker::parse, data);
+    worker.invoke(&RasterTileWorker::parse, data, decodeSizeHint(), encoding);
+}
+
+uint32_t RasterTile::decodeSizeHint() const {
+    // Project the tile's corners to measure its current on-screen footprint.
+    // Tiles far from the camera at high pitch cover far fewer screen pixels
+    // than their native resolution, and JPEG and WebP can exploit that by
+    // decoding at reduced scale. The decoders reduce in powers of two while
+    // keeping the longer edge at or above the hint, so the worst case if the
+    // camera later moves closer is a transient 2x loss of sharpness until
+    // the tile is re-requested.
+    if (!transformState.getSize()) {
+        return 0;
+    }
+
+    const LatLngBounds bounds{ id.canonical };
+    const std::array<ScreenCoordinate, 4> corners {{
+        transformState.latLngToScreenCoordinate(bounds.northwest()),
+        transformState.latLngToScreenCoordinate(bounds.northeast()),
+        transformState.latLngToScreenCoordinate(bounds.southeast()),
+        transformState.latLngToScreenCoordinate(bounds.southwest()),
+    }};
+
+    double longestEdge = 0.0;
+    for (std::size_t i = 0; i < corners.size(); ++i) {
+        const ScreenCoordinate& a = corners[i];
+        const ScreenCoordinate& b = corners[(i + 1) % corners.size()];
+        longestEdge = std::max(longestEdge, std::hypot(b.x - a.x, b.y - a.y));
+    }
+
+    // Screen coordinates are in logical pixels.
+    return static_cast<uint32_t>(std::ceil(longestEdge * pixelRatio));
 }
 
-void RasterTile::onParsed(std::unique_ptr<Bucket> result) {
+void RasterTile::onParsed(std::unique_ptr<Bucket> result, Duration parseDuration_) {
     bucket = std::move(result);
+    parseDuration = parseDuration_;
     availableData = DataAvailability::All;
     observer->onTileChanged(*this);
 }
@@ -55,6 +95,14 @@ Bucket* RasterTile::getBucket(const style::Layer&) {
     return bucket.get();
 }
 
+std::size_t RasterTile::byteSize() const {
+    return bucket ? bucket->uploadByteSize() : 0;
+}
+
+Duration RasterTile::rebuildCost() const {
+    return parseDuration;
+}
+
 void RasterTile::setNecessity(Necessity necessity) {
     loader.setNecessity(necessity);
 }
@@ -4,10 +4,11 @@
 #include <mbgl/tile/tile_loader.hpp>
 #include <mbgl/tile/raster_tile_worker.hpp>
 #include <mbgl/actor/actor.hpp>
+#include <mbgl/util/tileset.hpp>
 
 namespace mbgl {
 
-class Tileset;
+class TransformState;
 
 namespace style {
 class Layer;
@@ -31,10 +32,24 @@ public:
     void cancel() override;
     Bucket* getBucket(const style::Layer&) override;
 
-    void onParsed(std::unique_ptr<Bucket> result);
+    std::size_t byteSize() const override;
+    Duration rebuildCost() const override;
+
+    void onParsed(std::unique_ptr<Bucket> result, Duration parseDuration);
     void onError(std::exception_ptr);
 
 private:
+    // On-screen size in device pixels of the tile's longer edge, passed to
+    // the worker as a decode-time downsampling hint; zero when the transform
+    // is not ready, which decodes at full resolution.
+    uint32_t decodeSizeHint() const;
+
+    const TransformState& transformState;
+    const float pixelRatio;
+
+    // How the worker is to interpret decoded pixels; see Tileset::Encoding.
+    const Tileset::Encoding encoding;
+
     TileLoader<RasterTile> loader;
 
     std::shared_ptr<Mailbox> mailbox;
@@ -43,6 +58,10 @@ private:
     // Contains the Bucket object for the tile. Buckets are render
     // objects and they get added by tile parsing operations.
     std::unique_ptr<Bucket> bucket;
+
+    // Worker time spent decoding the current bucket's image; see
+    // Tile::rebuildCost().
+    Duration parseDuration = Duration::zero();
 };
 
 } // namespace mbgl
@@ -1,24 +1,95 @@
 #include <mbgl/tile/raster_tile_worker.hpp>
 #include <mbgl/tile/raster_tile.hpp>
-#include <mbgl/renderer/raster_bucket.cpp>
+#include <mbgl/renderer/raster_bucket.hpp>
+#include <mbgl/gl/extension.hpp>
 #include <mbgl/actor/actor.hpp>
+#include <mbgl/util/buffer_pool.hpp>
+#include <mbgl/util/compression.hpp>
+#include <mbgl/util/etc1.hpp>
 #include <mbgl/util/premultiply.hpp>
+#include <mbgl/util/tracing.hpp>
+
+#include <algorithm>
 
 namespace mbgl {
 
+namespace {
+
+// Decode stage for terrain-RGB tiles: heights arrive packed into the color
+// channels as height = -10000 + (R * 256 * 256 + G * 256 + B) * 0.1 meters.
+// Re-encode to 16 bits as whole meters offset by 10000 (clamped), which keeps
+// every terrestrial elevation at 1m resolution in half the memory of the RGBA
+// original and spares terrain shaders the 24-bit unpack per fragment. Further
+// encodings slot in as more cases in parse() below.
+std::unique_ptr<RasterBucket> decodeTerrainRGB(const UnassociatedImage& image) {
+    RasterBucket::DEMPayload payload;
+    payload.size = image.size;
+    const std::size_t count = std::size_t(image.size.width) * image.size.height;
+    payload.data = std::make_unique<uint8_t[]>(count * 2);
+
+    const uint8_t* src = image.data.get();
+    uint8_t* dst = payload.data.get();
+    for (std::size_t i = 0; i < count; ++i) {
+        const uint32_t decimeters =
+            (uint32_t(src[0]) << 16) | (uint32_t(src[1]) << 8) | uint32_t(src[2]);
+        const uint32_t meters = std::min(decimeters / 10, 65535u);
+        dst[0] = uint8_t(meters >> 8);
+        dst[1] = uint8_t(meters & 0xff);
+        src += 4;
+        dst += 2;
+    }
+
+    return std::make_unique<RasterBucket>(std::move(payload));
+}
+
+} // namespace
+
 RasterTileWorker::RasterTileWorker(ActorRef<RasterTileWorker>, ActorRef<RasterTile> parent_)
     : parent(std::move(parent_)) {
 }
 
-void RasterTileWorker::parse(std::shared_ptr<const std::string> data) {
+void RasterTileWorker::parse(std::shared_ptr<const std::string> data, uint32_t maxSize, Tileset::Encoding encoding) {
+    MBGL_TRACE_SPAN("worker", "raster parse");
+
     if (!data) {
-        parent.invoke(&RasterTile::onParsed, nullptr); // No data; empty tile.
+        parent.invoke(&RasterTile::onParsed, nullptr, Duration::zero()); // No data; empty tile.
         return;
     }
 
+    const TimePoint start = Clock::now();
+
     try {
-        auto bucket = std::make_unique<RasterBucket>(util::unpremultiply(decodeImage(*data)));
-        parent.invoke(&RasterTile::onParsed, std::move(bucket));
+        // The offline database delivers tile payloads as stored, which may be
+        // zlib-compressed; inflate here on the worker before decoding.
+        if (util::isCompressed(*data)) {
+            auto inflated = util::BufferPool::acquire(data->size() * 4);
+            util::decompress(*data, *inflated);
+            data = std::move(inflated);
+        }
+        auto image = util::unpremultiply(decodeImage(*data, maxSize));
+
+        if (encoding == Tileset::Encoding::TerrainRGB) {
+            parent.invoke(&RasterTile::onParsed, decodeTerrainRGB(image), Clock::now() - start);
+            return;
+        }
+
+        // When the GL context takes ETC payloads, transcode eligible images
+        // (fully opaque, block-aligned — satellite imagery, in practice) here
+        // on the worker: the tile then occupies an eighth of the VRAM and the
+        // render thread uploads an eighth of the bytes. Before the first
+        // frame the capability reads as unsupported, so early tiles upload as
+        // RGBA; that's benign and resolves as the view refreshes.
+        if (gl::etcTextureSupport() != gl::ETCTextureSupport::None) {
+            if (auto compressed = util::compressETC1(image)) {
+                parent.invoke(&RasterTile::onParsed,
+                              std::make_unique<RasterBucket>(std::move(*compressed)),
+                              Clock::now() - start);
+                return;
+            }
+        }
+
+        parent.invoke(&RasterTile::onParsed, std::make_unique<RasterBucket>(std::move(image)),
+                      Clock::now() - start);
     } catch (...) {
         parent.invoke(&RasterTile::onError, std::current_exception());
     }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <mbgl/actor/actor_ref.hpp>
+#include <mbgl/util/tileset.hpp>
 
 #include <memory>
 #include <string>
@@ -13,7 +14,11 @@ class RasterTileWorker {
 public:
     RasterTileWorker(ActorRef<RasterTileWorker>, ActorRef<RasterTile>);
 
-    void parse(std::shared_ptr<const std::string> data);
+    // `maxSize` is the decode-time downsampling hint passed on to
+    // `decodeImage`; zero decodes at full resolution. `encoding` selects the
+    // decode stage that turns the decoded pixels into the bucket's texture
+    // payload.
+    void parse(std::shared_ptr<const std::string> data, uint32_t maxSize, Tileset::Encoding encoding);
 
 private:
     ActorRef<RasterTile> parent;
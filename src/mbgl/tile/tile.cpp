@@ -1,4 +1,5 @@
 #include <mbgl/tile/tile.hpp>
+#include <mbgl/tile/tile_latency.hpp>
 #include <mbgl/tile/tile_observer.hpp>
 #include <mbgl/renderer/debug_bucket.hpp>
 #include <mbgl/util/string.hpp>
@@ -22,6 +23,14 @@ void Tile::setTriedOptional() {
     observer->onTileChanged(*this);
 }
 
+void Tile::markRendered() {
+    if (latencySampled) {
+        return;
+    }
+    latencySampled = true;
+    TileLatency::record(Clock::now() - created);
+}
+
 void Tile::dumpDebugLogs() const {
     Log::Info(Event::General, "Tile::id: %s", util::toString(id).c_str());
     Log::Info(Event::General, "Tile::renderable: %s", isRenderable() ? "yes" : "no");
@@ -48,9 +48,19 @@ public:
     virtual Bucket* getBucket(const style::Layer&) = 0;
 
     virtual void setPlacementConfig(const PlacementConfig&) {}
+    // Whether the tile has yet to receive the given placement configuration.
+    // Lets the source spread re-placement across several updates instead of
+    // saturating the workers in one burst.
+    virtual bool needsPlacement(const PlacementConfig&) const { return false; }
     virtual void symbolDependenciesChanged() {};
     virtual void redoLayout() {}
 
+    // Called on a newly created tile when a tile of the same source covering
+    // the same canonical data at a different overscaled zoom is still alive.
+    // Tiles whose layout output is (partially) independent of the overscaled
+    // zoom can adopt that output instead of recomputing it.
+    virtual void inheritLayout(Tile&) {}
+
     virtual void queryRenderedFeatures(
             std::unordered_map<std::string, std::vector<Feature>>& result,
             const GeometryCoordinates& queryGeometry,
@@ -76,6 +86,20 @@ public:
         return availableData == DataAvailability::All;
     }
 
+    // Approximate number of bytes of CPU and GPU memory held by this tile's
+    // parsed contents. Used for cache accounting; zero when unknown.
+    virtual std::size_t byteSize() const { return 0; }
+
+    // Approximate worker time it took to build this tile's renderable
+    // contents, measured when they were built. Used by the cache eviction
+    // policy to prefer evicting tiles that are cheap to rebuild; zero when
+    // unknown.
+    virtual Duration rebuildCost() const { return Duration::zero(); }
+
+    // Called once per frame for every tile that was drawn; the first call
+    // records the tile's end-to-end latency sample with TileLatency.
+    void markRendered();
+
     void dumpDebugLogs() const;
 
     const OverscaledTileID id;
@@ -104,6 +128,12 @@ protected:
     DataAvailability availableData = DataAvailability::None;
 
     TileObserver* observer = nullptr;
+
+private:
+    // When this tile was created; its loader issues the resource request from
+    // the constructor, so this anchors the end-to-end latency sample.
+    const TimePoint created = Clock::now();
+    bool latencySampled = false;
 };
 
 } // namespace mbgl
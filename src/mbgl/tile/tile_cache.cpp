@@ -1,17 +1,27 @@
 #include <mbgl/tile/tile_cache.hpp>
 #include <mbgl/tile/tile.hpp>
+#include <mbgl/util/memory_budget.hpp>
 
 #include <cassert>
 
 namespace mbgl {
 
+TileCache::TileCache(size_t size_) : size(size_) {
+    memoryBudgetId = MemoryBudget::Register(
+        "TileCache",
+        [this] { return getMemoryUsage(); },
+        [this] (size_t targetBytes) { trim(targetBytes); });
+}
+
+TileCache::~TileCache() {
+    MemoryBudget::Unregister(memoryBudgetId);
+}
+
 void TileCache::setSize(size_t size_) {
     size = size_;
 
     while (orderedKeys.size() > size) {
-        auto key = orderedKeys.front();
-        orderedKeys.pop_front();
-        tiles.erase(key);
+        evictOne(false);
     }
 
     assert(orderedKeys.size() <= size);
@@ -31,9 +41,9 @@ void TileCache::add(const OverscaledTileID& key, std::unique_ptr<Tile> tile) {
     // (re-)insert tile key as newest
     orderedKeys.push_back(key);
 
-    // purge oldest key/tile if necessary
+    // purge a tile if necessary
     if (orderedKeys.size() > size) {
-        get(orderedKeys.front());
+        evictOne(false);
     }
 
     assert(orderedKeys.size() <= size);
@@ -63,4 +73,49 @@ void TileCache::clear() {
     tiles.clear();
 }
 
+size_t TileCache::getMemoryUsage() const {
+    size_t total = 0;
+    for (const auto& entry : tiles) {
+        total += entry.second->byteSize();
+    }
+    return total;
+}
+
+void TileCache::trim(size_t targetBytes) {
+    while (!orderedKeys.empty() && getMemoryUsage() > targetBytes) {
+        evictOne(true);
+    }
+}
+
+void TileCache::evictOne(bool weighByBytes) {
+    assert(!orderedKeys.empty());
+
+    auto victim = orderedKeys.begin();
+    double victimCost = 0;
+
+    size_t examined = 0;
+    for (auto it = orderedKeys.begin();
+         it != orderedKeys.end() && examined < evictionWindow; ++it, ++examined) {
+        const Tile& tile = *tiles.find(*it)->second;
+
+        // When evicting for a slot, what matters is the time to rebuild the
+        // tile if it is needed again; when evicting for memory, the time per
+        // byte freed.
+        double cost = std::chrono::duration<double>(tile.rebuildCost()).count();
+        if (weighByBytes) {
+            cost /= 1 + tile.byteSize();
+        }
+
+        if (examined == 0 || cost < victimCost) {
+            victim = it;
+            victimCost = cost;
+        }
+    }
+
+    // Copied: get() removes the key from orderedKeys, which would otherwise
+    // invalidate what the iterator points at mid-removal.
+    const OverscaledTileID key = *victim;
+    get(key);
+}
+
 } // namespace mbgl
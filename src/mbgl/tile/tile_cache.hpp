@@ -2,6 +2,7 @@
 
 #include <mbgl/tile/tile_id.hpp>
 
+#include <cstdint>
 #include <list>
 #include <memory>
 #include <map>
@@ -12,7 +13,8 @@ class Tile;
 
 class TileCache {
 public:
-    TileCache(size_t size_ = 0) : size(size_) {}
+    TileCache(size_t size_ = 0);
+    ~TileCache();
 
     void setSize(size_t);
     size_t getSize() const { return size; };
@@ -21,11 +23,29 @@ public:
     bool has(const OverscaledTileID& key);
     void clear();
 
+    // Approximate number of bytes held by the cached tiles.
+    size_t getMemoryUsage() const;
+
+    // Evicts tiles, oldest first, until the cache holds at most targetBytes.
+    void trim(size_t targetBytes);
+
 private:
+    // Evicts one tile: the cheapest to rebuild among the least recently used
+    // few, rather than strictly the oldest — a z16 tile dense with symbols
+    // takes orders of magnitude longer to restore than a low-zoom raster
+    // tile, and both occupy one slot. When freeing memory rather than a
+    // slot, the rebuild cost is weighed per byte so large-but-cheap tiles
+    // go first. The window keeps recency in charge overall: an expensive
+    // tile that stops being touched still ages out.
+    void evictOne(bool weighByBytes);
+
+    static constexpr size_t evictionWindow = 8;
+
     std::map<OverscaledTileID, std::unique_ptr<Tile>> tiles;
     std::list<OverscaledTileID> orderedKeys;
 
     size_t size;
+    uint64_t memoryBudgetId;
 };
 
 } // namespace mbgl
@@ -0,0 +1,72 @@
+#include <mbgl/tile/tile_latency.hpp>
+
+#include <array>
+#include <atomic>
+#include <cmath>
+
+namespace mbgl {
+
+namespace {
+
+// Bucket i holds samples below 2^i milliseconds; the last bucket also takes
+// everything beyond it (2^23 ms is over two hours, so in practice nothing
+// lands there for the wrong reason).
+constexpr std::size_t bucketCount = 24;
+
+std::array<std::atomic<uint64_t>, bucketCount>& buckets() {
+    static std::array<std::atomic<uint64_t>, bucketCount> counts {};
+    return counts;
+}
+
+std::size_t bucketIndex(Duration sample) {
+    const int64_t ms = std::chrono::duration_cast<Milliseconds>(sample).count();
+    std::size_t index = 0;
+    while (index + 1 < bucketCount && (int64_t(1) << index) <= ms) {
+        ++index;
+    }
+    return index;
+}
+
+} // namespace
+
+void TileLatency::record(Duration sample) {
+    ++buckets()[bucketIndex(sample)];
+}
+
+Duration TileLatency::percentile(double p) {
+    auto& counts = buckets();
+
+    uint64_t total = 0;
+    for (const auto& count : counts) {
+        total += count;
+    }
+    if (total == 0) {
+        return Duration::zero();
+    }
+
+    const uint64_t rank = uint64_t(std::ceil(p * double(total)));
+    uint64_t cumulative = 0;
+    for (std::size_t i = 0; i < bucketCount; ++i) {
+        cumulative += counts[i];
+        if (cumulative >= rank) {
+            return Milliseconds(int64_t(1) << i);
+        }
+    }
+    return Milliseconds(int64_t(1) << (bucketCount - 1));
+}
+
+std::size_t TileLatency::sampleCount() {
+    uint64_t total = 0;
+    for (const auto& count : buckets()) {
+        total += count;
+    }
+    return total;
+}
+
+void TileLatency::reset() {
+    for (auto& count : buckets()) {
+        count = 0;
+    }
+}
+
+} // namespace mbgl
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <mbgl/util/chrono.hpp>
+
+#include <cstddef>
+
+namespace mbgl {
+
+// Process-wide record of end-to-end tile latency: the time from a tile's
+// creation — its loader issues the resource request from the constructor —
+// to the first frame that drew it. Samples land in a fixed set of
+// power-of-two millisecond buckets, so percentiles are approximate (they
+// report the bucket's upper bound) but recording is an atomic increment,
+// cheap enough to leave on in production and poll from release gates.
+//
+// All entry points are thread-safe.
+class TileLatency {
+public:
+    static void record(Duration);
+
+    // Approximate percentile over every sample recorded since the last
+    // reset; p is a fraction, e.g. 0.95 for p95. Returns the upper bound of
+    // the bucket the percentile falls in, or zero with no samples.
+    static Duration percentile(double p);
+
+    static std::size_t sampleCount();
+    static void reset();
+};
+
+} // namespace mbgl
@@ -52,11 +52,29 @@ private:
     void loadedData(const Response&);
     void loadRequired();
 
+    // called when the tile becomes required while the initial cache read is still
+    // in flight. instead of waiting for the cache result before going to the
+    // network, issues the network request concurrently and renders whichever
+    // source answers first, hiding database latency behind network latency.
+    void raceRequired();
+
     T& tile;
     Necessity necessity;
     Resource resource;
     FileSource& fileSource;
     std::unique_ptr<AsyncRequest> request;
+
+    // The raced network request; see raceRequired(). Once the cache read
+    // completes, it is adopted as the long-lived required request.
+    std::unique_ptr<AsyncRequest> networkRequest;
+
+    // Set when a raced network request delivered data before the cache read
+    // finished; the cached copy is older than what the tile already has and
+    // must not overwrite it.
+    bool racedNetworkWon = false;
+
+    // Tile ID rendered once for the MBGL_TRACE_* fetch annotations.
+    const std::string traceID;
 };
 
 } // namespace mbgl
@@ -1,9 +1,11 @@
 #pragma once
 
 #include <mbgl/tile/tile_loader.hpp>
+#include <mbgl/tile/tile_parse_pressure.hpp>
 #include <mbgl/storage/file_source.hpp>
 #include <mbgl/style/update_parameters.hpp>
 #include <mbgl/util/tileset.hpp>
+#include <mbgl/util/tracing.hpp>
 
 #include <cassert>
 
@@ -23,8 +25,10 @@ TileLoader<T>::TileLoader(T& tile_,
         id.canonical.y,
         id.canonical.z,
         tileset.scheme)),
-      fileSource(parameters.fileSource) {
+      fileSource(parameters.fileSource),
+      traceID(util::toString(id)) {
     assert(!request);
+    resource.priority = parameters.tilePriority;
     if (fileSource.supportsOptionalRequests()) {
         // When supported, the first request is always optional, even if the TileLoader
         // is marked as required. That way, we can let the first optional request continue
@@ -52,12 +56,17 @@ void TileLoader<T>::loadOptional() {
     assert(!request);
 
     resource.necessity = Resource::Optional;
+    MBGL_TRACE_ASYNC_BEGIN("tile", "fetch", traceID);
     request = fileSource.request(resource, [this](Response res) {
+        MBGL_TRACE_ASYNC_END("tile", "fetch", traceID);
         request.reset();
 
         tile.setTriedOptional();
 
-        if (res.error && res.error->reason == Response::Error::Reason::NotFound) {
+        if (racedNetworkWon) {
+            // A raced network request (see raceRequired) already delivered fresher
+            // data than the cache holds; drop the cache result.
+        } else if (res.error && res.error->reason == Response::Error::Reason::NotFound) {
             // When the optional request could not be satisfied, don't treat it as an error.
             // Instead, we make sure that the next request knows that there has been an optional
             // request before by setting one of the prior* fields.
@@ -67,7 +76,14 @@ void TileLoader<T>::loadOptional() {
         }
 
         if (necessity == Necessity::Required) {
-            loadRequired();
+            if (networkRequest) {
+                // Adopt the raced network request as the long-lived required
+                // request; it keeps revalidating the resource as it expires.
+                resource.necessity = Resource::Required;
+                request = std::move(networkRequest);
+            } else {
+                loadRequired();
+            }
         }
     });
 }
@@ -76,11 +92,15 @@ template <typename T>
 void TileLoader<T>::makeRequired() {
     if (!request) {
         loadRequired();
+    } else if (!networkRequest) {
+        raceRequired();
     }
 }
 
 template <typename T>
 void TileLoader<T>::makeOptional() {
+    // Abort a raced network request; the cache read may continue.
+    networkRequest.reset();
     if (resource.necessity == Resource::Required && request) {
         // Abort a potential HTTP request.
         request.reset();
@@ -96,6 +116,14 @@ void TileLoader<T>::loadedData(const Response& res) {
         // Do not notify the tile; when we get this message, it already has the current
         // version of the data.
     } else {
+        if (necessity == Necessity::Optional && res.data && TileParsePressure::shedding()) {
+            // The workers are buried in unparsed tile data; queueing more for
+            // a tile that isn't needed for rendering right now only balloons
+            // memory. The response has already been written to the cache, so
+            // the data is one cheap read away when the tile becomes required —
+            // leave the prior* fields unset so that read actually happens.
+            return;
+        }
         resource.priorModified = res.modified;
         resource.priorExpires = res.expires;
         resource.priorEtag = res.etag;
@@ -103,12 +131,36 @@ void TileLoader<T>::loadedData(const Response& res) {
     }
 }
 
+template <typename T>
+void TileLoader<T>::raceRequired() {
+    assert(request);
+    assert(!networkRequest);
+
+    // The pending cache read runs on; whichever source answers first renders.
+    // There is no cache result to revalidate against yet, so this request goes
+    // out unconditional; setting priorExpires tells the file source not to
+    // repeat the cache lookup that is already in flight.
+    Resource networkResource = resource;
+    networkResource.necessity = Resource::Required;
+    networkResource.priorExpires = Timestamp{ Seconds::zero() };
+    networkRequest = fileSource.request(networkResource, [this](Response res) {
+        if (!res.error) {
+            racedNetworkWon = true;
+        }
+        loadedData(res);
+    });
+}
+
 template <typename T>
 void TileLoader<T>::loadRequired() {
     assert(!request);
 
     resource.necessity = Resource::Required;
-    request = fileSource.request(resource, [this](Response res) { loadedData(res); });
+    MBGL_TRACE_ASYNC_BEGIN("tile", "fetch", traceID);
+    request = fileSource.request(resource, [this](Response res) {
+        MBGL_TRACE_ASYNC_END("tile", "fetch", traceID);
+        loadedData(res);
+    });
 }
 
 } // namespace mbgl
@@ -0,0 +1,35 @@
+#include <mbgl/tile/tile_parse_pressure.hpp>
+
+namespace mbgl {
+
+namespace {
+
+// Halving from the high to the low watermark lets the workers make a real
+// dent in the backlog before optional loads resume. The absolute values are
+// sized against the ~180MB backlogs observed during stress pans on slow
+// devices: large enough that they are never reached in normal operation.
+constexpr std::size_t highWatermark = 32 * 1024 * 1024;
+constexpr std::size_t lowWatermark = 16 * 1024 * 1024;
+
+} // namespace
+
+std::atomic<std::size_t> TileParsePressure::pending { 0 };
+std::atomic<bool> TileParsePressure::shed { false };
+
+void TileParsePressure::add(std::size_t bytes) {
+    if (pending.fetch_add(bytes) + bytes >= highWatermark) {
+        shed = true;
+    }
+}
+
+void TileParsePressure::remove(std::size_t bytes) {
+    if (pending.fetch_sub(bytes) - bytes <= lowWatermark) {
+        shed = false;
+    }
+}
+
+bool TileParsePressure::shedding() {
+    return shed;
+}
+
+} // namespace mbgl
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+namespace mbgl {
+
+// Process-wide accounting of tile bytes that have been handed to worker
+// threads but not yet parsed. When the network outpaces the workers — a fast
+// connection feeding a slow device — these queued payloads are pure ballast,
+// so once the total crosses a high watermark, loads that aren't strictly
+// needed for rendering are shed until the workers drain the backlog below a
+// low watermark.
+class TileParsePressure {
+public:
+    // Called when a payload is queued for a worker (add) and when the worker
+    // has consumed it or the tile was destroyed (remove). Thread-safe.
+    static void add(std::size_t bytes);
+    static void remove(std::size_t bytes);
+
+    // Whether optional tile data should currently be dropped instead of
+    // queued for parsing. Latches on above the high watermark and off below
+    // the low watermark, so shedding doesn't flap around a single threshold.
+    static bool shedding();
+
+private:
+    static std::atomic<std::size_t> pending;
+    static std::atomic<bool> shed;
+};
+
+} // namespace mbgl
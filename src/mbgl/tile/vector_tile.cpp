@@ -1,75 +1,17 @@
 #include <mbgl/tile/vector_tile.hpp>
 #include <mbgl/tile/tile_loader_impl.hpp>
 #include <mbgl/tile/geometry_tile_data.hpp>
+#include <mbgl/util/buffer_pool.hpp>
+#include <mbgl/util/compression.hpp>
 
 #include <protozero/pbf_reader.hpp>
 
-#include <unordered_map>
 #include <unordered_map>
 #include <functional>
 #include <utility>
 
 namespace mbgl {
 
-class VectorTileLayer;
-
-using packed_iter_type = protozero::iterator_range<protozero::pbf_reader::const_uint32_iterator>;
-
-class VectorTileFeature : public GeometryTileFeature {
-public:
-    VectorTileFeature(protozero::pbf_reader, const VectorTileLayer&);
-
-    FeatureType getType() const override { return type; }
-    optional<Value> getValue(const std::string&) const override;
-    std::unordered_map<std::string,Value> getProperties() const override;
-    optional<FeatureIdentifier> getID() const override;
-    GeometryCollection getGeometries() const override;
-
-private:
-    const VectorTileLayer& layer;
-    optional<FeatureIdentifier> id;
-    FeatureType type = FeatureType::Unknown;
-    packed_iter_type tags_iter;
-    packed_iter_type geometry_iter;
-};
-
-class VectorTileLayer : public GeometryTileLayer {
-public:
-    VectorTileLayer(protozero::pbf_reader);
-
-    std::size_t featureCount() const override { return features.size(); }
-    std::unique_ptr<GeometryTileFeature> getFeature(std::size_t) const override;
-    std::string getName() const override;
-
-private:
-    friend class VectorTileData;
-    friend class VectorTileFeature;
-
-    std::string name;
-    uint32_t version = 1;
-    uint32_t extent = 4096;
-    std::unordered_map<std::string, uint32_t> keysMap;
-    std::vector<std::reference_wrapper<const std::string>> keys;
-    std::vector<Value> values;
-    std::vector<protozero::pbf_reader> features;
-};
-
-class VectorTileData : public GeometryTileData {
-public:
-    VectorTileData(std::shared_ptr<const std::string> data);
-
-    std::unique_ptr<GeometryTileData> clone() const override {
-        return std::make_unique<VectorTileData>(*this);
-    }
-
-    const GeometryTileLayer* getLayer(const std::string&) const override;
-
-private:
-    std::shared_ptr<const std::string> data;
-    mutable bool parsed = false;
-    mutable std::unordered_map<std::string, VectorTileLayer> layers;
-};
-
 VectorTile::VectorTile(const OverscaledTileID& id_,
                        std::string sourceID_,
                        const style::UpdateParameters& parameters,
@@ -140,10 +82,9 @@ VectorTileFeature::VectorTileFeature(protozero::pbf_reader feature_pbf, const Ve
     }
 }
 
-optional<Value> VectorTileFeature::getValue(const std::string& key) const {
-    auto keyIter = layer.keysMap.find(key);
-    if (keyIter == layer.keysMap.end()) {
-        return optional<Value>();
+void VectorTileFeature::decodeTags() const {
+    if (tagsDecoded) {
+        return;
     }
 
     auto start_itr = tags_iter.begin();
@@ -159,13 +100,27 @@ optional<Value> VectorTileFeature::getValue(const std::string& key) const {
             throw std::runtime_error("uneven number of feature tag ids");
         }
 
-        uint32_t tag_val = static_cast<uint32_t>(*start_itr++);;
+        uint32_t tag_val = static_cast<uint32_t>(*start_itr++);
         if (layer.values.size() <= tag_val) {
             throw std::runtime_error("feature referenced out of range value");
         }
 
-        if (tag_key == keyIter->second) {
-            return layer.values[tag_val];
+        decodedTags.emplace_back(tag_key, tag_val);
+    }
+
+    tagsDecoded = true;
+}
+
+optional<Value> VectorTileFeature::getValue(const std::string& key) const {
+    auto keyIter = layer.keysMap.find(key);
+    if (keyIter == layer.keysMap.end()) {
+        return optional<Value>();
+    }
+
+    decodeTags();
+    for (const auto& tag : decodedTags) {
+        if (tag.first == keyIter->second) {
+            return layer.values[tag.second];
         }
     }
 
@@ -173,16 +128,11 @@ optional<Value> VectorTileFeature::getValue(const std::string& key) const {
 }
 
 std::unordered_map<std::string,Value> VectorTileFeature::getProperties() const {
+    decodeTags();
     std::unordered_map<std::string,Value> properties;
-    auto start_itr = tags_iter.begin();
-    const auto & end_itr = tags_iter.end();
-    while (start_itr != end_itr) {
-        uint32_t tag_key = static_cast<uint32_t>(*start_itr++);
-        if (start_itr == end_itr) {
-            throw std::runtime_error("uneven number of feature tag ids");
-        }
-        uint32_t tag_val = static_cast<uint32_t>(*start_itr++);
-        properties[layer.keys.at(tag_key)] = layer.values.at(tag_val);
+    properties.reserve(decodedTags.size());
+    for (const auto& tag : decodedTags) {
+        properties[layer.keys.at(tag.first)] = layer.values.at(tag.second);
     }
     return properties;
 }
@@ -191,7 +141,11 @@ optional<FeatureIdentifier> VectorTileFeature::getID() const {
     return id;
 }
 
-GeometryCollection VectorTileFeature::getGeometries() const {
+const GeometryCollection& VectorTileFeature::getGeometries() const {
+    if (geometry) {
+        return *geometry;
+    }
+
     uint8_t cmd = 1;
     uint32_t length = 0;
     int32_t x = 0;
@@ -235,10 +189,12 @@ GeometryCollection VectorTileFeature::getGeometries() const {
     }
 
     if (layer.version >= 2 || type != FeatureType::Polygon) {
-        return lines;
+        geometry = std::move(lines);
+    } else {
+        geometry = fixupPolygons(lines);
     }
 
-    return fixupPolygons(lines);
+    return *geometry;
 }
 
 VectorTileData::VectorTileData(std::shared_ptr<const std::string> data_)
@@ -248,6 +204,15 @@ VectorTileData::VectorTileData(std::shared_ptr<const std::string> data_)
 const GeometryTileLayer* VectorTileData::getLayer(const std::string& name) const {
     if (!parsed) {
         parsed = true;
+        if (util::isCompressed(*data)) {
+            // Pin the content hash to the stored bytes before inflating so
+            // that bucket cache keys stay stable across clones of this tile,
+            // whether or not they have been parsed yet.
+            contentHash();
+            auto inflated = util::BufferPool::acquire(data->size() * 4);
+            util::decompress(*data, *inflated);
+            data = std::move(inflated);
+        }
         protozero::pbf_reader tile_pbf(*data);
         while (tile_pbf.next(3)) {
             VectorTileLayer layer(tile_pbf.get_message());
@@ -262,6 +227,35 @@ const GeometryTileLayer* VectorTileData::getLayer(const std::string& name) const
     return nullptr;
 }
 
+bool VectorTileData::empty() const {
+    if (parsed) {
+        for (const auto& pair : layers) {
+            if (pair.second.featureCount() > 0) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // The tile hasn't been parsed yet; peek at the undecoded layer table
+    // instead. Scanning the raw bytes for the first feature tag is cheap
+    // enough for the foreground thread, whereas inflating a compressed
+    // payload is not — answer conservatively in that case and leave the
+    // work to the background parse.
+    if (util::isCompressed(*data)) {
+        return false;
+    }
+
+    protozero::pbf_reader tile_pbf(*data);
+    while (tile_pbf.next(3)) { // layer
+        protozero::pbf_reader layer_pbf = tile_pbf.get_message();
+        if (layer_pbf.next(2)) { // feature
+            return false;
+        }
+    }
+    return true;
+}
+
 VectorTileLayer::VectorTileLayer(protozero::pbf_reader layer_pbf) {
     while (layer_pbf.next()) {
         switch (layer_pbf.tag()) {
@@ -1,8 +1,13 @@
 #pragma once
 
 #include <mbgl/tile/geometry_tile.hpp>
+#include <mbgl/tile/geometry_tile_data.hpp>
 #include <mbgl/tile/tile_loader.hpp>
 
+#include <protozero/pbf_reader.hpp>
+
+#include <unordered_map>
+
 namespace mbgl {
 
 class Tileset;
@@ -11,6 +16,96 @@ namespace style {
 class UpdateParameters;
 } // namespace style
 
+class VectorTileLayer;
+
+using packed_iter_type = protozero::iterator_range<protozero::pbf_reader::const_uint32_iterator>;
+
+class VectorTileFeature : public GeometryTileFeature {
+public:
+    VectorTileFeature(protozero::pbf_reader, const VectorTileLayer&);
+
+    FeatureType getType() const override { return type; }
+    optional<Value> getValue(const std::string&) const override;
+    std::unordered_map<std::string,Value> getProperties() const override;
+    optional<FeatureIdentifier> getID() const override;
+    const GeometryCollection& getGeometries() const override;
+
+private:
+    void decodeTags() const;
+
+    const VectorTileLayer& layer;
+    optional<FeatureIdentifier> id;
+    FeatureType type = FeatureType::Unknown;
+    packed_iter_type tags_iter;
+    packed_iter_type geometry_iter;
+
+    // Tag list decoded once on first property access: pairs of indexes into
+    // the layer's interned key and value tables. Filters and data-driven
+    // binders query the same keys repeatedly per feature; after the first
+    // access that costs an integer scan instead of re-decoding the packed
+    // varints from tags_iter.
+    mutable std::vector<std::pair<uint32_t, uint32_t>> decodedTags;
+    mutable bool tagsDecoded = false;
+
+    // Decoded lazily from geometry_iter; the pbf buffer stays alive via the
+    // owning VectorTileData, so decoding can happen whenever it's first asked for.
+    mutable optional<GeometryCollection> geometry;
+};
+
+class VectorTileLayer : public GeometryTileLayer {
+public:
+    VectorTileLayer(protozero::pbf_reader);
+
+    std::size_t featureCount() const override { return features.size(); }
+    std::unique_ptr<GeometryTileFeature> getFeature(std::size_t) const override;
+    std::string getName() const override;
+
+private:
+    friend class VectorTileData;
+    friend class VectorTileFeature;
+
+    std::string name;
+    uint32_t version = 1;
+    uint32_t extent = 4096;
+    std::unordered_map<std::string, uint32_t> keysMap;
+    std::vector<std::reference_wrapper<const std::string>> keys;
+    std::vector<Value> values;
+    std::vector<protozero::pbf_reader> features;
+};
+
+class VectorTileData : public GeometryTileData {
+public:
+    VectorTileData(std::shared_ptr<const std::string> data);
+
+    std::unique_ptr<GeometryTileData> clone() const override {
+        return std::make_unique<VectorTileData>(*this);
+    }
+
+    const GeometryTileLayer* getLayer(const std::string&) const override;
+
+    bool empty() const override;
+
+    optional<std::uint64_t> contentHash() const override {
+        if (!hash) {
+            hash = data ? std::hash<std::string>()(*data) : 0;
+        }
+        return *hash;
+    }
+
+    std::size_t payloadSize() const override {
+        return data ? data->size() : 0;
+    }
+
+private:
+    // May hold a zlib-compressed pbf as delivered by the offline database;
+    // getLayer() inflates it on first parse, so tiles retained unparsed (e.g.
+    // in the tile cache) keep only the compressed bytes resident.
+    mutable std::shared_ptr<const std::string> data;
+    mutable optional<std::uint64_t> hash;
+    mutable bool parsed = false;
+    mutable std::unordered_map<std::string, VectorTileLayer> layers;
+};
+
 class VectorTile : public GeometryTile {
 public:
     VectorTile(const OverscaledTileID&,
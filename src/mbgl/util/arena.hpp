@@ -0,0 +1,95 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace mbgl {
+namespace util {
+
+/*
+    A chunked bump allocator for scratch memory that shares a single lifetime,
+    such as the intermediate containers built up during tile layout.
+    Allocation is a pointer bump in the common case; individual deallocation
+    is a no-op, and all memory is released at once when the arena is
+    destroyed. Chunk sizes grow geometrically, so even allocation-heavy
+    clients settle into a handful of large malloc calls. Not thread-safe.
+*/
+class Arena {
+public:
+    Arena(std::size_t initialChunkSize = 16 * 1024)
+        : chunkSize(initialChunkSize) {
+    }
+
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    void* allocate(std::size_t size, std::size_t alignment = alignof(std::max_align_t)) {
+        std::size_t offset = (cursor + alignment - 1) & ~(alignment - 1);
+        if (!chunks.empty() && offset + size <= chunks.back().size) {
+            cursor = offset + size;
+            return chunks.back().data.get() + offset;
+        }
+
+        while (chunkSize < size) {
+            chunkSize *= 2;
+        }
+
+        // `new char[]` returns storage suitably aligned for any object of the
+        // requested size, so a fresh chunk needs no alignment fixup.
+        chunks.push_back(Chunk { std::unique_ptr<char[]>(new char[chunkSize]), chunkSize });
+        chunkSize *= 2;
+        cursor = size;
+        return chunks.back().data.get();
+    }
+
+private:
+    struct Chunk {
+        std::unique_ptr<char[]> data;
+        std::size_t size;
+    };
+
+    std::vector<Chunk> chunks;
+    std::size_t chunkSize;
+    std::size_t cursor = 0;
+};
+
+// Standard allocator adapter over an Arena, for use with STL containers whose
+// contents die with the arena. The referenced arena must outlive the container.
+template <class T>
+class ArenaAllocator {
+public:
+    using value_type = T;
+
+    explicit ArenaAllocator(Arena& arena_)
+        : arena(&arena_) {
+    }
+
+    template <class U>
+    ArenaAllocator(const ArenaAllocator<U>& other)
+        : arena(other.arena) {
+    }
+
+    T* allocate(std::size_t n) {
+        return static_cast<T*>(arena->allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T*, std::size_t) {
+        // Reclaimed wholesale when the arena is destroyed.
+    }
+
+    Arena* arena;
+};
+
+template <class T, class U>
+bool operator==(const ArenaAllocator<T>& lhs, const ArenaAllocator<U>& rhs) {
+    return lhs.arena == rhs.arena;
+}
+
+template <class T, class U>
+bool operator!=(const ArenaAllocator<T>& lhs, const ArenaAllocator<U>& rhs) {
+    return lhs.arena != rhs.arena;
+}
+
+} // namespace util
+} // namespace mbgl
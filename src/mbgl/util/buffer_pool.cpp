@@ -0,0 +1,122 @@
+#include <mbgl/util/buffer_pool.hpp>
+
+#include <algorithm>
+#include <mutex>
+#include <vector>
+
+namespace mbgl {
+namespace util {
+
+const std::size_t BufferPool::minimumClassSize;
+const std::size_t BufferPool::maximumClassSize;
+const std::size_t BufferPool::maximumRetainedBytes;
+
+namespace {
+
+std::mutex mtx;
+std::size_t retained = 0;
+
+// One free list per power-of-two class between minimumClassSize and
+// maximumClassSize, most recently released first.
+std::vector<std::vector<std::unique_ptr<std::string>>>& freeLists() {
+    static std::vector<std::vector<std::unique_ptr<std::string>>> lists = [] {
+        std::size_t classes = 0;
+        for (std::size_t size = BufferPool::minimumClassSize;
+             size <= BufferPool::maximumClassSize; size *= 2) {
+            classes++;
+        }
+        return std::vector<std::vector<std::unique_ptr<std::string>>>(classes);
+    }();
+    return lists;
+}
+
+// Index of the smallest class that guarantees at least `size` bytes. Every
+// buffer parked in class i has at least that class's capacity, so acquire()
+// may serve a request from this class or any larger one.
+std::size_t ceilingClassIndex(std::size_t size) {
+    std::size_t index = 0;
+    for (std::size_t classSize = BufferPool::minimumClassSize; classSize < size; classSize *= 2) {
+        index++;
+    }
+    return index;
+}
+
+// Index of the largest class a buffer of `capacity` bytes can back: released
+// buffers park one class down so the guarantee above holds.
+std::size_t floorClassIndex(std::size_t capacity) {
+    std::size_t index = 0;
+    for (std::size_t classSize = BufferPool::minimumClassSize; classSize * 2 <= capacity; classSize *= 2) {
+        index++;
+    }
+    return index;
+}
+
+void release(std::string* body) {
+    std::unique_ptr<std::string> buffer(body);
+
+    // A buffer parks under the class its capacity satisfies, which may be
+    // larger than the class it was acquired for if appends grew it.
+    const std::size_t capacity = buffer->capacity();
+    if (capacity < BufferPool::minimumClassSize || capacity > BufferPool::maximumClassSize) {
+        return; // Outside the pooled range; freed normally.
+    }
+
+    std::lock_guard<std::mutex> lock(mtx);
+    if (retained + capacity > BufferPool::maximumRetainedBytes) {
+        return; // The pool is full; freed normally.
+    }
+
+    buffer->clear();
+    retained += capacity;
+    freeLists()[floorClassIndex(capacity)].push_back(std::move(buffer));
+}
+
+} // namespace
+
+std::shared_ptr<std::string> BufferPool::acquire(std::size_t sizeHint) {
+    const std::size_t index = ceilingClassIndex(std::max(sizeHint, minimumClassSize));
+
+    std::unique_ptr<std::string> buffer;
+
+    if (sizeHint <= maximumClassSize) {
+        std::lock_guard<std::mutex> lock(mtx);
+        // Exact class first, then any larger one: a roomier buffer only
+        // wastes slack, while a smaller one would reallocate on append.
+        auto& lists = freeLists();
+        for (std::size_t i = index; i < lists.size(); i++) {
+            if (!lists[i].empty()) {
+                buffer = std::move(lists[i].back());
+                lists[i].pop_back();
+                retained -= buffer->capacity();
+                break;
+            }
+        }
+    }
+
+    if (!buffer) {
+        buffer = std::make_unique<std::string>();
+        buffer->reserve(std::max(sizeHint, minimumClassSize));
+    }
+
+    return { buffer.release(), release };
+}
+
+std::shared_ptr<std::string> BufferPool::adopt(std::string&& body) {
+    return { new std::string(std::move(body)), release };
+}
+
+std::size_t BufferPool::retainedBytes() {
+    std::lock_guard<std::mutex> lock(mtx);
+    return retained;
+}
+
+void BufferPool::clear() {
+    std::lock_guard<std::mutex> lock(mtx);
+    for (auto& list : freeLists()) {
+        list.clear();
+    }
+    retained = 0;
+}
+
+} // namespace util
+} // namespace mbgl
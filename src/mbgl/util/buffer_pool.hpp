@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+namespace mbgl {
+namespace util {
+
+// Process-wide recycler for response body buffers.
+//
+// Tile and asset payloads arrive as std::string bodies averaging tens of
+// kilobytes and live only until a worker has parsed them. Allocating each one
+// fresh churns the allocator thousands of times a minute and fragments the
+// heap over long sessions. The pool parks retired buffers on bounded
+// free lists in power-of-two size classes and hands them back out: acquire()
+// returns an empty string whose shared_ptr deleter recycles the buffer once
+// the last reader drops it. Bodies flow untouched from the network or
+// database thread through Response::data into VectorTile::setData and the
+// workers; recycling happens on whichever thread releases the final
+// reference, so every method is thread-safe.
+class BufferPool {
+public:
+    // Smallest pooled class; acquire() requests below it are rounded up.
+    static const std::size_t minimumClassSize = 4096;
+    // Largest pooled class; bigger buffers are freed normally on release.
+    static const std::size_t maximumClassSize = 1024 * 1024;
+    // Cap on bytes parked across all free lists; overflow is freed.
+    static const std::size_t maximumRetainedBytes = 8 * 1024 * 1024;
+
+    // An empty string with capacity for at least sizeHint bytes, backed by a
+    // recycled buffer when one of a suitable class is parked. The buffer
+    // returns to the pool when the last shared_ptr reference is dropped.
+    static std::shared_ptr<std::string> acquire(std::size_t sizeHint);
+
+    // Wraps an already-filled buffer -- e.g. a blob SQLite handed us -- so
+    // that its capacity is recycled on release like an acquired one.
+    static std::shared_ptr<std::string> adopt(std::string&& body);
+
+    // Bytes currently parked on the free lists.
+    static std::size_t retainedBytes();
+
+    // Frees every parked buffer.
+    static void clear();
+};
+
+} // namespace util
+} // namespace mbgl
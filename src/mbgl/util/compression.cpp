@@ -2,6 +2,7 @@
 
 #include <zlib.h>
 
+#include <cstdint>
 #include <cstdio>
 #include <cstring>
 #include <stdexcept>
@@ -58,6 +59,12 @@ std::string compress(const std::string &raw) {
 }
 
 std::string decompress(const std::string &raw) {
+    std::string result;
+    decompress(raw, result);
+    return result;
+}
+
+void decompress(const std::string &raw, std::string &result) {
     z_stream inflate_stream;
     memset(&inflate_stream, 0, sizeof(inflate_stream));
 
@@ -69,7 +76,7 @@ std::string decompress(const std::string &raw) {
     inflate_stream.next_in = (Bytef *)raw.data();
     inflate_stream.avail_in = uInt(raw.size());
 
-    std::string result;
+    const size_t offset = result.size();
     char out[15384];
 
     int code;
@@ -78,8 +85,8 @@ std::string decompress(const std::string &raw) {
         inflate_stream.avail_out = sizeof(out);
         code = inflate(&inflate_stream, 0);
         // result.append(out, sizeof(out) - inflate_stream.avail_out);
-        if (result.size() < inflate_stream.total_out) {
-            result.append(out, inflate_stream.total_out - result.size());
+        if (result.size() - offset < inflate_stream.total_out) {
+            result.append(out, inflate_stream.total_out - (result.size() - offset));
         }
     } while (code == Z_OK);
 
@@ -88,8 +95,19 @@ std::string decompress(const std::string &raw) {
     if (code != Z_STREAM_END) {
         throw std::runtime_error(inflate_stream.msg ? inflate_stream.msg : "decompression error");
     }
+}
 
-    return result;
+bool isCompressed(const std::string &raw) {
+    if (raw.size() < 2) {
+        return false;
+    }
+
+    const uint8_t cmf = static_cast<uint8_t>(raw[0]);
+    const uint8_t flg = static_cast<uint8_t>(raw[1]);
+
+    return (cmf & 0x0f) == Z_DEFLATED    // compression method
+        && (cmf >> 4) <= 7               // window size within spec
+        && ((cmf << 8) | flg) % 31 == 0; // header checksum
 }
 } // namespace util
 } // namespace mbgl
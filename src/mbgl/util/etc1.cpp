@@ -0,0 +1,253 @@
+#include <mbgl/util/etc1.hpp>
+
+#include <array>
+#include <cassert>
+#include <limits>
+
+namespace mbgl {
+namespace util {
+
+namespace {
+
+// Modifier magnitude pairs from table 3.17.2 of the
+// OES_compressed_ETC1_RGB8_texture specification. The 3-bit codeword of each
+// subblock selects a row; the 2-bit index of each pixel selects the sign (high
+// bit) and magnitude (low bit) added to the subblock's base color.
+constexpr int32_t modifierTables[8][2] = {
+    { 2, 8 },   { 5, 17 },  { 9, 29 },  { 13, 42 },
+    { 18, 60 }, { 24, 80 }, { 33, 106 }, { 47, 183 },
+};
+
+struct RGB {
+    int32_t r;
+    int32_t g;
+    int32_t b;
+};
+
+uint8_t clampByte(int32_t v) {
+    return static_cast<uint8_t>(v < 0 ? 0 : v > 255 ? 255 : v);
+}
+
+// Extends a quantized 4- or 5-bit channel back to 8 bits by bit replication.
+int32_t extend4(int32_t c) {
+    return (c << 4) | c;
+}
+
+int32_t extend5(int32_t c) {
+    return (c << 3) | (c >> 2);
+}
+
+int32_t quantize4(int32_t c) {
+    return (c * 15 + 127) / 255;
+}
+
+int32_t quantize5(int32_t c) {
+    return (c * 31 + 127) / 255;
+}
+
+// Chosen table codeword and per-pixel modifier selectors for one 2x4 subblock.
+struct SubblockCode {
+    uint32_t table = 0;
+    std::array<uint8_t, 8> selectors {{}};
+};
+
+// Exhaustively picks the modifier table and per-pixel selectors minimizing
+// squared RGB error against the subblock's extended base color. Eight tables
+// by eight pixels by four candidates keeps this cheap enough for tile workers.
+SubblockCode encodeSubblock(const RGB& base, const RGB* pixels) {
+    SubblockCode best;
+    int64_t bestError = std::numeric_limits<int64_t>::max();
+    for (uint32_t table = 0; table < 8; ++table) {
+        const int32_t small = modifierTables[table][0];
+        const int32_t large = modifierTables[table][1];
+        // Candidate order matches the pixel index encoding: high bit sign,
+        // low bit magnitude.
+        const int32_t candidates[4] = { small, large, -small, -large };
+        SubblockCode code;
+        code.table = table;
+        int64_t error = 0;
+        for (size_t p = 0; p < 8; ++p) {
+            int64_t bestPixelError = std::numeric_limits<int64_t>::max();
+            for (uint8_t c = 0; c < 4; ++c) {
+                const int64_t dr = clampByte(base.r + candidates[c]) - pixels[p].r;
+                const int64_t dg = clampByte(base.g + candidates[c]) - pixels[p].g;
+                const int64_t db = clampByte(base.b + candidates[c]) - pixels[p].b;
+                const int64_t pixelError = dr * dr + dg * dg + db * db;
+                if (pixelError < bestPixelError) {
+                    bestPixelError = pixelError;
+                    code.selectors[p] = c;
+                }
+            }
+            error += bestPixelError;
+        }
+        if (error < bestError) {
+            bestError = error;
+            best = code;
+        }
+    }
+    return best;
+}
+
+void encodeBlock(const uint8_t* rgba, const size_t stride, uint8_t* out) {
+    // Texel order matches the pixel index bit layout: index = 4 * x + y, so
+    // the first eight entries form the left 2x4 subblock.
+    RGB pixels[16];
+    for (size_t x = 0; x < 4; ++x) {
+        for (size_t y = 0; y < 4; ++y) {
+            const uint8_t* p = rgba + y * stride + x * 4;
+            pixels[x * 4 + y] = { p[0], p[1], p[2] };
+        }
+    }
+
+    // Always encode with flip == 0, i.e. subblocks are the left and right
+    // halves. Trying both orientations buys little on photographic tiles and
+    // doubles the search.
+    RGB average[2];
+    for (size_t sub = 0; sub < 2; ++sub) {
+        RGB sum = {};
+        for (size_t p = 0; p < 8; ++p) {
+            sum.r += pixels[sub * 8 + p].r;
+            sum.g += pixels[sub * 8 + p].g;
+            sum.b += pixels[sub * 8 + p].b;
+        }
+        average[sub] = { (sum.r + 4) / 8, (sum.g + 4) / 8, (sum.b + 4) / 8 };
+    }
+
+    // Differential mode carries RGB555 plus a 3-bit per-channel delta and is
+    // preferred for its extra base color precision; fall back to the
+    // individual RGB444 mode when the subblock averages are too far apart.
+    RGB base[2];
+    const int32_t dr = quantize5(average[1].r) - quantize5(average[0].r);
+    const int32_t dg = quantize5(average[1].g) - quantize5(average[0].g);
+    const int32_t db = quantize5(average[1].b) - quantize5(average[0].b);
+    const bool differential =
+        dr >= -4 && dr <= 3 && dg >= -4 && dg <= 3 && db >= -4 && db <= 3;
+    if (differential) {
+        const RGB q = { quantize5(average[0].r), quantize5(average[0].g), quantize5(average[0].b) };
+        base[0] = { extend5(q.r), extend5(q.g), extend5(q.b) };
+        base[1] = { extend5(q.r + dr), extend5(q.g + dg), extend5(q.b + db) };
+        out[0] = static_cast<uint8_t>((q.r << 3) | (dr & 0x07));
+        out[1] = static_cast<uint8_t>((q.g << 3) | (dg & 0x07));
+        out[2] = static_cast<uint8_t>((q.b << 3) | (db & 0x07));
+    } else {
+        const RGB q0 = { quantize4(average[0].r), quantize4(average[0].g), quantize4(average[0].b) };
+        const RGB q1 = { quantize4(average[1].r), quantize4(average[1].g), quantize4(average[1].b) };
+        base[0] = { extend4(q0.r), extend4(q0.g), extend4(q0.b) };
+        base[1] = { extend4(q1.r), extend4(q1.g), extend4(q1.b) };
+        out[0] = static_cast<uint8_t>((q0.r << 4) | q1.r);
+        out[1] = static_cast<uint8_t>((q0.g << 4) | q1.g);
+        out[2] = static_cast<uint8_t>((q0.b << 4) | q1.b);
+    }
+
+    const SubblockCode code[2] = {
+        encodeSubblock(base[0], pixels),
+        encodeSubblock(base[1], pixels + 8),
+    };
+    out[3] = static_cast<uint8_t>((code[0].table << 5) | (code[1].table << 2) |
+                                  (differential ? 0x02 : 0x00));
+
+    // Pixel indices: bits 31..16 of the block's low word hold the high bits,
+    // bits 15..0 the low bits, one bit per texel, stored big-endian.
+    uint32_t msbBits = 0;
+    uint32_t lsbBits = 0;
+    for (size_t i = 0; i < 16; ++i) {
+        const uint8_t selector = code[i / 8].selectors[i % 8];
+        msbBits |= static_cast<uint32_t>(selector >> 1) << i;
+        lsbBits |= static_cast<uint32_t>(selector & 1) << i;
+    }
+    out[4] = static_cast<uint8_t>(msbBits >> 8);
+    out[5] = static_cast<uint8_t>(msbBits & 0xFF);
+    out[6] = static_cast<uint8_t>(lsbBits >> 8);
+    out[7] = static_cast<uint8_t>(lsbBits & 0xFF);
+}
+
+void decodeBlock(const uint8_t* block, uint8_t* rgba, const size_t stride) {
+    const bool differential = (block[3] & 0x02) != 0;
+    const bool flip = (block[3] & 0x01) != 0;
+    const uint32_t tables[2] = { static_cast<uint32_t>(block[3] >> 5),
+                                 static_cast<uint32_t>((block[3] >> 2) & 0x07) };
+
+    RGB base[2];
+    if (differential) {
+        const auto channel = [](uint8_t byte, int32_t& b0, int32_t& b1) {
+            const int32_t q = byte >> 3;
+            int32_t delta = byte & 0x07;
+            if (delta >= 4) {
+                delta -= 8;
+            }
+            b0 = extend5(q);
+            b1 = extend5(q + delta);
+        };
+        channel(block[0], base[0].r, base[1].r);
+        channel(block[1], base[0].g, base[1].g);
+        channel(block[2], base[0].b, base[1].b);
+    } else {
+        base[0] = { extend4(block[0] >> 4), extend4(block[1] >> 4), extend4(block[2] >> 4) };
+        base[1] = { extend4(block[0] & 0x0F), extend4(block[1] & 0x0F), extend4(block[2] & 0x0F) };
+    }
+
+    const uint32_t msbBits = (static_cast<uint32_t>(block[4]) << 8) | block[5];
+    const uint32_t lsbBits = (static_cast<uint32_t>(block[6]) << 8) | block[7];
+    for (size_t i = 0; i < 16; ++i) {
+        const size_t x = i / 4;
+        const size_t y = i % 4;
+        const size_t sub = (flip ? y : x) >= 2 ? 1 : 0;
+        const uint32_t selector = (((msbBits >> i) & 1) << 1) | ((lsbBits >> i) & 1);
+        const int32_t magnitude = modifierTables[tables[sub]][selector & 1];
+        const int32_t modifier = (selector & 0x02) ? -magnitude : magnitude;
+        uint8_t* p = rgba + y * stride + x * 4;
+        p[0] = clampByte(base[sub].r + modifier);
+        p[1] = clampByte(base[sub].g + modifier);
+        p[2] = clampByte(base[sub].b + modifier);
+        p[3] = 0xFF;
+    }
+}
+
+} // namespace
+
+optional<ETC1Image> compressETC1(const UnassociatedImage& image) {
+    if (!image.valid() || image.size.width % 4 != 0 || image.size.height % 4 != 0) {
+        return {};
+    }
+
+    // ETC1 carries no alpha channel, so compressing anything but a fully
+    // opaque image — satellite imagery decoded from JPEG, typically — would
+    // drop its transparency.
+    const uint8_t* data = image.data.get();
+    for (size_t i = 3; i < image.bytes(); i += 4) {
+        if (data[i] != 0xFF) {
+            return {};
+        }
+    }
+
+    ETC1Image compressed;
+    compressed.size = image.size;
+    compressed.blocks.resize(
+        static_cast<size_t>(image.size.width / 4) * (image.size.height / 4) * 8);
+    uint8_t* out = compressed.blocks.data();
+    for (uint32_t by = 0; by < image.size.height; by += 4) {
+        for (uint32_t bx = 0; bx < image.size.width; bx += 4) {
+            encodeBlock(data + by * image.stride() + bx * 4, image.stride(), out);
+            out += 8;
+        }
+    }
+    return optional<ETC1Image>(std::move(compressed));
+}
+
+UnassociatedImage decompressETC1(const ETC1Image& compressed) {
+    assert(compressed.size.width % 4 == 0 && compressed.size.height % 4 == 0);
+    assert(compressed.blocks.size() ==
+           static_cast<size_t>(compressed.size.width / 4) * (compressed.size.height / 4) * 8);
+    UnassociatedImage image(compressed.size);
+    const uint8_t* block = compressed.blocks.data();
+    for (uint32_t by = 0; by < compressed.size.height; by += 4) {
+        for (uint32_t bx = 0; bx < compressed.size.width; bx += 4) {
+            decodeBlock(block, image.data.get() + by * image.stride() + bx * 4, image.stride());
+            block += 8;
+        }
+    }
+    return image;
+}
+
+} // namespace util
+} // namespace mbgl
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <mbgl/util/image.hpp>
+#include <mbgl/util/optional.hpp>
+
+#include <vector>
+
+namespace mbgl {
+namespace util {
+
+// An ETC1-compressed RGB image: one 8-byte block per 4x4 pixel group, blocks
+// in row-major order. ETC1 bitstreams are also valid ETC2 RGB8 payloads, so
+// contexts supporting either format can take them verbatim.
+class ETC1Image {
+public:
+    Size size;
+    std::vector<uint8_t> blocks;
+};
+
+// Compresses an image to ETC1 at a fixed 8:1 ratio over RGBA. Returns nullopt
+// when the image is unsuitable: ETC1 has no alpha channel, so any non-opaque
+// pixel disqualifies it, as do dimensions that are not multiples of the 4x4
+// block size.
+optional<ETC1Image> compressETC1(const UnassociatedImage&);
+
+// Decodes an ETC1 image back to RGBA with opaque alpha.
+UnassociatedImage decompressETC1(const ETC1Image&);
+
+} // namespace util
+} // namespace mbgl
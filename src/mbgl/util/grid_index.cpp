@@ -2,7 +2,8 @@
 #include <mbgl/geometry/feature_index.hpp>
 #include <mbgl/math/minmax.hpp>
 
-#include <unordered_set>
+#include <algorithm>
+#include <cmath>
 
 namespace mbgl {
 
@@ -17,33 +18,88 @@ GridIndex<T>::GridIndex(int32_t extent_, int32_t n_, int32_t padding_) :
     min(-double(padding) / n * extent),
     max(extent + double(padding) / n * extent)
     {
-        cells.resize(d * d);
+        cellOffsets.resize(d * d + 1, 0);
     }
 
 template <class T>
 void GridIndex<T>::insert(T&& t, const BBox& bbox) {
-    size_t uid = elements.size();
-
-    auto cx1 = convertToCellCoord(bbox.min.x);
-    auto cy1 = convertToCellCoord(bbox.min.y);
-    auto cx2 = convertToCellCoord(bbox.max.x);
-    auto cy2 = convertToCellCoord(bbox.max.y);
+    elements.emplace_back(std::move(t), bbox);
+    dirty = true;
+}
 
-    int32_t x, y, cellIndex;
-    for (x = cx1; x <= cx2; ++x) {
-        for (y = cy1; y <= cy2; ++y) {
-            cellIndex = d * y + x;
-            cells[cellIndex].push_back(uid);
+template <class T>
+void GridIndex<T>::build() {
+    // Counting sort of element ids into cells: one pass to count how many
+    // elements cover each cell, a prefix sum to turn counts into offsets, and
+    // one pass to place the ids.
+    std::fill(cellOffsets.begin(), cellOffsets.end(), 0);
+
+    auto eachCoveredCell = [&] (const BBox& bbox, auto&& fn) {
+        auto cx1 = convertToCellCoord(bbox.min.x);
+        auto cy1 = convertToCellCoord(bbox.min.y);
+        auto cx2 = convertToCellCoord(bbox.max.x);
+        auto cy2 = convertToCellCoord(bbox.max.y);
+
+        for (auto x = cx1; x <= cx2; ++x) {
+            for (auto y = cy1; y <= cy2; ++y) {
+                fn(d * y + x);
+            }
         }
+    };
+
+    // Counts accumulate one slot ahead so that the prefix sum leaves
+    // cellOffsets[c] holding the start of cell c.
+    for (auto& element : elements) {
+        eachCoveredCell(element.second, [&] (int32_t cellIndex) {
+            ++cellOffsets[cellIndex + 1];
+        });
+    }
+
+    for (std::size_t i = 1; i < cellOffsets.size(); ++i) {
+        cellOffsets[i] += cellOffsets[i - 1];
+    }
+
+    cellElements.resize(cellOffsets.back());
+
+    std::vector<size_t> cursors(cellOffsets.begin(), cellOffsets.end() - 1);
+    for (size_t uid = 0; uid < elements.size(); ++uid) {
+        eachCoveredCell(elements[uid].second, [&] (int32_t cellIndex) {
+            cellElements[cursors[cellIndex]++] = uid;
+        });
     }
 
-    elements.emplace_back(t, bbox);
+    lastQuery.assign(elements.size(), 0);
+    queryGeneration = 0;
+    dirty = false;
 }
 
 template <class T>
-std::vector<T> GridIndex<T>::query(const BBox& queryBBox) const {
+std::vector<T> GridIndex<T>::query(const BBox& queryBBox) {
     std::vector<T> result;
-    std::unordered_set<size_t> seenUids;
+    query(queryBBox, result);
+    return result;
+}
+
+template <class T>
+void GridIndex<T>::query(const BBox& queryBBox, std::vector<T>& result) {
+    query(queryBBox, [&] (const T& t, const BBox&) -> bool {
+        result.push_back(t);
+        return false;
+    });
+}
+
+template <class T>
+void GridIndex<T>::query(const BBox& queryBBox, std::function<bool (const T&, const BBox&)> fn) {
+    if (dirty) {
+        build();
+    }
+
+    // A fresh generation invalidates all stamps at once; on the (unlikely)
+    // wrap back to zero, every stamp is reset explicitly.
+    if (++queryGeneration == 0) {
+        std::fill(lastQuery.begin(), lastQuery.end(), 0);
+        queryGeneration = 1;
+    }
 
     auto cx1 = convertToCellCoord(queryBBox.min.x);
     auto cy1 = convertToCellCoord(queryBBox.min.y);
@@ -54,25 +110,26 @@ std::vector<T> GridIndex<T>::query(const BBox& queryBBox) const {
     for (x = cx1; x <= cx2; ++x) {
         for (y = cy1; y <= cy2; ++y) {
             cellIndex = d * y + x;
-            for (auto uid : cells[cellIndex]) {
-                if (seenUids.count(uid) == 0) {
-                    seenUids.insert(uid);
+            for (size_t i = cellOffsets[cellIndex]; i < cellOffsets[cellIndex + 1]; ++i) {
+                auto uid = cellElements[i];
+                if (lastQuery[uid] != queryGeneration) {
+                    lastQuery[uid] = queryGeneration;
 
-                    auto& pair = elements.at(uid);
+                    auto& pair = elements[uid];
                     auto& bbox = pair.second;
                     if (queryBBox.min.x <= bbox.max.x &&
                         queryBBox.min.y <= bbox.max.y &&
                         queryBBox.max.x >= bbox.min.x &&
                         queryBBox.max.y >= bbox.min.y) {
 
-                        result.push_back(pair.first);
+                        if (fn(pair.first, bbox)) {
+                            return;
+                        }
                     }
                 }
             }
         }
     }
-
-    return result;
 }
 
 
@@ -5,10 +5,23 @@
 
 #include <cstdint>
 #include <cstddef>
+#include <functional>
 #include <vector>
 
 namespace mbgl {
 
+/*
+    A uniform grid over a tile's coordinate space for broad-phase box
+    intersection queries. Elements are bulk-loaded with insert(); the first
+    query after a batch of inserts freezes them into a flat CSR-style layout
+    (one contiguous element-id array plus per-cell offsets), so queries walk
+    contiguous memory instead of chasing one heap-allocated vector per cell.
+    Elements spanning several cells are deduplicated with a per-element
+    generation stamp rather than a per-query hash set, which makes a query
+    allocation-free once the stamp array has grown to the element count.
+    Queries bump the generation stamp, so the index is not safe for
+    concurrent use.
+*/
 template <class T>
 class GridIndex {
 public:
@@ -17,9 +30,23 @@ public:
     using BBox = mapbox::geometry::box<int16_t>;
 
     void insert(T&& t, const BBox&);
-    std::vector<T> query(const BBox&) const;
+    std::vector<T> query(const BBox&);
+
+    // Appends matches to a caller-provided buffer, so callers querying in a
+    // loop can reuse one buffer's capacity across queries.
+    void query(const BBox&, std::vector<T>& result);
+
+    // Visits every element whose bounding box intersects the query box,
+    // without materializing a result vector. Returning true from the callback
+    // terminates the query early, so callers that only need the first hit (or
+    // that can prove no further hit matters) pay for only the cells visited so
+    // far.
+    void query(const BBox&, std::function<bool (const T&, const BBox&)>);
 
 private:
+    // Rebuilds the CSR cell arrays from the element list.
+    void build();
+
     int32_t convertToCellCoord(int32_t x) const;
 
     const int32_t extent;
@@ -31,8 +58,18 @@ private:
     const int32_t max;
 
     std::vector<std::pair<T, BBox>> elements;
-    std::vector<std::vector<size_t>> cells;
 
+    // CSR cell storage: element ids of cell c are
+    // cellElements[cellOffsets[c] .. cellOffsets[c + 1]). Rebuilt by build()
+    // whenever elements were inserted since the last query.
+    std::vector<size_t> cellOffsets;
+    std::vector<size_t> cellElements;
+    bool dirty = true;
+
+    // Generation stamps for query-time deduplication of elements that span
+    // multiple cells.
+    std::vector<uint32_t> lastQuery;
+    uint32_t queryGeneration = 0;
 };
 
 } // namespace mbgl
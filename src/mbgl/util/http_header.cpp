@@ -1,27 +1,119 @@
 #include <mbgl/util/http_header.hpp>
 
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wunknown-pragmas"
-#pragma GCC diagnostic ignored "-Wunused-parameter"
-#pragma GCC diagnostic ignored "-Wshadow"
-#include <boost/spirit/include/qi.hpp>
-#include <boost/spirit/include/phoenix_core.hpp>
-#include <boost/spirit/include/phoenix_operator.hpp>
-#pragma GCC diagnostic pop
+#include <cctype>
+#include <limits>
 
 namespace mbgl {
 namespace http {
 
-CacheControl CacheControl::parse(const std::string& value) {
-    namespace qi = boost::spirit::qi;
-    namespace phoenix = boost::phoenix;
+namespace {
+
+inline void skipSpace(const char*& p, const char* end) {
+    while (p != end && std::isspace(static_cast<unsigned char>(*p))) {
+        ++p;
+    }
+}
+
+// Advances past a double-quoted string (with backslash escapes), starting at
+// the opening quote. Returns false if the string never closes, in which case
+// the rest of the header is unparseable.
+inline bool skipQuotedString(const char*& p, const char* end) {
+    ++p; // opening quote
+    while (p != end) {
+        if (*p == '\\') {
+            if (++p == end) {
+                return false;
+            }
+            ++p;
+        } else if (*p == '"') {
+            ++p;
+            return true;
+        } else {
+            ++p;
+        }
+    }
+    return false;
+}
+
+inline bool consumeLiteral(const char*& p, const char* end, const char* literal) {
+    const char* q = p;
+    while (*literal) {
+        if (q == end || *q != *literal) {
+            return false;
+        }
+        ++q;
+        ++literal;
+    }
+    p = q;
+    return true;
+}
+
+} // namespace
 
+// Hand-rolled parser for the Cache-Control grammar: a comma-separated list of
+// directives whose values may be quoted strings containing commas. It runs on
+// the file source thread for every network response, so it avoids spinning up
+// grammar machinery per call. Directives other than max-age and
+// must-revalidate are skipped over; an unterminated quoted string ends the
+// parse, matching the grammar it replaces.
+CacheControl CacheControl::parse(const std::string& value) {
     CacheControl result;
-    qi::phrase_parse(value.begin(), value.end(), (
-        (qi::lit("must-revalidate") [ phoenix::ref(result.mustRevalidate) = true ]) |
-        (qi::lit("max-age") >> '=' >> qi::ulong_long [ phoenix::ref(result.maxAge) = qi::_1 ]) |
-        (*(('"' >> *(('\\' >> qi::char_) | (qi::char_ - '"')) >> '"') | (qi::char_ - '"' - ',')))
-    ) % ',', qi::ascii::space);
+
+    const char* p = value.data();
+    const char* end = p + value.size();
+
+    while (p != end) {
+        skipSpace(p, end);
+        const char* elementStart = p;
+
+        bool recognized = false;
+        if (consumeLiteral(p, end, "must-revalidate")) {
+            result.mustRevalidate = true;
+            recognized = true;
+        } else if (consumeLiteral(p, end, "max-age")) {
+            skipSpace(p, end);
+            if (p != end && *p == '=') {
+                ++p;
+                skipSpace(p, end);
+                if (p != end && std::isdigit(static_cast<unsigned char>(*p))) {
+                    uint64_t age = 0;
+                    bool overflow = false;
+                    while (p != end && std::isdigit(static_cast<unsigned char>(*p))) {
+                        if (age > (std::numeric_limits<uint64_t>::max() - (*p - '0')) / 10) {
+                            overflow = true;
+                        }
+                        age = age * 10 + (*p - '0');
+                        ++p;
+                    }
+                    if (!overflow) {
+                        result.maxAge = age;
+                        recognized = true;
+                    }
+                }
+            }
+        }
+
+        if (!recognized) {
+            p = elementStart;
+        }
+
+        // Skip the remainder of the element, honoring quoted strings so an
+        // embedded comma doesn't end the directive early.
+        while (p != end && *p != ',') {
+            if (*p == '"') {
+                if (!skipQuotedString(p, end)) {
+                    return result;
+                }
+            } else {
+                ++p;
+            }
+        }
+
+        if (p != end) {
+            ++p; // comma
+        }
+    }
+
     return result;
 }
 
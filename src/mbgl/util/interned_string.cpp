@@ -0,0 +1,49 @@
+#include <mbgl/util/interned_string.hpp>
+
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+
+namespace mbgl {
+namespace util {
+
+namespace {
+
+struct InternTable {
+    std::mutex mutex;
+    std::unordered_map<std::string, uint32_t> ids;
+
+    // Tokens index into this deque; entries are never removed, and deque
+    // growth does not move existing elements, so str() can hand out stable
+    // references.
+    std::deque<std::string> strings;
+};
+
+InternTable& internTable() {
+    static InternTable& table = *new InternTable { {}, { { "", 0 } }, { "" } };
+    return table;
+}
+
+} // namespace
+
+InternedString::InternedString(const std::string& s) {
+    InternTable& table = internTable();
+    std::lock_guard<std::mutex> lock(table.mutex);
+    auto it = table.ids.find(s);
+    if (it != table.ids.end()) {
+        id = it->second;
+        return;
+    }
+    id = static_cast<uint32_t>(table.strings.size());
+    table.strings.push_back(s);
+    table.ids.emplace(s, id);
+}
+
+const std::string& InternedString::str() const {
+    InternTable& table = internTable();
+    std::lock_guard<std::mutex> lock(table.mutex);
+    return table.strings[id];
+}
+
+} // namespace util
+} // namespace mbgl
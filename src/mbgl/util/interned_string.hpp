@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+
+namespace mbgl {
+namespace util {
+
+/*
+    A handle to a string in a process-wide intern table. Interning a string
+    hashes it once and yields a small integer token; all subsequent equality
+    checks, hashing, and map lookups on the handle are integer operations.
+
+    Intended for identifiers that are created rarely but compared and hashed
+    in hot loops — layer IDs and source-layer names flowing through tile
+    workers and the feature index. Interned strings are never released, so
+    this is not suitable for unbounded, data-driven string sets.
+
+    Thread-safe: handles may be created and resolved from any thread.
+*/
+class InternedString {
+public:
+    // The empty string is pre-interned as token 0.
+    InternedString() = default;
+    InternedString(const std::string&);
+    InternedString(const char* s) : InternedString(std::string(s)) {}
+
+    // The returned reference remains valid for the lifetime of the process.
+    const std::string& str() const;
+
+    uint32_t token() const { return id; }
+
+    bool operator==(const InternedString& other) const { return id == other.id; }
+    bool operator!=(const InternedString& other) const { return id != other.id; }
+    bool operator<(const InternedString& other) const { return id < other.id; }
+
+private:
+    uint32_t id = 0;
+};
+
+} // namespace util
+} // namespace mbgl
+
+namespace std {
+
+template <>
+struct hash<mbgl::util::InternedString> {
+    size_t operator()(const mbgl::util::InternedString& s) const {
+        return s.token();
+    }
+};
+
+} // namespace std
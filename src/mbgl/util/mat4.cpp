@@ -335,6 +335,34 @@ void multiply(mat4& out, const mat4& a, const mat4& b) {
     out[15] = b0 * a03 + b1 * a13 + b2 * a23 + b3 * a33;
 }
 
+void multiply(mat4& out, const mat4& a, const aff2& b) {
+    const double sx = b[0], sy = b[1], tx = b[2], ty = b[3];
+
+    // The affine transform expands to a matrix whose only non-trivial entries
+    // are the diagonal and the translation row, so the product scales columns
+    // 0 and 1 of `a`, passes column 2 through, and folds the translation into
+    // column 3. The translation is written first so the result may alias `a`.
+    out[12] = a[0] * tx + a[4] * ty + a[12];
+    out[13] = a[1] * tx + a[5] * ty + a[13];
+    out[14] = a[2] * tx + a[6] * ty + a[14];
+    out[15] = a[3] * tx + a[7] * ty + a[15];
+
+    out[0] = a[0] * sx;
+    out[1] = a[1] * sx;
+    out[2] = a[2] * sx;
+    out[3] = a[3] * sx;
+
+    out[4] = a[4] * sy;
+    out[5] = a[5] * sy;
+    out[6] = a[6] * sy;
+    out[7] = a[7] * sy;
+
+    out[8] = a[8];
+    out[9] = a[9];
+    out[10] = a[10];
+    out[11] = a[11];
+}
+
 void transformMat4(vec4& out, const vec4& a, const mat4& m) {
     out[0] = m[0] * a[0] + m[4] * a[1] + m[8] * a[2] + m[12] * a[3];
     out[1] = m[1] * a[0] + m[5] * a[1] + m[9] * a[2] + m[13] * a[3];
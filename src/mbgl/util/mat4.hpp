@@ -29,6 +29,12 @@ namespace mbgl {
 using vec4 = std::array<double, 4>;
 using mat4 = std::array<double, 16>;
 
+// An axis-aligned 2D transform { sx, sy, tx, ty }, applied as scale followed
+// by translate. Tile-to-world transforms are always of this form; keeping
+// them in this representation lets them be composed with a full matrix by
+// touching only three of its columns instead of running a general multiply.
+using aff2 = std::array<double, 4>;
+
 namespace matrix {
 
 void identity(mat4& out);
@@ -43,6 +49,10 @@ void rotate_z(mat4& out, const mat4& a, double rad);
 void scale(mat4& out, const mat4& a, double x, double y, double z);
 void multiply(mat4& out, const mat4& a, const mat4& b);
 
+// out = a * b, where b is the mat4 equivalent of the given affine transform.
+// Safe to call with &out == &a.
+void multiply(mat4& out, const mat4& a, const aff2& b);
+
 void transformMat4(vec4& out, const vec4& a, const mat4& m);
 
 } // namespace matrix
@@ -0,0 +1,86 @@
+#include <mbgl/util/memory_budget.hpp>
+
+#include <algorithm>
+
+namespace mbgl {
+
+std::mutex MemoryBudget::mtx;
+uint64_t MemoryBudget::nextID = 1;
+std::size_t MemoryBudget::limit = 0;
+std::map<uint64_t, MemoryBudget::Participant> MemoryBudget::participants;
+
+std::size_t MemoryBudget::totalUsage() {
+    std::size_t total = 0;
+    for (const auto& entry : participants) {
+        total += entry.second.usage();
+    }
+    return total;
+}
+
+uint64_t MemoryBudget::Register(std::string name, UsageFn usage, TrimFn trim) {
+    std::lock_guard<std::mutex> lock(mtx);
+    const uint64_t id = nextID++;
+    participants.emplace(id, Participant { std::move(name), std::move(usage), std::move(trim) });
+    return id;
+}
+
+void MemoryBudget::Unregister(uint64_t id) {
+    std::lock_guard<std::mutex> lock(mtx);
+    participants.erase(id);
+}
+
+std::size_t MemoryBudget::Usage() {
+    std::lock_guard<std::mutex> lock(mtx);
+    return totalUsage();
+}
+
+void MemoryBudget::SetLimit(std::size_t bytes) {
+    std::lock_guard<std::mutex> lock(mtx);
+    limit = bytes;
+}
+
+std::size_t MemoryBudget::GetLimit() {
+    std::lock_guard<std::mutex> lock(mtx);
+    return limit;
+}
+
+void MemoryBudget::Enforce() {
+    std::lock_guard<std::mutex> lock(mtx);
+
+    if (!limit) {
+        return;
+    }
+
+    const std::size_t total = totalUsage();
+    if (total <= limit) {
+        return;
+    }
+
+    // Only caches with a trim hook can give memory back; the rest just
+    // count against the cap.
+    std::size_t trimmable = 0;
+    for (const auto& entry : participants) {
+        if (entry.second.trim) {
+            trimmable += entry.second.usage();
+        }
+    }
+    if (!trimmable) {
+        return;
+    }
+
+    const std::size_t overage = std::min(total - limit, trimmable);
+    for (const auto& entry : participants) {
+        const auto& participant = entry.second;
+        if (!participant.trim) {
+            continue;
+        }
+        // Each cache gives back a slice of the overage proportional to its
+        // share of the trimmable total.
+        const std::size_t usage = participant.usage();
+        const auto give = static_cast<std::size_t>(
+            double(overage) * double(usage) / double(trimmable));
+        participant.trim(usage - std::min(give, usage));
+    }
+}
+
+} // namespace mbgl
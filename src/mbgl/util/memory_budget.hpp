@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+
+namespace mbgl {
+
+// Process-wide ledger of the memory held by mbgl's in-memory caches.
+//
+// Each cache registers a probe that reports its current byte usage and, if it
+// can shrink on demand, a trim hook. A process-wide cap can then be enforced:
+// when the combined usage exceeds the cap, trimmable caches are asked to give
+// memory back in proportion to their share of it. Caches that cannot shrink
+// (e.g. fixed-size atlas pages) still count against the cap, so shrinkable
+// caches absorb their overage.
+//
+// Registration is thread-safe, but usage probes and trim hooks run on
+// whatever thread calls Usage() or Enforce(). That must be the thread owning
+// the registered caches — in practice, the Map thread. Hooks must not call
+// back into MemoryBudget.
+class MemoryBudget {
+public:
+    using UsageFn = std::function<std::size_t ()>;
+    using TrimFn = std::function<void (std::size_t targetBytes)>;
+
+    // Adds a cache to the ledger and returns a handle for Unregister. The
+    // name is only used for debugging output.
+    static uint64_t Register(std::string name, UsageFn, TrimFn = nullptr);
+    static void Unregister(uint64_t);
+
+    // Combined byte usage of all registered caches.
+    static std::size_t Usage();
+
+    // Sets the process-wide cap in bytes; 0 disables enforcement.
+    static void SetLimit(std::size_t bytes);
+    static std::size_t GetLimit();
+
+    // If combined usage exceeds the cap, shrinks trimmable caches until it
+    // fits (or until nothing more can be given back).
+    static void Enforce();
+
+private:
+    struct Participant {
+        std::string name;
+        UsageFn usage;
+        TrimFn trim;
+    };
+
+    // Combined usage of all participants; the caller must hold mtx.
+    static std::size_t totalUsage();
+
+    static std::mutex mtx;
+    static uint64_t nextID;
+    static std::size_t limit;
+    static std::map<uint64_t, Participant> participants;
+};
+
+} // namespace mbgl
@@ -31,5 +31,19 @@ PremultipliedImage OffscreenTexture::readStillImage() {
     return context.readFramebuffer<PremultipliedImage>(size);
 }
 
+void OffscreenTexture::beginReadStillImage() {
+#if not MBGL_USE_GLES2
+    context.beginFramebufferRead(size);
+#endif
+}
+
+PremultipliedImage OffscreenTexture::endReadStillImage() {
+#if not MBGL_USE_GLES2
+    return context.endFramebufferRead<PremultipliedImage>(size);
+#else
+    return readStillImage();
+#endif
+}
+
 
 } // namespace mbgl
@@ -20,6 +20,12 @@ public:
 
     PremultipliedImage readStillImage();
 
+    // Asynchronous variant: begin queues the readback into a pixel pack
+    // buffer and returns immediately; end collects the pixels. On GLES2 the
+    // pair degenerates to a synchronous read in end.
+    void beginReadStillImage();
+    PremultipliedImage endReadStillImage();
+
     gl::Texture& getTexture();
 
 public:
@@ -0,0 +1,125 @@
+#include <mbgl/util/simplify.hpp>
+
+#include <utility>
+#include <vector>
+
+namespace mbgl {
+namespace util {
+
+namespace {
+
+double squaredDistance(const GeometryCoordinate& a, const GeometryCoordinate& b) {
+    const double dx = double(a.x) - b.x;
+    const double dy = double(a.y) - b.y;
+    return dx * dx + dy * dy;
+}
+
+// Squared distance from `p` to the segment `a`-`b`.
+double squaredSegmentDistance(const GeometryCoordinate& p,
+                              const GeometryCoordinate& a,
+                              const GeometryCoordinate& b) {
+    double x = a.x;
+    double y = a.y;
+    double dx = double(b.x) - x;
+    double dy = double(b.y) - y;
+
+    if (dx != 0 || dy != 0) {
+        const double t = ((p.x - x) * dx + (p.y - y) * dy) / (dx * dx + dy * dy);
+        if (t > 1) {
+            x = b.x;
+            y = b.y;
+        } else if (t > 0) {
+            x += dx * t;
+            y += dy * t;
+        }
+    }
+
+    dx = p.x - x;
+    dy = p.y - y;
+    return dx * dx + dy * dy;
+}
+
+GeometryCoordinates radialFilter(const GeometryCoordinates& points, double sqTolerance) {
+    GeometryCoordinates result;
+    result.reserve(points.size());
+    result.push_back(points.front());
+
+    for (std::size_t i = 1; i + 1 < points.size(); i++) {
+        if (squaredDistance(points[i], result.back()) > sqTolerance) {
+            result.push_back(points[i]);
+        }
+    }
+
+    result.push_back(points.back());
+    return result;
+}
+
+GeometryCoordinates douglasPeucker(const GeometryCoordinates& points, double sqTolerance) {
+    std::vector<bool> keep(points.size(), false);
+    keep.front() = true;
+    keep.back() = true;
+
+    // Iterative Douglas-Peucker: split at the point farthest from the current
+    // segment until every intermediate point is within tolerance.
+    std::vector<std::pair<std::size_t, std::size_t>> stack;
+    stack.emplace_back(0, points.size() - 1);
+
+    while (!stack.empty()) {
+        const std::size_t first = stack.back().first;
+        const std::size_t last = stack.back().second;
+        stack.pop_back();
+
+        double maxSqDistance = sqTolerance;
+        std::size_t index = 0;
+
+        for (std::size_t i = first + 1; i < last; i++) {
+            const double sqDistance = squaredSegmentDistance(points[i], points[first], points[last]);
+            if (sqDistance > maxSqDistance) {
+                maxSqDistance = sqDistance;
+                index = i;
+            }
+        }
+
+        if (index != 0) {
+            keep[index] = true;
+            stack.emplace_back(first, index);
+            stack.emplace_back(index, last);
+        }
+    }
+
+    GeometryCoordinates result;
+    result.reserve(points.size());
+    for (std::size_t i = 0; i < points.size(); i++) {
+        if (keep[i]) {
+            result.push_back(points[i]);
+        }
+    }
+    return result;
+}
+
+} // namespace
+
+GeometryCoordinates simplify(const GeometryCoordinates& points, double tolerance) {
+    if (points.size() < 3 || tolerance <= 0) {
+        return points;
+    }
+
+    const double sqTolerance = tolerance * tolerance;
+    GeometryCoordinates filtered = radialFilter(points, sqTolerance);
+    if (filtered.size() < 3) {
+        return filtered;
+    }
+    return douglasPeucker(filtered, sqTolerance);
+}
+
+GeometryCollection simplify(const GeometryCollection& collection, double tolerance) {
+    GeometryCollection result;
+    result.reserve(collection.size());
+    for (const auto& line : collection) {
+        result.push_back(simplify(line, tolerance));
+    }
+    return result;
+}
+
+} // namespace util
+} // namespace mbgl
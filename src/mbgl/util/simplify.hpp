@@ -0,0 +1,24 @@
+#pragma once
+
+#include <mbgl/tile/geometry_tile_data.hpp>
+
+namespace mbgl {
+namespace util {
+
+// Default simplification tolerance in tile units, chosen to stay below half a
+// screen pixel when a tile renders at its own zoom (EXTENT units across a
+// ≥512px tile), so decimation is invisible. Divide by the overscale factor
+// when the tile may render magnified.
+constexpr double SIMPLIFY_DEFAULT_TOLERANCE = 4.0;
+
+// Reduces the number of points in a line or ring while keeping every surviving
+// point within `tolerance` tile units of the original shape: a radial-distance
+// prefilter followed by Douglas-Peucker. End points are always kept, so closed
+// rings stay closed. Inputs with fewer than three points are returned as-is.
+GeometryCoordinates simplify(const GeometryCoordinates&, double tolerance);
+
+// Applies simplify() to every line or ring in the collection.
+GeometryCollection simplify(const GeometryCollection&, double tolerance);
+
+} // namespace util
+} // namespace mbgl
@@ -91,6 +91,8 @@ Thread<Object>::Thread(const ThreadContext& context, Args&&... args) {
 
         if (context.priority == ThreadPriority::Low) {
             platform::makeThreadLowPriority();
+        } else if (context.priority == ThreadPriority::High) {
+            platform::makeThreadHighPriority();
         }
 
         run(std::move(params), std::index_sequence_for<Args...>{});
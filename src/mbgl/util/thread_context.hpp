@@ -5,9 +5,17 @@
 namespace mbgl {
 namespace util {
 
-enum class ThreadPriority : bool {
+enum class ThreadPriority {
     Regular,
+
+    // Background work (file and database I/O, speculative parsing) that
+    // should yield to everything else.
     Low,
+
+    // Render-critical work whose latency shows up as dropped frames, e.g.
+    // tile layout. Best effort: elevation is platform- and privilege-
+    // dependent, and falls back to Regular where it isn't permitted.
+    High,
 };
 
 struct ThreadContext {
@@ -3,7 +3,9 @@
 #include <mbgl/util/interpolate.hpp>
 #include <mbgl/map/transform_state.hpp>
 
+#include <cmath>
 #include <functional>
+#include <unordered_set>
 
 namespace mbgl {
 
@@ -80,7 +82,8 @@ std::vector<UnwrappedTileID> tileCover(const Point<double>& tl,
                                        const Point<double>& br,
                                        const Point<double>& bl,
                                        const Point<double>& c,
-                                       int32_t z) {
+                                       int32_t z,
+                                       double lodTileDistance = 0) {
     const int32_t tiles = 1 << z;
 
     struct ID {
@@ -118,8 +121,29 @@ std::vector<UnwrappedTileID> tileCover(const Point<double>& tl,
             }), t.end());
 
     std::vector<UnwrappedTileID> result;
+    std::unordered_set<UnwrappedTileID> seen;
     for (const auto& id : t) {
-        result.emplace_back(z, id.x, id.y);
+        int32_t lod = 0;
+        if (lodTileDistance > 0) {
+            // Each doubling of the camera depth halves the on-screen size of
+            // a tile; replace tiles past the first doubling with their
+            // parent, and past the second with their grandparent. The radial
+            // distance from the center slightly overestimates depth for
+            // tiles towards the sides, which only errs towards fewer tiles.
+            const double dist = std::sqrt(id.sqDist);
+            if (dist > 3.0 * lodTileDistance) {
+                lod = 2;
+            } else if (dist > lodTileDistance) {
+                lod = 1;
+            }
+            lod = std::min(lod, z);
+        }
+        // Several far-field tiles map to the same ancestor; keep the first
+        // occurrence so the distance ordering is preserved.
+        const UnwrappedTileID tileID(z - lod, id.x >> lod, id.y >> lod);
+        if (seen.insert(tileID).second) {
+            result.emplace_back(tileID);
+        }
     }
     return result;
 }
@@ -158,13 +182,28 @@ std::vector<UnwrappedTileID> tileCover(const LatLngBounds& bounds_, int32_t z) {
 std::vector<UnwrappedTileID> tileCover(const TransformState& state, int32_t z) {
     const double w = state.getSize().width;
     const double h = state.getSize().height;
+
+    // At high pitch the far rows of the viewport show tiles at a fraction of
+    // their nominal size, and covering them at the ideal zoom loads far more
+    // tiles than the visible pixels justify. Beyond the distance at which
+    // the camera depth has doubled — where a tile's on-screen size has
+    // halved — the cover drops to ancestor tiles, one zoom level per
+    // doubling. Shallow pitches never reach that distance inside the
+    // viewport, so their cover is unchanged.
+    double lodTileDistance = 0;
+    if (state.getPitch() > 30.0 * M_PI / 180.0) {
+        const double pixelsPerTile = util::tileSize * std::pow(2.0, state.getZoom() - z);
+        lodTileDistance =
+            state.getCameraToCenterDistance() / (pixelsPerTile * std::sin(state.getPitch()));
+    }
+
     return tileCover(
         TileCoordinate::fromScreenCoordinate(state, z, { 0,   0   }).p,
         TileCoordinate::fromScreenCoordinate(state, z, { w,   0   }).p,
         TileCoordinate::fromScreenCoordinate(state, z, { w,   h   }).p,
         TileCoordinate::fromScreenCoordinate(state, z, { 0,   h   }).p,
         TileCoordinate::fromScreenCoordinate(state, z, { w/2, h/2 }).p,
-        z);
+        z, lodTileDistance);
 }
 
 } // namespace util
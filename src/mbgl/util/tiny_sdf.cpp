@@ -0,0 +1,117 @@
+#include <mbgl/util/tiny_sdf.hpp>
+
+#include <mbgl/math/clamp.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace mbgl {
+namespace util {
+
+namespace {
+
+const double INF = std::numeric_limits<double>::infinity();
+
+// 1D squared distance transform of a sampled function f (Felzenszwalb &
+// Huttenlocher). v and z are scratch space for the parabola hull; d receives
+// the result. The loops are branch-light and contiguous so the compiler's
+// auto-vectorizer can do its job on the hot row/column sweeps.
+void edt1d(std::vector<double>& f,
+           std::vector<double>& d,
+           std::vector<int16_t>& v,
+           std::vector<double>& z,
+           uint32_t n) {
+    v[0] = 0;
+    z[0] = -INF;
+    z[1] = +INF;
+
+    for (uint32_t q = 1, k = 0; q < n; q++) {
+        double s = ((f[q] + q * q) - (f[v[k]] + v[k] * v[k])) / (2 * q - 2 * v[k]);
+        while (s <= z[k]) {
+            k--;
+            s = ((f[q] + q * q) - (f[v[k]] + v[k] * v[k])) / (2 * q - 2 * v[k]);
+        }
+        k++;
+        v[k] = q;
+        z[k] = s;
+        z[k + 1] = +INF;
+    }
+
+    for (uint32_t q = 0, k = 0; q < n; q++) {
+        while (z[k + 1] < q) {
+            k++;
+        }
+        const double qd = double(q) - v[k];
+        d[q] = qd * qd + f[v[k]];
+    }
+}
+
+// 2D squared distance transform, computed as a column pass followed by a row
+// pass over the same grid.
+void edt(std::vector<double>& grid,
+         uint32_t width,
+         uint32_t height,
+         std::vector<double>& f,
+         std::vector<double>& d,
+         std::vector<int16_t>& v,
+         std::vector<double>& z) {
+    for (uint32_t x = 0; x < width; x++) {
+        for (uint32_t y = 0; y < height; y++) {
+            f[y] = grid[y * width + x];
+        }
+        edt1d(f, d, v, z, height);
+        for (uint32_t y = 0; y < height; y++) {
+            grid[y * width + x] = d[y];
+        }
+    }
+    for (uint32_t y = 0; y < height; y++) {
+        for (uint32_t x = 0; x < width; x++) {
+            f[x] = grid[y * width + x];
+        }
+        edt1d(f, d, v, z, width);
+        for (uint32_t x = 0; x < width; x++) {
+            grid[y * width + x] = std::sqrt(d[x]);
+        }
+    }
+}
+
+} // namespace
+
+AlphaImage transformRasterToSDF(const AlphaImage& rasterInput, double radius, double cutoff) {
+    const uint32_t size = rasterInput.size.width * rasterInput.size.height;
+    const uint32_t maxDimension = std::max(rasterInput.size.width, rasterInput.size.height);
+
+    AlphaImage sdf(rasterInput.size);
+
+    // Temporary arrays for the distance transform.
+    std::vector<double> gridOuter(size);
+    std::vector<double> gridInner(size);
+    std::vector<double> f(maxDimension);
+    std::vector<double> d(maxDimension);
+    std::vector<double> z(maxDimension + 1);
+    std::vector<int16_t> v(maxDimension);
+
+    for (uint32_t i = 0; i < size; i++) {
+        const double a = double(rasterInput.data[i]) / 255; // alpha value
+        gridOuter[i] =
+            a == 1.0 ? 0.0 : a == 0.0 ? INF : std::pow(std::max(0.0, 0.5 - a), 2.0);
+        gridInner[i] =
+            a == 1.0 ? INF : a == 0.0 ? 0.0 : std::pow(std::max(0.0, a - 0.5), 2.0);
+    }
+
+    edt(gridOuter, rasterInput.size.width, rasterInput.size.height, f, d, v, z);
+    edt(gridInner, rasterInput.size.width, rasterInput.size.height, f, d, v, z);
+
+    for (uint32_t i = 0; i < size; i++) {
+        const double distance = gridOuter[i] - gridInner[i];
+        sdf.data[i] = clamp(
+            std::lround(255.0 - 255.0 * (distance / radius + cutoff)), 0l, 255l);
+    }
+
+    return sdf;
+}
+
+} // namespace util
+} // namespace mbgl
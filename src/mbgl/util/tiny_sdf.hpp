@@ -0,0 +1,25 @@
+#pragma once
+
+#include <mbgl/util/image.hpp>
+
+namespace mbgl {
+namespace util {
+
+/*
+    Converts a grayscale coverage bitmap of a locally rasterized glyph into
+    the signed distance field encoding used by the glyph PBFs, so platform
+    font rasterizers can synthesize glyphs (CJK ideographs in particular)
+    instead of downloading the pre-rendered ranges.
+
+    C++ port of https://github.com/mapbox/tiny-sdf, which computes the exact
+    euclidean distance transform of Felzenszwalb & Huttenlocher ("Distance
+    Transforms of Sampled Functions", 2012) in two 1D passes. The defaults
+    match the encoding parameters the rest of the GL ecosystem assumes:
+    distances are mapped over an 8px radius with the glyph edge (d = 0)
+    placed at alpha 191 (cutoff 0.25). The input must already include
+    SDFGlyph::borderSize pixels of empty border on each side.
+*/
+AlphaImage transformRasterToSDF(const AlphaImage& rasterInput, double radius = 8, double cutoff = 0.25);
+
+} // namespace util
+} // namespace mbgl
@@ -3,6 +3,8 @@
 #include <map>
 #include <string>
 #include <algorithm>
+#include <utility>
+#include <vector>
 
 namespace mbgl {
 namespace util {
@@ -37,5 +39,72 @@ std::string replaceTokens(const std::string &source, const Lookup &lookup) {
     return result;
 }
 
+// Pre-parsed {token} template. Parsing the template into literal and token
+// segments once lets repeated expansions — e.g. per feature in a symbol
+// layout — skip the scan and write into a reused buffer instead of building
+// a fresh string each time.
+class TokenTemplate {
+public:
+    explicit TokenTemplate(const std::string& source) {
+        auto pos = source.begin();
+        const auto end = source.end();
+        std::string literal;
+
+        while (pos != end) {
+            auto brace = std::find(pos, end, '{');
+            literal.append(pos, brace);
+            pos = brace;
+            if (pos != end) {
+                for (brace++; brace != end && tokenReservedChars.find(*brace) == std::string::npos; brace++);
+                if (brace != end && *brace == '}') {
+                    if (!literal.empty()) {
+                        segments.push_back({ std::move(literal), false });
+                        literal.clear();
+                    }
+                    segments.push_back({ { pos + 1, brace }, true });
+                    tokens = true;
+                    pos = brace + 1;
+                } else {
+                    literal.append(pos, brace);
+                    pos = brace;
+                }
+            }
+        }
+
+        if (!literal.empty()) {
+            segments.push_back({ std::move(literal), false });
+        }
+    }
+
+    bool hasTokens() const {
+        return tokens;
+    }
+
+    // Expands into `result`, clearing it first so one buffer can be reused
+    // across calls. `appendToken` is called as appendToken(name, result) for
+    // each {token} and appends the replacement itself, so lookups that format
+    // numbers can write in place rather than returning a temporary string.
+    template <typename AppendToken>
+    void expand(std::string& result, const AppendToken& appendToken) const {
+        result.clear();
+        for (const auto& segment : segments) {
+            if (segment.isToken) {
+                appendToken(segment.text, result);
+            } else {
+                result.append(segment.text);
+            }
+        }
+    }
+
+private:
+    struct Segment {
+        std::string text;
+        bool isToken;
+    };
+
+    std::vector<Segment> segments;
+    bool tokens = false;
+};
+
 } // end namespace util
 } // end namespace mbgl
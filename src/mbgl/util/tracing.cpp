@@ -0,0 +1,118 @@
+#include <mbgl/util/tracing.hpp>
+
+#include <fstream>
+#include <mutex>
+
+namespace mbgl {
+namespace util {
+
+std::atomic<bool> Tracing::active { false };
+
+namespace {
+
+struct TraceState {
+    std::ofstream out;
+    TimePoint start;
+    uint32_t nextThreadID = 0;
+};
+
+// Function-local statics so annotations in static initializers are safe.
+std::mutex& traceMutex() {
+    static std::mutex mutex;
+    return mutex;
+}
+
+TraceState& traceState() {
+    static TraceState state;
+    return state;
+}
+
+// Small per-process thread numbers; trace viewers group events by them.
+// Initialized on a thread's first event, which happens under the trace mutex.
+uint32_t currentThreadID() {
+    static thread_local uint32_t id = traceState().nextThreadID++;
+    return id;
+}
+
+int64_t microsecondsSinceStart(const TraceState& state, TimePoint t) {
+    return std::chrono::duration_cast<std::chrono::microseconds>(t - state.start).count();
+}
+
+void writeCommonFields(TraceState& state,
+                       const char* category,
+                       const char* name,
+                       const char* phase,
+                       TimePoint t) {
+    state.out << "{\"name\":\"" << name << "\",\"cat\":\"" << category << "\",\"ph\":\"" << phase
+              << "\",\"ts\":" << microsecondsSinceStart(state, t) << ",\"pid\":1,\"tid\":"
+              << currentThreadID();
+}
+
+} // namespace
+
+void Tracing::Start(const std::string& path) {
+    std::lock_guard<std::mutex> lock(traceMutex());
+    TraceState& state = traceState();
+    if (state.out.is_open()) {
+        return;
+    }
+    state.out.open(path, std::ios::trunc);
+    if (!state.out) {
+        return;
+    }
+    state.start = Clock::now();
+    state.out << "[\n";
+    active.store(true, std::memory_order_relaxed);
+}
+
+void Tracing::Stop() {
+    std::lock_guard<std::mutex> lock(traceMutex());
+    active.store(false, std::memory_order_relaxed);
+    TraceState& state = traceState();
+    if (state.out.is_open()) {
+        // The trailing comma after the last event is accepted by the viewers.
+        state.out << "]\n";
+        state.out.close();
+    }
+}
+
+void Tracing::Complete(const char* category,
+                       const char* name,
+                       TimePoint begin,
+                       TimePoint end,
+                       const std::string& id) {
+    std::lock_guard<std::mutex> lock(traceMutex());
+    TraceState& state = traceState();
+    if (!state.out.is_open()) {
+        return;
+    }
+    writeCommonFields(state, category, name, "X", begin);
+    state.out << ",\"dur\":" << microsecondsSinceStart(state, end) - microsecondsSinceStart(state, begin);
+    if (!id.empty()) {
+        state.out << ",\"args\":{\"id\":\"" << id << "\"}";
+    }
+    state.out << "},\n";
+}
+
+void Tracing::AsyncBegin(const char* category, const char* name, const std::string& id) {
+    std::lock_guard<std::mutex> lock(traceMutex());
+    TraceState& state = traceState();
+    if (!state.out.is_open()) {
+        return;
+    }
+    writeCommonFields(state, category, name, "b", Clock::now());
+    state.out << ",\"id\":\"" << id << "\"},\n";
+}
+
+void Tracing::AsyncEnd(const char* category, const char* name, const std::string& id) {
+    std::lock_guard<std::mutex> lock(traceMutex());
+    TraceState& state = traceState();
+    if (!state.out.is_open()) {
+        return;
+    }
+    writeCommonFields(state, category, name, "e", Clock::now());
+    state.out << ",\"id\":\"" << id << "\"},\n";
+}
+
+} // namespace util
+} // namespace mbgl
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <mbgl/util/chrono.hpp>
+#include <mbgl/util/noncopyable.hpp>
+
+#include <atomic>
+#include <string>
+
+namespace mbgl {
+namespace util {
+
+// Records a session in the Chrome trace-event JSON format, loadable into
+// chrome://tracing or Perfetto. Spans are annotated through the codebase with
+// the MBGL_TRACE_* macros below; recording is toggled at runtime with
+// Start()/Stop() and costs a single relaxed atomic load per annotation while
+// disabled. Events are serialized to the output file as they are recorded,
+// under a mutex, so a session that ends in a crash still yields a readable
+// trace up to that point.
+//
+// Names, categories and IDs are written into the JSON verbatim; they must not
+// contain characters that need escaping. Tile IDs and string literals do not.
+class Tracing : private noncopyable {
+public:
+    // Starts recording, truncating and streaming to the JSON file at `path`.
+    // No-op if recording is already in progress or the file cannot be opened.
+    static void Start(const std::string& path);
+
+    // Stops recording and closes the file. Spans still open on other threads
+    // are dropped.
+    static void Stop();
+
+    static bool Active() {
+        return active.load(std::memory_order_relaxed);
+    }
+
+    // Called by the MBGL_TRACE_* macros and TraceSpan; prefer those.
+    static void Complete(const char* category,
+                         const char* name,
+                         TimePoint begin,
+                         TimePoint end,
+                         const std::string& id);
+    static void AsyncBegin(const char* category, const char* name, const std::string& id);
+    static void AsyncEnd(const char* category, const char* name, const std::string& id);
+
+private:
+    static std::atomic<bool> active;
+};
+
+// Scoped span: records a complete ("X") event covering its own lifetime.
+// Instantiate through MBGL_TRACE_SPAN so disabled annotations stay cheap.
+class TraceSpan : private noncopyable {
+public:
+    TraceSpan(const char* category_, const char* name_, std::string id_ = {})
+        : category(category_),
+          name(name_),
+          id(std::move(id_)),
+          recording(Tracing::Active()),
+          begin(recording ? Clock::now() : TimePoint()) {
+    }
+
+    ~TraceSpan() {
+        if (recording) {
+            Tracing::Complete(category, name, begin, Clock::now(), id);
+        }
+    }
+
+private:
+    const char* const category;
+    const char* const name;
+    const std::string id;
+    const bool recording;
+    const TimePoint begin;
+};
+
+} // namespace util
+} // namespace mbgl
+
+#define __MBGL_TRACE_NAME2(counter) __mbgl_trace_span_##counter
+#define __MBGL_TRACE_NAME(counter) __MBGL_TRACE_NAME2(counter)
+
+#define MBGL_TRACE_SPAN(category, name) \
+    ::mbgl::util::TraceSpan __MBGL_TRACE_NAME(__LINE__)(category, name)
+
+// The ID expression is evaluated even while recording is disabled; guard
+// anything costlier than a member read with Tracing::Active().
+#define MBGL_TRACE_SPAN_ID(category, name, id) \
+    ::mbgl::util::TraceSpan __MBGL_TRACE_NAME(__LINE__)(category, name, id)
+
+// Async ("b"/"e") events for operations that span threads or callbacks, such
+// as a tile fetch. Events pair up by category, name and ID; a begin without a
+// matching end shows as still open in the viewer.
+#define MBGL_TRACE_ASYNC_BEGIN(category, name, id)                 \
+    do {                                                           \
+        if (::mbgl::util::Tracing::Active()) {                     \
+            ::mbgl::util::Tracing::AsyncBegin(category, name, id); \
+        }                                                          \
+    } while (false)
+
+#define MBGL_TRACE_ASYNC_END(category, name, id)                 \
+    do {                                                         \
+        if (::mbgl::util::Tracing::Active()) {                   \
+            ::mbgl::util::Tracing::AsyncEnd(category, name, id); \
+        }                                                        \
+    } while (false)
@@ -0,0 +1,87 @@
+#include <mbgl/actor/actor.hpp>
+#include <mbgl/actor/instrumentation.hpp>
+#include <mbgl/util/default_thread_pool.hpp>
+
+#include <mbgl/test/util.hpp>
+
+#include <future>
+#include <mutex>
+#include <vector>
+
+using namespace mbgl;
+
+TEST(ActorInstrumentation, SamplesMessages) {
+    struct Test {
+        Test(ActorRef<Test>) {}
+
+        void noop() {}
+
+        void end(std::promise<void> promise) {
+            promise.set_value();
+        }
+    };
+
+    std::mutex mutex;
+    std::vector<actor::MessageSample> samples;
+    actor::setMessageSampler(2, [&] (const actor::MessageSample& sample) {
+        std::lock_guard<std::mutex> lock(mutex);
+        samples.push_back(sample);
+    });
+
+    {
+        ThreadPool pool { 1 };
+        Actor<Test> test(pool);
+
+        std::promise<void> promise;
+        auto ended = promise.get_future();
+        for (int i = 0; i < 10; ++i) {
+            test.invoke(&Test::noop);
+        }
+        test.invoke(&Test::end, std::move(promise));
+        ended.wait();
+
+        // Joining the pool guarantees any in-flight sample callback is done.
+    }
+
+    actor::setMessageSampler(0, {});
+
+    // Eleven messages at an interval of two yield at least five samples
+    // regardless of where the process-wide counter started.
+    std::lock_guard<std::mutex> lock(mutex);
+    EXPECT_GE(samples.size(), 5u);
+    for (const auto& sample : samples) {
+        EXPECT_NE(nullptr, sample.mailbox);
+        EXPECT_GE(sample.waitTime, Duration::zero());
+        EXPECT_GE(sample.processingTime, Duration::zero());
+    }
+}
+
+TEST(ActorInstrumentation, DisabledSamplerReportsNothing) {
+    struct Test {
+        Test(ActorRef<Test>) {}
+
+        void end(std::promise<void> promise) {
+            promise.set_value();
+        }
+    };
+
+    std::mutex mutex;
+    std::vector<actor::MessageSample> samples;
+    actor::setMessageSampler(0, [&] (const actor::MessageSample& sample) {
+        std::lock_guard<std::mutex> lock(mutex);
+        samples.push_back(sample);
+    });
+
+    {
+        ThreadPool pool { 1 };
+        Actor<Test> test(pool);
+
+        std::promise<void> promise;
+        auto ended = promise.get_future();
+        test.invoke(&Test::end, std::move(promise));
+        ended.wait();
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    EXPECT_TRUE(samples.empty());
+}
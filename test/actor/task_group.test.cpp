@@ -0,0 +1,64 @@
+#include <mbgl/actor/actor.hpp>
+#include <mbgl/actor/task_group.hpp>
+#include <mbgl/util/default_thread_pool.hpp>
+
+#include <mbgl/test/util.hpp>
+
+#include <atomic>
+#include <stdexcept>
+
+using namespace mbgl;
+
+TEST(TaskGroup, JoinRunsEveryTask) {
+    // Without any helpers, join() drains the whole queue on the calling
+    // thread.
+
+    TaskGroup group;
+    std::atomic<int> ran { 0 };
+
+    for (int i = 0; i < 16; ++i) {
+        group.add([&] { ++ran; });
+    }
+
+    group.join();
+
+    EXPECT_EQ(16, ran.load());
+}
+
+TEST(TaskGroup, HelpersShareTheQueue) {
+    // Helper messages on pool threads pull from the same queue; every task
+    // still runs exactly once, and join() blocks until the last one is done.
+
+    ThreadPool pool { 2 };
+    TaskGroup group;
+    std::atomic<int> ran { 0 };
+
+    const int total = 64;
+    for (int i = 0; i < total; ++i) {
+        group.add([&] { ++ran; });
+    }
+
+    Actor<TaskGroupHelper> helper { pool, group };
+    for (int i = 1; i < total; ++i) {
+        helper.invoke(&TaskGroupHelper::runOne);
+    }
+
+    group.join();
+
+    EXPECT_EQ(total, ran.load());
+}
+
+TEST(TaskGroup, JoinRethrowsFirstException) {
+    // A throwing task doesn't stop the rest of the group; the first
+    // exception resurfaces from join().
+
+    TaskGroup group;
+    std::atomic<int> ran { 0 };
+
+    group.add([&] { ++ran; });
+    group.add([] { throw std::runtime_error("failed task"); });
+    group.add([&] { ++ran; });
+
+    EXPECT_THROW(group.join(), std::runtime_error);
+    EXPECT_EQ(2, ran.load());
+}
@@ -45,6 +45,36 @@ TEST(Query, QueryRenderedFeatures) {
     EXPECT_EQ(features2.size(), 0u);
 }
 
+TEST(Query, QueryRenderedFeaturesAsync) {
+    QueryTest test;
+
+    // The query is deferred off the caller's stack and answered on the next
+    // run loop wakeup.
+    std::vector<Feature> features;
+    bool answered = false;
+    test.map.queryRenderedFeatures(test.map.pixelForLatLng({ 0, 0 }), {}, {},
+                                   [&] (std::vector<Feature> result) {
+        features = std::move(result);
+        answered = true;
+        test.loop.stop();
+    });
+    EXPECT_FALSE(answered);
+
+    test.loop.run();
+    EXPECT_TRUE(answered);
+    EXPECT_EQ(features.size(), 3u);
+
+    // A limit truncates the result and stops the query early.
+    test.map.queryRenderedFeatures(test.map.pixelForLatLng({ 0, 0 }), {}, { 1u },
+                                   [&] (std::vector<Feature> result) {
+        features = std::move(result);
+        test.loop.stop();
+    });
+
+    test.loop.run();
+    EXPECT_EQ(features.size(), 1u);
+}
+
 TEST(Query, QueryRenderedFeaturesFilterLayer) {
     QueryTest test;
 
@@ -17,16 +17,48 @@ TEST(BinPack, Allocating) {
 
     rects[0] = bin.allocate(32, 48);
     ASSERT_EQ(mbgl::Rect<uint16_t>(0, 0, 32, 48), rects[0]);
+
+    // Equal heights share a shelf; a differing height opens a new one rather
+    // than wasting the 48-high shelf.
     rects[1] = bin.allocate(8, 17);
-    ASSERT_EQ(mbgl::Rect<uint16_t>(32, 0, 8, 17), rects[1]);
+    ASSERT_EQ(mbgl::Rect<uint16_t>(0, 48, 8, 17), rects[1]);
     rects[2] = bin.allocate(8, 17);
-    ASSERT_EQ(mbgl::Rect<uint16_t>(0, 48, 8, 17), rects[2]);
+    ASSERT_EQ(mbgl::Rect<uint16_t>(8, 48, 8, 17), rects[2]);
 
+    // Releasing the 48-high entry leaves an empty shelf, which is split for
+    // the next, shorter request instead of being wasted.
     bin.release(rects[0]);
     rects[0] = bin.allocate(32, 24);
     ASSERT_EQ(mbgl::Rect<uint16_t>(0, 0, 32, 24), rects[0]);
     rects[3] = bin.allocate(32, 24);
-    ASSERT_EQ(mbgl::Rect<uint16_t>(32, 17, 32, 24), rects[3]);
+    ASSERT_EQ(mbgl::Rect<uint16_t>(32, 0, 32, 24), rects[3]);
+}
+
+TEST(BinPack, MergeReclaimsFreedSpace) {
+    mbgl::BinPack<uint16_t> bin(128, 128);
+
+    // Fill two shelves with entries of different heights.
+    std::vector<mbgl::Rect<uint16_t>> first, second;
+    for (int i = 0; i < 4; i++) {
+        first.push_back(bin.allocate(32, 64));
+        ASSERT_TRUE(first.back().hasArea());
+    }
+    for (int i = 0; i < 4; i++) {
+        second.push_back(bin.allocate(32, 64));
+        ASSERT_TRUE(second.back().hasArea());
+    }
+    ASSERT_FALSE(bin.allocate(128, 128).hasArea());
+
+    // Releasing both shelves merges their spans, merges the empty shelves,
+    // and returns the space to the unshelved remainder: the full-size
+    // allocation fits again.
+    for (auto& rect : first) {
+        bin.release(rect);
+    }
+    for (auto& rect : second) {
+        bin.release(rect);
+    }
+    ASSERT_TRUE(bin.allocate(128, 128).hasArea());
 }
 
 
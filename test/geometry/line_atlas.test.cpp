@@ -0,0 +1,47 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/geometry/line_atlas.hpp>
+
+using namespace mbgl;
+
+TEST(LineAtlas, Deduplication) {
+    LineAtlas atlas { { 64, 8 } };
+
+    LinePatternPos a = atlas.getDashPosition({ 1, 2 }, LinePatternCap::Square);
+    LinePatternPos b = atlas.getDashPosition({ 1, 2 }, LinePatternCap::Square);
+    EXPECT_EQ(a.y, b.y);
+
+    // A different pattern, and the same pattern with a different cap, get
+    // their own rows.
+    EXPECT_NE(a.y, atlas.getDashPosition({ 2, 1 }, LinePatternCap::Square).y);
+}
+
+TEST(LineAtlas, Eviction) {
+    // Four rows: four square-cap patterns fill the atlas.
+    LineAtlas atlas { { 64, 4 } };
+
+    LinePatternPos first = atlas.getDashPosition({ 1, 1 }, LinePatternCap::Square);
+    LinePatternPos second = atlas.getDashPosition({ 1, 2 }, LinePatternCap::Square);
+    atlas.getDashPosition({ 1, 3 }, LinePatternCap::Square);
+    atlas.getDashPosition({ 1, 4 }, LinePatternCap::Square);
+
+    // A fifth pattern reuses the row of the least recently used one.
+    LinePatternPos fifth = atlas.getDashPosition({ 1, 5 }, LinePatternCap::Square);
+    EXPECT_EQ(first.y, fifth.y);
+
+    // Re-requesting the evicted pattern re-renders it into the next
+    // least recently used row.
+    LinePatternPos readded = atlas.getDashPosition({ 1, 1 }, LinePatternCap::Square);
+    EXPECT_EQ(second.y, readded.y);
+}
+
+TEST(LineAtlas, PinsPatternsOfDrawInProgress) {
+    // A single row: the second pattern would have to evict the first, but
+    // the first is one of the two positions of the dash transition being
+    // drawn, so the atlas reports overflow instead of corrupting it.
+    LineAtlas atlas { { 64, 1 } };
+
+    atlas.getDashPosition({ 1, 1 }, LinePatternCap::Square);
+    LinePatternPos overflowed = atlas.getDashPosition({ 1, 2 }, LinePatternCap::Square);
+    EXPECT_EQ(0, overflowed.width);
+}
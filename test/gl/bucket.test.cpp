@@ -11,18 +11,26 @@
 
 using namespace mbgl;
 
+namespace {
+
+// BucketParameters references the owning tile's cancellation flag; these
+// buckets have no tile, so give them one that never fires.
+const std::atomic<bool> neverObsolete { false };
+
+} // namespace
+
 TEST(Buckets, CircleBucket) {
-    CircleBucket bucket { { {0, 0, 0}, MapMode::Still }, {} };
+    CircleBucket bucket { { {0, 0, 0}, MapMode::Still, neverObsolete }, {} };
     ASSERT_FALSE(bucket.hasData());
 }
 
 TEST(Buckets, FillBucket) {
-    FillBucket bucket { { {0, 0, 0}, MapMode::Still }, {} };
+    FillBucket bucket { { {0, 0, 0}, MapMode::Still, neverObsolete }, {} };
     ASSERT_FALSE(bucket.hasData());
 }
 
 TEST(Buckets, LineBucket) {
-    LineBucket bucket { { {0, 0, 0}, MapMode::Still }, {}, {} };
+    LineBucket bucket { { {0, 0, 0}, MapMode::Still, neverObsolete }, {}, {} };
     ASSERT_FALSE(bucket.hasData());
 }
 
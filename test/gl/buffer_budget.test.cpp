@@ -0,0 +1,38 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/gl/buffer_budget.hpp>
+
+using namespace mbgl;
+
+// The ledger is process-wide, so every test restores a clean slate.
+
+TEST(BufferBudget, TracksAllocations) {
+    gl::BufferBudget::SetLimit(0);
+    const size_t baseline = gl::BufferBudget::Usage();
+
+    gl::BufferBudget::Allocated(4096);
+    EXPECT_EQ(baseline + 4096, gl::BufferBudget::Usage());
+
+    gl::BufferBudget::Freed(4096);
+    EXPECT_EQ(baseline, gl::BufferBudget::Usage());
+}
+
+TEST(BufferBudget, NoPressureWithoutLimit) {
+    gl::BufferBudget::SetLimit(0);
+    EXPECT_EQ(1.0, gl::BufferBudget::Pressure(64 * 1024 * 1024));
+}
+
+TEST(BufferBudget, PressureGrowsWithProjectedOverage) {
+    gl::BufferBudget::SetLimit(1024 * 1024);
+
+    // Fits: no pressure.
+    EXPECT_EQ(1.0, gl::BufferBudget::Pressure(512 * 1024));
+
+    // Projected to double the budget: pressure matches the overage ratio.
+    EXPECT_DOUBLE_EQ(2.0, gl::BufferBudget::Pressure(2 * 1024 * 1024));
+
+    // Pathological estimates are capped.
+    EXPECT_EQ(4.0, gl::BufferBudget::Pressure(1024 * 1024 * 1024));
+
+    gl::BufferBudget::SetLimit(0);
+}
@@ -80,3 +80,56 @@ TEST(GLObject, Store) {
 
     backend.deactivate();
 }
+
+TEST(GLObject, LowMemoryCleanup) {
+    HeadlessBackend backend { test::sharedDisplay() };
+    OffscreenView view(backend.getContext());
+
+    gl::Context context;
+
+    // A released texture is pooled for reuse rather than deleted, so a
+    // regular cleanup keeps it alive.
+    gl::UniqueTexture texture = context.createTexture();
+    texture.reset();
+    context.performCleanup();
+    EXPECT_FALSE(context.empty());
+
+    // The memory pressure tier drains the pool as well.
+    context.performLowMemoryCleanup();
+    EXPECT_TRUE(context.empty());
+
+    backend.deactivate();
+}
+
+TEST(GLObject, BufferPool) {
+    HeadlessBackend backend { test::sharedDisplay() };
+    OffscreenView view(backend.getContext());
+
+    gl::Context context;
+
+    struct TestVertex { std::array<int16_t, 2> a1; };
+
+    gl::VertexVector<TestVertex> vertices;
+    vertices.emplace_back(TestVertex { {{ 0, 0 }} });
+    auto buffer = context.createVertexBuffer(std::move(vertices));
+    const gl::BufferID id = buffer.buffer.get();
+    EXPECT_NE(id, 0u);
+
+    // A released buffer name is pooled for reuse rather than deleted; the
+    // next buffer gets the recycled name, regardless of its size, since the
+    // storage is re-specified on upload.
+    buffer.buffer.reset();
+    gl::VertexVector<TestVertex> more;
+    more.emplace_back(TestVertex { {{ 1, 1 }} });
+    more.emplace_back(TestVertex { {{ 2, 2 }} });
+    auto recycled = context.createVertexBuffer(std::move(more));
+    EXPECT_EQ(id, recycled.buffer.get());
+
+    // The memory pressure tier drains the buffer pool as well.
+    recycled.buffer.reset();
+    EXPECT_FALSE(context.empty());
+    context.performLowMemoryCleanup();
+    EXPECT_TRUE(context.empty());
+
+    backend.deactivate();
+}
@@ -4,6 +4,7 @@
 #include <mbgl/test/fixture_log_observer.hpp>
 
 #include <mbgl/map/map.hpp>
+#include <mbgl/map/map_state.hpp>
 #include <mbgl/gl/headless_backend.hpp>
 #include <mbgl/gl/offscreen_view.hpp>
 #include <mbgl/util/default_thread_pool.hpp>
@@ -46,6 +47,45 @@ TEST(Map, LatLngBehavior) {
     ASSERT_DOUBLE_EQ(latLng1.longitude, latLng2.longitude);
 }
 
+TEST(Map, ApplyState) {
+    MapTest test;
+    Map map(test.backend, test.view.size, 1, test.fileSource, test.threadPool, MapMode::Still);
+
+    map.setStyleJSON(util::read_file("test/fixtures/api/empty.json"));
+
+    MapState state;
+    state.camera = CameraOptions();
+    state.camera->center = LatLng { 10, 20 };
+    state.camera->zoom = 3;
+    state.debugOptions = MapDebugOptions::TileBorders;
+    state.classes = std::vector<std::string> { "night" };
+
+    map.applyState(state);
+
+    EXPECT_DOUBLE_EQ(10, map.getLatLng().latitude);
+    EXPECT_DOUBLE_EQ(20, map.getLatLng().longitude);
+    EXPECT_DOUBLE_EQ(3, map.getZoom());
+    EXPECT_TRUE(map.getDebug() & MapDebugOptions::TileBorders);
+    EXPECT_TRUE(map.hasClass("night"));
+
+    // Unset fields leave the corresponding state untouched.
+    map.applyState(MapState());
+    EXPECT_DOUBLE_EQ(3, map.getZoom());
+    EXPECT_TRUE(map.hasClass("night"));
+}
+
+TEST(Map, NeedsRepaint) {
+    MapTest test;
+    Map map(test.backend, test.view.size, 1, test.fileSource, test.threadPool, MapMode::Still);
+
+    // A map that has never been fully rendered always needs painting.
+    EXPECT_TRUE(map.needsRepaint());
+
+    map.setStyleJSON(util::read_file("test/fixtures/api/empty.json"));
+    map.setLatLngZoom({ 1, 1 }, 0);
+    EXPECT_TRUE(map.needsRepaint());
+}
+
 TEST(Map, Offline) {
     MapTest test;
     DefaultFileSource fileSource(":memory:", ".");
@@ -225,6 +265,64 @@ TEST(Map, StyleEarlyMutation) {
     EXPECT_NE(nullptr, map.getLayer("water"));
 }
 
+TEST(Map, StyleReloadForPooledReuse) {
+    MapTest test;
+
+    Map map(test.backend, test.view.size, 1, test.fileSource, test.threadPool, MapMode::Still);
+
+    unsigned loadStarted = 0;
+    test.backend.setMapChangeCallback([&](MapChange change) {
+        if (change == mbgl::MapChangeWillStartLoadingMap) {
+            ++loadStarted;
+        }
+    });
+
+    const std::string json = util::read_file("test/fixtures/api/water.json");
+
+    // Re-setting the identical stylesheet keeps the parsed style warm.
+    map.setStyleJSON(json);
+    map.setStyleJSON(json);
+    EXPECT_EQ(1u, loadStarted);
+
+    // But once the style has been mutated, reloading it starts over from the
+    // stylesheet as written.
+    map.addLayer(std::make_unique<style::BackgroundLayer>("bg"));
+    EXPECT_NE(nullptr, map.getLayer("bg"));
+
+    map.setStyleJSON(json);
+    EXPECT_EQ(2u, loadStarted);
+    EXPECT_EQ(nullptr, map.getLayer("bg"));
+    EXPECT_NE(nullptr, map.getLayer("water"));
+}
+
+TEST(Map, PrefetchGlyphs) {
+    MapTest test;
+    FakeFileSource fileSource;
+
+    Map map(test.backend, test.view.size, 1, fileSource, test.threadPool, MapMode::Still);
+    map.setStyleJSON(R"STYLE({
+        "version": 8,
+        "glyphs": "test://prefetch-glyphs/{fontstack}/{range}.pbf",
+        "sources": {},
+        "layers": []
+    })STYLE");
+
+    // Two 256-codepoint ranges cover the requested span.
+    map.prefetchGlyphs({ { "Test Prefetch Stack" } }, u'一', u'俿');
+    test.runLoop.runOnce();
+
+    auto glyphRequests = std::count_if(fileSource.requests.begin(), fileSource.requests.end(),
+                                       [] (FakeFileSource::FakeFileRequest* request) {
+        return request->resource.kind == Resource::Kind::Glyphs;
+    });
+    EXPECT_EQ(2, static_cast<int>(glyphRequests));
+
+    // Already-requested ranges are not requested again.
+    map.prefetchGlyphs({ { "Test Prefetch Stack" } }, u'一', u'俿');
+    test.runLoop.runOnce();
+    EXPECT_EQ(2u, fileSource.requests.size());
+}
+
 TEST(Map, StyleLoadedSignal) {
     MapTest test;
     Map map(test.backend, test.view.size, 1, test.fileSource, test.threadPool, MapMode::Still);
@@ -380,6 +478,31 @@ TEST(Map, DisabledSources) {
     test::checkImage("test/fixtures/map/disabled_layers/second", test::render(map, test.view));
 }
 
+TEST(Map, BatchedUpdates) {
+    MapTest test;
+
+    Map map(test.backend, test.view.size, 1, test.fileSource, test.threadPool, MapMode::Still);
+    map.setStyleJSON(util::read_file("test/fixtures/api/empty.json"));
+
+    // Mutations inside a batch apply immediately and are observable through
+    // getters; only the invalidation is deferred to endUpdates.
+    map.beginUpdates();
+    map.addClass("night");
+    EXPECT_TRUE(map.hasClass("night"));
+    map.addAnnotation(LineAnnotation { LineString<double> {{ { 0, 0 }, { 10, 10 } }} });
+    map.endUpdates();
+
+    EXPECT_TRUE(map.needsRepaint());
+
+    // Batches nest; an inner endUpdates does not unbalance the outer batch.
+    map.beginUpdates();
+    map.beginUpdates();
+    map.removeClass("night");
+    map.endUpdates();
+    map.endUpdates();
+    EXPECT_FALSE(map.hasClass("night"));
+}
+
 TEST(Map, Classes) {
     MapTest test;
 
@@ -0,0 +1,66 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/map/quality_governor.hpp>
+#include <mbgl/util/constants.hpp>
+
+using namespace mbgl;
+
+namespace {
+
+const Duration interval = Milliseconds(16);
+
+void feed(QualityGovernor& governor, const Duration& frameTime, int frames) {
+    for (int i = 0; i < frames; i++) {
+        governor.observeFrame(frameTime, interval);
+    }
+}
+
+} // namespace
+
+TEST(QualityGovernor, StaysAtFullQualityWithHeadroom) {
+    QualityGovernor governor;
+    feed(governor, Milliseconds(5), 1000);
+
+    EXPECT_EQ(QualityGovernor::Level::Full, governor.level());
+    EXPECT_EQ(0.0f, governor.placementAngleQuantization());
+    EXPECT_EQ(util::DEFAULT_FADE_DURATION, governor.fadeDuration());
+    EXPECT_TRUE(governor.allowSpeculativeWork());
+}
+
+TEST(QualityGovernor, DegradesUnderSustainedOverrun) {
+    QualityGovernor governor;
+    feed(governor, Milliseconds(30), 20);
+
+    EXPECT_EQ(QualityGovernor::Level::Reduced, governor.level());
+    EXPECT_GT(governor.placementAngleQuantization(), 0.0f);
+    EXPECT_LT(governor.fadeDuration(), util::DEFAULT_FADE_DURATION);
+
+    // Keep overrunning: bottoms out at Minimal and stays there.
+    feed(governor, Milliseconds(30), 1000);
+    EXPECT_EQ(QualityGovernor::Level::Minimal, governor.level());
+    EXPECT_EQ(Duration::zero(), governor.fadeDuration());
+    EXPECT_FALSE(governor.allowSpeculativeWork());
+}
+
+TEST(QualityGovernor, SingleSpikeDoesNotDegrade) {
+    QualityGovernor governor;
+    feed(governor, Milliseconds(5), 100);
+    governor.observeFrame(Milliseconds(200), interval);
+    feed(governor, Milliseconds(5), 100);
+
+    EXPECT_EQ(QualityGovernor::Level::Full, governor.level());
+}
+
+TEST(QualityGovernor, RecoversSlowly) {
+    QualityGovernor governor;
+    feed(governor, Milliseconds(30), 20);
+    ASSERT_EQ(QualityGovernor::Level::Reduced, governor.level());
+
+    // A short stretch of headroom is not enough to recover...
+    feed(governor, Milliseconds(5), 30);
+    EXPECT_EQ(QualityGovernor::Level::Reduced, governor.level());
+
+    // ...a sustained one is.
+    feed(governor, Milliseconds(5), 1000);
+    EXPECT_EQ(QualityGovernor::Level::Full, governor.level());
+}
@@ -476,9 +476,13 @@ TEST(Transform, Camera) {
     transform.easeTo(cameraOptions1, easeOptions);
     ASSERT_TRUE(transform.inTransition());
     transform.updateTransitions(transform.getTransitionStart() + Milliseconds(250));
+    transform.deliverTransitionNotifications();
     transform.updateTransitions(transform.getTransitionStart() + Milliseconds(500));
+    transform.deliverTransitionNotifications();
     transform.updateTransitions(transform.getTransitionStart() + Milliseconds(750));
+    transform.deliverTransitionNotifications();
     transform.updateTransitions(transform.getTransitionStart() + transform.getTransitionDuration());
+    transform.deliverTransitionNotifications();
     ASSERT_FALSE(transform.inTransition());
 
     AnimationOptions flyOptions(Seconds(1));
@@ -498,9 +502,13 @@ TEST(Transform, Camera) {
     transform.flyTo(cameraOptions2, flyOptions);
     ASSERT_TRUE(transform.inTransition());
     transform.updateTransitions(transform.getTransitionStart() + Milliseconds(250));
+    transform.deliverTransitionNotifications();
     transform.updateTransitions(transform.getTransitionStart() + Milliseconds(500));
+    transform.deliverTransitionNotifications();
     transform.updateTransitions(transform.getTransitionStart() + Milliseconds(750));
+    transform.deliverTransitionNotifications();
     transform.updateTransitions(transform.getTransitionStart() + transform.getTransitionDuration());
+    transform.deliverTransitionNotifications();
     ASSERT_FALSE(transform.inTransition());
 }
 
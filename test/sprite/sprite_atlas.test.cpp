@@ -4,7 +4,7 @@
 #include <mbgl/test/stub_style_observer.hpp>
 
 #include <mbgl/sprite/sprite_atlas.hpp>
-#include <mbgl/sprite/sprite_atlas.hpp>
+#include <mbgl/sprite/sprite_cache.hpp>
 #include <mbgl/sprite/sprite_parser.hpp>
 #include <mbgl/util/io.hpp>
 #include <mbgl/util/image.hpp>
@@ -260,7 +260,11 @@ TEST(SpriteAtlas, ReplaceWithDifferentDimensions) {
 
 class SpriteAtlasTest {
 public:
-    SpriteAtlasTest() = default;
+    SpriteAtlasTest() {
+        // Every case below loads the same sprite URL; keep the process-wide
+        // cache from leaking a parsed sheet into the failure cases.
+        SpriteCache::Get().clear();
+    }
 
     util::RunLoop loop;
     StubFileSource fileSource;
@@ -409,3 +413,39 @@ TEST(SpriteAtlas, LoadingCancel) {
 
     test.run();
 }
+
+TEST(SpriteAtlas, SharedViaSpriteCache) {
+    SpriteAtlasTest test;
+
+    test.fileSource.spriteImageResponse = successfulSpriteImageResponse;
+    test.fileSource.spriteJSONResponse = successfulSpriteJSONResponse;
+
+    test.observer.spriteLoaded = [&] () {
+        test.end();
+    };
+
+    test.run();
+
+    // A second atlas for the same URL and pixel ratio is satisfied from the
+    // process-wide cache without touching the FileSource.
+    test.fileSource.spriteImageResponse =
+    test.fileSource.spriteJSONResponse = failedSpriteResponse;
+
+    SpriteAtlas secondAtlas { { 32, 32 }, 1 };
+    StubStyleObserver secondObserver;
+
+    secondObserver.spriteError = [&] (std::exception_ptr error) {
+        FAIL() << util::toString(error);
+        test.end();
+    };
+
+    secondObserver.spriteLoaded = [&] () {
+        EXPECT_TRUE(secondAtlas.isLoaded());
+        test.end();
+    };
+
+    secondAtlas.setObserver(&secondObserver);
+    secondAtlas.load("test/fixtures/resources/sprite", test.fileSource);
+
+    test.loop.run();
+}
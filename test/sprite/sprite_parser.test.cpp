@@ -286,7 +286,7 @@ TEST(Sprite, SpriteParsing) {
         EXPECT_EQ(18u, sprite->image.size.width);
         EXPECT_EQ(18u, sprite->image.size.height);
         EXPECT_EQ(1, sprite->pixelRatio);
-        EXPECT_EQ(readImage("test/fixtures/annotations/result-spriteparsing.png"), sprite->image);
+        EXPECT_EQ(readImage("test/fixtures/annotations/result-spriteparsing.png"), sprite->getImage());
     }
 }
 
@@ -1,5 +1,8 @@
 #include <mbgl/test/util.hpp>
 #include <mbgl/storage/default_file_source.hpp>
+#include <mbgl/storage/offline_database.hpp>
+#include <mbgl/storage/offline_pack.hpp>
+#include <mbgl/util/io.hpp>
 #include <mbgl/util/run_loop.hpp>
 
 using namespace mbgl;
@@ -291,6 +294,93 @@ TEST(DefaultFileSource, OptionalNotFound) {
     loop.run();
 }
 
+TEST(DefaultFileSource, SessionJournal) {
+    util::RunLoop loop;
+    const std::string path = "test/fixtures/offline_database/journal.db";
+    util::deleteFile(path);
+
+    const Resource resource { Resource::Unknown, "http://127.0.0.1:3000/journal", {}, Resource::Optional };
+
+    using namespace std::chrono_literals;
+
+    Response response;
+    response.data = std::make_shared<std::string>("Cached value");
+    response.expires = util::now() + 1h;
+
+    // First session: the request is recorded in the session journal, which is
+    // persisted when the file source shuts down.
+    {
+        DefaultFileSource fs(path, ".");
+        fs.put(resource, response);
+
+        std::unique_ptr<AsyncRequest> req;
+        req = fs.request(resource, [&](Response res) {
+            req.reset();
+            EXPECT_EQ(nullptr, res.error);
+            loop.stop();
+        });
+        loop.run();
+    }
+
+    // The persisted journal names the requested resource...
+    {
+        OfflineDatabase db(path);
+        auto journal = db.get({ Resource::Unknown, "mapbox://journal/last-session" });
+        ASSERT_TRUE(bool(journal));
+        ASSERT_TRUE(journal->data.get());
+        EXPECT_NE(std::string::npos, journal->data->find("http://127.0.0.1:3000/journal"));
+    }
+
+    // ...and the next session, which replays it against the database during
+    // startup, still answers the request from the cache.
+    {
+        DefaultFileSource fs(path, ".");
+
+        std::unique_ptr<AsyncRequest> req;
+        req = fs.request(resource, [&](Response res) {
+            req.reset();
+            EXPECT_EQ(nullptr, res.error);
+            ASSERT_TRUE(res.data.get());
+            EXPECT_EQ("Cached value", *res.data);
+            loop.stop();
+        });
+        loop.run();
+    }
+
+    util::deleteFile(path);
+}
+
+// Test that a mounted offline pack answers requests that miss the database.
+TEST(DefaultFileSource, OfflinePackMount) {
+    util::RunLoop loop;
+
+    const std::string path = "test/fixtures/offline_database/mounted_pack.bin";
+    OfflinePack::write(path, {
+        { OfflinePack::entryKey(Resource::style("http://127.0.0.1:3000/pack-style")), "Pack value", false },
+    });
+
+    DefaultFileSource fs(":memory:", ".");
+    fs.mountOfflinePack(path, [&] (std::exception_ptr error) {
+        EXPECT_FALSE(bool(error));
+    });
+
+    Resource resource = Resource::style("http://127.0.0.1:3000/pack-style");
+    resource.necessity = Resource::Optional;
+
+    std::unique_ptr<AsyncRequest> req;
+    req = fs.request(resource, [&] (Response res) {
+        req.reset();
+        EXPECT_EQ(nullptr, res.error);
+        ASSERT_TRUE(res.data.get());
+        EXPECT_EQ("Pack value", *res.data);
+        loop.stop();
+    });
+
+    loop.run();
+
+    util::deleteFile(path);
+}
+
 // Test that we can make a request with etag data that doesn't first try to load
 // from cache like a regular request
 TEST(DefaultFileSource, TEST_REQUIRES_SERVER(NoCacheRefreshEtagNotModified)) {
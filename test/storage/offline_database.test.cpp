@@ -219,6 +219,40 @@ TEST(OfflineDatabase, PutTile) {
     EXPECT_EQ("second", *updateGetResult->data);
 }
 
+TEST(OfflineDatabase, GetTiles) {
+    using namespace mbgl;
+
+    OfflineDatabase db(":memory:");
+
+    auto makeTile = [] (uint32_t x) {
+        Resource resource { Resource::Tile, "http://example.com/" };
+        resource.tileData = Resource::TileData {
+            "http://example.com/",
+            1,
+            x,
+            0,
+            0
+        };
+        return resource;
+    };
+
+    Response response;
+    response.data = std::make_shared<std::string>("first");
+    db.put(makeTile(0), response);
+
+    response.data = std::make_shared<std::string>("second");
+    db.put(makeTile(2), response);
+
+    auto results = db.getTiles({ makeTile(0), makeTile(1), makeTile(2) });
+
+    ASSERT_EQ(3u, results.size());
+    ASSERT_TRUE(bool(results[0]));
+    EXPECT_EQ("first", *results[0]->first.data);
+    EXPECT_FALSE(bool(results[1]));
+    ASSERT_TRUE(bool(results[2]));
+    EXPECT_EQ("second", *results[2]->first.data);
+}
+
 TEST(OfflineDatabase, PutResourceNoContent) {
     using namespace mbgl;
 
@@ -606,52 +640,49 @@ TEST(OfflineDatabase, OfflineMapboxTileCount) {
     EXPECT_EQ(0u, db.getOfflineMapboxTileCount());
 }
 
+// These helpers open the database read-write: even a reader of a WAL-mode
+// database needs to create the -shm file, which a read-only connection cannot
+// do on the older SQLite versions we still support.
+
 static int databasePageCount(const std::string& path) {
-    mapbox::sqlite::Database db(path, mapbox::sqlite::ReadOnly);
+    mapbox::sqlite::Database db(path, mapbox::sqlite::ReadWrite);
     mapbox::sqlite::Statement stmt = db.prepare("pragma page_count");
     stmt.run();
     return stmt.get<int>(0);
 }
 
 static int databaseUserVersion(const std::string& path) {
-    mapbox::sqlite::Database db(path, mapbox::sqlite::ReadOnly);
+    mapbox::sqlite::Database db(path, mapbox::sqlite::ReadWrite);
     mapbox::sqlite::Statement stmt = db.prepare("pragma user_version");
     stmt.run();
     return stmt.get<int>(0);
 }
 
 static std::string databaseJournalMode(const std::string& path) {
-    mapbox::sqlite::Database db(path, mapbox::sqlite::ReadOnly);
+    mapbox::sqlite::Database db(path, mapbox::sqlite::ReadWrite);
     mapbox::sqlite::Statement stmt = db.prepare("pragma journal_mode");
     stmt.run();
     return stmt.get<std::string>(0);
 }
 
-static int databaseSyncMode(const std::string& path) {
-    mapbox::sqlite::Database db(path, mapbox::sqlite::ReadOnly);
-    mapbox::sqlite::Statement stmt = db.prepare("pragma synchronous");
-    stmt.run();
-    return stmt.get<int>(0);
-}
-
 TEST(OfflineDatabase, MigrateFromV2Schema) {
     using namespace mbgl;
 
     // v2.db is a v2 database containing a single offline region with a small number of resources.
 
-    deleteFile("test/fixtures/offline_database/v5.db");
-    writeFile("test/fixtures/offline_database/v5.db", util::read_file("test/fixtures/offline_database/v2.db"));
+    deleteFile("test/fixtures/offline_database/v6.db");
+    writeFile("test/fixtures/offline_database/v6.db", util::read_file("test/fixtures/offline_database/v2.db"));
 
     {
-        OfflineDatabase db("test/fixtures/offline_database/v5.db", 0);
+        OfflineDatabase db("test/fixtures/offline_database/v6.db", 0);
         auto regions = db.listRegions();
         for (auto& region : regions) {
             db.deleteRegion(std::move(region));
         }
     }
 
-    EXPECT_EQ(5, databaseUserVersion("test/fixtures/offline_database/v5.db"));
-    EXPECT_LT(databasePageCount("test/fixtures/offline_database/v5.db"),
+    EXPECT_EQ(6, databaseUserVersion("test/fixtures/offline_database/v6.db"));
+    EXPECT_LT(databasePageCount("test/fixtures/offline_database/v6.db"),
               databasePageCount("test/fixtures/offline_database/v2.db"));
 }
 
@@ -660,18 +691,19 @@ TEST(OfflineDatabase, MigrateFromV3Schema) {
 
     // v3.db is a v3 database, migrated from v2.
 
-    deleteFile("test/fixtures/offline_database/v5.db");
-    writeFile("test/fixtures/offline_database/v5.db", util::read_file("test/fixtures/offline_database/v3.db"));
+    deleteFile("test/fixtures/offline_database/v6.db");
+    writeFile("test/fixtures/offline_database/v6.db", util::read_file("test/fixtures/offline_database/v3.db"));
 
     {
-        OfflineDatabase db("test/fixtures/offline_database/v5.db", 0);
+        OfflineDatabase db("test/fixtures/offline_database/v6.db", 0);
         auto regions = db.listRegions();
         for (auto& region : regions) {
             db.deleteRegion(std::move(region));
         }
     }
 
-    EXPECT_EQ(5, databaseUserVersion("test/fixtures/offline_database/v5.db"));
+    EXPECT_EQ(6, databaseUserVersion("test/fixtures/offline_database/v6.db"));
+    EXPECT_EQ("wal", databaseJournalMode("test/fixtures/offline_database/v6.db"));
 }
 
 TEST(OfflineDatabase, MigrateFromV4Schema) {
@@ -679,22 +711,47 @@ TEST(OfflineDatabase, MigrateFromV4Schema) {
 
     // v4.db is a v4 database, migrated from v2 & v3. This database used `journal_mode = WAL` and `synchronous = NORMAL`.
 
-    deleteFile("test/fixtures/offline_database/v5.db");
-    writeFile("test/fixtures/offline_database/v5.db", util::read_file("test/fixtures/offline_database/v4.db"));
+    deleteFile("test/fixtures/offline_database/v6.db");
+    writeFile("test/fixtures/offline_database/v6.db", util::read_file("test/fixtures/offline_database/v4.db"));
 
     {
-        OfflineDatabase db("test/fixtures/offline_database/v5.db", 0);
+        OfflineDatabase db("test/fixtures/offline_database/v6.db", 0);
         auto regions = db.listRegions();
         for (auto& region : regions) {
             db.deleteRegion(std::move(region));
         }
     }
 
-    EXPECT_EQ(5, databaseUserVersion("test/fixtures/offline_database/v5.db"));
+    EXPECT_EQ(6, databaseUserVersion("test/fixtures/offline_database/v6.db"));
+
+    // Journal mode should still be WAL after migration to v6.
+    EXPECT_EQ("wal", databaseJournalMode("test/fixtures/offline_database/v6.db"));
+}
+
+TEST(OfflineDatabase, MigrateFromV5Schema) {
+    using namespace mbgl;
+
+    // Version 5 used the same table layout as v3 with a DELETE journal, so a
+    // v5 database is a v3 database with a bumped user_version.
+
+    deleteFile("test/fixtures/offline_database/v6.db");
+    writeFile("test/fixtures/offline_database/v6.db", util::read_file("test/fixtures/offline_database/v3.db"));
+
+    {
+        sqlite3* db = nullptr;
+        sqlite3_open_v2("test/fixtures/offline_database/v6.db", &db, SQLITE_OPEN_READWRITE, nullptr);
+        sqlite3_exec(db, "PRAGMA user_version = 5", nullptr, nullptr, nullptr);
+        sqlite3_close_v2(db);
+    }
 
-    // Journal mode should be DELETE after migration to v5.
-    EXPECT_EQ("delete", databaseJournalMode("test/fixtures/offline_database/v5.db"));
+    {
+        OfflineDatabase db("test/fixtures/offline_database/v6.db", 0);
+        auto regions = db.listRegions();
+        for (auto& region : regions) {
+            db.deleteRegion(std::move(region));
+        }
+    }
 
-    // Synchronous setting should be FULL (2) after migration to v5.
-    EXPECT_EQ(2, databaseSyncMode("test/fixtures/offline_database/v5.db"));
+    EXPECT_EQ(6, databaseUserVersion("test/fixtures/offline_database/v6.db"));
+    EXPECT_EQ("wal", databaseJournalMode("test/fixtures/offline_database/v6.db"));
 }
@@ -570,7 +570,9 @@ TEST(OfflineDownload, ReactivatePreviouslyCompletedDownload) {
 
     test.loop.run();
 
-    ASSERT_EQ(4u, statusesAfterReactivate.size());
+    // The tile is completed by the batched existence check while the style's
+    // own completion is still pending, so both arrive in one status change.
+    ASSERT_EQ(3u, statusesAfterReactivate.size());
 
     EXPECT_EQ(OfflineRegionDownloadState::Active, statusesAfterReactivate[0].downloadState);
     EXPECT_FALSE(statusesAfterReactivate[0].requiredResourceCountIsPrecise);
@@ -580,9 +582,9 @@ TEST(OfflineDownload, ReactivatePreviouslyCompletedDownload) {
     EXPECT_EQ(OfflineRegionDownloadState::Active, statusesAfterReactivate[1].downloadState);
     EXPECT_TRUE(statusesAfterReactivate[1].requiredResourceCountIsPrecise);
     EXPECT_EQ(2u, statusesAfterReactivate[1].requiredResourceCount);
-    EXPECT_EQ(1u, statusesAfterReactivate[1].completedResourceCount);
+    EXPECT_EQ(2u, statusesAfterReactivate[1].completedResourceCount);
 
-    EXPECT_EQ(OfflineRegionDownloadState::Active, statusesAfterReactivate[2].downloadState);
+    EXPECT_EQ(OfflineRegionDownloadState::Inactive, statusesAfterReactivate[2].downloadState);
     EXPECT_TRUE(statusesAfterReactivate[2].requiredResourceCountIsPrecise);
     EXPECT_EQ(2u, statusesAfterReactivate[2].requiredResourceCount);
     EXPECT_EQ(2u, statusesAfterReactivate[2].completedResourceCount);
@@ -0,0 +1,89 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/storage/offline_database.hpp>
+#include <mbgl/storage/offline_pack.hpp>
+#include <mbgl/storage/resource.hpp>
+#include <mbgl/storage/response.hpp>
+#include <mbgl/util/compression.hpp>
+#include <mbgl/util/io.hpp>
+
+#include <gtest/gtest.h>
+
+namespace {
+
+const char* packPath = "test/fixtures/offline_database/pack.bin";
+
+} // namespace
+
+TEST(OfflinePack, WriteAndGet) {
+    using namespace mbgl;
+
+    std::string compressible(1024, 'a');
+
+    OfflinePack::write(packPath, {
+        { OfflinePack::entryKey(Resource::style("http://example.com/style")),
+          "style data", false },
+        { OfflinePack::entryKey(Resource::tile("http://example.com/{z}-{x}-{y}", 1.0, 0, 0, 0, Tileset::Scheme::XYZ)),
+          util::compress(compressible), true },
+    });
+
+    OfflinePack pack(packPath);
+
+    auto style = pack.get(Resource::style("http://example.com/style"));
+    ASSERT_TRUE(bool(style));
+    ASSERT_TRUE(style->data.get());
+    EXPECT_EQ("style data", *style->data);
+
+    auto tile = pack.get(Resource::tile("http://example.com/{z}-{x}-{y}", 1.0, 0, 0, 0, Tileset::Scheme::XYZ));
+    ASSERT_TRUE(bool(tile));
+    ASSERT_TRUE(tile->data.get());
+    EXPECT_EQ(compressible, *tile->data);
+
+    EXPECT_FALSE(bool(pack.get(Resource::style("http://example.com/other"))));
+    EXPECT_FALSE(bool(pack.get(Resource::tile("http://example.com/{z}-{x}-{y}", 1.0, 1, 0, 0, Tileset::Scheme::XYZ))));
+
+    util::deleteFile(packPath);
+}
+
+TEST(OfflinePack, Invalid) {
+    using namespace mbgl;
+
+    util::write_file(packPath, "this is not a pack");
+    EXPECT_THROW(OfflinePack{packPath}, std::runtime_error);
+
+    // A valid magic followed by a truncated index must also be rejected.
+    util::write_file(packPath, std::string("MBGLPACK\x01\x00\x00\x00", 12));
+    EXPECT_THROW(OfflinePack{packPath}, std::runtime_error);
+
+    util::deleteFile(packPath);
+}
+
+TEST(OfflinePack, ExportRegion) {
+    using namespace mbgl;
+
+    OfflineDatabase db(":memory:");
+    OfflineRegionDefinition definition { "http://example.com/style", LatLngBounds::world(), 0, INFINITY, 1.0 };
+    OfflineRegion region = db.createRegion(definition, OfflineRegionMetadata());
+
+    Response response;
+    response.data = std::make_shared<std::string>("Region value");
+
+    db.putRegionResource(region.getID(), Resource::style("http://example.com/"), response);
+    db.putRegionResource(region.getID(), Resource::tile("http://example.com/", 1.0, 0, 0, 0, Tileset::Scheme::XYZ), response);
+
+    db.exportRegion(region.getID(), packPath);
+
+    OfflinePack pack(packPath);
+
+    auto style = pack.get(Resource::style("http://example.com/"));
+    ASSERT_TRUE(bool(style));
+    ASSERT_TRUE(style->data.get());
+    EXPECT_EQ("Region value", *style->data);
+
+    auto tile = pack.get(Resource::tile("http://example.com/", 1.0, 0, 0, 0, Tileset::Scheme::XYZ));
+    ASSERT_TRUE(bool(tile));
+    ASSERT_TRUE(tile->data.get());
+    EXPECT_EQ("Region value", *tile->data);
+
+    util::deleteFile(packPath);
+}
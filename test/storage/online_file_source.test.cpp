@@ -139,6 +139,102 @@ TEST(OnlineFileSource, TEST_REQUIRES_SERVER(Timeout)) {
     EXPECT_EQ(4, counter);
 }
 
+TEST(OnlineFileSource, TEST_REQUIRES_SERVER(RefreshAhead)) {
+    util::RunLoop loop;
+    OnlineFileSource fs;
+
+    int counter = 0;
+
+    // Expires ten seconds out: too far for the expiration timer to fire
+    // within this test, but near enough to fall inside the refresh-ahead
+    // window.
+    const Resource resource { Resource::Unknown, "http://127.0.0.1:3000/test?cachecontrol=max-age=10" };
+    std::unique_ptr<AsyncRequest> req1 = fs.request(resource, [&](Response res) {
+        counter++;
+        EXPECT_EQ(nullptr, res.error);
+    });
+
+    // A second, slower request; once it completes and the network goes idle,
+    // the first resource is revalidated ahead of its expiration.
+    std::unique_ptr<AsyncRequest> req2;
+    req2 = fs.request({ Resource::Unknown, "http://127.0.0.1:3000/delayed" }, [&](Response) {
+        req2.reset();
+    });
+
+    util::Timer timer;
+    timer.start(Milliseconds(1500), Duration::zero(), [&] () {
+        loop.stop();
+    });
+
+    loop.run();
+
+    EXPECT_EQ(2, counter);
+}
+
+TEST(OnlineFileSource, TEST_REQUIRES_SERVER(DeduplicateConcurrent)) {
+    util::RunLoop loop;
+    OnlineFileSource fs;
+
+    // The /cache endpoint numbers its responses, so two requests that share
+    // one transfer receive identical bodies, while two separate transfers
+    // would not.
+    const Resource resource { Resource::Unknown, "http://127.0.0.1:3000/cache" };
+
+    int remaining = 2;
+    std::string first, second;
+
+    std::unique_ptr<AsyncRequest> req1 = fs.request(resource, [&](Response res) {
+        EXPECT_EQ(nullptr, res.error);
+        ASSERT_TRUE(res.data.get());
+        first = *res.data;
+        if (--remaining == 0) {
+            loop.stop();
+        }
+    });
+
+    std::unique_ptr<AsyncRequest> req2 = fs.request(resource, [&](Response res) {
+        EXPECT_EQ(nullptr, res.error);
+        ASSERT_TRUE(res.data.get());
+        second = *res.data;
+        if (--remaining == 0) {
+            loop.stop();
+        }
+    });
+
+    loop.run();
+
+    EXPECT_EQ(first, second);
+}
+
+TEST(OnlineFileSource, TEST_REQUIRES_SERVER(DeduplicateLeaderCancelled)) {
+    util::RunLoop loop;
+    OnlineFileSource fs;
+
+    const Resource resource { Resource::Unknown, "http://127.0.0.1:3000/delayed" };
+
+    // Cancelling the request that opened a shared transfer hands the transfer
+    // over to the request that attached to it.
+    std::unique_ptr<AsyncRequest> req1 = fs.request(resource, [&](Response) {
+        ADD_FAILURE() << "Callback should not be called";
+    });
+
+    std::unique_ptr<AsyncRequest> req2;
+    req2 = fs.request(resource, [&](Response res) {
+        req2.reset();
+        EXPECT_EQ(nullptr, res.error);
+        ASSERT_TRUE(res.data.get());
+        EXPECT_EQ("Response", *res.data);
+        loop.stop();
+    });
+
+    util::Timer timer;
+    timer.start(Milliseconds(50), Duration::zero(), [&] () {
+        req1.reset();
+    });
+
+    loop.run();
+}
+
 TEST(OnlineFileSource, TEST_REQUIRES_SERVER(RetryDelayOnExpiredTile)) {
     util::RunLoop loop;
     OnlineFileSource fs;
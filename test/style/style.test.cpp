@@ -78,9 +78,11 @@ TEST(Style, UnusedSourceActiveViaClassUpdate) {
     style.cascade(now, MapMode::Still);
     style.recalculate(0, now, MapMode::Still);
 
+    // Re-setting the same stylesheet is applied as a diff, so the source — and
+    // its already-loaded state — is kept rather than torn down and refetched.
     unusedSource = style.getSource("unusedsource");
     EXPECT_TRUE(unusedSource);
-    EXPECT_FALSE(unusedSource->baseImpl->isLoaded());
+    EXPECT_TRUE(unusedSource->baseImpl->isLoaded());
 }
 
 TEST(Style, Properties) {
@@ -117,6 +119,75 @@ TEST(Style, Properties) {
     ASSERT_EQ(0, style.getDefaultPitch());
 }
 
+TEST(Style, SetJSONLayerDiff) {
+    util::RunLoop loop;
+
+    StubFileSource fileSource;
+    Style style { fileSource, 1.0 };
+
+    const std::string base = R"STYLE({
+        "version": 8,
+        "sources": {
+            "vector": { "type": "vector", "tiles": [ "http://example.com/{z}-{x}-{y}.vector.pbf" ] }
+        },
+        "layers": [{
+            "id": "line",
+            "type": "line",
+            "source": "vector",
+            "source-layer": "layer",
+            "paint": { "line-color": "#ff0000" }
+        }]
+    })STYLE";
+
+    style.setJSON(base);
+
+    Source* source = style.getSource("vector");
+    Layer* layer = style.getLayer("line");
+    ASSERT_TRUE(source);
+    ASSERT_TRUE(layer);
+
+    // Re-setting an identical stylesheet keeps both objects.
+    style.setJSON(base);
+    EXPECT_EQ(source, style.getSource("vector"));
+    EXPECT_EQ(layer, style.getLayer("line"));
+
+    // A paint-only change keeps the source and swaps in the recolored layer.
+    style.setJSON(R"STYLE({
+        "version": 8,
+        "sources": {
+            "vector": { "type": "vector", "tiles": [ "http://example.com/{z}-{x}-{y}.vector.pbf" ] }
+        },
+        "layers": [{
+            "id": "line",
+            "type": "line",
+            "source": "vector",
+            "source-layer": "layer",
+            "paint": { "line-color": "#00ff00" }
+        }]
+    })STYLE");
+    EXPECT_EQ(source, style.getSource("vector"));
+    Layer* recolored = style.getLayer("line");
+    ASSERT_TRUE(recolored);
+    EXPECT_NE(layer, recolored);
+
+    // A changed sources object falls back to a full reload.
+    style.setJSON(R"STYLE({
+        "version": 8,
+        "sources": {
+            "vector": { "type": "vector", "tiles": [ "http://example.com/other/{z}-{x}-{y}.vector.pbf" ] }
+        },
+        "layers": [{
+            "id": "line",
+            "type": "line",
+            "source": "vector",
+            "source-layer": "layer",
+            "paint": { "line-color": "#00ff00" }
+        }]
+    })STYLE");
+    EXPECT_NE(source, style.getSource("vector"));
+    EXPECT_TRUE(style.getLayer("line"));
+}
+
 TEST(Style, DuplicateSource) {
     util::RunLoop loop;
 
@@ -16,6 +16,8 @@
 #include <mbgl/style/layers/raster_layer_impl.hpp>
 #include <mbgl/style/layers/symbol_layer.hpp>
 #include <mbgl/style/layers/symbol_layer_impl.hpp>
+#include <mbgl/style/cascade_parameters.hpp>
+#include <mbgl/style/property_evaluation_parameters.hpp>
 #include <mbgl/util/color.hpp>
 #include <mbgl/util/run_loop.hpp>
 #include <mbgl/util/io.hpp>
@@ -296,3 +298,34 @@ TEST(Layer, DuplicateLayer) {
     }
 }
 
+
+TEST(Layer, ZoomIndependentBuckets) {
+    auto cascadeAndEvaluate = [] (Layer& layer) {
+        layer.baseImpl->cascade(CascadeParameters());
+        layer.baseImpl->evaluate(PropertyEvaluationParameters(10.0f));
+    };
+
+    // Fill and circle buckets bake no zoom-dependent values by default.
+    auto fill = std::make_unique<FillLayer>("fill", "source");
+    cascadeAndEvaluate(*fill);
+    EXPECT_TRUE(fill->baseImpl->hasZoomIndependentBuckets());
+
+    // Source functions bake per-feature values only.
+    fill->setFillColor(SourceFunction<Color> { "property", CategoricalStops<Color>({{ std::string("a"), Color::black() }}) });
+    cascadeAndEvaluate(*fill);
+    EXPECT_TRUE(fill->baseImpl->hasZoomIndependentBuckets());
+
+    // Composite functions interpolate along the zoom axis in the bucket.
+    fill->setFillOpacity(CompositeFunction<float> { "property", std::map<float, ExponentialStops<float>> {
+        { 0.0f, ExponentialStops<float>({{ 0.0f, 0.0f }}) },
+        { 20.0f, ExponentialStops<float>({{ 0.0f, 1.0f }}) },
+    }});
+    cascadeAndEvaluate(*fill);
+    EXPECT_FALSE(fill->baseImpl->hasZoomIndependentBuckets());
+
+    // Line buckets evaluate layout at the overscaled zoom and adjust their
+    // geometry for the overscale factor, so they never qualify.
+    auto line = std::make_unique<LineLayer>("line", "source");
+    cascadeAndEvaluate(*line);
+    EXPECT_FALSE(line->baseImpl->hasZoomIndependentBuckets());
+}
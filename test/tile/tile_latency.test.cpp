@@ -0,0 +1,36 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/tile/tile_latency.hpp>
+
+using namespace mbgl;
+
+// The histogram is process-wide, so every test starts and ends clean.
+
+TEST(TileLatency, EmptyHistogram) {
+    TileLatency::reset();
+
+    EXPECT_EQ(0u, TileLatency::sampleCount());
+    EXPECT_EQ(Duration::zero(), TileLatency::percentile(0.95));
+}
+
+TEST(TileLatency, PercentilesReportBucketUpperBounds) {
+    TileLatency::reset();
+
+    // 90 fast samples, 10 slow ones: the median lands in the fast bucket and
+    // p95 in the slow one.
+    for (int i = 0; i < 90; i++) {
+        TileLatency::record(Milliseconds(40));
+    }
+    for (int i = 0; i < 10; i++) {
+        TileLatency::record(Milliseconds(3000));
+    }
+
+    EXPECT_EQ(100u, TileLatency::sampleCount());
+
+    // 40ms falls in the (32, 64] bucket; 3000ms in the (2048, 4096] bucket.
+    EXPECT_EQ(Milliseconds(64), TileLatency::percentile(0.5));
+    EXPECT_EQ(Milliseconds(4096), TileLatency::percentile(0.95));
+
+    TileLatency::reset();
+    EXPECT_EQ(0u, TileLatency::sampleCount());
+}
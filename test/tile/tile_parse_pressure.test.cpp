@@ -0,0 +1,34 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/tile/tile_parse_pressure.hpp>
+
+using namespace mbgl;
+
+namespace {
+
+constexpr std::size_t MB = 1024 * 1024;
+
+} // namespace
+
+TEST(TileParsePressure, Watermarks) {
+    EXPECT_FALSE(TileParsePressure::shedding());
+
+    // Below the high watermark nothing is shed.
+    TileParsePressure::add(16 * MB);
+    EXPECT_FALSE(TileParsePressure::shedding());
+
+    // Crossing the high watermark latches shedding on.
+    TileParsePressure::add(16 * MB);
+    EXPECT_TRUE(TileParsePressure::shedding());
+
+    // Draining below the high watermark isn't enough; the backlog has to
+    // fall below the low watermark before optional loads resume.
+    TileParsePressure::remove(8 * MB);
+    EXPECT_TRUE(TileParsePressure::shedding());
+
+    TileParsePressure::remove(16 * MB);
+    EXPECT_FALSE(TileParsePressure::shedding());
+
+    TileParsePressure::remove(8 * MB);
+    EXPECT_FALSE(TileParsePressure::shedding());
+}
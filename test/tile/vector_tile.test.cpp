@@ -3,6 +3,7 @@
 #include <mbgl/tile/vector_tile.hpp>
 #include <mbgl/tile/tile_loader_impl.hpp>
 
+#include <mbgl/util/compression.hpp>
 #include <mbgl/util/default_thread_pool.hpp>
 #include <mbgl/util/run_loop.hpp>
 #include <mbgl/map/transform.hpp>
@@ -71,7 +72,9 @@ TEST(VectorTile, Issue7615) {
             symbolBucket
         }},
         nullptr,
-        0
+        Duration::zero(),
+        0,
+        true
     });
 
     // Subsequent onLayout should not cause the existing symbol bucket to be discarded.
@@ -79,8 +82,39 @@ TEST(VectorTile, Issue7615) {
         {},
         nullptr,
         nullptr,
+        Duration::zero(),
         0
     });
 
     EXPECT_EQ(symbolBucket.get(), tile.getBucket(symbolLayer));
 }
+
+TEST(VectorTileData, LazyDecompression) {
+    // A tile with a single layer named "test" (version 2).
+    const std::string pbf("\x1a\x08\x0a\x04test\x78\x02", 10);
+
+    VectorTileData data(std::make_shared<std::string>(util::compress(pbf)));
+
+    // The content hash covers the stored (compressed) bytes and must not
+    // change once the payload has been inflated for parsing.
+    const auto hash = data.contentHash();
+    EXPECT_NE(nullptr, data.getLayer("test"));
+    EXPECT_EQ(hash, data.contentHash());
+}
+
+TEST(VectorTileData, Empty) {
+    // A tile with a single layer named "test" (version 2) and no features.
+    const std::string noFeatures("\x1a\x08\x0a\x04test\x78\x02", 10);
+    EXPECT_TRUE(VectorTileData(std::make_shared<std::string>(noFeatures)).empty());
+
+    // The same layer carrying one (empty) feature message.
+    const std::string oneFeature("\x1a\x0a\x0a\x04test\x12\x00\x78\x02", 12);
+    EXPECT_FALSE(VectorTileData(std::make_shared<std::string>(oneFeature)).empty());
+
+    // Compressed payloads answer conservatively until they have been parsed;
+    // inflating them just for the peek would burden the foreground thread.
+    VectorTileData compressed(std::make_shared<std::string>(util::compress(noFeatures)));
+    EXPECT_FALSE(compressed.empty());
+    EXPECT_NE(nullptr, compressed.getLayer("test"));
+    EXPECT_TRUE(compressed.empty());
+}
@@ -0,0 +1,52 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/util/buffer_pool.hpp>
+
+using namespace mbgl;
+
+// The pool is process-wide, so every test clears it before returning.
+
+TEST(BufferPool, Recycles) {
+    util::BufferPool::clear();
+
+    auto body = util::BufferPool::acquire(64 * 1024);
+    body->assign(64 * 1024, 'x');
+    const char* allocation = body->data();
+    body.reset();
+
+    // The released buffer is parked, then handed back out for a request of
+    // the same class, contents cleared but capacity intact.
+    EXPECT_GT(util::BufferPool::retainedBytes(), 0u);
+
+    auto recycled = util::BufferPool::acquire(64 * 1024);
+    EXPECT_EQ(allocation, recycled->data());
+    EXPECT_TRUE(recycled->empty());
+    EXPECT_GE(recycled->capacity(), 64u * 1024u);
+    EXPECT_EQ(0u, util::BufferPool::retainedBytes());
+
+    recycled.reset();
+    util::BufferPool::clear();
+}
+
+TEST(BufferPool, AdoptedBuffersRecycle) {
+    util::BufferPool::clear();
+
+    std::string blob(64 * 1024, 'x');
+    auto body = util::BufferPool::adopt(std::move(blob));
+    EXPECT_EQ(64u * 1024u, body->size());
+    body.reset();
+
+    EXPECT_GE(util::BufferPool::retainedBytes(), 64u * 1024u);
+    util::BufferPool::clear();
+    EXPECT_EQ(0u, util::BufferPool::retainedBytes());
+}
+
+TEST(BufferPool, OversizedBuffersAreNotPooled) {
+    util::BufferPool::clear();
+
+    auto body = util::BufferPool::acquire(util::BufferPool::maximumClassSize * 2);
+    body->assign(util::BufferPool::maximumClassSize * 2, 'x');
+    body.reset();
+
+    EXPECT_EQ(0u, util::BufferPool::retainedBytes());
+}
@@ -0,0 +1,87 @@
+#include <mbgl/util/etc1.hpp>
+
+#include <mbgl/test/util.hpp>
+
+#include <cstdlib>
+#include <cstring>
+
+using namespace mbgl;
+
+namespace {
+
+UnassociatedImage solidImage(Size size, uint8_t r, uint8_t g, uint8_t b, uint8_t a = 255) {
+    UnassociatedImage image(size);
+    for (size_t i = 0; i < image.bytes(); i += 4) {
+        image.data[i + 0] = r;
+        image.data[i + 1] = g;
+        image.data[i + 2] = b;
+        image.data[i + 3] = a;
+    }
+    return image;
+}
+
+} // namespace
+
+TEST(ETC1, SolidBlackBlockLayout) {
+    // A solid black 4x4 block has a spec-derivable encoding: differential
+    // mode with zero base colors and table 0, every pixel selecting the
+    // small negative modifier (clamped to zero). This pins the bit layout
+    // down independently of the decoder.
+    auto compressed = util::compressETC1(solidImage({ 4, 4 }, 0, 0, 0));
+    ASSERT_TRUE(bool(compressed));
+    ASSERT_EQ(8u, compressed->blocks.size());
+    const uint8_t expected[8] = { 0x00, 0x00, 0x00, 0x02, 0xFF, 0xFF, 0x00, 0x00 };
+    EXPECT_EQ(0, std::memcmp(expected, compressed->blocks.data(), 8));
+}
+
+TEST(ETC1, SolidColorRoundTrip) {
+    const auto original = solidImage({ 8, 8 }, 120, 80, 200);
+    auto compressed = util::compressETC1(original);
+    ASSERT_TRUE(bool(compressed));
+    EXPECT_EQ(8u * 8u / 16u * 8u, compressed->blocks.size());
+
+    const auto decoded = util::decompressETC1(*compressed);
+    ASSERT_EQ(original.size, decoded.size);
+    for (size_t i = 0; i < decoded.bytes(); i += 4) {
+        for (size_t channel = 0; channel < 3; ++channel) {
+            EXPECT_NEAR(original.data[i + channel], decoded.data[i + channel], 8);
+        }
+        EXPECT_EQ(255, decoded.data[i + 3]);
+    }
+}
+
+TEST(ETC1, GradientRoundTrip) {
+    UnassociatedImage original({ 16, 16 });
+    for (uint32_t y = 0; y < 16; ++y) {
+        for (uint32_t x = 0; x < 16; ++x) {
+            uint8_t* p = original.data.get() + y * original.stride() + x * 4;
+            p[0] = static_cast<uint8_t>(x * 16);
+            p[1] = static_cast<uint8_t>(y * 16);
+            p[2] = 128;
+            p[3] = 255;
+        }
+    }
+
+    auto compressed = util::compressETC1(original);
+    ASSERT_TRUE(bool(compressed));
+
+    const auto decoded = util::decompressETC1(*compressed);
+    uint64_t totalError = 0;
+    for (size_t i = 0; i < decoded.bytes(); i += 4) {
+        for (size_t channel = 0; channel < 3; ++channel) {
+            totalError += std::abs(int32_t(original.data[i + channel]) -
+                                   int32_t(decoded.data[i + channel]));
+        }
+    }
+    EXPECT_LT(totalError / (16.0 * 16.0 * 3.0), 16.0);
+}
+
+TEST(ETC1, RejectsUnsuitableImages) {
+    // Any non-opaque pixel disqualifies the image: ETC1 has no alpha channel.
+    auto transparent = solidImage({ 4, 4 }, 10, 20, 30);
+    transparent.data[7] = 128;
+    EXPECT_FALSE(bool(util::compressETC1(transparent)));
+
+    // As do dimensions that aren't multiples of the 4x4 block size.
+    EXPECT_FALSE(bool(util::compressETC1(solidImage({ 6, 4 }, 10, 20, 30))));
+}
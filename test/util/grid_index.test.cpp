@@ -0,0 +1,62 @@
+#include <mbgl/util/grid_index.hpp>
+#include <mbgl/geometry/feature_index.hpp>
+
+#include <mbgl/test/util.hpp>
+
+using namespace mbgl;
+
+using BBox = GridIndex<IndexedSubfeature>::BBox;
+using Point = mapbox::geometry::point<int16_t>;
+
+TEST(GridIndex, QueryDeduplicatesSpanningElements) {
+    GridIndex<IndexedSubfeature> grid(8192, 16, 0);
+
+    // The first box spans many cells; it must still be reported once.
+    grid.insert(IndexedSubfeature { 0, "a", "a", 0 }, BBox { Point { 0, 0 }, Point { 4000, 4000 } });
+    grid.insert(IndexedSubfeature { 1, "b", "b", 1 }, BBox { Point { 100, 100 }, Point { 200, 200 } });
+    grid.insert(IndexedSubfeature { 2, "c", "c", 2 }, BBox { Point { 6000, 6000 }, Point { 7000, 7000 } });
+
+    EXPECT_EQ(2u, grid.query(BBox { Point { 0, 0 }, Point { 300, 300 } }).size());
+    EXPECT_EQ(3u, grid.query(BBox { Point { 0, 0 }, Point { 8191, 8191 } }).size());
+    EXPECT_TRUE(grid.query(BBox { Point { 7500, 100 }, Point { 7600, 200 } }).empty());
+}
+
+TEST(GridIndex, CallerProvidedBufferAppends) {
+    GridIndex<IndexedSubfeature> grid(8192, 16, 0);
+
+    grid.insert(IndexedSubfeature { 0, "a", "a", 0 }, BBox { Point { 100, 100 }, Point { 200, 200 } });
+
+    std::vector<IndexedSubfeature> buffer;
+    for (int i = 0; i < 3; ++i) {
+        buffer.clear();
+        grid.query(BBox { Point { 0, 0 }, Point { 300, 300 } }, buffer);
+        ASSERT_EQ(1u, buffer.size());
+        EXPECT_EQ(0u, buffer[0].index);
+    }
+}
+
+TEST(GridIndex, InsertAfterQueryRebuilds) {
+    GridIndex<IndexedSubfeature> grid(8192, 16, 0);
+
+    grid.insert(IndexedSubfeature { 0, "a", "a", 0 }, BBox { Point { 100, 100 }, Point { 200, 200 } });
+    EXPECT_EQ(1u, grid.query(BBox { Point { 0, 0 }, Point { 300, 300 } }).size());
+
+    grid.insert(IndexedSubfeature { 1, "b", "b", 1 }, BBox { Point { 150, 150 }, Point { 160, 160 } });
+    EXPECT_EQ(2u, grid.query(BBox { Point { 0, 0 }, Point { 300, 300 } }).size());
+}
+
+TEST(GridIndex, EarlyExitVisitsFirstHitOnly) {
+    GridIndex<IndexedSubfeature> grid(8192, 16, 0);
+
+    grid.insert(IndexedSubfeature { 0, "a", "a", 0 }, BBox { Point { 0, 0 }, Point { 4000, 4000 } });
+    grid.insert(IndexedSubfeature { 1, "b", "b", 1 }, BBox { Point { 100, 100 }, Point { 200, 200 } });
+
+    int visits = 0;
+    grid.query(BBox { Point { 0, 0 }, Point { 8191, 8191 } },
+               [&] (const IndexedSubfeature&, const BBox&) {
+                   ++visits;
+                   return true;
+               });
+
+    EXPECT_EQ(1, visits);
+}
@@ -0,0 +1,28 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/util/i18n.hpp>
+
+using namespace mbgl::util;
+
+TEST(I18n, AllowsIdeographicBreaking) {
+    // Codepoints inside ideographic blocks.
+    EXPECT_TRUE(i18n::allowsIdeographicBreaking(0x2027)); // Interpunct
+    EXPECT_TRUE(i18n::allowsIdeographicBreaking(0x3041)); // Hiragana
+    EXPECT_TRUE(i18n::allowsIdeographicBreaking(0x30A1)); // Katakana
+    EXPECT_TRUE(i18n::allowsIdeographicBreaking(0x4E00)); // CJK Unified Ideographs, first
+    EXPECT_TRUE(i18n::allowsIdeographicBreaking(0x9FFF)); // CJK Unified Ideographs, last
+    EXPECT_TRUE(i18n::allowsIdeographicBreaking(0xA000)); // Yi Syllables
+    EXPECT_TRUE(i18n::allowsIdeographicBreaking(0xFF01)); // Fullwidth forms
+
+    // Codepoints outside, including gaps between adjacent ideographic blocks.
+    EXPECT_FALSE(i18n::allowsIdeographicBreaking(u'A'));
+    EXPECT_FALSE(i18n::allowsIdeographicBreaking(0x2E7F)); // before CJK Radicals Supplement
+    EXPECT_FALSE(i18n::allowsIdeographicBreaking(0x2FE0)); // Kangxi Radicals .. Ideographic Description
+    EXPECT_FALSE(i18n::allowsIdeographicBreaking(0x3130)); // Hangul Compatibility Jamo
+    EXPECT_FALSE(i18n::allowsIdeographicBreaking(0xAC00)); // Hangul Syllables
+    EXPECT_FALSE(i18n::allowsIdeographicBreaking(0xFFF0)); // Specials
+
+    // The string overload requires every character to allow it.
+    EXPECT_TRUE(i18n::allowsIdeographicBreaking(u"日本語"));
+    EXPECT_FALSE(i18n::allowsIdeographicBreaking(u"日本語 Tokyo"));
+}
@@ -78,12 +78,45 @@ TEST(Image, JPEGTile) {
     EXPECT_EQ(256u, image.size.height);
 }
 
+#if !defined(__ANDROID__) && !defined(__APPLE__) && !defined(QT_IMAGE_DECODERS)
+TEST(Image, JPEGTileDownsampled) {
+    const std::string data = util::read_file("test/fixtures/image/tile.jpeg");
+
+    // The hint reduces by powers of two while keeping the longer edge at or
+    // above the requested size.
+    PremultipliedImage half = decodeImage(data, 100);
+    EXPECT_EQ(128u, half.size.width);
+    EXPECT_EQ(128u, half.size.height);
+
+    PremultipliedImage exact = decodeImage(data, 128);
+    EXPECT_EQ(128u, exact.size.width);
+    EXPECT_EQ(128u, exact.size.height);
+
+    // A hint at or above the native size decodes at full resolution.
+    PremultipliedImage full = decodeImage(data, 256);
+    EXPECT_EQ(256u, full.size.width);
+    EXPECT_EQ(256u, full.size.height);
+}
+
+TEST(Image, PNGTileIgnoresDownsamplingHint) {
+    PremultipliedImage image = decodeImage(util::read_file("test/fixtures/image/tile.png"), 100);
+    EXPECT_EQ(256u, image.size.width);
+    EXPECT_EQ(256u, image.size.height);
+}
+#endif // !defined(__ANDROID__) && !defined(__APPLE__) && !defined(QT_IMAGE_DECODERS)
+
 #if !defined(__ANDROID__) && !defined(__APPLE__) && !defined(QT_IMAGE_DECODERS)
 TEST(Image, WebPTile) {
     PremultipliedImage image = decodeImage(util::read_file("test/fixtures/image/tile.webp"));
     EXPECT_EQ(256u, image.size.width);
     EXPECT_EQ(256u, image.size.height);
 }
+
+TEST(Image, WebPTileDownsampled) {
+    PremultipliedImage image = decodeImage(util::read_file("test/fixtures/image/tile.webp"), 100);
+    EXPECT_EQ(128u, image.size.width);
+    EXPECT_EQ(128u, image.size.height);
+}
 #endif // !defined(__ANDROID__) && !defined(__APPLE__) && !defined(QT_IMAGE_DECODERS)
 
 TEST(Image, Premultiply) {
@@ -99,3 +132,48 @@ TEST(Image, Premultiply) {
     EXPECT_EQ(127, image.data[2]);
     EXPECT_EQ(128, image.data[3]);
 }
+
+TEST(Image, PremultiplyMatchesScalarFormula) {
+    // Wide enough to cover both the vectorized chunk and the scalar tail of
+    // the conversion, with a mix of opaque, transparent and translucent
+    // alphas; every pixel must match the scalar rounding exactly.
+    UnassociatedImage rgba({ 7, 1 });
+    const uint8_t alphas[7] = { 0, 1, 64, 127, 128, 254, 255 };
+    for (size_t px = 0; px < 7; ++px) {
+        rgba.data[px * 4 + 0] = 200;
+        rgba.data[px * 4 + 1] = 100;
+        rgba.data[px * 4 + 2] = 3;
+        rgba.data[px * 4 + 3] = alphas[px];
+    }
+
+    PremultipliedImage image = util::premultiply(std::move(rgba));
+    for (size_t px = 0; px < 7; ++px) {
+        const uint8_t a = alphas[px];
+        EXPECT_EQ((200 * a + 127) / 255, image.data[px * 4 + 0]);
+        EXPECT_EQ((100 * a + 127) / 255, image.data[px * 4 + 1]);
+        EXPECT_EQ((3 * a + 127) / 255, image.data[px * 4 + 2]);
+        EXPECT_EQ(a, image.data[px * 4 + 3]);
+    }
+}
+
+TEST(Image, UnpremultiplyMixedAlpha) {
+    // Mixed opaque and translucent pixels across a chunk exercises the
+    // opaque-skip fast path together with the per-pixel division.
+    PremultipliedImage pre({ 7, 1 });
+    for (size_t px = 0; px < 7; ++px) {
+        const uint8_t a = px % 2 ? 255 : 128;
+        pre.data[px * 4 + 0] = 64;
+        pre.data[px * 4 + 1] = 128;
+        pre.data[px * 4 + 2] = 0;
+        pre.data[px * 4 + 3] = a;
+    }
+
+    UnassociatedImage image = util::unpremultiply(std::move(pre));
+    for (size_t px = 0; px < 7; ++px) {
+        const uint8_t a = px % 2 ? 255 : 128;
+        EXPECT_EQ((255 * 64 + a / 2) / a, image.data[px * 4 + 0]);
+        EXPECT_EQ((255 * 128 + a / 2) / a, image.data[px * 4 + 1]);
+        EXPECT_EQ(0, image.data[px * 4 + 2]);
+        EXPECT_EQ(a, image.data[px * 4 + 3]);
+    }
+}
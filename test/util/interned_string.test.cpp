@@ -0,0 +1,37 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/util/interned_string.hpp>
+
+#include <unordered_map>
+
+using namespace mbgl;
+
+TEST(InternedString, SameStringSameToken) {
+    util::InternedString a { "water" };
+    util::InternedString b { std::string("water") };
+    util::InternedString c { "waterway" };
+
+    EXPECT_EQ(a.token(), b.token());
+    EXPECT_TRUE(a == b);
+    EXPECT_TRUE(a != c);
+    EXPECT_EQ("water", a.str());
+    EXPECT_EQ("waterway", c.str());
+}
+
+TEST(InternedString, EmptyStringIsDefault) {
+    util::InternedString empty { "" };
+
+    EXPECT_EQ(0u, empty.token());
+    EXPECT_TRUE(empty == util::InternedString());
+    EXPECT_EQ("", util::InternedString().str());
+}
+
+TEST(InternedString, UsableAsMapKey) {
+    std::unordered_map<util::InternedString, int> map;
+    map[util::InternedString("road")] = 1;
+    map[util::InternedString("building")] = 2;
+
+    EXPECT_EQ(1, map.at(util::InternedString("road")));
+    EXPECT_EQ(2, map.at(util::InternedString("building")));
+    EXPECT_EQ(0u, map.count(util::InternedString("poi")));
+}
@@ -0,0 +1,86 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/util/memory_budget.hpp>
+
+using namespace mbgl;
+
+// The registry is process-wide, so every test unregisters its participants
+// and clears the limit before returning.
+
+TEST(MemoryBudget, Usage) {
+    const std::size_t baseline = MemoryBudget::Usage();
+
+    const uint64_t a = MemoryBudget::Register("a", [] { return std::size_t(100); });
+    const uint64_t b = MemoryBudget::Register("b", [] { return std::size_t(50); });
+
+    EXPECT_EQ(baseline + 150, MemoryBudget::Usage());
+
+    MemoryBudget::Unregister(a);
+    EXPECT_EQ(baseline + 50, MemoryBudget::Usage());
+
+    MemoryBudget::Unregister(b);
+    EXPECT_EQ(baseline, MemoryBudget::Usage());
+}
+
+TEST(MemoryBudget, EnforceProportionally) {
+    std::size_t usageA = 300;
+    std::size_t usageB = 100;
+
+    const uint64_t a = MemoryBudget::Register(
+        "a", [&] { return usageA; }, [&] (std::size_t target) { usageA = target; });
+    const uint64_t b = MemoryBudget::Register(
+        "b", [&] { return usageB; }, [&] (std::size_t target) { usageB = target; });
+
+    const std::size_t baseline = MemoryBudget::Usage() - usageA - usageB;
+
+    // Caps the combined usage 200 bytes below the current total; each cache
+    // gives back a slice proportional to its share.
+    MemoryBudget::SetLimit(baseline + 200);
+    MemoryBudget::Enforce();
+
+    EXPECT_EQ(150u, usageA);
+    EXPECT_EQ(50u, usageB);
+
+    // Under the limit: enforcement doesn't touch anything.
+    MemoryBudget::Enforce();
+    EXPECT_EQ(150u, usageA);
+    EXPECT_EQ(50u, usageB);
+
+    MemoryBudget::SetLimit(0);
+    MemoryBudget::Unregister(a);
+    MemoryBudget::Unregister(b);
+}
+
+TEST(MemoryBudget, UntrimmableParticipants) {
+    std::size_t trimmableUsage = 100;
+
+    // No trim hook: counts against the cap but can't shrink.
+    const uint64_t fixed = MemoryBudget::Register("fixed", [] { return std::size_t(300); });
+    const uint64_t trimmable = MemoryBudget::Register(
+        "trimmable", [&] { return trimmableUsage; },
+        [&] (std::size_t target) { trimmableUsage = target; });
+
+    const std::size_t baseline = MemoryBudget::Usage() - 300 - trimmableUsage;
+
+    // The fixed participant alone exceeds the cap; the trimmable one absorbs
+    // as much of the overage as it can.
+    MemoryBudget::SetLimit(baseline + 250);
+    MemoryBudget::Enforce();
+    EXPECT_EQ(0u, trimmableUsage);
+
+    MemoryBudget::SetLimit(0);
+    MemoryBudget::Unregister(fixed);
+    MemoryBudget::Unregister(trimmable);
+}
+
+TEST(MemoryBudget, NoLimit) {
+    std::size_t usage = 500;
+    const uint64_t id = MemoryBudget::Register(
+        "cache", [&] { return usage; }, [&] (std::size_t target) { usage = target; });
+
+    // Limit 0 disables enforcement entirely.
+    MemoryBudget::Enforce();
+    EXPECT_EQ(500u, usage);
+
+    MemoryBudget::Unregister(id);
+}
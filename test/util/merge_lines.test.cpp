@@ -77,6 +77,25 @@ TEST(MergeLines, CircularLines) {
     }
 }
 
+TEST(MergeLines, OpposingDirections) {
+    // mergeLines handles segments digitized in opposite directions
+    std::vector<mbgl::SymbolFeature> input = {
+        { FeatureType::LineString, {{{0, 0}, {1, 0}, {2, 0}}}, aaa, {}, {{0, 0}}, 0, 0 },
+        { FeatureType::LineString, {{{4, 0}, {3, 0}, {2, 0}}}, aaa, {}, {{0, 0}}, 0, 0 }
+    };
+
+    const std::vector<mbgl::SymbolFeature> expected = {
+        { FeatureType::LineString, {{{0, 0}, {1, 0}, {2, 0}, {3, 0}, {4, 0}}}, aaa, {}, {{0, 0}}, 0, 0 },
+        { FeatureType::LineString, {{}}, aaa, {}, {{0, 0}}, 0, 0 }
+    };
+
+    mbgl::util::mergeLines(input);
+
+    for (int i = 0; i < 2; i++) {
+        EXPECT_TRUE(input[i].geometry == expected[i].geometry);
+    }
+}
+
 TEST(MergeLines, EmptyOuterGeometry) {
     std::vector<mbgl::SymbolFeature> input = {
         { FeatureType::LineString, {}, aaa, {}, {{0, 0}}, 0, 0 },
@@ -0,0 +1,73 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/util/simplify.hpp>
+
+using namespace mbgl;
+
+TEST(Simplify, CollapsesCollinearPoints) {
+    GeometryCoordinates line;
+    for (int16_t x = 0; x <= 100; x += 10) {
+        line.emplace_back(x, x);
+    }
+
+    GeometryCoordinates result = util::simplify(line, 4.0);
+
+    ASSERT_EQ(2u, result.size());
+    EXPECT_EQ(line.front(), result.front());
+    EXPECT_EQ(line.back(), result.back());
+}
+
+TEST(Simplify, KeepsPointsBeyondTolerance) {
+    GeometryCoordinates line {
+        { 0, 0 }, { 50, 20 }, { 100, 0 }
+    };
+
+    GeometryCoordinates result = util::simplify(line, 4.0);
+
+    EXPECT_EQ(line, result);
+}
+
+TEST(Simplify, DropsSubToleranceJitter) {
+    GeometryCoordinates line {
+        { 0, 0 }, { 25, 2 }, { 50, -2 }, { 75, 1 }, { 100, 0 }
+    };
+
+    GeometryCoordinates result = util::simplify(line, 4.0);
+
+    ASSERT_EQ(2u, result.size());
+    EXPECT_EQ(line.front(), result.front());
+    EXPECT_EQ(line.back(), result.back());
+}
+
+TEST(Simplify, KeepsShortInputsVerbatim) {
+    GeometryCoordinates segment { { 0, 0 }, { 1, 1 } };
+    EXPECT_EQ(segment, util::simplify(segment, 4.0));
+
+    GeometryCoordinates jittery { { 0, 0 }, { 1, 1 }, { 2, 0 } };
+    EXPECT_EQ(jittery, util::simplify(jittery, 0.0));
+}
+
+TEST(Simplify, ClosedRingStaysClosed) {
+    GeometryCoordinates ring {
+        { 0, 0 }, { 50, 1 }, { 100, 0 }, { 100, 100 }, { 0, 100 }, { 0, 0 }
+    };
+
+    GeometryCoordinates result = util::simplify(ring, 4.0);
+
+    ASSERT_GE(result.size(), 4u);
+    EXPECT_EQ(result.front(), result.back());
+    EXPECT_EQ(5u, result.size()); // The near-collinear edge midpoint is gone.
+}
+
+TEST(Simplify, AppliesPerLineInCollection) {
+    GeometryCollection collection {
+        { { 0, 0 }, { 50, 0 }, { 100, 0 } },
+        { { 0, 0 }, { 50, 20 }, { 100, 0 } },
+    };
+
+    GeometryCollection result = util::simplify(collection, 4.0);
+
+    ASSERT_EQ(2u, result.size());
+    EXPECT_EQ(2u, result[0].size());
+    EXPECT_EQ(3u, result[1].size());
+}
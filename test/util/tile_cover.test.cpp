@@ -41,6 +41,28 @@ TEST(TileCover, Pitch) {
               util::tileCover(transform.getState(), 2));
 }
 
+TEST(TileCover, PitchedLOD) {
+    Transform transform;
+    transform.resize({ 512, 512 });
+    transform.setLatLng({ 0.1, -0.1 });
+    transform.setZoom(5);
+    transform.setPitch(60.0 * M_PI / 180.0);
+
+    const auto cover = util::tileCover(transform.getState(), 5);
+
+    // The cover is ordered by distance from the center: the near field stays
+    // at the ideal zoom, while the far rows drop to ancestor tiles whose
+    // on-screen size matches what the perspective leaves visible.
+    EXPECT_EQ(5u, cover.front().canonical.z);
+    bool hasAncestors = false;
+    for (const auto& id : cover) {
+        EXPECT_GE(5u, id.canonical.z);
+        EXPECT_LE(3u, id.canonical.z);
+        hasAncestors |= id.canonical.z < 5;
+    }
+    EXPECT_TRUE(hasAncestors);
+}
+
 TEST(TileCover, WorldZ1) {
     EXPECT_EQ((std::vector<UnwrappedTileID>{
                   { 1, 0, 0 }, { 1, 0, 1 }, { 1, 1, 0 }, { 1, 1, 1 },
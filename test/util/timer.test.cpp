@@ -165,6 +165,45 @@ TEST(Timer, TEST_REQUIRES_ACCURATE_TIMING(StartOverrides)) {
     EXPECT_LE(totalTime, expectedTotalTime * 1.2);
 }
 
+TEST(Timer, TEST_REQUIRES_ACCURATE_TIMING(CoalescedTimersAllFire)) {
+    RunLoop loop;
+
+    Timer timer1;
+    Timer timer2;
+
+    // Deadlines closer together than the run loop's coalescing slack; both
+    // callbacks must still run, in deadline order, in a single wakeup.
+    auto interval1 = mbgl::Milliseconds(100);
+    auto interval2 = mbgl::Milliseconds(105);
+    auto expectedTotalTime = interval2;
+
+    int count = 0;
+
+    auto callback1 = [&] {
+        EXPECT_EQ(count, 0);
+        ++count;
+    };
+
+    auto callback2 = [&] {
+        EXPECT_EQ(count, 1);
+        ++count;
+        loop.stop();
+    };
+
+    auto first = mbgl::Clock::now();
+    timer1.start(interval1, mbgl::Duration::zero(), callback1);
+    timer2.start(interval2, mbgl::Duration::zero(), callback2);
+
+    loop.run();
+
+    auto totalTime = std::chrono::duration_cast<mbgl::Milliseconds>(mbgl::Clock::now() - first);
+
+    EXPECT_EQ(count, 2);
+
+    EXPECT_GE(totalTime, expectedTotalTime * 0.8);
+    EXPECT_LE(totalTime, expectedTotalTime * 1.2);
+}
+
 TEST(Timer, TEST_REQUIRES_ACCURATE_TIMING(CanStopNonStartedTimer)) {
     RunLoop loop;
 
@@ -0,0 +1,49 @@
+#include <mbgl/test/util.hpp>
+
+#include <mbgl/util/tiny_sdf.hpp>
+#include <mbgl/text/glyph.hpp>
+
+#include <algorithm>
+
+using namespace mbgl;
+
+TEST(TinySDF, FilledSquare) {
+    // An 8x8 filled square with a borderSize empty margin on every side, as a
+    // platform font rasterizer would hand it to us.
+    const uint32_t border = SDFGlyph::borderSize;
+    const uint32_t squareSize = 8;
+    const Size size { squareSize + 2 * border, squareSize + 2 * border };
+
+    AlphaImage raster(size);
+    std::fill(raster.data.get(), raster.data.get() + size.width * size.height, 0);
+    for (uint32_t y = border; y < border + squareSize; y++) {
+        for (uint32_t x = border; x < border + squareSize; x++) {
+            raster.data[y * size.width + x] = 255;
+        }
+    }
+
+    AlphaImage sdf = util::transformRasterToSDF(raster);
+    ASSERT_EQ(size.width, sdf.size.width);
+    ASSERT_EQ(size.height, sdf.size.height);
+
+    auto at = [&] (uint32_t x, uint32_t y) {
+        return sdf.data[y * sdf.size.width + x];
+    };
+
+    // The edge maps to alpha 191 (cutoff 0.25); the square interior is
+    // positive distance inside the shape, the margin negative.
+    const uint32_t mid = size.width / 2;
+    EXPECT_GT(at(mid, mid), 191);
+    EXPECT_LT(at(0, 0), 191);
+    EXPECT_LT(at(0, mid), 191);
+
+    // Alpha decays monotonically walking from the center out into the margin.
+    for (uint32_t x = mid; x > 0; x--) {
+        EXPECT_GE(at(x, mid), at(x - 1, mid));
+    }
+
+    // One pixel inside the edge is above the edge value, one pixel outside
+    // below it, and the two straddle it symmetrically.
+    EXPECT_GT(at(border, mid), 191);
+    EXPECT_LT(at(border - 1, mid), 191);
+}
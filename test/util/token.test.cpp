@@ -48,3 +48,37 @@ TEST(Token, replaceTokens) {
         return "";
     }));
 }
+
+TEST(Token, templateExpansion) {
+    auto expand = [](const std::string& tmpl, const std::string& name, const std::string& replacement) {
+        util::TokenTemplate compiled { tmpl };
+        std::string buffer = "stale contents from a previous expansion";
+        compiled.expand(buffer, [&](const std::string& token, std::string& out) {
+            if (token == name) {
+                out.append(replacement);
+            }
+        });
+        return buffer;
+    };
+
+    EXPECT_EQ("literal", expand("literal", "name", "14th St NW"));
+    EXPECT_EQ("14th St NW", expand("{name}", "name", "14th St NW"));
+    EXPECT_EQ("", expand("{name}", "text", "14th St NW"));
+    EXPECT_EQ("500 m", expand("{num} m", "num", "500"));
+    EXPECT_EQ(" but still", expand("{notset} but still", "", ""));
+    EXPECT_EQ("{malformed", expand("{malformed", "malformed", "nope"));
+
+    EXPECT_FALSE(util::TokenTemplate { "no tokens here" }.hasTokens());
+    EXPECT_FALSE(util::TokenTemplate { "{unclosed" }.hasTokens());
+    EXPECT_TRUE(util::TokenTemplate { "{name}" }.hasTokens());
+
+    // Multiple tokens expand in order against one lookup.
+    util::TokenTemplate multi { "{a} {b} {c}" };
+    std::string buffer;
+    multi.expand(buffer, [](const std::string& token, std::string& out) {
+        if (token == "a") out.append("3");
+        if (token == "b") out.append("Fine");
+        if (token == "c") out.append("Fields");
+    });
+    EXPECT_EQ("3 Fine Fields", buffer);
+}